@@ -24,6 +24,7 @@
 
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/AtomTable.h>
 #include <lsp-plug.in/expr/Resolver.h>
 #include <lsp-plug.in/lltl/parray.h>
 
@@ -38,6 +39,7 @@ namespace lsp
                 {
                     LSPString                   name;
                     value_t                     value;
+                    const atom_t               *atom;       // Atom bound to the variable, may be NULL
                 } variable_t;
 
                 typedef struct user_func_t
@@ -50,12 +52,17 @@ namespace lsp
             protected:
                 Resolver                   *pResolver;
                 lltl::parray<variable_t>    vVars;
+                lltl::parray<variable_t>    vAtoms;     // Variables bound to atoms, sorted by atom pointer
                 lltl::parray<user_func_t>   vFunc;
 
             protected:
                 status_t            insert_var(const LSPString *name, const value_t *value, size_t idx);
                 status_t            insert_var_move(const LSPString *name, value_t *value, size_t idx);
                 ssize_t             index_of_var(const LSPString *name);
+                ssize_t             index_of_atom(const atom_t *atom);
+                variable_t         *atom_var(const atom_t *atom, size_t idx);
+                void                bind_atom(const atom_t *atom, size_t idx);
+                void                unbind_atom(variable_t *var);
 
                 status_t            insert_func(const LSPString *name, function_t func, void *context, size_t idx);
                 ssize_t             index_of_func(const LSPString *name);
@@ -99,6 +106,33 @@ namespace lsp
                 status_t            unset(const char *name, value_t *value = NULL);
                 status_t            unset(const LSPString *name, value_t *value = NULL);
 
+            public:
+                /**
+                 * Resolve the variable by the interned name. The first lookup of the atom is performed
+                 * by the string value of the atom, all subsequent lookups compare only atom pointers.
+                 *
+                 * @param value pointer to store the value (may be NULL)
+                 * @param name interned name of the variable
+                 * @return status of operation
+                 */
+                status_t            resolve(value_t *value, const atom_t *name);
+
+                /**
+                 * Set the variable by the interned name
+                 * @param name interned name of the variable
+                 * @param value value to set
+                 * @return status of operation
+                 */
+                status_t            set(const atom_t *name, const value_t *value);
+
+                /**
+                 * Remove the variable by the interned name
+                 * @param name interned name of the variable
+                 * @param value pointer to store the removed value (may be NULL)
+                 * @return status of operation
+                 */
+                status_t            unset(const atom_t *name, value_t *value = NULL);
+
                 void                clear_vars();
 
             public:
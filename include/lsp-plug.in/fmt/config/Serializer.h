@@ -26,6 +26,7 @@
 #include <lsp-plug.in/common/types.h>
 #include <lsp-plug.in/common/status.h>
 #include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/StringBuilder.h>
 #include <lsp-plug.in/io/IOutSequence.h>
 #include <lsp-plug.in/io/IOutStream.h>
 #include <lsp-plug.in/io/Path.h>
@@ -97,6 +98,13 @@ namespace lsp
                  */
                 virtual status_t    wrap(LSPString *str);
 
+                /**
+                 * Wrap string builder with parser
+                 * @param sb string builder to wrap
+                 * @return status of operation
+                 */
+                virtual status_t    wrap(StringBuilder *sb);
+
                 /**
                  * Wrap input sequence with parser
                  * @param seq sequence to use for reads
@@ -24,6 +24,7 @@
 
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/AtomTable.h>
 
 namespace lsp
 {
@@ -88,7 +89,8 @@ namespace lsp
         typedef struct param_t
         {
             public:
-                LSPString   name;           // Name of parameter
+                LSPString   name;           // Name of parameter, direct modification requires atom = NULL, use set_name()
+                const atom_t *atom;         // Interned name of parameter, NULL if not interned
                 LSPString   comment;        // Comment
                 size_t      flags;          // Serialization flags
                 value_t     v;              // Value
@@ -193,6 +195,11 @@ namespace lsp
                 bool            set_name(const char * name);
                 bool            set_name(const LSPString * name);
                 bool            set_name(const LSPString & name);
+                bool            set_name(const atom_t *name);
+
+                // Interned names
+                bool            intern_name(AtomTable *table = NULL);
+                bool            is(const atom_t *name) const;
         } param_t;
 
     } /* namespace config */
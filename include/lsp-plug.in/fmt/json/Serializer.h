@@ -24,6 +24,7 @@
 
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/runtime/StringBuilder.h>
 #include <lsp-plug.in/io/IOutStream.h>
 #include <lsp-plug.in/io/IOutSequence.h>
 #include <lsp-plug.in/io/Path.h>
@@ -123,6 +124,14 @@ namespace lsp
                  */
                 status_t    wrap(LSPString *str, const serial_flags_t *settings);
 
+                /**
+                 * Wrap string builder with serializer
+                 * @param sb string builder to wrap
+                 * @param settings serialization flags
+                 * @return status of operation
+                 */
+                status_t    wrap(StringBuilder *sb, const serial_flags_t *settings);
+
                 /**
                  * Wrap input sequence with serializer
                  * @param seq sequence to use for reads
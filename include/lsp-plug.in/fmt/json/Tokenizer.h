@@ -25,6 +25,7 @@
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/runtime/LSPString.h>
 #include <lsp-plug.in/io/IInSequence.h>
+#include <lsp-plug.in/io/SpanReader.h>
 #include <lsp-plug.in/fmt/json/token.h>
 
 namespace lsp
@@ -38,7 +39,7 @@ namespace lsp
                 friend class Serializer;
 
             protected:
-                io::IInSequence        *pIn;
+                io::SpanReader          sIn;
                 lsp_swchar_t            cCurrent;
                 token_t                 enToken;
                 LSPString               sValue;
@@ -66,12 +67,14 @@ namespace lsp
                 static bool         is_identifier_start(lsp_wchar_t ch);
                 static bool         is_identifier(lsp_wchar_t ch);
                 static bool         parse_digit(int *digit, lsp_wchar_t ch, int radix);
+                static inline bool  is_whitespace(lsp_swchar_t ch);
 
                 status_t            add_pending_character(lsp_utf16_t ch);
                 status_t            commit_pending_characters();
                 token_t             parse_unicode_escape_sequence(token_t type);
                 token_t             parse_hexadecimal_escape_sequence(token_t type);
 
+                status_t            append_span(const lsp_wchar_t *tail);
                 token_t             parse_string(token_t type);
                 token_t             parse_identifier();
                 token_t             parse_single_line_comment();
@@ -129,6 +132,15 @@ namespace lsp
                  * @return last error code
                  */
                 inline status_t         error() const { return nError; }
+
+                /**
+                 * Update the read position of the sequence. The tokenizer reads characters ahead
+                 * of the sequence, so this method should be called before accessing the sequence
+                 * directly. The destructor does not access the sequence, so the sequence may be
+                 * destroyed before the tokenizer.
+                 * @return status of operation
+                 */
+                status_t                sync();
         };
     
     } /* namespace json */
@@ -108,6 +108,9 @@ namespace lsp
         constexpr uint32_t COMPRESSED_SIGNATURE     = __IF_LEBE(0x4a424f43, 0x434f424a); /* COBJ */
         constexpr size_t MIN_FLOAT_BUF_BITS         = 4;
         constexpr size_t MAX_FLOAT_BUF_BITS         = 16;
+        constexpr size_t VARINT_BITS                = 6;    // Number of data bits per group of generic variable-length integer
+        constexpr size_t ICOUNT_BITS                = 3;    // Number of data bits in the first group of index or count
+        constexpr size_t ICOUNT_STEP                = 2;    // Increment of data bits for each next group of index or count
     } /* namesoace obj */
 } /* namespace lsp */
 
@@ -40,8 +40,14 @@ namespace lsp
          */
         class LSP_RUNTIME_LIB_PUBLIC PullParser
         {
+            private:
+                static constexpr size_t BUF_SIZE        = 0x1000;
+
             private:
                 io::IInStream      *pIn;
+                uint8_t            *pBuffer;            // Read-ahead buffer
+                size_t              nBufSize;           // Number of bytes in the read-ahead buffer
+                size_t              nBufOffset;         // Read offset in the read-ahead buffer
                 size_t              nWFlags;
                 event_t             sCurrent;
                 event_t             sSample;            // Pending sample event
@@ -56,6 +62,7 @@ namespace lsp
 
             protected:
                 lsp_swchar_t        get_char();
+                lsp_swchar_t        fill_buffer();
                 status_t            expect_string(const char *text);
                 status_t            expect_char(lsp_swchar_t expected);
                 status_t            read_opcode(lsp_wchar_t ch, event_t *ev);
@@ -26,6 +26,7 @@
 #include <lsp-plug.in/common/types.h>
 #include <lsp-plug.in/io/IInStream.h>
 #include <lsp-plug.in/io/IInSequence.h>
+#include <lsp-plug.in/io/SpanReader.h>
 #include <lsp-plug.in/io/Path.h>
 #include <lsp-plug.in/fmt/xml/const.h>
 #include <lsp-plug.in/lltl/parray.h>
@@ -64,6 +65,7 @@ namespace lsp
 
             protected:
                 io::IInSequence        *pIn;
+                io::SpanReader          sIn;
                 size_t                  nWFlags;
                 status_t                nToken;
                 parse_state_t           nState;
@@ -92,6 +94,7 @@ namespace lsp
 
                 inline lsp_swchar_t getch();
                 inline void         ungetch(lsp_swchar_t c);
+                status_t            append_span(LSPString *dst, lsp_wchar_t c1, lsp_wchar_t c2, lsp_wchar_t c3);
                 inline void         push_state(parse_state_t override);
                 inline void         pop_state();
 
@@ -49,8 +49,16 @@ namespace lsp
                     bool                    bRoot;
                 } node_t;
 
+                typedef struct cached_t
+                {
+                    const atom_t           *pKey;
+                    status_t                nStatus;
+                    LSPString               sValue;
+                } cached_t;
+
             protected:
                 lltl::parray<node_t>    vNodes;
+                lltl::parray<cached_t>  vCache;     // Results of lookups by atom, sorted by atom pointer
                 LSPString               sPath;
                 resource::ILoader      *pLoader;
 
@@ -58,6 +66,8 @@ namespace lsp
                 status_t            load_json(IDictionary **dict, const io::Path *path);
                 status_t            create_child(IDictionary **dict, const LSPString *path);
                 status_t            load_dictionary(const LSPString *id, IDictionary **dict);
+                ssize_t             index_of_cached(const atom_t *key);
+                void                drop_cache();
 
             public:
                 explicit Dictionary(resource::ILoader *loader = NULL);
@@ -75,6 +85,8 @@ namespace lsp
 
                 virtual status_t    lookup(const LSPString *key, IDictionary **value);
 
+                virtual status_t    lookup(const atom_t *key, LSPString *value);
+
                 virtual status_t    get_value(size_t index, LSPString *key, LSPString *value);
 
                 virtual status_t    get_child(size_t index, LSPString *key, IDictionary **dict);
@@ -25,6 +25,7 @@
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/common/status.h>
 #include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/AtomTable.h>
 #include <lsp-plug.in/io/Path.h>
 
 namespace lsp
@@ -78,6 +79,14 @@ namespace lsp
                  */
                 virtual status_t lookup(const LSPString *key, LSPString *value);
 
+                /**
+                 * Lookup for a key
+                 * @param key non-null interned key value
+                 * @param value pointer to store the value (may be NULL)
+                 * @return status of operation
+                 */
+                virtual status_t lookup(const atom_t *key, LSPString *value);
+
                 /**
                  * Lookup for a dictionary
                  * @param key non-null UTF-8 encoded key value
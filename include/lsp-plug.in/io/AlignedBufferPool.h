@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_ALIGNEDBUFFERPOOL_H_
+#define LSP_PLUG_IN_IO_ALIGNEDBUFFERPOOL_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/ipc/Mutex.h>
+#include <lsp-plug.in/lltl/darray.h>
+
+#define IO_DIRECT_DEFAULT_ALIGN         0x1000
+#define IO_DIRECT_DEFAULT_BUF_SIZE      0x100000
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Thread-safe pool of equally-sized memory buffers aligned to the boundary
+         * required for direct (unbuffered) file I/O. The size of each buffer is a
+         * multiple of the alignment. Released buffers are kept for reuse until
+         * trim() is called or the pool is destroyed.
+         */
+        class AlignedBufferPool
+        {
+            private:
+                typedef struct buffer_t
+                {
+                    uint8_t            *raw;        // Pointer to the allocated memory
+                    uint8_t            *data;       // Aligned pointer to the buffer
+                    bool                used;       // Buffer is in use
+                } buffer_t;
+
+            private:
+                ipc::Mutex              sMutex;     // Mutex for synchronization
+                lltl::darray<buffer_t>  vBuffers;   // List of allocated buffers
+                size_t                  nBufSize;   // Size of each buffer
+                size_t                  nAlign;     // Alignment of buffers
+                size_t                  nUsed;      // Number of buffers in use
+
+            public:
+                /**
+                 * Create buffer pool
+                 * @param buf_size size of each buffer, rounded up to the multiple of alignment
+                 * @param align alignment of buffers, should be power of two, the value is
+                 *   raised to the default direct I/O alignment if it is less
+                 */
+                explicit AlignedBufferPool(size_t buf_size = IO_DIRECT_DEFAULT_BUF_SIZE, size_t align = IO_DIRECT_DEFAULT_ALIGN);
+                AlignedBufferPool(const AlignedBufferPool &) = delete;
+                AlignedBufferPool(AlignedBufferPool &&) = delete;
+                ~AlignedBufferPool();
+
+                AlignedBufferPool & operator = (const AlignedBufferPool &) = delete;
+                AlignedBufferPool & operator = (AlignedBufferPool &&) = delete;
+
+            public:
+                /**
+                 * Get the size of each buffer
+                 * @return size of each buffer in bytes
+                 */
+                inline size_t       buffer_size() const     { return nBufSize;  }
+
+                /**
+                 * Get the alignment of buffers
+                 * @return alignment of buffers in bytes
+                 */
+                inline size_t       alignment() const       { return nAlign;    }
+
+                /**
+                 * Acquire buffer from the pool, allocate new buffer if there are no free buffers
+                 * @return pointer to the aligned buffer or NULL if there is no memory
+                 */
+                uint8_t            *acquire();
+
+                /**
+                 * Return the buffer to the pool
+                 * @param buf buffer previously obtained by acquire()
+                 * @return status of operation, STATUS_NOT_FOUND if buffer does not belong to the pool
+                 */
+                status_t            release(void *buf);
+
+                /**
+                 * Free all buffers that are not in use
+                 */
+                void                trim();
+
+                /**
+                 * Get the number of buffers allocated by the pool
+                 * @return number of allocated buffers
+                 */
+                size_t              allocated();
+
+                /**
+                 * Get the number of buffers currently in use
+                 * @return number of buffers in use
+                 */
+                size_t              used();
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_ALIGNEDBUFFERPOOL_H_ */
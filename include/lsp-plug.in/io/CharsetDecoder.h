@@ -55,10 +55,12 @@ namespace lsp
 #else
                 iconv_t         hIconv;         // iconv handle
 #endif /* PLATFORM_WINDOWS */
+                builtin_charset_t enCharset;    // Built-in character set
 
             private:
                 inline size_t   prepare_buffer();
                 ssize_t         decode_buffer();
+                ssize_t         decode_builtin();
 
             public:
                 explicit CharsetDecoder();
@@ -112,6 +114,23 @@ namespace lsp
                  */
                 ssize_t     fetch(IOutSequence *out, size_t count = 0);
 
+                /**
+                 * Obtain the pointer to the decoded characters stored in the internal buffer
+                 * without copying them. The data remains valid until the next call of any
+                 * other method of the decoder.
+                 * @param ptr pointer to store the pointer to the first decoded character
+                 * @return number of decoded characters available, zero if the decoder needs more data,
+                 *         or negative error code
+                 */
+                ssize_t     peek(const lsp_wchar_t **ptr);
+
+                /**
+                 * Skip decoded characters stored in the internal buffer
+                 * @param count number of characters to skip
+                 * @return number of characters skipped
+                 */
+                size_t      skip(size_t count);
+
                 /**
                  * Fill the internal byte buffer with additional data for decoding
                  * @param buf source buffer with data
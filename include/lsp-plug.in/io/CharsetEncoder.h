@@ -55,10 +55,12 @@ namespace lsp
 #else
                 iconv_t         hIconv;         // iconv handle
 #endif /* PLATFORM_WINDOWS */
+                builtin_charset_t enCharset;    // Built-in character set
 
             private:
                 inline size_t   prepare_buffer();
                 ssize_t         encode_buffer();
+                ssize_t         encode_builtin();
 
             public:
                 explicit CharsetEncoder();
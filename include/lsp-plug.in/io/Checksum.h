@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_CHECKSUM_H_
+#define LSP_PLUG_IN_IO_CHECKSUM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Checksum algorithm
+         */
+        enum checksum_t
+        {
+            CHECKSUM_CRC32,             // CRC-32 (IEEE 802.3, zlib), 32-bit value
+            CHECKSUM_CRC32C,            // CRC-32C (Castagnoli, iSCSI), 32-bit value
+            CHECKSUM_XXH64              // xxHash64, 64-bit value
+        };
+
+        /**
+         * Implementation of checksum routines
+         */
+        enum checksum_kernel_t
+        {
+            CHECKSUM_KERNEL_AUTO,       // The best implementation supported by the CPU
+            CHECKSUM_KERNEL_GENERIC,    // Scalar table-driven implementation
+            CHECKSUM_KERNEL_SSE42,      // x86 SSE4.2 CRC32 instruction
+            CHECKSUM_KERNEL_ARMV8       // AArch64 CRC32 instructions
+        };
+
+        /**
+         * State of the streaming xxHash64 computation
+         */
+        typedef struct xxh64_t
+        {
+            uint64_t        v[4];       // Accumulators
+            uint64_t        total;      // Total number of bytes processed
+            uint64_t        seed;       // Seed
+            uint8_t         tail[32];   // Pending bytes of the incomplete stripe
+            uint32_t        pending;    // Number of pending bytes
+        } xxh64_t;
+
+        /**
+         * Select the implementation of checksum routines. The function is intended for
+         * testing and benchmarking and should not be called while checksums are computed
+         * by other threads.
+         * @param kernel implementation to use
+         * @return status of operation, STATUS_NOT_SUPPORTED if the implementation
+         *   is not supported by the build or by the CPU
+         */
+        status_t                select_checksum_kernel(checksum_kernel_t kernel);
+
+        /**
+         * Get the implementation of checksum routines currently in use
+         * @return implementation currently in use
+         */
+        checksum_kernel_t       checksum_kernel();
+
+        /**
+         * Update CRC-32 checksum. The initial value of the checksum is 0, the returned
+         * value is final and can be passed to the next call to continue the computation.
+         * @param crc current value of the checksum
+         * @param buf data to process
+         * @param count number of bytes to process
+         * @return updated value of the checksum
+         */
+        uint32_t                crc32(uint32_t crc, const void *buf, size_t count);
+
+        /**
+         * Update CRC-32C checksum. The initial value of the checksum is 0, the returned
+         * value is final and can be passed to the next call to continue the computation.
+         * @param crc current value of the checksum
+         * @param buf data to process
+         * @param count number of bytes to process
+         * @return updated value of the checksum
+         */
+        uint32_t                crc32c(uint32_t crc, const void *buf, size_t count);
+
+        /**
+         * Compute xxHash64 of the data block
+         * @param buf data to process
+         * @param count number of bytes to process
+         * @param seed seed value
+         * @return hash value
+         */
+        uint64_t                xxh64(const void *buf, size_t count, uint64_t seed = 0);
+
+        /**
+         * Initialize state of the streaming xxHash64 computation
+         * @param state state to initialize
+         * @param seed seed value
+         */
+        void                    xxh64_init(xxh64_t *state, uint64_t seed = 0);
+
+        /**
+         * Process the data block by the streaming xxHash64 computation
+         * @param state computation state
+         * @param buf data to process
+         * @param count number of bytes to process
+         */
+        void                    xxh64_update(xxh64_t *state, const void *buf, size_t count);
+
+        /**
+         * Get the hash value of all data processed by the streaming xxHash64 computation.
+         * The state is not modified, so the computation can be continued.
+         * @param state computation state
+         * @return hash value
+         */
+        uint64_t                xxh64_digest(const xxh64_t *state);
+
+        /**
+         * Checksum accumulator that computes the checksum of the chosen algorithm
+         * over the sequence of data blocks
+         */
+        class Checksum
+        {
+            private:
+                checksum_t          enType;     // Algorithm
+                uint32_t            nCrc;       // Current value of CRC
+                wsize_t             nProcessed; // Number of bytes processed
+                xxh64_t             sXXH;       // State of xxHash64
+
+            public:
+                explicit Checksum(checksum_t type = CHECKSUM_CRC32C, uint64_t seed = 0);
+                Checksum(const Checksum &) = delete;
+                Checksum(Checksum &&) = delete;
+                ~Checksum();
+
+                Checksum & operator = (const Checksum &) = delete;
+                Checksum & operator = (Checksum &&) = delete;
+
+            public:
+                /**
+                 * Select the algorithm and reset the state
+                 * @param type algorithm
+                 * @param seed seed value, used by hashes that support seeding
+                 * @return status of operation
+                 */
+                status_t            init(checksum_t type, uint64_t seed = 0);
+
+                /**
+                 * Reset the state to the initial one, the algorithm and seed are kept
+                 */
+                void                reset();
+
+                /**
+                 * Process the data block
+                 * @param buf data to process
+                 * @param count number of bytes to process
+                 */
+                void                update(const void *buf, size_t count);
+
+                /**
+                 * Get the checksum of all processed data
+                 * @return checksum value, 32-bit checksums are zero-extended
+                 */
+                uint64_t            value() const;
+
+                /**
+                 * Get the algorithm
+                 * @return algorithm
+                 */
+                inline checksum_t   type() const            { return enType;        }
+
+                /**
+                 * Get the size of the checksum value
+                 * @return size of the checksum value in bytes
+                 */
+                size_t              size() const;
+
+                /**
+                 * Get the number of bytes processed
+                 * @return number of bytes processed
+                 */
+                inline wsize_t      processed() const       { return nProcessed;    }
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_CHECKSUM_H_ */
@@ -249,6 +249,33 @@ namespace lsp
                  */
                 static status_t remove(const Path *path);
 
+                /**
+                 * Flush directory metadata (created, removed and renamed entries) to the
+                 * storage device. Has no effect on platforms that do not allow to synchronize
+                 * directories, STATUS_OK is returned in this case.
+                 * @param path path to directory
+                 * @return status of operation
+                 */
+                static status_t sync(const char *path);
+
+                /**
+                 * Flush directory metadata (created, removed and renamed entries) to the
+                 * storage device. Has no effect on platforms that do not allow to synchronize
+                 * directories, STATUS_OK is returned in this case.
+                 * @param path path to directory
+                 * @return status of operation
+                 */
+                static status_t sync(const LSPString *path);
+
+                /**
+                 * Flush directory metadata (created, removed and renamed entries) to the
+                 * storage device. Has no effect on platforms that do not allow to synchronize
+                 * directories, STATUS_OK is returned in this case.
+                 * @param path path to directory
+                 * @return status of operation
+                 */
+                static status_t sync(const Path *path);
+
                 /**
                  * Delete directory
                  * @param path path to directory
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_DIRWALKER_H_
+#define LSP_PLUG_IN_IO_DIRWALKER_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/IDirWalkHandler.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/io/PathPattern.h>
+#include <lsp-plug.in/ipc/Condition.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/lltl/parray.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Recursive directory walker. The walker reads directory entries in large batches,
+         * avoids stat() calls when the file type is provided by the directory listing and
+         * can process subdirectories in parallel by several threads.
+         */
+        class DirWalker
+        {
+            public:
+                enum flags_t
+                {
+                    WALK_STAT       = 1 << 0,       // Provide attributes for each entry
+                    WALK_NO_DIRS    = 1 << 1,       // Do not report directories to the handler
+                    WALK_NO_FILES   = 1 << 2,       // Do not report non-directory entries to the handler
+
+                    WALK_NONE       = 0
+                };
+
+            protected:
+                typedef struct task_t
+                {
+                    size_t              nLength;    // Length of the path
+                    size_t              nDepth;     // Depth of the directory entries
+                    char               *sPath;      // Path to the directory, allocated together with the task
+                } task_t;
+
+                typedef struct context_t
+                {
+                    char               *pPath;      // Buffer for the path of the entry
+                    size_t              nCapacity;  // Capacity of the path buffer
+                    uint8_t            *pData;      // Buffer for directory listing
+                    lltl::parray<task_t> vTasks;    // Subdirectories found in the current directory
+                } context_t;
+
+            private:
+                IDirWalkHandler        *pHandler;
+                const PathPattern      *pFilter;
+                const PathPattern      *pExclude;
+                size_t                  nFlags;
+                size_t                  nThreads;
+                size_t                  nMaxDepth;
+                size_t                  nRootLength;
+
+                ipc::Condition          sCond;
+                lltl::parray<task_t>    vQueue;
+                size_t                  nActive;
+                status_t                nError;
+                uatomic_t               nStatx;     // Non-zero if statx() system call can be used
+
+            private:
+                static status_t         thread_proc(void *arg);
+                static task_t          *create_task(const char *path, size_t length, size_t depth);
+                static bool             reserve_path(context_t *ctx, size_t length);
+
+            private:
+                status_t                worker();
+                status_t                build_path(context_t *ctx, const task_t *task, const char *name, dir_entry_t *entry);
+                status_t                process_task(context_t *ctx, const task_t *task);
+                status_t                process_entry(context_t *ctx, const task_t *task, const dir_entry_t *entry);
+            #ifndef PLATFORM_WINDOWS
+                status_t                process_dirent(context_t *ctx, const task_t *task, int dirfd, const char *name, uint8_t type);
+            #endif /* PLATFORM_WINDOWS */
+                void                    set_result(status_t code);
+                void                    clear_queue();
+
+            public:
+                explicit DirWalker();
+                DirWalker(const DirWalker &) = delete;
+                DirWalker(DirWalker &&) = delete;
+                ~DirWalker();
+
+                DirWalker & operator = (const DirWalker &) = delete;
+                DirWalker & operator = (DirWalker &&) = delete;
+
+            public:
+                /**
+                 * Set walking flags
+                 * @param flags walking flags
+                 */
+                inline void             set_flags(size_t flags)                     { nFlags = flags;       }
+
+                /**
+                 * Get walking flags
+                 * @return walking flags
+                 */
+                inline size_t           flags() const                               { return nFlags;        }
+
+                /**
+                 * Set number of threads used for walking, the calling thread is also counted
+                 * @param threads number of threads, 0 means the number of CPU cores
+                 */
+                inline void             set_threads(size_t threads)                 { nThreads = threads;   }
+
+                /**
+                 * Get number of threads used for walking
+                 * @return number of threads used for walking, 0 means the number of CPU cores
+                 */
+                inline size_t           threads() const                             { return nThreads;      }
+
+                /**
+                 * Set maximum depth of the walk
+                 * @param depth maximum depth, 0 means to read only the root directory
+                 */
+                inline void             set_max_depth(size_t depth)                 { nMaxDepth = depth;    }
+
+                /**
+                 * Get maximum depth of the walk
+                 * @return maximum depth of the walk
+                 */
+                inline size_t           max_depth() const                           { return nMaxDepth;     }
+
+                /**
+                 * Set filter for entries reported to the handler. The filter is applied to the
+                 * path relative to the root directory and does not affect the walk
+                 * @param filter filter, NULL to report all entries
+                 */
+                inline void             set_filter(const PathPattern *filter)       { pFilter = filter;     }
+
+                /**
+                 * Set filter for excluded entries. The excluded entries are not reported to the
+                 * handler and excluded directories are not entered
+                 * @param exclude filter, NULL to exclude nothing
+                 */
+                inline void             set_exclude(const PathPattern *exclude)     { pExclude = exclude;   }
+
+            public:
+                /**
+                 * Walk the directory tree, the method returns when the whole tree has been walked
+                 * or the walk has been aborted
+                 * @param path path to the root directory
+                 * @param handler handler of directory entries
+                 * @return status of operation
+                 */
+                status_t                walk(const char *path, IDirWalkHandler *handler);
+
+                /**
+                 * Walk the directory tree, the method returns when the whole tree has been walked
+                 * or the walk has been aborted
+                 * @param path path to the root directory
+                 * @param handler handler of directory entries
+                 * @return status of operation
+                 */
+                status_t                walk(const LSPString *path, IDirWalkHandler *handler);
+
+                /**
+                 * Walk the directory tree, the method returns when the whole tree has been walked
+                 * or the walk has been aborted
+                 * @param path path to the root directory
+                 * @param handler handler of directory entries
+                 * @return status of operation
+                 */
+                status_t                walk(const Path *path, IDirWalkHandler *handler);
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_DIRWALKER_H_ */
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_DIRWATCHER_H_
+#define LSP_PLUG_IN_IO_DIRWATCHER_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/io/IDirWalkHandler.h>
+#include <lsp-plug.in/io/IDirWatchHandler.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/lltl/pphash.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Directory watcher, reports changes of the directory tree. On Linux the watcher
+         * relies on inotify, on other systems or when inotify is not available the watcher
+         * periodically re-scans the directory tree and compares it with the previous state.
+         * Bursts of events are coalesced: for example, creation and following modifications
+         * of the file are reported as single creation event.
+         *
+         * The watcher is not thread-safe and should be polled from a single thread.
+         */
+        class DirWatcher: private IDirWalkHandler
+        {
+            public:
+                enum flags_t
+                {
+                    WATCH_RECURSIVE = 1 << 0,       // Watch all subdirectories
+                    WATCH_POLL      = 1 << 1,       // Force the polling mode
+
+                    WATCH_NONE      = 0
+                };
+
+                enum watch_mode_t
+                {
+                    MODE_NONE,                      // The watcher is not opened
+                    MODE_NOTIFY,                    // The watcher receives notifications from the system
+                    MODE_POLL                       // The watcher periodically re-scans the directory tree
+                };
+
+            protected:
+                typedef struct event_t
+                {
+                    dir_event_t::event_t    nType;      // Type of event
+                    bool                    bDirectory; // The entry is a directory
+                    uint32_t                nCookie;    // Cookie of pending move, non-zero until the destination is known
+                    char                   *sPath;      // Path to the entry
+                    char                   *sOldPath;   // Previous path for rename event
+                } event_t;
+
+                typedef struct watch_t
+                {
+                    int                     nWd;        // Watch descriptor
+                    char                   *sPath;      // Path to the directory relative to the root
+                } watch_t;
+
+                typedef struct snapshot_t
+                {
+                    fattr_t::ftype_t        nType;      // Type of the entry
+                    wsize_t                 nSize;      // Size of the entry
+                    wsize_t                 nMTime;     // Modification time
+                } snapshot_t;
+
+                typedef lltl::pphash<char, snapshot_t> snapshot_map_t;
+
+            private:
+                LSPString                   sRoot;
+                char                       *sNative;
+                size_t                      nFlags;
+                watch_mode_t                enMode;
+                size_t                      nCoalesce;
+                size_t                      nInterval;
+
+                int                         hNotify;
+                lltl::parray<watch_t>       vWatches;
+
+                lltl::parray<event_t>       vEvents;
+                lltl::pphash<char, event_t> vIndex;
+
+                snapshot_map_t             *pSnapshot;
+                snapshot_map_t             *pScan;
+                system::time_millis_t       nLastScan;
+                const char                 *sBase;
+                bool                        bReport;
+
+            private:
+                static event_t             *create_event(dir_event_t::event_t type, const char *path, bool directory);
+                static void                 destroy_event(event_t *ev);
+                static void                 destroy_snapshot(snapshot_map_t *map);
+
+            private:
+                virtual status_t            on_entry(const dir_entry_t *entry) override;
+                virtual status_t            on_error(const char *path, status_t code) override;
+
+            private:
+                void                        drop_events();
+                void                        drop_event(event_t *ev);
+                status_t                    add_event(dir_event_t::event_t type, const char *path, bool directory);
+                status_t                    add_rescan();
+                status_t                    add_rename(const char *from, const char *to, bool directory);
+                status_t                    move_from(const char *path, bool directory, uint32_t cookie);
+                status_t                    move_to(const char *path, bool directory, uint32_t cookie);
+                status_t                    complete_moves();
+                status_t                    fetch(size_t timeout);
+                status_t                    dispatch(IDirWatchHandler *handler);
+
+                status_t                    scan(snapshot_map_t *map);
+                status_t                    rescan();
+                status_t                    start_polling();
+
+            #if defined(PLATFORM_LINUX)
+                ssize_t                     find_watch(int wd) const;
+                status_t                    add_watch(const char *path);
+                status_t                    add_tree(const char *path, bool report);
+                status_t                    watch_subtree(const char *path);
+                void                        remove_watch(size_t index);
+                void                        remove_watches(const char *path);
+                status_t                    rename_watches(const char *from, const char *to);
+                status_t                    read_notify(size_t timeout);
+                status_t                    process_notify(int wd, uint32_t mask, uint32_t cookie, const char *name);
+            #endif /* PLATFORM_LINUX */
+
+            public:
+                explicit DirWatcher();
+                DirWatcher(const DirWatcher &) = delete;
+                DirWatcher(DirWatcher &&) = delete;
+                virtual ~DirWatcher() override;
+
+                DirWatcher & operator = (const DirWatcher &) = delete;
+                DirWatcher & operator = (DirWatcher &&) = delete;
+
+            public:
+                /**
+                 * Set the coalescing delay: after receiving the first event the watcher waits
+                 * until no new events arrive during this delay before reporting them
+                 * @param delay coalescing delay in milliseconds
+                 */
+                inline void                 set_coalesce_delay(size_t delay)        { nCoalesce = delay;        }
+
+                /**
+                 * Get the coalescing delay
+                 * @return coalescing delay in milliseconds
+                 */
+                inline size_t               coalesce_delay() const                  { return nCoalesce;         }
+
+                /**
+                 * Set the interval between re-scans of the directory tree in polling mode
+                 * @param interval interval in milliseconds
+                 */
+                inline void                 set_poll_interval(size_t interval)      { nInterval = interval;     }
+
+                /**
+                 * Get the interval between re-scans of the directory tree in polling mode
+                 * @return interval in milliseconds
+                 */
+                inline size_t               poll_interval() const                   { return nInterval;         }
+
+                /**
+                 * Get the current mode of the watcher. The watcher may switch from notification
+                 * to polling mode if the system runs out of notification resources
+                 * @return current mode of the watcher
+                 */
+                inline watch_mode_t         mode() const                            { return enMode;            }
+
+                /**
+                 * Check that watcher is opened
+                 * @return true if watcher is opened
+                 */
+                inline bool                 is_opened() const                       { return enMode != MODE_NONE; }
+
+                /**
+                 * Get number of events pending for dispatch
+                 * @return number of events pending for dispatch
+                 */
+                inline size_t               pending() const                         { return vEvents.size();    }
+
+            public:
+                /**
+                 * Start watching the directory
+                 * @param path path to the directory
+                 * @param flags watching flags
+                 * @return status of operation
+                 */
+                status_t                    open(const char *path, size_t flags = WATCH_RECURSIVE);
+
+                /**
+                 * Start watching the directory
+                 * @param path path to the directory
+                 * @param flags watching flags
+                 * @return status of operation
+                 */
+                status_t                    open(const LSPString *path, size_t flags = WATCH_RECURSIVE);
+
+                /**
+                 * Start watching the directory
+                 * @param path path to the directory
+                 * @param flags watching flags
+                 * @return status of operation
+                 */
+                status_t                    open(const Path *path, size_t flags = WATCH_RECURSIVE);
+
+                /**
+                 * Stop watching the directory and drop all pending events
+                 * @return status of operation
+                 */
+                status_t                    close();
+
+                /**
+                 * Wait for changes of the directory tree and report them to the handler
+                 * @param handler handler of events
+                 * @param timeout maximum time to wait for the first event in milliseconds,
+                 *   zero means to report only events that already happened
+                 * @return status of operation, STATUS_TIMED_OUT if no changes have happened
+                 */
+                status_t                    poll(IDirWatchHandler *handler, size_t timeout = 0);
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_DIRWATCHER_H_ */
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_IDIRWALKHANDLER_H_
+#define LSP_PLUG_IN_IO_IDIRWALKHANDLER_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/io/Path.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Directory entry reported by the directory walker. All pointers are valid
+         * only during the call of the handler.
+         */
+        typedef struct dir_entry_t
+        {
+            const char         *path;       // Full path to the entry in native encoding (UTF-8 on Windows)
+            const char         *relative;   // Path to the entry relative to the root directory, points to the tail of the path
+            const char         *name;       // Name of the entry, points to the tail of the path
+            size_t              depth;      // Depth of the entry, 0 for the entries of the root directory
+            fattr_t::ftype_t    type;       // Type of the entry
+            const fattr_t      *attr;       // File attributes, NULL if the walker has not been asked to provide them
+        } dir_entry_t;
+
+        /**
+         * Handler of the directory walker. When the walker uses more than one thread, the
+         * methods of the handler are called concurrently from different threads.
+         */
+        class IDirWalkHandler
+        {
+            public:
+                IDirWalkHandler();
+                IDirWalkHandler(const IDirWalkHandler &) = delete;
+                IDirWalkHandler(IDirWalkHandler &&) = delete;
+                virtual ~IDirWalkHandler();
+
+                IDirWalkHandler & operator = (const IDirWalkHandler &) = delete;
+                IDirWalkHandler & operator = (IDirWalkHandler &&) = delete;
+
+            public:
+                /**
+                 * Process the directory entry
+                 * @param entry directory entry
+                 * @return STATUS_OK to continue, STATUS_SKIP to prevent walker from entering
+                 *   the directory, any other code to abort the walk
+                 */
+                virtual status_t    on_entry(const dir_entry_t *entry);
+
+                /**
+                 * Process the error that occurred while reading the directory
+                 * @param path path to the directory in native encoding (UTF-8 on Windows)
+                 * @param code error code
+                 * @return STATUS_OK to ignore the error and continue, any other code to abort the walk
+                 */
+                virtual status_t    on_error(const char *path, status_t code);
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_IDIRWALKHANDLER_H_ */
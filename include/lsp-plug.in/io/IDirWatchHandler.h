@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_IDIRWATCHHANDLER_H_
+#define LSP_PLUG_IN_IO_IDIRWATCHHANDLER_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Change of the directory tree reported by the directory watcher. All pointers
+         * are valid only during the call of the handler.
+         */
+        typedef struct dir_event_t
+        {
+            enum event_t
+            {
+                EV_CREATE,      // Entry has been created
+                EV_DELETE,      // Entry has been deleted
+                EV_MODIFY,      // Contents or attributes of the entry have been modified
+                EV_RENAME,      // Entry has been renamed, old_path contains the previous path
+                EV_RESCAN       // Some events have been lost, the whole tree should be re-scanned
+            };
+
+            event_t             type;       // Type of event
+            const char         *path;       // Path to the entry relative to the watched directory in native encoding
+            const char         *old_path;   // Previous path to the entry for EV_RENAME, NULL otherwise
+            bool                directory;  // The entry is a directory
+        } dir_event_t;
+
+        /**
+         * Handler of the directory watcher events
+         */
+        class IDirWatchHandler
+        {
+            public:
+                IDirWatchHandler();
+                IDirWatchHandler(const IDirWatchHandler &) = delete;
+                IDirWatchHandler(IDirWatchHandler &&) = delete;
+                virtual ~IDirWatchHandler();
+
+                IDirWatchHandler & operator = (const IDirWatchHandler &) = delete;
+                IDirWatchHandler & operator = (IDirWatchHandler &&) = delete;
+
+            public:
+                /**
+                 * Process the event
+                 * @param event event to process
+                 * @return STATUS_OK to continue, any other code to stop processing, the
+                 *   events that have not been processed will be reported on the next poll
+                 */
+                virtual status_t    on_event(const dir_event_t *event);
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_IDIRWATCHHANDLER_H_ */
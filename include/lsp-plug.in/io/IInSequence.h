@@ -116,6 +116,28 @@ namespace lsp
                  */
                 virtual status_t    reset();
 
+                /**
+                 * Obtain the span of characters that can be read from the sequence without
+                 * copying. Obtaining the span does not change the read position of the sequence,
+                 * the consume() method should be called to advance it. The span remains valid
+                 * until the next call of any other method of the sequence.
+                 *
+                 * @param ptr pointer to store the pointer to the first character of the span
+                 * @param len pointer to store the number of characters in the span, always positive on success
+                 * @return status of operation
+                 *        - STATUS_EOF if there is no more data in the sequence
+                 *        - STATUS_NOT_SUPPORTED if feature is not supported by this sequence
+                 */
+                virtual status_t    peek_span(const lsp_wchar_t **ptr, size_t *len);
+
+                /**
+                 * Advance the read position of the sequence by the number of characters
+                 * previously obtained by the peek_span() call
+                 *
+                 * @param count number of characters to consume, should not be greater than the span length
+                 * @return number of consumed characters or negative error code
+                 */
+                virtual ssize_t     consume(size_t count);
         };
 
     } /* namespace io */
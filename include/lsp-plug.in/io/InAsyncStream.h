@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_INASYNCSTREAM_H_
+#define LSP_PLUG_IN_IO_INASYNCSTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/io/IInStream.h>
+#include <lsp-plug.in/ipc/Condition.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
+#include <lsp-plug.in/ipc/ITask.h>
+#include <lsp-plug.in/ipc/Thread.h>
+
+#define IO_ASYNC_DEFAULT_DEPTH          4
+#define IO_ASYNC_DEFAULT_BUF_SIZE       0x10000
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Input stream that reads the wrapped stream ahead in background into the ring
+         * of buffers while the caller processes the data that has already been read.
+         * The read-ahead is performed by the dedicated thread or by the task submitted
+         * to the executor. If there is no data read ahead and the read-ahead is not in
+         * progress, the data is read on the caller's thread.
+         *
+         * The wrapped stream should not be accessed directly while it is wrapped.
+         */
+        class InAsyncStream: public IInStream
+        {
+            private:
+                class FillTask: public ipc::ITask
+                {
+                    private:
+                        InAsyncStream      *pStream;
+
+                    public:
+                        explicit FillTask(InAsyncStream *stream);
+                        FillTask(const FillTask &) = delete;
+                        FillTask(FillTask &&) = delete;
+                        virtual ~FillTask() override;
+
+                        FillTask & operator = (const FillTask &) = delete;
+                        FillTask & operator = (FillTask &&) = delete;
+
+                    public:
+                        virtual status_t    run() override;
+                };
+
+                typedef struct buffer_t
+                {
+                    uint8_t            *data;           // Buffer data
+                    size_t              size;           // Number of bytes in the buffer
+                } buffer_t;
+
+            private:
+                IInStream          *pIS;            // Input stream
+                size_t              nWrapFlags;     // Wrap flags
+                ipc::IExecutor     *pExecutor;      // Executor for read-ahead, NULL if thread is used
+                ipc::Thread        *pThread;        // Read-ahead thread
+                FillTask            sTask;          // Read-ahead task for the executor
+                ipc::Condition      sCond;          // Synchronization of the consumer and the read-ahead
+                uint8_t            *pData;          // Allocated data
+                buffer_t           *vBuffers;       // Ring of buffers
+                size_t              nDepth;         // Number of buffers in the ring
+                size_t              nBufSize;       // Size of each buffer
+                size_t              nHead;          // Index of the buffer being consumed
+                size_t              nFilled;        // Number of filled buffers
+                size_t              nOffset;        // Read offset in the head buffer
+                wsize_t             nPosition;      // Current read position
+                status_t            nFillStatus;    // Status of read-ahead: OK, EOF or error
+                bool                bActive;        // Read-ahead task is submitted or running
+                bool                bBusy;          // The wrapped stream is being read
+                bool                bStop;          // Read-ahead should be stopped
+
+            private:
+                static status_t     thread_proc(void *arg);
+                void                run_thread();
+                void                run_task();
+                bool                fill();
+                void                kick();
+                void                advance();
+                wsize_t             consume(wsize_t amount);
+                status_t            wait_data();
+                void                start();
+                void                stop();
+                void                acquire();
+                void                release();
+                void                reset();
+                status_t            do_close();
+
+            public:
+                /**
+                 * Create stream
+                 * @param executor executor to perform read-ahead, the dedicated thread
+                 *   is used if NULL. The executor should be running while the stream is open
+                 */
+                explicit InAsyncStream(ipc::IExecutor *executor = NULL);
+                InAsyncStream(const InAsyncStream &) = delete;
+                InAsyncStream(InAsyncStream &&) = delete;
+                virtual ~InAsyncStream() override;
+
+                InAsyncStream & operator = (const InAsyncStream &) = delete;
+                InAsyncStream & operator = (InAsyncStream &&) = delete;
+
+            public:
+                /** Wrap input stream and start read-ahead
+                 *
+                 * @param is input stream
+                 * @param flags wrapping flags
+                 * @param depth number of buffers to read ahead
+                 * @param buf_size size of each buffer
+                 * @return status of operation
+                 */
+                status_t            wrap(IInStream *is, size_t flags = 0,
+                                        size_t depth = IO_ASYNC_DEFAULT_DEPTH,
+                                        size_t buf_size = IO_ASYNC_DEFAULT_BUF_SIZE);
+
+                /**
+                 * Get number of buffers to read ahead
+                 * @return number of buffers to read ahead
+                 */
+                inline size_t       depth() const           { return nDepth;        }
+
+                /**
+                 * Get size of each read-ahead buffer
+                 * @return size of each read-ahead buffer
+                 */
+                inline size_t       buffer_size() const     { return nBufSize;      }
+
+            public: // io::IInStream
+                /**
+                 * Get number of bytes that have been read ahead and can be read
+                 * without blocking
+                 * @return number of bytes that can be read without blocking
+                 */
+                virtual wssize_t    avail() override;
+                virtual wssize_t    position() override;
+                virtual ssize_t     read(void *dst, size_t count) override;
+                virtual wssize_t    seek(wsize_t position) override;
+                virtual wssize_t    skip(wsize_t amount) override;
+                virtual status_t    close() override;
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_INASYNCSTREAM_H_ */
@@ -37,13 +37,22 @@ namespace lsp
             protected:
                 IInStream      *pIS;            // Input stream
                 size_t          nWrapFlags;     // Wrap flags
-                umword_t        nBuffer;        // Fixed-size buffer
-                size_t          nBits;          // Number of bits stored
+                uint64_t        nBuffer;        // Bit cache, MSB-aligned
+                size_t          nBits;          // Number of bits stored in the cache
+                uint8_t        *vData;          // Read-ahead buffer
+                size_t          nDataOff;       // Read position in the read-ahead buffer
+                size_t          nDataSize;      // Number of bytes stored in the read-ahead buffer
 
             protected:
                 status_t        fill();
-                void            unread(umword_t v, size_t bits);
+                status_t        fetch();
                 status_t        do_close();
+                ssize_t         read_bits(uint64_t *value, size_t bits);
+
+                template <class T>
+                ssize_t         read_array(T *dst, size_t count, size_t bits);
+                template <class T>
+                ssize_t         read_varint(T *dst, size_t count, size_t bits, size_t step);
 
             public:
                 explicit InBitStream();
@@ -129,6 +138,40 @@ namespace lsp
                 inline ssize_t      readv(int32_t *value, size_t bits = sizeof(int32_t)*8)      { return readv(reinterpret_cast<uint32_t *>(value), bits);      }
                 ssize_t             readv(uint64_t *value, size_t bits = sizeof(uint64_t)*8);
                 inline ssize_t      readv(int64_t *value, size_t bits = sizeof(int64_t)*8)      { return readv(reinterpret_cast<uint64_t *>(value), bits);      }
+
+            public:
+                /**
+                 * Read array of values of the same bit width. The trailing value which is not
+                 * completely stored in the stream is not consumed.
+                 *
+                 * @param dst destination array to store values
+                 * @param count number of values to read
+                 * @param bits number of bits per each value
+                 * @return number of values read or negative error code
+                 */
+                ssize_t             readn(uint8_t *dst, size_t count, size_t bits = sizeof(uint8_t)*8);
+                inline ssize_t      readn(int8_t *dst, size_t count, size_t bits = sizeof(int8_t)*8)       { return readn(reinterpret_cast<uint8_t *>(dst), count, bits);  }
+                ssize_t             readn(uint16_t *dst, size_t count, size_t bits = sizeof(uint16_t)*8);
+                inline ssize_t      readn(int16_t *dst, size_t count, size_t bits = sizeof(int16_t)*8)     { return readn(reinterpret_cast<uint16_t *>(dst), count, bits); }
+                ssize_t             readn(uint32_t *dst, size_t count, size_t bits = sizeof(uint32_t)*8);
+                inline ssize_t      readn(int32_t *dst, size_t count, size_t bits = sizeof(int32_t)*8)     { return readn(reinterpret_cast<uint32_t *>(dst), count, bits); }
+                ssize_t             readn(uint64_t *dst, size_t count, size_t bits = sizeof(uint64_t)*8);
+                inline ssize_t      readn(int64_t *dst, size_t count, size_t bits = sizeof(int64_t)*8)     { return readn(reinterpret_cast<uint64_t *>(dst), count, bits); }
+
+                /**
+                 * Read array of variable-length integers. Each integer is encoded as a sequence of groups
+                 * starting with the least significant one. Each group consists of continuation flag followed
+                 * by data bits. The first group contains the specified number of data bits, each next group
+                 * contains step more bits than the previous one.
+                 *
+                 * @param dst destination array to store values
+                 * @param count number of values to read
+                 * @param bits number of data bits in the first group
+                 * @param step number of data bits to add for each next group
+                 * @return number of values read or negative error code
+                 */
+                ssize_t             readvar(uint32_t *dst, size_t count, size_t bits, size_t step = 0);
+                ssize_t             readvar(uint64_t *dst, size_t count, size_t bits, size_t step = 0);
         };
 
     } /* namespace io */
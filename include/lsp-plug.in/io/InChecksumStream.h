@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_INCHECKSUMSTREAM_H_
+#define LSP_PLUG_IN_IO_INCHECKSUMSTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/io/Checksum.h>
+#include <lsp-plug.in/io/IInStream.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Pass-through input stream that computes the checksum of all data read
+         * from the wrapped stream. Seeking is not supported since it breaks the
+         * sequence of processed data, skipped data is read and processed.
+         */
+        class InChecksumStream: public IInStream
+        {
+            private:
+                IInStream          *pIS;            // Input stream
+                size_t              nWrapFlags;     // Wrap flags
+                Checksum            sChecksum;      // Checksum of the read data
+
+            private:
+                status_t            do_close();
+
+            public:
+                explicit InChecksumStream(checksum_t type = CHECKSUM_CRC32C, uint64_t seed = 0);
+                InChecksumStream(const InChecksumStream &) = delete;
+                InChecksumStream(InChecksumStream &&) = delete;
+                virtual ~InChecksumStream() override;
+
+                InChecksumStream & operator = (const InChecksumStream &) = delete;
+                InChecksumStream & operator = (InChecksumStream &&) = delete;
+
+            public: // io::IInStream
+                virtual wssize_t    avail() override;
+                virtual wssize_t    position() override;
+                virtual ssize_t     read(void *dst, size_t count) override;
+                virtual status_t    close() override;
+
+            public:
+                /** Wrap input stream, the checksum is reset
+                 *
+                 * @param is input stream
+                 * @param flags wrapping flags
+                 * @return status of operation
+                 */
+                status_t            wrap(IInStream *is, size_t flags = 0);
+
+                /**
+                 * Select the checksum algorithm, should be called before wrapping the stream
+                 * @param type checksum algorithm
+                 * @param seed seed value, used by hashes that support seeding
+                 * @return status of operation
+                 */
+                status_t            set_checksum(checksum_t type, uint64_t seed = 0);
+
+                /**
+                 * Get the checksum accumulator
+                 * @return checksum accumulator
+                 */
+                inline const Checksum  *checksum() const        { return &sChecksum;            }
+
+                /**
+                 * Get the checksum of all data that passed through the stream
+                 * @return checksum value
+                 */
+                inline uint64_t     value() const               { return sChecksum.value();     }
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_INCHECKSUMSTREAM_H_ */
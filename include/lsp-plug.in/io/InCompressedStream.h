@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_INCOMPRESSEDSTREAM_H_
+#define LSP_PLUG_IN_IO_INCOMPRESSEDSTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/lltl/darray.h>
+#include <lsp-plug.in/io/IInStream.h>
+#include <lsp-plug.in/io/InBitStream.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/resource/buffer.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Input stream that decompresses the data written by io::OutCompressedStream.
+         * Each block is verified with CRC-32C, STATUS_CORRUPTED is returned on mismatch
+         * or if the stream is truncated. Since blocks are compressed independently, the
+         * stream supports seeking: the index of block positions is built while reading
+         * and block headers are scanned forward without decoding the skipped blocks.
+         * Seeking backwards requires the underlying stream to be seekable.
+         */
+        class InCompressedStream: public IInStream
+        {
+            private:
+                typedef struct block_t
+                {
+                    wsize_t                 raw;        // Offset of the block in decompressed data
+                    wsize_t                 offset;     // Offset of the block header in compressed data
+                } block_t;
+
+            private:
+                IInStream              *pIS;            // Input stream
+                size_t                  nWrapFlags;     // Wrap flags
+                uint8_t                *vBlock;         // Decompressed data of the current block
+                uint8_t                *vPayload;       // Compressed data of the current block
+                size_t                  nLogBlock;      // Logarithm of the block size
+                size_t                  nBlockSize;     // Size of the current block
+                size_t                  nBlockOff;      // Read offset in the current block
+                wsize_t                 nBlockStart;    // Offset of the current block in decompressed data
+                ssize_t                 nCurrent;       // Index of the current block
+                wsize_t                 nBase;          // Position of the underlying stream at wrap
+                wsize_t                 nInPos;         // Current position in the compressed data
+                bool                    bEOF;           // The terminating block header has been reached
+                lltl::darray<block_t>   vIndex;         // Index of discovered blocks
+                resource::dbuffer_t     sBuffer;        // Decompression buffer
+                InMemoryStream          sData;          // Compressed data of the block
+                InBitStream             sBits;          // Bit stream for compressed data
+
+            private:
+                status_t            do_close();
+                status_t            read_stream_header();
+                status_t            move_to(wsize_t offset);
+                status_t            fetch(void *dst, size_t count);
+                status_t            read_header(size_t index, uint32_t *size, uint32_t *payload, uint32_t *crc);
+                status_t            load_payload(size_t index, uint32_t size, uint32_t payload, uint32_t crc);
+                status_t            load_block(size_t index);
+                ssize_t             find_block(wsize_t position) const;
+
+            public:
+                explicit InCompressedStream();
+                InCompressedStream(const InCompressedStream &) = delete;
+                InCompressedStream(InCompressedStream &&) = delete;
+                virtual ~InCompressedStream() override;
+
+                InCompressedStream & operator = (const InCompressedStream &) = delete;
+                InCompressedStream & operator = (InCompressedStream &&) = delete;
+
+            public:
+                /**
+                 * Wrap input stream and read the stream header
+                 * @param is input stream with compressed data
+                 * @param flags wrapping flags
+                 * @return status of operation, STATUS_BAD_FORMAT if the stream header is invalid
+                 */
+                status_t            wrap(IInStream *is, size_t flags = 0);
+
+                /**
+                 * Open file with compressed data
+                 * @param path path to the file
+                 * @return status of operation
+                 */
+                status_t            open(const char *path);
+                status_t            open(const LSPString *path);
+                status_t            open(const Path *path);
+
+                /**
+                 * Get the block size of the stream
+                 * @return block size
+                 */
+                inline size_t       block_size() const          { return size_t(1) << nLogBlock;    }
+
+            public: // io::IInStream
+                virtual wssize_t    avail() override;
+                virtual wssize_t    position() override;
+                virtual ssize_t     read(void *dst, size_t count) override;
+                virtual wssize_t    seek(wsize_t position) override;
+                virtual wssize_t    skip(wsize_t amount) override;
+                virtual status_t    close() override;
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_INCOMPRESSEDSTREAM_H_ */
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_INDIRECTFILESTREAM_H_
+#define LSP_PLUG_IN_IO_INDIRECTFILESTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/AlignedBufferPool.h>
+#include <lsp-plug.in/io/IInStream.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/io/Path.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        class DirectTransfer;
+
+        /**
+         * Input file stream that reads the file with direct (unbuffered) I/O bypassing
+         * the page cache, so streaming of large files does not evict other cached data.
+         * The file is read by aligned blocks of the buffer pool size into two buffers:
+         * the next block is read in background while the current one is consumed.
+         * If the file system does not support direct I/O, the file is read with regular
+         * buffered I/O using the same read-ahead scheme.
+         */
+        class InDirectFileStream: public IInStream
+        {
+            private:
+                NativeFile             *pFD;            // File descriptor
+                DirectTransfer         *pTransfer;      // Background transfer
+                AlignedBufferPool      *pPool;          // Buffer pool
+                AlignedBufferPool      *pLocalPool;     // Buffer pool owned by the stream
+                uint8_t                *vBuf[2];        // Current and read-ahead buffers
+                wsize_t                 nBufOffset;     // Offset of the current buffer in the file
+                size_t                  nBufSize;       // Number of bytes in the current buffer
+                size_t                  nBufPos;        // Read position in the current buffer
+                wsize_t                 nNextOffset;    // Offset of the read-ahead buffer in the file
+                bool                    bDirect;        // File is opened for direct I/O
+
+            private:
+                status_t            do_close();
+                status_t            load(wsize_t offset);
+                status_t            prefetch();
+                status_t            advance();
+
+            public:
+                /**
+                 * Create stream
+                 * @param pool buffer pool to obtain buffers, the stream creates its own
+                 *   pool with default settings if NULL
+                 */
+                explicit InDirectFileStream(AlignedBufferPool *pool = NULL);
+                InDirectFileStream(const InDirectFileStream &) = delete;
+                InDirectFileStream(InDirectFileStream &&) = delete;
+                virtual ~InDirectFileStream() override;
+
+                InDirectFileStream & operator = (const InDirectFileStream &) = delete;
+                InDirectFileStream & operator = (InDirectFileStream &&) = delete;
+
+            public:
+                /**
+                 * Open file for reading
+                 * @param path path to the file
+                 * @return status of operation
+                 */
+                status_t            open(const char *path);
+                status_t            open(const LSPString *path);
+                status_t            open(const Path *path);
+
+                /**
+                 * Check that the file has been opened for direct I/O
+                 * @return true if the file has been opened for direct I/O
+                 */
+                inline bool         direct() const      { return bDirect;   }
+
+            public: // io::IInStream
+                virtual wssize_t    avail() override;
+                virtual wssize_t    position() override;
+                virtual ssize_t     read(void *dst, size_t count) override;
+                virtual wssize_t    seek(wsize_t position) override;
+                virtual wssize_t    skip(wsize_t amount) override;
+                virtual status_t    close() override;
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_INDIRECTFILESTREAM_H_ */
@@ -68,6 +68,8 @@ namespace lsp
                 virtual ssize_t         skip(size_t count) override;
                 virtual status_t        mark(ssize_t limit) override;
                 virtual status_t        reset() override;
+                virtual status_t        peek_span(const lsp_wchar_t **ptr, size_t *len) override;
+                virtual ssize_t         consume(size_t count) override;
         };
 
     } /* namespace io */
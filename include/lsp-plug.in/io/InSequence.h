@@ -127,6 +127,10 @@ namespace lsp
                 virtual ssize_t     skip(size_t count);
 
                 virtual status_t    close();
+
+                virtual status_t    peek_span(const lsp_wchar_t **ptr, size_t *len);
+
+                virtual ssize_t     consume(size_t count);
         };
     }
 } /* namespace lsp */
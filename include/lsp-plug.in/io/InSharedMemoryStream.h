@@ -39,10 +39,12 @@ namespace lsp
             protected:
                 typedef struct shared_data_t
                 {
-                    uint8_t        *pData;
-                    size_t          nSize;
-                    mutable size_t  nRefs;
-                    lsp_memdrop_t   enDrop;
+                    uint8_t        *pData;          // Contiguous data
+                    uint8_t       **vChunks;        // List of chunks if data is not contiguous
+                    size_t          nSize;          // Overall size of data
+                    size_t          nChunkSize;     // Size of each chunk
+                    mutable size_t  nRefs;          // Number of references
+                    lsp_memdrop_t   enDrop;         // Drop method
                 } shared_data_t;
 
             protected:
@@ -51,6 +53,7 @@ namespace lsp
 
             protected:
                 void release_shared();
+                status_t take_chunks(OutMemoryStream *src);
 
             public:
                 explicit InSharedMemoryStream();
@@ -119,7 +122,8 @@ namespace lsp
 
                 /**
                  * Get the memory contents
-                 * @return memory contents
+                 * @return memory contents, NULL if the data has been taken from the chunked
+                 *   output memory stream
                  */
                 inline const uint8_t *data() const { return (pShared != NULL) ? pShared->pData : NULL; }
 
@@ -145,6 +149,14 @@ namespace lsp
                 void                take(InSharedMemoryStream &src);
                 void                take(InSharedMemoryStream *src);
 
+                /**
+                 * Take the data from the output memory stream. The data is not copied,
+                 * if the output memory stream operates in chunked mode, the list of chunks
+                 * is taken as is.
+                 *
+                 * @param src output memory stream to take the data
+                 * @return status of operation
+                 */
                 status_t            take(OutMemoryStream &src);
                 status_t            take(OutMemoryStream *src);
 
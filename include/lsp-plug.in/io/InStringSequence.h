@@ -67,6 +67,8 @@ namespace lsp
                 virtual status_t        close() override;
                 virtual status_t        mark(ssize_t limit) override;
                 virtual status_t        reset() override;
+                virtual status_t        peek_span(const lsp_wchar_t **ptr, size_t *len) override;
+                virtual ssize_t         consume(size_t count) override;
         };
     } /* namespace io */
 } /* namespace lsp */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_INTEESTREAM_H_
+#define LSP_PLUG_IN_IO_INTEESTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/io/IInStream.h>
+#include <lsp-plug.in/io/IOutStream.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Pass-through input stream that writes a copy of all data read from the
+         * wrapped input stream to the output stream. Allows to attach additional
+         * processing stages like hashing or storing to the chain of input streams.
+         * Seeking is not supported since it breaks the sequence of copied data,
+         * skipped data is read and copied.
+         */
+        class InTeeStream: public IInStream
+        {
+            private:
+                IInStream          *pIS;            // Input stream
+                IOutStream         *pOS;            // Output stream for the copy of data
+                size_t              nInFlags;       // Wrap flags of the input stream
+                size_t              nOutFlags;      // Wrap flags of the output stream
+                wsize_t             nCopied;        // Number of bytes copied to the output stream
+
+            private:
+                status_t            do_close();
+
+            public:
+                explicit InTeeStream();
+                InTeeStream(const InTeeStream &) = delete;
+                InTeeStream(InTeeStream &&) = delete;
+                virtual ~InTeeStream() override;
+
+                InTeeStream & operator = (const InTeeStream &) = delete;
+                InTeeStream & operator = (InTeeStream &&) = delete;
+
+            public: // io::IInStream
+                virtual wssize_t    avail() override;
+                virtual wssize_t    position() override;
+                virtual ssize_t     read(void *dst, size_t count) override;
+                virtual status_t    close() override;
+
+            public:
+                /** Wrap input and output streams
+                 *
+                 * @param is input stream
+                 * @param in_flags wrapping flags for the input stream
+                 * @param os output stream to write the copy of data
+                 * @param out_flags wrapping flags for the output stream
+                 * @return status of operation
+                 */
+                status_t            wrap(IInStream *is, size_t in_flags, IOutStream *os, size_t out_flags);
+
+                /**
+                 * Get number of bytes copied to the output stream
+                 * @return number of bytes copied to the output stream
+                 */
+                inline wsize_t      copied() const              { return nCopied;           }
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_INTEESTREAM_H_ */
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_OUTATOMICFILESTREAM_H_
+#define LSP_PLUG_IN_IO_OUTATOMICFILESTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/io/IOutStream.h>
+#include <lsp-plug.in/io/SyncBatch.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Output file stream that atomically replaces the target file. All data is written
+         * into the temporary file located in the same directory as the target file. On close()
+         * the temporary file is flushed to the storage, renamed over the target file and the
+         * directory is synchronized. Any failure or destruction of the stream without calling
+         * close() keeps the original file untouched and removes the temporary file.
+         * If the target is a symbolic link, the file it finally points to is replaced and
+         * the link is kept.
+         */
+        class OutAtomicFileStream: public IOutStream
+        {
+            private:
+                NativeFile         *pFD;            // Temporary file
+                SyncBatch          *pBatch;         // Batch for deferred directory synchronization
+                LSPString           sPath;          // Path to the target file
+                LSPString           sTemp;          // Path to the temporary file
+                LSPString           sDir;           // Directory containing both files
+                status_t            nFailure;       // First write error, STATUS_OK if none
+
+            private:
+                status_t            create_temp();
+                status_t            do_commit();
+                void                do_abort();
+                void                set_failure(status_t code);
+
+            public:
+                explicit OutAtomicFileStream();
+                OutAtomicFileStream(const OutAtomicFileStream &) = delete;
+                OutAtomicFileStream(OutAtomicFileStream &&) = delete;
+                virtual ~OutAtomicFileStream() override;
+
+                OutAtomicFileStream & operator = (const OutAtomicFileStream &) = delete;
+                OutAtomicFileStream & operator = (OutAtomicFileStream &&) = delete;
+
+            public:
+                /**
+                 * Open stream for replacing the file
+                 * @param path path to the target file
+                 * @param batch optional batch to defer synchronization of the directory,
+                 *   should stay alive until the stream is closed
+                 * @return status of operation
+                 */
+                status_t            open(const char *path, SyncBatch *batch = NULL);
+                status_t            open(const LSPString *path, SyncBatch *batch = NULL);
+                status_t            open(const Path *path, SyncBatch *batch = NULL);
+
+                /**
+                 * Discard all written data, remove the temporary file and close the stream.
+                 * The target file stays untouched.
+                 * @return status of operation
+                 */
+                status_t            abort();
+
+                /**
+                 * Get path to the temporary file
+                 * @return path to the temporary file or NULL if stream is closed
+                 */
+                inline const LSPString *temp_path() const   { return (pFD != NULL) ? &sTemp : NULL; }
+
+            public: // io::IOutStream
+                virtual wssize_t    position() override;
+                virtual ssize_t     write(const void *buf, size_t count) override;
+                virtual wssize_t    seek(wsize_t position) override;
+                virtual status_t    flush() override;
+
+                /**
+                 * Commit all written data: synchronize the temporary file, rename it over the target
+                 * file and synchronize the directory (or defer the synchronization to the batch).
+                 * If any write error occurred before, the data is discarded and the code of the first
+                 * error is returned.
+                 * @return status of operation
+                 */
+                virtual status_t    close() override;
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_OUTATOMICFILESTREAM_H_ */
@@ -40,8 +40,10 @@ namespace lsp
             private:
                 IOutStream     *pOS;            // Output stream for writing
                 size_t          nWrapFlags;     // Wrapping flags
-                umword_t        nBuffer;        // Fixed-size buffer
-                size_t          nBits;          // Number of bits stored
+                uint64_t        nBuffer;        // Bit cache, LSB-aligned
+                size_t          nBits;          // Number of bits stored in the cache
+                uint8_t        *vData;          // Output buffer
+                size_t          nDataSize;      // Number of bytes stored in the output buffer
 
             public:
                 explicit OutBitStream();
@@ -54,6 +56,15 @@ namespace lsp
 
             protected:
                 status_t            do_flush_buffer();
+                status_t            flush_data();
+                status_t            spill();
+                status_t            write_bits(uint64_t value, size_t bits);
+                status_t            write_varint(uint64_t value, size_t bits, size_t step);
+
+                template <class T>
+                status_t            write_array(const T *src, size_t count, size_t bits);
+                template <class T>
+                status_t            write_varint(const T *src, size_t count, size_t bits, size_t step);
 
             public:
                 status_t            open(const char *path, size_t mode);
@@ -87,6 +98,49 @@ namespace lsp
                 inline status_t     writev(int32_t value, size_t bits = sizeof(int32_t)*8)      { return writev(uint32_t(value), bits);  }
                 status_t            writev(uint64_t value, size_t bits = sizeof(uint64_t)*8);
                 inline status_t     writev(int64_t value, size_t bits = sizeof(int64_t)*8)      { return writev(uint64_t(value), bits);  }
+
+            public:
+                /**
+                 * Write array of values of the same bit width
+                 *
+                 * @param src source array of values
+                 * @param count number of values to write
+                 * @param bits number of bits per each value
+                 * @return status of operation
+                 */
+                status_t            writen(const uint8_t *src, size_t count, size_t bits = sizeof(uint8_t)*8);
+                inline status_t     writen(const int8_t *src, size_t count, size_t bits = sizeof(int8_t)*8)        { return writen(reinterpret_cast<const uint8_t *>(src), count, bits);  }
+                status_t            writen(const uint16_t *src, size_t count, size_t bits = sizeof(uint16_t)*8);
+                inline status_t     writen(const int16_t *src, size_t count, size_t bits = sizeof(int16_t)*8)      { return writen(reinterpret_cast<const uint16_t *>(src), count, bits); }
+                status_t            writen(const uint32_t *src, size_t count, size_t bits = sizeof(uint32_t)*8);
+                inline status_t     writen(const int32_t *src, size_t count, size_t bits = sizeof(int32_t)*8)      { return writen(reinterpret_cast<const uint32_t *>(src), count, bits); }
+                status_t            writen(const uint64_t *src, size_t count, size_t bits = sizeof(uint64_t)*8);
+                inline status_t     writen(const int64_t *src, size_t count, size_t bits = sizeof(int64_t)*8)      { return writen(reinterpret_cast<const uint64_t *>(src), count, bits); }
+
+                /**
+                 * Write variable-length integer. The integer is encoded as a sequence of groups starting
+                 * with the least significant one. Each group consists of continuation flag followed
+                 * by data bits. The first group contains the specified number of data bits, each next group
+                 * contains step more bits than the previous one.
+                 *
+                 * @param value value to write
+                 * @param bits number of data bits in the first group
+                 * @param step number of data bits to add for each next group
+                 * @return status of operation
+                 */
+                status_t            writevar(uint64_t value, size_t bits, size_t step = 0);
+
+                /**
+                 * Write array of variable-length integers, see writevar() for the encoding details
+                 *
+                 * @param src source array of values
+                 * @param count number of values to write
+                 * @param bits number of data bits in the first group
+                 * @param step number of data bits to add for each next group
+                 * @return status of operation
+                 */
+                status_t            writevar(const uint32_t *src, size_t count, size_t bits, size_t step);
+                status_t            writevar(const uint64_t *src, size_t count, size_t bits, size_t step);
         };
 
     } /* namespace io */
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_OUTBUFSTREAM_H_
+#define LSP_PLUG_IN_IO_OUTBUFSTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/File.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/io/IOutStream.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * This class works as a proxy around the output stream and accumulates
+         * small writes in the internal buffer. The buffer is written to the
+         * underlying stream when it becomes full, when flush policy requires
+         * it or when the flush(), seek() or close() method is called. Writes
+         * that are larger than the buffer capacity are passed directly to
+         * the underlying stream.
+         */
+        class OutBufStream: public IOutStream
+        {
+            public:
+                /**
+                 * Flush policy of the buffer
+                 */
+                enum flush_policy_t
+                {
+                    FLUSH_FULL,         // Write the buffer to the underlying stream only when it becomes full
+                    FLUSH_LINE,         // Additionally write the buffer when new line character has been written
+                    FLUSH_ALWAYS        // Write the buffer to the underlying stream on each write() call
+                };
+
+            private:
+                IOutStream         *pOS;            // Output stream
+                uint8_t            *vBuffer;        // Pointer to the buffer
+                uint32_t            nBufCap;        // Overall buffer capacity
+                uint32_t            nBufSize;       // Number of bytes pending in the buffer
+                wsize_t             nPosition;      // Position of the buffer in the stream
+                size_t              nWrapFlags;     // Wrap flags
+                flush_policy_t      enPolicy;       // Flush policy
+
+            private:
+                bool                init_buffer();
+                status_t            flush_buffer();
+                status_t            do_close();
+                status_t            do_wrap(IOutStream *os, size_t flags);
+                ssize_t             write_direct(const void *buf, size_t count);
+
+            public:
+                explicit OutBufStream(size_t buf_size = 0x1000);
+                OutBufStream(const OutBufStream &) = delete;
+                OutBufStream(OutBufStream &&) = delete;
+                virtual ~OutBufStream() override;
+
+                OutBufStream & operator = (const OutBufStream &) = delete;
+                OutBufStream & operator = (OutBufStream &&) = delete;
+
+            public: // io::IOutStream
+                virtual wssize_t    position() override;
+                virtual ssize_t     write(const void *buf, size_t count) override;
+                virtual status_t    write_byte(int v) override;
+                virtual wssize_t    seek(wsize_t position) override;
+                virtual status_t    flush() override;
+                virtual status_t    close() override;
+
+            public: // Open operations
+                /** Open output stream associated with file. The Writer should be in closed state.
+                 *
+                 * @param path file location path
+                 * @param mode open mode
+                 * @return status of operation
+                 */
+                status_t            open(const char *path, size_t mode);
+
+                /** Open output stream associated with file. The Writer should be in closed state.
+                 *
+                 * @param path file location path
+                 * @param mode open mode
+                 * @return status of operation
+                 */
+                status_t            open(const LSPString *path, size_t mode);
+
+                /** Open output stream associated with file. The Writer should be in closed state.
+                 *
+                 * @param path file location path
+                 * @param mode open mode
+                 * @return status of operation
+                 */
+                status_t            open(const Path *path, size_t mode);
+
+            public: // Wrap operations
+                /** Wrap stdio file descriptor. The Writer should be in closed state.
+                 *
+                 * @param fd file descriptor
+                 * @param close close file descriptor on close()
+                 * @return status of operation
+                 */
+                status_t            wrap(FILE *fd, bool close);
+
+                /** Wrap native file descriptor. The Writer should be in closed state.
+                 *
+                 * @param fd file descriptor
+                 * @param close close file descriptor on close()
+                 * @return status of operation
+                 */
+                status_t            wrap_native(fhandle_t fd, bool close);
+
+                /** Wrap file descriptor. The Writer should be in closed state.
+                 *
+                 * @param fd file descriptor
+                 * @param flags wrapping flags
+                 * @return status of operation
+                 */
+                status_t            wrap(File *fd, size_t flags);
+
+                /** Wrap output stream
+                 *
+                 * @param os output stream
+                 * @param flags wrapping flags
+                 * @return status of operation
+                 */
+                status_t            wrap(IOutStream *os, size_t flags = 0);
+
+            public: // Buffering operations
+                /**
+                 * Set flush policy of the buffer
+                 * @param policy flush policy
+                 */
+                void                set_flush_policy(flush_policy_t policy);
+
+                /**
+                 * Get flush policy of the buffer
+                 * @return flush policy
+                 */
+                inline flush_policy_t flush_policy() const          { return enPolicy;      }
+
+                /**
+                 * Get start position of the area covered by buffer
+                 * @return start position
+                 */
+                inline wssize_t     buffer_position() const         { return nPosition;     }
+
+                /**
+                 * Get number of bytes pending in the buffer
+                 * @return number of bytes pending in the buffer
+                 */
+                inline ssize_t      buffer_size() const             { return nBufSize;      }
+
+                /**
+                 * Get the maximum possible number of bytes that can be stored in the buffer
+                 * @return maximum possible number of bytes stored in the buffer
+                 */
+                inline ssize_t      buffer_capacity() const         { return nBufCap;       }
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_OUTBUFSTREAM_H_ */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_OUTCHECKSUMSTREAM_H_
+#define LSP_PLUG_IN_IO_OUTCHECKSUMSTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/io/Checksum.h>
+#include <lsp-plug.in/io/IOutStream.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Pass-through output stream that computes the checksum of all data written
+         * to the wrapped stream. Seeking is not supported since it breaks the sequence
+         * of processed data.
+         */
+        class OutChecksumStream: public IOutStream
+        {
+            private:
+                IOutStream         *pOS;            // Output stream
+                size_t              nWrapFlags;     // Wrap flags
+                Checksum            sChecksum;      // Checksum of the written data
+
+            private:
+                status_t            do_close();
+
+            public:
+                explicit OutChecksumStream(checksum_t type = CHECKSUM_CRC32C, uint64_t seed = 0);
+                OutChecksumStream(const OutChecksumStream &) = delete;
+                OutChecksumStream(OutChecksumStream &&) = delete;
+                virtual ~OutChecksumStream() override;
+
+                OutChecksumStream & operator = (const OutChecksumStream &) = delete;
+                OutChecksumStream & operator = (OutChecksumStream &&) = delete;
+
+            public: // io::IOutStream
+                virtual wssize_t    position() override;
+                virtual ssize_t     write(const void *buf, size_t count) override;
+                virtual status_t    flush() override;
+                virtual status_t    close() override;
+
+            public:
+                /** Wrap output stream, the checksum is reset
+                 *
+                 * @param os output stream
+                 * @param flags wrapping flags
+                 * @return status of operation
+                 */
+                status_t            wrap(IOutStream *os, size_t flags = 0);
+
+                /**
+                 * Select the checksum algorithm, should be called before wrapping the stream
+                 * @param type checksum algorithm
+                 * @param seed seed value, used by hashes that support seeding
+                 * @return status of operation
+                 */
+                status_t            set_checksum(checksum_t type, uint64_t seed = 0);
+
+                /**
+                 * Get the checksum accumulator
+                 * @return checksum accumulator
+                 */
+                inline const Checksum  *checksum() const        { return &sChecksum;            }
+
+                /**
+                 * Get the checksum of all data that passed through the stream
+                 * @return checksum value
+                 */
+                inline uint64_t     value() const               { return sChecksum.value();     }
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_OUTCHECKSUMSTREAM_H_ */
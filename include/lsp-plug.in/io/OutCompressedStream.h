@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_OUTCOMPRESSEDSTREAM_H_
+#define LSP_PLUG_IN_IO_OUTCOMPRESSEDSTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/IOutStream.h>
+#include <lsp-plug.in/io/OutBitStream.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/resource/buffer.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Output stream that compresses the data with the LZ-style codec of resource
+         * bundles. The data is split into independently compressed blocks, each block
+         * is protected by CRC-32C checksum. Blocks that can not be compressed are stored
+         * as is. The data can be read by io::InCompressedStream.
+         */
+        class OutCompressedStream: public IOutStream
+        {
+            private:
+                IOutStream             *pOS;            // Output stream
+                size_t                  nWrapFlags;     // Wrap flags
+                uint8_t                *vBlock;         // Block of data pending for compression
+                size_t                  nLogBlock;      // Logarithm of the block size
+                size_t                  nBlockSize;     // Number of bytes pending in the block
+                wsize_t                 nPosition;      // Number of bytes written
+                wsize_t                 nOutput;        // Number of bytes emitted to the output stream
+                bool                    bHeader;        // Stream header has been written
+                resource::cbuffer_t     sBuffer;        // Compression buffer
+                OutMemoryStream         sData;          // Compressed data of the block
+                OutBitStream            sBits;          // Bit stream for compressed data
+
+            private:
+                status_t            do_close();
+                status_t            write_header();
+                status_t            emit_block(const uint8_t *data, size_t size);
+                status_t            emit(const void *buf, size_t count);
+
+            public:
+                /**
+                 * Create compressed stream
+                 * @param log_block_size logarithm of the block size, the value is
+                 *   clamped to the range of 10 (1 KiB) to 24 (16 MiB)
+                 */
+                explicit OutCompressedStream(size_t log_block_size = 16);
+                OutCompressedStream(const OutCompressedStream &) = delete;
+                OutCompressedStream(OutCompressedStream &&) = delete;
+                virtual ~OutCompressedStream() override;
+
+                OutCompressedStream & operator = (const OutCompressedStream &) = delete;
+                OutCompressedStream & operator = (OutCompressedStream &&) = delete;
+
+            public:
+                /**
+                 * Wrap output stream
+                 * @param os output stream to write compressed data
+                 * @param flags wrapping flags
+                 * @return status of operation
+                 */
+                status_t            wrap(IOutStream *os, size_t flags = 0);
+
+                /**
+                 * Open file for writing compressed data
+                 * @param path path to the file
+                 * @param mode open mode
+                 * @return status of operation
+                 */
+                status_t            open(const char *path, size_t mode);
+                status_t            open(const LSPString *path, size_t mode);
+                status_t            open(const Path *path, size_t mode);
+
+                /**
+                 * Get the number of compressed bytes emitted to the underlying stream
+                 * @return number of compressed bytes
+                 */
+                inline wsize_t      compressed_size() const     { return nOutput;       }
+
+                /**
+                 * Get the block size
+                 * @return block size
+                 */
+                inline size_t       block_size() const          { return size_t(1) << nLogBlock;    }
+
+            public: // io::IOutStream
+                virtual wssize_t    position() override;
+                virtual ssize_t     write(const void *buf, size_t count) override;
+
+                /**
+                 * Compress all pending data as a block and flush the underlying stream
+                 * @return status of operation
+                 */
+                virtual status_t    flush() override;
+                virtual status_t    close() override;
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_OUTCOMPRESSEDSTREAM_H_ */
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_OUTDIRECTFILESTREAM_H_
+#define LSP_PLUG_IN_IO_OUTDIRECTFILESTREAM_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/AlignedBufferPool.h>
+#include <lsp-plug.in/io/File.h>
+#include <lsp-plug.in/io/IOutStream.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/io/Path.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        class DirectTransfer;
+
+        /**
+         * Output file stream that writes the file with direct (unbuffered) I/O bypassing
+         * the page cache. The data is accumulated in two aligned buffers: the full buffer
+         * is written in background while the other one is being filled. Since direct I/O
+         * allows only aligned transfers, flush() writes only complete aligned blocks and
+         * the partial tail is written on close(), after which the file is truncated to
+         * the actual size. If the file system does not support direct I/O, the file is
+         * written with regular buffered I/O using the same scheme.
+         */
+        class OutDirectFileStream: public IOutStream
+        {
+            private:
+                NativeFile             *pFD;            // File descriptor
+                DirectTransfer         *pTransfer;      // Background transfer
+                AlignedBufferPool      *pPool;          // Buffer pool
+                AlignedBufferPool      *pLocalPool;     // Buffer pool owned by the stream
+                uint8_t                *vBuf[2];        // Current and background buffers
+                wsize_t                 nBufOffset;     // Offset of the current buffer in the file
+                size_t                  nBufFill;       // Number of bytes in the current buffer
+                size_t                  nPending;       // Number of bytes submitted for background write
+                wsize_t                 nFileSize;      // Size of the file at the moment of opening
+                bool                    bDirect;        // File is opened for direct I/O
+
+            private:
+                status_t            do_close();
+                status_t            complete();
+                status_t            submit();
+                status_t            write_tail();
+
+            public:
+                /**
+                 * Create stream
+                 * @param pool buffer pool to obtain buffers, the stream creates its own
+                 *   pool with default settings if NULL
+                 */
+                explicit OutDirectFileStream(AlignedBufferPool *pool = NULL);
+                OutDirectFileStream(const OutDirectFileStream &) = delete;
+                OutDirectFileStream(OutDirectFileStream &&) = delete;
+                virtual ~OutDirectFileStream() override;
+
+                OutDirectFileStream & operator = (const OutDirectFileStream &) = delete;
+                OutDirectFileStream & operator = (OutDirectFileStream &&) = delete;
+
+            public:
+                /**
+                 * Open file for writing, the data is written from the beginning of the file
+                 * @param path path to the file
+                 * @param mode open mode, FM_WRITE is always added, FM_READ is added if
+                 *   FM_TRUNC is not set
+                 * @return status of operation
+                 */
+                status_t            open(const char *path, size_t mode = File::FM_WRITE_NEW);
+                status_t            open(const LSPString *path, size_t mode = File::FM_WRITE_NEW);
+                status_t            open(const Path *path, size_t mode = File::FM_WRITE_NEW);
+
+                /**
+                 * Check that the file has been opened for direct I/O
+                 * @return true if the file has been opened for direct I/O
+                 */
+                inline bool         direct() const      { return bDirect;   }
+
+            public: // io::IOutStream
+                virtual wssize_t    position() override;
+                virtual ssize_t     write(const void *buf, size_t count) override;
+
+                /**
+                 * Write all complete aligned blocks to the file, the partial tail remains
+                 * in the buffer until more data is written or the stream is closed
+                 * @return status of operation
+                 */
+                virtual status_t    flush() override;
+                virtual status_t    close() override;
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_OUTDIRECTFILESTREAM_H_ */
@@ -30,18 +30,35 @@ namespace lsp
     namespace io
     {
         
+        /**
+         * Output memory stream. By default, the data is stored in the contiguous memory
+         * buffer which grows geometrically. Optionally, the stream can be switched into the
+         * chunked mode which stores the data as a list of fixed-size chunks and never copies
+         * already written data when the stream grows.
+         */
         class OutMemoryStream: public IOutStream
         {
             private:
-                uint8_t    *pData;
-                size_t      nSize;
-                size_t      nCapacity;
-                size_t      nQuantity;
-                size_t      nPosition;
+                uint8_t    *pData;          // Contiguous data buffer
+                uint8_t   **vChunks;        // List of chunks (chunked mode)
+                size_t      nSize;          // Size of data
+                size_t      nCapacity;      // Capacity of data
+                size_t      nQuantity;      // Grow quantity
+                size_t      nChunkSize;     // Size of each chunk, zero if chunked mode is off
+                size_t      nChunks;        // Number of allocated chunks
+                size_t      nChunkCap;      // Capacity of the chunk list
+                size_t      nPosition;      // Current write position
+                float       fGrowth;        // Growth factor of the contiguous buffer
+
+            protected:
+                inline uint8_t *byte_at(size_t position);
+                status_t        reserve_chunks(size_t amount);
+                void            drop_chunks();
 
             public:
                 explicit OutMemoryStream();
                 explicit OutMemoryStream(size_t quantity);
+                explicit OutMemoryStream(size_t quantity, float growth);
                 OutMemoryStream(const OutMemoryStream &) = delete;
                 OutMemoryStream(OutMemoryStream &&) = delete;
                 virtual ~OutMemoryStream() override;
@@ -53,6 +70,7 @@ namespace lsp
                 /**
                  * Get current contents of the memory buffer
                  * @return contents of the memory buffer, may be NULL if there is no data
+                 *   or if the stream operates in chunked mode
                  */
                 const uint8_t  *data() const        { return pData; }
 
@@ -75,11 +93,74 @@ namespace lsp
                 const size_t    quantity() const    { return nQuantity; }
 
                 /**
-                 * Release the internal buffer and return it's contents
+                 * Get growth factor of the memory buffer
+                 * @return growth factor
+                 */
+                const float     growth() const      { return fGrowth; }
+
+                /**
+                 * Set growth factor of the memory buffer. When the buffer needs to be extended,
+                 * it's capacity is multiplied by the growth factor and aligned to the grow quantity.
+                 * The growth factor less or equal to 1 means linear growth by grow quantity.
+                 *
+                 * @param growth growth factor
+                 */
+                void            set_growth(float growth);
+
+                /**
+                 * Check that stream operates in chunked mode
+                 * @return true if stream operates in chunked mode
+                 */
+                const bool      chunked() const     { return nChunkSize > 0; }
+
+                /**
+                 * Get the size of each chunk
+                 * @return size of each chunk, zero if stream does not operate in chunked mode
+                 */
+                const size_t    chunk_size() const  { return nChunkSize; }
+
+                /**
+                 * Get number of chunks that contain data
+                 * @return number of chunks that contain data
+                 */
+                size_t          chunks() const;
+
+                /**
+                 * Get contents of the chunk
+                 * @param index index of the chunk
+                 * @param size pointer to store the number of bytes stored in the chunk, may be NULL
+                 * @return pointer to the chunk data or NULL if index is invalid
+                 */
+                const uint8_t  *chunk(size_t index, size_t *size = NULL) const;
+
+                /**
+                 * Switch the stream into the chunked mode or back into contiguous mode.
+                 * The stream should not contain any data.
+                 *
+                 * @param chunk_size size of each chunk, zero to switch into contiguous mode
+                 * @return status of operation
+                 */
+                status_t        set_chunk_size(size_t chunk_size);
+
+                /**
+                 * Release the internal buffer and return it's contents. In chunked mode
+                 * the contents of all chunks is copied into contiguous buffer.
                  * @return the pointer to data that should be free()'d after use
                  */
                 uint8_t        *release();
 
+                /**
+                 * Release the list of chunks in chunked mode. The returned list and each chunk
+                 * in the list should be free()'d after use. The size of each chunk is equal
+                 * to chunk_size() except of the last one.
+                 *
+                 * @param size pointer to store the overall size of data
+                 * @param count pointer to store number of chunks in the list
+                 * @return the list of chunks or NULL if there is no data or the stream is not
+                 *   in chunked mode
+                 */
+                uint8_t       **release_chunks(size_t *size, size_t *count);
+
                 /**
                  * Drop internal stream data and reset position
                  */
@@ -102,6 +183,14 @@ namespace lsp
                  */
                 status_t        reserve(size_t amount);
 
+                /**
+                 * Write the whole contents of the stream to the output stream without
+                 * making intermediate copies
+                 * @param os output stream
+                 * @return number of bytes written or negative error code
+                 */
+                wssize_t        sink(IOutStream *os);
+
             public: // io::IOutStream
                 virtual wssize_t    position() override;
                 virtual ssize_t     write(const void *buf, size_t count) override;
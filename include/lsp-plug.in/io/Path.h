@@ -28,6 +28,11 @@
 #include <lsp-plug.in/lltl/types.h>
 #include <stdarg.h>
 
+/**
+ * Size of the stack buffer used to pass short paths to the system calls without memory allocation
+ */
+#define IO_PATH_NATIVE_BUF_SIZE         0x200
+
 namespace lsp
 {
     namespace io
@@ -66,6 +71,7 @@ namespace lsp
             private:
                 inline void     fixup_path();
                 status_t        compute_relative(Path *base);
+                static bool     is_absolute(const LSPString *path, size_t first);
 
             public:
                 explicit Path();
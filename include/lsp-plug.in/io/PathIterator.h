@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_PATHITERATOR_H_
+#define LSP_PLUG_IN_IO_PATHITERATOR_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/Path.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Read-only iterator over the items of the path. Works directly with the characters
+         * of the path and does not perform any memory allocations. Both '/' and '\' characters
+         * are treated as separators, sequences of separators are considered to be a single
+         * separator. The root separator is not reported as an item, use is_absolute() to check
+         * it. Special items like '.' and '..' are reported as is.
+         *
+         * The iterated path should not be modified or destroyed while the iterator is in use.
+         */
+        class PathIterator
+        {
+            private:
+                const lsp_wchar_t  *pHead;          // Beginning of the path
+                const lsp_wchar_t  *pTail;          // End of the path
+                const lsp_wchar_t  *pFirst;         // Beginning of the current item
+                const lsp_wchar_t  *pLast;          // End of the current item
+
+            public:
+                explicit PathIterator();
+                explicit PathIterator(const Path *path);
+                explicit PathIterator(const LSPString *path);
+                explicit PathIterator(const lsp_wchar_t *path, size_t length);
+                PathIterator(const PathIterator &) = delete;
+                PathIterator(PathIterator &&) = delete;
+                ~PathIterator();
+
+                PathIterator & operator = (const PathIterator &) = delete;
+                PathIterator & operator = (PathIterator &&) = delete;
+
+            public:
+                /**
+                 * Attach iterator to the path and move it before the first item
+                 * @param path path to iterate, NULL is treated as empty path
+                 */
+                void                wrap(const Path *path);
+                void                wrap(const LSPString *path);
+                void                wrap(const lsp_wchar_t *path, size_t length);
+
+                /**
+                 * Move iterator before the first item of the path
+                 */
+                void                rewind();
+
+                /**
+                 * Move iterator to the next item of the path
+                 * @return true if the item is available, false if there are no more items
+                 */
+                bool                next();
+
+                /**
+                 * Check that the iterator points to the item
+                 * @return true if the iterator points to the item
+                 */
+                inline bool         valid() const           { return pFirst < pLast;        }
+
+                /**
+                 * Check that the current item is the last item of the path
+                 * @return true if the current item is the last item of the path
+                 */
+                bool                is_last() const;
+
+                /**
+                 * Check that the iterated path is absolute
+                 * @return true if the iterated path is absolute
+                 */
+                bool                is_absolute() const;
+
+                /**
+                 * Get characters of the current item, the data is not zero-terminated
+                 * @return pointer to characters of the current item
+                 */
+                inline const lsp_wchar_t *characters() const { return pFirst;               }
+
+                /**
+                 * Get length of the current item
+                 * @return length of the current item in characters
+                 */
+                inline size_t       length() const          { return pLast - pFirst;        }
+
+                /**
+                 * Get index of the first character of the current item in the path
+                 * @return index of the first character of the current item
+                 */
+                inline size_t       first() const           { return pFirst - pHead;        }
+
+                /**
+                 * Get index of the character that follows the current item in the path
+                 * @return index of the character that follows the current item
+                 */
+                inline size_t       last() const            { return pLast - pHead;         }
+
+                /**
+                 * Compare the current item with the string
+                 * @param s string to compare
+                 * @param len length of the string
+                 * @return true if the current item matches the string
+                 */
+                bool                equals(const lsp_wchar_t *s, size_t len) const;
+                bool                equals(const LSPString *s) const;
+                bool                equals_ascii(const char *s) const;
+                bool                equals_utf8(const char *s) const;
+
+                /**
+                 * Check that the current item is a special item
+                 * @return true if the current item is a special item
+                 */
+                bool                is_dot() const;
+                bool                is_dotdot() const;
+                bool                is_dots() const;
+
+                /**
+                 * Store the current item to the string
+                 * @param dst destination string
+                 * @return status of operation
+                 */
+                status_t            get(LSPString *dst) const;
+
+                /**
+                 * Store the rest of the path that follows the current item to the string
+                 * @param dst destination string
+                 * @return status of operation
+                 */
+                status_t            get_tail(LSPString *dst) const;
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_PATHITERATOR_H_ */
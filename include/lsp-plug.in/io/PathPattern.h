@@ -50,8 +50,14 @@ namespace lsp
         //
         // Example:
         //   **/((*.c|*.h)&(test-*)) - matches any source/header C files for any subdirectory starting with 'test-' prefix
+        //
+        // The pattern is compiled into the deterministic finite automaton which guarantees the linear
+        // matching time. If the automaton becomes too complex, the backtracking matcher is used instead.
         class PathPattern
         {
+            private:
+                friend class PathPatternSet;
+
             public:
                 enum flags
                 {
@@ -163,7 +169,7 @@ namespace lsp
                     size_t                  prefix;     // Number of fixed prefixes
                     size_t                  postfix;    // Number of fixed postfixes
                     lltl::darray<mregion_t> fixed;      // Fixed text regions
-                    lltl::parray<matcher_t> var;        // Variable text regions
+                    lltl::parray<matcher_t> var;        // Variable text regions, NULL for empty region between fixed ones
                 } sequence_matcher_t;
 
                 typedef struct brute_matcher_t: public matcher_t
@@ -171,14 +177,33 @@ namespace lsp
                     lltl::darray<mregion_t> items;      // Matching regions
                 } brute_matcher_t;
 
+                typedef struct dfa_t
+                {
+                    size_t                  nStates;    // Number of states
+                    size_t                  nClasses;   // Number of character classes
+                    size_t                  nWords;     // Number of 32-bit words in the accept mask of each state
+                    size_t                  nChars;     // Number of non-ASCII characters having own class
+                    bool                    bMatchCase; // Case-sensitive character classes
+                    uint32_t               *vNext;      // Transition table, nStates x nClasses
+                    uint32_t               *vAccept;    // Accept bit masks, nStates x nWords
+                    uint8_t                *vSink;      // Flags that state does not change on any input
+                    lsp_wchar_t            *vChars;     // Sorted list of non-ASCII characters having own class
+                    uint32_t               *vCharClass; // Classes of non-ASCII characters
+                    uint32_t                vAscii[0x80];   // Classes of ASCII characters
+                } dfa_t;
+
+                struct dfa_builder_t;
+
             protected:
                 LSPString                   sMask;
                 cmd_t                      *pRoot;
+                dfa_t                      *pDfa;
                 size_t                      nFlags;
 
             protected:
                 status_t                    parse(const LSPString *pattern, size_t flags = NONE);
                 bool                        match_full(const LSPString *path) const;
+                bool                        match_dfa(const LSPString *path) const;
 
                 static ssize_t              get_token(tokenizer_t *it);
                 static inline void          next_token(tokenizer_t *it);
@@ -217,6 +242,12 @@ namespace lsp
                 static bool                 brute_match_variable(brute_matcher_t *bm, size_t start, size_t count);
                 static bool                 brute_next_variable(brute_matcher_t *bm, size_t start, size_t count);
 
+                static dfa_t               *compile_dfa(const PathPattern * const *list, size_t count, bool match_case);
+                static void                 destroy_dfa(dfa_t *dfa);
+                static inline uint32_t      dfa_class(const dfa_t *dfa, lsp_wchar_t c);
+                static const uint32_t      *run_dfa(const dfa_t *dfa, const lsp_wchar_t *s, size_t count);
+                static const lsp_wchar_t   *get_subject(const LSPString *path, size_t flags, size_t *count);
+
             public:
                 explicit PathPattern();
                 PathPattern(const PathPattern &) = delete;
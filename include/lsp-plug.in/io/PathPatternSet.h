@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_PATHPATTERNSET_H_
+#define LSP_PLUG_IN_IO_PATHPATTERNSET_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/io/PathPattern.h>
+#include <lsp-plug.in/lltl/darray.h>
+#include <lsp-plug.in/lltl/parray.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Set of path patterns. All patterns having the same case sensitivity and
+         * path matching mode are compiled into one automaton, so the path is tested
+         * against all patterns of the set in a single pass.
+         */
+        class PathPatternSet
+        {
+            protected:
+                enum group_flags_t
+                {
+                    GROUP_FLAGS     = PathPattern::MATCH_CASE | PathPattern::FULL_PATH,
+                    GROUP_COUNT     = GROUP_FLAGS + 1
+                };
+
+                typedef struct group_t
+                {
+                    PathPattern::dfa_t     *pDfa;       // Compiled automaton, NULL if the patterns are too complex
+                    lltl::darray<uint32_t>  vIndex;     // Indices of patterns in the set
+                    lltl::darray<uint32_t>  vInverse;   // Inverse bit mask of patterns
+                } group_t;
+
+            protected:
+                lltl::parray<PathPattern>   vPatterns;
+                group_t                     vGroups[GROUP_COUNT];
+
+            protected:
+                status_t                    add_pattern(PathPattern *pattern);
+                status_t                    compile(group_t *g);
+                ssize_t                     lookup(const LSPString *path, size_t first) const;
+                ssize_t                     lookup_group(const group_t *g, const LSPString *path, size_t first) const;
+
+            public:
+                explicit PathPatternSet();
+                PathPatternSet(const PathPatternSet &) = delete;
+                PathPatternSet(PathPatternSet &&) = delete;
+                ~PathPatternSet();
+
+                PathPatternSet & operator = (const PathPatternSet &) = delete;
+                PathPatternSet & operator = (PathPatternSet &&) = delete;
+
+            public:
+                /**
+                 * Add pattern to the set
+                 * @param pattern pattern to add
+                 * @param flags pattern flags, see PathPattern::flags
+                 * @return status of operation
+                 */
+                status_t                    add(const char *pattern, size_t flags = PathPattern::NONE);
+                status_t                    add(const LSPString *pattern, size_t flags = PathPattern::NONE);
+                status_t                    add(const Path *pattern, size_t flags = PathPattern::NONE);
+
+                /**
+                 * Add copy of the pattern to the set
+                 * @param pattern pattern to add
+                 * @return status of operation
+                 */
+                status_t                    add(const PathPattern *pattern);
+
+                /**
+                 * Remove all patterns from the set
+                 */
+                void                        clear();
+
+                /**
+                 * Get number of patterns in the set
+                 * @return number of patterns in the set
+                 */
+                inline size_t               size() const                    { return vPatterns.size();      }
+                inline bool                 is_empty() const                { return vPatterns.is_empty();  }
+
+                /**
+                 * Get pattern
+                 * @param index index of the pattern
+                 * @return pattern or NULL if index is out of range
+                 */
+                inline const PathPattern   *get(size_t index) const         { return vPatterns.get(index);  }
+
+                /**
+                 * Test that path matches at least one pattern of the set
+                 * @param path path to test
+                 * @return true if path matches at least one pattern
+                 */
+                bool                        test(const char *path) const;
+                bool                        test(const LSPString *path) const;
+                bool                        test(const Path *path) const;
+
+                /**
+                 * Find the first pattern that matches the path
+                 * @param path path to test
+                 * @param first index of the pattern to start the search from
+                 * @return index of the matching pattern or negative value if there is no match
+                 */
+                ssize_t                     find(const char *path, size_t first = 0) const;
+                ssize_t                     find(const LSPString *path, size_t first = 0) const;
+                ssize_t                     find(const Path *path, size_t first = 0) const;
+
+                void                        swap(PathPatternSet *dst);
+                inline void                 swap(PathPatternSet &dst)       { swap(&dst);                   }
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_PATHPATTERNSET_H_ */
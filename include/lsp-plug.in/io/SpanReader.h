@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_SPANREADER_H_
+#define LSP_PLUG_IN_IO_SPANREADER_H_
+
+#include <lsp-plug.in/runtime/version.h>
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/io/IInSequence.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Character reader on top of the input sequence that uses zero-copy span
+         * access provided by IInSequence::peek_span() and IInSequence::consume().
+         * Characters are taken directly from the span and the read position of the
+         * sequence is advanced only when the span is exhausted or sync() is called.
+         * Falls back to IInSequence::read() for sequences that do not support spans.
+         *
+         * No other methods of the sequence should be called while the reader is
+         * attached to it until sync() is called.
+         */
+        class SpanReader
+        {
+            private:
+                IInSequence        *pIn;            // Input sequence
+                const lsp_wchar_t  *pHead;          // Current read position in the span
+                const lsp_wchar_t  *pTail;          // End of the span
+                size_t              nSpan;          // Size of the span obtained from the sequence
+                bool                bNative;        // The sequence supports span access
+                lsp_wchar_t         cChar;          // Buffer for the character in fallback mode
+
+            private:
+                lsp_swchar_t        fetch();
+
+            public:
+                explicit SpanReader();
+                explicit SpanReader(IInSequence *in);
+                SpanReader(const SpanReader &) = delete;
+                SpanReader(SpanReader &&) = delete;
+                ~SpanReader();
+
+                SpanReader & operator = (const SpanReader &) = delete;
+                SpanReader & operator = (SpanReader &&) = delete;
+
+            public:
+                /**
+                 * Attach reader to the input sequence, the previously attached sequence is synchronized
+                 * @param in input sequence
+                 */
+                void                wrap(IInSequence *in);
+
+                /**
+                 * Detach reader from the sequence without updating the read position of the
+                 * sequence, the characters read from the span are not committed to the sequence
+                 */
+                void                detach();
+
+                /**
+                 * Advance the read position of the sequence by the number of characters
+                 * read from the reader and drop the span. Should be called before accessing
+                 * the sequence directly. In fallback mode the character obtained by fill()
+                 * but not read yet stays in the reader.
+                 * @return status of operation
+                 */
+                status_t            sync();
+
+                /**
+                 * Ensure that the span contains at least one character
+                 * @return status of operation, STATUS_EOF at the end of sequence
+                 */
+                status_t            fill();
+
+                /**
+                 * Read single character
+                 * @return code of single character or negative error code
+                 */
+                inline lsp_swchar_t read()                  { return (pHead < pTail) ? *(pHead++) : fetch(); }
+
+                /**
+                 * Get pointer to the first unread character of the span
+                 * @return pointer to the first unread character of the span
+                 */
+                inline const lsp_wchar_t *head() const      { return pHead;             }
+
+                /**
+                 * Get pointer to the end of the span
+                 * @return pointer to the end of the span
+                 */
+                inline const lsp_wchar_t *tail() const      { return pTail;             }
+
+                /**
+                 * Get number of unread characters in the span
+                 * @return number of unread characters in the span
+                 */
+                inline size_t       avail() const           { return pTail - pHead;     }
+
+                /**
+                 * Mark the characters of the span as read
+                 * @param count number of characters, should not be greater than avail()
+                 */
+                inline void         advance(size_t count)   { pHead += count;           }
+
+                /**
+                 * Get attached sequence
+                 * @return attached sequence
+                 */
+                inline IInSequence *sequence()              { return pIn;               }
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_SPANREADER_H_ */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_IO_SYNCBATCH_H_
+#define LSP_PLUG_IN_IO_SYNCBATCH_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/lltl/parray.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Batch of pending directory synchronizations. Atomic file replacement
+         * requires the directory holding the file to be flushed after the rename.
+         * When many files are saved at once, the directories can be collected
+         * in the batch and flushed once per directory by calling commit().
+         */
+        class SyncBatch
+        {
+            private:
+                lltl::parray<LSPString> vDirs;      // Unique list of directories pending for sync
+
+            public:
+                explicit SyncBatch();
+                SyncBatch(const SyncBatch &) = delete;
+                SyncBatch(SyncBatch &&) = delete;
+                ~SyncBatch();
+
+                SyncBatch & operator = (const SyncBatch &) = delete;
+                SyncBatch & operator = (SyncBatch &&) = delete;
+
+            public:
+                /**
+                 * Add directory to the batch. Directories that are already
+                 * present in the batch are not added twice.
+                 * @param path path to the directory
+                 * @return status of operation
+                 */
+                status_t            add(const char *path);
+                status_t            add(const LSPString *path);
+                status_t            add(const Path *path);
+
+                /**
+                 * Synchronize all pending directories and clear the batch.
+                 * All directories are processed even if some of them fail.
+                 * @return status of operation, first met error if any
+                 */
+                status_t            commit();
+
+                /**
+                 * Drop all pending directories without synchronizing them
+                 */
+                void                clear();
+
+                /**
+                 * Get number of directories pending for synchronization
+                 * @return number of directories pending for synchronization
+                 */
+                inline size_t       pending() const         { return vDirs.size();      }
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_IO_SYNCBATCH_H_ */
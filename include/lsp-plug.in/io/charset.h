@@ -24,6 +24,7 @@
 
 #include <lsp-plug.in/runtime/version.h>
 #include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
 #include <lsp-plug.in/stdlib/string.h>
 
 #if defined(PLATFORM_WINDOWS)
@@ -78,6 +79,83 @@ namespace lsp
 
 #endif /* PLATFORM_WINDOWS */
 
+    /**
+     * Character sets that are encoded and decoded by the library itself without
+     * calls to iconv or system code page conversion routines
+     */
+    enum builtin_charset_t
+    {
+        BUILTIN_CHARSET_NONE,       // The character set is not supported natively
+        BUILTIN_CHARSET_ASCII,      // 7-bit ASCII character set
+        BUILTIN_CHARSET_UTF8,       // UTF-8 character set
+    };
+
+    /**
+     * Check that the character set is supported natively by the library
+     * @param charset character set name, NULL for default native character set
+     * @return the built-in character set identifier or BUILTIN_CHARSET_NONE
+     */
+    builtin_charset_t       builtin_charset_from_name(const char *charset);
+
+    /**
+     * Convert the leading run of 7-bit ASCII characters to UTF-32 characters
+     * in native byte order. The conversion stops at the first non-ASCII character.
+     * @param dst destination buffer
+     * @param src source buffer
+     * @param count maximum number of characters to convert
+     * @return number of converted characters
+     */
+    size_t                  ascii_to_utf32(lsp_utf32_t *dst, const char *src, size_t count);
+
+    /**
+     * Convert the leading run of UTF-32 characters in native byte order that belong
+     * to the 7-bit ASCII range to ASCII characters. The conversion stops at the first
+     * character outside of the ASCII range.
+     * @param dst destination buffer
+     * @param src source buffer
+     * @param count maximum number of characters to convert
+     * @return number of converted characters
+     */
+    size_t                  utf32_to_ascii(char *dst, const lsp_utf32_t *src, size_t count);
+
+    /**
+     * Implementation of bulk UTF conversion and validation routines
+     */
+    enum utf_kernel_t
+    {
+        UTF_KERNEL_AUTO,            // The best implementation supported by the CPU
+        UTF_KERNEL_GENERIC,         // Scalar reference implementation
+        UTF_KERNEL_SSE2,            // x86 SSE2 implementation
+        UTF_KERNEL_AVX2,            // x86 AVX2 implementation
+        UTF_KERNEL_NEON             // AArch64 NEON implementation
+    };
+
+    /**
+     * Select the implementation of bulk UTF conversion and validation routines.
+     * The function is intended for testing and benchmarking and should not be
+     * called while conversions are performed by other threads.
+     * @param kernel implementation to use
+     * @return status of operation, STATUS_NOT_SUPPORTED if the implementation
+     *   is not supported by the build or by the CPU
+     */
+    status_t                select_utf_kernel(utf_kernel_t kernel);
+
+    /**
+     * Get the implementation of bulk UTF conversion and validation routines
+     * currently in use
+     * @return implementation currently in use
+     */
+    utf_kernel_t            utf_kernel();
+
+    /**
+     * Validate UTF-8 sequence
+     * @param src UTF-8 sequence
+     * @param count number of bytes in the sequence
+     * @return number of bytes at the beginning of the sequence that form complete
+     *   and well-formed UTF-8 characters, equal to count if the whole sequence is valid
+     */
+    size_t                  utf8_validate(const char *src, size_t count);
+
     /**
      * Read UTF-16 codepoint from the NULL-terminated UTF-16 string, replace invalid
      * code sequence by 0xfffd code point
@@ -101,8 +179,8 @@ namespace lsp
     inline lsp_utf32_t      read_utf16_streaming(const lsp_utf16_t **str, size_t *nsrc, bool force) { return __IF_LEBE(read_utf16le_streaming, read_utf16be_streaming)(str, nsrc, force); }
 
     /**
-     * Read UTF-16 codepoint from the NULL-terminated UTF-8 string, replace invalid
-     * code sequence by 0xfffd code point
+     * Read UTF-16 codepoint from the NULL-terminated UTF-8 string, replace each maximal
+     * subpart of invalid code sequence by single 0xfffd code point
      * @param str pointer to the NULL-terminated UTF-8 string
      * @return code point
      */
@@ -110,7 +188,7 @@ namespace lsp
 
     /**
      * Read UTF-8 codepoint from the NULL-terminated UTF-8 string in streaming mode,
-     * replace invalid code sequence by 0xfffd code point
+     * replace each maximal subpart of invalid code sequence by single 0xfffd code point
      * @param str pointer to the pointer to the NULL-terminated UTF-8 string
      * @param nsrc counter containing number of unread array elements
      * @param force process data as there will be no future data on the input
@@ -390,19 +468,143 @@ namespace lsp
     int                     wchar_casecmp(const lsp_wchar_t *s1, const lsp_wchar_t *s2, size_t count);
 
     /**
-     * Convert character to lower case
+     * Convert character to lower case using the simple Unicode case mapping
      * @param c character to convert
      * @return converted character
      */
     lsp_wchar_t             to_lower(lsp_wchar_t c);
 
     /**
-     * Convert character to upper case
+     * Convert character to upper case using the simple Unicode case mapping
      * @param c character to convert
      * @return converted character
      */
     lsp_wchar_t             to_upper(lsp_wchar_t c);
 
+    /**
+     * Apply the simple Unicode case folding to the character. Case folding should be
+     * used for case-insensitive comparison instead of to_lower() since it maps all case
+     * variants of the character to the same value, for example 'ς', 'σ' and 'Σ'
+     * @param c character to convert
+     * @return folded character
+     */
+    lsp_wchar_t             to_casefold(lsp_wchar_t c);
+
+    /**
+     * Select the implementation of wide character string routines. The function
+     * is intended for testing and benchmarking and should not be called while
+     * the routines are used by other threads.
+     * @param kernel implementation to use
+     * @return status of operation, STATUS_NOT_SUPPORTED if the implementation
+     *   is not supported by the build or by the CPU
+     */
+    status_t                select_wchar_kernel(utf_kernel_t kernel);
+
+    /**
+     * Get the implementation of wide character string routines currently in use
+     * @return implementation currently in use
+     */
+    utf_kernel_t            wchar_kernel();
+
+    /**
+     * Find the first occurrence of the character
+     * @param s character sequence
+     * @param count number of characters in the sequence
+     * @param ch character to search
+     * @return index of the character or negative value if not found
+     */
+    ssize_t                 wchar_find(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch);
+
+    /**
+     * Find the last occurrence of the character
+     * @param s character sequence
+     * @param count number of characters in the sequence
+     * @param ch character to search
+     * @return index of the character or negative value if not found
+     */
+    ssize_t                 wchar_rfind(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch);
+
+    /**
+     * Find the first occurrence of the character sequence
+     * @param s character sequence
+     * @param count number of characters in the sequence
+     * @param str character sequence to search
+     * @param len number of characters in the sequence to search
+     * @return index of the sequence or negative value if not found
+     */
+    ssize_t                 wchar_search(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len);
+
+    /**
+     * Find the last occurrence of the character sequence
+     * @param s character sequence
+     * @param count number of characters in the sequence
+     * @param str character sequence to search
+     * @param len number of characters in the sequence to search
+     * @return index of the sequence or negative value if not found
+     */
+    ssize_t                 wchar_rsearch(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len);
+
+    /**
+     * Count number of occurrences of the character
+     * @param s character sequence
+     * @param count number of characters in the sequence
+     * @param ch character to count
+     * @return number of occurrences
+     */
+    size_t                  wchar_count(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch);
+
+    /**
+     * Replace all occurrences of the character
+     * @param s character sequence
+     * @param count number of characters in the sequence
+     * @param ch character to replace
+     * @param rep replacement
+     * @return number of replaced characters
+     */
+    size_t                  wchar_replace(lsp_wchar_t *s, size_t count, lsp_wchar_t ch, lsp_wchar_t rep);
+
+    /**
+     * Find the first position where two character sequences differ
+     * @param a character sequence 1
+     * @param b character sequence 2
+     * @param count number of characters to compare
+     * @return index of the first differing character or count if sequences are equal
+     */
+    size_t                  wchar_mismatch(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count);
+
+    /**
+     * Find the first position where two character sequences differ ignoring the case
+     * @param a character sequence 1
+     * @param b character sequence 2
+     * @param count number of characters to compare
+     * @return index of the first differing character or count if sequences are equal
+     */
+    size_t                  wchar_casemismatch(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count);
+
+    /**
+     * Convert characters to lower case
+     * @param s character sequence
+     * @param count number of characters in the sequence
+     */
+    void                    wchar_tolower(lsp_wchar_t *s, size_t count);
+
+    /**
+     * Convert characters to upper case
+     * @param s character sequence
+     * @param count number of characters in the sequence
+     */
+    void                    wchar_toupper(lsp_wchar_t *s, size_t count);
+
+    /**
+     * Compute hash of the character sequence. Sequences shorter than 8 characters are
+     * hashed as hash = (hash * 0x10015) ^ ch, longer sequences are hashed by 8 interleaved
+     * lanes which are combined at the end. The result does not depend on the implementation.
+     * @param s character sequence
+     * @param count number of characters in the sequence
+     * @return hash value
+     */
+    size_t                  wchar_hash(const lsp_wchar_t *s, size_t count);
+
 } /* namespace lsp */
 
 #endif /* LSP_PLUG_IN_IO_CHARSET_H_ */
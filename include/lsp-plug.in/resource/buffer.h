@@ -58,6 +58,7 @@ namespace lsp
                 uint32_t    head;       // Head of the buffer
                 uint32_t    length;     // Buffer length
                 uint32_t    cap;        // Buffer capacity
+                uint32_t    depth;      // Maximum number of matches checked by lookup, 0 means no limit
 
             public:
                 explicit cbuffer_t();
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_RESOURCE_CODEC_H_
+#define LSP_PLUG_IN_RESOURCE_CODEC_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/io/InBitStream.h>
+#include <lsp-plug.in/io/OutBitStream.h>
+#include <lsp-plug.in/resource/buffer.h>
+
+namespace lsp
+{
+    namespace resource
+    {
+        /**
+         * Encode the block of data with LZ-style commands: emission of octets and
+         * replays of sequences stored in the compression buffer. The state of the
+         * compression buffer is kept between calls, so the data may be encoded by
+         * several blocks that refer to the previously encoded data.
+         *
+         * @param buf compression buffer
+         * @param out output bit stream
+         * @param src data to encode
+         * @param count number of bytes to encode
+         * @return status of operation
+         */
+        status_t lz_encode(cbuffer_t *buf, io::OutBitStream *out, const void *src, size_t count);
+
+        /**
+         * Decode the block of data encoded by lz_encode(). The decompression buffer
+         * should have the same capacity as the compression buffer used for encoding,
+         * the state of the buffer is kept between calls.
+         *
+         * @param buf decompression buffer
+         * @param in input bit stream
+         * @param dst destination buffer to store decoded data
+         * @param count number of bytes to decode, should match the number of encoded bytes
+         * @return status of operation, STATUS_CORRUPTED if the encoded data is invalid
+         */
+        status_t lz_decode(dbuffer_t *buf, io::InBitStream *in, void *dst, size_t count);
+
+    } /* namespace resource */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_RESOURCE_CODEC_H_ */
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_RUNTIME_ATOMTABLE_H_
+#define LSP_PLUG_IN_RUNTIME_ATOMTABLE_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/ipc/Mutex.h>
+#include <lsp-plug.in/lltl/types.h>
+
+namespace lsp
+{
+    class AtomTable;
+
+    /**
+     * Interned string (atom). Atoms are owned by the atom table and never change
+     * after they have been created, so two atoms issued by the same table are equal
+     * if and only if their pointers are equal. Atoms of different tables should be
+     * compared by their names.
+     */
+    typedef struct atom_t
+    {
+        LSPString           name;           // The string value of the atom
+        size_t              hash;           // Precomputed hash value, same to LSPString::hash()
+        const AtomTable    *table;          // The table that owns the atom
+        atom_t             *next;           // Next atom in the hash bin
+    } atom_t;
+
+    /**
+     * Thread-safe string interning table. Each distinct string is stored once and
+     * the table issues a stable handle to it which remains valid until the table
+     * is destroyed. Atoms are never removed from the table, so holders of atoms
+     * (config::param_t, expr::Variables, i18n::Dictionary) never see dangling handles.
+     */
+    class AtomTable
+    {
+        protected:
+            mutable ipc::Mutex  sLock;          // Lock for the concurrent access
+            atom_t            **vBins;          // Hash bins, the number of bins is a power of two
+            size_t              nBins;          // Number of hash bins
+            size_t              nSize;          // Number of atoms
+
+        protected:
+            const atom_t       *lookup(const LSPString *name, size_t hash) const;
+            bool                grow();
+
+        public:
+            explicit AtomTable();
+            AtomTable(const AtomTable &) = delete;
+            AtomTable(AtomTable &&) = delete;
+            ~AtomTable();
+
+            AtomTable & operator = (const AtomTable &) = delete;
+            AtomTable & operator = (AtomTable &&) = delete;
+
+        public:
+            /**
+             * Get the global atom table shared by all consumers of the library
+             * @return global atom table
+             */
+            static AtomTable   *global();
+
+        public:
+            /**
+             * Intern the string: return the existing atom or create a new one
+             * @param name string to intern
+             * @return atom or NULL on error
+             */
+            const atom_t       *intern(const LSPString *name);
+            inline const atom_t*intern(const LSPString & name)     { return intern(&name);     }
+
+            /**
+             * Intern the UTF-8 encoded string: return the existing atom or create a new one
+             * @param name UTF-8 encoded string to intern
+             * @return atom or NULL on error
+             */
+            const atom_t       *intern(const char *name);
+
+            /**
+             * Find the atom without creating it
+             * @param name string to search
+             * @return atom or NULL if the string has not been interned
+             */
+            const atom_t       *find(const LSPString *name) const;
+            inline const atom_t*find(const LSPString & name) const { return find(&name);       }
+
+            /**
+             * Find the atom without creating it
+             * @param name UTF-8 encoded string to search
+             * @return atom or NULL if the string has not been interned
+             */
+            const atom_t       *find(const char *name) const;
+
+            /**
+             * Get number of atoms in the table
+             * @return number of atoms in the table
+             */
+            size_t              size() const;
+    };
+
+    /**
+     * Intern string in the global atom table
+     * @param name string to intern
+     * @return atom or NULL on error
+     */
+    inline const atom_t *intern(const LSPString *name)      { return AtomTable::global()->intern(name);  }
+    inline const atom_t *intern(const char *name)           { return AtomTable::global()->intern(name);  }
+
+    namespace lltl
+    {
+        template <>
+        struct hash_spec<atom_t>: public hash_iface
+        {
+            static size_t hash_func(const void *ptr, size_t size);
+
+            explicit hash_spec()
+            {
+                hash        = hash_func;
+            }
+        };
+
+        template <>
+        struct compare_spec<atom_t>: public compare_iface
+        {
+            static ssize_t cmp_func(const void *a, const void *b, size_t size);
+
+            explicit compare_spec()
+            {
+                compare     = cmp_func;
+            }
+        };
+
+        /**
+         * Atoms are owned by the atom table, so containers only keep references to them
+         */
+        template <>
+        struct allocator_spec<atom_t>: public allocator_iface
+        {
+            static void *clone_func(const void *src, size_t size);
+            static void free_func(void *ptr);
+
+            explicit allocator_spec()
+            {
+                clone       = clone_func;
+                free        = free_func;
+            }
+        };
+    } /* namespace lltl */
+
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_RUNTIME_ATOMTABLE_H_ */
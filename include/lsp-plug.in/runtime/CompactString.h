@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_RUNTIME_COMPACTSTRING_H_
+#define LSP_PLUG_IN_RUNTIME_COMPACTSTRING_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/lltl/types.h>
+
+namespace lsp
+{
+    /**
+     * String with adaptive compact storage. Each character occupies 1 byte if all
+     * characters of the string fit into Latin-1, 2 bytes if all characters fit into
+     * the Basic Multilingual Plane (UCS-2) and 4 bytes (UTF-32) otherwise. The width
+     * of characters is chosen when the string is set and is widened when appending
+     * characters that do not fit into the current width.
+     *
+     * The string is intended for long-living data like keys and values of dictionaries,
+     * paths and configuration parameters where the memory footprint matters. Comparison
+     * and hashing are compatible with LSPString.
+     */
+    class CompactString
+    {
+        protected:
+            size_t              nLength;        // Number of characters
+            size_t              nCapacity;      // Capacity in characters
+            uint8_t            *pData;          // Character data
+            mutable size_t      nHash;          // Cached hash value
+            size_t              nShift;         // Width of character: 0 - Latin-1, 1 - UCS-2, 2 - UTF-32
+
+        protected:
+            bool                realloc_data(size_t capacity, size_t shift);
+            bool                cap_grow(size_t delta, size_t shift);
+            void                put(size_t index, const lsp_wchar_t *src, size_t count);
+            void                put(size_t index, const CompactString *src);
+
+            static size_t       shift_of(const lsp_wchar_t *src, size_t count);
+            static inline size_t shift_of(lsp_wchar_t ch);
+
+        public:
+            explicit CompactString();
+            CompactString(const CompactString &) = delete;
+            CompactString(CompactString &&) = delete;
+            ~CompactString();
+
+            CompactString & operator = (const CompactString &) = delete;
+            CompactString & operator = (CompactString &&) = delete;
+
+        public:
+            /** Get the length of the string
+             *
+             * @return the length of the string
+             */
+            inline size_t       length() const          { return nLength;                   }
+
+            /** Check whether the string is emtpy
+             *
+             * @return true if string is empty
+             */
+            inline bool         is_empty() const        { return nLength <= 0;              }
+
+            /**
+             * Get the number of bytes used to store each character
+             * @return number of bytes per character: 1, 2 or 4
+             */
+            inline size_t       width() const           { return size_t(1) << nShift;       }
+
+            /**
+             * Get the number of bytes allocated for character data
+             * @return number of bytes allocated for character data
+             */
+            inline size_t       data_size() const       { return nCapacity << nShift;       }
+
+            /**
+             * Clear the string without deallocating internal buffer
+             */
+            void                clear();
+
+            /**
+             * Clear the string and deallocate internal buffer
+             */
+            void                truncate();
+
+            /**
+             * Release the unused memory of the internal buffer
+             */
+            void                reduce();
+
+            /**
+             * Swap contents with another string
+             * @param src string to swap contents
+             */
+            void                swap(CompactString *src);
+
+        public:
+            /**
+             * Get character at specified position
+             * @param index index of the character, negative values are counted from the end
+             * @return character or 0 if index is out of bounds
+             */
+            lsp_wchar_t         at(ssize_t index) const;
+            lsp_wchar_t         first() const;
+            lsp_wchar_t         last() const;
+
+            /**
+             * Set the contents of the string and choose the most compact storage
+             * @param src source string
+             * @return true on success
+             */
+            bool                set(const CompactString *src);
+            bool                set(const LSPString *src);
+            bool                set(const lsp_wchar_t *arr, size_t n);
+            bool                set_utf8(const char *s, size_t n);
+            inline bool         set_utf8(const char *s)                 { return set_utf8(s, ::strlen(s));  }
+            bool                set_ascii(const char *s, size_t n);
+            inline bool         set_ascii(const char *s)                { return set_ascii(s, ::strlen(s)); }
+
+            /**
+             * Append data to the string, widen the storage if necessary
+             * @param src data to append
+             * @return true on success
+             */
+            bool                append(lsp_wchar_t ch);
+            bool                append(const lsp_wchar_t *arr, size_t n);
+            bool                append(const LSPString *src);
+            bool                append(const CompactString *src);
+
+            /**
+             * Get the contents of the string as LSPString
+             * @param dst destination string
+             * @return true on success
+             */
+            bool                get(LSPString *dst) const;
+
+            /**
+             * Get the number of bytes required to encode the string as UTF-8
+             * @return number of bytes excluding the terminating zero
+             */
+            size_t              utf8_length() const;
+
+            /**
+             * Encode the string as UTF-8 into the caller's buffer
+             * @param dst destination buffer
+             * @param size size of the buffer including the terminating zero
+             * @return number of bytes excluding the terminating zero required to store the
+             *   whole string, the output is truncated if the value is not less than size
+             */
+            size_t              get_utf8(char *dst, size_t size) const;
+
+            /**
+             * Encode the string as UTF-8 into the allocated buffer
+             * @param bytes pointer to store number of bytes excluding the terminating zero, may be NULL
+             * @return pointer to the zero-terminated string that should be free()'d after use
+             *   or NULL if there is no memory
+             */
+            char               *clone_utf8(size_t *bytes = NULL) const;
+
+        public:
+            /**
+             * Compare strings, the result is compatible with LSPString::compare_to
+             * @param src string to compare
+             * @return the difference of the first differing characters, zero if strings are equal
+             */
+            int                 compare_to(const CompactString *src) const;
+            int                 compare_to(const LSPString *src) const;
+            int                 compare_to(const lsp_wchar_t *src, size_t len) const;
+
+            /**
+             * Check that strings are equal
+             * @param src string to compare
+             * @return true if strings are equal
+             */
+            bool                equals(const CompactString *src) const;
+            bool                equals(const LSPString *src) const;
+            bool                equals(const lsp_wchar_t *src, size_t len) const;
+            bool                equals_ascii(const char *src) const;
+
+            /**
+             * Find the first occurrence of the character or string
+             * @param start index to start search, negative values are counted from the end
+             * @param ch character or string to search
+             * @return index of the first occurrence or negative value if not found
+             */
+            ssize_t             index_of(ssize_t start, lsp_wchar_t ch) const;
+            ssize_t             index_of(lsp_wchar_t ch) const;
+            ssize_t             index_of(ssize_t start, const CompactString *str) const;
+            ssize_t             index_of(const CompactString *str) const;
+
+            /**
+             * Compute the hash value of the string, the value is the same as for the
+             * LSPString with the same contents
+             * @return hash value
+             */
+            size_t              hash() const;
+    };
+
+    // LLTL specialization for CompactString class
+    namespace lltl
+    {
+        template <>
+        struct hash_spec<CompactString>: public hash_iface
+        {
+            static size_t hash_func(const void *ptr, size_t size);
+
+            explicit hash_spec()
+            {
+                hash        = hash_func;
+            }
+        };
+
+        template <>
+        struct compare_spec<CompactString>: public compare_iface
+        {
+            static ssize_t cmp_func(const void *a, const void *b, size_t size);
+
+            explicit compare_spec()
+            {
+                compare     = cmp_func;
+            }
+        };
+
+        template <>
+        struct allocator_spec<CompactString>: public allocator_iface
+        {
+            static void *clone_func(const void *src, size_t size);
+            static void free_func(void *ptr);
+
+            explicit allocator_spec()
+            {
+                clone       = clone_func;
+                free        = free_func;
+            }
+        };
+    } /* namespace lltl */
+
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_RUNTIME_COMPACTSTRING_H_ */
@@ -36,6 +36,9 @@ namespace lsp
      */
     class LSPString
     {
+        private:
+            friend class SharedString;
+
         protected:
             typedef struct buffer_t
             {
@@ -44,18 +47,25 @@ namespace lsp
                 char       *pData;
             } buffer_t;
 
+            // Number of characters stored in the string object without heap allocation
+            static constexpr size_t INLINE_SIZE     = 8;
+
         protected:
             size_t              nLength;
             size_t              nCapacity;
-            lsp_wchar_t        *pData;
+            lsp_wchar_t        *pData;              // Heap buffer, NULL if the data is stored in vInline
             mutable size_t      nHash;
             mutable buffer_t   *pTemp;
+            lsp_wchar_t         vInline[INLINE_SIZE];   // Inline buffer, never referenced by pData to keep the object relocatable
 
         protected:
+            inline lsp_wchar_t         *xdata()             { return (pData != NULL) ? pData : vInline;  }
+            inline const lsp_wchar_t   *xdata() const       { return (pData != NULL) ? pData : vInline;  }
             bool            size_reserve(size_t size);
             inline bool     cap_reserve(size_t size);
             inline bool     cap_grow(size_t delta);
             void            drop_temp();
+            inline void     drop_data();
             bool            append_temp(const char *p, size_t n) const;
             bool            resize_temp(size_t n) const;
             bool            grow_temp(size_t n) const;
@@ -119,7 +129,7 @@ namespace lsp
              *
              * @return pointer to internal to internal non-null-terminated characters array
              */
-            inline const lsp_wchar_t *characters() const { return pData; }
+            inline const lsp_wchar_t *characters() const { return (nCapacity > 0) ? xdata() : pData; }
 
             /** Reserve additional capacity at the tail for further modifications
              *
@@ -389,6 +399,100 @@ namespace lsp
             inline size_t temporal_size() const     { return (pTemp != NULL) ? pTemp->nOffset : 0; };
             inline size_t temporal_capacity() const { return (pTemp != NULL) ? pTemp->nLength : 0; };
 
+            /**
+             * Get the exact number of bytes required to encode the string or its part as UTF-8
+             * @param first index of the first character
+             * @param last index of the character after the last one
+             * @return number of bytes excluding the terminating zero, zero if the range is invalid
+             */
+            size_t utf8_length(ssize_t first, ssize_t last) const;
+            inline size_t utf8_length(ssize_t first) const { return utf8_length(first, nLength); };
+            inline size_t utf8_length() const { return utf8_length(0, nLength); };
+
+            /**
+             * Get the exact number of UTF-16 code units required to encode the string or its part
+             * @param first index of the first character
+             * @param last index of the character after the last one
+             * @return number of code units excluding the terminating zero, zero if the range is invalid
+             */
+            size_t utf16_length(ssize_t first, ssize_t last) const;
+            inline size_t utf16_length(ssize_t first) const { return utf16_length(first, nLength); };
+            inline size_t utf16_length() const { return utf16_length(0, nLength); };
+
+            /**
+             * Get the number of bytes required to encode the string or its part using the native
+             * character set
+             * @param first index of the first character
+             * @param last index of the character after the last one
+             * @param charset character set, NULL for the character set of the current locale
+             * @return number of bytes excluding the terminating zero, negative value on error
+             */
+            ssize_t native_length(ssize_t first, ssize_t last, const char *charset = NULL) const;
+            inline ssize_t native_length(const char *charset = NULL) const { return native_length(0, nLength, charset); };
+
+            /**
+             * Encode the string or its part as UTF-8 into the caller's buffer. The temporary buffer
+             * of the string is not used, so the method does not allocate memory and can be called
+             * concurrently for the same string.
+             * @param dst destination buffer, may be NULL if size is zero
+             * @param size size of the buffer in bytes including the terminating zero
+             * @param first index of the first character
+             * @param last index of the character after the last one
+             * @return number of bytes excluding the terminating zero required to store the whole
+             *   text, the output is truncated at character boundary if the value is not less than size;
+             *   negative value if the range is invalid
+             */
+            ssize_t encode_utf8(char *dst, size_t size, ssize_t first, ssize_t last) const;
+            inline ssize_t encode_utf8(char *dst, size_t size, ssize_t first) const { return encode_utf8(dst, size, first, nLength); };
+            inline ssize_t encode_utf8(char *dst, size_t size) const { return encode_utf8(dst, size, 0, nLength); };
+
+            /**
+             * Encode the string or its part as UTF-16 with native byte order into the caller's buffer
+             * without using the temporary buffer of the string
+             * @param dst destination buffer, may be NULL if size is zero
+             * @param size size of the buffer in code units including the terminating zero
+             * @param first index of the first character
+             * @param last index of the character after the last one
+             * @return number of code units excluding the terminating zero required to store the whole
+             *   text, the output is truncated at character boundary if the value is not less than size;
+             *   negative value if the range is invalid
+             */
+            ssize_t encode_utf16(lsp_utf16_t *dst, size_t size, ssize_t first, ssize_t last) const;
+            inline ssize_t encode_utf16(lsp_utf16_t *dst, size_t size, ssize_t first) const { return encode_utf16(dst, size, first, nLength); };
+            inline ssize_t encode_utf16(lsp_utf16_t *dst, size_t size) const { return encode_utf16(dst, size, 0, nLength); };
+
+            /**
+             * Encode the string or its part using the native character set into the caller's buffer
+             * without using the temporary buffer of the string
+             * @param dst destination buffer, may be NULL if size is zero
+             * @param size size of the buffer in bytes including the terminating zero
+             * @param first index of the first character
+             * @param last index of the character after the last one
+             * @param charset character set, NULL for the character set of the current locale
+             * @return number of bytes excluding the terminating zero required to store the whole
+             *   text, the output is incomplete if the value is not less than size;
+             *   negative value on error
+             * @note if the value is not less than size, the buffer holds a zero-terminated string
+             *   which should not be used: it is a truncated prefix of the output on POSIX systems
+             *   and an empty string on Windows. Callers should check the result like to_native()
+             *   does, falling back to the temporary buffer
+             */
+            ssize_t encode_native(char *dst, size_t size, ssize_t first, ssize_t last, const char *charset = NULL) const;
+            inline ssize_t encode_native(char *dst, size_t size, const char *charset = NULL) const { return encode_native(dst, size, 0, nLength, charset); };
+
+            /**
+             * Get the zero-terminated representation of the string, the caller's buffer is used
+             * if it is large enough, the temporary buffer of the string otherwise. This allows
+             * to perform conversion of short strings without memory allocation.
+             * @param buf caller's buffer
+             * @param size size of the caller's buffer in bytes or code units
+             * @param charset character set, NULL for the character set of the current locale
+             * @return pointer to the caller's buffer or to the temporary buffer, NULL on error
+             */
+            const char *to_utf8(char *buf, size_t size) const;
+            const lsp_utf16_t *to_utf16(lsp_utf16_t *buf, size_t size) const;
+            const char *to_native(char *buf, size_t size, const char *charset = NULL) const;
+
             /**
              * Find number of matching characters from one string to another
              */
@@ -592,14 +696,14 @@ namespace lsp
              */
             int compare_to(const lsp_wchar_t *src) const;
             int compare_to(const lsp_wchar_t *src, size_t n) const;
-            inline int compare_to(const LSPString *src) const { return compare_to(src->pData, src->nLength); };
+            inline int compare_to(const LSPString *src) const { return compare_to(src->xdata(), src->nLength); };
             int compare_to_ascii(const char *src) const;
             int compare_to_utf8(const char *src) const;
             int compare_to_utf16(const lsp_utf16_t *src) const;
 
             int compare_to_nocase(const lsp_wchar_t *src) const;
             int compare_to_nocase(const lsp_wchar_t *src, size_t n) const;
-            inline int compare_to_nocase(const LSPString *src) const { return compare_to_nocase(src->pData, src->nLength); };
+            inline int compare_to_nocase(const LSPString *src) const { return compare_to_nocase(src->xdata(), src->nLength); };
             int compare_to_ascii_nocase(const char *src) const;
             int compare_to_utf8_nocase(const char *src) const;
             int compare_to_utf16_nocase(const lsp_utf16_t *src) const;
@@ -619,12 +723,12 @@ namespace lsp
              */
             bool equals(const lsp_wchar_t *src) const;
             bool equals(const lsp_wchar_t *src, size_t len) const;
-            inline bool equals(const LSPString *src) const { return equals(src->pData, src->nLength); };
+            inline bool equals(const LSPString *src) const { return equals(src->xdata(), src->nLength); };
             bool equals(const LSPString *src, ssize_t first, ssize_t last) const;
 
             bool equals_nocase(const lsp_wchar_t *src) const;
             bool equals_nocase(const lsp_wchar_t *src, size_t len) const;
-            inline bool equals_nocase(const LSPString *src) const { return equals_nocase(src->pData, src->nLength); };
+            inline bool equals_nocase(const LSPString *src) const { return equals_nocase(src->xdata(), src->nLength); };
 
             inline bool equals_ascii(const char *src) const { return compare_to_ascii(src) == 0; };
             inline bool equals_ascii_nocase(const char *src) const { return compare_to_ascii_nocase(src) == 0; };
@@ -638,7 +742,7 @@ namespace lsp
 
             bool contains_at(ssize_t index, const lsp_wchar_t *src) const;
             bool contains_at(ssize_t index, const lsp_wchar_t *src, size_t len) const;
-            inline bool contains_at(ssize_t index, const LSPString *src) const  { return contains_at(index, src->pData, src->nLength); };
+            inline bool contains_at(ssize_t index, const LSPString *src) const  { return contains_at(index, src->xdata(), src->nLength); };
             bool contains_at_ascii(ssize_t index, const char *src) const;
             bool contains_at_utf8(ssize_t index, const char *src) const;
             bool contains_at_utf16(ssize_t index, const lsp_utf16_t *src) const;
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_RUNTIME_LSPSTRINGVIEW_H_
+#define LSP_PLUG_IN_RUNTIME_LSPSTRINGVIEW_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+
+namespace lsp
+{
+    /**
+     * Non-owning read-only view of the character sequence. The view refers the characters
+     * of another string or character array without copying them, so it can be used as a key
+     * for lookups in dictionaries and lltl containers without any memory allocation:
+     *
+     *   LSPStringView key(&path, 0, path.index_of('/'));
+     *   value = map.get(key.string());
+     *
+     * The referenced data should not be modified or deallocated while the view is in use.
+     * UTF-8 and ASCII sequences can not be referenced directly, they are decoded into the
+     * internal buffer of the view, so the memory is allocated only for long sequences.
+     */
+    class LSPStringView: private LSPString
+    {
+        private:
+            // Number of characters decoded into the view without heap allocation
+            static constexpr size_t BUFFER_SIZE     = 32;
+
+        private:
+            lsp_wchar_t        *pBuffer;                // Heap buffer for decoded characters
+            size_t              nBufCap;                // Capacity of the heap buffer
+            lsp_wchar_t         vBuffer[BUFFER_SIZE];   // Buffer for short decoded sequences
+
+        private:
+            lsp_wchar_t        *decode_buffer(size_t size);
+            inline void         bind(const lsp_wchar_t *data, size_t length);
+
+        public:
+            explicit LSPStringView();
+            explicit LSPStringView(const lsp_wchar_t *src, size_t length);
+            explicit LSPStringView(const LSPString *src);
+            explicit LSPStringView(const LSPString *src, ssize_t first);
+            explicit LSPStringView(const LSPString *src, ssize_t first, ssize_t last);
+            LSPStringView(const LSPStringView &) = delete;
+            LSPStringView(LSPStringView &&) = delete;
+            ~LSPStringView();
+
+            LSPStringView & operator = (const LSPStringView &) = delete;
+            LSPStringView & operator = (LSPStringView &&) = delete;
+
+        public:
+            /**
+             * Refer the character array
+             * @param src pointer to the first character
+             * @param length number of characters
+             */
+            void                set(const lsp_wchar_t *src, size_t length);
+
+            /**
+             * Refer the whole string
+             * @param src string to refer
+             */
+            void                set(const LSPString *src);
+
+            /**
+             * Refer the part of the string, negative indexes are counted from the end
+             * of the string like for LSPString::set()
+             * @param src string to refer
+             * @param first index of the first character
+             * @param last index of the character after the last one
+             * @return true on success, false if the range is out of bounds
+             */
+            bool                set(const LSPString *src, ssize_t first);
+            bool                set(const LSPString *src, ssize_t first, ssize_t last);
+            bool                set(const LSPStringView *src, ssize_t first, ssize_t last);
+
+            /**
+             * Decode UTF-8 sequence into the view
+             * @param src UTF-8 sequence
+             * @param length length of the sequence in bytes
+             * @return true on success, false if there is no memory
+             */
+            bool                set_utf8(const char *src, size_t length);
+            inline bool         set_utf8(const char *src)           { return set_utf8(src, ::strlen(src));      }
+
+            /**
+             * Decode ASCII sequence into the view
+             * @param src ASCII sequence
+             * @param length length of the sequence in bytes
+             * @return true on success, false if there is no memory
+             */
+            bool                set_ascii(const char *src, size_t length);
+            inline bool         set_ascii(const char *src)          { return set_ascii(src, ::strlen(src));     }
+
+            /**
+             * Reset the view to the empty sequence, the memory allocated for decoded data is kept
+             */
+            void                clear();
+
+            /**
+             * Get the view as a read-only string which can be passed to any routine that accepts
+             * the const LSPString pointer. The returned string is valid until the view is changed
+             * or destroyed.
+             * @return read-only string
+             */
+            inline const LSPString *string() const                  { return this;                              }
+
+        public:
+            using LSPString::length;
+            using LSPString::is_empty;
+            using LSPString::characters;
+            using LSPString::at;
+            using LSPString::char_at;
+            using LSPString::first;
+            using LSPString::last;
+
+            using LSPString::compare_to;
+            using LSPString::compare_to_ascii;
+            using LSPString::compare_to_utf8;
+            using LSPString::compare_to_nocase;
+            using LSPString::compare_to_ascii_nocase;
+            using LSPString::compare_to_utf8_nocase;
+            using LSPString::equals;
+            using LSPString::equals_nocase;
+            using LSPString::equals_ascii;
+            using LSPString::equals_ascii_nocase;
+            using LSPString::equals_utf8;
+            using LSPString::equals_utf8_nocase;
+            using LSPString::starts_with;
+            using LSPString::starts_with_ascii;
+            using LSPString::ends_with;
+            using LSPString::ends_with_ascii;
+            using LSPString::index_of;
+            using LSPString::rindex_of;
+            using LSPString::count;
+            using LSPString::hash;
+
+            using LSPString::get_utf8;
+            using LSPString::get_ascii;
+            using LSPString::get_native;
+            using LSPString::clone_utf8;
+            using LSPString::utf8_length;
+            using LSPString::utf16_length;
+            using LSPString::native_length;
+            using LSPString::encode_utf8;
+            using LSPString::encode_utf16;
+            using LSPString::encode_native;
+            using LSPString::to_utf8;
+            using LSPString::to_utf16;
+            using LSPString::to_native;
+
+            inline int          compare_to(const LSPStringView *src) const          { return compare_to(src->string());         }
+            inline int          compare_to_nocase(const LSPStringView *src) const   { return compare_to_nocase(src->string());  }
+            inline bool         equals(const LSPStringView *src) const              { return equals(src->string());             }
+            inline bool         equals_nocase(const LSPStringView *src) const       { return equals_nocase(src->string());      }
+    };
+
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_RUNTIME_LSPSTRINGVIEW_H_ */
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_RUNTIME_SHAREDSTRING_H_
+#define LSP_PLUG_IN_RUNTIME_SHAREDSTRING_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/LSPStringView.h>
+
+namespace lsp
+{
+    /**
+     * Immutable string with the reference-counted character buffer. Copying of the string
+     * is O(1) operation, all copies share the same buffer until the last of them is destroyed.
+     * The reference counter is atomic, so copies may be passed to and released by different
+     * threads. Concurrent access to the same SharedString object is not thread-safe.
+     *
+     * The string can be converted from LSPString in O(1) by taking ownership of its buffer
+     * and converted back in O(1) if there are no other references to the buffer. For
+     * read-only access the LSPStringView can be bound to the contents without copying.
+     */
+    class SharedString
+    {
+        protected:
+            typedef struct shared_t
+            {
+                uatomic_t           nReferences;    // Number of references to the buffer
+                size_t              nLength;        // Number of characters
+                size_t              nCapacity;      // Capacity of the buffer in characters
+                lsp_wchar_t        *pData;          // Character data compatible with LSPString
+            } shared_t;
+
+        protected:
+            shared_t           *pShared;        // Shared buffer, NULL for empty string
+            mutable size_t      nHash;          // Cached hash value
+
+        protected:
+            static void         release(shared_t *shared);
+            static shared_t    *create(lsp_wchar_t *data, size_t length, size_t capacity);
+            void                replace(shared_t *shared, size_t hash);
+
+        public:
+            explicit SharedString();
+            SharedString(const SharedString &) = delete;
+            SharedString(SharedString &&) = delete;
+            ~SharedString();
+
+            SharedString & operator = (const SharedString &) = delete;
+            SharedString & operator = (SharedString &&) = delete;
+
+        public:
+            /**
+             * Get the length of the string
+             * @return the length of the string
+             */
+            inline size_t       length() const             { return (pShared != NULL) ? pShared->nLength : 0;      }
+
+            /**
+             * Check whether the string is empty
+             * @return true if string is empty
+             */
+            inline bool         is_empty() const           { return pShared == NULL;                               }
+
+            /**
+             * Get pointer to the non-zero-terminated characters array
+             * @return pointer to the characters array, NULL for empty string
+             */
+            inline const lsp_wchar_t *characters() const   { return (pShared != NULL) ? pShared->pData : NULL;     }
+
+            /**
+             * Check that the character buffer is shared with other strings
+             * @return true if the character buffer is shared
+             */
+            bool                is_shared() const;
+
+            /**
+             * Get unicode character at the specified position
+             * @param index index, negative value means offset from the end of string
+             * @return character or 0 on error
+             */
+            lsp_wchar_t         at(ssize_t index) const;
+            inline lsp_wchar_t  char_at(ssize_t index) const    { return at(index);                                 }
+
+            /**
+             * Compute the hash value of the string, compatible with LSPString::hash()
+             * @return hash value
+             */
+            size_t              hash() const;
+
+        public:
+            /**
+             * Clear the string and release the reference to the buffer
+             */
+            void                clear();
+
+            /**
+             * Make the string referencing the same buffer as the other string, O(1)
+             * @param src source string
+             */
+            void                set(const SharedString *src);
+
+            /**
+             * Copy contents of the string
+             * @param src source string
+             * @return true on success
+             */
+            bool                set(const LSPString *src);
+            bool                set(const LSPString *src, ssize_t first);
+            bool                set(const LSPString *src, ssize_t first, ssize_t last);
+
+            /**
+             * Copy array of characters
+             * @param arr array of characters
+             * @param n number of characters
+             * @return true on success
+             */
+            bool                set(const lsp_wchar_t *arr, size_t n);
+
+            /**
+             * Set the contents from the UTF-8 sequence
+             * @param s UTF-8 sequence
+             * @param n number of bytes
+             * @return true on success
+             */
+            bool                set_utf8(const char *s, size_t n);
+            bool                set_utf8(const char *s);
+
+            /**
+             * Take the contents of the string. The buffer of the string is taken without
+             * copying if it is allocated on the heap. The source string becomes empty.
+             * @param src source string
+             * @return true on success
+             */
+            bool                take(LSPString *src);
+
+            /**
+             * Copy the contents to the string
+             * @param dst destination string
+             * @return true on success
+             */
+            bool                get(LSPString *dst) const;
+
+            /**
+             * Move the contents to the string for further modification. The buffer is passed
+             * to the string without copying if there are no other references to it. This
+             * string becomes empty.
+             * @param dst destination string
+             * @return true on success
+             */
+            bool                extract(LSPString *dst);
+
+            /**
+             * Bind the string view to the contents of the string. The view remains valid
+             * until this string is modified or destroyed.
+             * @param dst string view to bind
+             */
+            void                view(LSPStringView *dst) const;
+
+            /**
+             * Swap contents with another string
+             * @param dst string to swap
+             */
+            void                swap(SharedString *dst);
+            inline void         swap(SharedString &dst)     { swap(&dst);                                           }
+
+        public:
+            /**
+             * Check that strings are equal
+             * @param src string to compare
+             * @return true if strings are equal
+             */
+            bool                equals(const SharedString *src) const;
+            bool                equals(const LSPString *src) const;
+
+            /**
+             * Compare strings
+             * @param src string to compare
+             * @return negative value if this string is less, zero if equal, positive if greater
+             */
+            int                 compare_to(const SharedString *src) const;
+            int                 compare_to(const LSPString *src) const;
+    };
+
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_RUNTIME_SHAREDSTRING_H_ */
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_RUNTIME_STRINGBUILDER_H_
+#define LSP_PLUG_IN_RUNTIME_STRINGBUILDER_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/IOutStream.h>
+
+namespace lsp
+{
+    /**
+     * Builder for large texts generated by small pieces. The text is stored as UTF-8 in
+     * the list of chunks growing geometrically, so the appended data is never moved
+     * and the memory is not reallocated. Each character is always stored entirely within
+     * one chunk. The final result can be emitted in a single pass into the LSPString or
+     * the output stream.
+     */
+    class StringBuilder
+    {
+        protected:
+            typedef struct chunk_t
+            {
+                chunk_t            *pNext;          // Next chunk in the list
+                size_t              nSize;          // Number of bytes used
+                size_t              nCapacity;      // Capacity of the chunk in bytes
+            } chunk_t;
+
+        protected:
+            chunk_t            *pHead;          // First chunk
+            chunk_t            *pTail;          // Last chunk, the data is appended to it
+            size_t              nBytes;         // Overall number of bytes
+            size_t              nChars;         // Overall number of characters
+            size_t              nChunkSize;     // Size of the next chunk to allocate
+
+        protected:
+            static inline char *chunk_data(chunk_t *chunk);
+            static inline const char *chunk_data(const chunk_t *chunk);
+
+            char               *reserve(size_t bytes);
+            inline void         commit(size_t bytes, size_t chars);
+            bool                append_raw(const char *s, size_t count);
+
+        public:
+            explicit StringBuilder();
+            StringBuilder(const StringBuilder &) = delete;
+            StringBuilder(StringBuilder &&) = delete;
+            ~StringBuilder();
+
+            StringBuilder & operator = (const StringBuilder &) = delete;
+            StringBuilder & operator = (StringBuilder &&) = delete;
+
+        public:
+            /**
+             * Get the number of characters stored in the builder
+             * @return number of characters
+             */
+            inline size_t       length() const              { return nChars;        }
+
+            /**
+             * Get the size of the text in UTF-8 encoding
+             * @return size of the text in bytes
+             */
+            inline size_t       size() const                { return nBytes;        }
+
+            /**
+             * Check that the builder contains no data
+             * @return true if the builder contains no data
+             */
+            inline bool         is_empty() const            { return nBytes <= 0;   }
+
+            /**
+             * Clear the contents but keep the first chunk allocated for further use
+             */
+            void                clear();
+
+            /**
+             * Clear the contents and free all allocated memory
+             */
+            void                truncate();
+
+            /**
+             * Swap contents with another builder
+             * @param dst builder to perform swap
+             */
+            void                swap(StringBuilder *dst);
+            inline void         swap(StringBuilder &dst)    { swap(&dst);           }
+
+        public:
+            /**
+             * Append single character
+             * @param ch character to append
+             * @return true on success
+             */
+            bool                append(lsp_wchar_t ch);
+
+            /**
+             * Append array of characters
+             * @param arr array of characters
+             * @param n number of characters
+             * @return true on success
+             */
+            bool                append(const lsp_wchar_t *arr, size_t n);
+
+            /**
+             * Append the string or its part
+             * @param src string to append
+             * @param first index of the first character
+             * @param last index of the character after the last one
+             * @return true on success
+             */
+            bool                append(const LSPString *src, ssize_t first, ssize_t last);
+            inline bool         append(const LSPString *src, ssize_t first)     { return (src != NULL) ? append(src, first, src->length()) : false; }
+            inline bool         append(const LSPString *src)                    { return (src != NULL) ? append(src, 0, src->length()) : false; }
+
+            /**
+             * Append ASCII characters, each byte is treated as a character code
+             * @param str ASCII characters to append
+             * @param n number of characters
+             * @return true on success
+             */
+            bool                append_ascii(const char *str, size_t n);
+            bool                append_ascii(const char *str);
+
+            /**
+             * Append UTF-8 sequence, invalid sequences are replaced by 0xfffd code point
+             * @param str UTF-8 sequence
+             * @param n number of bytes in the sequence
+             * @return true on success
+             */
+            bool                append_utf8(const char *str, size_t n);
+            bool                append_utf8(const char *str);
+
+            /**
+             * Append decimal representation of the integer value
+             * @param value value to append
+             * @return true on success
+             */
+            bool                append_int(int64_t value);
+            bool                append_uint(uint64_t value);
+
+            /**
+             * Append hexadecimal representation of the integer value in lower case
+             * @param value value to append
+             * @param digits minimum number of digits to emit, padded with zeros
+             * @return true on success
+             */
+            bool                append_hex(uint64_t value, size_t digits = 0);
+
+            /**
+             * Append the shortest locale-independent representation of floating-point
+             * value that is parsed back into the same value
+             * @param value value to append
+             * @return true on success
+             */
+            bool                append_double(double value);
+            bool                append_float(float value);
+
+            /**
+             * Append the string or its part with backslash-escaping of control characters,
+             * backslashes and double quotes in the C/JSON style. The quotes are not emitted.
+             * @param src string to append
+             * @param first index of the first character
+             * @param last index of the character after the last one
+             * @return true on success
+             */
+            bool                append_escaped(const LSPString *src, ssize_t first, ssize_t last);
+            inline bool         append_escaped(const LSPString *src, ssize_t first) { return (src != NULL) ? append_escaped(src, first, src->length()) : false; }
+            inline bool         append_escaped(const LSPString *src)                { return (src != NULL) ? append_escaped(src, 0, src->length()) : false; }
+
+        public:
+            /**
+             * Store the contents of the builder to the string
+             * @param dst destination string, the previous contents is replaced
+             * @return true on success
+             */
+            bool                to_string(LSPString *dst) const;
+
+            /**
+             * Append the contents of the builder to the string
+             * @param dst destination string
+             * @return true on success
+             */
+            bool                append_to(LSPString *dst) const;
+
+            /**
+             * Write the contents of the builder as UTF-8 sequence to the output stream
+             * @param os output stream
+             * @return status of operation
+             */
+            status_t            write(io::IOutStream *os) const;
+
+            /**
+             * Copy the contents of the builder as NULL-terminated UTF-8 sequence to the buffer
+             * @param dst destination buffer
+             * @param size size of the destination buffer including the terminating zero,
+             *   should be at least size() + 1
+             * @return number of bytes written excluding the terminating zero or negative value
+             *   if the buffer is too small
+             */
+            ssize_t             copy_utf8(char *dst, size_t size) const;
+    };
+
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_RUNTIME_STRINGBUILDER_H_ */
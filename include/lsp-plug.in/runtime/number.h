@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_RUNTIME_NUMBER_H_
+#define LSP_PLUG_IN_RUNTIME_NUMBER_H_
+
+#include <lsp-plug.in/runtime/version.h>
+
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+
+/**
+ * Size of buffer that is enough to store the result of format_shortest() including
+ * the terminating zero character
+ */
+#define FLOAT_SHORTEST_BUF_SIZE         32
+
+namespace lsp
+{
+    /*
+     * All routines below do not depend on the current locale: the decimal point is always
+     * the '.' character, no digit grouping is performed. They do not modify the global state
+     * of the process and are safe to be called from any thread.
+     */
+
+    /**
+     * Format floating-point value using the shortest sequence of digits which is parsed back
+     * to exactly the same value. Fixed notation is used for decimal exponents in range
+     * [-5, 17), scientific notation ("1.5e+20") otherwise. Special values are formatted
+     * as "nan", "inf" and "-inf".
+     *
+     * @param dst destination buffer, should be at least FLOAT_SHORTEST_BUF_SIZE bytes long
+     * @param value value to format
+     * @return number of characters written, not including the terminating zero character
+     */
+    size_t      format_shortest(char *dst, double value);
+
+    /**
+     * Format single-precision floating-point value using the shortest sequence of digits which
+     * is parsed back to exactly the same single-precision value.
+     *
+     * @param dst destination buffer, should be at least FLOAT_SHORTEST_BUF_SIZE bytes long
+     * @param value value to format
+     * @return number of characters written, not including the terminating zero character
+     */
+    size_t      format_shortest(char *dst, float value);
+
+    /**
+     * Format floating-point value in fixed notation, the result is the same to the one
+     * produced by the "%.*f" format specifier of snprintf() in the "C" locale
+     *
+     * @param dst destination buffer, may be NULL if len is zero
+     * @param len size of the destination buffer, the result is always zero-terminated if non-zero
+     * @param value value to format
+     * @param precision number of digits after the decimal point
+     * @return number of characters that would have been written if the buffer was large enough,
+     *   not including the terminating zero character
+     */
+    size_t      format_fixed(char *dst, size_t len, double value, size_t precision);
+
+    /**
+     * Format floating-point value in scientific notation, the result is the same to the one
+     * produced by the "%.*e" format specifier of snprintf() in the "C" locale
+     *
+     * @param dst destination buffer, may be NULL if len is zero
+     * @param len size of the destination buffer, the result is always zero-terminated if non-zero
+     * @param value value to format
+     * @param precision number of digits after the decimal point
+     * @param upper use upper case for the exponent character and special values
+     * @return number of characters that would have been written if the buffer was large enough,
+     *   not including the terminating zero character
+     */
+    size_t      format_exp(char *dst, size_t len, double value, size_t precision, bool upper = false);
+
+    /**
+     * Format floating-point value according to the printf()-like format string. The format string
+     * should contain at most one conversion specification of the "%[flags][width][.precision]type"
+     * form where type is one of 'f', 'F', 'e', 'E', 'g', 'G'. Flags '-', '+', ' ', '#' and '0' are
+     * supported, the 'l' and 'L' length modifiers are ignored. Any other text is copied as is,
+     * the "%%" sequence is emitted as a single '%' character.
+     *
+     * @param dst destination buffer, may be NULL if len is zero
+     * @param len size of the destination buffer, the result is always zero-terminated if non-zero
+     * @param fmt format string
+     * @param value value to format
+     * @return number of characters that would have been written if the buffer was large enough,
+     *   not including the terminating zero character, negative value if format string is invalid
+     */
+    ssize_t     format_float(char *dst, size_t len, const char *fmt, double value);
+
+    /**
+     * Parse floating-point value in the same way strtod() does in the "C" locale: leading whitespace
+     * is skipped, optional sign, decimal digits with optional decimal point and optional exponent
+     * are accepted as well as case-insensitive "inf", "infinity" and "nan" special values. The
+     * result is always correctly rounded. Hexadecimal notation is not supported.
+     *
+     * @param dst pointer to store the parsed value, may be NULL
+     * @param src source string
+     * @param len length of the source string in bytes
+     * @param parsed pointer to store number of parsed bytes, may be NULL
+     * @return status of operation:
+     *   STATUS_OK if value has been parsed,
+     *   STATUS_BAD_FORMAT if there is no number at the beginning of the string,
+     *   STATUS_OVERFLOW if the magnitude of value is too large, infinity is stored to dst,
+     *   STATUS_UNDERFLOW if the non-zero value was rounded to zero, zero is stored to dst
+     */
+    status_t    parse_double(double *dst, const char *src, size_t len, size_t *parsed);
+
+    /**
+     * Parse floating-point value stored in zero-terminated string in the same way strtod() does
+     * in the "C" locale.
+     *
+     * @param dst pointer to store the parsed value, may be NULL
+     * @param src zero-terminated source string
+     * @param end pointer to store the pointer to the first character that has not been parsed, may be NULL
+     * @return status of operation, see parse_double(double *, const char *, size_t, size_t *)
+     */
+    status_t    parse_double(double *dst, const char *src, const char **end);
+
+    /**
+     * Parse single-precision floating-point value in the same way strtof() does in the "C" locale.
+     * The result is correctly rounded to single precision directly, without intermediate rounding
+     * to the double precision.
+     *
+     * @param dst pointer to store the parsed value, may be NULL
+     * @param src source string
+     * @param len length of the source string in bytes
+     * @param parsed pointer to store number of parsed bytes, may be NULL
+     * @return status of operation, see parse_double(double *, const char *, size_t, size_t *)
+     */
+    status_t    parse_float(float *dst, const char *src, size_t len, size_t *parsed);
+
+    /**
+     * Parse single-precision floating-point value stored in zero-terminated string in the same way
+     * strtof() does in the "C" locale.
+     *
+     * @param dst pointer to store the parsed value, may be NULL
+     * @param src zero-terminated source string
+     * @param end pointer to store the pointer to the first character that has not been parsed, may be NULL
+     * @return status of operation, see parse_double(double *, const char *, size_t, size_t *)
+     */
+    status_t    parse_float(float *dst, const char *src, const char **end);
+
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_RUNTIME_NUMBER_H_ */
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_IO_DIRECTTRANSFER_H_
+#define PRIVATE_IO_DIRECTTRANSFER_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/ipc/Condition.h>
+#include <lsp-plug.in/ipc/Thread.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /**
+         * Background worker that performs one positioned read or write operation
+         * at a time. It allows the owner to process one buffer while the other
+         * buffer is transferred to or from the file.
+         */
+        class DirectTransfer
+        {
+            private:
+                enum op_t
+                {
+                    OP_NONE,
+                    OP_READ,
+                    OP_WRITE,
+                    OP_EXIT
+                };
+
+            private:
+                NativeFile         *pFD;            // File to perform I/O
+                ipc::Thread        *pThread;        // Worker thread
+                ipc::Condition      sCond;          // Condition for synchronization
+                op_t                enOp;           // Requested operation
+                bool                bPending;       // Operation is pending or in progress
+                uint8_t            *pBuf;           // Buffer for operation
+                wsize_t             nOffset;        // Offset in the file
+                size_t              nSize;          // Number of bytes to transfer
+                ssize_t             nResult;        // Result of the last operation
+
+            private:
+                static status_t     thread_proc(void *arg);
+                void                run();
+                status_t            submit(op_t op, void *buf, wsize_t offset, size_t size);
+
+            public:
+                explicit DirectTransfer();
+                DirectTransfer(const DirectTransfer &) = delete;
+                DirectTransfer(DirectTransfer &&) = delete;
+                ~DirectTransfer();
+
+                DirectTransfer & operator = (const DirectTransfer &) = delete;
+                DirectTransfer & operator = (DirectTransfer &&) = delete;
+
+            public:
+                /**
+                 * Start the worker thread
+                 * @param fd file to perform I/O
+                 * @return status of operation
+                 */
+                status_t            start(NativeFile *fd);
+
+                /**
+                 * Wait for pending operation and stop the worker thread
+                 */
+                void                stop();
+
+                /**
+                 * Submit positioned read, there should be no pending operation
+                 * @param buf buffer to store data
+                 * @param offset offset in the file
+                 * @param size number of bytes to read
+                 * @return status of operation
+                 */
+                inline status_t     read(void *buf, wsize_t offset, size_t size)            { return submit(OP_READ, buf, offset, size);                            }
+
+                /**
+                 * Submit positioned write, there should be no pending operation
+                 * @param buf buffer with data
+                 * @param offset offset in the file
+                 * @param size number of bytes to write
+                 * @return status of operation
+                 */
+                inline status_t     write(const void *buf, wsize_t offset, size_t size)     { return submit(OP_WRITE, const_cast<void *>(buf), offset, size);       }
+
+                /**
+                 * Wait for completion of the pending operation
+                 * @return number of transferred bytes or negative error code,
+                 *   zero if there was no pending operation
+                 */
+                ssize_t             wait();
+
+                /**
+                 * Check that there is pending operation
+                 * @return true if there is pending operation
+                 */
+                inline bool         pending() const     { return bPending;  }
+        };
+
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* PRIVATE_IO_DIRECTTRANSFER_H_ */
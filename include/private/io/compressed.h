@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_IO_COMPRESSED_H_
+#define PRIVATE_IO_COMPRESSED_H_
+
+#include <lsp-plug.in/runtime/version.h>
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        /*
+         * Framed format of the compressed stream, all values are little-endian:
+         *
+         *   stream_header_t                      - stream header
+         *   { block_header_t, uint8_t[payload] } - sequence of blocks
+         *   block_header_t                       - terminating block header filled with zeros
+         *
+         * Each block is encoded independently of other blocks, so the reader may start
+         * decoding from any block. All blocks except the last one usually have the size
+         * of the block set in the header but shorter blocks are allowed (for example,
+         * after the explicit flush). The compression window of each block is limited
+         * to the block size or 1 << LOG_WINDOW_MAX bytes, whichever is less.
+         */
+        namespace compressed
+        {
+            static const uint8_t    MAGIC[4]            = { 'L', 'S', 'P', 'Z' };
+            static const uint8_t    VERSION             = 1;
+            static const size_t     LOG_BLOCK_MIN       = 10;
+            static const size_t     LOG_BLOCK_MAX       = 24;
+            static const size_t     LOG_BLOCK_DFL       = 16;
+            static const size_t     LOG_WINDOW_MAX      = 16;                   // Maximum logarithm of the compression window
+            static const size_t     SEARCH_DEPTH        = 32;                   // Maximum number of matches checked by the encoder
+            static const uint32_t   BLOCK_STORED        = uint32_t(1) << 31;    // Block payload is stored without compression
+            static const uint32_t   BLOCK_SIZE_MASK     = BLOCK_STORED - 1;
+
+            #pragma pack(push, 1)
+            typedef struct stream_header_t
+            {
+                uint8_t         magic[4];       // Stream signature
+                uint8_t         version;        // Version of the format
+                uint8_t         log_block;      // Logarithm of the maximum block size
+                uint16_t        reserved;       // Reserved, should be zero
+            } stream_header_t;
+
+            typedef struct block_header_t
+            {
+                uint32_t        size;           // Size of decompressed data with the BLOCK_STORED flag
+                uint32_t        payload;        // Size of the payload that follows the header
+                uint32_t        crc;            // CRC-32C of decompressed data
+            } block_header_t;
+            #pragma pack(pop)
+
+        } /* namespace compressed */
+    } /* namespace io */
+} /* namespace lsp */
+
+#endif /* PRIVATE_IO_COMPRESSED_H_ */
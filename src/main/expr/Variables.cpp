@@ -362,6 +362,96 @@ namespace lsp
             return first;
         }
 
+        ssize_t Variables::index_of_atom(const atom_t *atom)
+        {
+            const uintptr_t key = reinterpret_cast<uintptr_t>(atom);
+            ssize_t first = 0, last = vAtoms.size(), mid;
+
+            while (first < last)
+            {
+                mid             = (first + last) >> 1;
+                if (reinterpret_cast<uintptr_t>(vAtoms.uget(mid)->atom) < key)
+                    first           = mid + 1;
+                else
+                    last            = mid;
+            }
+
+            return first;
+        }
+
+        Variables::variable_t *Variables::atom_var(const atom_t *atom, size_t idx)
+        {
+            variable_t *var = vAtoms.get(idx);
+            return ((var != NULL) && (var->atom == atom)) ? var : NULL;
+        }
+
+        void Variables::bind_atom(const atom_t *atom, size_t idx)
+        {
+            ssize_t vidx    = index_of_var(&atom->name);
+            if (vidx < 0)
+                return;
+            variable_t *var = vVars.uget(vidx);
+            if ((var->atom != NULL) || (!var->name.equals(&atom->name)))
+                return;
+
+            // Failed binding does not break anything: the variable will be looked up by name
+            if (vAtoms.insert(idx, var))
+                var->atom       = atom;
+        }
+
+        void Variables::unbind_atom(variable_t *var)
+        {
+            if (var->atom == NULL)
+                return;
+
+            const ssize_t idx = index_of_atom(var->atom);
+            if (atom_var(var->atom, idx) == var)
+                vAtoms.remove(idx);
+            var->atom       = NULL;
+        }
+
+        status_t Variables::resolve(value_t *value, const atom_t *name)
+        {
+            if (name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            const ssize_t idx   = index_of_atom(name);
+            variable_t *var     = atom_var(name, idx);
+            if (var != NULL)
+                return (value != NULL) ? copy_value(value, &var->value) : STATUS_OK;
+
+            status_t res        = resolve(value, &name->name);
+            if (res == STATUS_OK)
+                bind_atom(name, idx);
+
+            return res;
+        }
+
+        status_t Variables::set(const atom_t *name, const value_t *value)
+        {
+            if (name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            const ssize_t idx   = index_of_atom(name);
+            variable_t *var     = atom_var(name, idx);
+            if (var != NULL)
+                return copy_value(&var->value, value);
+
+            status_t res        = set(&name->name, value);
+            if (res == STATUS_OK)
+                bind_atom(name, idx);
+
+            return res;
+        }
+
+        status_t Variables::unset(const atom_t *name, value_t *value)
+        {
+            if (name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            return unset(&name->name, value);
+        }
+
         ssize_t Variables::index_of_func(const LSPString *name)
         {
             const user_func_t *f;
@@ -396,6 +486,7 @@ namespace lsp
                 delete var;
                 return STATUS_NO_MEM;
             }
+            var->atom       = NULL;
 
             status_t res = init_value(&var->value, value);
             if (res == STATUS_OK)
@@ -418,6 +509,7 @@ namespace lsp
                 delete var;
                 return STATUS_NO_MEM;
             }
+            var->atom       = NULL;
 
             init_value_move(&var->value, value);
             status_t res = (vVars.insert(idx, var)) ? STATUS_OK : STATUS_NO_MEM;
@@ -520,6 +612,7 @@ namespace lsp
             }
 
             // Remove stored value
+            unbind_atom(var);
             vVars.remove(idx);
             destroy_value(&var->value);
             delete var;
@@ -539,6 +632,7 @@ namespace lsp
                 }
             }
             vVars.flush();
+            vAtoms.flush();
         }
 
         void Variables::clear_func()
@@ -23,14 +23,11 @@
 #include <lsp-plug.in/expr/Tokenizer.h>
 #include <lsp-plug.in/io/InStringSequence.h>
 #include <lsp-plug.in/io/OutStringSequence.h>
-#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/runtime/number.h>
 #include <lsp-plug.in/stdlib/math.h>
 #include <lsp-plug.in/stdlib/stdio.h>
 #include <lsp-plug.in/common/debug.h>
-
-#ifdef PLATFORM_WINDOWS
-    #include <ctype.h>
-#endif /* PLATFORM_WINDOWS */
+#include <lsp-plug.in/common/finally.h>
 
 namespace lsp
 {
@@ -744,42 +741,34 @@ namespace lsp
             }
             else
             {
-                char fmt[64];
-
-                SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
-            #ifdef PLATFORM_WINDOWS
-                // Windows format string does not respect uppercase format letters.
-                // That's why we need to do some workaround work
-                // Initialize format specifier
-                bool uppercase = isupper(spec->type);
-                char spec_type = tolower(spec->type);
-                if (spec->flags & F_FRAC)
-                    ::snprintf(fmt, sizeof(fmt), "%%.%d%c", int(spec->frac), spec_type);
-                else
-                    ::snprintf(fmt, sizeof(fmt), "%%.6%c", spec_type);
-                fmt[sizeof(fmt)-1] = '\0';
-
                 // Format the floating-point value and reverse buffer
-                if (!spec->buf.fmt_ascii(fmt, lsp_abs(v->v_float)))
-                    return STATUS_NO_MEM;
-
-                if (uppercase)
-                    spec->buf.toupper();
-                spec->buf.reverse();
-            #else
-                // Initialize format specifier
-                if (spec->flags & F_FRAC)
-                    ::snprintf(fmt, sizeof(fmt), "%%.%d%c", int(spec->frac), char(spec->type));
-                else
-                    ::snprintf(fmt, sizeof(fmt), "%%.6%c", char(spec->type));
-                fmt[sizeof(fmt)-1] = '\0';
+                const size_t frac   = (spec->flags & F_FRAC) ? spec->frac : 6;
+                const bool fixed    = (spec->type == 'f') || (spec->type == 'F');
+                const double value  = lsp_abs(v->v_float);
+
+                char tmp[0x80];
+                char *buf           = tmp;
+                lsp_finally {
+                    if (buf != tmp)
+                        free(buf);
+                };
+
+                size_t len          = (fixed) ?
+                    format_fixed(tmp, sizeof(tmp), value, frac) :
+                    format_exp(tmp, sizeof(tmp), value, frac, is_float_upper(spec));
+                if (len >= sizeof(tmp))
+                {
+                    // The value does not fit into the temporary buffer
+                    if ((buf = static_cast<char *>(malloc(len + 1))) == NULL)
+                        return STATUS_NO_MEM;
+                    len                 = (fixed) ?
+                        format_fixed(buf, len + 1, value, frac) :
+                        format_exp(buf, len + 1, value, frac, is_float_upper(spec));
+                }
 
-                // Format the floating-point value and reverse buffer
-                if (!spec->buf.fmt_ascii(fmt, lsp_abs(v->v_float)))
+                if (!spec->buf.set_ascii(buf, len))
                     return STATUS_NO_MEM;
                 spec->buf.reverse();
-            #endif /* PLATFORM_WINDOWS */
 
                 // Append to specified width
                 if (spec->flags & F_WIDTH)
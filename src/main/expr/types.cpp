@@ -22,7 +22,7 @@
 #include <lsp-plug.in/expr/types.h>
 #include <lsp-plug.in/expr/Tokenizer.h>
 #include <lsp-plug.in/io/InStringSequence.h>
-#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/runtime/number.h>
 #include <lsp-plug.in/stdlib/math.h>
 
 namespace lsp
@@ -671,9 +671,9 @@ namespace lsp
                     }
                     else
                     {
-                        // Update locale
-                        SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-                        if (!tmp.fmt_ascii("%f", double(v->v_float)))
+                        char buf[0x200]; // Enough for any value with 6 digits after the decimal point
+                        const size_t len = format_fixed(buf, sizeof(buf), v->v_float, 6);
+                        if (!tmp.set_ascii(buf, len))
                             return STATUS_NO_MEM;
                     }
                     break;
@@ -721,9 +721,9 @@ namespace lsp
                     }
                     else
                     {
-                        // Update locale
-                        SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-                        if (!tmp.fmt_ascii("%f", double(v->v_float)))
+                        char buf[0x200]; // Enough for any value with 6 digits after the decimal point
+                        const size_t len = format_fixed(buf, sizeof(buf), v->v_float, 6);
+                        if (!tmp.set_ascii(buf, len))
                             return STATUS_NO_MEM;
                     }
                     break;
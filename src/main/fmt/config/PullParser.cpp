@@ -23,7 +23,7 @@
 #include <lsp-plug.in/io/InFileStream.h>
 #include <lsp-plug.in/io/InStringSequence.h>
 #include <lsp-plug.in/io/InSequence.h>
-#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/runtime/number.h>
 #include <lsp-plug.in/stdlib/math.h>
 
 #include <errno.h>
@@ -673,16 +673,12 @@ namespace lsp
             else if (*s == '\0')
                 return STATUS_BAD_FORMAT;
 
-            // Save and update locale
-            SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
             // Parse float
-            errno = 0;
-            char *end   = NULL;
-            float value = ::strtof(s, &end);
-            size_t xf   = 0;
+            const char *end = NULL;
+            float value     = 0.0f;
+            size_t xf       = 0;
 
-            bool success = (errno == 0);
+            bool success = (lsp::parse_float(&value, s, &end) == STATUS_OK);
             if ((success) && (end != NULL))
             {
                 // Skip spaces
@@ -718,16 +714,12 @@ namespace lsp
             else if (*s == '\0')
                 return STATUS_BAD_FORMAT;
 
-            // Save and update locale
-            SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
             // Parse float
-            errno = 0;
-            char *end       = NULL;
-            double value    = ::strtod(s, &end);
+            const char *end = NULL;
+            double value    = 0.0;
             size_t xf       = 0;
 
-            bool success = (errno == 0);
+            bool success = (lsp::parse_double(&value, s, &end) == STATUS_OK);
             if ((success) && (end != NULL))
             {
                 // Skip spaces
@@ -20,10 +20,11 @@
  */
 
 #include <lsp-plug.in/fmt/config/Serializer.h>
-#include <lsp-plug.in/io/OutFileStream.h>
+#include <lsp-plug.in/io/OutBufStream.h>
+#include <lsp-plug.in/io/OutBuilderSequence.h>
 #include <lsp-plug.in/io/OutSequence.h>
 #include <lsp-plug.in/io/OutStringSequence.h>
-#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/runtime/number.h>
 
 namespace lsp
 {
@@ -130,9 +131,6 @@ namespace lsp
 
         status_t Serializer::write_float(double v, size_t flags)
         {
-            // Save and update locale
-            SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
             status_t res;
             char tmp[64];
             const char *fmt = "%f";
@@ -158,8 +156,7 @@ namespace lsp
                     default: fmt = "%.5f"; break;
                 }
             }
-            ::snprintf(tmp, sizeof(tmp), fmt, v);
-            tmp[sizeof(tmp)-1] = '\0';
+            format_float(tmp, sizeof(tmp), fmt, v);
 
             // Write value
             if (flags & SF_QUOTED)
@@ -210,7 +207,7 @@ namespace lsp
             else if (path == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
-            io::OutFileStream *ofs = new io::OutFileStream();
+            io::OutBufStream *ofs = new io::OutBufStream();
             if (ofs == NULL)
                 return STATUS_NO_MEM;
             status_t res = ofs->open(path, io::File::FM_WRITE | io::File::FM_TRUNC | io::File::FM_CREATE);
@@ -233,7 +230,7 @@ namespace lsp
             else if (path == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
-            io::OutFileStream *ofs = new io::OutFileStream();
+            io::OutBufStream *ofs = new io::OutBufStream();
             if (ofs == NULL)
                 return STATUS_NO_MEM;
             status_t res = ofs->open(path, io::File::FM_WRITE | io::File::FM_TRUNC | io::File::FM_CREATE);
@@ -256,7 +253,7 @@ namespace lsp
             else if (path == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
-            io::OutFileStream *ofs = new io::OutFileStream();
+            io::OutBufStream *ofs = new io::OutBufStream();
             if (ofs == NULL)
                 return STATUS_NO_MEM;
             status_t res = ofs->open(path, io::File::FM_WRITE | io::File::FM_TRUNC | io::File::FM_CREATE);
@@ -293,6 +290,27 @@ namespace lsp
             return res;
         }
 
+        status_t Serializer::wrap(StringBuilder *sb)
+        {
+            if (pOut != NULL)
+                return STATUS_BAD_STATE;
+            else if (sb == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            io::OutBuilderSequence *seq = new io::OutBuilderSequence(sb, false);
+            if (seq == NULL)
+                return STATUS_NO_MEM;
+
+            status_t res = wrap(seq, WRAP_CLOSE | WRAP_DELETE);
+            if (res == STATUS_OK)
+                return res;
+
+            seq->close();
+            delete seq;
+
+            return res;
+        }
+
         status_t Serializer::wrap(io::IOutStream *os, size_t flags, const char *charset)
         {
             if (pOut != NULL)
@@ -30,6 +30,7 @@ namespace lsp
     {
         param_t::param_t()
         {
+            atom        = NULL;
             flags       = SF_TYPE_NONE;
             ::bzero(&v, sizeof(v));
         }
@@ -45,6 +46,7 @@ namespace lsp
             tmp.flags   = SF_TYPE_NONE;
             if (!tmp.name.set(&src->name))
                 return false;
+            tmp.atom    = src->atom;
             if (!tmp.comment.set(&src->comment))
                 return false;
             tmp.flags   = src->flags;
@@ -98,6 +100,7 @@ namespace lsp
         void param_t::swap(param_t *dst)
         {
             name.swap(&dst->name);
+            lsp::swap(atom, dst->atom);
             comment.swap(&dst->comment);
             lsp::swap(flags, dst->flags);
             lsp::swap(v, dst->v);
@@ -106,6 +109,7 @@ namespace lsp
         void param_t::clear()
         {
             name.truncate();
+            atom        = NULL;
             comment.truncate();
             clear_value();
         }
@@ -469,17 +473,54 @@ namespace lsp
 
         bool param_t::set_name(const char * name)
         {
-            return (name != NULL) ? this->name.set_utf8(name) : false;
+            if ((name == NULL) || (!this->name.set_utf8(name)))
+                return false;
+            atom        = NULL;
+            return true;
         }
 
         bool param_t::set_name(const LSPString * name)
         {
-            return (name != NULL) ? this->name.set(name) : false;
+            if ((name == NULL) || (!this->name.set(name)))
+                return false;
+            atom        = NULL;
+            return true;
         }
 
         bool param_t::set_name(const LSPString & name)
         {
-            return this->name.set(&name);
+            return set_name(&name);
+        }
+
+        bool param_t::set_name(const atom_t *name)
+        {
+            if ((name == NULL) || (!this->name.set(&name->name)))
+                return false;
+            atom        = name;
+            return true;
+        }
+
+        bool param_t::intern_name(AtomTable *table)
+        {
+            if (table == NULL)
+                table       = AtomTable::global();
+            const atom_t *a = table->intern(&name);
+            if (a == NULL)
+                return false;
+            atom        = a;
+            return true;
+        }
+
+        bool param_t::is(const atom_t *name) const
+        {
+            if (name == NULL)
+                return false;
+
+            // Atoms issued by the same table are equal only if their pointers are equal
+            if ((atom != NULL) && (atom->table == name->table))
+                return atom == name;
+
+            return this->name.equals(&name->name);
         }
 
         bool param_t::set_blob(const blob_t *value)
@@ -210,6 +210,8 @@ namespace lsp
 
             if (pTokenizer != NULL)
             {
+                // Keep the read position of the sequence consistent with parsed data
+                res     = update_status(res, pTokenizer->sync());
                 delete pTokenizer;
                 pTokenizer = NULL;
             }
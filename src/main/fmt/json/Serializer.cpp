@@ -19,15 +19,17 @@
  * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <lsp-plug.in/common/finally.h>
 #include <lsp-plug.in/io/File.h>
-#include <lsp-plug.in/io/OutFileStream.h>
+#include <lsp-plug.in/io/OutBufStream.h>
+#include <lsp-plug.in/io/OutBuilderSequence.h>
 #include <lsp-plug.in/io/OutStringSequence.h>
 #include <lsp-plug.in/io/OutSequence.h>
 #include <lsp-plug.in/fmt/json/Tokenizer.h>
 #include <lsp-plug.in/fmt/json/Serializer.h>
+#include <lsp-plug.in/runtime/number.h>
 #include <lsp-plug.in/stdlib/stdio.h>
 #include <lsp-plug.in/stdlib/math.h>
-#include <lsp-plug.in/stdlib/locale.h>
 
 namespace lsp
 {
@@ -57,7 +59,7 @@ namespace lsp
             else if (path == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
-            io::OutFileStream *ofs = new io::OutFileStream();
+            io::OutBufStream *ofs = new io::OutBufStream();
             if (ofs == NULL)
                 return STATUS_NO_MEM;
             status_t res = ofs->open(path, io::File::FM_WRITE | io::File::FM_TRUNC | io::File::FM_CREATE);
@@ -80,7 +82,7 @@ namespace lsp
             else if (path == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
-            io::OutFileStream *ofs = new io::OutFileStream();
+            io::OutBufStream *ofs = new io::OutBufStream();
             if (ofs == NULL)
                 return STATUS_NO_MEM;
             status_t res = ofs->open(path, io::File::FM_WRITE | io::File::FM_TRUNC | io::File::FM_CREATE);
@@ -103,7 +105,7 @@ namespace lsp
             else if (path == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
-            io::OutFileStream *ofs = new io::OutFileStream();
+            io::OutBufStream *ofs = new io::OutBufStream();
             if (ofs == NULL)
                 return STATUS_NO_MEM;
             status_t res = ofs->open(path, io::File::FM_WRITE | io::File::FM_TRUNC | io::File::FM_CREATE);
@@ -148,6 +150,27 @@ namespace lsp
             return res;
         }
 
+        status_t Serializer::wrap(StringBuilder *sb, const serial_flags_t *settings)
+        {
+            if (pOut != NULL)
+                return STATUS_BAD_STATE;
+            else if (sb == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            io::OutBuilderSequence *seq = new io::OutBuilderSequence(sb, false);
+            if (seq == NULL)
+                return STATUS_NO_MEM;
+
+            status_t res = wrap(seq, settings, WRAP_CLOSE | WRAP_DELETE);
+            if (res == STATUS_OK)
+                return res;
+
+            seq->close();
+            delete seq;
+
+            return res;
+        }
+
         status_t Serializer::wrap(io::IOutStream *os, const serial_flags_t *settings, size_t flags, const char *charset)
         {
             if (pOut != NULL)
@@ -445,10 +468,8 @@ namespace lsp
             else if (isinf(value))
                 return (value < 0.0) ? write_raw("-Infinity", 9) : write_raw("Infinity", 8);
 
-            char buf[0x20];
             const char *fmt = (sSettings.fmt_double != NULL) ? sSettings.fmt_double : "%f";
-            int len = ::snprintf(buf, sizeof(buf), fmt, value);
-            return (len < int(sizeof(buf))) ? write_raw(buf, len) : STATUS_OVERFLOW;
+            return write_double(value, fmt);
         }
 
         status_t Serializer::write_double(double value, const char *fmt)
@@ -461,16 +482,21 @@ namespace lsp
             else if (isinf(value))
                 return (value < 0.0) ? write_raw("-Infinity", 9) : write_raw("Infinity", 8);
 
-            SET_LOCALE_SCOPED(LC_NUMERIC, "C"); // For proper decimal point
+            // Try to format into the stack buffer first, allocate buffer for long values
+            char tmp[0x40];
+            ssize_t len = format_float(tmp, sizeof(tmp), fmt, value);
+            if (len < 0)
+                return STATUS_BAD_FORMAT;
+            else if (len < ssize_t(sizeof(tmp)))
+                return write_raw(tmp, len);
 
-            char *buf = NULL;
-            int len = asprintf(&buf, fmt, value);
+            char *buf = static_cast<char *>(malloc(len + 1));
             if (buf == NULL)
                 return STATUS_NO_MEM;
+            lsp_finally { free(buf); };
 
-            status_t res = (len >= 0) ? write_raw(buf, len) : STATUS_NO_DATA;
-            ::free(buf);
-            return res;
+            format_float(buf, len + 1, fmt, value);
+            return write_raw(buf, len);
         }
 
         status_t Serializer::write_bool(bool value)
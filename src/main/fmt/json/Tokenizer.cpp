@@ -97,7 +97,7 @@ namespace lsp
         
         Tokenizer::Tokenizer(io::IInSequence *in)
         {
-            pIn         = in;
+            sIn.wrap(in);
             cCurrent    = -1;
             enToken     = JT_UNKNOWN;
             nError      = STATUS_OK;
@@ -111,7 +111,8 @@ namespace lsp
         
         Tokenizer::~Tokenizer()
         {
-            pIn         = NULL;
+            // The sequence may be already destroyed, do not access it
+            sIn.detach();
             if (vPending != NULL)
             {
                 ::free(vPending);
@@ -121,34 +122,62 @@ namespace lsp
             nCapacity   = 0;
         }
 
+        status_t Tokenizer::sync()
+        {
+            return sIn.sync();
+        }
+
         token_t Tokenizer::set_error(status_t code)
         {
             nError          = code;
             return enToken  = JT_ERROR;
         }
 
+        inline bool Tokenizer::is_whitespace(lsp_swchar_t ch)
+        {
+            return ::iswspace(ch) || ::iswblank(ch);
+        }
+
         lsp_swchar_t Tokenizer::skip_whitespace()
         {
             if (cCurrent < 0)
-                cCurrent = pIn->read();
+                cCurrent = sIn.read();
 
-            while (true)
+            while (is_whitespace(cCurrent))
             {
-                // Skip whitespace
-                if (::iswspace(cCurrent) || (::iswblank(cCurrent)))
-                    cCurrent = pIn->read();
-                else
-                    return cCurrent;
+                // Skip whitespace available in the span without fetching characters one by one
+                const lsp_wchar_t *p    = sIn.head();
+                const lsp_wchar_t *tail = sIn.tail();
+                while ((p < tail) && (is_whitespace(*p)))
+                    ++p;
+                sIn.advance(p - sIn.head());
+
+                cCurrent = sIn.read();
             }
+
+            return cCurrent;
         }
 
         lsp_swchar_t Tokenizer::lookup()
         {
             if (cCurrent < 0)
-                cCurrent = pIn->read();
+                cCurrent = sIn.read();
             return cCurrent;
         }
 
+        status_t Tokenizer::append_span(const lsp_wchar_t *tail)
+        {
+            const lsp_wchar_t *head = sIn.head();
+            if (tail <= head)
+                return STATUS_OK;
+
+            if (!sValue.append(head, tail - head))
+                return STATUS_NO_MEM;
+            sIn.advance(tail - head);
+
+            return STATUS_OK;
+        }
+
         token_t Tokenizer::commit(token_t token)
         {
             if (cCurrent < 0)
@@ -383,6 +412,14 @@ namespace lsp
 
                     if ((type = commit(type)) == JT_ERROR)
                         return type;
+
+                    // Append the run of regular characters available in the span at once
+                    const lsp_wchar_t *p    = sIn.head();
+                    const lsp_wchar_t *tail = sIn.tail();
+                    while ((p < tail) && (*p != '\\') && (*p != '\n') && (*p != '\"') && (*p != '\''))
+                        ++p;
+                    if ((res = append_span(p)) != STATUS_OK)
+                        return set_error(res);
                 }
             }
 
@@ -557,6 +594,14 @@ namespace lsp
                         token_t tok = commit(JT_SL_COMMENT);
                         if (tok == JT_ERROR)
                             return tok;
+
+                        // Append the run of regular characters available in the span at once
+                        const lsp_wchar_t *p    = sIn.head();
+                        const lsp_wchar_t *tail = sIn.tail();
+                        while ((p < tail) && (*p != '\n') && (*p != '\\'))
+                            ++p;
+                        if ((res = append_span(p)) != STATUS_OK)
+                            return set_error(res);
                         break;
                     }
                 }
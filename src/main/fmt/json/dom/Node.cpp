@@ -22,7 +22,7 @@
 #include <lsp-plug.in/fmt/json/dom/Node.h>
 #include <lsp-plug.in/io/InStringSequence.h>
 #include <lsp-plug.in/expr/Tokenizer.h>
-#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/runtime/number.h>
 
 namespace lsp
 {
@@ -443,8 +443,9 @@ namespace lsp
                     break;
                 case JN_DOUBLE:
                 {
-                    SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-                    if (!tmp.fmt_ascii("%f", double(pNode->fValue)))
+                    char buf[0x200]; // Enough for any value with 6 digits after the decimal point
+                    const size_t len = format_fixed(buf, sizeof(buf), pNode->fValue, 6);
+                    if (!tmp.set_ascii(buf, len))
                         return STATUS_NO_MEM;
                     break;
                 }
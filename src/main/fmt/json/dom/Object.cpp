@@ -23,6 +23,7 @@
 #include <lsp-plug.in/io/InStringSequence.h>
 #include <lsp-plug.in/expr/Tokenizer.h>
 #include <lsp-plug.in/expr/types.h>
+#include <lsp-plug.in/runtime/LSPStringView.h>
 
 namespace lsp
 {
@@ -85,10 +86,10 @@ namespace lsp
 
         Node Object::get(const char *field)
         {
-            LSPString tmp;
+            LSPStringView tmp;
             if (!tmp.set_utf8(field))
                 return Node();
-            return get(&tmp);
+            return get(tmp.string());
         }
 
         Node Object::get(const LSPString *field)
@@ -102,10 +103,10 @@ namespace lsp
 
         bool Object::contains(const char *field) const
         {
-            LSPString tmp;
+            LSPStringView tmp;
             if (!tmp.set_utf8(field))
                 return false;
-            return contains(&tmp);
+            return contains(tmp.string());
         }
 
         bool Object::contains(const LSPString *field) const
@@ -115,10 +116,10 @@ namespace lsp
 
         status_t Object::remove(const char *field)
         {
-            LSPString tmp;
+            LSPStringView tmp;
             if (!tmp.set_utf8(field))
                 return STATUS_NO_MEM;
-            return remove(&tmp);
+            return remove(tmp.string());
         }
 
         status_t Object::remove(const LSPString *field)
@@ -136,10 +137,10 @@ namespace lsp
 
         status_t Object::set(const char *field, const Node *node)
         {
-            LSPString tmp;
+            LSPStringView tmp;
             if (!tmp.set_utf8(field))
                 return STATUS_NO_MEM;
-            return set(&tmp, node);
+            return set(tmp.string(), node);
         }
 
         status_t Object::set(const LSPString *field, const Node *node)
@@ -24,7 +24,7 @@
 #include <lsp-plug.in/io/InStringSequence.h>
 #include <lsp-plug.in/expr/Tokenizer.h>
 #include <lsp-plug.in/expr/types.h>
-#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/runtime/number.h>
 
 namespace lsp
 {
@@ -186,8 +186,9 @@ namespace lsp
                     return (dst->fmt_ascii("%lld", (long long)pNode->nValue) > 0) ? STATUS_OK : STATUS_NO_MEM;
                 case JN_DOUBLE:
                 {
-                    SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-                    return (dst->fmt_ascii("%f", (long long)pNode->fValue) > 0) ? STATUS_OK : STATUS_NO_MEM;
+                    char buf[0x200]; // Enough for any value with 6 digits after the decimal point
+                    const size_t len = format_fixed(buf, sizeof(buf), pNode->fValue, 6);
+                    return (dst->set_ascii(buf, len)) ? STATUS_OK : STATUS_NO_MEM;
                 }
                 case JN_BOOL:
                     return (dst->set_ascii((pNode->bValue) ? "true" : "false")) ? STATUS_OK : STATUS_NO_MEM;
@@ -23,7 +23,7 @@
 #include <lsp-plug.in/common/types.h>
 #include <lsp-plug.in/fmt/lspc/util/config.h>
 #include <lsp-plug.in/io/InFileStream.h>
-#include <lsp-plug.in/io/OutFileStream.h>
+#include <lsp-plug.in/io/OutBufStream.h>
 #include <lsp-plug.in/io/InMemoryStream.h>
 #include <lsp-plug.in/io/OutMemoryStream.h>
 
@@ -201,7 +201,7 @@ namespace lsp
         LSP_RUNTIME_LIB_PUBLIC
         status_t read_config(chunk_id_t chunk_id, File *file, const char *path, size_t buf_size)
         {
-            io::OutFileStream os;
+            io::OutBufStream os;
             status_t res = os.open(path, io::File::FM_WRITE_NEW);
             if (res != STATUS_OK)
                 return res;
@@ -213,7 +213,7 @@ namespace lsp
         LSP_RUNTIME_LIB_PUBLIC
         status_t read_config(chunk_id_t chunk_id, File *file, const io::Path *path, size_t buf_size)
         {
-            io::OutFileStream os;
+            io::OutBufStream os;
             status_t res = os.open(path, io::File::FM_WRITE_NEW);
             if (res != STATUS_OK)
                 return res;
@@ -225,7 +225,7 @@ namespace lsp
         LSP_RUNTIME_LIB_PUBLIC
         status_t read_config(chunk_id_t chunk_id, File *file, const LSPString *path, size_t buf_size)
         {
-            io::OutFileStream os;
+            io::OutBufStream os;
             status_t res = os.open(path, io::File::FM_WRITE_NEW);
             if (res != STATUS_OK)
                 return res;
@@ -362,37 +362,12 @@ namespace lsp
 
         status_t Compressor::write_varint(size_t value)
         {
-            do
-            {
-                const uint8_t b     = (value >= 0x40) ? 0x40 | (value & 0x3f) : value;
-                value     >>= 6;
-
-                status_t res        = pOut->writev(b, 7);
-                if (res != STATUS_OK)
-                    return res;
-            } while (value > 0);
-
-            return STATUS_OK;
+            return pOut->writevar(uint64_t(value), VARINT_BITS);
         }
 
         status_t Compressor::write_varint_icount(size_t value)
         {
-            size_t bits = 3;
-            size_t max  = 1 << bits;
-            do
-            {
-                const size_t b      = (value >= max) ? max | (value & (max - 1)) : value;
-                status_t res        = pOut->writev(fixed_int(b), bits + 1);
-                if (res != STATUS_OK)
-                    return res;
-
-                // Update count
-                value             >>= bits;
-                bits               += 2;
-                max               <<= 2;
-            } while (value > 0);
-
-            return STATUS_OK;
+            return pOut->writevar(uint64_t(value), ICOUNT_BITS, ICOUNT_STEP);
         }
 
         status_t Compressor::write_utf8(const char *text)
@@ -72,6 +72,8 @@ namespace lsp
             return cvt.f32;
         }
 
+        static constexpr size_t INDEX_BATCH     = 64;
+
         static inline int32_t zigzag_decode(uint32_t value)
         {
             return (int32_t(value) >> 1) ^ -(int32_t(value) & 1);
@@ -312,51 +314,24 @@ namespace lsp
 
         status_t Decompressor::read_varint(size_t *dst)
         {
-            size_t value        = 0;
-            size_t shift        = 0;
-            uint8_t b;
-
-            do
-            {
-                ssize_t nread       = sStream.readv(&b, 7);
-                if (nread != 7)
-                    return (nread < 0) ? status_t(-nread) : STATUS_CORRUPTED;
-
-                value              |= size_t(b & 0x3f) << shift;
-                shift              += 6;
-            } while (b & 0x40);
+            uint64_t value      = 0;
+            ssize_t nread       = sStream.readvar(&value, 1, VARINT_BITS);
+            if (nread != 1)
+                return (nread < 0) ? status_t(-nread) : STATUS_CORRUPTED;
 
-            *dst                = value;
+            *dst                = size_t(value);
 
             return STATUS_OK;
         }
 
         status_t Decompressor::read_varint_icount(size_t *dst)
         {
-            size_t bits         = 3;
-            size_t max          = 1 << bits;
-            size_t value        = 0;
-            size_t b            = 0;
-            size_t shift        = 0;
-
-            while (true)
-            {
-                ssize_t nread       = sStream.readv(fixed_int(&b), bits + 1);
-                if (nread != ssize_t(bits + 1))
-                    return (nread < 0) ? status_t(-nread) : STATUS_CORRUPTED;
-
-                // Decode value
-                value              |= (b & (max - 1)) << shift;
-                if (!(b & max))
-                    break;
-
-                // Update bit count
-                shift              += bits;
-                bits               += 2;
-                max               <<= 2;
-            }
+            uint64_t value      = 0;
+            ssize_t nread       = sStream.readvar(&value, 1, ICOUNT_BITS, ICOUNT_STEP);
+            if (nread != 1)
+                return (nread < 0) ? status_t(-nread) : STATUS_CORRUPTED;
 
-            *dst                = value;
+            *dst                = size_t(value);
 
             return STATUS_OK;
         }
@@ -370,18 +345,29 @@ namespace lsp
                 return STATUS_OK;
             }
 
-            size_t value    = 0;
-            status_t res    = read_varint_icount(&value);
-            if (res != STATUS_OK)
-                return res;
-            dst[0]          = zigzag_decode(int32_t(value));
+            // Decode indices by batches
+            uint32_t buf[INDEX_BATCH];
+            index_t base    = 0;
 
-            for (size_t i=1; i<count; ++i)
+            for (size_t offset=0; offset < count; )
             {
-                status_t res            = read_varint_icount(&value);
-                if (res != STATUS_OK)
-                    return res;
-                dst[i]                  = dst[0] + zigzag_decode(int32_t(value));
+                const size_t to_read    = lsp_min(count - offset, size_t(INDEX_BATCH));
+                const ssize_t nread     = sStream.readvar(buf, to_read, ICOUNT_BITS, ICOUNT_STEP);
+                if (nread != ssize_t(to_read))
+                    return (nread < 0) ? status_t(-nread) : STATUS_CORRUPTED;
+
+                // First index is absolute, all other indices are relative to the first one
+                size_t i        = 0;
+                if (offset == 0)
+                {
+                    base            = zigzag_decode(int32_t(buf[0]));
+                    dst[0]          = base;
+                    ++i;
+                }
+                for ( ; i < to_read; ++i)
+                    dst[offset + i] = base + zigzag_decode(int32_t(buf[i]));
+
+                offset         += to_read;
             }
 
             return STATUS_OK;
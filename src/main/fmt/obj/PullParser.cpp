@@ -25,7 +25,7 @@
 #include <lsp-plug.in/io/InFileStream.h>
 #include <lsp-plug.in/io/InStringSequence.h>
 #include <lsp-plug.in/io/InSequence.h>
-#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/runtime/number.h>
 
 #include <errno.h>
 
@@ -483,14 +483,10 @@ namespace lsp
             if (*s == NULL)
                 return false;
 
-            // Save and update locale
-            SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
             // Parse floating-point value
-            errno = 0;
-            char *ptr = NULL;
-            float result = strtof(*s, &ptr);
-            bool success = ((errno == 0) && (ptr > *s));
+            const char *ptr = NULL;
+            float result    = 0.0f;
+            bool success    = (lsp::parse_float(&result, *s, &ptr) == STATUS_OK);
             if (success)
             {
                 *dst    = result;
@@ -35,6 +35,9 @@ namespace lsp
         PullParser::PullParser()
         {
             pIn             = NULL;
+            pBuffer         = NULL;
+            nBufSize        = 0;
+            nBufOffset      = 0;
             nWFlags         = 0;
             sCurrent.type   = EVENT_NONE;
             sSample.type    = EVENT_NONE;
@@ -146,7 +149,16 @@ namespace lsp
             if (pIn != NULL)
                 return STATUS_OPENED;
 
+            if (pBuffer == NULL)
+            {
+                pBuffer         = static_cast<uint8_t *>(malloc(BUF_SIZE));
+                if (pBuffer == NULL)
+                    return STATUS_NO_MEM;
+            }
+
             pIn             = is;
+            nBufSize        = 0;
+            nBufOffset      = 0;
             nWFlags         = flags;
             sCurrent.type   = EVENT_NONE;
             sUnget.truncate();
@@ -171,6 +183,14 @@ namespace lsp
             sUnget.truncate();
             nUnget          = 0;
 
+            if (pBuffer != NULL)
+            {
+                free(pBuffer);
+                pBuffer         = NULL;
+            }
+            nBufSize        = 0;
+            nBufOffset      = 0;
+
             return res;
         }
 
@@ -260,7 +280,20 @@ namespace lsp
                 }
                 return ch;
             }
-            return lsp_swchar_t(pIn->read_byte());
+
+            return (nBufOffset < nBufSize) ? lsp_swchar_t(pBuffer[nBufOffset++]) : fill_buffer();
+        }
+
+        lsp_swchar_t PullParser::fill_buffer()
+        {
+            const ssize_t nread = pIn->read(pBuffer, BUF_SIZE);
+            if (nread <= 0)
+                return (nread < 0) ? lsp_swchar_t(nread) : -STATUS_EOF;
+
+            nBufSize        = nread;
+            nBufOffset      = 1;
+
+            return pBuffer[0];
         }
 
         status_t PullParser::peek_pending_event(event_t *ev)
@@ -21,7 +21,7 @@
 
 #include <lsp-plug.in/fmt/sfz/parse.h>
 
-#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/runtime/number.h>
 #include <lsp-plug.in/stdlib/stdlib.h>
 #include <lsp-plug.in/stdlib/string.h>
 
@@ -137,9 +137,6 @@ namespace lsp
 
         status_t parse_int(ssize_t *dst, const char *text)
         {
-            // Update locale
-            SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
             // Parse the integer value
             errno       = 0;
             char *end   = NULL;
@@ -160,14 +157,10 @@ namespace lsp
 
         status_t parse_float(float *dst, const char *text)
         {
-            // Update locale
-            SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
             // Parse the floating-point value
-            errno       = 0;
-            char *end   = NULL;
-            float value = ::strtof(text, &end);
-            if ((errno != 0) || (end == text))
+            const char *end = NULL;
+            float value     = 0.0f;
+            if (lsp::parse_float(&value, text, &end) != STATUS_OK)
                 return STATUS_INVALID_VALUE;
             text        = skip_blank(end);
 
@@ -199,6 +199,7 @@ namespace lsp
                 return STATUS_BAD_ARGUMENTS;
 
             pIn             = seq;
+            sIn.wrap(seq);
             nWFlags         = flags;
             nToken          = -STATUS_NO_DATA;
             nState          = PS_READ_MISC;
@@ -237,6 +238,7 @@ namespace lsp
             // Release input sequence
             if (pIn != NULL)
             {
+                sIn.wrap(NULL);
                 if (nWFlags & WRAP_CLOSE)
                     res         = pIn->close();
 
@@ -251,7 +253,7 @@ namespace lsp
 
         lsp_swchar_t PullParser::getch()
         {
-            return (nUngetch > 0) ? vUngetch[--nUngetch] : pIn->read();
+            return (nUngetch > 0) ? vUngetch[--nUngetch] : sIn.read();
         }
 
         void PullParser::ungetch(lsp_swchar_t ch)
@@ -259,6 +261,28 @@ namespace lsp
             vUngetch[nUngetch++] = ch;
         }
 
+        status_t PullParser::append_span(LSPString *dst, lsp_wchar_t c1, lsp_wchar_t c2, lsp_wchar_t c3)
+        {
+            // Characters returned back precede the span
+            if (nUngetch > 0)
+                return STATUS_OK;
+
+            // Append all characters of the span up to the first stop character
+            const lsp_wchar_t *head = sIn.head();
+            const lsp_wchar_t *tail = sIn.tail();
+            const lsp_wchar_t *p    = head;
+            while ((p < tail) && (*p != c1) && (*p != c2) && (*p != c3))
+                ++p;
+            if (p <= head)
+                return STATUS_OK;
+
+            if (!dst->append(head, p - head))
+                return STATUS_NO_MEM;
+            sIn.advance(p - head);
+
+            return STATUS_OK;
+        }
+
         void PullParser::push_state(parse_state_t override)
         {
             vStates[nStates++]  = nState;
@@ -390,12 +414,17 @@ namespace lsp
                     return STATUS_OK; // Query for reference, do not need to pop_state()
                 }
 
-                // Append current character
+                // Append current character and all regular characters that follow it
                 if (!sValue.append(c))
                 {
                     pop_state();
                     return STATUS_NO_MEM;
                 }
+                if ((res = append_span(&sValue, qc, '&', qc)) != STATUS_OK)
+                {
+                    pop_state();
+                    return res;
+                }
             }
 
             pop_state();
@@ -581,6 +610,7 @@ namespace lsp
         status_t PullParser::read_comment()
         {
             lsp_swchar_t c, xc;
+            status_t res;
             sValue.clear();
 
             while (true)
@@ -609,6 +639,8 @@ namespace lsp
 
                 if (!sValue.append(c))
                     return STATUS_NO_MEM;
+                if ((res = append_span(&sValue, '-', '-', '-')) != STATUS_OK)
+                    return res;
             }
 
             return STATUS_OK;
@@ -1094,12 +1126,17 @@ namespace lsp
                     }
                 }
 
-                // No, simple character
+                // No, simple character, append it and all regular characters that follow it
                 if (!sValue.append(c))
                 {
                     pop_state();
                     return STATUS_NO_MEM;
                 }
+                if ((res = append_span(&sValue, '<', '&', '>')) != STATUS_OK)
+                {
+                    pop_state();
+                    return res;
+                }
             }
 
             // Ensure that there is character data
@@ -22,6 +22,7 @@
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/i18n/Dictionary.h>
 #include <lsp-plug.in/i18n/JsonDictionary.h>
+#include <lsp-plug.in/runtime/LSPStringView.h>
 
 namespace lsp
 {
@@ -109,19 +110,15 @@ namespace lsp
             if (key == NULL)
                 return STATUS_INVALID_VALUE;
 
-            LSPString id, subkey;
+            // Split the key without copying the data
+            LSPStringView id, subkey;
             ssize_t idx = key->index_of('.');
             if (idx < 0)
-            {
-                if (!id.set(key))
-                    return STATUS_NO_MEM;
-            }
+                id.set(key);
             else
             {
-                if (!id.set(key, 0, idx))
-                    return STATUS_NO_MEM;
-                if (!subkey.set(key, idx+1))
-                    return STATUS_NO_MEM;
+                id.set(key, 0, idx);
+                subkey.set(key, idx+1);
             }
 
             // Perform binary search of the item
@@ -130,7 +127,7 @@ namespace lsp
             {
                 ssize_t curr = (first + last) >> 1;
                 node_t *node = vNodes.uget(curr);
-                int cmp = node->sKey.compare_to(&id);
+                int cmp = node->sKey.compare_to(id.string());
 
                 if (cmp > 0)
                     last    = curr - 1;
@@ -140,7 +137,7 @@ namespace lsp
                 {
                     if (id.is_empty())
                         return STATUS_NOT_FOUND;
-                    return (node->pDict != NULL) ? node->pDict->lookup(&subkey, value) : STATUS_NOT_FOUND;
+                    return (node->pDict != NULL) ? node->pDict->lookup(subkey.string(), value) : STATUS_NOT_FOUND;
                 }
             }
 
@@ -150,25 +147,85 @@ namespace lsp
 
             // Dictionary not found, try to create new one
             IDictionary *dict = NULL;
-            status_t res = load_dictionary(&id, &dict);
+            status_t res = load_dictionary(id.string(), &dict);
             if (res == STATUS_NOT_FOUND)
-                res = create_child(&dict, &id);
+                res = create_child(&dict, id.string());
 
             // Add node to list of nodes
             if (res != STATUS_OK)
                 return res;
 
             node_t *child = new node_t;
-            if ((child == NULL) || (!vNodes.insert(first, child)))
+            if ((child == NULL) || (!child->sKey.set(id.string())) || (!vNodes.insert(first, child)))
             {
+                delete child;
                 delete dict;
                 return STATUS_NO_MEM;
             }
 
-            child->sKey.swap(&id);
             child->pDict        = dict;
 
-            return dict->lookup(&subkey, value);
+            return dict->lookup(subkey.string(), value);
+        }
+
+        ssize_t Dictionary::index_of_cached(const atom_t *key)
+        {
+            const uintptr_t ptr = reinterpret_cast<uintptr_t>(key);
+            ssize_t first = 0, last = vCache.size(), mid;
+
+            while (first < last)
+            {
+                mid             = (first + last) >> 1;
+                if (reinterpret_cast<uintptr_t>(vCache.uget(mid)->pKey) < ptr)
+                    first           = mid + 1;
+                else
+                    last            = mid;
+            }
+
+            return first;
+        }
+
+        status_t Dictionary::lookup(const atom_t *key, LSPString *value)
+        {
+            if (key == NULL)
+                return STATUS_INVALID_VALUE;
+
+            // Lookup the cache first
+            const ssize_t idx   = index_of_cached(key);
+            cached_t *c         = vCache.get(idx);
+            if ((c != NULL) && (c->pKey == key))
+            {
+                if ((c->nStatus == STATUS_OK) && (value != NULL) && (!value->set(&c->sValue)))
+                    return STATUS_NO_MEM;
+                return c->nStatus;
+            }
+
+            // Perform the regular lookup
+            LSPString tmp;
+            status_t res        = lookup(&key->name, &tmp);
+            if ((res != STATUS_OK) && (res != STATUS_NOT_FOUND))
+                return res;
+
+            // Remember the result, the dictionary data does not change until it is cleared
+            c                   = new cached_t;
+            if (c != NULL)
+            {
+                c->pKey             = key;
+                c->nStatus          = res;
+                c->sValue.swap(&tmp);
+                if (!vCache.insert(idx, c))
+                {
+                    tmp.swap(&c->sValue);
+                    delete c;
+                    c                   = NULL;
+                }
+            }
+
+            const LSPString *src = (c != NULL) ? &c->sValue : &tmp;
+            if ((res == STATUS_OK) && (value != NULL) && (!value->set(src)))
+                return STATUS_NO_MEM;
+
+            return res;
         }
 
         status_t Dictionary::lookup(const LSPString *key, IDictionary **value)
@@ -176,18 +233,17 @@ namespace lsp
             if (key == NULL)
                 return STATUS_INVALID_VALUE;
 
+            // Split the key without copying the data
             ssize_t idx = key->index_of('.');
-            LSPString id, subkey;
+            LSPStringView id, subkey;
 
             if (idx > 0)
             {
-                if (!id.set(key, 0, idx))
-                    return STATUS_NO_MEM;
-                if (!subkey.set(key, idx+1))
-                    return STATUS_NO_MEM;
+                id.set(key, 0, idx);
+                subkey.set(key, idx+1);
             }
-            else if (!id.set(key))
-                return STATUS_NO_MEM;
+            else
+                id.set(key);
 
             // Perform binary search of the dictionary
             IDictionary *dict = NULL;
@@ -196,7 +252,7 @@ namespace lsp
             {
                 ssize_t curr = (first + last) >> 1;
                 node_t *node = vNodes.uget(curr);
-                int cmp = node->sKey.compare_to(&id);
+                int cmp = node->sKey.compare_to(id.string());
 
                 if (cmp > 0)
                     last    = curr - 1;
@@ -216,10 +272,10 @@ namespace lsp
             {
                 // Try to load/create node
                 bool root    = false;
-                status_t res = load_dictionary(&id, &dict);
+                status_t res = load_dictionary(id.string(), &dict);
                 if (res == STATUS_NOT_FOUND)
                 {
-                    res         = create_child(&dict, &id);
+                    res         = create_child(&dict, id.string());
                     root        = true;
                 }
                 if (res != STATUS_OK)
@@ -227,13 +283,13 @@ namespace lsp
 
                 // Add node to list of nodes
                 node_t *child = new node_t;
-                if ((child == NULL) || (!vNodes.insert(first, child)))
+                if ((child == NULL) || (!child->sKey.set(id.string())) || (!vNodes.insert(first, child)))
                 {
+                    delete child;
                     delete dict;
                     return STATUS_NO_MEM;
                 }
 
-                child->sKey.swap(&id);
                 child->pDict        = dict;
                 child->bRoot        = root;
 
@@ -243,7 +299,7 @@ namespace lsp
             }
 
             if (idx > 0)
-                return dict->lookup(&subkey, value);
+                return dict->lookup(subkey.string(), value);
 
             *value = dict;
             return STATUS_OK;
@@ -278,9 +334,22 @@ namespace lsp
         status_t Dictionary::Dictionary::init(const LSPString *path)
         {
             lsp_trace("Init dictionary path: %s" , path->get_utf8());
+            drop_cache();
             return (sPath.set(path)) ? STATUS_OK : STATUS_NO_MEM;
         }
 
+        void Dictionary::drop_cache()
+        {
+            for (size_t i=0, n=vCache.size(); i<n; ++i)
+            {
+                cached_t *c = vCache.uget(i);
+                if (c != NULL)
+                    delete c;
+            }
+
+            vCache.flush();
+        }
+
         void  Dictionary::Dictionary::clear()
         {
             for (size_t i=0, n=vNodes.size(); i<n; ++i)
@@ -295,6 +364,7 @@ namespace lsp
             }
 
             vNodes.flush();
+            drop_cache();
         }
 
     } /* namespace i18n */
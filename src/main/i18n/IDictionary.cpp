@@ -68,6 +68,11 @@ namespace lsp
             return STATUS_NOT_FOUND;
         }
 
+        status_t IDictionary::lookup(const atom_t *key, LSPString *value)
+        {
+            return (key != NULL) ? lookup(&key->name, value) : STATUS_INVALID_VALUE;
+        }
+
         status_t IDictionary::lookup(const char *key, IDictionary **value)
         {
             LSPString path;
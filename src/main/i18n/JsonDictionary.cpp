@@ -21,6 +21,7 @@
 
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/i18n/JsonDictionary.h>
+#include <lsp-plug.in/runtime/LSPStringView.h>
 
 namespace lsp
 {
@@ -278,8 +279,8 @@ namespace lsp
             JsonDictionary *curr = this;
             size_t last = 0;
 
-            // Need to lookup sub-nodes?
-            LSPString id;
+            // Need to lookup sub-nodes? Path elements are referenced without copying
+            LSPStringView id;
             while (true)
             {
                 // Is there a path element?
@@ -287,12 +288,9 @@ namespace lsp
                 if (idx <= 0)
                     break;
 
-                // Get a sub-string
-                if (!id.set(key, last, idx))
-                    return STATUS_NO_MEM;
-
-                // Try to find node
-                node = curr->find_node(&id);
+                // Get a sub-string and try to find node
+                id.set(key, last, idx);
+                node = curr->find_node(id.string());
                 if ((node == NULL) || (node->pChild == NULL))
                     return STATUS_NOT_FOUND;
 
@@ -303,9 +301,8 @@ namespace lsp
             // Find last element
             if (last != 0)
             {
-                if (!id.set(key, last))
-                    return STATUS_NO_MEM;
-                node = curr->find_node(&id);
+                id.set(key, last);
+                node = curr->find_node(id.string());
             }
             else
                 node = curr->find_node(key);
@@ -339,8 +336,8 @@ namespace lsp
             JsonDictionary *curr = this;
             size_t last = 0;
 
-            // Need to lookup sub-nodes?
-            LSPString id;
+            // Need to lookup sub-nodes? Path elements are referenced without copying
+            LSPStringView id;
             while (true)
             {
                 // Is there a path element?
@@ -348,12 +345,9 @@ namespace lsp
                 if (idx <= 0)
                     break;
 
-                // Get a sub-string
-                if (!id.set(key, last, idx))
-                    return STATUS_NO_MEM;
-
-                // Try to find node
-                node = curr->find_node(&id);
+                // Get a sub-string and try to find node
+                id.set(key, last, idx);
+                node = curr->find_node(id.string());
                 if ((node == NULL) || (node->pChild == NULL))
                     return STATUS_NOT_FOUND;
 
@@ -364,9 +358,8 @@ namespace lsp
             // Find last element
             if (last != 0)
             {
-                if (!id.set(key, last))
-                    return STATUS_NO_MEM;
-                node = curr->find_node(&id);
+                id.set(key, last);
+                node = curr->find_node(id.string());
             }
             else
                 node = curr->find_node(key);
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/AlignedBufferPool.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/finally.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        AlignedBufferPool::AlignedBufferPool(size_t buf_size, size_t align)
+        {
+            // Alignment should be power of two
+            size_t a    = IO_DIRECT_DEFAULT_ALIGN;
+            while (a < align)
+                a         <<= 1;
+
+            nAlign      = a;
+            nBufSize    = lsp_max(align_size(buf_size, a), a);
+            nUsed       = 0;
+        }
+
+        AlignedBufferPool::~AlignedBufferPool()
+        {
+            for (size_t i=0, n=vBuffers.size(); i<n; ++i)
+            {
+                buffer_t *b = vBuffers.uget(i);
+                free_aligned(b->raw);
+            }
+            vBuffers.flush();
+        }
+
+        uint8_t *AlignedBufferPool::acquire()
+        {
+            if (!sMutex.lock())
+                return NULL;
+            lsp_finally { sMutex.unlock(); };
+
+            // Lookup for free buffer
+            for (size_t i=0, n=vBuffers.size(); i<n; ++i)
+            {
+                buffer_t *b = vBuffers.uget(i);
+                if (!b->used)
+                {
+                    b->used     = true;
+                    ++nUsed;
+                    return b->data;
+                }
+            }
+
+            // Allocate new buffer
+            buffer_t *b = vBuffers.add();
+            if (b == NULL)
+                return NULL;
+
+            b->raw      = NULL;
+            b->data     = alloc_aligned<uint8_t>(b->raw, nBufSize, nAlign);
+            if (b->data == NULL)
+            {
+                vBuffers.pop();
+                return NULL;
+            }
+            b->used     = true;
+            ++nUsed;
+
+            return b->data;
+        }
+
+        status_t AlignedBufferPool::release(void *buf)
+        {
+            if (buf == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (!sMutex.lock())
+                return STATUS_UNKNOWN_ERR;
+            lsp_finally { sMutex.unlock(); };
+
+            for (size_t i=0, n=vBuffers.size(); i<n; ++i)
+            {
+                buffer_t *b = vBuffers.uget(i);
+                if (b->data != buf)
+                    continue;
+                if (!b->used)
+                    return STATUS_BAD_STATE;
+
+                b->used     = false;
+                --nUsed;
+                return STATUS_OK;
+            }
+
+            return STATUS_NOT_FOUND;
+        }
+
+        void AlignedBufferPool::trim()
+        {
+            if (!sMutex.lock())
+                return;
+            lsp_finally { sMutex.unlock(); };
+
+            for (size_t i=vBuffers.size(); (i--) > 0; )
+            {
+                buffer_t *b = vBuffers.uget(i);
+                if (b->used)
+                    continue;
+                free_aligned(b->raw);
+                vBuffers.remove(i);
+            }
+        }
+
+        size_t AlignedBufferPool::allocated()
+        {
+            if (!sMutex.lock())
+                return 0;
+            lsp_finally { sMutex.unlock(); };
+            return vBuffers.size();
+        }
+
+        size_t AlignedBufferPool::used()
+        {
+            if (!sMutex.lock())
+                return 0;
+            lsp_finally { sMutex.unlock(); };
+            return nUsed;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -46,6 +46,7 @@ namespace lsp
 #else
             hIconv          = iconv_t(-1);
 #endif /* PLATFORM_WINDOWS */
+            enCharset       = BUILTIN_CHARSET_NONE;
         }
         
         CharsetDecoder::~CharsetDecoder()
@@ -55,23 +56,31 @@ namespace lsp
     
         status_t CharsetDecoder::init(const char *charset)
         {
-#if defined(PLATFORM_WINDOWS)
-            if (nCodePage != uint32_t(-1))
+            if (bBuffer != NULL)
                 return STATUS_BAD_STATE;
 
-            ssize_t cp  = codepage_from_name(charset);
-            if (cp < 0)
-                return STATUS_BAD_LOCALE;
-            nCodePage       = cp;
+            // Check that character set can be decoded without system routines
+            enCharset       = builtin_charset_from_name(charset);
+            if (enCharset == BUILTIN_CHARSET_NONE)
+            {
+#if defined(PLATFORM_WINDOWS)
+                if (nCodePage != uint32_t(-1))
+                    return STATUS_BAD_STATE;
+
+                ssize_t cp  = codepage_from_name(charset);
+                if (cp < 0)
+                    return STATUS_BAD_LOCALE;
+                nCodePage       = cp;
 #else
-            if (hIconv != iconv_t(-1))
-                return STATUS_BAD_STATE;
+                if (hIconv != iconv_t(-1))
+                    return STATUS_BAD_STATE;
 
-            iconv_t handle = init_iconv_to_wchar_t(charset);
-            if (handle == iconv_t(-1))
-                return STATUS_BAD_LOCALE;
-            hIconv      = handle;
+                iconv_t handle = init_iconv_to_wchar_t(charset);
+                if (handle == iconv_t(-1))
+                    return STATUS_BAD_LOCALE;
+                hIconv      = handle;
 #endif /* PLATFORM_WINDOWS */
+            }
 
             // Allocate buffer
             uint8_t *buf= reinterpret_cast<uint8_t *>(::malloc(
@@ -127,6 +136,8 @@ namespace lsp
                 hIconv      = iconv_t(-1);
             }
 #endif /* PLATFORM_WINDOWS */
+
+            enCharset   = BUILTIN_CHARSET_NONE;
         }
 #if 0
         ssize_t CharsetDecoder::decode(lsp_wchar_t **outbuf, size_t *outleft, void **inbuf, size_t *inleft)
@@ -236,6 +247,118 @@ namespace lsp
             return DATA_BUFSIZE - bufsz;
         }
 
+        /**
+         * Decode single non-ASCII UTF-8 character
+         * @param dst pointer to store the decoded character
+         * @param src pointer to the first byte of the sequence
+         * @param avail number of bytes available in the source buffer
+         * @return number of bytes in the sequence, zero if the sequence is incomplete
+         *   or negative value if the sequence is invalid
+         */
+        static ssize_t decode_utf8_char(lsp_wchar_t *dst, const uint8_t *src, size_t avail)
+        {
+            lsp_wchar_t cp      = src[0];
+            lsp_wchar_t min;
+            size_t bytes;
+
+            if ((cp & 0xe0) == 0xc0)        // 2 bytes: 110xxxxx 10xxxxxx
+            {
+                cp         &= 0x1f;
+                min         = 0x80;
+                bytes       = 2;
+            }
+            else if ((cp & 0xf0) == 0xe0)   // 3 bytes: 1110xxxx 10xxxxxx 10xxxxxx
+            {
+                cp         &= 0x0f;
+                min         = 0x800;
+                bytes       = 3;
+            }
+            else if ((cp & 0xf8) == 0xf0)   // 4 bytes: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+            {
+                cp         &= 0x07;
+                min         = 0x10000;
+                bytes       = 4;
+            }
+            else
+                return -1;
+
+            // Decode extension bytes
+            for (size_t i=1; i<bytes; ++i)
+            {
+                if (i >= avail)
+                    return 0;
+                const lsp_wchar_t sp = src[i];
+                if ((sp & 0xc0) != 0x80)
+                    return -1;
+                cp          = (cp << 6) | (sp & 0x3f);
+            }
+
+            // Reject overlong sequences, surrogates and out-of-range code points
+            if ((cp < min) || (cp > 0x10ffff) || ((cp >= 0xd800) && (cp < 0xe000)))
+                return -1;
+
+            *dst        = cp;
+            return bytes;
+        }
+
+        ssize_t CharsetDecoder::decode_builtin()
+        {
+            const uint8_t *src  = bBufHead;
+            lsp_wchar_t *dst    = cBufTail;
+            lsp_wchar_t *dend   = &cBufTail[DATA_BUFSIZE];
+
+            while ((dst < dend) && (src < bBufTail))
+            {
+                const size_t avail  = lsp_min(size_t(dend - dst), size_t(bBufTail - src));
+
+                if (enCharset == BUILTIN_CHARSET_UTF8)
+                {
+                    // Decode the longest valid part of UTF-8 sequence, each valid character
+                    // takes at least one byte so it always fits into the character buffer
+                    const char *s       = reinterpret_cast<const char *>(src);
+                    size_t nsrc         = utf8_validate(s, avail);
+                    if (nsrc > 0)
+                    {
+                        const size_t count  = nsrc;
+                        size_t ndst         = dend - dst;
+                        dst                += utf8_to_utf32(reinterpret_cast<lsp_utf32_t *>(dst), &ndst, s, &nsrc, false);
+                        src                += count - nsrc;
+                        continue;
+                    }
+
+                    // Check the character that did not pass validation
+                    const ssize_t bytes = decode_utf8_char(dst, src, bBufTail - src);
+                    if (bytes > 0)
+                    {
+                        ++dst;
+                        src                += bytes;
+                        continue;
+                    }
+                    else if (bytes == 0) // Incomplete sequence, need more data
+                        break;
+                }
+                else
+                {
+                    // Convert the run of ASCII characters
+                    const size_t count  = ascii_to_utf32(dst, reinterpret_cast<const char *>(src), avail);
+                    dst                += count;
+                    src                += count;
+                    if ((dst >= dend) || (src >= bBufTail))
+                        break;
+                }
+
+                // Invalid character, report error only if there were no data decoded
+                if (src == bBufHead)
+                    return -STATUS_BAD_FORMAT;
+                break;
+            }
+
+            bBufHead            = const_cast<uint8_t *>(src);
+            cBufTail            = dst;
+
+            return cBufTail - cBufHead;
+        }
+
         ssize_t CharsetDecoder::decode_buffer()
         {
             // Prepare buffer
@@ -256,6 +379,10 @@ namespace lsp
             if (xinleft <= 0)
                 return bufsz;
 
+            // Decode built-in character set
+            if (enCharset != BUILTIN_CHARSET_NONE)
+                return decode_builtin();
+
             // Now we can surely decode DATA_BUFSIZE characters
 #ifdef PLATFORM_WINDOWS
             // Round 1: Perform native -> UTF-16 decoding
@@ -323,6 +450,36 @@ namespace lsp
             return (nchars < 0) ? lsp_swchar_t(nchars) : -STATUS_EOF;
         }
 
+        ssize_t CharsetDecoder::peek(const lsp_wchar_t **ptr)
+        {
+            if (bBuffer == NULL)
+                return -STATUS_CLOSED;
+            else if (ptr == NULL)
+                return -STATUS_BAD_ARGUMENTS;
+
+            // Decode more data if the character buffer is empty
+            ssize_t nchars  = cBufTail - cBufHead;
+            if (nchars <= 0)
+            {
+                nchars          = decode_buffer();
+                if (nchars <= 0)
+                    return nchars;
+            }
+
+            *ptr            = cBufHead;
+            return nchars;
+        }
+
+        size_t CharsetDecoder::skip(size_t count)
+        {
+            size_t avail    = cBufTail - cBufHead;
+            if (count > avail)
+                count           = avail;
+            cBufHead       += count;
+
+            return count;
+        }
+
         ssize_t CharsetDecoder::fetch(lsp_wchar_t *outbuf, size_t count)
         {
             if (bBuffer == NULL)
@@ -456,7 +613,7 @@ namespace lsp
 
             if (count > bufsz)
                 count   = bufsz;
-            ::memcpy(&bBufTail, buf, count);
+            ::memcpy(bBufTail, buf, count);
             bBufTail       += count;
             return count;
         }
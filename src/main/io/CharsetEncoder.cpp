@@ -45,6 +45,7 @@ namespace lsp
 #else
             hIconv          = iconv_t(-1);
 #endif /* PLATFORM_WINDOWS */
+            enCharset       = BUILTIN_CHARSET_NONE;
         }
         
         CharsetEncoder::~CharsetEncoder()
@@ -54,23 +55,31 @@ namespace lsp
 
         status_t CharsetEncoder::init(const char *charset)
         {
-#if defined(PLATFORM_WINDOWS)
-            if (nCodePage != uint32_t(-1))
+            if (bBuffer != NULL)
                 return STATUS_BAD_STATE;
 
-            ssize_t cp  = codepage_from_name(charset);
-            if (cp < 0)
-                return STATUS_BAD_LOCALE;
-            nCodePage       = cp;
+            // Check that character set can be encoded without system routines
+            enCharset       = builtin_charset_from_name(charset);
+            if (enCharset == BUILTIN_CHARSET_NONE)
+            {
+#if defined(PLATFORM_WINDOWS)
+                if (nCodePage != uint32_t(-1))
+                    return STATUS_BAD_STATE;
+
+                ssize_t cp  = codepage_from_name(charset);
+                if (cp < 0)
+                    return STATUS_BAD_LOCALE;
+                nCodePage       = cp;
 #else
-            if (hIconv != iconv_t(-1))
-                return STATUS_BAD_STATE;
+                if (hIconv != iconv_t(-1))
+                    return STATUS_BAD_STATE;
 
-            iconv_t handle = init_iconv_from_wchar_t(charset);
-            if (handle == iconv_t(-1))
-                return STATUS_BAD_LOCALE;
-            hIconv      = handle;
+                iconv_t handle = init_iconv_from_wchar_t(charset);
+                if (handle == iconv_t(-1))
+                    return STATUS_BAD_LOCALE;
+                hIconv      = handle;
 #endif /* PLATFORM_WINDOWS */
+            }
 
             // Allocate buffer
             uint8_t *buf= reinterpret_cast<uint8_t *>(::malloc(
@@ -127,6 +136,8 @@ namespace lsp
                 hIconv      = iconv_t(-1);
             }
 #endif /* PLATFORM_WINDOWS */
+
+            enCharset   = BUILTIN_CHARSET_NONE;
         }
 
 #if 0
@@ -224,6 +235,50 @@ namespace lsp
             return DATA_BUFSIZE - bufsz;
         }
 
+        ssize_t CharsetEncoder::encode_builtin()
+        {
+            const lsp_wchar_t *src  = cBufHead;
+            char *dst               = reinterpret_cast<char *>(bBufTail);
+            char *dend              = &dst[DATA_BUFSIZE * sizeof(lsp_utf32_t)];
+
+            while ((dst < dend) && (src < cBufTail))
+            {
+                // Convert the run of ASCII characters
+                const size_t count  = utf32_to_ascii(
+                    dst, src,
+                    lsp_min(size_t(dend - dst), size_t(cBufTail - src)));
+                dst                += count;
+                src                += count;
+                if ((dst >= dend) || (src >= cBufTail))
+                    break;
+
+                // Encode non-ASCII character
+                const lsp_wchar_t cp = *src;
+                if ((enCharset == BUILTIN_CHARSET_UTF8) &&
+                    (cp <= 0x10ffff) &&
+                    ((cp < 0xd800) || (cp >= 0xe000)))
+                {
+                    const size_t bytes  = (cp < 0x800) ? 2 : (cp < 0x10000) ? 3 : 4;
+                    if (size_t(dend - dst) < bytes)
+                        break;
+
+                    write_utf8_codepoint(&dst, cp);
+                    ++src;
+                    continue;
+                }
+
+                // Invalid character, report error only if there were no data encoded
+                if (src == cBufHead)
+                    return -STATUS_BAD_FORMAT;
+                break;
+            }
+
+            cBufHead            = const_cast<lsp_wchar_t *>(src);
+            bBufTail            = reinterpret_cast<uint8_t *>(dst);
+
+            return bBufTail - bBufHead;
+        }
+
         ssize_t CharsetEncoder::encode_buffer()
         {
             // Prepare buffer
@@ -244,6 +299,10 @@ namespace lsp
             if (!xinleft)
                 return bufsz;
 
+            // Encode built-in character set
+            if (enCharset != BUILTIN_CHARSET_NONE)
+                return encode_builtin();
+
 #ifdef PLATFORM_WINDOWS
             // Round 1: encode UTF-32 -> UTF-16
             size_t nsrc     = xinleft;
@@ -0,0 +1,620 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/io/Checksum.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#if defined(ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+    // SSE4.2 routines are compiled with function-specific target options and selected at runtime
+    #define LSP_CHECKSUM_SSE42
+    #define LSP_CHECKSUM_TARGET_SSE42       __attribute__((target("sse4.2")))
+    #include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+    #define LSP_CHECKSUM_ARMV8
+    #include <arm_acle.h>
+#endif
+
+#define CRC32_POLY          0xedb88320      /* Reversed polynomial 0x04c11db7 */
+#define CRC32C_POLY         0x82f63b78      /* Reversed polynomial 0x1edc6f41 */
+
+#define XXH64_PRIME1        0x9e3779b185ebca87ULL
+#define XXH64_PRIME2        0xc2b2ae3d27d4eb4fULL
+#define XXH64_PRIME3        0x165667b19e3779f9ULL
+#define XXH64_PRIME4        0x85ebca77c2b2ae63ULL
+#define XXH64_PRIME5        0x27d4eb2f165667c5ULL
+
+namespace lsp
+{
+    namespace io
+    {
+        //---------------------------------------------------------------------
+        // Generic slicing-by-8 CRC implementation
+        typedef struct crc_table_t
+        {
+            uint32_t    v[8][256];
+
+            explicit crc_table_t(uint32_t poly)
+            {
+                for (size_t i=0; i<256; ++i)
+                {
+                    uint32_t c  = uint32_t(i);
+                    for (size_t j=0; j<8; ++j)
+                        c           = (c & 1) ? (c >> 1) ^ poly : (c >> 1);
+                    v[0][i]     = c;
+                }
+
+                for (size_t i=0; i<256; ++i)
+                    for (size_t k=1; k<8; ++k)
+                        v[k][i]     = (v[k-1][i] >> 8) ^ v[0][v[k-1][i] & 0xff];
+            }
+        } crc_table_t;
+
+        static const crc_table_t *crc32_table()
+        {
+            static const crc_table_t table(CRC32_POLY);
+            return &table;
+        }
+
+        static const crc_table_t *crc32c_table()
+        {
+            static const crc_table_t table(CRC32C_POLY);
+            return &table;
+        }
+
+        static inline uint32_t load32le(const uint8_t *p)
+        {
+            uint32_t v;
+            memcpy(&v, p, sizeof(v));
+            return LE_TO_CPU(v);
+        }
+
+        static inline uint64_t load64le(const uint8_t *p)
+        {
+            uint64_t v;
+            memcpy(&v, p, sizeof(v));
+            return LE_TO_CPU(v);
+        }
+
+        static uint32_t crc_update_generic(const crc_table_t *t, uint32_t crc, const void *buf, size_t count)
+        {
+            const uint8_t *p    = static_cast<const uint8_t *>(buf);
+
+            crc     = ~crc;
+            for ( ; count >= 8; count -= 8, p += 8)
+            {
+                const uint32_t lo   = load32le(p) ^ crc;
+                const uint32_t hi   = load32le(&p[4]);
+                crc =
+                    t->v[7][lo & 0xff] ^ t->v[6][(lo >> 8) & 0xff] ^
+                    t->v[5][(lo >> 16) & 0xff] ^ t->v[4][lo >> 24] ^
+                    t->v[3][hi & 0xff] ^ t->v[2][(hi >> 8) & 0xff] ^
+                    t->v[1][(hi >> 16) & 0xff] ^ t->v[0][hi >> 24];
+            }
+            for ( ; count > 0; --count, ++p)
+                crc     = t->v[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+
+            return ~crc;
+        }
+
+        static uint32_t crc32_generic(uint32_t crc, const void *buf, size_t count)
+        {
+            return crc_update_generic(crc32_table(), crc, buf, count);
+        }
+
+        static uint32_t crc32c_generic(uint32_t crc, const void *buf, size_t count)
+        {
+            return crc_update_generic(crc32c_table(), crc, buf, count);
+        }
+
+        //---------------------------------------------------------------------
+        // Hardware CRC instructions have latency of several cycles but allow to issue
+        // one instruction per cycle. The data is split into three interleaved lanes,
+        // CRC of the lanes are combined by shifting them with table-driven multiplication
+        // by x^(8*n) modulo polynomial.
+    #if defined(LSP_CHECKSUM_SSE42) || defined(LSP_CHECKSUM_ARMV8)
+        #define CRC_LANE_SIZE       512
+
+        static uint32_t crc_multmodp(uint32_t a, uint32_t b, uint32_t poly)
+        {
+            uint32_t m = uint32_t(1) << 31, p = 0;
+            while (true)
+            {
+                if (a & m)
+                {
+                    p      ^= b;
+                    if ((a & (m - 1)) == 0)
+                        break;
+                }
+                m     >>= 1;
+                b       = (b & 1) ? (b >> 1) ^ poly : (b >> 1);
+            }
+            return p;
+        }
+
+        static uint32_t crc_x8nmodp(size_t n, uint32_t poly)
+        {
+            // Compute x^(8*n) by squaring
+            uint32_t p  = uint32_t(1) << 31;    // x^0
+            uint32_t x  = uint32_t(1) << 23;    // x^8
+            for ( ; n > 0; n >>= 1)
+            {
+                if (n & 1)
+                    p       = crc_multmodp(x, p, poly);
+                x       = crc_multmodp(x, x, poly);
+            }
+            return p;
+        }
+
+        typedef struct crc_shift_t
+        {
+            uint32_t    v[2][4][256];       // Shift by one and two lanes
+
+            explicit crc_shift_t(uint32_t poly)
+            {
+                for (size_t k=0; k<2; ++k)
+                {
+                    const uint32_t op = crc_x8nmodp(CRC_LANE_SIZE * (k + 1), poly);
+                    for (size_t j=0; j<4; ++j)
+                        for (size_t i=0; i<256; ++i)
+                            v[k][j][i]  = crc_multmodp(op, uint32_t(i) << (j * 8), poly);
+                }
+            }
+        } crc_shift_t;
+
+        static inline uint32_t crc_shift(const uint32_t (*t)[256], uint32_t crc)
+        {
+            return t[0][crc & 0xff] ^ t[1][(crc >> 8) & 0xff] ^ t[2][(crc >> 16) & 0xff] ^ t[3][crc >> 24];
+        }
+
+        static const crc_shift_t *crc32c_shift()
+        {
+            static const crc_shift_t shift(CRC32C_POLY);
+            return &shift;
+        }
+    #endif /* LSP_CHECKSUM_SSE42 || LSP_CHECKSUM_ARMV8 */
+
+    #if defined(LSP_CHECKSUM_ARMV8)
+        static const crc_shift_t *crc32_shift()
+        {
+            static const crc_shift_t shift(CRC32_POLY);
+            return &shift;
+        }
+    #endif /* LSP_CHECKSUM_ARMV8 */
+
+        //---------------------------------------------------------------------
+        // x86 SSE4.2 implementation
+    #if defined(LSP_CHECKSUM_SSE42)
+        LSP_CHECKSUM_TARGET_SSE42
+        static uint32_t crc32c_sse42(uint32_t crc, const void *buf, size_t count)
+        {
+            const uint8_t *p    = static_cast<const uint8_t *>(buf);
+
+            crc     = ~crc;
+        #if defined(ARCH_X86_64)
+            if (count >= CRC_LANE_SIZE * 3)
+            {
+                const crc_shift_t *s    = crc32c_shift();
+                for ( ; count >= CRC_LANE_SIZE * 3; count -= CRC_LANE_SIZE * 3, p += CRC_LANE_SIZE * 3)
+                {
+                    uint64_t c0 = crc, c1 = 0, c2 = 0;
+                    for (size_t i=0; i<CRC_LANE_SIZE; i += 8)
+                    {
+                        c0      = _mm_crc32_u64(c0, load64le(&p[i]));
+                        c1      = _mm_crc32_u64(c1, load64le(&p[i + CRC_LANE_SIZE]));
+                        c2      = _mm_crc32_u64(c2, load64le(&p[i + CRC_LANE_SIZE * 2]));
+                    }
+                    crc     = crc_shift(s->v[1], uint32_t(c0)) ^ crc_shift(s->v[0], uint32_t(c1)) ^ uint32_t(c2);
+                }
+            }
+
+            uint64_t c64        = crc;
+            for ( ; count >= 8; count -= 8, p += 8)
+                c64     = _mm_crc32_u64(c64, load64le(p));
+            crc     = uint32_t(c64);
+        #endif /* ARCH_X86_64 */
+            for ( ; count >= 4; count -= 4, p += 4)
+                crc     = _mm_crc32_u32(crc, load32le(p));
+            for ( ; count > 0; --count, ++p)
+                crc     = _mm_crc32_u8(crc, *p);
+
+            return ~crc;
+        }
+    #endif /* LSP_CHECKSUM_SSE42 */
+
+        //---------------------------------------------------------------------
+        // AArch64 CRC32 implementation
+    #if defined(LSP_CHECKSUM_ARMV8)
+        static uint32_t crc32_armv8(uint32_t crc, const void *buf, size_t count)
+        {
+            const uint8_t *p    = static_cast<const uint8_t *>(buf);
+
+            crc     = ~crc;
+            if (count >= CRC_LANE_SIZE * 3)
+            {
+                const crc_shift_t *s    = crc32_shift();
+                for ( ; count >= CRC_LANE_SIZE * 3; count -= CRC_LANE_SIZE * 3, p += CRC_LANE_SIZE * 3)
+                {
+                    uint32_t c0 = crc, c1 = 0, c2 = 0;
+                    for (size_t i=0; i<CRC_LANE_SIZE; i += 8)
+                    {
+                        c0      = __crc32d(c0, load64le(&p[i]));
+                        c1      = __crc32d(c1, load64le(&p[i + CRC_LANE_SIZE]));
+                        c2      = __crc32d(c2, load64le(&p[i + CRC_LANE_SIZE * 2]));
+                    }
+                    crc     = crc_shift(s->v[1], c0) ^ crc_shift(s->v[0], c1) ^ c2;
+                }
+            }
+            for ( ; count >= 8; count -= 8, p += 8)
+                crc     = __crc32d(crc, load64le(p));
+            for ( ; count > 0; --count, ++p)
+                crc     = __crc32b(crc, *p);
+
+            return ~crc;
+        }
+
+        static uint32_t crc32c_armv8(uint32_t crc, const void *buf, size_t count)
+        {
+            const uint8_t *p    = static_cast<const uint8_t *>(buf);
+
+            crc     = ~crc;
+            if (count >= CRC_LANE_SIZE * 3)
+            {
+                const crc_shift_t *s    = crc32c_shift();
+                for ( ; count >= CRC_LANE_SIZE * 3; count -= CRC_LANE_SIZE * 3, p += CRC_LANE_SIZE * 3)
+                {
+                    uint32_t c0 = crc, c1 = 0, c2 = 0;
+                    for (size_t i=0; i<CRC_LANE_SIZE; i += 8)
+                    {
+                        c0      = __crc32cd(c0, load64le(&p[i]));
+                        c1      = __crc32cd(c1, load64le(&p[i + CRC_LANE_SIZE]));
+                        c2      = __crc32cd(c2, load64le(&p[i + CRC_LANE_SIZE * 2]));
+                    }
+                    crc     = crc_shift(s->v[1], c0) ^ crc_shift(s->v[0], c1) ^ c2;
+                }
+            }
+            for ( ; count >= 8; count -= 8, p += 8)
+                crc     = __crc32cd(crc, load64le(p));
+            for ( ; count > 0; --count, ++p)
+                crc     = __crc32cb(crc, *p);
+
+            return ~crc;
+        }
+    #endif /* LSP_CHECKSUM_ARMV8 */
+
+        //---------------------------------------------------------------------
+        // Runtime dispatching
+        typedef struct checksum_kernels_t
+        {
+            checksum_kernel_t   id;
+            uint32_t          (*crc32)(uint32_t crc, const void *buf, size_t count);
+            uint32_t          (*crc32c)(uint32_t crc, const void *buf, size_t count);
+        } checksum_kernels_t;
+
+        static const checksum_kernels_t checksum_generic_kernels =
+        {
+            CHECKSUM_KERNEL_GENERIC,
+            crc32_generic,
+            crc32c_generic
+        };
+
+    #if defined(LSP_CHECKSUM_SSE42)
+        static const checksum_kernels_t checksum_sse42_kernels =
+        {
+            CHECKSUM_KERNEL_SSE42,
+            crc32_generic,              // No dedicated instruction for CRC-32 polynomial
+            crc32c_sse42
+        };
+    #endif /* LSP_CHECKSUM_SSE42 */
+
+    #if defined(LSP_CHECKSUM_ARMV8)
+        static const checksum_kernels_t checksum_armv8_kernels =
+        {
+            CHECKSUM_KERNEL_ARMV8,
+            crc32_armv8,
+            crc32c_armv8
+        };
+    #endif /* LSP_CHECKSUM_ARMV8 */
+
+        static const checksum_kernels_t *checksum_find_kernels(checksum_kernel_t kernel)
+        {
+            switch (kernel)
+            {
+                case CHECKSUM_KERNEL_AUTO:
+    #if defined(LSP_CHECKSUM_SSE42)
+                    __builtin_cpu_init();
+                    if (__builtin_cpu_supports("sse4.2"))
+                        return &checksum_sse42_kernels;
+    #elif defined(LSP_CHECKSUM_ARMV8)
+                    return &checksum_armv8_kernels;
+    #endif
+                    return &checksum_generic_kernels;
+
+                case CHECKSUM_KERNEL_GENERIC:
+                    return &checksum_generic_kernels;
+
+    #if defined(LSP_CHECKSUM_SSE42)
+                case CHECKSUM_KERNEL_SSE42:
+                    __builtin_cpu_init();
+                    return (__builtin_cpu_supports("sse4.2")) ? &checksum_sse42_kernels : NULL;
+    #endif /* LSP_CHECKSUM_SSE42 */
+
+    #if defined(LSP_CHECKSUM_ARMV8)
+                case CHECKSUM_KERNEL_ARMV8:
+                    return &checksum_armv8_kernels;
+    #endif /* LSP_CHECKSUM_ARMV8 */
+
+                default:
+                    break;
+            }
+
+            return NULL;
+        }
+
+        // The pointer is initialized during the static initialization of the library,
+        // the lazy initialization covers calls from constructors of other static objects
+        static const checksum_kernels_t *checksum_active_kernels = checksum_find_kernels(CHECKSUM_KERNEL_AUTO);
+
+        static inline const checksum_kernels_t *checksum_kernels()
+        {
+            if (checksum_active_kernels == NULL)
+                checksum_active_kernels = checksum_find_kernels(CHECKSUM_KERNEL_AUTO);
+            return checksum_active_kernels;
+        }
+
+        status_t select_checksum_kernel(checksum_kernel_t kernel)
+        {
+            const checksum_kernels_t *k = checksum_find_kernels(kernel);
+            if (k == NULL)
+                return STATUS_NOT_SUPPORTED;
+
+            checksum_active_kernels = k;
+            return STATUS_OK;
+        }
+
+        checksum_kernel_t checksum_kernel()
+        {
+            return checksum_kernels()->id;
+        }
+
+        uint32_t crc32(uint32_t crc, const void *buf, size_t count)
+        {
+            return checksum_kernels()->crc32(crc, buf, count);
+        }
+
+        uint32_t crc32c(uint32_t crc, const void *buf, size_t count)
+        {
+            return checksum_kernels()->crc32c(crc, buf, count);
+        }
+
+        //---------------------------------------------------------------------
+        // xxHash64
+        static inline uint64_t xxh64_rotl(uint64_t x, int r)
+        {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        static inline uint64_t xxh64_round(uint64_t acc, uint64_t input)
+        {
+            acc    += input * XXH64_PRIME2;
+            acc     = xxh64_rotl(acc, 31);
+            return acc * XXH64_PRIME1;
+        }
+
+        static inline uint64_t xxh64_merge_round(uint64_t acc, uint64_t val)
+        {
+            acc    ^= xxh64_round(0, val);
+            return acc * XXH64_PRIME1 + XXH64_PRIME4;
+        }
+
+        static inline const uint8_t *xxh64_stripes(uint64_t *v, const uint8_t *p, size_t count)
+        {
+            uint64_t v1 = v[0], v2 = v[1], v3 = v[2], v4 = v[3];
+
+            for ( ; count >= 32; count -= 32, p += 32)
+            {
+                v1      = xxh64_round(v1, load64le(p));
+                v2      = xxh64_round(v2, load64le(&p[8]));
+                v3      = xxh64_round(v3, load64le(&p[16]));
+                v4      = xxh64_round(v4, load64le(&p[24]));
+            }
+
+            v[0] = v1; v[1] = v2; v[2] = v3; v[3] = v4;
+            return p;
+        }
+
+        static uint64_t xxh64_finalize(const uint64_t *v, uint64_t seed, uint64_t total, const uint8_t *p, size_t count)
+        {
+            uint64_t h;
+
+            if (total >= 32)
+            {
+                h       = xxh64_rotl(v[0], 1) + xxh64_rotl(v[1], 7) + xxh64_rotl(v[2], 12) + xxh64_rotl(v[3], 18);
+                h       = xxh64_merge_round(h, v[0]);
+                h       = xxh64_merge_round(h, v[1]);
+                h       = xxh64_merge_round(h, v[2]);
+                h       = xxh64_merge_round(h, v[3]);
+            }
+            else
+                h       = seed + XXH64_PRIME5;
+
+            h      += total;
+
+            for ( ; count >= 8; count -= 8, p += 8)
+            {
+                h      ^= xxh64_round(0, load64le(p));
+                h       = xxh64_rotl(h, 27) * XXH64_PRIME1 + XXH64_PRIME4;
+            }
+            if (count >= 4)
+            {
+                h      ^= uint64_t(load32le(p)) * XXH64_PRIME1;
+                h       = xxh64_rotl(h, 23) * XXH64_PRIME2 + XXH64_PRIME3;
+                count  -= 4;
+                p      += 4;
+            }
+            for ( ; count > 0; --count, ++p)
+            {
+                h      ^= uint64_t(*p) * XXH64_PRIME5;
+                h       = xxh64_rotl(h, 11) * XXH64_PRIME1;
+            }
+
+            // Avalanche
+            h      ^= h >> 33;
+            h      *= XXH64_PRIME2;
+            h      ^= h >> 29;
+            h      *= XXH64_PRIME3;
+            h      ^= h >> 32;
+
+            return h;
+        }
+
+        void xxh64_init(xxh64_t *state, uint64_t seed)
+        {
+            state->v[0]     = seed + XXH64_PRIME1 + XXH64_PRIME2;
+            state->v[1]     = seed + XXH64_PRIME2;
+            state->v[2]     = seed;
+            state->v[3]     = seed - XXH64_PRIME1;
+            state->total    = 0;
+            state->seed     = seed;
+            state->pending  = 0;
+        }
+
+        void xxh64_update(xxh64_t *state, const void *buf, size_t count)
+        {
+            const uint8_t *p    = static_cast<const uint8_t *>(buf);
+            state->total       += count;
+
+            // Complete the pending stripe
+            if (state->pending > 0)
+            {
+                const size_t n      = lsp_min(count, size_t(32 - state->pending));
+                memcpy(&state->tail[state->pending], p, n);
+                state->pending     += n;
+                p                  += n;
+                count              -= n;
+                if (state->pending < 32)
+                    return;
+
+                xxh64_stripes(state->v, state->tail, 32);
+                state->pending      = 0;
+            }
+
+            // Process full stripes and keep the tail
+            const uint8_t *end  = xxh64_stripes(state->v, p, count);
+            count              -= end - p;
+            if (count > 0)
+            {
+                memcpy(state->tail, end, count);
+                state->pending      = uint32_t(count);
+            }
+        }
+
+        uint64_t xxh64_digest(const xxh64_t *state)
+        {
+            return xxh64_finalize(state->v, state->seed, state->total, state->tail, state->pending);
+        }
+
+        uint64_t xxh64(const void *buf, size_t count, uint64_t seed)
+        {
+            uint64_t v[4];
+            v[0]    = seed + XXH64_PRIME1 + XXH64_PRIME2;
+            v[1]    = seed + XXH64_PRIME2;
+            v[2]    = seed;
+            v[3]    = seed - XXH64_PRIME1;
+
+            const uint8_t *p    = static_cast<const uint8_t *>(buf);
+            const uint8_t *end  = xxh64_stripes(v, p, count);
+
+            return xxh64_finalize(v, seed, count, end, count - (end - p));
+        }
+
+        //---------------------------------------------------------------------
+        // Checksum accumulator
+        Checksum::Checksum(checksum_t type, uint64_t seed)
+        {
+            enType      = type;
+            nCrc        = 0;
+            nProcessed  = 0;
+            xxh64_init(&sXXH, seed);
+        }
+
+        Checksum::~Checksum()
+        {
+        }
+
+        status_t Checksum::init(checksum_t type, uint64_t seed)
+        {
+            switch (type)
+            {
+                case CHECKSUM_CRC32:
+                case CHECKSUM_CRC32C:
+                case CHECKSUM_XXH64:
+                    break;
+                default:
+                    return STATUS_BAD_ARGUMENTS;
+            }
+
+            enType      = type;
+            nCrc        = 0;
+            nProcessed  = 0;
+            xxh64_init(&sXXH, seed);
+
+            return STATUS_OK;
+        }
+
+        void Checksum::reset()
+        {
+            nCrc        = 0;
+            nProcessed  = 0;
+            xxh64_init(&sXXH, sXXH.seed);
+        }
+
+        void Checksum::update(const void *buf, size_t count)
+        {
+            switch (enType)
+            {
+                case CHECKSUM_CRC32:
+                    nCrc        = checksum_kernels()->crc32(nCrc, buf, count);
+                    break;
+                case CHECKSUM_CRC32C:
+                    nCrc        = checksum_kernels()->crc32c(nCrc, buf, count);
+                    break;
+                case CHECKSUM_XXH64:
+                    xxh64_update(&sXXH, buf, count);
+                    break;
+                default:
+                    break;
+            }
+            nProcessed += count;
+        }
+
+        uint64_t Checksum::value() const
+        {
+            return (enType == CHECKSUM_XXH64) ? xxh64_digest(&sXXH) : nCrc;
+        }
+
+        size_t Checksum::size() const
+        {
+            return (enType == CHECKSUM_XXH64) ? sizeof(uint64_t) : sizeof(uint32_t);
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -140,7 +140,8 @@ namespace lsp
             dir->hHandle    = dh;
             lsp::swap(hDir, dir);
         #else
-            DIR *dh = ::opendir(path->get_native());
+            char xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            DIR *dh = ::opendir(path->to_native(xbuf, sizeof(xbuf)));
             if (dh == NULL)
             {
                 sPath.clear();
@@ -399,7 +400,8 @@ namespace lsp
                 return set_error(STATUS_NO_MEM);
             if (!xpath.append(&xname))
                 return set_error(STATUS_NO_MEM);
-            int code = ::lstat(xpath.get_native(), &sb);
+            char xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            int code = ::lstat(xpath.to_native(xbuf, sizeof(xbuf)), &sb);
         #endif
             if (code != 0)
             {
@@ -652,7 +654,8 @@ namespace lsp
                 return STATUS_BAD_ARGUMENTS;
 
         #ifdef PLATFORM_WINDOWS
-            const WCHAR *xp = path->get_utf16();
+            lsp_utf16_t xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            const WCHAR *xp = path->to_utf16(xbuf, IO_PATH_NATIVE_BUF_SIZE);
             if (::CreateDirectoryW(xp, NULL))
                 return STATUS_OK;
 
@@ -669,7 +672,8 @@ namespace lsp
             }
         #else
             // Try to create directory
-            if (::mkdir(path->get_native(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) == 0)
+            char xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            if (::mkdir(path->to_native(xbuf, sizeof(xbuf)), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) == 0)
                 return STATUS_OK;
 
             // Analyze error code
@@ -729,7 +733,8 @@ namespace lsp
                 return STATUS_BAD_ARGUMENTS;
 
         #ifdef PLATFORM_WINDOWS
-            if (::RemoveDirectoryW(path->get_utf16()))
+            lsp_utf16_t xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            if (::RemoveDirectoryW(path->to_utf16(xbuf, IO_PATH_NATIVE_BUF_SIZE)))
                 return STATUS_OK;
 
             // Analyze error code
@@ -747,7 +752,8 @@ namespace lsp
             }
         #else
             // Try to remove directory
-            if (::rmdir(path->get_native()) == 0)
+            char xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            if (::rmdir(path->to_native(xbuf, sizeof(xbuf))) == 0)
                 return STATUS_OK;
 
             // Analyze error code
@@ -777,6 +783,67 @@ namespace lsp
             return STATUS_OK;
         }
 
+        status_t Dir::sync(const char *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return STATUS_NO_MEM;
+            return sync(&tmp);
+        }
+
+        status_t Dir::sync(const Path *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            return sync(path->as_string());
+        }
+
+        status_t Dir::sync(const LSPString *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+        #ifdef PLATFORM_WINDOWS
+            // Windows does not allow to open directory for flushing, directory entries
+            // are committed by MoveFileEx() with MOVEFILE_WRITE_THROUGH flag
+            return STATUS_OK;
+        #else
+            char xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            int fd = ::open(path->to_native(xbuf, sizeof(xbuf)), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                switch (errno)
+                {
+                    case EACCES:
+                    case EPERM:
+                        return STATUS_PERMISSION_DENIED;
+                    case ENOENT:
+                        return STATUS_NOT_FOUND;
+                    case ENOTDIR:
+                        return STATUS_NOT_DIRECTORY;
+                    case ENAMETOOLONG:
+                        return STATUS_BAD_ARGUMENTS;
+                    default:
+                        return STATUS_IO_ERROR;
+                }
+            }
+
+            status_t res = STATUS_OK;
+            if (::fsync(fd) != 0)
+            {
+                // Some file systems do not support synchronization of directories
+                if ((errno != EINVAL) && (errno != EROFS))
+                    res = STATUS_IO_ERROR;
+            }
+            ::close(fd);
+
+            return res;
+        #endif /* PLATFORM_WINDOWS */
+        }
+
         status_t Dir::get_current(LSPString *path)
         {
             if (path == NULL)
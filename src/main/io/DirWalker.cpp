@@ -0,0 +1,623 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/DirWalker.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <lsp-plug.in/io/Dir.h>
+#else
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <dirent.h>
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif /* PLATFORM_WINDOWS */
+
+#if defined(PLATFORM_LINUX)
+    #include <sys/syscall.h>
+#endif /* PLATFORM_LINUX */
+
+#include <stddef.h>
+
+#define DIR_BUF_SIZE        0x10000
+#define PATH_GRANULARITY    0x100
+
+namespace lsp
+{
+    namespace io
+    {
+    #if defined(PLATFORM_LINUX)
+        // The structure is not defined by system headers
+        typedef struct linux_dirent64_t
+        {
+            uint64_t            d_ino;
+            int64_t             d_off;
+            uint16_t            d_reclen;
+            uint8_t             d_type;
+            char                d_name[1];
+        } linux_dirent64_t;
+    #endif /* PLATFORM_LINUX */
+
+        static inline bool is_separator(char c)
+        {
+        #if defined(PLATFORM_WINDOWS)
+            return (c == '/') || (c == '\\');
+        #else
+            return c == FILE_SEPARATOR_C;
+        #endif /* PLATFORM_WINDOWS */
+        }
+
+        static inline bool is_dots(const char *name)
+        {
+            return (name[0] == '.') &&
+                ((name[1] == '\0') || ((name[1] == '.') && (name[2] == '\0')));
+        }
+
+    #if !defined(PLATFORM_WINDOWS)
+        static status_t decode_errno(int code)
+        {
+            switch (code)
+            {
+                case EACCES: return STATUS_PERMISSION_DENIED;
+                case EPERM: return STATUS_PERMISSION_DENIED;
+                case EBADF: return STATUS_INVALID_VALUE;
+                case ENAMETOOLONG: return STATUS_OVERFLOW;
+                case EOVERFLOW: return STATUS_OVERFLOW;
+                case ENOENT: return STATUS_NOT_FOUND;
+                case ENOTDIR: return STATUS_NOT_DIRECTORY;
+                case ENOMEM: return STATUS_NO_MEM;
+                case ELOOP: return STATUS_BAD_SYMLINK;
+                default: break;
+            }
+            return STATUS_IO_ERROR;
+        }
+
+        static fattr_t::ftype_t decode_mode(mode_t mode)
+        {
+            switch (mode & S_IFMT)
+            {
+                case S_IFBLK:  return fattr_t::FT_BLOCK;
+                case S_IFCHR:  return fattr_t::FT_CHARACTER;
+                case S_IFDIR:  return fattr_t::FT_DIRECTORY;
+                case S_IFIFO:  return fattr_t::FT_FIFO;
+                case S_IFLNK:  return fattr_t::FT_SYMLINK;
+                case S_IFREG:  return fattr_t::FT_REGULAR;
+                case S_IFSOCK: return fattr_t::FT_SOCKET;
+                default:       break;
+            }
+            return fattr_t::FT_UNKNOWN;
+        }
+
+        #if defined(DT_UNKNOWN)
+        static fattr_t::ftype_t decode_dtype(uint8_t type)
+        {
+            switch (type)
+            {
+                case DT_BLK:   return fattr_t::FT_BLOCK;
+                case DT_CHR:   return fattr_t::FT_CHARACTER;
+                case DT_DIR:   return fattr_t::FT_DIRECTORY;
+                case DT_FIFO:  return fattr_t::FT_FIFO;
+                case DT_LNK:   return fattr_t::FT_SYMLINK;
+                case DT_REG:   return fattr_t::FT_REGULAR;
+                case DT_SOCK:  return fattr_t::FT_SOCKET;
+                default:       break;
+            }
+            return fattr_t::FT_UNKNOWN;
+        }
+        #endif /* DT_UNKNOWN */
+
+        /**
+         * Obtain attributes of the directory entry, do not follow symlinks
+         * @param dirfd directory descriptor
+         * @param name name of the entry
+         * @param attr attributes to store, only type is valid if full is not set
+         * @param full request all attributes instead of file type
+         * @param use_statx flag that allows to use statx(), reset if the system call is not available
+         * @return status of operation
+         */
+        static status_t stat_entry(int dirfd, const char *name, fattr_t *attr, bool full, uatomic_t *use_statx)
+        {
+        #if defined(STATX_TYPE)
+            if (atomic_load(use_statx))
+            {
+                // Request only the data we need, this allows some file systems to avoid
+                // expensive operations
+                const unsigned int mask = (full) ?
+                    STATX_TYPE | STATX_INO | STATX_SIZE | STATX_ATIME | STATX_MTIME | STATX_CTIME :
+                    STATX_TYPE;
+
+                struct statx sb;
+                if (::statx(dirfd, name, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT | AT_STATX_DONT_SYNC, mask, &sb) == 0)
+                {
+                    attr->type      = decode_mode(sb.stx_mode);
+                    if (!full)
+                        return STATUS_OK;
+
+                    attr->blk_size  = sb.stx_blksize;
+                    attr->size      = sb.stx_size;
+                    attr->inode     = sb.stx_ino;
+                    attr->ctime     = (sb.stx_ctime.tv_sec * 1000LL) + (sb.stx_ctime.tv_nsec / 1000000);
+                    attr->mtime     = (sb.stx_mtime.tv_sec * 1000LL) + (sb.stx_mtime.tv_nsec / 1000000);
+                    attr->atime     = (sb.stx_atime.tv_sec * 1000LL) + (sb.stx_atime.tv_nsec / 1000000);
+                    return STATUS_OK;
+                }
+
+                // Kernels before 4.11 do not implement statx() and some seccomp profiles
+                // deny it, use fstatat() for the rest of the walk then
+                const int code  = errno;
+                if ((code != ENOSYS) && (code != EPERM))
+                    return decode_errno(code);
+                atomic_store(use_statx, 0);
+            }
+        #endif /* STATX_TYPE */
+
+            struct stat sb;
+            if (::fstatat(dirfd, name, &sb, AT_SYMLINK_NOFOLLOW) != 0)
+                return decode_errno(errno);
+
+            attr->type      = decode_mode(sb.st_mode);
+            if (!full)
+                return STATUS_OK;
+
+            attr->blk_size  = sb.st_blksize;
+            attr->size      = sb.st_size;
+            attr->inode     = sb.st_ino;
+
+            #if defined(PLATFORM_MACOSX)
+                attr->ctime     = (sb.st_ctimespec.tv_sec * 1000LL) + (sb.st_ctimespec.tv_nsec / 1000000);
+                attr->mtime     = (sb.st_mtimespec.tv_sec * 1000LL) + (sb.st_mtimespec.tv_nsec / 1000000);
+                attr->atime     = (sb.st_atimespec.tv_sec * 1000LL) + (sb.st_atimespec.tv_nsec / 1000000);
+            #elif defined(st_ctime) || defined(st_mtime) || defined(st_atime)
+                attr->ctime     = (sb.st_ctim.tv_sec * 1000LL) + (sb.st_ctim.tv_nsec / 1000000);
+                attr->mtime     = (sb.st_mtim.tv_sec * 1000LL) + (sb.st_mtim.tv_nsec / 1000000);
+                attr->atime     = (sb.st_atim.tv_sec * 1000LL) + (sb.st_atim.tv_nsec / 1000000);
+            #else
+                attr->ctime     = sb.st_ctime * 1000LL;
+                attr->mtime     = sb.st_mtime * 1000LL;
+                attr->atime     = sb.st_atime * 1000LL;
+            #endif
+
+            return STATUS_OK;
+        }
+    #endif /* PLATFORM_WINDOWS */
+
+        DirWalker::DirWalker()
+        {
+            pHandler        = NULL;
+            pFilter         = NULL;
+            pExclude        = NULL;
+            nFlags          = WALK_NONE;
+            nThreads        = 1;
+            nMaxDepth       = size_t(-1);
+            nRootLength     = 0;
+            nActive         = 0;
+            nError          = STATUS_OK;
+            nStatx          = 1;
+        }
+
+        DirWalker::~DirWalker()
+        {
+            clear_queue();
+        }
+
+        void DirWalker::clear_queue()
+        {
+            for (size_t i=0, n=vQueue.size(); i<n; ++i)
+                free(vQueue.uget(i));
+            vQueue.flush();
+        }
+
+        DirWalker::task_t *DirWalker::create_task(const char *path, size_t length, size_t depth)
+        {
+            task_t *task        = static_cast<task_t *>(malloc(sizeof(task_t) + length + 1));
+            if (task == NULL)
+                return NULL;
+
+            task->nLength       = length;
+            task->nDepth        = depth;
+            task->sPath         = reinterpret_cast<char *>(&task[1]);
+            memcpy(task->sPath, path, length);
+            task->sPath[length] = '\0';
+
+            return task;
+        }
+
+        bool DirWalker::reserve_path(context_t *ctx, size_t length)
+        {
+            if (length <= ctx->nCapacity)
+                return true;
+
+            const size_t cap    = (length + PATH_GRANULARITY - 1) & (~size_t(PATH_GRANULARITY - 1));
+            char *path          = static_cast<char *>(realloc(ctx->pPath, cap));
+            if (path == NULL)
+                return false;
+
+            ctx->pPath          = path;
+            ctx->nCapacity      = cap;
+            return true;
+        }
+
+        status_t DirWalker::build_path(context_t *ctx, const task_t *task, const char *name, dir_entry_t *entry)
+        {
+            const size_t nlen   = strlen(name);
+            const size_t plen   = task->nLength;
+            const size_t offset = ((plen > 0) && (is_separator(task->sPath[plen - 1]))) ? plen : plen + 1;
+            if (!reserve_path(ctx, offset + nlen + 1))
+                return STATUS_NO_MEM;
+
+            char *path          = ctx->pPath;
+            memcpy(path, task->sPath, plen);
+            path[plen]          = FILE_SEPARATOR_C;
+            memcpy(&path[offset], name, nlen + 1);
+
+            entry->path         = path;
+            entry->relative     = &path[nRootLength];
+            entry->name         = &path[offset];
+            entry->depth        = task->nDepth;
+
+            return STATUS_OK;
+        }
+
+        status_t DirWalker::process_entry(context_t *ctx, const task_t *task, const dir_entry_t *entry)
+        {
+            const bool is_dir   = entry->type == fattr_t::FT_DIRECTORY;
+
+            // Excluded entries are not reported and not entered
+            if ((pExclude != NULL) && (pExclude->test(entry->relative)))
+                return STATUS_OK;
+
+            // Report the entry
+            status_t res        = STATUS_OK;
+            const size_t skip   = (is_dir) ? WALK_NO_DIRS : WALK_NO_FILES;
+            if ((!(nFlags & skip)) && ((pFilter == NULL) || (pFilter->test(entry->relative))))
+                res                 = pHandler->on_entry(entry);
+
+            if (res == STATUS_SKIP)
+                return STATUS_OK;
+            else if (res != STATUS_OK)
+                return res;
+
+            // Schedule the subdirectory for processing
+            if ((!is_dir) || (task->nDepth >= nMaxDepth))
+                return STATUS_OK;
+
+            task_t *sub         = create_task(entry->path, strlen(entry->path), task->nDepth + 1);
+            if (sub == NULL)
+                return STATUS_NO_MEM;
+            if (!ctx->vTasks.add(sub))
+            {
+                free(sub);
+                return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t DirWalker::process_task(context_t *ctx, const task_t *task)
+        {
+            status_t res;
+
+        #if defined(PLATFORM_WINDOWS)
+            dir_entry_t entry;
+            fattr_t attr;
+            LSPString path, name;
+            if (!path.set_utf8(task->sPath, task->nLength))
+                return STATUS_NO_MEM;
+
+            // Windows provides file attributes together with the directory listing
+            Dir dir;
+            if ((res = dir.open(&path)) != STATUS_OK)
+                return pHandler->on_error(task->sPath, res);
+            lsp_finally { dir.close(); };
+
+            while ((res = dir.reads(&name, &attr, false)) == STATUS_OK)
+            {
+                const char *u8name  = name.get_utf8();
+                if (u8name == NULL)
+                    return STATUS_NO_MEM;
+                if (is_dots(u8name))
+                    continue;
+
+                if ((res = build_path(ctx, task, u8name, &entry)) != STATUS_OK)
+                    return res;
+                entry.type          = attr.type;
+                entry.attr          = (nFlags & WALK_STAT) ? &attr : NULL;
+
+                if ((res = process_entry(ctx, task, &entry)) != STATUS_OK)
+                    return res;
+            }
+
+            return (res == STATUS_EOF) ? STATUS_OK : pHandler->on_error(task->sPath, res);
+        #else
+            #if defined(PLATFORM_LINUX)
+                // Read directory entries in large batches
+                const int fd        = ::open(task->sPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+                if (fd < 0)
+                    return pHandler->on_error(task->sPath, decode_errno(errno));
+                lsp_finally { ::close(fd); };
+
+                while (true)
+                {
+                    const long count    = ::syscall(SYS_getdents64, fd, ctx->pData, DIR_BUF_SIZE);
+                    if (count == 0)
+                        break;
+                    else if (count < 0)
+                        return pHandler->on_error(task->sPath, decode_errno(errno));
+
+                    for (long offset = 0; offset < count; )
+                    {
+                        const linux_dirent64_t *dent = reinterpret_cast<const linux_dirent64_t *>(&ctx->pData[offset]);
+                        offset             += dent->d_reclen;
+
+                        if ((res = process_dirent(ctx, task, fd, dent->d_name, dent->d_type)) != STATUS_OK)
+                            return res;
+                    }
+                }
+            #else
+                DIR *dir            = ::opendir(task->sPath);
+                if (dir == NULL)
+                    return pHandler->on_error(task->sPath, decode_errno(errno));
+                lsp_finally { ::closedir(dir); };
+                const int fd        = ::dirfd(dir);
+
+                while (true)
+                {
+                    errno               = 0;
+                    struct dirent *dent = ::readdir(dir);
+                    if (dent == NULL)
+                    {
+                        if (errno == 0)
+                            break;
+                        return pHandler->on_error(task->sPath, decode_errno(errno));
+                    }
+
+                #if defined(DT_UNKNOWN)
+                    res                 = process_dirent(ctx, task, fd, dent->d_name, dent->d_type);
+                #else
+                    res                 = process_dirent(ctx, task, fd, dent->d_name, 0);
+                #endif /* DT_UNKNOWN */
+                    if (res != STATUS_OK)
+                        return res;
+                }
+            #endif /* PLATFORM_LINUX */
+
+            return STATUS_OK;
+        #endif /* PLATFORM_WINDOWS */
+        }
+
+    #if !defined(PLATFORM_WINDOWS)
+        status_t DirWalker::process_dirent(context_t *ctx, const task_t *task, int dirfd, const char *name, uint8_t type)
+        {
+            if (is_dots(name))
+                return STATUS_OK;
+
+            dir_entry_t entry;
+            fattr_t attr;
+            status_t res        = build_path(ctx, task, name, &entry);
+            if (res != STATUS_OK)
+                return res;
+
+            // Use the file type provided by the directory listing, call stat only if
+            // the file system does not provide it or attributes have been requested
+        #if defined(DT_UNKNOWN)
+            entry.type          = decode_dtype(type);
+        #else
+            entry.type          = fattr_t::FT_UNKNOWN;
+        #endif /* DT_UNKNOWN */
+            entry.attr          = NULL;
+
+            const bool full     = nFlags & WALK_STAT;
+            if ((full) || (entry.type == fattr_t::FT_UNKNOWN))
+            {
+                // The entry may be removed while walking, let the handler decide what to do
+                if ((res = stat_entry(dirfd, name, &attr, full, &nStatx)) != STATUS_OK)
+                    return pHandler->on_error(entry.path, res);
+
+                entry.type          = attr.type;
+                if (full)
+                    entry.attr          = &attr;
+            }
+
+            return process_entry(ctx, task, &entry);
+        }
+    #endif /* PLATFORM_WINDOWS */
+
+        void DirWalker::set_result(status_t code)
+        {
+            sCond.lock();
+            if (nError == STATUS_OK)
+                nError          = code;
+            sCond.notify_all();
+            sCond.unlock();
+        }
+
+        status_t DirWalker::worker()
+        {
+            context_t ctx;
+            ctx.pPath       = NULL;
+            ctx.nCapacity   = 0;
+            ctx.pData       = NULL;
+            lsp_finally {
+                for (size_t i=0, n=ctx.vTasks.size(); i<n; ++i)
+                    free(ctx.vTasks.uget(i));
+                ctx.vTasks.flush();
+                free(ctx.pPath);
+                free(ctx.pData);
+            };
+
+        #if defined(PLATFORM_LINUX)
+            ctx.pData       = static_cast<uint8_t *>(malloc(DIR_BUF_SIZE));
+            if (ctx.pData == NULL)
+            {
+                set_result(STATUS_NO_MEM);
+                return STATUS_NO_MEM;
+            }
+        #endif /* PLATFORM_LINUX */
+
+            while (true)
+            {
+                // Obtain the next directory to process or wait until other threads
+                // find more directories or finish their work
+                task_t *task    = NULL;
+                sCond.lock();
+                while (nError == STATUS_OK)
+                {
+                    if (vQueue.pop(&task))
+                        break;
+                    if (nActive <= 0)
+                        break;
+                    sCond.wait();
+                }
+
+                if (task == NULL)
+                {
+                    sCond.notify_all();
+                    sCond.unlock();
+                    return STATUS_OK;
+                }
+                ++nActive;
+                sCond.unlock();
+
+                // Process the directory
+                status_t res    = process_task(&ctx, task);
+                free(task);
+                if (res != STATUS_OK)
+                    set_result(res);
+
+                // Submit found subdirectories to the queue
+                sCond.lock();
+                if ((nError == STATUS_OK) && (vQueue.add(&ctx.vTasks)))
+                    ctx.vTasks.clear();
+                else if (nError == STATUS_OK)
+                    nError          = STATUS_NO_MEM;
+                --nActive;
+                sCond.notify_all();
+                sCond.unlock();
+
+                for (size_t i=0, n=ctx.vTasks.size(); i<n; ++i)
+                    free(ctx.vTasks.uget(i));
+                ctx.vTasks.clear();
+            }
+        }
+
+        status_t DirWalker::thread_proc(void *arg)
+        {
+            DirWalker *self = static_cast<DirWalker *>(arg);
+            return self->worker();
+        }
+
+        status_t DirWalker::walk(const char *path, IDirWalkHandler *handler)
+        {
+            if ((path == NULL) || (handler == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return STATUS_NO_MEM;
+            return walk(&tmp, handler);
+        }
+
+        status_t DirWalker::walk(const Path *path, IDirWalkHandler *handler)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            return walk(path->as_string(), handler);
+        }
+
+        status_t DirWalker::walk(const LSPString *path, IDirWalkHandler *handler)
+        {
+            if ((path == NULL) || (handler == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            if (pHandler != NULL)
+                return STATUS_BAD_STATE;
+
+        #if defined(PLATFORM_WINDOWS)
+            const char *root    = path->get_utf8();
+        #else
+            const char *root    = path->get_native();
+        #endif /* PLATFORM_WINDOWS */
+            if (root == NULL)
+                return STATUS_NO_MEM;
+
+            // Remove trailing separators except the one that denotes the root of file system
+            size_t length       = strlen(root);
+            if (length <= 0)
+                return STATUS_BAD_PATH;
+            while ((length > 1) && (is_separator(root[length - 1])) && (!is_separator(root[length - 2])))
+                --length;
+
+            task_t *task        = create_task(root, length, 0);
+            if (task == NULL)
+                return STATUS_NO_MEM;
+            if (!vQueue.add(task))
+            {
+                free(task);
+                return STATUS_NO_MEM;
+            }
+
+            // Initialize state
+            pHandler            = handler;
+            nRootLength         = (is_separator(root[length - 1])) ? length : length + 1;
+            nActive             = 0;
+            nError              = STATUS_OK;
+            nStatx              = 1;
+            lsp_finally {
+                clear_queue();
+                pHandler            = NULL;
+            };
+
+            // Start additional threads, the calling thread also takes part in the walk
+            lltl::parray<ipc::Thread> threads;
+
+            const size_t count  = (nThreads > 0) ? nThreads : ipc::Thread::system_cores();
+            for (size_t i=1; i<count; ++i)
+            {
+                ipc::Thread *t      = new ipc::Thread(thread_proc, this);
+                if (t == NULL)
+                    break;
+                if ((t->start() != STATUS_OK) || (!threads.add(t)))
+                {
+                    t->join();
+                    delete t;
+                    break;
+                }
+            }
+
+            worker();
+
+            // Wait for other threads
+            for (size_t i=0, n=threads.size(); i<n; ++i)
+            {
+                ipc::Thread *t = threads.uget(i);
+                t->join();
+                delete t;
+            }
+            threads.flush();
+
+            return nError;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -0,0 +1,1088 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/DirWatcher.h>
+#include <lsp-plug.in/io/DirWalker.h>
+#include <lsp-plug.in/io/File.h>
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#if defined(PLATFORM_LINUX)
+    #include <sys/inotify.h>
+    #include <errno.h>
+    #include <limits.h>
+    #include <poll.h>
+    #include <unistd.h>
+#endif /* PLATFORM_LINUX */
+
+#define NOTIFY_BUF_SIZE     0x4000
+#define COALESCE_ROUNDS     16
+
+namespace lsp
+{
+    namespace io
+    {
+    #if defined(PLATFORM_LINUX)
+        static constexpr uint32_t NOTIFY_MASK =
+            IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE |
+            IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF |
+            IN_ONLYDIR | IN_EXCL_UNLINK;
+    #endif /* PLATFORM_LINUX */
+
+        static inline bool is_separator(char c)
+        {
+        #if defined(PLATFORM_WINDOWS)
+            return (c == '/') || (c == '\\');
+        #else
+            return c == FILE_SEPARATOR_C;
+        #endif /* PLATFORM_WINDOWS */
+        }
+
+        static char *join_path(const char *dir, const char *name)
+        {
+            if (dir[0] == '\0')
+                return strdup(name);
+            if (name[0] == '\0')
+                return strdup(dir);
+
+            const size_t dlen   = strlen(dir);
+            const size_t nlen   = strlen(name);
+            char *res           = static_cast<char *>(malloc(dlen + nlen + 2));
+            if (res == NULL)
+                return NULL;
+
+            memcpy(res, dir, dlen);
+            res[dlen]           = FILE_SEPARATOR_C;
+            memcpy(&res[dlen + 1], name, nlen + 1);
+
+            return res;
+        }
+
+    #if defined(PLATFORM_LINUX)
+        static const char *subpath(const char *path, const char *dir, size_t length)
+        {
+            if (strncmp(path, dir, length) != 0)
+                return NULL;
+            if (path[length] == '\0')
+                return &path[length];
+            return (is_separator(path[length])) ? &path[length + 1] : NULL;
+        }
+    #endif /* PLATFORM_LINUX */
+
+        static ssize_t compare_paths(const char *a, const char *b)
+        {
+            return strcmp(a, b);
+        }
+
+        DirWatcher::DirWatcher()
+        {
+            sNative         = NULL;
+            nFlags          = WATCH_NONE;
+            enMode          = MODE_NONE;
+            nCoalesce       = 50;
+            nInterval       = 1000;
+            hNotify         = -1;
+            pSnapshot       = NULL;
+            pScan           = NULL;
+            nLastScan       = 0;
+            sBase           = NULL;
+            bReport         = false;
+        }
+
+        DirWatcher::~DirWatcher()
+        {
+            close();
+        }
+
+        DirWatcher::event_t *DirWatcher::create_event(dir_event_t::event_t type, const char *path, bool directory)
+        {
+            event_t *ev         = static_cast<event_t *>(malloc(sizeof(event_t)));
+            if (ev == NULL)
+                return NULL;
+
+            ev->nType           = type;
+            ev->bDirectory      = directory;
+            ev->nCookie         = 0;
+            ev->sPath           = strdup(path);
+            ev->sOldPath        = NULL;
+            if (ev->sPath == NULL)
+            {
+                free(ev);
+                return NULL;
+            }
+
+            return ev;
+        }
+
+        void DirWatcher::destroy_event(event_t *ev)
+        {
+            if (ev == NULL)
+                return;
+            if (ev->sPath != NULL)
+                free(ev->sPath);
+            if (ev->sOldPath != NULL)
+                free(ev->sOldPath);
+            free(ev);
+        }
+
+        void DirWatcher::destroy_snapshot(snapshot_map_t *map)
+        {
+            if (map == NULL)
+                return;
+
+            lltl::parray<snapshot_t> values;
+            map->values(&values);
+            map->flush();
+            for (size_t i=0, n=values.size(); i<n; ++i)
+                free(values.uget(i));
+            delete map;
+        }
+
+        status_t DirWatcher::on_entry(const dir_entry_t *entry)
+        {
+            // Polling mode: remember the state of the entry
+            if (pScan != NULL)
+            {
+                snapshot_t *s       = static_cast<snapshot_t *>(malloc(sizeof(snapshot_t)));
+                if (s == NULL)
+                    return STATUS_NO_MEM;
+
+                s->nType            = entry->type;
+                s->nSize            = (entry->attr != NULL) ? entry->attr->size : 0;
+                s->nMTime           = (entry->attr != NULL) ? entry->attr->mtime : 0;
+                if (!pScan->create(entry->relative, s))
+                {
+                    free(s);
+                    return STATUS_NO_MEM;
+                }
+                return STATUS_OK;
+            }
+
+        #if defined(PLATFORM_LINUX)
+            // Notification mode: watch the subdirectory and report the entry
+            const bool directory    = entry->type == fattr_t::FT_DIRECTORY;
+            char *path              = join_path(sBase, entry->relative);
+            if (path == NULL)
+                return STATUS_NO_MEM;
+            lsp_finally { free(path); };
+
+            if (directory)
+            {
+                status_t res        = add_watch(path);
+                switch (res)
+                {
+                    case STATUS_OK:
+                        break;
+                    case STATUS_NOT_FOUND:
+                    case STATUS_NOT_DIRECTORY:
+                    case STATUS_PERMISSION_DENIED:
+                        return STATUS_SKIP;
+                    default:
+                        return res;
+                }
+            }
+
+            return (bReport) ? add_event(dir_event_t::EV_CREATE, path, directory) : STATUS_OK;
+        #else
+            return STATUS_OK;
+        #endif /* PLATFORM_LINUX */
+        }
+
+        status_t DirWatcher::on_error(const char *path, status_t code)
+        {
+            // Entries may disappear while the tree is being scanned
+            switch (code)
+            {
+                case STATUS_NOT_FOUND:
+                case STATUS_NOT_DIRECTORY:
+                case STATUS_PERMISSION_DENIED:
+                    return STATUS_OK;
+                default:
+                    break;
+            }
+            return code;
+        }
+
+        void DirWatcher::drop_events()
+        {
+            for (size_t i=0, n=vEvents.size(); i<n; ++i)
+                destroy_event(vEvents.uget(i));
+            vEvents.flush();
+            vIndex.flush();
+        }
+
+        void DirWatcher::drop_event(event_t *ev)
+        {
+            if (vIndex.get(ev->sPath) == ev)
+                vIndex.remove(ev->sPath, NULL);
+            vEvents.premove(ev);
+            destroy_event(ev);
+        }
+
+        status_t DirWatcher::add_event(dir_event_t::event_t type, const char *path, bool directory)
+        {
+            event_t *ev         = vIndex.get(path);
+            if (ev == NULL)
+            {
+                if ((ev = create_event(type, path, directory)) == NULL)
+                    return STATUS_NO_MEM;
+                if (!vEvents.add(ev))
+                {
+                    destroy_event(ev);
+                    return STATUS_NO_MEM;
+                }
+                if (!vIndex.create(ev->sPath, ev))
+                {
+                    vEvents.pop();
+                    destroy_event(ev);
+                    return STATUS_NO_MEM;
+                }
+                return STATUS_OK;
+            }
+
+            // Coalesce with the pending event
+            ev->bDirectory      = directory;
+            switch (ev->nType)
+            {
+                case dir_event_t::EV_CREATE:
+                    // Created and deleted: nothing has happened
+                    if (type == dir_event_t::EV_DELETE)
+                        drop_event(ev);
+                    break;
+                case dir_event_t::EV_DELETE:
+                    // Deleted and created again: the entry has been replaced
+                    if (type != dir_event_t::EV_DELETE)
+                        ev->nType       = dir_event_t::EV_MODIFY;
+                    break;
+                case dir_event_t::EV_MODIFY:
+                    if (type == dir_event_t::EV_DELETE)
+                        ev->nType       = dir_event_t::EV_DELETE;
+                    break;
+                case dir_event_t::EV_RENAME:
+                    // Renamed and deleted: the original entry has been deleted
+                    if (type == dir_event_t::EV_DELETE)
+                    {
+                        char *old       = ev->sOldPath;
+                        ev->sOldPath    = NULL;
+                        lsp_finally { free(old); };
+
+                        drop_event(ev);
+                        return add_event(dir_event_t::EV_DELETE, old, directory);
+                    }
+                    break;
+                default:
+                    break;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::add_rescan()
+        {
+            event_t *ev         = create_event(dir_event_t::EV_RESCAN, "", true);
+            if (ev == NULL)
+                return STATUS_NO_MEM;
+            if (!vEvents.add(ev))
+            {
+                destroy_event(ev);
+                return STATUS_NO_MEM;
+            }
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::add_rename(const char *from, const char *to, bool directory)
+        {
+            if (strcmp(from, to) == 0)
+                return add_event(dir_event_t::EV_MODIFY, to, directory);
+
+            // The destination entry is replaced by the renamed one
+            event_t *ev         = vIndex.get(to);
+            if (ev != NULL)
+                drop_event(ev);
+
+            if ((ev = create_event(dir_event_t::EV_RENAME, to, directory)) == NULL)
+                return STATUS_NO_MEM;
+            if ((ev->sOldPath = strdup(from)) == NULL)
+            {
+                destroy_event(ev);
+                return STATUS_NO_MEM;
+            }
+            if (!vEvents.add(ev))
+            {
+                destroy_event(ev);
+                return STATUS_NO_MEM;
+            }
+            if (!vIndex.create(ev->sPath, ev))
+            {
+                vEvents.pop();
+                destroy_event(ev);
+                return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::move_from(const char *path, bool directory, uint32_t cookie)
+        {
+            // The pending event is detached from index until the destination becomes known.
+            // The type of pending move keeps the previous state of the entry, EV_DELETE means
+            // that there were no pending changes.
+            event_t *ev         = vIndex.get(path);
+            if (ev != NULL)
+                vIndex.remove(path, NULL);
+            else
+            {
+                if ((ev = create_event(dir_event_t::EV_DELETE, path, directory)) == NULL)
+                    return STATUS_NO_MEM;
+                if (!vEvents.add(ev))
+                {
+                    destroy_event(ev);
+                    return STATUS_NO_MEM;
+                }
+            }
+
+            ev->bDirectory      = directory;
+            ev->nCookie         = cookie;
+
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::move_to(const char *path, bool directory, uint32_t cookie)
+        {
+            // Find the source of the move
+            event_t *src        = NULL;
+            for (size_t i=vEvents.size(); i > 0; )
+            {
+                event_t *ev         = vEvents.uget(--i);
+                if ((ev->nCookie != 0) && (ev->nCookie == cookie))
+                {
+                    src                 = ev;
+                    break;
+                }
+            }
+
+            // The entry has been moved from outside of the watched tree
+            if (src == NULL)
+            {
+                status_t res        = add_event(dir_event_t::EV_CREATE, path, directory);
+            #if defined(PLATFORM_LINUX)
+                if ((res == STATUS_OK) && (directory) && (nFlags & WATCH_RECURSIVE))
+                    res                 = watch_subtree(path);
+            #endif /* PLATFORM_LINUX */
+                return res;
+            }
+
+            // The entry has been moved inside of the watched tree
+            const dir_event_t::event_t type = src->nType;
+            char *from          = src->sPath;
+            char *old           = src->sOldPath;
+            src->sPath          = NULL;
+            src->sOldPath       = NULL;
+            lsp_finally {
+                free(from);
+                if (old != NULL)
+                    free(old);
+            };
+            vEvents.premove(src);
+            destroy_event(src);
+
+        #if defined(PLATFORM_LINUX)
+            if ((directory) && (enMode == MODE_NOTIFY))
+            {
+                status_t res        = rename_watches(from, path);
+                if (res != STATUS_OK)
+                    return res;
+            }
+        #endif /* PLATFORM_LINUX */
+
+            switch (type)
+            {
+                case dir_event_t::EV_CREATE:
+                    return add_event(dir_event_t::EV_CREATE, path, directory);
+                case dir_event_t::EV_RENAME:
+                    return add_rename(old, path, directory);
+                default:
+                    break;
+            }
+
+            return add_rename(from, path, directory);
+        }
+
+        status_t DirWatcher::complete_moves()
+        {
+            // Entries that have been moved outside of the watched tree become deleted
+            for (size_t i=0; i<vEvents.size(); )
+            {
+                event_t *ev         = vEvents.uget(i);
+                if (ev->nCookie == 0)
+                {
+                    ++i;
+                    continue;
+                }
+
+                ev->nCookie         = 0;
+            #if defined(PLATFORM_LINUX)
+                if ((ev->bDirectory) && (enMode == MODE_NOTIFY))
+                    remove_watches(ev->sPath);
+            #endif /* PLATFORM_LINUX */
+
+                switch (ev->nType)
+                {
+                    case dir_event_t::EV_CREATE:
+                        // Created and moved away: nothing has happened
+                        vEvents.remove(i);
+                        destroy_event(ev);
+                        break;
+
+                    case dir_event_t::EV_RENAME:
+                    {
+                        // Renamed and moved away: the original entry has been deleted
+                        const bool directory    = ev->bDirectory;
+                        char *old               = ev->sOldPath;
+                        ev->sOldPath            = NULL;
+                        lsp_finally { free(old); };
+
+                        vEvents.remove(i);
+                        destroy_event(ev);
+                        status_t res            = add_event(dir_event_t::EV_DELETE, old, directory);
+                        if (res != STATUS_OK)
+                            return res;
+                        break;
+                    }
+
+                    default:
+                        ev->nType           = dir_event_t::EV_DELETE;
+                        ++i;
+                        break;
+                }
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::dispatch(IDirWatchHandler *handler)
+        {
+            status_t res        = complete_moves();
+            if (res != STATUS_OK)
+                return res;
+
+            // Report events
+            dir_event_t de;
+            size_t count        = 0;
+            for (size_t n=vEvents.size(); count < n; )
+            {
+                const event_t *ev   = vEvents.uget(count++);
+
+                de.type             = ev->nType;
+                de.path             = ev->sPath;
+                de.old_path         = ev->sOldPath;
+                de.directory        = ev->bDirectory;
+
+                if ((res = handler->on_event(&de)) != STATUS_OK)
+                    break;
+            }
+
+            // Remove reported events
+            for (size_t i=0; i<count; ++i)
+            {
+                event_t *ev         = vEvents.uget(i);
+                if (vIndex.get(ev->sPath) == ev)
+                    vIndex.remove(ev->sPath, NULL);
+                destroy_event(ev);
+            }
+            vEvents.remove_n(0, count);
+
+            return res;
+        }
+
+        status_t DirWatcher::scan(snapshot_map_t *map)
+        {
+            DirWalker w;
+            w.set_threads(1);
+            w.set_flags(DirWalker::WALK_STAT);
+            if (!(nFlags & WATCH_RECURSIVE))
+                w.set_max_depth(0);
+
+            pScan               = map;
+            lsp_finally { pScan = NULL; };
+
+            return w.walk(&sRoot, this);
+        }
+
+        status_t DirWatcher::rescan()
+        {
+            snapshot_map_t *map = new snapshot_map_t();
+            if (map == NULL)
+                return STATUS_NO_MEM;
+            lsp_finally { destroy_snapshot(map); };
+
+            status_t res        = scan(map);
+            nLastScan           = system::get_time_millis();
+            if (res != STATUS_OK)
+                return res;
+
+            // Report created and modified entries in the order of paths, so parent directories
+            // are reported before their contents
+            lltl::parray<char> keys;
+            if (!map->keys(&keys))
+                return STATUS_NO_MEM;
+            keys.qsort(compare_paths);
+
+            for (size_t i=0, n=keys.size(); i<n; ++i)
+            {
+                const char *key         = keys.uget(i);
+                const snapshot_t *curr  = map->get(key);
+                const snapshot_t *prev  = (pSnapshot != NULL) ? pSnapshot->get(key) : NULL;
+                const bool directory    = curr->nType == fattr_t::FT_DIRECTORY;
+
+                if (prev == NULL)
+                    res                     = add_event(dir_event_t::EV_CREATE, key, directory);
+                else if ((prev->nType != curr->nType) ||
+                         ((!directory) && ((prev->nSize != curr->nSize) || (prev->nMTime != curr->nMTime))))
+                    res                     = add_event(dir_event_t::EV_MODIFY, key, directory);
+
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            // Report deleted entries
+            keys.clear();
+            if ((pSnapshot != NULL) && (!pSnapshot->keys(&keys)))
+                return STATUS_NO_MEM;
+            keys.qsort(compare_paths);
+
+            for (size_t i=0, n=keys.size(); i<n; ++i)
+            {
+                const char *key         = keys.uget(i);
+                if (map->contains(key))
+                    continue;
+
+                const snapshot_t *prev  = pSnapshot->get(key);
+                if ((res = add_event(dir_event_t::EV_DELETE, key, prev->nType == fattr_t::FT_DIRECTORY)) != STATUS_OK)
+                    return res;
+            }
+
+            lsp::swap(map, pSnapshot);
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::start_polling()
+        {
+        #if defined(PLATFORM_LINUX)
+            if (hNotify >= 0)
+            {
+                ::close(hNotify);
+                hNotify             = -1;
+            }
+            for (size_t i=0, n=vWatches.size(); i<n; ++i)
+            {
+                watch_t *w          = vWatches.uget(i);
+                free(w->sPath);
+                free(w);
+            }
+            vWatches.flush();
+        #endif /* PLATFORM_LINUX */
+
+            destroy_snapshot(pSnapshot);
+            pSnapshot           = NULL;
+            enMode              = MODE_POLL;
+
+            snapshot_map_t *map = new snapshot_map_t();
+            if (map == NULL)
+                return STATUS_NO_MEM;
+
+            status_t res        = scan(map);
+            if (res != STATUS_OK)
+            {
+                destroy_snapshot(map);
+                return res;
+            }
+
+            pSnapshot           = map;
+            nLastScan           = system::get_time_millis();
+
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::fetch(size_t timeout)
+        {
+        #if defined(PLATFORM_LINUX)
+            if (enMode == MODE_NOTIFY)
+                return read_notify(timeout);
+        #endif /* PLATFORM_LINUX */
+
+            // Wait for the next re-scan of the directory tree
+            const system::time_millis_t time    = system::get_time_millis();
+            const system::time_millis_t next    = nLastScan + nInterval;
+            if (time < next)
+            {
+                const system::time_millis_t delay   = next - time;
+                if (delay > timeout)
+                {
+                    if (timeout > 0)
+                        ipc::Thread::sleep(timeout);
+                    return STATUS_TIMED_OUT;
+                }
+                ipc::Thread::sleep(delay);
+            }
+
+            return rescan();
+        }
+
+    #if defined(PLATFORM_LINUX)
+        ssize_t DirWatcher::find_watch(int wd) const
+        {
+            // Binary search, returns negative value that encodes the insert position if not found
+            ssize_t first = 0, last = vWatches.size() - 1;
+            while (first <= last)
+            {
+                const ssize_t mid   = (first + last) >> 1;
+                const int value     = vWatches.uget(mid)->nWd;
+                if (value < wd)
+                    first               = mid + 1;
+                else if (value > wd)
+                    last                = mid - 1;
+                else
+                    return mid;
+            }
+            return -first - 1;
+        }
+
+        status_t DirWatcher::add_watch(const char *path)
+        {
+            char *full          = join_path(sNative, path);
+            if (full == NULL)
+                return STATUS_NO_MEM;
+            lsp_finally { free(full); };
+
+            // Do not follow symbolic links inside of the tree
+            const uint32_t mask = (path[0] != '\0') ? NOTIFY_MASK | IN_DONT_FOLLOW : NOTIFY_MASK;
+            const int wd        = inotify_add_watch(hNotify, full, mask);
+            if (wd < 0)
+            {
+                switch (errno)
+                {
+                    case ENOSPC: return STATUS_OVERFLOW;
+                    case ENOMEM: return STATUS_NO_MEM;
+                    case ENOENT: return STATUS_NOT_FOUND;
+                    case ENOTDIR: return STATUS_NOT_DIRECTORY;
+                    case EACCES: return STATUS_PERMISSION_DENIED;
+                    default: break;
+                }
+                return STATUS_IO_ERROR;
+            }
+
+            char *copy          = strdup(path);
+            if (copy == NULL)
+                return STATUS_NO_MEM;
+
+            // The directory may already be watched
+            ssize_t index       = find_watch(wd);
+            if (index >= 0)
+            {
+                watch_t *w          = vWatches.uget(index);
+                free(w->sPath);
+                w->sPath            = copy;
+                return STATUS_OK;
+            }
+
+            watch_t *w          = static_cast<watch_t *>(malloc(sizeof(watch_t)));
+            if (w == NULL)
+            {
+                free(copy);
+                return STATUS_NO_MEM;
+            }
+            w->nWd              = wd;
+            w->sPath            = copy;
+            if (!vWatches.insert(-index - 1, w))
+            {
+                free(copy);
+                free(w);
+                return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::add_tree(const char *path, bool report)
+        {
+            status_t res        = add_watch(path);
+            if ((res != STATUS_OK) || (!(nFlags & WATCH_RECURSIVE)))
+                return res;
+
+            // Watch all subdirectories, entries that existed before the watch has been
+            // added are reported as created
+            char *full          = join_path(sNative, path);
+            if (full == NULL)
+                return STATUS_NO_MEM;
+            lsp_finally { free(full); };
+
+            LSPString root;
+            if (!root.set_native(full))
+                return STATUS_NO_MEM;
+
+            DirWalker w;
+            w.set_threads(1);
+            w.set_flags((report) ? DirWalker::WALK_NONE : DirWalker::WALK_NO_FILES);
+
+            sBase               = path;
+            bReport             = report;
+            lsp_finally {
+                sBase               = NULL;
+                bReport             = false;
+            };
+
+            return w.walk(&root, this);
+        }
+
+        status_t DirWatcher::watch_subtree(const char *path)
+        {
+            status_t res        = add_tree(path, true);
+            switch (res)
+            {
+                case STATUS_OK:
+                case STATUS_NOT_FOUND:
+                case STATUS_NOT_DIRECTORY:
+                case STATUS_PERMISSION_DENIED:
+                    return STATUS_OK;
+
+                case STATUS_OVERFLOW:
+                    // The limit of watches has been reached, changes may be lost
+                    if ((res = start_polling()) != STATUS_OK)
+                        return res;
+                    return add_rescan();
+
+                default:
+                    break;
+            }
+
+            return res;
+        }
+
+        void DirWatcher::remove_watch(size_t index)
+        {
+            watch_t *w          = vWatches.uget(index);
+            vWatches.remove(index);
+            free(w->sPath);
+            free(w);
+        }
+
+        void DirWatcher::remove_watches(const char *path)
+        {
+            const size_t length = strlen(path);
+            for (size_t i=0; i<vWatches.size(); )
+            {
+                watch_t *w          = vWatches.uget(i);
+                if (subpath(w->sPath, path, length) == NULL)
+                {
+                    ++i;
+                    continue;
+                }
+
+                inotify_rm_watch(hNotify, w->nWd);
+                remove_watch(i);
+            }
+        }
+
+        status_t DirWatcher::rename_watches(const char *from, const char *to)
+        {
+            const size_t length = strlen(from);
+            for (size_t i=0, n=vWatches.size(); i<n; ++i)
+            {
+                watch_t *w          = vWatches.uget(i);
+                const char *tail    = subpath(w->sPath, from, length);
+                if (tail == NULL)
+                    continue;
+
+                char *path          = join_path(to, tail);
+                if (path == NULL)
+                    return STATUS_NO_MEM;
+                free(w->sPath);
+                w->sPath            = path;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::read_notify(size_t timeout)
+        {
+            struct pollfd pfd;
+            pfd.fd              = hNotify;
+            pfd.events          = POLLIN;
+            pfd.revents         = 0;
+
+            const int count     = ::poll(&pfd, 1, lsp_min(timeout, size_t(INT_MAX)));
+            if (count == 0)
+                return STATUS_TIMED_OUT;
+            else if (count < 0)
+                return (errno == EINTR) ? STATUS_OK : STATUS_IO_ERROR;
+
+            alignas(struct inotify_event) uint8_t buf[NOTIFY_BUF_SIZE];
+            while (true)
+            {
+                const ssize_t bytes = ::read(hNotify, buf, sizeof(buf));
+                if (bytes <= 0)
+                {
+                    if (bytes == 0)
+                        break;
+
+                    const int code      = errno;
+                    if ((code == EAGAIN) || (code == EWOULDBLOCK))
+                        break;
+                    else if (code != EINTR)
+                        return STATUS_IO_ERROR;
+                    continue;
+                }
+
+                for (ssize_t offset = 0; offset < bytes; )
+                {
+                    const struct inotify_event *ev = reinterpret_cast<const struct inotify_event *>(&buf[offset]);
+                    offset             += sizeof(struct inotify_event) + ev->len;
+
+                    status_t res        = process_notify(ev->wd, ev->mask, ev->cookie, (ev->len > 0) ? ev->name : NULL);
+                    if (res != STATUS_OK)
+                        return res;
+
+                    // The watcher could switch to polling mode
+                    if (enMode != MODE_NOTIFY)
+                        return STATUS_OK;
+                }
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::process_notify(int wd, uint32_t mask, uint32_t cookie, const char *name)
+        {
+            // Some events have been lost, directories created meanwhile need to be watched
+            if (mask & IN_Q_OVERFLOW)
+            {
+                drop_events();
+                status_t res        = add_rescan();
+                if ((res == STATUS_OK) && (nFlags & WATCH_RECURSIVE))
+                {
+                    res                 = add_tree("", false);
+                    if (res == STATUS_OVERFLOW)
+                        res                 = start_polling();
+                }
+                return res;
+            }
+
+            const ssize_t index = find_watch(wd);
+            if (index < 0)
+                return STATUS_OK;
+            if (mask & IN_IGNORED)
+            {
+                remove_watch(index);
+                return STATUS_OK;
+            }
+
+            const watch_t *w    = vWatches.uget(index);
+            const bool directory= mask & IN_ISDIR;
+
+            // Event related to the watched directory itself
+            if (name == NULL)
+            {
+                if ((w->sPath[0] == '\0') && (mask & (IN_DELETE_SELF | IN_MOVE_SELF)))
+                    return add_event(dir_event_t::EV_DELETE, "", true);
+                return STATUS_OK;
+            }
+
+            char *path          = join_path(w->sPath, name);
+            if (path == NULL)
+                return STATUS_NO_MEM;
+            lsp_finally { free(path); };
+
+            if (mask & IN_MOVED_FROM)
+                return move_from(path, directory, cookie);
+            if (mask & IN_MOVED_TO)
+                return move_to(path, directory, cookie);
+            if (mask & IN_CREATE)
+            {
+                status_t res        = add_event(dir_event_t::EV_CREATE, path, directory);
+                if ((res == STATUS_OK) && (directory) && (nFlags & WATCH_RECURSIVE))
+                    res                 = watch_subtree(path);
+                return res;
+            }
+            if (mask & IN_DELETE)
+                return add_event(dir_event_t::EV_DELETE, path, directory);
+            if (mask & (IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE))
+                return add_event(dir_event_t::EV_MODIFY, path, directory);
+
+            return STATUS_OK;
+        }
+    #endif /* PLATFORM_LINUX */
+
+        status_t DirWatcher::open(const char *path, size_t flags)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return STATUS_NO_MEM;
+            return open(&tmp, flags);
+        }
+
+        status_t DirWatcher::open(const Path *path, size_t flags)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            return open(path->as_string(), flags);
+        }
+
+        status_t DirWatcher::open(const LSPString *path, size_t flags)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (enMode != MODE_NONE)
+                return STATUS_OPENED;
+
+            // Check that directory exists
+            fattr_t attr;
+            status_t res        = File::stat(path, &attr);
+            if (res != STATUS_OK)
+                return res;
+            if (attr.type != fattr_t::FT_DIRECTORY)
+                return STATUS_NOT_DIRECTORY;
+
+            // Remember the root directory
+            const char *native  = path->get_native();
+            if (native == NULL)
+                return STATUS_NO_MEM;
+            size_t length       = strlen(native);
+            while ((length > 1) && (is_separator(native[length - 1])))
+                --length;
+            if ((sNative = static_cast<char *>(malloc(length + 1))) == NULL)
+                return STATUS_NO_MEM;
+            memcpy(sNative, native, length);
+            sNative[length]     = '\0';
+            if (!sRoot.set(path))
+            {
+                close();
+                return STATUS_NO_MEM;
+            }
+            nFlags              = flags;
+
+        #if defined(PLATFORM_LINUX)
+            // Use notifications if possible, fall back to polling if the system is out of resources
+            if (!(flags & WATCH_POLL))
+            {
+                hNotify             = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                if (hNotify >= 0)
+                {
+                    enMode              = MODE_NOTIFY;
+                    res                 = add_tree("", false);
+                    if (res == STATUS_OK)
+                        return res;
+                    if (res != STATUS_OVERFLOW)
+                    {
+                        close();
+                        return res;
+                    }
+                }
+            }
+        #endif /* PLATFORM_LINUX */
+
+            if ((res = start_polling()) != STATUS_OK)
+                close();
+
+            return res;
+        }
+
+        status_t DirWatcher::close()
+        {
+        #if defined(PLATFORM_LINUX)
+            if (hNotify >= 0)
+            {
+                ::close(hNotify);
+                hNotify             = -1;
+            }
+            for (size_t i=0, n=vWatches.size(); i<n; ++i)
+            {
+                watch_t *w          = vWatches.uget(i);
+                free(w->sPath);
+                free(w);
+            }
+            vWatches.flush();
+        #endif /* PLATFORM_LINUX */
+
+            drop_events();
+            destroy_snapshot(pSnapshot);
+            pSnapshot           = NULL;
+
+            if (sNative != NULL)
+            {
+                free(sNative);
+                sNative             = NULL;
+            }
+            sRoot.truncate();
+            nFlags              = WATCH_NONE;
+            enMode              = MODE_NONE;
+
+            return STATUS_OK;
+        }
+
+        status_t DirWatcher::poll(IDirWatchHandler *handler, size_t timeout)
+        {
+            if (handler == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (enMode == MODE_NONE)
+                return STATUS_CLOSED;
+
+            // Wait for the first event
+            status_t res;
+            system::time_millis_t time          = system::get_time_millis();
+            const system::time_millis_t deadline= time + timeout;
+            while (vEvents.is_empty())
+            {
+                res                 = fetch((time < deadline) ? deadline - time : 0);
+                if ((res != STATUS_OK) && (res != STATUS_TIMED_OUT))
+                    return res;
+
+                time                = system::get_time_millis();
+                if (time >= deadline)
+                    break;
+            }
+            if (vEvents.is_empty())
+                return STATUS_TIMED_OUT;
+
+            // Wait until the burst of events ends
+            if ((enMode == MODE_NOTIFY) && (nCoalesce > 0))
+            {
+                const system::time_millis_t limit   = time + nCoalesce * COALESCE_ROUNDS;
+                while (time < limit)
+                {
+                    res                 = fetch(nCoalesce);
+                    if (res == STATUS_TIMED_OUT)
+                        break;
+                    else if (res != STATUS_OK)
+                        return res;
+                    time                = system::get_time_millis();
+                }
+            }
+
+            return dispatch(handler);
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
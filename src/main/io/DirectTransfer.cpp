@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <private/io/DirectTransfer.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        DirectTransfer::DirectTransfer()
+        {
+            pFD         = NULL;
+            pThread     = NULL;
+            enOp        = OP_NONE;
+            bPending    = false;
+            pBuf        = NULL;
+            nOffset     = 0;
+            nSize       = 0;
+            nResult     = 0;
+        }
+
+        DirectTransfer::~DirectTransfer()
+        {
+            stop();
+        }
+
+        status_t DirectTransfer::start(NativeFile *fd)
+        {
+            if (pThread != NULL)
+                return STATUS_BAD_STATE;
+            else if (fd == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            pFD         = fd;
+            enOp        = OP_NONE;
+            bPending    = false;
+            nResult     = 0;
+
+            ipc::Thread *t  = new ipc::Thread(thread_proc, this);
+            if (t == NULL)
+                return STATUS_NO_MEM;
+
+            status_t res    = t->start();
+            if (res != STATUS_OK)
+            {
+                delete t;
+                return res;
+            }
+            pThread     = t;
+
+            return STATUS_OK;
+        }
+
+        void DirectTransfer::stop()
+        {
+            if (pThread == NULL)
+                return;
+
+            wait();
+
+            sCond.lock();
+            enOp        = OP_EXIT;
+            sCond.notify_all();
+            sCond.unlock();
+
+            pThread->join();
+            delete pThread;
+
+            pThread     = NULL;
+            pFD         = NULL;
+            enOp        = OP_NONE;
+        }
+
+        status_t DirectTransfer::submit(op_t op, void *buf, wsize_t offset, size_t size)
+        {
+            if (pThread == NULL)
+                return STATUS_CLOSED;
+            else if (bPending)
+                return STATUS_BAD_STATE;
+
+            sCond.lock();
+            enOp        = op;
+            pBuf        = static_cast<uint8_t *>(buf);
+            nOffset     = offset;
+            nSize       = size;
+            nResult     = 0;
+            bPending    = true;
+            sCond.notify_all();
+            sCond.unlock();
+
+            return STATUS_OK;
+        }
+
+        ssize_t DirectTransfer::wait()
+        {
+            if (!bPending)
+                return 0;
+
+            sCond.lock();
+            while (enOp != OP_NONE)
+                sCond.wait();
+            const ssize_t res   = nResult;
+            bPending    = false;
+            sCond.unlock();
+
+            return res;
+        }
+
+        status_t DirectTransfer::thread_proc(void *arg)
+        {
+            DirectTransfer *self = static_cast<DirectTransfer *>(arg);
+            self->run();
+            return STATUS_OK;
+        }
+
+        void DirectTransfer::run()
+        {
+            sCond.lock();
+            while (true)
+            {
+                if (enOp == OP_EXIT)
+                    break;
+                if (enOp == OP_NONE)
+                {
+                    sCond.wait();
+                    continue;
+                }
+
+                // Perform the operation outside of the lock
+                const op_t op       = enOp;
+                sCond.unlock();
+
+                ssize_t res         = (op == OP_READ) ?
+                    pFD->pread(nOffset, pBuf, nSize) :
+                    pFD->pwrite(nOffset, pBuf, nSize);
+                if ((op == OP_READ) && (res == -STATUS_EOF))
+                    res                 = 0;
+
+                sCond.lock();
+                nResult             = res;
+                enOp                = OP_NONE;
+                sCond.notify_all();
+            }
+            sCond.unlock();
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -222,7 +222,8 @@ namespace lsp
             #ifdef PLATFORM_WINDOWS
                 WIN32_FIND_DATAW hfi;
 
-                HANDLE dh   = ::FindFirstFileW(path->get_utf16(), &hfi);
+                lsp_utf16_t xbuf[IO_PATH_NATIVE_BUF_SIZE];
+                HANDLE dh   = ::FindFirstFileW(path->to_utf16(xbuf, IO_PATH_NATIVE_BUF_SIZE), &hfi);
                 if (dh == INVALID_HANDLE_VALUE)
                 {
                     DWORD err = ::GetLastError();
@@ -258,7 +259,8 @@ namespace lsp
                 decode_file_type(attr, &hfi);
             #else
                 struct stat sb;
-                const char * const s = path->get_native();
+                char xbuf[IO_PATH_NATIVE_BUF_SIZE];
+                const char * const s = path->to_native(xbuf, sizeof(xbuf));
                 if (::lstat(s, &sb) != 0)
                 {
                     const int code = errno;
@@ -355,7 +357,8 @@ namespace lsp
             #ifdef PLATFORM_WINDOWS
                 WIN32_FIND_DATAW hfi;
 
-                HANDLE dh   = ::FindFirstFileW(path->get_utf16(), &hfi);
+                lsp_utf16_t xbuf[IO_PATH_NATIVE_BUF_SIZE];
+                HANDLE dh   = ::FindFirstFileW(path->to_utf16(xbuf, IO_PATH_NATIVE_BUF_SIZE), &hfi);
                 if (dh == INVALID_HANDLE_VALUE)
                 {
                     DWORD err = ::GetLastError();
@@ -391,7 +394,8 @@ namespace lsp
                 decode_file_type(attr, &hfi);
             #else
                 struct stat sb;
-                const char * const s = path->get_native();
+                char xbuf[IO_PATH_NATIVE_BUF_SIZE];
+                const char * const s = path->to_native(xbuf, sizeof(xbuf));
                 if (::stat(s, &sb) != 0)
                 {
                     const int code = errno;
@@ -440,7 +444,8 @@ namespace lsp
                 return STATUS_BAD_ARGUMENTS;
 
 #ifdef PLATFORM_WINDOWS
-            if (::DeleteFileW(path->get_utf16()))
+            lsp_utf16_t xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            if (::DeleteFileW(path->to_utf16(xbuf, IO_PATH_NATIVE_BUF_SIZE)))
                 return STATUS_OK;
 
             // Analyze error code
@@ -462,7 +467,8 @@ namespace lsp
             }
 #else
             // Try to remove file
-            if (::unlink(path->get_native()) == 0)
+            char xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            if (::unlink(path->to_native(xbuf, sizeof(xbuf))) == 0)
                 return STATUS_OK;
 
             // Analyze error code
@@ -588,7 +594,8 @@ namespace lsp
                 return STATUS_BAD_ARGUMENTS;
 
 #ifdef PLATFORM_WINDOWS
-            if (::MoveFileExW(from->get_utf16(), to->get_utf16(), MOVEFILE_REPLACE_EXISTING))
+            lsp_utf16_t xfrom[IO_PATH_NATIVE_BUF_SIZE], xto[IO_PATH_NATIVE_BUF_SIZE];
+            if (::MoveFileExW(from->to_utf16(xfrom, IO_PATH_NATIVE_BUF_SIZE), to->to_utf16(xto, IO_PATH_NATIVE_BUF_SIZE), MOVEFILE_REPLACE_EXISTING))
                 return STATUS_OK;
 
             // Analyze error code
@@ -604,7 +611,8 @@ namespace lsp
             }
 #else
             // Try to remove file
-            if (::rename(from->get_native(), to->get_native()) == 0)
+            char xfrom[IO_PATH_NATIVE_BUF_SIZE], xto[IO_PATH_NATIVE_BUF_SIZE];
+            if (::rename(from->to_native(xfrom, sizeof(xfrom)), to->to_native(xto, sizeof(xto))) == 0)
                 return STATUS_OK;
 
             switch (errno)
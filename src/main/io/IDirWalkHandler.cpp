@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/IDirWalkHandler.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        IDirWalkHandler::IDirWalkHandler()
+        {
+        }
+
+        IDirWalkHandler::~IDirWalkHandler()
+        {
+        }
+
+        status_t IDirWalkHandler::on_entry(const dir_entry_t *entry)
+        {
+            return STATUS_OK;
+        }
+
+        status_t IDirWalkHandler::on_error(const char *path, status_t code)
+        {
+            return code;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/IDirWatchHandler.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        IDirWatchHandler::IDirWatchHandler()
+        {
+        }
+
+        IDirWatchHandler::~IDirWatchHandler()
+        {
+        }
+
+        status_t IDirWatchHandler::on_event(const dir_event_t *event)
+        {
+            return STATUS_OK;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -86,6 +86,16 @@ namespace lsp
             return set_error(STATUS_NOT_SUPPORTED);
         }
 
+        status_t IInSequence::peek_span(const lsp_wchar_t **ptr, size_t *len)
+        {
+            return set_error(STATUS_NOT_SUPPORTED);
+        }
+
+        ssize_t IInSequence::consume(size_t count)
+        {
+            return skip(count);
+        }
+
         wssize_t IInSequence::sink(IOutSequence *os, size_t buf_size)
         {
             if ((os == NULL) || (buf_size < 1))
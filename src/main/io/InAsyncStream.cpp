@@ -0,0 +1,497 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InAsyncStream.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        //---------------------------------------------------------------------
+        InAsyncStream::FillTask::FillTask(InAsyncStream *stream)
+        {
+            pStream     = stream;
+        }
+
+        InAsyncStream::FillTask::~FillTask()
+        {
+            pStream     = NULL;
+        }
+
+        status_t InAsyncStream::FillTask::run()
+        {
+            pStream->run_task();
+            return STATUS_OK;
+        }
+
+        //---------------------------------------------------------------------
+        InAsyncStream::InAsyncStream(ipc::IExecutor *executor):
+            sTask(this)
+        {
+            pIS         = NULL;
+            nWrapFlags  = 0;
+            pExecutor   = executor;
+            pThread     = NULL;
+            pData       = NULL;
+            vBuffers    = NULL;
+            nDepth      = 0;
+            nBufSize    = 0;
+            nHead       = 0;
+            nFilled     = 0;
+            nOffset     = 0;
+            nPosition   = 0;
+            nFillStatus = STATUS_OK;
+            bActive     = false;
+            bBusy       = false;
+            bStop       = true;
+        }
+
+        InAsyncStream::~InAsyncStream()
+        {
+            do_close();
+        }
+
+        status_t InAsyncStream::do_close()
+        {
+            status_t res = STATUS_OK;
+
+            stop();
+
+            if (pIS != NULL)
+            {
+                if (nWrapFlags & WRAP_CLOSE)
+                    res = pIS->close();
+                if (nWrapFlags & WRAP_DELETE)
+                    delete pIS;
+                pIS         = NULL;
+            }
+            nWrapFlags  = 0;
+
+            if (pData != NULL)
+            {
+                free(pData);
+                pData       = NULL;
+            }
+            vBuffers    = NULL;
+            nDepth      = 0;
+            nBufSize    = 0;
+            reset();
+
+            return res;
+        }
+
+        status_t InAsyncStream::close()
+        {
+            return set_error(do_close());
+        }
+
+        status_t InAsyncStream::wrap(IInStream *is, size_t flags, size_t depth, size_t buf_size)
+        {
+            if (pIS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if ((is == NULL) || (depth < 1) || (buf_size < 1))
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            // Allocate ring of buffers
+            const size_t hdr_size   = align_size(sizeof(buffer_t) * depth, DEFAULT_ALIGN);
+            uint8_t *ptr            = static_cast<uint8_t *>(malloc(hdr_size + depth * buf_size));
+            if (ptr == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            buffer_t *vb            = reinterpret_cast<buffer_t *>(ptr);
+            for (size_t i=0; i<depth; ++i)
+            {
+                vb[i].data              = &ptr[hdr_size + i * buf_size];
+                vb[i].size              = 0;
+            }
+
+            const wssize_t pos      = is->position();
+
+            pIS         = is;
+            nWrapFlags  = flags;
+            pData       = ptr;
+            vBuffers    = vb;
+            nDepth      = depth;
+            nBufSize    = buf_size;
+            reset();
+            nPosition   = (pos >= 0) ? pos : 0;
+
+            // Start read-ahead
+            start();
+
+            return set_error(STATUS_OK);
+        }
+
+        void InAsyncStream::reset()
+        {
+            nHead       = 0;
+            nFilled     = 0;
+            nOffset     = 0;
+            nFillStatus = STATUS_OK;
+        }
+
+        void InAsyncStream::start()
+        {
+            if (pExecutor != NULL)
+            {
+                sCond.lock();
+                bStop       = false;
+                kick();
+                sCond.unlock();
+                return;
+            }
+
+            // Keep read-ahead stopped if the thread can not be started, all data
+            // will be read on the caller's thread
+            ipc::Thread *t  = new ipc::Thread(thread_proc, this);
+            if (t == NULL)
+                return;
+
+            bStop       = false;
+            if (t->start() != STATUS_OK)
+            {
+                bStop       = true;
+                delete t;
+                return;
+            }
+            pThread     = t;
+        }
+
+        void InAsyncStream::stop()
+        {
+            sCond.lock();
+            bStop       = true;
+            sCond.notify_all();
+            while (bActive)
+                sCond.wait();
+            sCond.unlock();
+
+            if (pThread != NULL)
+            {
+                pThread->join();
+                delete pThread;
+                pThread     = NULL;
+            }
+
+            // The task may still be finishing after it has released the stream
+            while (sTask.running())
+                ipc::Thread::yield();
+        }
+
+        void InAsyncStream::acquire()
+        {
+            sCond.lock();
+            while (bBusy)
+                sCond.wait();
+            bBusy       = true;
+            sCond.unlock();
+        }
+
+        void InAsyncStream::release()
+        {
+            sCond.lock();
+            bBusy       = false;
+            if (pExecutor != NULL)
+                kick();
+            sCond.notify_all();
+            sCond.unlock();
+        }
+
+        status_t InAsyncStream::thread_proc(void *arg)
+        {
+            InAsyncStream *self = static_cast<InAsyncStream *>(arg);
+            self->run_thread();
+            return STATUS_OK;
+        }
+
+        void InAsyncStream::run_thread()
+        {
+            sCond.lock();
+            while (!bStop)
+            {
+                if (!fill())
+                    sCond.wait();
+            }
+            sCond.unlock();
+        }
+
+        void InAsyncStream::run_task()
+        {
+            sCond.lock();
+            while ((!bStop) && (fill()))
+                /* nothing */ ;
+            bActive     = false;
+            sCond.notify_all();
+            sCond.unlock();
+        }
+
+        bool InAsyncStream::fill()
+        {
+            if ((bBusy) || (nFillStatus != STATUS_OK) || (nFilled >= nDepth))
+                return false;
+
+            // The consumer does not access the buffer that follows the filled ones
+            buffer_t *buf       = &vBuffers[(nHead + nFilled) % nDepth];
+
+            bBusy               = true;
+            sCond.unlock();
+            const ssize_t res   = pIS->read(buf->data, nBufSize);
+            sCond.lock();
+            bBusy               = false;
+
+            if (res > 0)
+            {
+                buf->size           = res;
+                ++nFilled;
+            }
+            else
+                nFillStatus         = (res < 0) ? status_t(-res) : STATUS_EOF;
+            sCond.notify_all();
+
+            return true;
+        }
+
+        void InAsyncStream::kick()
+        {
+            if ((bActive) || (bStop) || (nFillStatus != STATUS_OK) || (nFilled >= nDepth))
+                return;
+
+            // The task may still be finishing, it will be submitted on the next call
+            if (sTask.completed())
+                sTask.reset();
+            if ((sTask.idle()) && (pExecutor->submit(&sTask)))
+                bActive     = true;
+        }
+
+        void InAsyncStream::advance()
+        {
+            nHead       = (nHead + 1) % nDepth;
+            nOffset     = 0;
+            --nFilled;
+
+            if (pExecutor != NULL)
+                kick();
+            else
+                sCond.notify_all();
+        }
+
+        status_t InAsyncStream::wait_data()
+        {
+            while (nFilled <= 0)
+            {
+                if (nFillStatus != STATUS_OK)
+                    return nFillStatus;
+
+                // Wait for the read-ahead to complete reading or read on the caller's thread
+                if (bBusy)
+                    sCond.wait();
+                else
+                    fill();
+            }
+
+            return STATUS_OK;
+        }
+
+        wsize_t InAsyncStream::consume(wsize_t amount)
+        {
+            wsize_t done = 0;
+            while ((amount > 0) && (nFilled > 0))
+            {
+                const buffer_t *buf = &vBuffers[nHead];
+                size_t n            = buf->size - nOffset;
+                if (n > amount)
+                    n                   = amount;
+
+                nOffset            += n;
+                nPosition          += n;
+                amount             -= n;
+                done               += n;
+                if (nOffset >= buf->size)
+                    advance();
+            }
+            return done;
+        }
+
+        wssize_t InAsyncStream::avail()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            sCond.lock();
+            wsize_t res = 0;
+            for (size_t i=0; i<nFilled; ++i)
+                res        += vBuffers[(nHead + i) % nDepth].size;
+            res        -= nOffset;
+            sCond.unlock();
+
+            set_error(STATUS_OK);
+            return res;
+        }
+
+        wssize_t InAsyncStream::position()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+            set_error(STATUS_OK);
+            return nPosition;
+        }
+
+        ssize_t InAsyncStream::read(void *dst, size_t count)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            uint8_t *ptr    = static_cast<uint8_t *>(dst);
+            size_t done     = 0;
+
+            sCond.lock();
+            while (done < count)
+            {
+                // Return the available data instead of waiting for more
+                if (nFilled <= 0)
+                {
+                    if (done > 0)
+                        break;
+
+                    status_t res = wait_data();
+                    if (res != STATUS_OK)
+                    {
+                        sCond.unlock();
+                        return -set_error(res);
+                    }
+                }
+
+                // The head buffer is owned by the consumer until it is released
+                const buffer_t *buf = &vBuffers[nHead];
+                size_t n            = buf->size - nOffset;
+                if (n > (count - done))
+                    n                   = count - done;
+
+                sCond.unlock();
+                memcpy(&ptr[done], &buf->data[nOffset], n);
+                sCond.lock();
+
+                nOffset            += n;
+                nPosition          += n;
+                done               += n;
+                if (nOffset >= buf->size)
+                    advance();
+            }
+            sCond.unlock();
+
+            set_error(STATUS_OK);
+            return done;
+        }
+
+        wssize_t InAsyncStream::seek(wsize_t position)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            // Seek backward within the buffer being consumed
+            if ((position < nPosition) && ((nPosition - position) <= nOffset))
+            {
+                nOffset        -= nPosition - position;
+                nPosition       = position;
+                set_error(STATUS_OK);
+                return nPosition;
+            }
+
+            // Seek forward within the data that has been read ahead
+            if (position >= nPosition)
+            {
+                sCond.lock();
+                consume(position - nPosition);
+                sCond.unlock();
+                if (position == nPosition)
+                {
+                    set_error(STATUS_OK);
+                    return nPosition;
+                }
+            }
+
+            // Drop the read-ahead data and seek the wrapped stream
+            acquire();
+            wssize_t res    = pIS->seek(position);
+            if (res >= 0)
+            {
+                sCond.lock();
+                reset();
+                nPosition       = res;
+                sCond.unlock();
+            }
+            release();
+
+            if (res < 0)
+                return -set_error(status_t(-res));
+
+            set_error(STATUS_OK);
+            return res;
+        }
+
+        wssize_t InAsyncStream::skip(wsize_t amount)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            // Skip the data that has been read ahead
+            sCond.lock();
+            wsize_t left    = amount - consume(amount);
+            sCond.unlock();
+            if (left <= 0)
+            {
+                set_error(STATUS_OK);
+                return amount;
+            }
+
+            // Skip the rest of data in the wrapped stream
+            acquire();
+            sCond.lock();
+            left           -= consume(left);
+            const status_t status = nFillStatus;
+            sCond.unlock();
+
+            if ((left > 0) && (status == STATUS_OK))
+            {
+                wssize_t res    = pIS->skip(left);
+                sCond.lock();
+                if (res > 0)
+                {
+                    left           -= res;
+                    nPosition      += res;
+                }
+                else
+                    nFillStatus     = (res < 0) ? status_t(-res) : STATUS_EOF;
+                sCond.unlock();
+            }
+            release();
+
+            if (left >= amount)
+                return -set_error((nFillStatus != STATUS_OK) ? nFillStatus : STATUS_EOF);
+
+            set_error(STATUS_OK);
+            return amount - left;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -22,13 +22,38 @@
 #include <lsp-plug.in/common/endian.h>
 #include <lsp-plug.in/io/InBitStream.h>
 #include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
 
 namespace lsp
 {
     namespace io
     {
-        static constexpr size_t BITSTREAM_BUFSZ     = sizeof(umword_t) * 8;
+        static constexpr size_t BITSTREAM_BUFSZ     = sizeof(uint64_t) * 8;
         static constexpr size_t BITSTREAM_BUFSZ32   = sizeof(uint32_t) * 8;
+        static constexpr size_t BITSTREAM_FETCH     = BITSTREAM_BUFSZ - 8;  // Guaranteed number of bits after fill()
+        static constexpr size_t BITSTREAM_DATASZ    = 0x1000;               // Size of read-ahead buffer
+
+        static inline uint64_t load_be64(const uint8_t *p)
+        {
+            uint64_t v;
+            memcpy(&v, p, sizeof(v));
+            return BE_TO_CPU(v);
+        }
+
+        /**
+         * Refill the bit cache with the whole word, at least 8 bytes should be available
+         * in the buffer. Loads the word and accounts only bytes that completely fit into
+         * the cache. Bits of the next partially loaded byte are the same as further loaded,
+         * so they will be just overwritten by the same values with the next refill.
+         * After the call the cache contains at least BITSTREAM_FETCH bits.
+         */
+        static inline void refill(uint64_t & buf, size_t & nbits, size_t & off, const uint8_t *data)
+        {
+            buf            |= load_be64(&data[off]) >> nbits;
+            off            += (BITSTREAM_BUFSZ - 1 - nbits) >> 3;
+            nbits          |= BITSTREAM_FETCH;
+        }
 
         InBitStream::InBitStream()
         {
@@ -36,6 +61,9 @@ namespace lsp
             nWrapFlags  = 0;
             nBuffer     = 0;
             nBits       = 0;
+            vData       = NULL;
+            nDataOff    = 0;
+            nDataSize   = 0;
         }
 
         InBitStream::~InBitStream()
@@ -189,11 +217,21 @@ namespace lsp
             else if (is == NULL)
                 return set_error(STATUS_BAD_ARGUMENTS);
 
+            // Allocate read-ahead buffer
+            if (vData == NULL)
+            {
+                vData       = static_cast<uint8_t *>(malloc(BITSTREAM_DATASZ));
+                if (vData == NULL)
+                    return set_error(STATUS_NO_MEM);
+            }
+
             // Store pointers
             pIS         = is;
             nWrapFlags  = flags;
             nBuffer     = 0;
             nBits       = 0;
+            nDataOff    = 0;
+            nDataSize   = 0;
 
             return set_error(STATUS_OK);
         }
@@ -213,9 +251,17 @@ namespace lsp
                 pIS         = NULL;
             }
 
+            if (vData != NULL)
+            {
+                free(vData);
+                vData       = NULL;
+            }
+
             nWrapFlags  = 0;
             nBuffer     = 0;
             nBits       = 0;
+            nDataOff    = 0;
+            nDataSize   = 0;
 
             return res;
         }
@@ -225,20 +271,95 @@ namespace lsp
             return set_error(do_close());
         }
 
+        static inline uint64_t take_bits(uint64_t & buf, size_t & nbits, size_t bits)
+        {
+            // Double shift allows to take zero bits without undefined behaviour
+            const uint64_t v    = (buf >> 1) >> (BITSTREAM_BUFSZ - 1 - bits);
+            buf               <<= bits;
+            nbits              -= bits;
+            return v;
+        }
+
         ssize_t InBitStream::read(void *dst, size_t count)
         {
-            ssize_t nread   = bread(dst, count * 8);
-            if (nread < 0)
-                return nread;
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            uint8_t *p          = reinterpret_cast<uint8_t *>(dst);
+            size_t done         = 0;
+            status_t res        = STATUS_OK;
 
-            // Need to unget something?
-            if (nread & 7)
+            // Not aligned to byte boundary? Extract bytes from the bit cache
+            if (nBits & 7)
             {
-                uint8_t *p      = reinterpret_cast<uint8_t *>(dst);
-                unread(p[nread >> 3], nread & 7);
+                while (done < count)
+                {
+                    if ((nBits < 8) && (((res = fill()) != STATUS_OK) || (nBits < 8)))
+                        break;
+
+                    for (size_t n = lsp_min(count - done, nBits >> 3); n > 0; --n)
+                        p[done++]       = uint8_t(take_bits(nBuffer, nBits, 8));
+                }
+
+                if (done > 0)
+                {
+                    set_error(STATUS_OK);
+                    return done;
+                }
+                return -set_error((res != STATUS_OK) ? res : STATUS_EOF);
+            }
+
+            // Drain the bit cache
+            while ((nBits > 0) && (done < count))
+                p[done++]       = uint8_t(take_bits(nBuffer, nBits, 8));
+            if (nBits > 0)
+            {
+                set_error(STATUS_OK);
+                return done;
             }
+            nBuffer             = 0;
+
+            while (done < count)
+            {
+                // Copy data from the read-ahead buffer
+                const size_t avail  = nDataSize - nDataOff;
+                if (avail > 0)
+                {
+                    const size_t n      = lsp_min(avail, count - done);
+                    memcpy(&p[done], &vData[nDataOff], n);
+                    nDataOff           += n;
+                    done               += n;
+                    continue;
+                }
+
+                // Read large blocks directly, otherwise fill the read-ahead buffer
+                ssize_t n;
+                if ((count - done) >= BITSTREAM_DATASZ)
+                {
+                    if ((n = pIS->read(&p[done], count - done)) > 0)
+                        done               += n;
+                }
+                else
+                {
+                    nDataOff            = 0;
+                    nDataSize           = 0;
+                    if ((n = pIS->read(vData, BITSTREAM_DATASZ)) > 0)
+                        nDataSize           = n;
+                }
 
-            return nread >> 3;
+                if (n <= 0)
+                {
+                    res                 = (n < 0) ? status_t(-n) : STATUS_EOF;
+                    break;
+                }
+            }
+
+            if (done > 0)
+            {
+                set_error(STATUS_OK);
+                return done;
+            }
+            return -set_error(res);
         }
 
         ssize_t InBitStream::bread(void *buf, size_t bits)
@@ -247,27 +368,34 @@ namespace lsp
                 return -set_error(STATUS_CLOSED);
 
             uint8_t *dst        = reinterpret_cast<uint8_t *>(buf);
+            const size_t bytes  = bits >> 3;
             size_t nread        = 0;
 
-            while (nread < bits)
+            // Read whole bytes
+            if (bytes > 0)
             {
-                size_t to_read      = lsp_min(bits - nread, 8u);
-                ssize_t n           = readv(dst++, to_read);
+                const ssize_t n     = read(dst, bytes);
                 if (n < 0)
-                {
-                    if (nread > 0)
-                        break;
-                    set_error(status_t(-n));
                     return n;
-                }
+                nread               = n;
+            }
 
-                nread              += n;
-                if (n < 8)
-                    break;
+            // Read the tail
+            size_t done         = nread << 3;
+            if (done < bits)
+            {
+                const ssize_t n     = readv(&dst[nread], lsp_min(bits - done, size_t(8)));
+                if (n < 0)
+                {
+                    if (done <= 0)
+                        return n;
+                }
+                else
+                    done               += n;
             }
 
             set_error(STATUS_OK);
-            return nread;
+            return done;
         }
 
         wssize_t InBitStream::bskip(wsize_t amount)
@@ -275,31 +403,37 @@ namespace lsp
             if (pIS == NULL)
                 return -set_error(STATUS_CLOSED);
 
-            wsize_t skipped = 0;
-
             // Simple skip?
             if (amount <= nBits)
             {
-                nBuffer   <<= amount;
-                nBits      -= amount;
+                take_bits(nBuffer, nBits, amount >> 1);
+                take_bits(nBuffer, nBits, amount - (amount >> 1));
+                set_error(STATUS_OK);
                 return amount;
             }
-            else
-            {
-                skipped     = nBits;
-                nBits       = 0;
-                amount     -= skipped;
-            }
 
-            // Can skip bytes?
-            wssize_t bytes  = amount >> 3;
+            // Drop the bit cache
+            wsize_t skipped = nBits;
+            amount         -= nBits;
+            nBuffer         = 0;
+            nBits           = 0;
+
+            // Skip bytes stored in the read-ahead buffer
+            wsize_t bytes   = lsp_min(amount >> 3, wsize_t(nDataSize - nDataOff));
+            nDataOff       += bytes;
+            skipped        += bytes << 3;
+            amount         -= bytes << 3;
+
+            // Skip bytes of the underlying stream
+            bytes           = amount >> 3;
             while (bytes > 0)
             {
                 wssize_t n  = pIS->skip(bytes);
-                if (n < 0)
+                if (n <= 0)
                 {
                     if (skipped > 0)
                         break;
+                    n           = (n < 0) ? n : -STATUS_EOF;
                     set_error(status_t(-n));
                     return n;
                 }
@@ -309,34 +443,51 @@ namespace lsp
             }
 
             // Tail left?
-            if (amount > 0)
+            if ((amount > 0) && (amount < 8))
             {
-                umword_t v;
+                uint8_t v;
                 ssize_t n   = readv(&v, amount);
-                if ((n < 0) && (skipped <= 0))
-                {
-                    set_error(status_t(-n));
+                if (n > 0)
+                    skipped    += n;
+                else if (skipped <= 0)
                     return n;
-                }
             }
 
             set_error(STATUS_OK);
             return skipped;
         }
 
-        ssize_t InBitStream::readb(bool *value)
+        ssize_t InBitStream::read_bits(uint64_t *value, size_t bits)
         {
-            status_t res;
-            if (pIS == NULL)
-                return -set_error(STATUS_CLOSED);
+            if (nBits >= bits)
+            {
+                // Enough bits in the cache
+            }
+            else if ((nDataSize - nDataOff) >= sizeof(uint64_t))
+                refill(nBuffer, nBits, nDataOff, vData);
+            else
+            {
+                status_t res = fill();
+                if (res != STATUS_OK)
+                    return -set_error(res);
+                bits        = lsp_min(bits, nBits);
+            }
 
-            // Fill buffer with new data
-            if ((res = fill()) != STATUS_OK)
-                return -set_error(res);
+            *value      = take_bits(nBuffer, nBits, bits);
+            set_error(STATUS_OK);
+            return bits;
+        }
 
-            *value      = nBuffer >> (BITSTREAM_BUFSZ - 1);
-            nBuffer   <<= 1;
-            --nBits;
+        ssize_t InBitStream::readb(bool *value)
+        {
+            if (nBits <= 0)
+            {
+                status_t res = fill();
+                if (res != STATUS_OK)
+                    return -set_error(res);
+            }
+
+            *value      = take_bits(nBuffer, nBits, 1);
 
             set_error(STATUS_OK);
             return 1;
@@ -344,8 +495,8 @@ namespace lsp
 
         ssize_t InBitStream::readv(uint8_t *value, size_t bits)
         {
-            umword_t v;
-            ssize_t n = readv(&v, bits);
+            uint64_t v;
+            ssize_t n = read_bits(&v, lsp_min(bits, sizeof(uint8_t) * 8));
             if (n > 0)
                 *value      = uint8_t(v);
             return n;
@@ -353,103 +504,299 @@ namespace lsp
 
         ssize_t InBitStream::readv(uint16_t *value, size_t bits)
         {
-            umword_t v;
-            ssize_t n = readv(&v, bits);
+            uint64_t v;
+            ssize_t n = read_bits(&v, lsp_min(bits, sizeof(uint16_t) * 8));
             if (n > 0)
                 *value      = uint16_t(v);
             return n;
         }
 
         ssize_t InBitStream::readv(uint32_t *value, size_t bits)
+        {
+            uint64_t v;
+            ssize_t n = read_bits(&v, lsp_min(bits, BITSTREAM_BUFSZ32));
+            if (n > 0)
+                *value      = uint32_t(v);
+            return n;
+        }
+
+        ssize_t InBitStream::readv(uint64_t *value, size_t bits)
+        {
+            bits            = lsp_min(bits, BITSTREAM_BUFSZ);
+            if (bits <= BITSTREAM_FETCH)
+                return read_bits(value, bits);
+
+            // Read high part and low part
+            uint64_t hi, lo;
+            ssize_t nhi     = read_bits(&hi, bits - BITSTREAM_BUFSZ32);
+            if (nhi < ssize_t(bits - BITSTREAM_BUFSZ32))
+            {
+                if (nhi > 0)
+                    *value          = hi;
+                return nhi;
+            }
+
+            ssize_t nlo     = read_bits(&lo, BITSTREAM_BUFSZ32);
+            if (nlo <= 0)
+            {
+                *value          = hi;
+                set_error(STATUS_OK);
+                return nhi;
+            }
+
+            *value          = (hi << nlo) | lo;
+            return nhi + nlo;
+        }
+
+        template <class T>
+        ssize_t InBitStream::read_array(T *dst, size_t count, size_t bits)
         {
             if (pIS == NULL)
                 return -set_error(STATUS_CLOSED);
 
-            size_t nread    = 0;
-            status_t res;
-            uint32_t v      = 0;
+            bits            = lsp_min(bits, sizeof(T) * 8);
+            if (bits <= 0)
+            {
+                for (size_t i=0; i<count; ++i)
+                    dst[i]          = 0;
+                set_error(STATUS_OK);
+                return count;
+            }
 
-            while (nread < bits)
+            // Wide values are read using two steps
+            size_t done     = 0;
+            status_t res    = STATUS_OK;
+            if (bits > BITSTREAM_FETCH)
             {
-                // Fill buffer with new data
-                if ((res = fill()) != STATUS_OK)
+                for ( ; done < count; ++done)
                 {
-                    if (nread > 0)
-                        break;
-                    return -set_error(res);
+                    // Ensure that the whole value is available before consuming it
+                    if ((nBits + ((nDataSize - nDataOff) << 3)) < bits)
+                    {
+                        res         = fetch();
+                        if ((nBits + ((nDataSize - nDataOff) << 3)) < bits)
+                        {
+                            if (res == STATUS_OK)
+                                res         = STATUS_EOF;
+                            break;
+                        }
+                    }
+
+                    uint64_t v;
+                    readv(&v, bits);
+                    dst[done]       = T(v);
+                }
+            }
+            else
+            {
+                // Keep the state in local variables to avoid memory round trips
+                uint64_t buf    = nBuffer;
+                size_t nbits    = nBits;
+                size_t off      = nDataOff;
+
+                for ( ; done < count; ++done)
+                {
+                    if ((nDataSize - off) >= sizeof(uint64_t))
+                        refill(buf, nbits, off, vData);
+                    else if (nbits < bits)
+                    {
+                        nBuffer         = buf;
+                        nBits           = nbits;
+                        nDataOff        = off;
+                        res             = fill();
+                        buf             = nBuffer;
+                        nbits           = nBits;
+                        off             = nDataOff;
+                        if ((res != STATUS_OK) || (nbits < bits))
+                            break;
+                    }
+
+                    dst[done]       = T(take_bits(buf, nbits, bits));
                 }
 
-                // Estimate number of bits to read
-                const size_t to_read= lsp_min(nBits, bits - nread);
-                uint32_t x          = uint32_t(nBuffer >> (BITSTREAM_BUFSZ - to_read));
-                v                   = (to_read < BITSTREAM_BUFSZ32) ? uint32_t((v << to_read) | x) : x;
-                nBuffer           <<= to_read;
-                nBits              -= to_read;
-                nread              += to_read;
+                nBuffer         = buf;
+                nBits           = nbits;
+                nDataOff        = off;
             }
 
-            *value          = v;
-            set_error(STATUS_OK);
-            return nread;
+            if ((done > 0) || (count <= 0))
+            {
+                set_error(STATUS_OK);
+                return done;
+            }
+
+            return -set_error((res != STATUS_OK) ? res : STATUS_EOF);
         }
 
-        ssize_t InBitStream::readv(uint64_t *value, size_t bits)
+        ssize_t InBitStream::readn(uint8_t *dst, size_t count, size_t bits)
+        {
+            return read_array(dst, count, bits);
+        }
+
+        ssize_t InBitStream::readn(uint16_t *dst, size_t count, size_t bits)
+        {
+            return read_array(dst, count, bits);
+        }
+
+        ssize_t InBitStream::readn(uint32_t *dst, size_t count, size_t bits)
+        {
+            return read_array(dst, count, bits);
+        }
+
+        ssize_t InBitStream::readn(uint64_t *dst, size_t count, size_t bits)
+        {
+            return read_array(dst, count, bits);
+        }
+
+        template <class T>
+        ssize_t InBitStream::read_varint(T *dst, size_t count, size_t bits, size_t step)
         {
             if (pIS == NULL)
                 return -set_error(STATUS_CLOSED);
+            if ((bits <= 0) && (step <= 0))
+                return -set_error(STATUS_BAD_ARGUMENTS);
 
-            size_t nread    = 0;
-            status_t res;
-            uint64_t v      = 0;
+            size_t done     = 0;
+            status_t res    = STATUS_OK;
+
+            // Keep the state in local variables to avoid memory round trips
+            uint64_t buf    = nBuffer;
+            size_t nbits    = nBits;
+            size_t off      = nDataOff;
 
-            while (nread < bits)
+            for ( ; done < count; ++done)
             {
-                // Fill buffer with new data
-                if ((res = fill()) != STATUS_OK)
+                uint64_t value  = 0;
+                size_t shift    = 0;
+                size_t width    = bits;
+
+                while (true)
                 {
-                    if (nread > 0)
+                    // Each group consists of the continuation flag and data bits
+                    const size_t group  = width + 1;
+                    if (group > BITSTREAM_FETCH)
+                    {
+                        res             = STATUS_CORRUPTED;
                         break;
-                    return -set_error(res);
+                    }
+
+                    if (nbits >= group)
+                    {
+                        // Enough bits in the cache
+                    }
+                    else if ((nDataSize - off) >= sizeof(uint64_t))
+                        refill(buf, nbits, off, vData);
+                    else
+                    {
+                        const size_t avail  = nbits;
+                        nBuffer         = buf;
+                        nBits           = nbits;
+                        nDataOff        = off;
+                        res             = fill();
+                        buf             = nBuffer;
+                        nbits           = nBits;
+                        off             = nDataOff;
+
+                        if (res != STATUS_OK)
+                        {
+                            // End of stream is allowed only at the boundary of the value
+                            if ((shift > 0) || (avail > 0))
+                                res             = STATUS_CORRUPTED;
+                            break;
+                        }
+                        if (nbits < group)
+                        {
+                            res             = STATUS_CORRUPTED;
+                            break;
+                        }
+                    }
+
+                    const uint64_t g    = take_bits(buf, nbits, group);
+                    if (shift < BITSTREAM_BUFSZ)
+                        value              |= (g & ((uint64_t(1) << width) - 1)) << shift;
+                    if (!(g >> width))
+                        break;
+
+                    shift              += width;
+                    width              += step;
                 }
 
-                // Estimate number of bits to read
-                size_t to_read      = lsp_min(nBits, bits - nread);
-                v                   = (to_read < BITSTREAM_BUFSZ) ? (v << to_read) | (nBuffer >> (BITSTREAM_BUFSZ - to_read)) : nBuffer;
-                nBuffer           <<= to_read;
-                nBits              -= to_read;
-                nread              += to_read;
+                if (res != STATUS_OK)
+                    break;
+                dst[done]       = T(value);
             }
 
-            *value          = v;
-            set_error(STATUS_OK);
-            return nread;
+            nBuffer         = buf;
+            nBits           = nbits;
+            nDataOff        = off;
+
+            if ((done > 0) || (count <= 0))
+            {
+                set_error(STATUS_OK);
+                return done;
+            }
+
+            return -set_error(res);
         }
 
-        void InBitStream::unread(umword_t v, size_t bits)
+        ssize_t InBitStream::readvar(uint32_t *dst, size_t count, size_t bits, size_t step)
         {
-            if (bits < BITSTREAM_BUFSZ)
-                v         <<= BITSTREAM_BUFSZ - bits;
-            nBuffer     = (nBuffer >> bits) | v;
-            nBits      += bits;
+            return read_varint(dst, count, bits, step);
         }
 
-        status_t InBitStream::fill()
+        ssize_t InBitStream::readvar(uint64_t *dst, size_t count, size_t bits, size_t step)
         {
-            if (nBits > 0)
-                return STATUS_OK;
+            return read_varint(dst, count, bits, step);
+        }
 
-            nBuffer     = 0;
-            ssize_t n   = pIS->read(&nBuffer, sizeof(umword_t));
-            if (n <= 0)
-                return status_t(-n);
+        status_t InBitStream::fetch()
+        {
+            if (pIS == NULL)
+                return STATUS_CLOSED;
+
+            // Move the pending data to the beginning of the buffer
+            const size_t avail  = nDataSize - nDataOff;
+            if ((avail > 0) && (nDataOff > 0))
+                memmove(vData, &vData[nDataOff], avail);
+            nDataOff            = 0;
+            nDataSize           = avail;
 
-            nBits       = n << 3;
-            nBuffer     = BE_TO_CPU(nBuffer);
+            // Read data until there is enough data for the word-sized refill
+            while (nDataSize < sizeof(uint64_t))
+            {
+                const ssize_t n     = pIS->read(&vData[nDataSize], BITSTREAM_DATASZ - nDataSize);
+                if (n <= 0)
+                    return (n < 0) ? status_t(-n) : STATUS_EOF;
+                nDataSize          += n;
+            }
 
             return STATUS_OK;
         }
 
-    } /* namespace io */
-} /* namespace lsp */
+        status_t InBitStream::fill()
+        {
+            // Called only if there are not enough bits in the cache, so nBits < BITSTREAM_FETCH.
+            // After the call the cache contains at least BITSTREAM_FETCH bits and at most
+            // BITSTREAM_BUFSZ - 1 bits if there is enough data in the stream.
+            status_t res        = STATUS_OK;
+            if ((nDataSize - nDataOff) < sizeof(uint64_t))
+                res                 = fetch();
+
+            if ((nDataSize - nDataOff) >= sizeof(uint64_t))
+            {
+                refill(nBuffer, nBits, nDataOff, vData);
+                return STATUS_OK;
+            }
+
+            // Less than a word is available at the end of the stream, load by bytes
+            while ((nBits < BITSTREAM_FETCH) && (nDataOff < nDataSize))
+            {
+                nBuffer            |= uint64_t(vData[nDataOff++]) << (BITSTREAM_FETCH - nBits);
+                nBits              += 8;
+            }
 
+            return (nBits > 0) ? STATUS_OK : res;
+        }
 
+    } /* namespace io */
+} /* namespace lsp */
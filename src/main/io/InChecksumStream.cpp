@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InChecksumStream.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        InChecksumStream::InChecksumStream(checksum_t type, uint64_t seed):
+            sChecksum(type, seed)
+        {
+            pIS         = NULL;
+            nWrapFlags  = 0;
+        }
+
+        InChecksumStream::~InChecksumStream()
+        {
+            do_close();
+        }
+
+        status_t InChecksumStream::do_close()
+        {
+            status_t res = STATUS_OK;
+
+            if (pIS != NULL)
+            {
+                if (nWrapFlags & WRAP_CLOSE)
+                    res = pIS->close();
+                if (nWrapFlags & WRAP_DELETE)
+                    delete pIS;
+                pIS         = NULL;
+            }
+            nWrapFlags  = 0;
+
+            return res;
+        }
+
+        status_t InChecksumStream::close()
+        {
+            return set_error(do_close());
+        }
+
+        status_t InChecksumStream::wrap(IInStream *is, size_t flags)
+        {
+            if (pIS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (is == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            pIS         = is;
+            nWrapFlags  = flags;
+            sChecksum.reset();
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t InChecksumStream::set_checksum(checksum_t type, uint64_t seed)
+        {
+            if (pIS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            return set_error(sChecksum.init(type, seed));
+        }
+
+        wssize_t InChecksumStream::avail()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+            wssize_t res = pIS->avail();
+            set_error((res < 0) ? status_t(-res) : STATUS_OK);
+            return res;
+        }
+
+        wssize_t InChecksumStream::position()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+            wssize_t res = pIS->position();
+            set_error((res < 0) ? status_t(-res) : STATUS_OK);
+            return res;
+        }
+
+        ssize_t InChecksumStream::read(void *dst, size_t count)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            ssize_t res = pIS->read(dst, count);
+            if (res > 0)
+                sChecksum.update(dst, res);
+            set_error((res < 0) ? status_t(-res) : STATUS_OK);
+            return res;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
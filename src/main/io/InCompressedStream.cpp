@@ -0,0 +1,490 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InCompressedStream.h>
+#include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/io/Checksum.h>
+#include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/resource/codec.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/io/compressed.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        InCompressedStream::InCompressedStream()
+        {
+            pIS         = NULL;
+            nWrapFlags  = 0;
+            vBlock      = NULL;
+            vPayload    = NULL;
+            nLogBlock   = compressed::LOG_BLOCK_DFL;
+            nBlockSize  = 0;
+            nBlockOff   = 0;
+            nBlockStart = 0;
+            nCurrent    = -1;
+            nBase       = 0;
+            nInPos      = 0;
+            bEOF        = false;
+        }
+
+        InCompressedStream::~InCompressedStream()
+        {
+            do_close();
+        }
+
+        status_t InCompressedStream::do_close()
+        {
+            status_t res = STATUS_OK;
+
+            if (pIS != NULL)
+            {
+                if (nWrapFlags & WRAP_CLOSE)
+                    res = pIS->close();
+                if (nWrapFlags & WRAP_DELETE)
+                    delete pIS;
+                pIS         = NULL;
+            }
+            nWrapFlags  = 0;
+
+            sBits.close();
+            sData.drop();
+            sBuffer.destroy();
+            vIndex.flush();
+
+            // vPayload shares the same memory chunk with vBlock
+            if (vBlock != NULL)
+                free(lsp_min(vBlock, vPayload));
+            vBlock      = NULL;
+            vPayload    = NULL;
+
+            nBlockSize  = 0;
+            nBlockOff   = 0;
+            nBlockStart = 0;
+            nCurrent    = -1;
+            nBase       = 0;
+            nInPos      = 0;
+            bEOF        = false;
+
+            return res;
+        }
+
+        status_t InCompressedStream::close()
+        {
+            return set_error(do_close());
+        }
+
+        status_t InCompressedStream::wrap(IInStream *is, size_t flags)
+        {
+            if (pIS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (is == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            const wssize_t base = is->position();
+
+            pIS         = is;
+            nWrapFlags  = flags;
+            nBase       = lsp_max(base, 0);
+            nInPos      = 0;
+
+            status_t res = read_stream_header();
+            if (res != STATUS_OK)
+            {
+                // Do not close the passed stream on failure
+                pIS         = NULL;
+                nWrapFlags  = 0;
+                do_close();
+                return set_error(res);
+            }
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t InCompressedStream::open(const char *path)
+        {
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return set_error(STATUS_NO_MEM);
+            return open(&tmp);
+        }
+
+        status_t InCompressedStream::open(const LSPString *path)
+        {
+            if (pIS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            InFileStream *f = new InFileStream();
+            if (f == NULL)
+                return set_error(STATUS_NO_MEM);
+            status_t res = f->open(path);
+            if (res != STATUS_OK)
+            {
+                f->close();
+                delete f;
+                return set_error(res);
+            }
+
+            res = wrap(f, WRAP_CLOSE | WRAP_DELETE);
+            if (res != STATUS_OK)
+            {
+                f->close();
+                delete f;
+                return set_error(res);
+            }
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t InCompressedStream::open(const Path *path)
+        {
+            return open(path->as_string());
+        }
+
+        status_t InCompressedStream::read_stream_header()
+        {
+            compressed::stream_header_t hdr;
+            status_t res    = fetch(&hdr, sizeof(hdr));
+            if (res != STATUS_OK)
+                return (res == STATUS_CORRUPTED) ? STATUS_BAD_FORMAT : res;
+
+            if ((memcmp(hdr.magic, compressed::MAGIC, sizeof(hdr.magic)) != 0) ||
+                (hdr.version != compressed::VERSION) ||
+                (hdr.log_block < compressed::LOG_BLOCK_MIN) ||
+                (hdr.log_block > compressed::LOG_BLOCK_MAX))
+                return STATUS_BAD_FORMAT;
+
+            // Allocate buffers
+            nLogBlock               = hdr.log_block;
+            const size_t block_size = size_t(1) << nLogBlock;
+            uint8_t *ptr            = static_cast<uint8_t *>(malloc(block_size * 2));
+            if (ptr == NULL)
+                return STATUS_NO_MEM;
+            vBlock                  = ptr;
+            vPayload                = &ptr[block_size];
+
+            if ((res = sBuffer.init(lsp_min(nLogBlock, compressed::LOG_WINDOW_MAX))) != STATUS_OK)
+                return res;
+
+            // The first block follows the stream header
+            block_t *b              = vIndex.add();
+            if (b == NULL)
+                return STATUS_NO_MEM;
+            b->raw                  = 0;
+            b->offset               = nInPos;
+
+            return STATUS_OK;
+        }
+
+        status_t InCompressedStream::move_to(wsize_t offset)
+        {
+            if (offset == nInPos)
+                return STATUS_OK;
+
+            if (offset > nInPos)
+            {
+                // Skipping allows to move forward even if the stream is not seekable
+                const wssize_t skipped = pIS->skip(offset - nInPos);
+                if (skipped < 0)
+                    return status_t(-skipped);
+                nInPos     += skipped;
+                return (nInPos == offset) ? STATUS_OK : STATUS_CORRUPTED;
+            }
+
+            const wssize_t pos  = pIS->seek(nBase + offset);
+            if (pos < 0)
+                return status_t(-pos);
+            nInPos      = offset;
+
+            return STATUS_OK;
+        }
+
+        status_t InCompressedStream::fetch(void *dst, size_t count)
+        {
+            uint8_t *ptr    = static_cast<uint8_t *>(dst);
+            while (count > 0)
+            {
+                const ssize_t n = pIS->read(ptr, count);
+                if (n <= 0)
+                {
+                    // The stream has been truncated
+                    if ((n == 0) || (n == -STATUS_EOF))
+                        return STATUS_CORRUPTED;
+                    return status_t(-n);
+                }
+                ptr            += n;
+                count          -= n;
+                nInPos         += n;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t InCompressedStream::read_header(size_t index, uint32_t *size, uint32_t *payload, uint32_t *crc)
+        {
+            const block_t *b    = vIndex.uget(index);
+            status_t res        = move_to(b->offset);
+            if (res != STATUS_OK)
+                return res;
+
+            compressed::block_header_t hdr;
+            if ((res = fetch(&hdr, sizeof(hdr))) != STATUS_OK)
+                return res;
+
+            const uint32_t bsize    = LE_TO_CPU(hdr.size);
+            const uint32_t bpayload = LE_TO_CPU(hdr.payload);
+            const uint32_t bcrc     = LE_TO_CPU(hdr.crc);
+
+            // Terminating block header
+            if ((bsize == 0) && (bpayload == 0) && (bcrc == 0))
+            {
+                bEOF                = true;
+                return STATUS_EOF;
+            }
+
+            // Validate header
+            const size_t block_size = size_t(1) << nLogBlock;
+            const size_t raw        = bsize & compressed::BLOCK_SIZE_MASK;
+            if ((raw <= 0) || (raw > block_size) || (bpayload <= 0))
+                return STATUS_CORRUPTED;
+            if ((bsize & compressed::BLOCK_STORED) ? (bpayload != raw) : (bpayload > block_size))
+                return STATUS_CORRUPTED;
+
+            // Register the next block if the header has been read for the first time
+            if (index + 1 >= vIndex.size())
+            {
+                block_t *next       = vIndex.add();
+                if (next == NULL)
+                    return STATUS_NO_MEM;
+                b                   = vIndex.uget(index);
+                next->raw           = b->raw + raw;
+                next->offset        = b->offset + sizeof(hdr) + bpayload;
+            }
+
+            *size               = bsize;
+            *payload            = bpayload;
+            *crc                = bcrc;
+
+            return STATUS_OK;
+        }
+
+        status_t InCompressedStream::load_payload(size_t index, uint32_t size, uint32_t payload, uint32_t crc)
+        {
+            const size_t raw    = size & compressed::BLOCK_SIZE_MASK;
+            status_t res        = fetch(vPayload, payload);
+
+            if (res == STATUS_OK)
+            {
+                if (size & compressed::BLOCK_STORED)
+                    lsp::swap(vBlock, vPayload);
+                else
+                {
+                    // Decode block with the clean state of the buffer
+                    sBits.close();
+                    sData.wrap(vPayload, payload);
+                    sBuffer.clear();
+
+                    res = sBits.wrap(&sData, WRAP_NONE);
+                    if (res == STATUS_OK)
+                        res = resource::lz_decode(&sBuffer, &sBits, vBlock, raw);
+                }
+            }
+
+            if ((res == STATUS_OK) && (crc32c(0, vBlock, raw) != crc))
+                res = STATUS_CORRUPTED;
+
+            // Update the state, the failed block becomes the next block to read
+            nBlockStart         = vIndex.uget(index)->raw;
+            nBlockOff           = 0;
+            if (res != STATUS_OK)
+            {
+                nCurrent            = ssize_t(index) - 1;
+                nBlockSize          = 0;
+                return res;
+            }
+
+            nCurrent            = index;
+            nBlockSize          = raw;
+
+            return STATUS_OK;
+        }
+
+        status_t InCompressedStream::load_block(size_t index)
+        {
+            uint32_t size = 0, payload = 0, crc = 0;
+            status_t res = read_header(index, &size, &payload, &crc);
+            if (res == STATUS_OK)
+                return load_payload(index, size, payload, crc);
+
+            // Position at the end of the data or at the failed block
+            nCurrent            = ssize_t(index) - 1;
+            nBlockStart         = vIndex.uget(index)->raw;
+            nBlockSize          = 0;
+            nBlockOff           = 0;
+
+            return res;
+        }
+
+        ssize_t InCompressedStream::find_block(wsize_t position) const
+        {
+            // Find the last block that starts at or before the position
+            ssize_t first = 0, last = vIndex.size() - 1;
+            while (first < last)
+            {
+                const ssize_t mid   = (first + last + 1) >> 1;
+                if (vIndex.uget(mid)->raw <= position)
+                    first               = mid;
+                else
+                    last                = mid - 1;
+            }
+
+            return first;
+        }
+
+        wssize_t InCompressedStream::avail()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+            set_error(STATUS_OK);
+            return nBlockSize - nBlockOff;
+        }
+
+        wssize_t InCompressedStream::position()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+            set_error(STATUS_OK);
+            return nBlockStart + nBlockOff;
+        }
+
+        ssize_t InCompressedStream::read(void *dst, size_t count)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            uint8_t *ptr    = static_cast<uint8_t *>(dst);
+            size_t done     = 0;
+            status_t res    = STATUS_OK;
+
+            while (done < count)
+            {
+                // Load the next block if the current one has been read
+                if (nBlockOff >= nBlockSize)
+                {
+                    const size_t next   = nCurrent + 1;
+                    if ((bEOF) && (next + 1 >= vIndex.size()))
+                    {
+                        res                 = STATUS_EOF;
+                        break;
+                    }
+                    if ((res = load_block(next)) != STATUS_OK)
+                        break;
+                }
+
+                const size_t to_copy = lsp_min(count - done, nBlockSize - nBlockOff);
+                memcpy(&ptr[done], &vBlock[nBlockOff], to_copy);
+                nBlockOff      += to_copy;
+                done           += to_copy;
+            }
+
+            if (done > 0)
+            {
+                set_error(STATUS_OK);
+                return done;
+            }
+
+            return -set_error(res);
+        }
+
+        wssize_t InCompressedStream::seek(wsize_t position)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            // Seek inside of the current block
+            if ((position >= nBlockStart) && (position < nBlockStart + nBlockSize))
+            {
+                nBlockOff       = position - nBlockStart;
+                set_error(STATUS_OK);
+                return position;
+            }
+
+            // Scan headers of blocks that have not been discovered yet
+            size_t index    = find_block(position);
+            uint32_t size = 0, payload = 0, crc = 0;
+            status_t res;
+
+            while ((!bEOF) && (index + 1 >= vIndex.size()))
+            {
+                res             = read_header(index, &size, &payload, &crc);
+                if (res == STATUS_EOF)
+                    break;
+                else if (res != STATUS_OK)
+                    return -set_error(res);
+
+                // The payload follows the header, load it immediately
+                if (position < vIndex.uget(index + 1)->raw)
+                {
+                    if ((res = load_payload(index, size, payload, crc)) != STATUS_OK)
+                        return -set_error(res);
+                    nBlockOff       = position - nBlockStart;
+                    set_error(STATUS_OK);
+                    return position;
+                }
+
+                ++index;
+            }
+
+            // Position beyond the end of data
+            if ((bEOF) && (index + 1 >= vIndex.size()))
+            {
+                nCurrent        = ssize_t(index) - 1;
+                nBlockStart     = vIndex.uget(index)->raw;
+                nBlockSize      = 0;
+                nBlockOff       = 0;
+                set_error(STATUS_OK);
+                return nBlockStart;
+            }
+
+            if ((res = load_block(index)) != STATUS_OK)
+                return -set_error(res);
+            nBlockOff       = position - nBlockStart;
+
+            set_error(STATUS_OK);
+            return position;
+        }
+
+        wssize_t InCompressedStream::skip(wsize_t amount)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            const wsize_t pos   = nBlockStart + nBlockOff;
+            const wssize_t res  = seek(pos + amount);
+            return (res < 0) ? res : res - pos;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
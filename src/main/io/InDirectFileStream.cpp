@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InDirectFileStream.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/io/DirectTransfer.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        InDirectFileStream::InDirectFileStream(AlignedBufferPool *pool)
+        {
+            pFD         = NULL;
+            pTransfer   = NULL;
+            pPool       = pool;
+            pLocalPool  = NULL;
+            vBuf[0]     = NULL;
+            vBuf[1]     = NULL;
+            nBufOffset  = 0;
+            nBufSize    = 0;
+            nBufPos     = 0;
+            nNextOffset = 0;
+            bDirect     = false;
+        }
+
+        InDirectFileStream::~InDirectFileStream()
+        {
+            do_close();
+
+            if (pLocalPool != NULL)
+            {
+                delete pLocalPool;
+                pLocalPool  = NULL;
+            }
+        }
+
+        status_t InDirectFileStream::do_close()
+        {
+            status_t res = STATUS_OK;
+
+            if (pTransfer != NULL)
+            {
+                pTransfer->stop();
+                delete pTransfer;
+                pTransfer   = NULL;
+            }
+
+            for (size_t i=0; i<2; ++i)
+            {
+                if (vBuf[i] != NULL)
+                {
+                    pPool->release(vBuf[i]);
+                    vBuf[i]     = NULL;
+                }
+            }
+
+            if (pFD != NULL)
+            {
+                res         = pFD->close();
+                delete pFD;
+                pFD         = NULL;
+            }
+
+            nBufOffset  = 0;
+            nBufSize    = 0;
+            nBufPos     = 0;
+            nNextOffset = 0;
+            bDirect     = false;
+
+            return res;
+        }
+
+        status_t InDirectFileStream::close()
+        {
+            return set_error(do_close());
+        }
+
+        status_t InDirectFileStream::open(const char *path)
+        {
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return set_error(STATUS_NO_MEM);
+            return open(&tmp);
+        }
+
+        status_t InDirectFileStream::open(const Path *path)
+        {
+            return open(path->as_string());
+        }
+
+        status_t InDirectFileStream::open(const LSPString *path)
+        {
+            if (pFD != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            // Create the buffer pool if it was not specified
+            if (pPool == NULL)
+            {
+                if ((pLocalPool = new AlignedBufferPool()) == NULL)
+                    return set_error(STATUS_NO_MEM);
+                pPool       = pLocalPool;
+            }
+
+            // Open the file, fall back to buffered I/O if direct I/O is not supported
+            pFD         = new NativeFile();
+            if (pFD == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            bDirect     = true;
+            status_t res = pFD->open(path, File::FM_READ | File::FM_DIRECT);
+            if (res == STATUS_INVALID_VALUE)
+            {
+                bDirect     = false;
+                res         = pFD->open(path, File::FM_READ);
+            }
+            if (res != STATUS_OK)
+            {
+                do_close();
+                return set_error(res);
+            }
+
+            // Allocate buffers and start background transfer
+            vBuf[0]     = pPool->acquire();
+            vBuf[1]     = pPool->acquire();
+            pTransfer   = new DirectTransfer();
+            if ((vBuf[0] == NULL) || (vBuf[1] == NULL) || (pTransfer == NULL))
+            {
+                do_close();
+                return set_error(STATUS_NO_MEM);
+            }
+
+            if ((res = pTransfer->start(pFD)) == STATUS_OK)
+                res         = load(0);
+            if (res != STATUS_OK)
+            {
+                do_close();
+                return set_error(res);
+            }
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t InDirectFileStream::prefetch()
+        {
+            // The short block means the end of file
+            const size_t buf_size   = pPool->buffer_size();
+            if (nBufSize < buf_size)
+                return STATUS_OK;
+
+            nNextOffset     = nBufOffset + buf_size;
+            return pTransfer->read(vBuf[1], nNextOffset, buf_size);
+        }
+
+        status_t InDirectFileStream::load(wsize_t offset)
+        {
+            // Drop the read-ahead data
+            pTransfer->wait();
+
+            status_t res    = pTransfer->read(vBuf[0], offset, pPool->buffer_size());
+            if (res != STATUS_OK)
+                return res;
+            const ssize_t n = pTransfer->wait();
+            if (n < 0)
+                return status_t(-n);
+
+            nBufOffset      = offset;
+            nBufSize        = n;
+            nBufPos         = 0;
+
+            return prefetch();
+        }
+
+        status_t InDirectFileStream::advance()
+        {
+            if (!pTransfer->pending())
+                return STATUS_EOF;
+
+            const ssize_t n = pTransfer->wait();
+            if (n < 0)
+                return status_t(-n);
+
+            lsp::swap(vBuf[0], vBuf[1]);
+            nBufOffset      = nNextOffset;
+            nBufSize        = n;
+            nBufPos         = 0;
+            if (n <= 0)
+                return STATUS_EOF;
+
+            return prefetch();
+        }
+
+        wssize_t InDirectFileStream::avail()
+        {
+            if (pFD == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            const wssize_t size = pFD->size();
+            if (size < 0)
+                return -set_error(status_t(-size));
+
+            set_error(STATUS_OK);
+            return lsp_max(size - wssize_t(nBufOffset + nBufPos), 0);
+        }
+
+        wssize_t InDirectFileStream::position()
+        {
+            if (pFD == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            set_error(STATUS_OK);
+            return nBufOffset + nBufPos;
+        }
+
+        ssize_t InDirectFileStream::read(void *dst, size_t count)
+        {
+            if (pFD == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            uint8_t *ptr    = static_cast<uint8_t *>(dst);
+            size_t done     = 0;
+            status_t res    = STATUS_OK;
+
+            while (done < count)
+            {
+                if ((nBufPos >= nBufSize) && ((res = advance()) != STATUS_OK))
+                    break;
+
+                const size_t to_copy = lsp_min(count - done, nBufSize - nBufPos);
+                memcpy(&ptr[done], &vBuf[0][nBufPos], to_copy);
+                nBufPos        += to_copy;
+                done           += to_copy;
+            }
+
+            if (done > 0)
+            {
+                set_error(STATUS_OK);
+                return done;
+            }
+
+            return -set_error(res);
+        }
+
+        wssize_t InDirectFileStream::seek(wsize_t position)
+        {
+            if (pFD == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            // Do not move beyond the end of file
+            const wssize_t size     = pFD->size();
+            if (size < 0)
+                return -set_error(status_t(-size));
+            position                = lsp_min(position, wsize_t(size));
+
+            // Use the read-ahead block if position is inside of it
+            const size_t buf_size   = pPool->buffer_size();
+            if ((position >= nBufOffset + nBufSize) &&
+                (pTransfer->pending()) &&
+                (position >= nNextOffset) &&
+                (position < nNextOffset + buf_size))
+            {
+                status_t res    = advance();
+                if ((res != STATUS_OK) && (res != STATUS_EOF))
+                    return -set_error(res);
+            }
+
+            // Seek inside of the current block
+            if ((position >= nBufOffset) && (position <= nBufOffset + nBufSize))
+            {
+                nBufPos         = position - nBufOffset;
+                set_error(STATUS_OK);
+                return position;
+            }
+
+            // Load the aligned block that contains the position
+            const wsize_t offset    = position & ~wsize_t(pPool->alignment() - 1);
+            status_t res            = load(offset);
+            if (res != STATUS_OK)
+                return -set_error(res);
+
+            // The file might be truncated by another process
+            nBufPos         = lsp_min(position - offset, wsize_t(nBufSize));
+            set_error(STATUS_OK);
+            return nBufOffset + nBufPos;
+        }
+
+        wssize_t InDirectFileStream::skip(wsize_t amount)
+        {
+            if (pFD == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            const wsize_t pos   = nBufOffset + nBufPos;
+            const wssize_t res  = seek(pos + amount);
+            return (res < 0) ? res : res - pos;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -349,6 +349,71 @@ namespace lsp
             return set_error(STATUS_OK);
         }
 
+        status_t InMarkSequence::peek_span(const lsp_wchar_t **ptr, size_t *len)
+        {
+            if (pSequence == NULL)
+                return set_error(STATUS_CLOSED);
+            else if ((ptr == NULL) || (len == NULL))
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            // Reset mark if we are out of buffer
+            if ((nMarkMax >= 0) && (nMarkPos >= nMarkLen) && (nMarkPos >= nMarkMax))
+                clear_mark();
+
+            // Simple peek if there is no mark set
+            if (nMarkMax < 0)
+                return set_error(pSequence->peek_span(ptr, len));
+
+            // Read more data to the buffer if all buffered characters have been consumed
+            if (nMarkPos >= nMarkLen)
+            {
+                ssize_t avail   = grow_buffer(MARKSEQ_SIZE);
+                if (avail < 0)
+                    return set_error(STATUS_NO_MEM);
+                else if (avail == 0)
+                {
+                    // Mark buffer can not be extended, the mark becomes invalid
+                    clear_mark();
+                    return set_error(pSequence->peek_span(ptr, len));
+                }
+
+                ssize_t nread   = pSequence->read(&pBuf[nMarkPos], avail);
+                if (nread < 0)
+                    return set_error(status_t(-nread));
+                else if (nread == 0)
+                    return set_error(STATUS_EOF);
+
+                nMarkLen       += nread;
+            }
+
+            // Return the buffered data
+            *ptr            = &pBuf[nMarkPos];
+            *len            = nMarkLen - nMarkPos;
+
+            return set_error(STATUS_OK);
+        }
+
+        ssize_t InMarkSequence::consume(size_t count)
+        {
+            if (pSequence == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            // No mark set?
+            if (nMarkMax < 0)
+            {
+                ssize_t res = pSequence->consume(count);
+                set_error((res < 0) ? status_t(-res) : STATUS_OK);
+                return res;
+            }
+
+            // Consume buffered characters
+            count           = lsp_min(count, size_t(nMarkLen - nMarkPos));
+            nMarkPos       += count;
+
+            set_error(STATUS_OK);
+            return count;
+        }
+
 
     } /* namespace io */
 } /* namespace lsp */
@@ -356,5 +356,45 @@ namespace lsp
             return IInSequence::skip(count);
         }
 
+        status_t InSequence::peek_span(const lsp_wchar_t **ptr, size_t *len)
+        {
+            if (pIS == NULL)
+                return set_error(STATUS_CLOSED);
+            else if ((ptr == NULL) || (len == NULL))
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            while (true)
+            {
+                // Try to obtain decoded characters
+                ssize_t nchars  = sDecoder.peek(ptr);
+                if (nchars > 0)
+                {
+                    *len            = nchars;
+                    return set_error(STATUS_OK);
+                }
+                else if (nchars < 0)
+                    return set_error(status_t(-nchars));
+
+                // No data to fetch? Try to fill buffer
+                ssize_t filled  = sDecoder.fill(pIS);
+                if (filled < 0)
+                    return set_error(status_t(-filled));
+                else if (filled == 0)
+                    return set_error(STATUS_EOF);
+            }
+        }
+
+        ssize_t InSequence::consume(size_t count)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            // Clear line buffer
+            sLine.clear();
+
+            set_error(STATUS_OK);
+            return sDecoder.skip(count);
+        }
+
     } /* namespace io */
 } /* namespace lsp */
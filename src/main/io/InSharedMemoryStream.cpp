@@ -46,7 +46,9 @@ namespace lsp
             if (shared != NULL)
             {
                 shared->pData   = static_cast<uint8_t *>(data);
+                shared->vChunks = NULL;
                 shared->nSize   = size;
+                shared->nChunkSize  = 0;
                 shared->nRefs   = 1;
                 shared->enDrop  = drop;
             }
@@ -61,7 +63,9 @@ namespace lsp
             if (shared != NULL)
             {
                 shared->pData   = reinterpret_cast<uint8_t *>(const_cast<void *>(data));
+                shared->vChunks = NULL;
                 shared->nSize   = size;
+                shared->nChunkSize  = 0;
                 shared->nRefs   = 1;
                 shared->enDrop  = MEMDROP_NONE;
             }
@@ -122,6 +126,14 @@ namespace lsp
                 return;
             if ((--pShared->nRefs) == 0)
             {
+                if (pShared->vChunks != NULL)
+                {
+                    const size_t count = (pShared->nSize + pShared->nChunkSize - 1) / pShared->nChunkSize;
+                    for (size_t i=0; i<count; ++i)
+                        free(pShared->vChunks[i]);
+                    free(pShared->vChunks);
+                }
+
                 switch (pShared->enDrop)
                 {
                     case MEMDROP_FREE: free(pShared->pData); break;
@@ -144,7 +156,9 @@ namespace lsp
             release_shared();
 
             shared->pData   = static_cast<uint8_t *>(data);
+            shared->vChunks = NULL;
             shared->nSize   = size;
+            shared->nChunkSize  = 0;
             shared->nRefs   = 1;
             shared->enDrop  = drop;
 
@@ -163,7 +177,9 @@ namespace lsp
             release_shared();
 
             shared->pData   = reinterpret_cast<uint8_t *>(const_cast<void *>(data));
+            shared->vChunks = NULL;
             shared->nSize   = size;
+            shared->nChunkSize  = 0;
             shared->nRefs   = 1;
             shared->enDrop  = MEMDROP_NONE;
 
@@ -238,8 +254,26 @@ namespace lsp
             if (count <= 0)
                 return -set_error(STATUS_EOF);
 
-            ::memcpy(dst, &pShared->pData[nOffset], count);
-            nOffset    += count;
+            if (pShared->vChunks != NULL)
+            {
+                const size_t chunk_size = pShared->nChunkSize;
+                uint8_t *dptr   = static_cast<uint8_t *>(dst);
+                for (size_t left = count; left > 0; )
+                {
+                    const size_t offset     = nOffset % chunk_size;
+                    const size_t to_copy    = lsp_min(left, chunk_size - offset);
+
+                    ::memcpy(dptr, &pShared->vChunks[nOffset / chunk_size][offset], to_copy);
+                    dptr           += to_copy;
+                    nOffset        += to_copy;
+                    left           -= to_copy;
+                }
+            }
+            else
+            {
+                ::memcpy(dst, &pShared->pData[nOffset], count);
+                nOffset    += count;
+            }
             return count;
         }
 
@@ -247,7 +281,14 @@ namespace lsp
         {
             if (pShared == NULL)
                 return -set_error(STATUS_NO_DATA);
-            return (nOffset < pShared->nSize) ? pShared->pData[nOffset++] : -STATUS_EOF;
+            if (nOffset >= pShared->nSize)
+                return -STATUS_EOF;
+            if (pShared->vChunks != NULL)
+            {
+                const size_t offset = nOffset++;
+                return pShared->vChunks[offset / pShared->nChunkSize][offset % pShared->nChunkSize];
+            }
+            return pShared->pData[nOffset++];
         }
 
         wssize_t InSharedMemoryStream::seek(wsize_t position)
@@ -311,9 +352,32 @@ namespace lsp
             src->nOffset    = 0;
         }
 
+        status_t InSharedMemoryStream::take_chunks(OutMemoryStream *src)
+        {
+            if (src->size() <= 0)
+                return STATUS_OK;
+
+            shared_data_t *shared = static_cast<shared_data_t *>(malloc(sizeof(shared_data_t)));
+            if (shared == NULL)
+                return STATUS_NO_MEM;
+
+            shared->pData       = NULL;
+            shared->nChunkSize  = src->chunk_size();
+            shared->nRefs       = 1;
+            shared->enDrop      = MEMDROP_NONE;
+            shared->vChunks     = src->release_chunks(&shared->nSize, NULL);
+
+            pShared = shared;
+            nOffset = 0;
+
+            return STATUS_OK;
+        }
+
         status_t InSharedMemoryStream::take(OutMemoryStream &src)
         {
             release_shared();
+            if (src.chunked())
+                return take_chunks(&src);
             if (src.data() == NULL)
                 return STATUS_OK;
 
@@ -326,6 +390,8 @@ namespace lsp
         status_t InSharedMemoryStream::take(OutMemoryStream *src)
         {
             release_shared();
+            if (src->chunked())
+                return take_chunks(src);
             if (src->data() == NULL)
                 return STATUS_OK;
 
@@ -258,5 +258,27 @@ namespace lsp
             nOffset     = nMark;
             return set_error(STATUS_OK);
         }
+
+        status_t InStringSequence::peek_span(const lsp_wchar_t **ptr, size_t *len)
+        {
+            if (pString == NULL)
+                return set_error(STATUS_CLOSED);
+            else if ((ptr == NULL) || (len == NULL))
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            size_t avail = pString->length() - nOffset;
+            if (avail <= 0)
+                return set_error(STATUS_EOF);
+
+            *ptr        = &pString->characters()[nOffset];
+            *len        = avail;
+
+            return set_error(STATUS_OK);
+        }
+
+        ssize_t InStringSequence::consume(size_t count)
+        {
+            return skip(count);
+        }
     }
 } /* namespace lsp */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InTeeStream.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        InTeeStream::InTeeStream()
+        {
+            pIS         = NULL;
+            pOS         = NULL;
+            nInFlags    = 0;
+            nOutFlags   = 0;
+            nCopied     = 0;
+        }
+
+        InTeeStream::~InTeeStream()
+        {
+            do_close();
+        }
+
+        status_t InTeeStream::do_close()
+        {
+            status_t res = STATUS_OK;
+
+            if (pIS != NULL)
+            {
+                if (nInFlags & WRAP_CLOSE)
+                    res = update_status(res, pIS->close());
+                if (nInFlags & WRAP_DELETE)
+                    delete pIS;
+                pIS         = NULL;
+            }
+            if (pOS != NULL)
+            {
+                if (nOutFlags & WRAP_CLOSE)
+                    res = update_status(res, pOS->close());
+                if (nOutFlags & WRAP_DELETE)
+                    delete pOS;
+                pOS         = NULL;
+            }
+            nInFlags    = 0;
+            nOutFlags   = 0;
+
+            return res;
+        }
+
+        status_t InTeeStream::close()
+        {
+            return set_error(do_close());
+        }
+
+        status_t InTeeStream::wrap(IInStream *is, size_t in_flags, IOutStream *os, size_t out_flags)
+        {
+            if (pIS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if ((is == NULL) || (os == NULL))
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            pIS         = is;
+            pOS         = os;
+            nInFlags    = in_flags;
+            nOutFlags   = out_flags;
+            nCopied     = 0;
+
+            return set_error(STATUS_OK);
+        }
+
+        wssize_t InTeeStream::avail()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+            wssize_t res = pIS->avail();
+            set_error((res < 0) ? status_t(-res) : STATUS_OK);
+            return res;
+        }
+
+        wssize_t InTeeStream::position()
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+            wssize_t res = pIS->position();
+            set_error((res < 0) ? status_t(-res) : STATUS_OK);
+            return res;
+        }
+
+        ssize_t InTeeStream::read(void *dst, size_t count)
+        {
+            if (pIS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            ssize_t res = pIS->read(dst, count);
+            if (res < 0)
+                return -set_error(status_t(-res));
+
+            // Write the copy of data to the output stream
+            const uint8_t *ptr  = static_cast<const uint8_t *>(dst);
+            for (ssize_t off = 0; off < res; )
+            {
+                ssize_t written     = pOS->write(&ptr[off], res - off);
+                if (written <= 0)
+                    return -set_error((written < 0) ? status_t(-written) : STATUS_IO_ERROR);
+                off                += written;
+                nCopied            += written;
+            }
+
+            set_error(STATUS_OK);
+            return res;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -119,7 +119,8 @@ namespace lsp
             if (mode & FM_DIRECT)
                 atts           |= FILE_FLAG_NO_BUFFERING;
 
-            fhandle_t fd = CreateFileW(path->get_utf16(),
+            lsp_utf16_t xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            fhandle_t fd = CreateFileW(path->to_utf16(xbuf, IO_PATH_NATIVE_BUF_SIZE),
                 oflags,
                 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
                 NULL, cmode, atts, NULL);
@@ -237,7 +238,8 @@ namespace lsp
                     oflags     |= O_DIRECT;
             #endif /* __USE_GNU */
 
-            fhandle_t fd        = ::open(path->get_native(), oflags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+            char xbuf[IO_PATH_NATIVE_BUF_SIZE];
+            fhandle_t fd        = ::open(path->to_native(xbuf, sizeof(xbuf)), oflags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
             if (fd < 0)
             {
                 const int code = errno;
@@ -260,6 +262,12 @@ namespace lsp
                 return set_error(res);
             }
 
+            #if !(defined(__USE_GNU) && defined(O_DIRECT)) && defined(F_NOCACHE)
+                // Disable caching of the file data if O_DIRECT is not available
+                if (mode & FM_DIRECT)
+                    fcntl(fd, F_NOCACHE, 1);
+            #endif /* F_NOCACHE */
+
             // Check that we need to lock the file
             if (mode & FM_LOCK)
             {
@@ -363,7 +371,7 @@ namespace lsp
                 while (bread < count)
                 {
                     size_t to_read  = count - bread;
-                    size_t n_read   = ::read(hFD, ptr, to_read);
+                    ssize_t n_read  = ::read(hFD, ptr, to_read);
 
                     if (n_read <= 0)
                     {
@@ -437,7 +445,7 @@ namespace lsp
                 while (bread < count)
                 {
                     size_t to_read  = count - bread;
-                    size_t n_read   = ::pread(hFD, ptr, to_read, pos);
+                    ssize_t n_read  = ::pread(hFD, ptr, to_read, pos);
 
                     if (n_read <= 0)
                     {
@@ -555,7 +563,7 @@ namespace lsp
                 while (bwritten < count)
                 {
                     size_t to_write     = count - bwritten;
-                    size_t n_written    = ::pwrite(hFD, ptr, to_write, pos);
+                    ssize_t n_written   = ::pwrite(hFD, ptr, to_write, pos);
 
                     if (n_written <= 0)
                         break;
@@ -0,0 +1,349 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/Dir.h>
+#include <lsp-plug.in/io/File.h>
+#include <lsp-plug.in/io/OutAtomicFileStream.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <windows.h>
+    #include <winbase.h>
+#endif /* PLATFORM_WINDOWS */
+
+#if defined(PLATFORM_UNIX_COMPATIBLE)
+    #include <sys/stat.h>
+    #include <errno.h>
+    #include <limits.h>
+    #include <unistd.h>
+#endif /* PLATFORM_UNIX_COMPATIBLE */
+
+// Maximum number of symbolic links to follow, same to the Linux kernel limit
+#define MAX_SYMLINKS        40
+
+namespace lsp
+{
+    namespace io
+    {
+        static status_t replace_file(const LSPString *from, const LSPString *to)
+        {
+        #ifdef PLATFORM_WINDOWS
+            // Write-through guarantees that the move is committed to the disk before return
+            if (::MoveFileExW(from->get_utf16(), to->get_utf16(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+                return STATUS_OK;
+        #endif /* PLATFORM_WINDOWS */
+            return File::rename(from, to);
+        }
+
+    #if defined(PLATFORM_UNIX_COMPATIBLE)
+        /**
+         * Follow the chain of symbolic links to the file that should be actually replaced.
+         * The final file may not exist yet.
+         * @param path path to resolve, replaced by the final path
+         * @return status of operation
+         */
+        static status_t resolve_target(Path *path)
+        {
+            char buf[PATH_MAX];
+            fattr_t attr;
+            Path link;
+
+            for (size_t i=0; i<MAX_SYMLINKS; ++i)
+            {
+                // Stop at the first path that is not a symbolic link
+                status_t res = path->stat(&attr);
+                if (res == STATUS_NOT_FOUND)
+                    return STATUS_OK;
+                else if (res != STATUS_OK)
+                    return res;
+                if (attr.type != fattr_t::FT_SYMLINK)
+                    return STATUS_OK;
+
+                const ssize_t count = ::readlink(path->as_native(), buf, sizeof(buf) - 1);
+                if (count < 0)
+                    return (errno == ENAMETOOLONG) ? STATUS_TOO_BIG : STATUS_IO_ERROR;
+                buf[count] = '\0';
+
+                // Relative links are resolved against the directory of the link
+                if ((res = link.set_native(buf)) != STATUS_OK)
+                    return res;
+                if (link.is_relative())
+                {
+                    if ((res = path->remove_last()) != STATUS_OK)
+                        return res;
+                    if ((res = path->append_child(&link)) != STATUS_OK)
+                        return res;
+                }
+                else
+                    path->swap(&link);
+                if ((res = path->canonicalize()) != STATUS_OK)
+                    return res;
+            }
+
+            return STATUS_OVERFLOW;
+        }
+    #endif /* PLATFORM_UNIX_COMPATIBLE */
+
+        OutAtomicFileStream::OutAtomicFileStream()
+        {
+            pFD         = NULL;
+            pBatch      = NULL;
+            nFailure    = STATUS_OK;
+        }
+
+        OutAtomicFileStream::~OutAtomicFileStream()
+        {
+            // Stream has not been committed, keep the target file untouched
+            do_abort();
+        }
+
+        void OutAtomicFileStream::do_abort()
+        {
+            if (pFD == NULL)
+                return;
+
+            pFD->close();
+            delete pFD;
+            pFD         = NULL;
+
+            File::remove(&sTemp);
+            pBatch      = NULL;
+            nFailure    = STATUS_OK;
+        }
+
+        void OutAtomicFileStream::set_failure(status_t code)
+        {
+            // Keep the first error, it is the cause of all further errors
+            if (nFailure == STATUS_OK)
+                nFailure    = code;
+        }
+
+        status_t OutAtomicFileStream::create_temp()
+        {
+            NativeFile *f = new NativeFile();
+            if (f == NULL)
+                return STATUS_NO_MEM;
+
+            const size_t len = sPath.length();
+            status_t res;
+
+            while (true)
+            {
+                // Generate the name of the file near the target file
+                if (!sTemp.set(&sPath))
+                    res     = STATUS_NO_MEM;
+                else
+                {
+                    const int seed = int(system::get_time_millis()) ^ int(rand());
+                    res     = (sTemp.fmt_append_ascii(".%08x.tmp", seed) > 0) ? STATUS_OK : STATUS_NO_MEM;
+                }
+                if (res != STATUS_OK)
+                    break;
+
+                res = f->open(&sTemp, File::FM_WRITE_NEW | File::FM_EXCL);
+                if (res != STATUS_ALREADY_EXISTS)
+                    break;
+                sTemp.set_length(len);
+            }
+
+            if (res != STATUS_OK)
+            {
+                delete f;
+                return res;
+            }
+
+        #if defined(PLATFORM_UNIX_COMPATIBLE)
+            // Preserve access rights of the replaced file
+            struct stat st;
+            if (::stat(sPath.get_native(), &st) == 0)
+                ::chmod(sTemp.get_native(), st.st_mode & 07777);
+        #endif /* PLATFORM_UNIX_COMPATIBLE */
+
+            pFD         = f;
+            return STATUS_OK;
+        }
+
+        status_t OutAtomicFileStream::open(const char *path, SyncBatch *batch)
+        {
+            if (pFD != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return set_error(STATUS_NO_MEM);
+            return open(&tmp, batch);
+        }
+
+        status_t OutAtomicFileStream::open(const Path *path, SyncBatch *batch)
+        {
+            if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+            return open(path->as_string(), batch);
+        }
+
+        status_t OutAtomicFileStream::open(const LSPString *path, SyncBatch *batch)
+        {
+            if (pFD != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if ((path == NULL) || (path->is_empty()))
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            Path p;
+            status_t res = p.set(path);
+            if (res != STATUS_OK)
+                return set_error(res);
+
+        #if defined(PLATFORM_UNIX_COMPATIBLE)
+            // Replace the file the symbolic link points to, not the link itself
+            if ((res = resolve_target(&p)) != STATUS_OK)
+                return set_error(res);
+        #endif /* PLATFORM_UNIX_COMPATIBLE */
+
+            // Determine the directory that holds the file
+            if (p.is_root())
+                return set_error(STATUS_IS_DIRECTORY);
+            res = p.get_parent(&sDir);
+            if (res == STATUS_NOT_FOUND)
+                res = (sDir.set_ascii(".")) ? STATUS_OK : STATUS_NO_MEM;
+            else if ((res == STATUS_OK) && (sDir.is_empty()))
+                res = (sDir.set_ascii(FILE_SEPARATOR_S)) ? STATUS_OK : STATUS_NO_MEM;
+            if (res != STATUS_OK)
+                return set_error(res);
+
+            if (!sPath.set(p.as_string()))
+                return set_error(STATUS_NO_MEM);
+
+            // Create temporary file
+            if ((res = create_temp()) != STATUS_OK)
+                return set_error(res);
+
+            pBatch      = batch;
+            nFailure    = STATUS_OK;
+
+            return set_error(STATUS_OK);
+        }
+
+        wssize_t OutAtomicFileStream::position()
+        {
+            if (pFD == NULL)
+                return -set_error(STATUS_CLOSED);
+            wssize_t pos = pFD->position();
+            set_error((pos < 0) ? status_t(-pos) : STATUS_OK);
+            return pos;
+        }
+
+        ssize_t OutAtomicFileStream::write(const void *buf, size_t count)
+        {
+            if (pFD == NULL)
+                return -set_error(STATUS_CLOSED);
+            ssize_t res = pFD->write(buf, count);
+            if (res < 0)
+                set_failure(status_t(-res));
+            set_error((res < 0) ? status_t(-res) : STATUS_OK);
+            return res;
+        }
+
+        wssize_t OutAtomicFileStream::seek(wsize_t position)
+        {
+            if (pFD == NULL)
+                return -set_error(STATUS_CLOSED);
+            status_t res = pFD->seek(position, File::FSK_SET);
+            if (res != STATUS_OK)
+            {
+                set_failure(res);
+                return -set_error(res);
+            }
+            wssize_t pos = pFD->position();
+            set_error((pos < 0) ? status_t(-pos) : STATUS_OK);
+            return pos;
+        }
+
+        status_t OutAtomicFileStream::flush()
+        {
+            if (pFD == NULL)
+                return set_error(STATUS_CLOSED);
+            status_t res = pFD->flush();
+            if (res != STATUS_OK)
+                set_failure(res);
+            return set_error(res);
+        }
+
+        status_t OutAtomicFileStream::do_commit()
+        {
+            // Ensure that the contents is on the disk before it becomes visible under the target name
+            status_t res = pFD->flush();
+            if (res == STATUS_OK)
+                res         = pFD->sync();
+            if (res == STATUS_OK)
+                res         = pFD->close();
+            if (res != STATUS_OK)
+                return res;
+
+            delete pFD;
+            pFD         = NULL;
+
+            // Replace the file
+            if ((res = replace_file(&sTemp, &sPath)) != STATUS_OK)
+            {
+                File::remove(&sTemp);
+                return res;
+            }
+
+            // Make the rename durable
+            SyncBatch *batch = pBatch;
+            pBatch      = NULL;
+
+            return (batch != NULL) ? batch->add(&sDir) : Dir::sync(&sDir);
+        }
+
+        status_t OutAtomicFileStream::close()
+        {
+            if (pFD == NULL)
+                return set_error(STATUS_OK);
+
+            if (nFailure != STATUS_OK)
+            {
+                const status_t res = nFailure;
+                do_abort();
+                return set_error(res);
+            }
+
+            status_t res = do_commit();
+            if (res != STATUS_OK)
+                do_abort();
+
+            return set_error(res);
+        }
+
+        status_t OutAtomicFileStream::abort()
+        {
+            if (pFD == NULL)
+                return set_error(STATUS_CLOSED);
+
+            do_abort();
+            return set_error(STATUS_OK);
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -20,15 +20,20 @@
  */
 
 #include <lsp-plug.in/io/OutBitStream.h>
+#include <lsp-plug.in/io/OutBufStream.h>
 #include <lsp-plug.in/io/OutFileStream.h>
 #include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
 
 namespace lsp
 {
     namespace io
     {
-        static constexpr size_t BITSTREAM_BUFSZ     = sizeof(umword_t) * 8;
+        static constexpr size_t BITSTREAM_BUFSZ     = sizeof(uint64_t) * 8;
         static constexpr size_t BITSTREAM_BUFSZ32   = sizeof(uint32_t) * 8;
+        static constexpr size_t BITSTREAM_GROUP     = BITSTREAM_BUFSZ - 8;  // Maximum size of variable-length integer group
+        static constexpr size_t BITSTREAM_DATASZ    = 0x1000;               // Size of output buffer
 
         OutBitStream::OutBitStream()
         {
@@ -36,6 +41,8 @@ namespace lsp
             nWrapFlags  = 0;
             nBuffer     = 0;
             nBits       = 0;
+            vData       = NULL;
+            nDataSize   = 0;
         }
 
         OutBitStream::~OutBitStream()
@@ -51,8 +58,15 @@ namespace lsp
                 pOS         = NULL;
             }
 
-            nBuffer = 0;
-            nBits   = 0;
+            if (vData != NULL)
+            {
+                free(vData);
+                vData       = NULL;
+            }
+
+            nBuffer     = 0;
+            nBits       = 0;
+            nDataSize   = 0;
         }
 
         status_t OutBitStream::close()
@@ -102,7 +116,7 @@ namespace lsp
             else if (path == NULL)
                 return set_error(STATUS_BAD_ARGUMENTS);
 
-            OutFileStream *f = new OutFileStream();
+            OutBufStream *f = new OutBufStream();
             if (f == NULL)
                 return set_error(STATUS_NO_MEM);
             status_t res = f->open(path, mode);
@@ -218,52 +232,97 @@ namespace lsp
             else if (os == NULL)
                 return set_error(STATUS_BAD_ARGUMENTS);
 
+            // Allocate output buffer
+            if (vData == NULL)
+            {
+                vData       = static_cast<uint8_t *>(malloc(BITSTREAM_DATASZ));
+                if (vData == NULL)
+                    return set_error(STATUS_NO_MEM);
+            }
+
             // Store pointers
             pOS         = os;
             nWrapFlags  = flags;
             nBuffer     = 0;
             nBits       = 0;
+            nDataSize   = 0;
 
             return set_error(STATUS_OK);
         }
 
+        static inline uint32_t load_be32(const uint8_t *p)
+        {
+            uint32_t v;
+            memcpy(&v, p, sizeof(v));
+            return BE_TO_CPU(v);
+        }
+
         ssize_t OutBitStream::write(const void *buf, size_t count)
         {
             if (pOS == NULL)
                 return -set_error(STATUS_CLOSED);
 
+            const uint8_t *p        = reinterpret_cast<const uint8_t *>(buf);
             size_t written          = 0;
+            status_t res            = STATUS_OK;
 
-        #ifdef LSP_UNALIGNED_MEMORY_SAFE
-            // x86 allows unaligned access, write with machine words first
-            const umword_t *wptr    = reinterpret_cast<const umword_t *>(buf);
-            size_t blocks           = count & (~(sizeof(umword_t) - 1));
-
-            for ( ; written < blocks; written += sizeof(umword_t))
+            // Not aligned to byte boundary? Pass data through the bit cache
+            if (nBits & 7)
             {
-                status_t res            = writev(BE_TO_CPU(*(wptr++)), sizeof(umword_t)*8);
+                for ( ; (written + sizeof(uint32_t)) <= count; written += sizeof(uint32_t))
+                {
+                    if ((res = write_bits(load_be32(&p[written]), BITSTREAM_BUFSZ32)) != STATUS_OK)
+                        break;
+                }
+                for ( ; (res == STATUS_OK) && (written < count); ++written)
+                    res                     = write_bits(p[written], 8);
+
                 if (res != STATUS_OK)
                 {
                     set_error(res);
                     return (written <= 0) ? -res : written;
                 }
+
+                return written;
             }
 
-            buf = wptr;
-        #endif /* LSP_UNALIGNED_MEMORY_SAFE */
+            // Move whole bytes from the bit cache to the output buffer
+            if ((res = spill()) != STATUS_OK)
+                return -set_error(res);
 
-            // Write the rest data with bytes
-            const uint8_t *bptr     = reinterpret_cast<const uint8_t *>(buf);
-            for ( ; written < count; ++written)
+            while (written < count)
             {
-                status_t res = writev(*(bptr++), sizeof(uint8_t) * 8);
-                if (res != STATUS_OK)
+                // Write large blocks directly
+                const size_t left       = count - written;
+                if ((nDataSize <= 0) && (left >= BITSTREAM_DATASZ))
                 {
-                    set_error(res);
-                    return (written <= 0) ? -res : written;
+                    const ssize_t n         = pOS->write(&p[written], left);
+                    if (n <= 0)
+                    {
+                        res                     = (n < 0) ? status_t(-n) : STATUS_IO_ERROR;
+                        break;
+                    }
+                    written                += n;
+                    continue;
                 }
+
+                // Append data to the output buffer
+                const size_t n          = lsp_min(left, BITSTREAM_DATASZ - nDataSize);
+                memcpy(&vData[nDataSize], &p[written], n);
+                nDataSize              += n;
+                written                += n;
+
+                if ((nDataSize >= BITSTREAM_DATASZ) && ((res = flush_data()) != STATUS_OK))
+                    break;
             }
 
+            if (res != STATUS_OK)
+            {
+                set_error(res);
+                return (written <= 0) ? -res : written;
+            }
+
+            set_error(STATUS_OK);
             return written;
         }
 
@@ -272,77 +331,94 @@ namespace lsp
             if (pOS == NULL)
                 return -set_error(STATUS_CLOSED);
 
+            const uint8_t *p        = reinterpret_cast<const uint8_t *>(buf);
+            const size_t bytes      = bits >> 3;
             size_t written          = 0;
 
-        #ifdef LSP_UNALIGNED_MEMORY_SAFE
-            // x86 allows unaligned memory access, write with machine words first
-            const umword_t *wptr    = reinterpret_cast<const umword_t *>(buf);
-            size_t blocks           = bits & (~((sizeof(umword_t) << 3) - 1));
-            for ( ; written < blocks; written += sizeof(umword_t)*8)
+            // Write whole bytes
+            if (bytes > 0)
             {
-                status_t res            = writev(BE_TO_CPU(*(wptr++)), sizeof(umword_t)*8);
-                if (res != STATUS_OK)
-                {
-                    set_error(res);
-                    return (written <= 0) ? -res : written;
-                }
+                const ssize_t n         = write(p, bytes);
+                if (n < 0)
+                    return n;
+                written                 = n << 3;
+                if (size_t(n) < bytes)
+                    return written;
             }
 
-            buf                     = wptr;
-        #endif /* LSP_UNALIGNED_MEMORY_SAFE */
-
-            // Write the rest data with bytes
-            const uint8_t *bptr     = reinterpret_cast<const uint8_t *>(buf);
-            while (written < bits)
+            // Write the tail
+            if (written < bits)
             {
-                size_t to_write         = lsp_min(sizeof(uint8_t) * 8, bits - written);
-                status_t res            = writev(*(bptr++), to_write);
+                const status_t res      = write_bits(p[bytes], bits - written);
                 if (res != STATUS_OK)
                 {
                     set_error(res);
                     return (written <= 0) ? -res : written;
                 }
-                written                += to_write;
+                written                 = bits;
             }
 
+            set_error(STATUS_OK);
             return written;
         }
 
-        status_t OutBitStream::do_flush_buffer()
+        status_t OutBitStream::flush_data()
         {
-            if (nBits == 0)
-                return set_error(STATUS_OK);
+            size_t offset   = 0;
+            while (offset < nDataSize)
+            {
+                const ssize_t n = pOS->write(&vData[offset], nDataSize - offset);
+                if (n <= 0)
+                {
+                    // Keep the data that has not been written
+                    if (offset > 0)
+                    {
+                        memmove(vData, &vData[offset], nDataSize - offset);
+                        nDataSize      -= offset;
+                    }
+                    return (n < 0) ? status_t(-n) : STATUS_IO_ERROR;
+                }
+                offset         += n;
+            }
 
-            size_t written, bytes;
-            umword_t buf;
+            nDataSize       = 0;
+            return STATUS_OK;
+        }
 
-            if (nBits == sizeof(umword_t) * 8)
+        status_t OutBitStream::spill()
+        {
+            // Ensure that there is enough space for the whole word
+            if (nDataSize > (BITSTREAM_DATASZ - sizeof(uint64_t)))
             {
-                buf         = CPU_TO_BE(nBuffer);
-                written     = pOS->write(&buf, sizeof(umword_t));
-
-                if (written != sizeof(umword_t))
-                    return -set_error(status_t(-written));
+                status_t res = flush_data();
+                if (res != STATUS_OK)
+                    return res;
             }
-            else
-            {
-                uint8_t data[sizeof(umword_t)];
 
-                bytes       = (nBits + 7) >> 3; // Overall number of bytes to write
-                buf         = nBuffer << (BITSTREAM_BUFSZ - nBits);
-                size_t s    = BITSTREAM_BUFSZ - 8;
+            // Store the whole word and account only complete bytes, the
+            // double shift allows to handle empty cache
+            const uint64_t v    = CPU_TO_BE((nBuffer << 1) << (BITSTREAM_BUFSZ - 1 - nBits));
+            memcpy(&vData[nDataSize], &v, sizeof(v));
+            nDataSize          += nBits >> 3;
+            nBits              &= 7;
 
-                for (size_t i=0; i<bytes; ++i, s -= 8)
-                    data[i]     = buf >> s;
+            return STATUS_OK;
+        }
 
-                written     = pOS->write(data, bytes);
-                if (written != bytes)
-                    return -set_error(status_t(-written));
-            }
+        status_t OutBitStream::do_flush_buffer()
+        {
+            status_t res    = spill();
+            if (res != STATUS_OK)
+                return set_error(res);
 
-            nBits       = 0;
+            // Pad the last incomplete byte with zeros
+            if (nBits > 0)
+            {
+                vData[nDataSize++]  = uint8_t(nBuffer << (8 - nBits));
+                nBits               = 0;
+            }
 
-            return set_error(STATUS_OK);
+            return set_error(flush_data());
         }
 
         status_t OutBitStream::flush()
@@ -353,92 +429,167 @@ namespace lsp
             return do_flush_buffer();
         }
 
+        inline status_t OutBitStream::write_bits(uint64_t value, size_t bits)
+        {
+            // The cache always keeps at least one bit free, this allows spill() to
+            // handle any number of bits stored without undefined behaviour
+            if ((nBits + bits) >= BITSTREAM_BUFSZ)
+            {
+                status_t res = spill();
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            nBuffer     = (nBuffer << bits) | (value & ((uint64_t(1) << bits) - 1));
+            nBits      += bits;
+
+            return STATUS_OK;
+        }
+
         status_t OutBitStream::bwrite(bool value)
         {
-            status_t res;
             if (pOS == NULL)
                 return set_error(STATUS_CLOSED);
 
-            // Need to flush?
-            if (nBits >= BITSTREAM_BUFSZ)
+            return set_error(write_bits(value, 1));
+        }
+
+        status_t OutBitStream::writev(uint32_t value, size_t bits)
+        {
+            if (pOS == NULL)
+                return set_error(STATUS_CLOSED);
+
+            return set_error(write_bits(value, lsp_min(bits, BITSTREAM_BUFSZ32)));
+        }
+
+        status_t OutBitStream::writev(uint64_t value, size_t bits)
+        {
+            if (pOS == NULL)
+                return set_error(STATUS_CLOSED);
+
+            // Need to write high part?
+            bits            = lsp_min(bits, BITSTREAM_BUFSZ);
+            if (bits > BITSTREAM_BUFSZ32)
             {
-                if ((res = flush()) != STATUS_OK)
-                    return res;
+                status_t res = write_bits(value >> BITSTREAM_BUFSZ32, bits - BITSTREAM_BUFSZ32);
+                if (res != STATUS_OK)
+                    return set_error(res);
+                bits            = BITSTREAM_BUFSZ32;
             }
 
-            nBuffer     = (nBuffer << 1) | umword_t(value);
-            ++nBits;
-
-            return set_error(STATUS_OK);
+            // Write low part
+            return set_error(write_bits(value, bits));
         }
 
-        status_t OutBitStream::writev(uint32_t value, size_t bits)
+        template <class T>
+        status_t OutBitStream::write_array(const T *src, size_t count, size_t bits)
         {
-            status_t res;
             if (pOS == NULL)
                 return set_error(STATUS_CLOSED);
 
-            value  <<= BITSTREAM_BUFSZ32 - bits;
-            while (bits > 0)
+            bits            = lsp_min(bits, sizeof(T) * 8);
+            status_t res    = STATUS_OK;
+
+            if (bits > BITSTREAM_BUFSZ32)
             {
-                // Need to flush?
-                if (nBits >= BITSTREAM_BUFSZ)
+                for (size_t i=0; (res == STATUS_OK) && (i<count); ++i)
                 {
-                    if ((res = flush()) != STATUS_OK)
-                        return res;
+                    const uint64_t v    = src[i];
+                    if ((res = write_bits(v >> BITSTREAM_BUFSZ32, bits - BITSTREAM_BUFSZ32)) == STATUS_OK)
+                        res                 = write_bits(v, BITSTREAM_BUFSZ32);
                 }
-
-                size_t avail    = lsp_min(bits, BITSTREAM_BUFSZ - nBits);
-                nBuffer         = (avail < BITSTREAM_BUFSZ) ? (nBuffer << avail) | (value >> (BITSTREAM_BUFSZ32 - avail)) : value;
-                nBits          += avail;
-                bits           -= avail;
-                value         <<= avail;
+            }
+            else
+            {
+                for (size_t i=0; (res == STATUS_OK) && (i<count); ++i)
+                    res                 = write_bits(src[i], bits);
             }
 
-            return set_error(STATUS_OK);
+            return set_error(res);
         }
 
-        status_t OutBitStream::writev(uint64_t value, size_t bits)
+        status_t OutBitStream::writen(const uint8_t *src, size_t count, size_t bits)
+        {
+            return write_array(src, count, bits);
+        }
+
+        status_t OutBitStream::writen(const uint16_t *src, size_t count, size_t bits)
         {
-            status_t res;
+            return write_array(src, count, bits);
+        }
+
+        status_t OutBitStream::writen(const uint32_t *src, size_t count, size_t bits)
+        {
+            return write_array(src, count, bits);
+        }
 
-            #if defined(ARCH_32BIT)
-                // Need to write high part?
-                if (bits > BITSTREAM_BUFSZ32)
+        status_t OutBitStream::writen(const uint64_t *src, size_t count, size_t bits)
+        {
+            return write_array(src, count, bits);
+        }
+
+        status_t OutBitStream::write_varint(uint64_t value, size_t bits, size_t step)
+        {
+            do
+            {
+                // Each group consists of the continuation flag and data bits
+                if (bits >= BITSTREAM_GROUP)
+                    return STATUS_OVERFLOW;
+
+                const uint64_t max  = uint64_t(1) << bits;
+                const uint64_t b    = (value >= max) ? max | (value & (max - 1)) : value;
+                const size_t group  = bits + 1;
+
+                if ((nBits + group) >= BITSTREAM_BUFSZ)
                 {
-                    if ((res = writev(uint32_t(value >> BITSTREAM_BUFSZ32), bits - BITSTREAM_BUFSZ32)) != STATUS_OK)
+                    status_t res = spill();
+                    if (res != STATUS_OK)
                         return res;
-                    bits    = BITSTREAM_BUFSZ32;
                 }
+                nBuffer             = (nBuffer << group) | b;
+                nBits              += group;
 
-                // Write low part
-                return writev(uint32_t(value), bits);
-            #else
-                if (pOS == NULL)
-                    return set_error(STATUS_CLOSED);
+                value             >>= bits;
+                bits               += step;
+            } while (value > 0);
 
-                value  <<= (BITSTREAM_BUFSZ - bits);
-                while (bits > 0)
-                {
-                    // Need to flush?
-                    if (nBits >= BITSTREAM_BUFSZ)
-                    {
-                        if ((res = flush()) != STATUS_OK)
-                            return res;
-                    }
+            return STATUS_OK;
+        }
 
-                    size_t avail    = lsp_min(bits, BITSTREAM_BUFSZ - nBits);
-                    nBuffer         = (avail < BITSTREAM_BUFSZ) ? (nBuffer << avail) | (value >> (BITSTREAM_BUFSZ - avail)) : value;
-                    nBits          += avail;
-                    bits           -= avail;
-                    value         <<= avail;
-                }
+        status_t OutBitStream::writevar(uint64_t value, size_t bits, size_t step)
+        {
+            if (pOS == NULL)
+                return set_error(STATUS_CLOSED);
+            if ((bits <= 0) && (step <= 0))
+                return set_error(STATUS_BAD_ARGUMENTS);
 
-                return set_error(STATUS_OK);
-            #endif /* ARCH_32BIT */
+            return set_error(write_varint(value, bits, step));
         }
 
-    } /* namespace io */
-} /* namespace lsp */
+        template <class T>
+        status_t OutBitStream::write_varint(const T *src, size_t count, size_t bits, size_t step)
+        {
+            if (pOS == NULL)
+                return set_error(STATUS_CLOSED);
+            if ((bits <= 0) && (step <= 0))
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            status_t res    = STATUS_OK;
+            for (size_t i=0; (res == STATUS_OK) && (i<count); ++i)
+                res             = write_varint(uint64_t(src[i]), bits, step);
+
+            return set_error(res);
+        }
+
+        status_t OutBitStream::writevar(const uint32_t *src, size_t count, size_t bits, size_t step)
+        {
+            return write_varint(src, count, bits, step);
+        }
 
+        status_t OutBitStream::writevar(const uint64_t *src, size_t count, size_t bits, size_t step)
+        {
+            return write_varint(src, count, bits, step);
+        }
 
+    } /* namespace io */
+} /* namespace lsp */
@@ -0,0 +1,432 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/OutBufStream.h>
+#include <lsp-plug.in/io/OutFileStream.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        OutBufStream::OutBufStream(size_t buf_size)
+        {
+            pOS         = NULL;
+            vBuffer     = NULL;
+            nBufCap     = uint32_t(buf_size);
+            nBufSize    = 0;
+            nPosition   = 0;
+            nWrapFlags  = 0;
+            enPolicy    = FLUSH_FULL;
+        }
+
+        OutBufStream::~OutBufStream()
+        {
+            do_close();
+        }
+
+        bool OutBufStream::init_buffer()
+        {
+            if (nBufCap <= 0)
+                return false;
+
+            if (vBuffer == NULL)
+            {
+                vBuffer     = static_cast<uint8_t *>(malloc(nBufCap));
+                if (vBuffer == NULL)
+                    return false;
+            }
+
+            nBufSize    = 0;
+
+            return true;
+        }
+
+        status_t OutBufStream::flush_buffer()
+        {
+            size_t offset   = 0;
+            status_t res    = STATUS_OK;
+
+            while (offset < nBufSize)
+            {
+                const ssize_t n = pOS->write(&vBuffer[offset], nBufSize - offset);
+                if (n <= 0)
+                {
+                    res             = (n < 0) ? status_t(-n) : STATUS_IO_ERROR;
+                    break;
+                }
+                offset         += n;
+            }
+
+            // Keep the data that has not been written in the buffer
+            if ((offset > 0) && (offset < nBufSize))
+                memmove(vBuffer, &vBuffer[offset], nBufSize - offset);
+            nBufSize       -= uint32_t(offset);
+            nPosition      += offset;
+
+            return res;
+        }
+
+        ssize_t OutBufStream::write_direct(const void *buf, size_t count)
+        {
+            const uint8_t *src  = static_cast<const uint8_t *>(buf);
+            size_t written      = 0;
+
+            while (written < count)
+            {
+                const ssize_t n = pOS->write(&src[written], count - written);
+                if (n <= 0)
+                {
+                    if (written > 0)
+                        break;
+                    return (n < 0) ? n : -STATUS_IO_ERROR;
+                }
+                written        += n;
+            }
+
+            nPosition      += written;
+            return written;
+        }
+
+        status_t OutBufStream::do_close()
+        {
+            status_t res = STATUS_OK, tres;
+
+            if (pOS != NULL)
+            {
+                // Flush pending data
+                res     = flush_buffer();
+
+                // Perform close
+                if (nWrapFlags & WRAP_CLOSE)
+                {
+                    tres    = pOS->close();
+                    if (res == STATUS_OK)
+                        res     = tres;
+                }
+                if (nWrapFlags & WRAP_DELETE)
+                    delete pOS;
+                pOS         = NULL;
+            }
+            nWrapFlags  = 0;
+
+            // Free the buffer
+            if (vBuffer != NULL)
+            {
+                free(vBuffer);
+                vBuffer     = NULL;
+            }
+
+            nBufSize    = 0;
+            nPosition   = 0;
+
+            return res;
+        }
+
+        status_t OutBufStream::close()
+        {
+            if (pOS == NULL)
+                return set_error(STATUS_OK);
+
+            return set_error(do_close());
+        }
+
+        status_t OutBufStream::do_wrap(IOutStream *os, size_t flags)
+        {
+            // Obtain the position of the output stream
+            wssize_t pos = os->position();
+            if (pos < 0)
+            {
+                if (pos != -STATUS_NOT_IMPLEMENTED)
+                    return status_t(-pos);
+                else
+                    pos = 0;
+            }
+
+            // Store pointers
+            pOS         = os;
+            nWrapFlags  = flags;
+            nPosition   = pos;
+
+            return STATUS_OK;
+        }
+
+        status_t OutBufStream::open(const char *path, size_t mode)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return set_error(STATUS_NO_MEM);
+            return open(&tmp, mode);
+        }
+
+        status_t OutBufStream::open(const LSPString *path, size_t mode)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+            if (!init_buffer())
+                return set_error(STATUS_NO_MEM);
+
+            status_t res;
+
+            OutFileStream *ofs = new OutFileStream();
+            if (ofs == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            if ((res = ofs->open(path, mode)) == STATUS_OK)
+                res     = do_wrap(ofs, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                ofs->close();
+                delete ofs;
+            }
+
+            return set_error(res);
+        }
+
+        status_t OutBufStream::open(const Path *path, size_t mode)
+        {
+            if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+            return open(path->as_string(), mode);
+        }
+
+        status_t OutBufStream::wrap(FILE *fd, bool close)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (fd == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+            if (!init_buffer())
+                return set_error(STATUS_NO_MEM);
+
+            status_t res;
+
+            OutFileStream *ofs = new OutFileStream();
+            if (ofs == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            if ((res = ofs->wrap(fd, close)) == STATUS_OK)
+                res     = do_wrap(ofs, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                ofs->close();
+                delete ofs;
+            }
+
+            return set_error(res);
+        }
+
+        status_t OutBufStream::wrap_native(fhandle_t fd, bool close)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            if (!init_buffer())
+                return set_error(STATUS_NO_MEM);
+
+            status_t res;
+
+            OutFileStream *ofs = new OutFileStream();
+            if (ofs == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            if ((res = ofs->wrap_native(fd, close)) == STATUS_OK)
+                res     = do_wrap(ofs, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                ofs->close();
+                delete ofs;
+            }
+
+            return set_error(res);
+        }
+
+        status_t OutBufStream::wrap(File *fd, size_t flags)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (fd == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+            if (!init_buffer())
+                return set_error(STATUS_NO_MEM);
+
+            status_t res;
+
+            OutFileStream *ofs = new OutFileStream();
+            if (ofs == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            if ((res = ofs->wrap(fd, flags)) == STATUS_OK)
+                res     = do_wrap(ofs, WRAP_CLOSE | WRAP_DELETE);
+
+            if (res != STATUS_OK)
+            {
+                ofs->close();
+                delete ofs;
+            }
+
+            return set_error(res);
+        }
+
+        status_t OutBufStream::wrap(IOutStream *os, size_t flags)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (os == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            if (!init_buffer())
+                return set_error(STATUS_NO_MEM);
+
+            return set_error(do_wrap(os, flags));
+        }
+
+        void OutBufStream::set_flush_policy(flush_policy_t policy)
+        {
+            enPolicy        = policy;
+        }
+
+        wssize_t OutBufStream::position()
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            set_error(STATUS_OK);
+            return nPosition + nBufSize;
+        }
+
+        ssize_t OutBufStream::write(const void *buf, size_t count)
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+            else if (buf == NULL)
+                return -set_error(STATUS_BAD_ARGUMENTS);
+
+            status_t res;
+            const uint8_t *src  = static_cast<const uint8_t *>(buf);
+
+            // Drop the buffer contents if there is not enough space for new data
+            if ((nBufSize + count) > nBufCap)
+            {
+                if ((res = flush_buffer()) != STATUS_OK)
+                    return -set_error(res);
+
+                // Pass large writes directly to the underlying stream
+                if (count >= nBufCap)
+                {
+                    const ssize_t written = write_direct(src, count);
+                    set_error((written < 0) ? status_t(-written) : STATUS_OK);
+                    return written;
+                }
+            }
+
+            // Append data to the buffer
+            memcpy(&vBuffer[nBufSize], src, count);
+            nBufSize       += uint32_t(count);
+
+            // Apply flush policy
+            if ((enPolicy == FLUSH_ALWAYS) ||
+                ((enPolicy == FLUSH_LINE) && (memchr(src, '\n', count) != NULL)))
+            {
+                // The data is already accepted by the buffer, the error will be reported later
+                // by subsequent write(), flush(), seek() or close() calls
+                set_error(flush_buffer());
+            }
+            else
+                set_error(STATUS_OK);
+
+            return count;
+        }
+
+        status_t OutBufStream::write_byte(int v)
+        {
+            if (pOS == NULL)
+                return set_error(STATUS_CLOSED);
+
+            status_t res;
+            if (nBufSize >= nBufCap)
+            {
+                if ((res = flush_buffer()) != STATUS_OK)
+                    return set_error(res);
+            }
+
+            vBuffer[nBufSize++] = uint8_t(v);
+
+            // Apply flush policy
+            if ((enPolicy == FLUSH_ALWAYS) ||
+                ((enPolicy == FLUSH_LINE) && (uint8_t(v) == '\n')))
+                set_error(flush_buffer());
+            else
+                set_error(STATUS_OK);
+
+            return STATUS_OK;
+        }
+
+        wssize_t OutBufStream::seek(wsize_t position)
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            // Seeking to the current position does not require any action
+            if (position == nPosition + nBufSize)
+            {
+                set_error(STATUS_OK);
+                return position;
+            }
+
+            // Write all pending data before changing the position
+            status_t res = flush_buffer();
+            if (res != STATUS_OK)
+                return -set_error(res);
+
+            const wssize_t pos = pOS->seek(position);
+            if (pos < 0)
+                return -set_error(status_t(-pos));
+
+            nPosition       = pos;
+            set_error(STATUS_OK);
+
+            return pos;
+        }
+
+        status_t OutBufStream::flush()
+        {
+            if (pOS == NULL)
+                return set_error(STATUS_CLOSED);
+
+            status_t res = flush_buffer();
+            if (res != STATUS_OK)
+                return set_error(res);
+
+            return set_error(pOS->flush());
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/OutChecksumStream.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        OutChecksumStream::OutChecksumStream(checksum_t type, uint64_t seed):
+            sChecksum(type, seed)
+        {
+            pOS         = NULL;
+            nWrapFlags  = 0;
+        }
+
+        OutChecksumStream::~OutChecksumStream()
+        {
+            do_close();
+        }
+
+        status_t OutChecksumStream::do_close()
+        {
+            status_t res = STATUS_OK;
+
+            if (pOS != NULL)
+            {
+                if (nWrapFlags & WRAP_CLOSE)
+                    res = pOS->close();
+                if (nWrapFlags & WRAP_DELETE)
+                    delete pOS;
+                pOS         = NULL;
+            }
+            nWrapFlags  = 0;
+
+            return res;
+        }
+
+        status_t OutChecksumStream::close()
+        {
+            return set_error(do_close());
+        }
+
+        status_t OutChecksumStream::wrap(IOutStream *os, size_t flags)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (os == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            pOS         = os;
+            nWrapFlags  = flags;
+            sChecksum.reset();
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t OutChecksumStream::set_checksum(checksum_t type, uint64_t seed)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            return set_error(sChecksum.init(type, seed));
+        }
+
+        wssize_t OutChecksumStream::position()
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+            wssize_t res = pOS->position();
+            set_error((res < 0) ? status_t(-res) : STATUS_OK);
+            return res;
+        }
+
+        ssize_t OutChecksumStream::write(const void *buf, size_t count)
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            ssize_t res = pOS->write(buf, count);
+            if (res > 0)
+                sChecksum.update(buf, res);
+            set_error((res < 0) ? status_t(-res) : STATUS_OK);
+            return res;
+        }
+
+        status_t OutChecksumStream::flush()
+        {
+            if (pOS == NULL)
+                return set_error(STATUS_CLOSED);
+            return set_error(pOS->flush());
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/OutCompressedStream.h>
+#include <lsp-plug.in/io/OutFileStream.h>
+#include <lsp-plug.in/io/Checksum.h>
+#include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/resource/codec.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/io/compressed.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        OutCompressedStream::OutCompressedStream(size_t log_block_size)
+        {
+            pOS         = NULL;
+            nWrapFlags  = 0;
+            vBlock      = NULL;
+            nLogBlock   = lsp_limit(log_block_size, compressed::LOG_BLOCK_MIN, compressed::LOG_BLOCK_MAX);
+            nBlockSize  = 0;
+            nPosition   = 0;
+            nOutput     = 0;
+            bHeader     = false;
+        }
+
+        OutCompressedStream::~OutCompressedStream()
+        {
+            do_close();
+        }
+
+        status_t OutCompressedStream::do_close()
+        {
+            status_t res = STATUS_OK, tres;
+
+            if (pOS != NULL)
+            {
+                if (nWrapFlags & WRAP_CLOSE)
+                    res = pOS->close();
+                if (nWrapFlags & WRAP_DELETE)
+                    delete pOS;
+                pOS         = NULL;
+            }
+            nWrapFlags  = 0;
+
+            tres        = sBits.close();
+            if (res == STATUS_OK)
+                res         = tres;
+            sData.drop();
+            sBuffer.destroy();
+
+            if (vBlock != NULL)
+            {
+                free(vBlock);
+                vBlock      = NULL;
+            }
+            nBlockSize  = 0;
+            bHeader     = false;
+
+            return res;
+        }
+
+        status_t OutCompressedStream::close()
+        {
+            status_t res = STATUS_OK;
+
+            if (pOS != NULL)
+            {
+                // Emit pending data and the terminating block header
+                res = emit_block(vBlock, nBlockSize);
+                if ((res == STATUS_OK) && (!bHeader))
+                    res = write_header();
+                if (res == STATUS_OK)
+                {
+                    compressed::block_header_t hdr;
+                    bzero(&hdr, sizeof(hdr));
+                    res = emit(&hdr, sizeof(hdr));
+                }
+                if (res == STATUS_OK)
+                    res = pOS->flush();
+            }
+
+            const status_t tres = do_close();
+            return set_error((res == STATUS_OK) ? tres : res);
+        }
+
+        status_t OutCompressedStream::wrap(IOutStream *os, size_t flags)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (os == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            const size_t block_size = size_t(1) << nLogBlock;
+            uint8_t *block  = static_cast<uint8_t *>(malloc(block_size));
+            if (block == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            status_t res    = sBuffer.init(lsp_min(nLogBlock, compressed::LOG_WINDOW_MAX));
+            sBuffer.depth   = compressed::SEARCH_DEPTH;
+            if (res == STATUS_OK)
+                res             = sBits.wrap(&sData, WRAP_NONE);
+            if (res != STATUS_OK)
+            {
+                sBits.close();
+                sBuffer.destroy();
+                free(block);
+                return set_error(res);
+            }
+
+            pOS         = os;
+            nWrapFlags  = flags;
+            vBlock      = block;
+            nBlockSize  = 0;
+            nPosition   = 0;
+            nOutput     = 0;
+            bHeader     = false;
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t OutCompressedStream::open(const char *path, size_t mode)
+        {
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return set_error(STATUS_NO_MEM);
+            return open(&tmp, mode);
+        }
+
+        status_t OutCompressedStream::open(const LSPString *path, size_t mode)
+        {
+            if (pOS != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            OutFileStream *f = new OutFileStream();
+            if (f == NULL)
+                return set_error(STATUS_NO_MEM);
+            status_t res = f->open(path, mode);
+            if (res != STATUS_OK)
+            {
+                f->close();
+                delete f;
+                return set_error(res);
+            }
+
+            res = wrap(f, WRAP_CLOSE | WRAP_DELETE);
+            if (res != STATUS_OK)
+            {
+                f->close();
+                delete f;
+                return set_error(res);
+            }
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t OutCompressedStream::open(const Path *path, size_t mode)
+        {
+            return open(path->as_string(), mode);
+        }
+
+        status_t OutCompressedStream::emit(const void *buf, size_t count)
+        {
+            const uint8_t *ptr  = static_cast<const uint8_t *>(buf);
+            while (count > 0)
+            {
+                const ssize_t n     = pOS->write(ptr, count);
+                if (n <= 0)
+                    return (n < 0) ? status_t(-n) : STATUS_IO_ERROR;
+                ptr                += n;
+                count              -= n;
+                nOutput            += n;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t OutCompressedStream::write_header()
+        {
+            compressed::stream_header_t hdr;
+            memcpy(hdr.magic, compressed::MAGIC, sizeof(hdr.magic));
+            hdr.version     = compressed::VERSION;
+            hdr.log_block   = uint8_t(nLogBlock);
+            hdr.reserved    = 0;
+
+            status_t res    = emit(&hdr, sizeof(hdr));
+            if (res == STATUS_OK)
+                bHeader         = true;
+            return res;
+        }
+
+        status_t OutCompressedStream::emit_block(const uint8_t *data, size_t size)
+        {
+            if (size <= 0)
+                return STATUS_OK;
+
+            status_t res;
+            if ((!bHeader) && ((res = write_header()) != STATUS_OK))
+                return res;
+
+            // Compress the block independently of previous blocks
+            sBuffer.clear();
+            sData.clear();
+            if ((res = resource::lz_encode(&sBuffer, &sBits, data, size)) != STATUS_OK)
+                return res;
+            if ((res = sBits.flush()) != STATUS_OK)
+                return res;
+
+            // Store the block as is if it does not compress
+            const bool stored   = sData.size() >= size;
+            const uint8_t *payload  = (stored) ? data : sData.data();
+            const size_t length = (stored) ? size : sData.size();
+
+            compressed::block_header_t hdr;
+            hdr.size            = CPU_TO_LE(uint32_t(size) | ((stored) ? compressed::BLOCK_STORED : 0));
+            hdr.payload         = CPU_TO_LE(uint32_t(length));
+            hdr.crc             = CPU_TO_LE(crc32c(0, data, size));
+
+            if ((res = emit(&hdr, sizeof(hdr))) != STATUS_OK)
+                return res;
+            return emit(payload, length);
+        }
+
+        wssize_t OutCompressedStream::position()
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+            set_error(STATUS_OK);
+            return nPosition;
+        }
+
+        ssize_t OutCompressedStream::write(const void *buf, size_t count)
+        {
+            if (pOS == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            const uint8_t *src      = static_cast<const uint8_t *>(buf);
+            const size_t block_size = size_t(1) << nLogBlock;
+            size_t written          = 0;
+            status_t res            = STATUS_OK;
+
+            while (written < count)
+            {
+                const size_t avail  = count - written;
+
+                // Compress whole blocks directly from the source buffer
+                if ((nBlockSize == 0) && (avail >= block_size))
+                {
+                    if ((res = emit_block(&src[written], block_size)) != STATUS_OK)
+                        break;
+                    written            += block_size;
+                    continue;
+                }
+
+                // Accumulate data in the block buffer
+                const size_t to_copy = lsp_min(avail, block_size - nBlockSize);
+                memcpy(&vBlock[nBlockSize], &src[written], to_copy);
+                nBlockSize         += to_copy;
+                written            += to_copy;
+
+                if (nBlockSize >= block_size)
+                {
+                    if ((res = emit_block(vBlock, nBlockSize)) != STATUS_OK)
+                    {
+                        // Keep the data that has been accepted, it will be emitted next time
+                        break;
+                    }
+                    nBlockSize          = 0;
+                }
+            }
+
+            nPosition  += written;
+            if ((res != STATUS_OK) && (written <= 0))
+                return -set_error(res);
+
+            set_error(res);
+            return written;
+        }
+
+        status_t OutCompressedStream::flush()
+        {
+            if (pOS == NULL)
+                return set_error(STATUS_CLOSED);
+
+            status_t res = emit_block(vBlock, nBlockSize);
+            if (res != STATUS_OK)
+                return set_error(res);
+            nBlockSize  = 0;
+
+            return set_error(pOS->flush());
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/OutDirectFileStream.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/io/DirectTransfer.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        OutDirectFileStream::OutDirectFileStream(AlignedBufferPool *pool)
+        {
+            pFD         = NULL;
+            pTransfer   = NULL;
+            pPool       = pool;
+            pLocalPool  = NULL;
+            vBuf[0]     = NULL;
+            vBuf[1]     = NULL;
+            nBufOffset  = 0;
+            nBufFill    = 0;
+            nPending    = 0;
+            nFileSize   = 0;
+            bDirect     = false;
+        }
+
+        OutDirectFileStream::~OutDirectFileStream()
+        {
+            if (pFD != NULL)
+                close();
+
+            if (pLocalPool != NULL)
+            {
+                delete pLocalPool;
+                pLocalPool  = NULL;
+            }
+        }
+
+        status_t OutDirectFileStream::do_close()
+        {
+            status_t res = STATUS_OK;
+
+            if (pTransfer != NULL)
+            {
+                pTransfer->stop();
+                delete pTransfer;
+                pTransfer   = NULL;
+            }
+
+            for (size_t i=0; i<2; ++i)
+            {
+                if (vBuf[i] != NULL)
+                {
+                    pPool->release(vBuf[i]);
+                    vBuf[i]     = NULL;
+                }
+            }
+
+            if (pFD != NULL)
+            {
+                res         = pFD->close();
+                delete pFD;
+                pFD         = NULL;
+            }
+
+            nBufOffset  = 0;
+            nBufFill    = 0;
+            nPending    = 0;
+            nFileSize   = 0;
+            bDirect     = false;
+
+            return res;
+        }
+
+        status_t OutDirectFileStream::close()
+        {
+            if (pFD == NULL)
+                return set_error(STATUS_CLOSED);
+
+            status_t res    = write_tail();
+            if (res == STATUS_OK)
+                res             = pFD->flush();
+
+            const status_t tres = do_close();
+            return set_error((res == STATUS_OK) ? tres : res);
+        }
+
+        status_t OutDirectFileStream::open(const char *path, size_t mode)
+        {
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return set_error(STATUS_NO_MEM);
+            return open(&tmp, mode);
+        }
+
+        status_t OutDirectFileStream::open(const Path *path, size_t mode)
+        {
+            return open(path->as_string(), mode);
+        }
+
+        status_t OutDirectFileStream::open(const LSPString *path, size_t mode)
+        {
+            if (pFD != NULL)
+                return set_error(STATUS_BAD_STATE);
+            else if (path == NULL)
+                return set_error(STATUS_BAD_ARGUMENTS);
+
+            // Create the buffer pool if it was not specified
+            if (pPool == NULL)
+            {
+                if ((pLocalPool = new AlignedBufferPool()) == NULL)
+                    return set_error(STATUS_NO_MEM);
+                pPool       = pLocalPool;
+            }
+
+            // Open the file, fall back to buffered I/O if direct I/O is not supported
+            pFD         = new NativeFile();
+            if (pFD == NULL)
+                return set_error(STATUS_NO_MEM);
+
+            // Reading is required to keep the existing data covered by the padding of the tail
+            mode        = (mode | File::FM_WRITE) & (~File::FM_DIRECT);
+            if (!(mode & File::FM_TRUNC))
+                mode       |= File::FM_READ;
+            bDirect     = true;
+            status_t res = pFD->open(path, mode | File::FM_DIRECT);
+            if (res == STATUS_INVALID_VALUE)
+            {
+                bDirect     = false;
+                res         = pFD->open(path, mode);
+            }
+            if (res != STATUS_OK)
+            {
+                do_close();
+                return set_error(res);
+            }
+
+            // The existing data that is not overwritten should be kept
+            const wssize_t size = pFD->size();
+            nFileSize   = lsp_max(size, 0);
+
+            // Allocate buffers and start background transfer
+            vBuf[0]     = pPool->acquire();
+            vBuf[1]     = pPool->acquire();
+            pTransfer   = new DirectTransfer();
+            if ((vBuf[0] == NULL) || (vBuf[1] == NULL) || (pTransfer == NULL))
+            {
+                do_close();
+                return set_error(STATUS_NO_MEM);
+            }
+
+            if ((res = pTransfer->start(pFD)) != STATUS_OK)
+            {
+                do_close();
+                return set_error(res);
+            }
+
+            return set_error(STATUS_OK);
+        }
+
+        status_t OutDirectFileStream::complete()
+        {
+            const ssize_t n     = pTransfer->wait();
+            const size_t count  = nPending;
+            nPending            = 0;
+
+            if (n < 0)
+                return status_t(-n);
+            return (size_t(n) == count) ? STATUS_OK : STATUS_IO_ERROR;
+        }
+
+        status_t OutDirectFileStream::submit()
+        {
+            status_t res    = complete();
+            if (res != STATUS_OK)
+                return res;
+
+            if ((res = pTransfer->write(vBuf[0], nBufOffset, nBufFill)) != STATUS_OK)
+                return res;
+
+            // Continue with another buffer while the data is being written
+            nPending        = nBufFill;
+            nBufOffset     += nBufFill;
+            nBufFill        = 0;
+            lsp::swap(vBuf[0], vBuf[1]);
+
+            return STATUS_OK;
+        }
+
+        status_t OutDirectFileStream::write_tail()
+        {
+            status_t res    = complete();
+            if ((res != STATUS_OK) || (nBufFill <= 0))
+                return res;
+
+            const wsize_t end   = nBufOffset + nBufFill;
+            if (!bDirect)
+            {
+                const ssize_t n     = pFD->pwrite(nBufOffset, vBuf[0], nBufFill);
+                if (n < 0)
+                    return status_t(-n);
+                return (size_t(n) == nBufFill) ? STATUS_OK : STATUS_IO_ERROR;
+            }
+
+            // Direct I/O allows only aligned transfers, pad the tail up to the aligned size
+            const size_t padded = align_size(nBufFill, pPool->alignment());
+            uint8_t *buf        = vBuf[0];
+            if (nFileSize > end)
+            {
+                // Keep the data of the file that is covered by padding
+                const ssize_t n     = pFD->pread(nBufOffset, vBuf[1], padded);
+                if ((n < 0) && (n != -STATUS_EOF))
+                    return status_t(-n);
+                const size_t filled = lsp_max(n, 0);
+                if (filled < padded)
+                    bzero(&vBuf[1][filled], padded - filled);
+                memcpy(vBuf[1], vBuf[0], nBufFill);
+                buf                 = vBuf[1];
+            }
+            else
+                bzero(&buf[nBufFill], padded - nBufFill);
+
+            const ssize_t n     = pFD->pwrite(nBufOffset, buf, padded);
+            if (n < 0)
+                return status_t(-n);
+            if (size_t(n) != padded)
+                return STATUS_IO_ERROR;
+
+            // Remove the padding
+            const wsize_t length = lsp_max(end, nFileSize);
+            if (nBufOffset + padded > length)
+                res                 = pFD->truncate(length);
+
+            nBufOffset          = end;
+            nBufFill            = 0;
+
+            return res;
+        }
+
+        wssize_t OutDirectFileStream::position()
+        {
+            if (pFD == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            set_error(STATUS_OK);
+            return nBufOffset + nBufFill;
+        }
+
+        ssize_t OutDirectFileStream::write(const void *buf, size_t count)
+        {
+            if (pFD == NULL)
+                return -set_error(STATUS_CLOSED);
+
+            const uint8_t *src      = static_cast<const uint8_t *>(buf);
+            const size_t buf_size   = pPool->buffer_size();
+            size_t done             = 0;
+            status_t res            = STATUS_OK;
+
+            while (done < count)
+            {
+                const size_t to_copy = lsp_min(count - done, buf_size - nBufFill);
+                memcpy(&vBuf[0][nBufFill], &src[done], to_copy);
+                nBufFill       += to_copy;
+                done           += to_copy;
+
+                if ((nBufFill >= buf_size) && ((res = submit()) != STATUS_OK))
+                    break;
+            }
+
+            if ((res != STATUS_OK) && (done <= 0))
+                return -set_error(res);
+
+            set_error(res);
+            return done;
+        }
+
+        status_t OutDirectFileStream::flush()
+        {
+            if (pFD == NULL)
+                return set_error(STATUS_CLOSED);
+
+            status_t res    = complete();
+            if (res != STATUS_OK)
+                return set_error(res);
+
+            // Write all complete aligned blocks
+            const size_t aligned = nBufFill & ~(pPool->alignment() - 1);
+            if (aligned > 0)
+            {
+                const ssize_t n     = pFD->pwrite(nBufOffset, vBuf[0], aligned);
+                if (n < 0)
+                    return set_error(status_t(-n));
+                if (size_t(n) != aligned)
+                    return set_error(STATUS_IO_ERROR);
+
+                nBufFill           -= aligned;
+                nBufOffset         += aligned;
+                if (nBufFill > 0)
+                    memmove(vBuf[0], &vBuf[0][aligned], nBufFill);
+            }
+
+            return set_error(pFD->flush());
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -1,6 +1,6 @@
 /*
- * Copyright (C) 2024 Linux Studio Plugins Project <https://lsp-plug.in/>
- *           (C) 2024 Vladimir Sadovnikov <sadko4u@gmail.com>
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
  *
  * This file is part of lsp-runtime-lib
  * Created on: 19 авг. 2019 г.
@@ -19,6 +19,7 @@
  * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
  */
 
+
 #include <lsp-plug.in/io/OutMemoryStream.h>
 #include <lsp-plug.in/stdlib/string.h>
 #include <stdlib.h>
@@ -27,23 +28,49 @@ namespace lsp
 {
     namespace io
     {
-        
+        static constexpr size_t DEFAULT_QUANTITY    = 0x1000;
+        static constexpr float  DEFAULT_GROWTH      = 1.5f;
+
         OutMemoryStream::OutMemoryStream()
         {
             pData       = NULL;
+            vChunks     = NULL;
             nSize       = 0;
             nCapacity   = 0;
-            nQuantity   = 0x1000;
+            nQuantity   = DEFAULT_QUANTITY;
+            nChunkSize  = 0;
+            nChunks     = 0;
+            nChunkCap   = 0;
             nPosition   = 0;
+            fGrowth     = DEFAULT_GROWTH;
         }
         
         OutMemoryStream::OutMemoryStream(size_t quantity)
         {
             pData       = NULL;
+            vChunks     = NULL;
+            nSize       = 0;
+            nCapacity   = 0;
+            nQuantity   = lsp_max(quantity, size_t(1));
+            nChunkSize  = 0;
+            nChunks     = 0;
+            nChunkCap   = 0;
+            nPosition   = 0;
+            fGrowth     = DEFAULT_GROWTH;
+        }
+
+        OutMemoryStream::OutMemoryStream(size_t quantity, float growth)
+        {
+            pData       = NULL;
+            vChunks     = NULL;
             nSize       = 0;
             nCapacity   = 0;
-            nQuantity   = quantity;
+            nQuantity   = lsp_max(quantity, size_t(1));
+            nChunkSize  = 0;
+            nChunks     = 0;
+            nChunkCap   = 0;
             nPosition   = 0;
+            fGrowth     = growth;
         }
 
         OutMemoryStream::~OutMemoryStream()
@@ -51,6 +78,46 @@ namespace lsp
             drop();
         }
 
+        inline uint8_t *OutMemoryStream::byte_at(size_t position)
+        {
+            return (nChunkSize > 0) ?
+                &vChunks[position / nChunkSize][position % nChunkSize] :
+                &pData[position];
+        }
+
+        void OutMemoryStream::set_growth(float growth)
+        {
+            fGrowth     = growth;
+        }
+
+        status_t OutMemoryStream::set_chunk_size(size_t chunk_size)
+        {
+            if (chunk_size == nChunkSize)
+                return set_error(STATUS_OK);
+            if (nSize > 0)
+                return set_error(STATUS_BAD_STATE);
+
+            drop();
+            nChunkSize  = chunk_size;
+
+            return set_error(STATUS_OK);
+        }
+
+        size_t OutMemoryStream::chunks() const
+        {
+            return (nChunkSize > 0) ? (nSize + nChunkSize - 1) / nChunkSize : 0;
+        }
+
+        const uint8_t *OutMemoryStream::chunk(size_t index, size_t *size) const
+        {
+            if (index >= chunks())
+                return NULL;
+
+            if (size != NULL)
+                *size       = lsp_min(nSize - index * nChunkSize, nChunkSize);
+            return vChunks[index];
+        }
+
         wssize_t OutMemoryStream::position()
         {
             return nPosition;
@@ -64,8 +131,26 @@ namespace lsp
                 return -res;
 
             // Append data
-            ::memcpy(&pData[nPosition], buf, count);
-            nPosition   = sz;
+            if (nChunkSize > 0)
+            {
+                const uint8_t *src  = static_cast<const uint8_t *>(buf);
+                for (size_t left = count; left > 0; )
+                {
+                    const size_t offset = nPosition % nChunkSize;
+                    const size_t to_copy= lsp_min(left, nChunkSize - offset);
+
+                    ::memcpy(&vChunks[nPosition / nChunkSize][offset], src, to_copy);
+                    src                += to_copy;
+                    nPosition          += to_copy;
+                    left               -= to_copy;
+                }
+            }
+            else
+            {
+                ::memcpy(&pData[nPosition], buf, count);
+                nPosition   = sz;
+            }
+
             if (nSize < sz)
                 nSize       = sz;
 
@@ -79,7 +164,7 @@ namespace lsp
             if (res != STATUS_OK)
                 return -res;
 
-            pData[nPosition++]  = v;
+            *byte_at(nPosition++)   = v;
             if (nSize < nPosition)
                 nSize       = nPosition;
             return 1;
@@ -91,7 +176,7 @@ namespace lsp
             if (res != STATUS_OK)
                 return STATUS_NO_MEM;
 
-            pData[nPosition++]  = v;
+            *byte_at(nPosition++)   = v;
             if (nSize < nPosition)
                 nSize       = nPosition;
             return STATUS_OK;
@@ -113,6 +198,24 @@ namespace lsp
         uint8_t *OutMemoryStream::release()
         {
             uint8_t *data   = pData;
+
+            // Build contiguous buffer from chunks
+            if (nChunkSize > 0)
+            {
+                data            = NULL;
+                if (nSize > 0)
+                {
+                    data            = static_cast<uint8_t *>(::malloc(nSize));
+                    if (data == NULL)
+                        return NULL;
+
+                    for (size_t i=0, offset=0; offset < nSize; ++i, offset += nChunkSize)
+                        ::memcpy(&data[offset], vChunks[i], lsp_min(nSize - offset, nChunkSize));
+                }
+
+                drop_chunks();
+            }
+
             pData           = NULL;
             nSize           = 0;
             nCapacity       = 0;
@@ -121,10 +224,52 @@ namespace lsp
             return data;
         }
 
+        uint8_t **OutMemoryStream::release_chunks(size_t *size, size_t *count)
+        {
+            if ((nChunkSize <= 0) || (nSize <= 0))
+                return NULL;
+
+            // Free chunks that do not contain data
+            const size_t used   = chunks();
+            for (size_t i=used; i<nChunks; ++i)
+                ::free(vChunks[i]);
+
+            uint8_t **list      = vChunks;
+            if (size != NULL)
+                *size               = nSize;
+            if (count != NULL)
+                *count              = used;
+
+            vChunks         = NULL;
+            nChunks         = 0;
+            nChunkCap       = 0;
+            nSize           = 0;
+            nCapacity       = 0;
+            nPosition       = 0;
+
+            return list;
+        }
+
+        void OutMemoryStream::drop_chunks()
+        {
+            if (vChunks == NULL)
+                return;
+
+            for (size_t i=0; i<nChunks; ++i)
+                ::free(vChunks[i]);
+            ::free(vChunks);
+
+            vChunks     = NULL;
+            nChunks     = 0;
+            nChunkCap   = 0;
+        }
+
         void OutMemoryStream::drop()
         {
             if (pData != NULL)
                 ::free(pData);
+            drop_chunks();
+
             pData       = NULL;
             nSize       = 0;
             nCapacity   = 0;
@@ -149,12 +294,46 @@ namespace lsp
             return true;
         }
 
+        status_t OutMemoryStream::reserve_chunks(size_t amount)
+        {
+            const size_t count  = (amount + nChunkSize - 1) / nChunkSize;
+
+            // Extend the list of chunks, only pointers are copied here
+            if (count > nChunkCap)
+            {
+                const size_t ncap   = lsp_max(lsp_max(count, nChunkCap * 2), size_t(16));
+                uint8_t **list      = static_cast<uint8_t **>(::realloc(vChunks, ncap * sizeof(uint8_t *)));
+                if (list == NULL)
+                    return set_error(STATUS_NO_MEM);
+                vChunks             = list;
+                nChunkCap           = ncap;
+            }
+
+            // Allocate new chunks
+            while (nChunks < count)
+            {
+                uint8_t *chunk      = static_cast<uint8_t *>(::malloc(nChunkSize));
+                if (chunk == NULL)
+                    return set_error(STATUS_NO_MEM);
+                vChunks[nChunks++]  = chunk;
+                nCapacity          += nChunkSize;
+            }
+
+            return set_error(STATUS_OK);
+        }
+
         status_t OutMemoryStream::reserve(size_t amount)
         {
             if (amount <= nCapacity)
                 return set_error(STATUS_OK);
+            if (nChunkSize > 0)
+                return reserve_chunks(amount);
+
+            // Grow geometrically to keep amortized cost of write() constant
+            size_t ncap = (fGrowth > 1.0f) ? size_t(nCapacity * fGrowth) : 0;
+            ncap        = lsp_max(ncap, amount);
+            ncap        = ((ncap + nQuantity - 1) / nQuantity) * nQuantity; // Quantify capacity
 
-            size_t ncap = ((amount + nQuantity - 1) / nQuantity) * nQuantity; // Quantify capacity
             uint8_t *p  = reinterpret_cast<uint8_t *>(::realloc(pData, ncap));
             if (p == NULL)
                 return set_error(STATUS_NO_MEM);
@@ -163,6 +342,34 @@ namespace lsp
             return set_error(STATUS_OK);
         }
 
+        wssize_t OutMemoryStream::sink(IOutStream *os)
+        {
+            if (os == NULL)
+                return -set_error(STATUS_BAD_ARGUMENTS);
+
+            wssize_t written    = 0;
+            for (size_t offset = 0; offset < nSize; )
+            {
+                const uint8_t *src  = byte_at(offset);
+                const size_t count  = (nChunkSize > 0) ?
+                    lsp_min(nSize - offset, nChunkSize - offset % nChunkSize) :
+                    nSize - offset;
+
+                const ssize_t n     = os->write(src, count);
+                if (n <= 0)
+                {
+                    const status_t res = (n < 0) ? status_t(-n) : STATUS_IO_ERROR;
+                    return (written > 0) ? written : -set_error(res);
+                }
+
+                offset             += n;
+                written            += n;
+            }
+
+            set_error(STATUS_OK);
+            return written;
+        }
+
         status_t OutMemoryStream::close()
         {
             return set_error(STATUS_OK);
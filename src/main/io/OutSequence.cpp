@@ -22,6 +22,7 @@
 #include <lsp-plug.in/io/charset.h>
 #include <lsp-plug.in/io/StdioFile.h>
 #include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/io/OutBufStream.h>
 #include <lsp-plug.in/io/OutFileStream.h>
 #include <lsp-plug.in/io/OutSequence.h>
 
@@ -213,7 +214,7 @@ namespace lsp
             else if (path == NULL)
                 return set_error(STATUS_BAD_ARGUMENTS);
 
-            OutFileStream *f = new OutFileStream();
+            OutBufStream *f = new OutBufStream();
             if (f == NULL)
                 return set_error(STATUS_NO_MEM);
             status_t res = f->open(path, mode);
@@ -663,46 +663,36 @@ namespace lsp
                 return STATUS_BAD_ARGUMENTS;
             else if (is_root())
                 return STATUS_BAD_STATE;
+            else if (path == &sPath)
+            {
+                // Self-reference, the data of the parent will be modified
+                LSPString tmp;
+                if (!tmp.set(path))
+                    return STATUS_NO_MEM;
+                return set_parent(&tmp);
+            }
 
-            LSPString tmp;
-            if (!tmp.set(path))
-                return STATUS_NO_MEM;
-            while (tmp.ends_with(FILE_SEPARATOR_C))
-                tmp.set_length(tmp.length() - 1);
+            // Insert the parent directly before the path
+            const lsp_wchar_t *s    = path->characters();
+            size_t len              = path->length();
+            while ((len > 0) && (s[len - 1] == FILE_SEPARATOR_C))
+                --len;
 
-            bool success = tmp.append(FILE_SEPARATOR_C);
-            if (success)
-                success = tmp.append(&sPath);
-            if (success)
+            if (!sPath.prepend(FILE_SEPARATOR_C))
+                return STATUS_NO_MEM;
+            if (!sPath.prepend(s, len))
             {
-                sPath.swap(&tmp);
-                fixup_path();
+                sPath.remove(0, 1);
+                return STATUS_NO_MEM;
             }
-            return (success) ? STATUS_OK : STATUS_NO_MEM;
+            fixup_path();
+
+            return STATUS_OK;
         }
 
         status_t Path::set_parent(const Path *path)
         {
-            if (path == NULL)
-                return STATUS_BAD_ARGUMENTS;
-            else if (is_root())
-                return STATUS_BAD_STATE;
-
-            LSPString tmp;
-            if (!tmp.set(&path->sPath))
-                return STATUS_NO_MEM;
-            while (tmp.ends_with(FILE_SEPARATOR_C))
-                tmp.set_length(tmp.length() - 1);
-
-            bool success = tmp.append(FILE_SEPARATOR_C);
-            if (success)
-                success = tmp.append(&sPath);
-            if (success)
-            {
-                sPath.swap(&tmp);
-                fixup_path();
-            }
-            return (success) ? STATUS_OK : STATUS_NO_MEM;
+            return (path != NULL) ? set_parent(&path->sPath) : STATUS_BAD_ARGUMENTS;
         }
 
         status_t Path::concat(const char *path)
@@ -737,48 +727,68 @@ namespace lsp
 
         status_t Path::append_child(const char *path)
         {
-            Path tmp;
-            status_t res = tmp.set(path);
-            if (res != STATUS_OK)
-                return res;
-            else if (tmp.is_empty())
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            else if (path[0] == '\0')
                 return STATUS_OK;
-            else if (tmp.is_absolute())
-                return STATUS_INVALID_VALUE;
 
+            // Append the child directly to the path and roll back on error
             size_t len = sPath.length();
             bool success = ((len <= 0) || (sPath.ends_with(FILE_SEPARATOR_C))) ? true : sPath.append(FILE_SEPARATOR_C);
+            size_t child = sPath.length();
             if (success)
-                success = sPath.append(&tmp.sPath);
-            if (success)
-                fixup_path();
-            else
+                success = sPath.append_utf8(path);
+            if (!success)
+            {
                 sPath.set_length(len);
+                return STATUS_NO_MEM;
+            }
 
-            return (success) ? STATUS_OK : STATUS_NO_MEM;
+            fixup_path();
+            if (is_absolute(&sPath, child))
+            {
+                sPath.set_length(len);
+                return STATUS_INVALID_VALUE;
+            }
+
+            return STATUS_OK;
         }
 
         status_t Path::append_child(const LSPString *path)
         {
-            Path tmp;
-            status_t res = tmp.set(path);
-            if (res != STATUS_OK)
-                return res;
-            else if (tmp.is_empty())
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            else if (path->is_empty())
                 return STATUS_OK;
-            else if (tmp.is_absolute())
-                return STATUS_INVALID_VALUE;
+            else if (path == &sPath)
+            {
+                // Self-reference, the data of the child will be modified
+                LSPString tmp;
+                if (!tmp.set(path))
+                    return STATUS_NO_MEM;
+                return append_child(&tmp);
+            }
 
+            // Append the child directly to the path and roll back on error
             size_t len = sPath.length();
             bool success = ((len <= 0) || (sPath.ends_with(FILE_SEPARATOR_C))) ? true : sPath.append(FILE_SEPARATOR_C);
+            size_t child = sPath.length();
             if (success)
-                success = sPath.append(&tmp.sPath);
-            if (success)
-                fixup_path();
-            else
+                success = sPath.append(path);
+            if (!success)
+            {
+                sPath.set_length(len);
+                return STATUS_NO_MEM;
+            }
+
+            fixup_path();
+            if (is_absolute(&sPath, child))
+            {
                 sPath.set_length(len);
+                return STATUS_INVALID_VALUE;
+            }
 
-            return (success) ? STATUS_OK : STATUS_NO_MEM;
+            return STATUS_OK;
         }
 
         status_t Path::append_child(const Path *path)
@@ -1223,6 +1233,17 @@ namespace lsp
             return state == S_SEEK;
         }
 
+        bool Path::is_absolute(const LSPString *path, size_t first)
+        {
+            if (first >= path->length())
+                return false;
+#if defined(PLATFORM_WINDOWS)
+            return !::PathIsRelativeW(reinterpret_cast<LPCWSTR>(path->get_utf16(first)));
+#else
+            return (path->char_at(first) == FILE_SEPARATOR_C);
+#endif
+        }
+
         bool Path::is_root() const
         {
 #if defined(PLATFORM_WINDOWS)
@@ -1356,10 +1377,12 @@ namespace lsp
         {
             if (path == NULL)
                 return STATUS_BAD_ARGUMENTS;
+
+            // Keep the destination untouched on error
             Path tmp;
-            status_t res = tmp.set(&sPath);
-            if (res == STATUS_OK)
-                res     = tmp.canonicalize();
+            if (!tmp.sPath.set(&sPath))
+                return STATUS_NO_MEM;
+            status_t res = tmp.canonicalize();
             if (res == STATUS_OK)
                 tmp.sPath.swap(path);
             return res;
@@ -1369,10 +1392,12 @@ namespace lsp
         {
             if (path == NULL)
                 return STATUS_BAD_ARGUMENTS;
+
+            // Keep the destination untouched on error
             Path tmp;
-            status_t res = tmp.set(&sPath);
-            if (res == STATUS_OK)
-                res     = tmp.canonicalize();
+            if (!tmp.sPath.set(&sPath))
+                return STATUS_NO_MEM;
+            status_t res = tmp.canonicalize();
             if (res == STATUS_OK)
                 tmp.swap(path);
             return res;
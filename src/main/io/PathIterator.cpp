@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/PathIterator.h>
+#include <lsp-plug.in/io/charset.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        static inline bool is_separator(lsp_wchar_t c)
+        {
+            return (c == '/') || (c == '\\');
+        }
+
+        PathIterator::PathIterator()
+        {
+            pHead       = NULL;
+            pTail       = NULL;
+            pFirst      = NULL;
+            pLast       = NULL;
+        }
+
+        PathIterator::PathIterator(const Path *path)
+        {
+            wrap(path);
+        }
+
+        PathIterator::PathIterator(const LSPString *path)
+        {
+            wrap(path);
+        }
+
+        PathIterator::PathIterator(const lsp_wchar_t *path, size_t length)
+        {
+            wrap(path, length);
+        }
+
+        PathIterator::~PathIterator()
+        {
+            pHead       = NULL;
+            pTail       = NULL;
+            pFirst      = NULL;
+            pLast       = NULL;
+        }
+
+        void PathIterator::wrap(const Path *path)
+        {
+            wrap((path != NULL) ? path->as_string() : NULL);
+        }
+
+        void PathIterator::wrap(const LSPString *path)
+        {
+            if (path != NULL)
+                wrap(path->characters(), path->length());
+            else
+                wrap(NULL, 0);
+        }
+
+        void PathIterator::wrap(const lsp_wchar_t *path, size_t length)
+        {
+            pHead       = path;
+            pTail       = (path != NULL) ? &path[length] : NULL;
+            pFirst      = pHead;
+            pLast       = pHead;
+        }
+
+        void PathIterator::rewind()
+        {
+            pFirst      = pHead;
+            pLast       = pHead;
+        }
+
+        bool PathIterator::next()
+        {
+            const lsp_wchar_t *p = pLast;
+            while ((p < pTail) && (is_separator(*p)))
+                ++p;
+
+            pFirst      = p;
+            while ((p < pTail) && (!is_separator(*p)))
+                ++p;
+            pLast       = p;
+
+            return pFirst < pLast;
+        }
+
+        bool PathIterator::is_last() const
+        {
+            if (pFirst >= pLast)
+                return false;
+
+            for (const lsp_wchar_t *p = pLast; p < pTail; ++p)
+                if (!is_separator(*p))
+                    return false;
+            return true;
+        }
+
+        bool PathIterator::is_absolute() const
+        {
+            if (pHead >= pTail)
+                return false;
+            if (is_separator(pHead[0]))
+                return true;
+#if defined(PLATFORM_WINDOWS)
+            // Path with the drive letter
+            return ((pTail - pHead) >= 2) && (pHead[1] == ':');
+#else
+            return false;
+#endif /* PLATFORM_WINDOWS */
+        }
+
+        bool PathIterator::equals(const lsp_wchar_t *s, size_t len) const
+        {
+            if (len != size_t(pLast - pFirst))
+                return false;
+
+            for (size_t i=0; i<len; ++i)
+                if (pFirst[i] != s[i])
+                    return false;
+            return true;
+        }
+
+        bool PathIterator::equals(const LSPString *s) const
+        {
+            return (s != NULL) ? equals(s->characters(), s->length()) : false;
+        }
+
+        bool PathIterator::equals_ascii(const char *s) const
+        {
+            if (s == NULL)
+                return false;
+
+            for (const lsp_wchar_t *p = pFirst; p < pLast; ++p, ++s)
+            {
+                if ((*s == '\0') || (*p != lsp_wchar_t(uint8_t(*s))))
+                    return false;
+            }
+            return *s == '\0';
+        }
+
+        bool PathIterator::equals_utf8(const char *s) const
+        {
+            if (s == NULL)
+                return false;
+
+            for (const lsp_wchar_t *p = pFirst; p < pLast; ++p)
+            {
+                // Fast path for ASCII characters
+                uint8_t c = uint8_t(*s);
+                if (c < 0x80)
+                {
+                    if ((c == 0) || (*p != c))
+                        return false;
+                    ++s;
+                    continue;
+                }
+
+                lsp_utf32_t cp = read_utf8_codepoint(&s);
+                if (*p != cp)
+                    return false;
+            }
+            return *s == '\0';
+        }
+
+        bool PathIterator::is_dot() const
+        {
+            return ((pLast - pFirst) == 1) && (pFirst[0] == '.');
+        }
+
+        bool PathIterator::is_dotdot() const
+        {
+            return ((pLast - pFirst) == 2) && (pFirst[0] == '.') && (pFirst[1] == '.');
+        }
+
+        bool PathIterator::is_dots() const
+        {
+            return is_dot() || is_dotdot();
+        }
+
+        status_t PathIterator::get(LSPString *dst) const
+        {
+            if (dst == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (pFirst >= pLast)
+                return STATUS_NOT_FOUND;
+
+            return (dst->set(pFirst, pLast - pFirst)) ? STATUS_OK : STATUS_NO_MEM;
+        }
+
+        status_t PathIterator::get_tail(LSPString *dst) const
+        {
+            if (dst == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            const lsp_wchar_t *p = pLast;
+            while ((p < pTail) && (is_separator(*p)))
+                ++p;
+
+            return (dst->set(p, pTail - p)) ? STATUS_OK : STATUS_NO_MEM;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
@@ -22,6 +22,10 @@
 #include <lsp-plug.in/io/PathPattern.h>
 #include <lsp-plug.in/io/charset.h>
 #include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <stdlib.h>
 
 #include <wctype.h>
 
@@ -38,12 +42,15 @@ namespace lsp
         {
             nFlags      = 0;
             pRoot       = NULL;
+            pDfa        = NULL;
         }
 
         PathPattern::~PathPattern()
         {
             destroy_cmd(pRoot);
+            destroy_dfa(pDfa);
             pRoot   = NULL;
+            pDfa    = NULL;
         }
 
         void PathPattern::destroy_cmd(cmd_t *cmd)
@@ -293,10 +300,11 @@ namespace lsp
                         // Require END-OF-GROUP token
                         tok = get_token(it);
                         if (tok == T_EOF)
-                            return -STATUS_EOF;
+                            res = STATUS_EOF;
                         else if (tok != T_GROUP_END)
-                            return -STATUS_BAD_FORMAT;
-                        next_token(it);
+                            res = STATUS_BAD_FORMAT;
+                        else
+                            next_token(it);
                         break;
 
                     case T_TEXT:
@@ -401,7 +409,10 @@ namespace lsp
 
                 // Merge command and parse next sub-expression
                 if ((res = merge_step(&out, next, CMD_AND)) == STATUS_OK)
-                    res = parse_not(&next, it);
+                {
+                    next                = NULL; // Now owned by the output expression
+                    res                 = parse_not(&next, it);
+                }
 
                 // Parse command
                 if (res != STATUS_OK)
@@ -436,7 +447,10 @@ namespace lsp
 
                 // Merge command and parse next sub-expression
                 if ((res = merge_step(&out, next, CMD_OR)) == STATUS_OK)
-                    res = parse_and(&next, it);
+                {
+                    next                = NULL; // Now owned by the output expression
+                    res                 = parse_and(&next, it);
+                }
 
                 // Parse command
                 if (res != STATUS_OK)
@@ -481,6 +495,10 @@ namespace lsp
                 else if (tok != T_EOF)
                     return STATUS_BAD_FORMAT;
 
+                // Compile the automaton, the backtracking matcher is used if it is too complex
+                const PathPattern *list = &tmp;
+                tmp.pDfa        = compile_dfa(&list, 1, flags & MATCH_CASE);
+
                 tmp.swap(this); // Apply new value on success
             }
 
@@ -567,12 +585,12 @@ namespace lsp
                                 pc = '`';
                                 break;
                         }
-                        if (lsp::to_lower(c) != lsp::to_lower(pc))
+                        if (lsp::to_casefold(c) != lsp::to_casefold(pc))
                             return false;
                         break;
 
                     default:
-                        if (lsp::to_lower(c) != lsp::to_lower(pc))
+                        if (lsp::to_casefold(c) != lsp::to_casefold(pc))
                             return false;
                         break;
                 } // switch
@@ -822,7 +840,7 @@ namespace lsp
                 const lsp_wchar_t *src  = sm->str->characters() + first;
                 const lsp_wchar_t *pat  = sm->pat->characters() + xc->nStart;
 
-                ssize_t loops           = last - first;
+                ssize_t loops           = last - first - xc->nChars + 1;
                 ssize_t match = (sm->flags & MATCH_CASE) ?
                         seek_pattern_case(pat, src, xc->nLength, loops) :
                         seek_pattern_nocase(pat, src, xc->nLength, loops);
@@ -849,7 +867,12 @@ namespace lsp
             {
                 r                       = sm->fixed.uget(i);
                 m                       = sm->var.uget(i);
-                if (!m->match(m, first, r->start - first))
+                if (m == NULL)
+                {
+                    if (ssize_t(r->start) != first)
+                        return false;
+                }
+                else if (!m->match(m, first, r->start - first))
                     return false;
                 first                   = r->start + r->cmd->nChars;
             }
@@ -954,15 +977,14 @@ namespace lsp
 
         bool PathPattern::brute_matcher_match(matcher_t *m, size_t start, size_t count)
         {
+            // The inversion is applied by the owning sequence matcher
             brute_matcher_t *bm = static_cast<brute_matcher_t *>(m);
-            const cmd_t *cmd    = bm->cmd;
 
             // Only one element?
             if (bm->items.size() <= 1)
             {
                 mregion_t *r            = bm->items.first();
-                bool match              = r->matcher->match(r->matcher, start, count);
-                return match ^ cmd->bInverse;
+                return r->matcher->match(r->matcher, start, count);
             }
 
             // Initialize positions
@@ -980,11 +1002,11 @@ namespace lsp
             {
                 bool match              = brute_match_variable(bm, start, count);
                 if (match)
-                    return !cmd->bInverse;
+                    return true;
 
                 // Try to search next fixed pattern
                 if (!brute_next_variable(bm, start, count))
-                    return cmd->bInverse;
+                    return false;
             }
 
             return false;
@@ -992,6 +1014,11 @@ namespace lsp
 
         bool PathPattern::add_range_matcher(sequence_matcher_t *sm, const pos_t *pos)
         {
+            // Empty range between two adjacent fixed patterns, it is
+            // stored as NULL matcher which matches only the empty string
+            if (pos->count <= 0)
+                return sm->var.add(static_cast<matcher_t *>(NULL));
+
             // Simple case (one command) ?
             const cmd_t *cmd    = sm->cmd;
             if (pos->count <= 1)
@@ -1300,6 +1327,912 @@ namespace lsp
             }
         }
 
+        //---------------------------------------------------------------------
+        // DFA compiler
+        //
+        // The command tree is translated into the extended regular expression
+        // that supports conjunction and negation, then the DFA is built by computing
+        // Brzozowski derivatives of the expression over the set of character classes.
+        // The '**/' command depends on the surrounding characters, so the 'beginning
+        // of string' and 'previous character is separator' flags become the part of
+        // the DFA state.
+        static constexpr size_t DFA_MAX_STATES          = 0x1000;
+        static constexpr size_t DFA_MAX_NODES           = 0x10000;
+        static constexpr size_t DFA_MAX_TRANSITIONS     = 0x100000;
+
+        static constexpr uint32_t DFA_CLASS_OTHER       = 0;        // Non-separator character without own class
+        static constexpr uint32_t DFA_CLASS_SEP         = 1;        // File separator
+        static constexpr uint32_t DFA_CLASS_CHAR        = 2;        // First class of literal characters
+
+        static constexpr size_t DFA_CTX_BOS             = 1 << 0;   // Beginning of the string
+        static constexpr size_t DFA_CTX_SEP             = 1 << 1;   // Previous character is a separator
+        static constexpr size_t DFA_CTX_EOS             = 1 << 2;   // End of the string
+
+        struct PathPattern::dfa_builder_t
+        {
+            enum xtype_t
+            {
+                X_NULL,             // Matches nothing
+                X_EMPTY,            // Matches empty string
+                X_ALL,              // Matches any string
+                X_BOS,              // Matches empty string at the beginning of the string
+                X_NONSEP,           // Any non-separator character
+                X_SEP,              // File separator
+                X_ANYPATH,          // Start of the '**/' match
+                X_ANYPATH_TAIL,     // Non-empty part of the '**/' match
+                X_CHAR,             // Literal character
+                X_STAR,             // Kleene star
+                X_CAT,              // Concatenation
+                X_OR,               // Disjunction
+                X_AND,              // Conjunction
+                X_NOT               // Negation
+            };
+
+            typedef struct xnode_t
+            {
+                uint32_t                    type;       // Node type
+                uint32_t                    value;      // Character class for X_CHAR
+                uint32_t                    first;      // Index of the first child
+                uint32_t                    count;      // Number of children
+                uint32_t                    hash;       // Hash code of the node
+                uint8_t                     nullable;   // Nullability for each combination of context flags
+                bool                        context;    // Node depends on context flags
+            } xnode_t;
+
+            lltl::darray<xnode_t>       vNodes;         // Expression nodes
+            lltl::darray<uint32_t>      vKids;          // Children of expression nodes
+            lltl::darray<lsp_wchar_t>   vChars;         // Literal characters, class is DFA_CLASS_CHAR + index
+            lltl::darray<uint32_t>      vStates;        // DFA states: expressions followed by context flags
+            lltl::darray<uint32_t>      vNext;          // Transition table
+            uint32_t                   *vIndex;         // Hash index of nodes
+            size_t                      nIndexCap;      // Capacity of the hash index of nodes
+            uint64_t                   *vMemoKey;       // Keys of computed derivatives
+            uint32_t                   *vMemoValue;     // Computed derivatives
+            size_t                      nMemoCap;       // Capacity of the derivative cache
+            size_t                      nMemoSize;      // Number of items in the derivative cache
+            uint32_t                   *vStateIndex;    // Hash index of states
+            size_t                      nStateCap;      // Capacity of the hash index of states
+            size_t                      nStateWords;    // Number of words per state
+            size_t                      nClasses;       // Number of character classes
+            bool                        bContext;       // Expressions depend on context flags
+            bool                        bMatchCase;     // Case-sensitive matching
+            bool                        bFailed;        // Limits exceeded or out of memory
+
+            explicit dfa_builder_t(bool match_case)
+            {
+                vIndex          = NULL;
+                nIndexCap       = 0;
+                vMemoKey        = NULL;
+                vMemoValue      = NULL;
+                nMemoCap        = 0;
+                nMemoSize       = 0;
+                vStateIndex     = NULL;
+                nStateCap       = 0;
+                nStateWords     = 0;
+                nClasses        = 0;
+                bContext        = false;
+                bMatchCase      = match_case;
+                bFailed         = false;
+
+                // Create predefined nodes, the node index matches the node type
+                for (uint32_t type = X_NULL; type <= X_ANYPATH_TAIL; ++type)
+                    intern(type, 0, NULL, 0);
+            }
+
+            dfa_builder_t(const dfa_builder_t &) = delete;
+            dfa_builder_t(dfa_builder_t &&) = delete;
+
+            ~dfa_builder_t()
+            {
+                free(vIndex);
+                free(vMemoKey);
+                free(vMemoValue);
+                free(vStateIndex);
+            }
+
+            dfa_builder_t & operator = (const dfa_builder_t &) = delete;
+            dfa_builder_t & operator = (dfa_builder_t &&) = delete;
+
+            static inline uint32_t hash_words(uint32_t h, const uint32_t *v, size_t count)
+            {
+                for (size_t i=0; i<count; ++i)
+                    h               = (h ^ v[i]) * 0x01000193;
+                return h ^ (h >> 15);
+            }
+
+            static inline size_t hash_memo(uint64_t key)
+            {
+                return size_t((key * 0x9e3779b97f4a7c15ULL) >> 32);
+            }
+
+            static inline void sort_unique(lltl::darray<uint32_t> *list)
+            {
+                uint32_t *v         = list->array();
+                size_t n            = list->size();
+
+                // Lists are short, use insertion sort
+                for (size_t i=1; i<n; ++i)
+                {
+                    const uint32_t x    = v[i];
+                    size_t j            = i;
+                    for ( ; (j > 0) && (v[j-1] > x); --j)
+                        v[j]                = v[j-1];
+                    v[j]                = x;
+                }
+
+                // Remove duplicates
+                size_t k            = 0;
+                for (size_t i=0; i<n; ++i)
+                    if ((k == 0) || (v[k-1] != v[i]))
+                        v[k++]              = v[i];
+                list->truncate(k);
+            }
+
+            inline xnode_t *node(uint32_t id)
+            {
+                return vNodes.uget(id);
+            }
+
+            inline const uint32_t *kids(const xnode_t *n)
+            {
+                return vKids.uget(n->first);
+            }
+
+            static bool alloc_index(uint32_t **index, size_t *capacity, size_t count)
+            {
+                size_t cap          = lsp_max(*capacity * 2, size_t(0x100));
+                while (cap < count * 2)
+                    cap                *= 2;
+
+                uint32_t *v         = static_cast<uint32_t *>(malloc(cap * sizeof(uint32_t)));
+                if (v == NULL)
+                    return false;
+                for (size_t i=0; i<cap; ++i)
+                    v[i]                = 0;
+
+                free(*index);
+                *index              = v;
+                *capacity           = cap;
+                return true;
+            }
+
+            static inline void put_index(uint32_t *index, size_t capacity, uint32_t hash, uint32_t id)
+            {
+                const size_t mask   = capacity - 1;
+                size_t i            = hash & mask;
+                while (index[i] != 0)
+                    i                   = (i + 1) & mask;
+                index[i]            = id + 1;
+            }
+
+            uint8_t nullable(uint32_t type, const uint32_t *list, size_t count)
+            {
+                // Each bit of the mask corresponds to the combination of DFA_CTX_* flags
+                uint8_t res;
+                switch (type)
+                {
+                    case X_EMPTY:
+                    case X_ALL:
+                    case X_STAR:
+                        return 0xff;
+                    case X_BOS:             // DFA_CTX_BOS
+                        return 0xaa;
+                    case X_ANYPATH:         // DFA_CTX_BOS or DFA_CTX_SEP
+                        return 0xee;
+                    case X_ANYPATH_TAIL:    // DFA_CTX_SEP or DFA_CTX_EOS
+                        return 0xfc;
+                    case X_CAT:
+                    case X_AND:
+                        res     = 0xff;
+                        for (size_t i=0; i<count; ++i)
+                            res    &= node(list[i])->nullable;
+                        return res;
+                    case X_OR:
+                        res     = 0;
+                        for (size_t i=0; i<count; ++i)
+                            res    |= node(list[i])->nullable;
+                        return res;
+                    case X_NOT:
+                        return ~node(list[0])->nullable;
+                    default:
+                        break;
+                }
+                return 0;
+            }
+
+            uint32_t intern(uint32_t type, uint32_t value, const uint32_t *list, size_t count)
+            {
+                if (bFailed)
+                    return X_NULL;
+
+                // Lookup for existing node
+                const uint32_t h    = hash_words(type * 0x9e3779b1 + value, list, count);
+                if (nIndexCap > 0)
+                {
+                    const size_t mask   = nIndexCap - 1;
+                    for (size_t i = h & mask; vIndex[i] != 0; i = (i + 1) & mask)
+                    {
+                        const uint32_t id   = vIndex[i] - 1;
+                        const xnode_t *n    = node(id);
+                        if ((n->hash != h) || (n->type != type) || (n->value != value) || (n->count != count))
+                            continue;
+                        if ((count <= 0) || (memcmp(kids(n), list, count * sizeof(uint32_t)) == 0))
+                            return id;
+                    }
+                }
+
+                // Create new node
+                const uint32_t id   = vNodes.size();
+                if (id >= DFA_MAX_NODES)
+                    return fail();
+
+                xnode_t *n          = vNodes.add();
+                if (n == NULL)
+                    return fail();
+                n->type             = type;
+                n->value            = value;
+                n->first            = vKids.size();
+                n->count            = count;
+                n->hash             = h;
+                n->nullable         = nullable(type, list, count);
+                n->context          = (type == X_BOS) || (type == X_ANYPATH) || (type == X_ANYPATH_TAIL);
+                for (size_t i=0; i<count; ++i)
+                    n->context         |= node(list[i])->context;
+                if ((count > 0) && (vKids.add_n(count, list) == NULL))
+                    return fail();
+
+                // Update the index
+                if ((id * 2) >= nIndexCap)
+                {
+                    if (!alloc_index(&vIndex, &nIndexCap, id + 1))
+                        return fail();
+                    for (uint32_t i=0; i<=id; ++i)
+                        put_index(vIndex, nIndexCap, node(i)->hash, i);
+                }
+                else
+                    put_index(vIndex, nIndexCap, h, id);
+
+                return id;
+            }
+
+            inline uint32_t fail()
+            {
+                bFailed         = true;
+                return X_NULL;
+            }
+
+            uint32_t make_char(lsp_wchar_t ch)
+            {
+                if (!bMatchCase)
+                    ch              = lsp::to_casefold(ch);
+
+                size_t idx      = 0;
+                for (size_t n=vChars.size(); idx < n; ++idx)
+                    if (*vChars.uget(idx) == ch)
+                        break;
+                if ((idx >= vChars.size()) && (!vChars.add(ch)))
+                    return fail();
+
+                return intern(X_CHAR, DFA_CLASS_CHAR + idx, NULL, 0);
+            }
+
+            uint32_t make_star(uint32_t e)
+            {
+                switch (node(e)->type)
+                {
+                    case X_STAR:
+                    case X_ALL:
+                        return e;
+                    case X_NULL:
+                    case X_EMPTY:
+                        return X_EMPTY;
+                    default:
+                        break;
+                }
+                return intern(X_STAR, 0, &e, 1);
+            }
+
+            uint32_t make_not(uint32_t e)
+            {
+                const xnode_t *n    = node(e);
+                switch (n->type)
+                {
+                    case X_NOT:
+                        return kids(n)[0];
+                    case X_NULL:
+                        return X_ALL;
+                    case X_ALL:
+                        return X_NULL;
+                    default:
+                        break;
+                }
+                return intern(X_NOT, 0, &e, 1);
+            }
+
+            uint32_t make_cat(const uint32_t *list, size_t count)
+            {
+                lltl::darray<uint32_t> items;
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    const xnode_t *n    = node(list[i]);
+                    if (n->type == X_NULL)
+                        return X_NULL;
+                    else if (n->type == X_EMPTY)
+                        continue;
+                    else if (n->type == X_CAT)
+                    {
+                        if (!items.add_n(n->count, kids(n)))
+                            return fail();
+                    }
+                    else if (!items.add(list[i]))
+                        return fail();
+                }
+
+                if (items.size() <= 0)
+                    return X_EMPTY;
+                if (items.size() == 1)
+                    return *items.uget(0);
+
+                return intern(X_CAT, 0, items.array(), items.size());
+            }
+
+            inline uint32_t make_cat(uint32_t a, uint32_t b)
+            {
+                const uint32_t list[] = { a, b };
+                return make_cat(list, 2);
+            }
+
+            uint32_t make_bool(uint32_t type, const uint32_t *list, size_t count)
+            {
+                // X_ALL absorbs any item of X_OR, X_NULL absorbs any item of X_AND
+                const uint32_t zero = (type == X_OR) ? X_ALL : X_NULL;
+                const uint32_t unit = (type == X_OR) ? X_NULL : X_ALL;
+                lltl::darray<uint32_t> items;
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    const xnode_t *n    = node(list[i]);
+                    if (list[i] == zero)
+                        return zero;
+                    else if (list[i] == unit)
+                        continue;
+                    else if (n->type == type)
+                    {
+                        if (!items.add_n(n->count, kids(n)))
+                            return fail();
+                    }
+                    else if (!items.add(list[i]))
+                        return fail();
+                }
+
+                sort_unique(&items);
+                if (items.size() <= 0)
+                    return unit;
+                if (items.size() == 1)
+                    return *items.uget(0);
+
+                return intern(type, 0, items.array(), items.size());
+            }
+
+            inline uint32_t make_bool(uint32_t type, uint32_t a, uint32_t b)
+            {
+                const uint32_t list[] = { a, b };
+                return make_bool(type, list, 2);
+            }
+
+            uint32_t translate_text(const lsp_wchar_t *pat, size_t len)
+            {
+                // The decoding should match the check_pattern_case() and check_pattern_nocase()
+                lltl::darray<uint32_t> items;
+                lsp_wchar_t pc;
+                uint32_t item;
+
+                for (size_t off=0; off<len; )
+                {
+                    pc = pat[off++];
+
+                    switch (pc)
+                    {
+                        case '/':
+                        case '\\':
+                            item        = X_SEP;
+                            break;
+                        case '?':
+                            item        = X_NONSEP;
+                            break;
+                        case '`':
+                            pc = (off < len) ? pat[off] : '`';
+                            switch (pc)
+                            {
+                                // Special symbols
+                                case '*': case '(': case ')': case '|':
+                                case '&': case '!': case '`':
+                                    ++off;
+                                    break;
+                                default:
+                                    pc = '`';
+                                    break;
+                            }
+                            item        = make_char(pc);
+                            break;
+                        default:
+                            item        = make_char(pc);
+                            break;
+                    }
+
+                    if (!items.add(item))
+                        return fail();
+                }
+
+                return make_cat(items.array(), items.size());
+            }
+
+            uint32_t translate(const cmd_t *cmd, const lsp_wchar_t *mask)
+            {
+                lltl::darray<uint32_t> items;
+                uint32_t res, tmp;
+
+                switch (cmd->nCommand)
+                {
+                    case CMD_PATTERN:
+                        res         = translate_text(&mask[cmd->nStart], cmd->nLength);
+                        break;
+
+                    case CMD_ANY:
+                        res         = make_star(X_NONSEP);
+                        if (cmd->nChars == 0)
+                            res         = make_cat(X_NONSEP, res);
+                        else if (cmd->nChars > 0)
+                        {
+                            // Any sequence of characters except the sequence that contains the pattern
+                            const uint32_t list[] = { X_ALL, translate_text(&mask[cmd->nStart], cmd->nLength), X_ALL };
+                            tmp         = make_not(make_cat(list, 3));
+                            res         = make_bool(X_AND, res, tmp);
+                        }
+                        break;
+
+                    case CMD_ANYPATH:
+                        // The inverse '**/' always matches the empty string at the beginning
+                        if (cmd->bInverse)
+                            return make_bool(X_OR, make_not(X_ANYPATH), X_BOS);
+                        return X_ANYPATH;
+
+                    case CMD_SEQUENCE:
+                    case CMD_AND:
+                    case CMD_OR:
+                        for (size_t i=0, n=cmd->sChildren.size(); i<n; ++i)
+                        {
+                            if (!items.add(translate(cmd->sChildren.uget(i), mask)))
+                                return fail();
+                        }
+                        if (cmd->nCommand == CMD_SEQUENCE)
+                            res         = make_cat(items.array(), items.size());
+                        else
+                            res         = make_bool((cmd->nCommand == CMD_AND) ? X_AND : X_OR, items.array(), items.size());
+                        break;
+
+                    default:
+                        return fail();
+                }
+
+                return (cmd->bInverse) ? make_not(res) : res;
+            }
+
+            uint32_t derive(uint32_t e, uint32_t cls, size_t ctx)
+            {
+                const xnode_t *n    = node(e);
+                switch (n->type)
+                {
+                    case X_NULL:
+                    case X_EMPTY:
+                    case X_BOS:
+                        return X_NULL;
+                    case X_ALL:
+                    case X_ANYPATH_TAIL:
+                        return e;
+                    case X_NONSEP:
+                        return (cls != DFA_CLASS_SEP) ? X_EMPTY : X_NULL;
+                    case X_SEP:
+                        return (cls == DFA_CLASS_SEP) ? X_EMPTY : X_NULL;
+                    case X_CHAR:
+                        return (cls == n->value) ? X_EMPTY : X_NULL;
+                    case X_ANYPATH:
+                        return (ctx & (DFA_CTX_BOS | DFA_CTX_SEP)) ? X_ANYPATH_TAIL : X_NULL;
+                    default:
+                        break;
+                }
+
+                // Lookup the cache
+                if (!n->context)
+                    ctx                 = 0;
+                const uint64_t key  = ((uint64_t(e) * nClasses + cls) << 2) | ctx;
+                if (nMemoCap > 0)
+                {
+                    const size_t mask   = nMemoCap - 1;
+                    for (size_t i = hash_memo(key) & mask; vMemoKey[i] != 0; i = (i + 1) & mask)
+                    {
+                        if (vMemoKey[i] == key + 1)
+                            return vMemoValue[i];
+                    }
+                }
+
+                // Compute the derivative
+                lltl::darray<uint32_t> items, terms;
+                uint32_t res;
+                if (!items.add_n(n->count, kids(n)))
+                    return fail();
+                const uint32_t type = n->type;
+                uint32_t *list      = items.array();
+                const size_t count  = items.size();
+
+                switch (type)
+                {
+                    case X_STAR:
+                        res         = make_cat(derive(list[0], cls, ctx), e);
+                        break;
+                    case X_NOT:
+                        res         = make_not(derive(list[0], cls, ctx));
+                        break;
+                    case X_CAT:
+                        for (size_t i=0; i<count; ++i)
+                        {
+                            const bool empty    = node(list[i])->nullable & (1 << ctx);
+                            list[i]             = derive(list[i], cls, ctx);
+                            if (!terms.add(make_cat(&list[i], count - i)))
+                                return fail();
+                            if (!empty)
+                                break;
+                        }
+                        res         = make_bool(X_OR, terms.array(), terms.size());
+                        break;
+                    case X_OR:
+                    case X_AND:
+                        for (size_t i=0; i<count; ++i)
+                            list[i]             = derive(list[i], cls, ctx);
+                        res         = make_bool(type, list, count);
+                        break;
+                    default:
+                        return fail();
+                }
+
+                // Store the result into the cache
+                if (bFailed)
+                    return X_NULL;
+                if ((nMemoSize * 2) >= nMemoCap)
+                {
+                    if (!grow_memo())
+                        return fail();
+                }
+                const size_t mask   = nMemoCap - 1;
+                size_t i            = hash_memo(key) & mask;
+                while (vMemoKey[i] != 0)
+                    i                   = (i + 1) & mask;
+                vMemoKey[i]         = key + 1;
+                vMemoValue[i]       = res;
+                ++nMemoSize;
+
+                return res;
+            }
+
+            bool grow_memo()
+            {
+                const size_t cap    = lsp_max(nMemoCap * 2, size_t(0x400));
+                uint64_t *keys      = static_cast<uint64_t *>(malloc(cap * sizeof(uint64_t)));
+                uint32_t *values    = static_cast<uint32_t *>(malloc(cap * sizeof(uint32_t)));
+                if ((keys == NULL) || (values == NULL))
+                {
+                    free(keys);
+                    free(values);
+                    return false;
+                }
+                for (size_t i=0; i<cap; ++i)
+                    keys[i]             = 0;
+
+                // Re-insert items
+                const size_t mask   = cap - 1;
+                for (size_t i=0; i<nMemoCap; ++i)
+                {
+                    if (vMemoKey[i] == 0)
+                        continue;
+                    size_t j            = hash_memo(vMemoKey[i] - 1) & mask;
+                    while (keys[j] != 0)
+                        j                   = (j + 1) & mask;
+                    keys[j]             = vMemoKey[i];
+                    values[j]           = vMemoValue[i];
+                }
+
+                free(vMemoKey);
+                free(vMemoValue);
+                vMemoKey            = keys;
+                vMemoValue          = values;
+                nMemoCap            = cap;
+
+                return true;
+            }
+
+            inline const uint32_t *state(size_t id)
+            {
+                return vStates.uget(id * nStateWords);
+            }
+
+            ssize_t add_state(const uint32_t *key)
+            {
+                // Lookup for existing state
+                const size_t count  = vStates.size() / nStateWords;
+                const uint32_t h    = hash_words(0, key, nStateWords);
+                if (nStateCap > 0)
+                {
+                    const size_t mask   = nStateCap - 1;
+                    for (size_t i = h & mask; vStateIndex[i] != 0; i = (i + 1) & mask)
+                    {
+                        const uint32_t id   = vStateIndex[i] - 1;
+                        if (memcmp(state(id), key, nStateWords * sizeof(uint32_t)) == 0)
+                            return id;
+                    }
+                }
+
+                // Create new state
+                if ((count >= DFA_MAX_STATES) || ((count + 1) * nClasses > DFA_MAX_TRANSITIONS))
+                    return -1;
+                if (!vStates.add_n(nStateWords, key))
+                    return -1;
+
+                // Update the index
+                if ((count * 2) >= nStateCap)
+                {
+                    if (!alloc_index(&vStateIndex, &nStateCap, count + 1))
+                        return -1;
+                    for (size_t i=0; i<=count; ++i)
+                        put_index(vStateIndex, nStateCap, hash_words(0, state(i), nStateWords), i);
+                }
+                else
+                    put_index(vStateIndex, nStateCap, h, count);
+
+                return count;
+            }
+
+            dfa_t *build(const uint32_t *roots, size_t count)
+            {
+                if (bFailed)
+                    return NULL;
+
+                nClasses            = DFA_CLASS_CHAR + vChars.size();
+                nStateWords         = count + 1;
+                for (size_t i=0; i<count; ++i)
+                    bContext           |= node(roots[i])->context;
+
+                // The initial state
+                lltl::darray<uint32_t> key;
+                uint32_t *next      = key.add_n(nStateWords);
+                if (next == NULL)
+                    return NULL;
+                for (size_t i=0; i<count; ++i)
+                    next[i]             = roots[i];
+                next[count]         = (bContext) ? DFA_CTX_BOS : 0;
+                if (add_state(next) < 0)
+                    return NULL;
+
+                // Explore all reachable states
+                for (size_t id=0; id < vStates.size() / nStateWords; ++id)
+                {
+                    for (size_t cls=0; cls<nClasses; ++cls)
+                    {
+                        const size_t ctx    = state(id)[count];
+                        for (size_t i=0; i<count; ++i)
+                            next[i]             = derive(state(id)[i], cls, ctx);
+                        next[count]         = ((bContext) && (cls == DFA_CLASS_SEP)) ? DFA_CTX_SEP : 0;
+                        if (bFailed)
+                            return NULL;
+
+                        const ssize_t to    = add_state(next);
+                        if ((to < 0) || (!vNext.add(uint32_t(to))))
+                            return NULL;
+                    }
+                }
+
+                return emit(count);
+            }
+
+            dfa_t *emit(size_t count)
+            {
+                // Count the number of non-ASCII characters
+                lltl::darray<lsp_wchar_t> chars;
+                for (size_t i=0, n=vChars.size(); i<n; ++i)
+                {
+                    const lsp_wchar_t ch    = *vChars.uget(i);
+                    if ((ch >= 0x80) && (!chars.add(ch)))
+                        return NULL;
+                }
+                lsp_wchar_t *vc     = chars.array();
+                const size_t nchars = chars.size();
+                for (size_t i=1; i<nchars; ++i)
+                {
+                    const lsp_wchar_t x = vc[i];
+                    size_t j            = i;
+                    for ( ; (j > 0) && (vc[j-1] > x); --j)
+                        vc[j]               = vc[j-1];
+                    vc[j]               = x;
+                }
+
+                // Allocate the DFA as a single memory block
+                const size_t nstates    = vStates.size() / nStateWords;
+                const size_t nwords     = (count + 31) >> 5;
+                const size_t szof_dfa   = align_size(sizeof(dfa_t), DEFAULT_ALIGN);
+                const size_t szof_next  = align_size(nstates * nClasses * sizeof(uint32_t), DEFAULT_ALIGN);
+                const size_t szof_acc   = align_size(nstates * nwords * sizeof(uint32_t), DEFAULT_ALIGN);
+                const size_t szof_chars = align_size(nchars * sizeof(lsp_wchar_t), DEFAULT_ALIGN);
+                const size_t szof_cls   = align_size(nchars * sizeof(uint32_t), DEFAULT_ALIGN);
+                const size_t szof_sink  = align_size(nstates * sizeof(uint8_t), DEFAULT_ALIGN);
+                uint8_t *ptr            = static_cast<uint8_t *>(malloc(szof_dfa + szof_next + szof_acc + szof_chars + szof_cls + szof_sink));
+                if (ptr == NULL)
+                    return NULL;
+
+                dfa_t *dfa              = reinterpret_cast<dfa_t *>(ptr);
+                ptr                    += szof_dfa;
+                dfa->vNext              = reinterpret_cast<uint32_t *>(ptr);
+                ptr                    += szof_next;
+                dfa->vAccept            = reinterpret_cast<uint32_t *>(ptr);
+                ptr                    += szof_acc;
+                dfa->vChars             = reinterpret_cast<lsp_wchar_t *>(ptr);
+                ptr                    += szof_chars;
+                dfa->vCharClass         = reinterpret_cast<uint32_t *>(ptr);
+                ptr                    += szof_cls;
+                dfa->vSink              = ptr;
+
+                dfa->nStates            = nstates;
+                dfa->nClasses           = nClasses;
+                dfa->nWords             = nwords;
+                dfa->nChars             = nchars;
+                dfa->bMatchCase         = bMatchCase;
+
+                // Character classes
+                for (size_t i=0; i<nchars; ++i)
+                {
+                    dfa->vChars[i]          = vc[i];
+                    dfa->vCharClass[i]      = char_class(vc[i]);
+                }
+                for (lsp_wchar_t ch=0; ch<0x80; ++ch)
+                {
+                    const lsp_wchar_t lc    = (bMatchCase) ? ch : lsp::to_casefold(ch);
+                    dfa->vAscii[ch]         = (is_file_separator(lc)) ? DFA_CLASS_SEP : char_class(lc);
+                }
+
+                // Transitions and accept masks
+                const uint32_t *vn      = vNext.array();
+                for (size_t id=0; id<nstates; ++id)
+                {
+                    const uint32_t *s       = state(id);
+                    const size_t ctx        = s[count] | DFA_CTX_EOS;
+                    uint32_t *acc           = &dfa->vAccept[id * nwords];
+                    uint32_t *tr            = &dfa->vNext[id * nClasses];
+                    bool sink               = true;
+
+                    for (size_t i=0; i<nwords; ++i)
+                        acc[i]                  = 0;
+                    for (size_t i=0; i<count; ++i)
+                    {
+                        if (node(s[i])->nullable & (1 << ctx))
+                            acc[i >> 5]            |= uint32_t(1) << (i & 0x1f);
+                    }
+                    for (size_t i=0; i<nClasses; ++i)
+                    {
+                        tr[i]                   = vn[id * nClasses + i];
+                        sink                    = sink && (tr[i] == id);
+                    }
+                    dfa->vSink[id]          = sink;
+                }
+
+                return dfa;
+            }
+
+            uint32_t char_class(lsp_wchar_t ch)
+            {
+                for (size_t i=0, n=vChars.size(); i<n; ++i)
+                    if (*vChars.uget(i) == ch)
+                        return DFA_CLASS_CHAR + i;
+                return DFA_CLASS_OTHER;
+            }
+        };
+
+        PathPattern::dfa_t *PathPattern::compile_dfa(const PathPattern * const *list, size_t count, bool match_case)
+        {
+            if (count <= 0)
+                return NULL;
+
+            dfa_builder_t b(match_case);
+            lltl::darray<uint32_t> roots;
+
+            for (size_t i=0; i<count; ++i)
+            {
+                const PathPattern *p    = list[i];
+                if (p->pRoot == NULL)
+                    return NULL;
+                if (!roots.add(b.translate(p->pRoot, p->sMask.characters())))
+                    return NULL;
+            }
+
+            return b.build(roots.array(), roots.size());
+        }
+
+        void PathPattern::destroy_dfa(dfa_t *dfa)
+        {
+            if (dfa != NULL)
+                free(dfa);
+        }
+
+        inline uint32_t PathPattern::dfa_class(const dfa_t *dfa, lsp_wchar_t c)
+        {
+            if (c < 0x80)
+                return dfa->vAscii[c];
+            if (!dfa->bMatchCase)
+            {
+                c   = lsp::to_casefold(c);
+                if (c < 0x80)
+                    return dfa->vAscii[c];
+            }
+
+            // Binary search for the character
+            ssize_t first = 0, last = ssize_t(dfa->nChars) - 1;
+            while (first <= last)
+            {
+                const ssize_t mid       = (first + last) >> 1;
+                const lsp_wchar_t ch    = dfa->vChars[mid];
+                if (ch == c)
+                    return dfa->vCharClass[mid];
+                else if (ch < c)
+                    first               = mid + 1;
+                else
+                    last                = mid - 1;
+            }
+
+            return DFA_CLASS_OTHER;
+        }
+
+        const uint32_t *PathPattern::run_dfa(const dfa_t *dfa, const lsp_wchar_t *s, size_t count)
+        {
+            const uint32_t *next    = dfa->vNext;
+            const size_t classes    = dfa->nClasses;
+            uint32_t state          = 0;
+
+            for (size_t i=0; i<count; ++i)
+            {
+                if (dfa->vSink[state])
+                    break;
+                state                   = next[state * classes + dfa_class(dfa, s[i])];
+            }
+
+            return &dfa->vAccept[state * dfa->nWords];
+        }
+
+        const lsp_wchar_t *PathPattern::get_subject(const LSPString *path, size_t flags, size_t *count)
+        {
+            const lsp_wchar_t *s    = path->characters();
+            size_t len              = path->length();
+
+            // Match only the last element of the path
+            if (!(flags & FULL_PATH))
+            {
+                size_t first            = len;
+                while ((first > 0) && (!is_file_separator(s[first - 1])))
+                    --first;
+                s                      += first;
+                len                    -= first;
+            }
+
+            *count                  = len;
+            return s;
+        }
+
+        bool PathPattern::match_dfa(const LSPString *path) const
+        {
+            size_t count;
+            const lsp_wchar_t *s    = get_subject(path, nFlags, &count);
+            const uint32_t *accept  = run_dfa(pDfa, s, count);
+
+            return bool(accept[0] & 1) ^ bool(nFlags & INVERSE);
+        }
+
         bool PathPattern::match_full(const LSPString *path) const
         {
             matcher_t root;
@@ -1330,6 +2263,15 @@ namespace lsp
         {
             size_t old  = nFlags;
             nFlags      = flags & (INVERSE | MATCH_CASE | FULL_PATH);
+
+            // Character classes of the automaton depend on the case sensitivity
+            if (((old ^ nFlags) & MATCH_CASE) && (pRoot != NULL))
+            {
+                const PathPattern *list = this;
+                destroy_dfa(pDfa);
+                pDfa        = compile_dfa(&list, 1, nFlags & MATCH_CASE);
+            }
+
             return old;
         }
 
@@ -1338,6 +2280,12 @@ namespace lsp
             if (pRoot == NULL)
                 return false;
 
+            if (pDfa != NULL)
+            {
+                LSPString tmp;
+                return (tmp.set_utf8(path)) ? match_dfa(&tmp) : false;
+            }
+
             Path tmp;
             if (tmp.set(path) != STATUS_OK)
                 return false;
@@ -1355,6 +2303,8 @@ namespace lsp
         {
             if (pRoot == NULL)
                 return false;
+            if (pDfa != NULL)
+                return match_dfa(path);
 
             Path tmp;
             if (tmp.set(path) != STATUS_OK)
@@ -1373,12 +2323,14 @@ namespace lsp
         {
             if (pRoot == NULL)
                 return false;
+            if (pDfa != NULL)
+                return match_dfa(path->as_string());
 
             if (nFlags & FULL_PATH)
                 return match_full(path->as_string());
 
             Path tmp;
-            if (tmp.get_last(&tmp) != STATUS_OK)
+            if (path->get_last(&tmp) != STATUS_OK)
                 return false;
 
             return match_full(tmp.as_string());
@@ -1388,6 +2340,7 @@ namespace lsp
         {
             sMask.swap(dst->sMask);
             lsp::swap(pRoot, dst->pRoot);
+            lsp::swap(pDfa, dst->pDfa);
             lsp::swap(nFlags, dst->nFlags);
         }
 
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/PathPatternSet.h>
+#include <lsp-plug.in/common/debug.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        PathPatternSet::PathPatternSet()
+        {
+            for (size_t i=0; i<GROUP_COUNT; ++i)
+                vGroups[i].pDfa     = NULL;
+        }
+
+        PathPatternSet::~PathPatternSet()
+        {
+            clear();
+        }
+
+        void PathPatternSet::clear()
+        {
+            for (size_t i=0; i<GROUP_COUNT; ++i)
+            {
+                group_t *g          = &vGroups[i];
+                PathPattern::destroy_dfa(g->pDfa);
+                g->pDfa             = NULL;
+                g->vIndex.flush();
+                g->vInverse.flush();
+            }
+
+            for (size_t i=0, n=vPatterns.size(); i<n; ++i)
+            {
+                PathPattern *p      = vPatterns.uget(i);
+                if (p != NULL)
+                    delete p;
+            }
+            vPatterns.flush();
+        }
+
+        status_t PathPatternSet::compile(group_t *g)
+        {
+            const size_t count  = g->vIndex.size();
+            const size_t words  = (count + 31) >> 5;
+            lltl::parray<PathPattern> list;
+            PathPattern **vp    = list.add_n(count);
+            if (vp == NULL)
+                return STATUS_NO_MEM;
+            if ((g->vInverse.size() < words) && (g->vInverse.append_n(words - g->vInverse.size()) == NULL))
+                return STATUS_NO_MEM;
+
+            // Build the list of patterns and inverse mask
+            uint32_t *inv       = g->vInverse.array();
+            for (size_t i=0; i<words; ++i)
+                inv[i]              = 0;
+            for (size_t i=0; i<count; ++i)
+            {
+                vp[i]               = vPatterns.uget(*g->vIndex.uget(i));
+                if (vp[i]->flags() & PathPattern::INVERSE)
+                    inv[i >> 5]        |= uint32_t(1) << (i & 0x1f);
+            }
+
+            // Compile the automaton, the patterns of the group will be tested
+            // one by one if the automaton is too complex
+            PathPattern::destroy_dfa(g->pDfa);
+            g->pDfa             = PathPattern::compile_dfa(vp, count, vp[0]->flags() & PathPattern::MATCH_CASE);
+
+            return STATUS_OK;
+        }
+
+        status_t PathPatternSet::add_pattern(PathPattern *pattern)
+        {
+            const size_t index  = vPatterns.size();
+            group_t *g          = &vGroups[pattern->flags() & GROUP_FLAGS];
+
+            if (!vPatterns.add(pattern))
+            {
+                delete pattern;
+                return STATUS_NO_MEM;
+            }
+            if (!g->vIndex.add(uint32_t(index)))
+            {
+                vPatterns.pop();
+                delete pattern;
+                return STATUS_NO_MEM;
+            }
+
+            status_t res        = compile(g);
+            if (res != STATUS_OK)
+            {
+                g->vIndex.pop();
+                vPatterns.pop();
+                delete pattern;
+            }
+
+            return res;
+        }
+
+        status_t PathPatternSet::add(const char *pattern, size_t flags)
+        {
+            if (pattern == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            PathPattern *p      = new PathPattern();
+            if (p == NULL)
+                return STATUS_NO_MEM;
+
+            status_t res        = p->set(pattern, flags);
+            if (res != STATUS_OK)
+            {
+                delete p;
+                return res;
+            }
+
+            return add_pattern(p);
+        }
+
+        status_t PathPatternSet::add(const LSPString *pattern, size_t flags)
+        {
+            if (pattern == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            PathPattern *p      = new PathPattern();
+            if (p == NULL)
+                return STATUS_NO_MEM;
+
+            status_t res        = p->set(pattern, flags);
+            if (res != STATUS_OK)
+            {
+                delete p;
+                return res;
+            }
+
+            return add_pattern(p);
+        }
+
+        status_t PathPatternSet::add(const Path *pattern, size_t flags)
+        {
+            if (pattern == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            return add(pattern->as_string(), flags);
+        }
+
+        status_t PathPatternSet::add(const PathPattern *pattern)
+        {
+            if (pattern == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            return add(pattern->get(), pattern->flags());
+        }
+
+        ssize_t PathPatternSet::lookup_group(const group_t *g, const LSPString *path, size_t first) const
+        {
+            const size_t count      = g->vIndex.size();
+            const uint32_t *index   = g->vIndex.uget(0);
+
+            // Test patterns one by one if there is no automaton
+            if (g->pDfa == NULL)
+            {
+                for (size_t i=0; i<count; ++i)
+                {
+                    if (index[i] < first)
+                        continue;
+                    if (vPatterns.uget(index[i])->test(path))
+                        return index[i];
+                }
+                return -1;
+            }
+
+            // Run the automaton, indices of patterns in the group are sorted
+            size_t length;
+            const lsp_wchar_t *s    = PathPattern::get_subject(path, vPatterns.uget(index[0])->flags(), &length);
+            const uint32_t *accept  = PathPattern::run_dfa(g->pDfa, s, length);
+            const uint32_t *inverse = g->vInverse.uget(0);
+
+            for (size_t i=0, n=g->pDfa->nWords; i<n; ++i)
+            {
+                uint32_t mask           = accept[i] ^ inverse[i];
+                for (size_t j = i << 5; mask != 0; mask >>= 1, ++j)
+                {
+                    if ((mask & 1) && (j < count) && (index[j] >= first))
+                        return index[j];
+                }
+            }
+
+            return -1;
+        }
+
+        ssize_t PathPatternSet::lookup(const LSPString *path, size_t first) const
+        {
+            ssize_t res = -1;
+
+            for (size_t i=0; i<GROUP_COUNT; ++i)
+            {
+                const group_t *g    = &vGroups[i];
+                if (g->vIndex.is_empty())
+                    continue;
+
+                const ssize_t idx   = lookup_group(g, path, first);
+                if ((idx >= 0) && ((res < 0) || (idx < res)))
+                    res                 = idx;
+            }
+
+            return res;
+        }
+
+        bool PathPatternSet::test(const char *path) const
+        {
+            if ((path == NULL) || (vPatterns.is_empty()))
+                return false;
+
+            LSPString tmp;
+            return (tmp.set_utf8(path)) ? lookup(&tmp, 0) >= 0 : false;
+        }
+
+        bool PathPatternSet::test(const LSPString *path) const
+        {
+            return (path != NULL) ? lookup(path, 0) >= 0 : false;
+        }
+
+        bool PathPatternSet::test(const Path *path) const
+        {
+            return (path != NULL) ? lookup(path->as_string(), 0) >= 0 : false;
+        }
+
+        ssize_t PathPatternSet::find(const char *path, size_t first) const
+        {
+            if (path == NULL)
+                return -STATUS_BAD_ARGUMENTS;
+            if (first >= vPatterns.size())
+                return -STATUS_NOT_FOUND;
+
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return -STATUS_NO_MEM;
+
+            const ssize_t res   = lookup(&tmp, first);
+            return (res >= 0) ? res : -STATUS_NOT_FOUND;
+        }
+
+        ssize_t PathPatternSet::find(const LSPString *path, size_t first) const
+        {
+            if (path == NULL)
+                return -STATUS_BAD_ARGUMENTS;
+
+            const ssize_t res   = lookup(path, first);
+            return (res >= 0) ? res : -STATUS_NOT_FOUND;
+        }
+
+        ssize_t PathPatternSet::find(const Path *path, size_t first) const
+        {
+            return (path != NULL) ? find(path->as_string(), first) : -STATUS_BAD_ARGUMENTS;
+        }
+
+        void PathPatternSet::swap(PathPatternSet *dst)
+        {
+            vPatterns.swap(dst->vPatterns);
+            for (size_t i=0; i<GROUP_COUNT; ++i)
+            {
+                group_t *a          = &vGroups[i];
+                group_t *b          = &dst->vGroups[i];
+                lsp::swap(a->pDfa, b->pDfa);
+                a->vIndex.swap(b->vIndex);
+                a->vInverse.swap(b->vInverse);
+            }
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
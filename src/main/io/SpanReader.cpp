@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/SpanReader.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        SpanReader::SpanReader()
+        {
+            pIn         = NULL;
+            pHead       = NULL;
+            pTail       = NULL;
+            nSpan       = 0;
+            bNative     = true;
+            cChar       = 0;
+        }
+
+        SpanReader::SpanReader(IInSequence *in)
+        {
+            pIn         = in;
+            pHead       = NULL;
+            pTail       = NULL;
+            nSpan       = 0;
+            bNative     = true;
+            cChar       = 0;
+        }
+
+        SpanReader::~SpanReader()
+        {
+            sync();
+            pIn         = NULL;
+        }
+
+        void SpanReader::detach()
+        {
+            pIn         = NULL;
+            pHead       = NULL;
+            pTail       = NULL;
+            nSpan       = 0;
+            bNative     = true;
+        }
+
+        void SpanReader::wrap(IInSequence *in)
+        {
+            sync();
+
+            pIn         = in;
+            pHead       = NULL;
+            pTail       = NULL;
+            nSpan       = 0;
+            bNative     = true;
+        }
+
+        status_t SpanReader::sync()
+        {
+            // In fallback mode characters are already read from the sequence
+            if (!bNative)
+                return STATUS_OK;
+
+            status_t res    = STATUS_OK;
+
+            // Commit the read characters of the span to the sequence
+            if ((pIn != NULL) && (nSpan > 0))
+            {
+                const size_t count  = nSpan - (pTail - pHead);
+                if (count > 0)
+                {
+                    const ssize_t n     = pIn->consume(count);
+                    if (n < 0)
+                        res                 = status_t(-n);
+                }
+            }
+
+            pHead       = NULL;
+            pTail       = NULL;
+            nSpan       = 0;
+
+            return res;
+        }
+
+        status_t SpanReader::fill()
+        {
+            if (pHead < pTail)
+                return STATUS_OK;
+            else if (pIn == NULL)
+                return STATUS_CLOSED;
+
+            if (bNative)
+            {
+                // The whole span has been read, commit it and obtain the new one
+                status_t res    = sync();
+                if (res != STATUS_OK)
+                    return res;
+
+                const lsp_wchar_t *ptr = NULL;
+                size_t len      = 0;
+                res             = pIn->peek_span(&ptr, &len);
+                if (res == STATUS_OK)
+                {
+                    pHead           = ptr;
+                    pTail           = &ptr[len];
+                    nSpan           = len;
+                    return STATUS_OK;
+                }
+                else if (res != STATUS_NOT_SUPPORTED)
+                    return res;
+
+                bNative         = false;
+            }
+
+            // Fallback: read characters one by one to keep the sequence position exact
+            const lsp_swchar_t ch   = pIn->read();
+            if (ch < 0)
+                return status_t(-ch);
+
+            cChar       = ch;
+            pHead       = &cChar;
+            pTail       = &pHead[1];
+
+            return STATUS_OK;
+        }
+
+        lsp_swchar_t SpanReader::fetch()
+        {
+            const status_t res  = fill();
+            return (res == STATUS_OK) ? *(pHead++) : -res;
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
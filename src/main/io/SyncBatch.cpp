@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/Dir.h>
+#include <lsp-plug.in/io/SyncBatch.h>
+
+namespace lsp
+{
+    namespace io
+    {
+        SyncBatch::SyncBatch()
+        {
+        }
+
+        SyncBatch::~SyncBatch()
+        {
+            // Do not lose durability of already replaced files
+            commit();
+        }
+
+        status_t SyncBatch::add(const char *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            LSPString tmp;
+            if (!tmp.set_utf8(path))
+                return STATUS_NO_MEM;
+            return add(&tmp);
+        }
+
+        status_t SyncBatch::add(const Path *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            return add(path->as_string());
+        }
+
+        status_t SyncBatch::add(const LSPString *path)
+        {
+            if (path == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            // Check that directory is already pending
+            for (size_t i=0, n=vDirs.size(); i<n; ++i)
+            {
+                const LSPString *dir = vDirs.uget(i);
+                if (dir->equals(path))
+                    return STATUS_OK;
+            }
+
+            // Add new record
+            LSPString *dir = path->clone();
+            if (dir == NULL)
+                return STATUS_NO_MEM;
+            if (!vDirs.add(dir))
+            {
+                delete dir;
+                return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t SyncBatch::commit()
+        {
+            status_t result = STATUS_OK;
+
+            for (size_t i=0, n=vDirs.size(); i<n; ++i)
+            {
+                LSPString *dir = vDirs.uget(i);
+                const status_t res = Dir::sync(dir);
+                if ((res != STATUS_OK) && (result == STATUS_OK))
+                    result = res;
+                delete dir;
+            }
+            vDirs.flush();
+
+            return result;
+        }
+
+        void SyncBatch::clear()
+        {
+            for (size_t i=0, n=vDirs.size(); i<n; ++i)
+                delete vDirs.uget(i);
+            vDirs.flush();
+        }
+
+    } /* namespace io */
+} /* namespace lsp */
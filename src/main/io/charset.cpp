@@ -27,13 +27,27 @@
 
 #include <errno.h>
 #include <stdlib.h>
-#include <wctype.h>
 
 #ifdef PLATFORM_WINDOWS
     #include <windows.h>
     #include <winnls.h>
 #endif /* PLATFORM_WINDOWS */
 
+#if defined(ARCH_X86) && defined(__SSE2__)
+    #define LSP_UTF_SSE2
+    #include <emmintrin.h>
+
+    // AVX2 routines are compiled with function-specific target options and selected at runtime
+    #if defined(__GNUC__) || defined(__clang__)
+        #define LSP_UTF_AVX2
+        #define LSP_UTF_TARGET_AVX2     __attribute__((target("avx2")))
+        #include <immintrin.h>
+    #endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    #define LSP_UTF_NEON
+    #include <arm_neon.h>
+#endif
+
 namespace lsp
 {
 #if defined(PLATFORM_WINDOWS)
@@ -599,919 +613,1912 @@ namespace lsp
 #endif
 
     //-------------------------------------------------------------------------
-    // UTF-16 helper routines
-    lsp_utf32_t read_utf16le_codepoint(const lsp_utf16_t **str)
+    // Built-in character sets
+    static bool charset_name_equals(const char *name, const char *ref)
     {
-        uint32_t cp, sc;
-        const lsp_utf16_t *s = *str;
-
-        cp = LE_TO_CPU(*(s++));
-        if (cp == 0)
-            return cp;
-
-        sc = cp & 0xfc00;
-        if (sc == 0xd800) // cp = Surrogate high
-        {
-            sc = LE_TO_CPU(*s);
-            if ((sc & 0xfc00) == 0xdc00)
-            {
-                ++s;
-                cp  = 0x10000 + (((cp & 0x3ff) << 10) | (sc & 0x3ff));
-            }
-            else
-                cp  = 0xfffd;
-        }
-        else if (sc == 0xdc00) // Surrogate low?
+        // Compare names ignoring case, dashes, underscores and modifier
+        while (true)
         {
-            sc = LE_TO_CPU(*s);
-            if ((sc & 0xfc00) == 0xd800)
+            char c = *name;
+            if ((c == '-') || (c == '_'))
             {
-                ++s;
-                cp  = 0x10000 + (((sc & 0x3ff) << 10) | (cp & 0x3ff));
+                ++name;
+                continue;
             }
-            else
-                cp  = 0xfffd;
-        }
+            else if ((c == '\0') || (c == '@'))
+                return *ref == '\0';
 
-        *str = s;
-        return cp;
+            if ((c >= 'A') && (c <= 'Z'))
+                c      += 'a' - 'A';
+            if (c != *ref)
+                return false;
+
+            ++name;
+            ++ref;
+        }
     }
 
-    lsp_utf32_t read_utf16be_codepoint(const lsp_utf16_t **str)
+    builtin_charset_t builtin_charset_from_name(const char *charset)
     {
-        uint32_t cp, sc;
-        const lsp_utf16_t *s = *str;
+        if (charset == NULL)
+        {
+#if defined(PLATFORM_WINDOWS)
+            return (codepage_from_name(NULL) == CP_UTF8) ? BUILTIN_CHARSET_UTF8 : BUILTIN_CHARSET_NONE;
+#else
+            // Assume default locale being UTF-8
+            charset = "UTF-8";
 
-        cp = BE_TO_CPU(*(s++));
-        if (cp == 0)
-            return cp;
+            // Get system locale
+            char *current = setlocale(LC_CTYPE, NULL);
+            if (current == NULL)
+                return BUILTIN_CHARSET_NONE;
 
-        sc = cp & 0xfc00;
-        if (sc == 0xd800) // cp = Surrogate high
-        {
-            sc = BE_TO_CPU(*s);
-            if ((sc & 0xfc00) == 0xdc00)
-            {
-                ++s;
-                cp  = 0x10000 + (((cp & 0x3ff) << 10) | (sc & 0x3ff));
-            }
-            else
-                cp  = 0xfffd;
-        }
-        else if (sc == 0xdc00) // Surrogate low?
-        {
-            sc = BE_TO_CPU(*s);
-            if ((sc & 0xfc00) == 0xd800)
+            // Scan for character set presence
+            current = strchr(current, '.');
+            if (current != NULL)
             {
-                ++s;
-                cp  = 0x10000 + (((sc & 0x3ff) << 10) | (cp & 0x3ff));
+                ++current;
+                if (strlen(current) > 0)
+                    charset = current;
             }
-            else
-                cp  = 0xfffd;
+#endif /* PLATFORM_WINDOWS */
         }
 
-        *str = s;
-        return cp;
+        if (charset_name_equals(charset, "utf8"))
+            return BUILTIN_CHARSET_UTF8;
+        if ((charset_name_equals(charset, "ascii")) ||
+            (charset_name_equals(charset, "usascii")) ||
+            (charset_name_equals(charset, "ansix3.41968")))
+            return BUILTIN_CHARSET_ASCII;
+
+        return BUILTIN_CHARSET_NONE;
     }
 
-    lsp_utf32_t read_utf16le_streaming(const lsp_utf16_t **str, size_t *nsrc, bool force)
-    {
-        if (*nsrc <= 0)
-            return LSP_UTF32_EOF;
+    //-------------------------------------------------------------------------
+    // Bulk conversion kernels
+    //
+    // Each conversion kernel converts the leading run of characters that can be
+    // processed without any additional checks and returns the length of this
+    // run. All kernels work with native byte order. The generic implementation
+    // is the scalar reference for all other implementations.
+    typedef struct utf_kernels_t
+    {
+        utf_kernel_t    id;
+        size_t        (*ascii_to_utf32)(lsp_utf32_t *dst, const char *src, size_t count);
+        size_t        (*utf32_to_ascii)(char *dst, const lsp_utf32_t *src, size_t count);
+        size_t        (*ascii_to_utf16)(lsp_utf16_t *dst, const char *src, size_t count);
+        size_t        (*utf16_to_ascii)(char *dst, const lsp_utf16_t *src, size_t count);
+        size_t        (*bmp_to_utf32)(lsp_utf32_t *dst, const lsp_utf16_t *src, size_t count);
+        size_t        (*utf32_to_bmp)(lsp_utf16_t *dst, const lsp_utf32_t *src, size_t count);
+        size_t        (*utf8_validate)(const char *src, size_t count);
+    } utf_kernels_t;
+
+    static inline size_t utf8_valid_sequence(const uint8_t *s, size_t avail)
+    {
+        const uint8_t c = s[0];
+        if (c < 0x80)
+            return 1;
+
+        // Determine the length of sequence and the valid range of the second byte
+        size_t bytes;
+        uint8_t lo = 0x80, hi = 0xbf;
+        if (c < 0xc2)       // Continuation byte or overlong 2-byte sequence
+            return 0;
+        else if (c < 0xe0)
+            bytes       = 2;
+        else if (c < 0xf0)
+        {
+            bytes       = 3;
+            if (c == 0xe0)          // Overlong 3-byte sequence
+                lo          = 0xa0;
+            else if (c == 0xed)     // Surrogate
+                hi          = 0x9f;
+        }
+        else if (c < 0xf5)
+        {
+            bytes       = 4;
+            if (c == 0xf0)          // Overlong 4-byte sequence
+                lo          = 0x90;
+            else if (c == 0xf4)     // Code point above 0x10ffff
+                hi          = 0x8f;
+        }
+        else
+            return 0;
+
+        if (bytes > avail)
+            return 0;
+        if ((s[1] < lo) || (s[1] > hi))
+            return 0;
+        for (size_t i=2; i<bytes; ++i)
+            if ((s[i] & 0xc0) != 0x80)
+                return 0;
 
-        uint32_t cp, sc;
-        const lsp_utf16_t *s = *str;
+        return bytes;
+    }
 
-        cp = LE_TO_CPU(*(s++));
-        sc = cp & 0xfc00;
-        if (sc == 0xd800) // cp = Surrogate high
+    /**
+     * Decode single UTF-8 sequence. Ill-formed sequence is reported as the maximal
+     * subpart which is replaced by a single 0xfffd code point (Unicode 3.9, U+FFFD
+     * substitution of maximal subparts)
+     * @param cp pointer to store the code point, 0xfffd for ill-formed sequence or
+     *   LSP_UTF32_EOF if the sequence is well-formed but truncated
+     * @param s pointer to the sequence
+     * @param avail number of available bytes, should be positive
+     * @return number of bytes that form the code point or the maximal subpart
+     */
+    static inline size_t utf8_decode_sequence(lsp_utf32_t *cp, const uint8_t *s, size_t avail)
+    {
+        lsp_utf32_t c = s[0];
+        if (c < 0x80)
         {
-            if (*nsrc > 1)
-                sc      = LE_TO_CPU(*s);
-            else if (force)
-                sc      = 0;
-            else
-                return LSP_UTF32_EOF;
+            *cp     = c;
+            return 1;
+        }
 
-            if ((sc & 0xfc00) == 0xdc00)
-            {
-                ++s;
-                cp  = 0x10000 + (((cp & 0x3ff) << 10) | (sc & 0x3ff));
-            }
-            else
-                cp  = 0xfffd;
+        // Determine the length of sequence and the valid range of the second byte
+        size_t bytes;
+        uint8_t lo = 0x80, hi = 0xbf;
+        if (c < 0xc2)       // Continuation byte or overlong 2-byte sequence
+        {
+            *cp     = 0xfffd;
+            return 1;
         }
-        else if (sc == 0xdc00) // Surrogate low?
+        else if (c < 0xe0)
         {
-            if (*nsrc > 1)
-                sc      = LE_TO_CPU(*s);
-            else if (force)
-                sc      = 0;
-            else
-                return LSP_UTF32_EOF;
-
-            if ((sc & 0xfc00) == 0xd800)
-            {
-                ++s;
-                cp  = 0x10000 + (((sc & 0x3ff) << 10) | (cp & 0x3ff));
-            }
-            else
-                cp  = 0xfffd;
+            bytes       = 2;
+            c          &= 0x1f;
         }
-
-        *nsrc  -= (s - *str);
-        *str    = s;
-        return cp;
-    }
-
-    lsp_utf32_t read_utf16be_streaming(const lsp_utf16_t **str, size_t *nsrc, bool force)
-    {
-        if (*nsrc <= 0)
-            return LSP_UTF32_EOF;
-
-        uint32_t cp, sc;
-        const lsp_utf16_t *s = *str;
-
-        cp = BE_TO_CPU(*(s++));
-        sc = cp & 0xfc00;
-        if (sc == 0xd800) // cp = Surrogate high
+        else if (c < 0xf0)
         {
-            if (*nsrc > 1)
-                sc      = BE_TO_CPU(*s);
-            else if (force)
-                sc      = 0;
-            else
-                return LSP_UTF32_EOF;
+            bytes       = 3;
+            c          &= 0x0f;
+            if (c == 0x00)          // Overlong 3-byte sequence
+                lo          = 0xa0;
+            else if (c == 0x0d)     // Surrogate
+                hi          = 0x9f;
+        }
+        else if (c < 0xf5)
+        {
+            bytes       = 4;
+            c          &= 0x07;
+            if (c == 0x00)          // Overlong 4-byte sequence
+                lo          = 0x90;
+            else if (c == 0x04)     // Code point above 0x10ffff
+                hi          = 0x8f;
+        }
+        else
+        {
+            *cp     = 0xfffd;
+            return 1;
+        }
 
-            if ((sc & 0xfc00) == 0xdc00)
+        // Decode extension bytes
+        for (size_t i=1; i<bytes; ++i)
+        {
+            if (i >= avail)
             {
-                ++s;
-                cp  = 0x10000 + (((cp & 0x3ff) << 10) | (sc & 0x3ff));
+                *cp     = LSP_UTF32_EOF;
+                return i;
             }
-            else
-                cp  = 0xfffd;
-        }
-        else if (sc == 0xdc00) // Surrogate low?
-        {
-            if (*nsrc > 1)
-                sc      = BE_TO_CPU(*s);
-            else if (force)
-                sc      = 0;
-            else
-                return LSP_UTF32_EOF;
 
-            if ((sc & 0xfc00) == 0xd800)
+            const uint8_t b = s[i];
+            if ((b < lo) || (b > hi))
             {
-                ++s;
-                cp  = 0x10000 + (((sc & 0x3ff) << 10) | (cp & 0x3ff));
+                *cp     = 0xfffd;
+                return i;
             }
-            else
-                cp  = 0xfffd;
+            c       = (c << 6) | (b & 0x3f);
+            lo      = 0x80;
+            hi      = 0xbf;
         }
 
-        *nsrc  -= (s - *str);
-        *str    = s;
-        return cp;
+        *cp     = c;
+        return bytes;
     }
 
-    inline size_t sizeof_utf16(lsp_utf32_t cp)
+    static size_t utf8_validate_tail(const char *src, size_t offset, size_t count)
     {
-        return (cp < 0x10000) ? 2 : 4;
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(src);
+        while (offset < count)
+        {
+            const size_t bytes = utf8_valid_sequence(&s[offset], count - offset);
+            if (bytes <= 0)
+                break;
+            offset     += bytes;
+        }
+        return offset;
     }
 
-    inline size_t count_utf16(lsp_utf32_t cp)
+    static size_t utf8_sequence_start(const char *src, size_t offset)
     {
-        return (cp < 0x10000) ? 1 : 2;
+        // Find the start of the last sequence that starts before the offset
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(src);
+        for (size_t i=offset, n=lsp_min(offset, size_t(4)); n > 0; --n)
+        {
+            const uint8_t c = s[--i];
+            if (c < 0x80)
+                return offset;
+            if ((c & 0xc0) != 0x80)
+                return i;
+        }
+        return offset;
     }
 
-    void write_utf16le_codepoint(lsp_utf16_t **str, lsp_utf32_t cp)
+    // Generic implementation
+    static size_t ascii_to_utf32_generic(lsp_utf32_t *dst, const char *src, size_t count)
     {
-        lsp_utf16_t *dst = *str;
-        if (cp < 0x10000)
-            *(dst++)        = CPU_TO_LE(lsp_utf16_t(cp));
-        else
+        size_t i = 0;
+        for ( ; i < count; ++i)
         {
-            cp     -= 0x10000;
-            dst[0]  = CPU_TO_LE(lsp_utf16_t(0xd800 | (cp >> 10)));
-            dst[1]  = CPU_TO_LE(lsp_utf16_t(0xdc00 | (cp & 0x3ff)));
-            dst    += 2;
+            const uint8_t c = uint8_t(src[i]);
+            if (c >= 0x80)
+                break;
+            dst[i]      = c;
         }
-        *str    = dst;
+        return i;
     }
 
-    void write_utf16be_codepoint(lsp_utf16_t **str, lsp_utf32_t cp)
+    static size_t utf32_to_ascii_generic(char *dst, const lsp_utf32_t *src, size_t count)
     {
-        lsp_utf16_t *dst = *str;
-        if (cp < 0x10000)
-            *(dst++)        = CPU_TO_BE(lsp_utf16_t(cp));
-        else
+        size_t i = 0;
+        for ( ; i < count; ++i)
         {
-            cp     -= 0x10000;
-            dst[0]  = CPU_TO_BE(lsp_utf16_t(0xd800 | (cp >> 10)));
-            dst[1]  = CPU_TO_BE(lsp_utf16_t(0xdc00 | (cp & 0x3ff)));
-            dst    += 2;
+            const lsp_utf32_t c = src[i];
+            if (c >= 0x80)
+                break;
+            dst[i]      = char(c);
         }
-        *str    = dst;
+        return i;
     }
 
-    //-------------------------------------------------------------------------
-    // UTF-8 helper routines
-    lsp_utf32_t read_utf8_codepoint(const char **str)
+    static size_t ascii_to_utf16_generic(lsp_utf16_t *dst, const char *src, size_t count)
     {
-        lsp_utf32_t cp, sp;
-        size_t bytes;
-        const char *s = *str;
-
-        // Decode primary byte
-        cp = uint8_t(*s);
-        if (cp <= 0x7f)
+        size_t i = 0;
+        for ( ; i < count; ++i)
         {
-            *str    = (cp == 0) ? s : s+1;
-            return cp;
+            const uint8_t c = uint8_t(src[i]);
+            if (c >= 0x80)
+                break;
+            dst[i]      = c;
         }
+        return i;
+    }
 
-        ++s;
-        if ((cp & 0xe0) == 0xc0) // 2 bytes: 110xxxxx 10xxxxxx
-        {
-            cp     &= 0x1f;
-            bytes   = (cp >= 0x02) ? 1 : 0;
-        }
-        else if ((cp & 0xf0) == 0xe0) // 3 bytes: 1110xxxx 10xxxxxx 10xxxxxx
-        {
-            cp     &= 0x0f;
-            bytes   = (cp) ? 2 : 0;
-        }
-        else if ((cp & 0xf8) == 0xf0) // 4 bytes: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+    static size_t utf16_to_ascii_generic(char *dst, const lsp_utf16_t *src, size_t count)
+    {
+        size_t i = 0;
+        for ( ; i < count; ++i)
         {
-            cp     &= 0x07;
-            bytes   = 3;
+            const lsp_utf16_t c = src[i];
+            if (c >= 0x80)
+                break;
+            dst[i]      = char(c);
         }
-        else
-            bytes   = 0;
+        return i;
+    }
 
-        // Invalid first byte sequence?
-        if (!bytes)
+    static size_t bmp_to_utf32_generic(lsp_utf32_t *dst, const lsp_utf16_t *src, size_t count)
+    {
+        size_t i = 0;
+        for ( ; i < count; ++i)
         {
-            *str    = s;
-            return 0xfffd;
+            const lsp_utf16_t c = src[i];
+            if ((c & 0xf800) == 0xd800)
+                break;
+            dst[i]      = c;
         }
+        return i;
+    }
 
-        // Decode extension bytes
-        for (size_t i=0; i<bytes; ++i)
+    static size_t utf32_to_bmp_generic(lsp_utf16_t *dst, const lsp_utf32_t *src, size_t count)
+    {
+        size_t i = 0;
+        for ( ; i < count; ++i)
         {
-            sp  = uint8_t(*s);
-            if ((sp & 0xc0) != 0x80) // Invalid sequence?
-            {
-                *str    = (sp == 0) ? s : s+1;
-                return 0xfffd;
-            }
-            cp     = (cp << 6) | (sp & 0x3f);
-            ++s;
+            const lsp_utf32_t c = src[i];
+            if (c >= 0x10000)
+                break;
+            dst[i]      = lsp_utf16_t(c);
         }
-
-        if ((bytes == 3) && (cp < 0x10000)) // Check that 4-byte sequence is valid
-            cp      = 0xfffd;
-        else if ((cp >= 0xd800) && (cp < 0xe000)) // Check for surrogates
-            cp      = 0xfffd;
-
-        *str = s;
-        return cp;
+        return i;
     }
 
-    lsp_utf32_t read_utf8_streaming(const char **str, size_t *nsrc, bool force)
+    static size_t utf8_validate_generic(const char *src, size_t count)
     {
-        if (*nsrc <= 0)
-            return LSP_UTF32_EOF;
+        return utf8_validate_tail(src, 0, count);
+    }
 
-        lsp_utf32_t cp, sp;
-        size_t bytes;
-        const char *s = *str;
+    static const utf_kernels_t utf_generic_kernels =
+    {
+        UTF_KERNEL_GENERIC,
+        ascii_to_utf32_generic,
+        utf32_to_ascii_generic,
+        ascii_to_utf16_generic,
+        utf16_to_ascii_generic,
+        bmp_to_utf32_generic,
+        utf32_to_bmp_generic,
+        utf8_validate_generic
+    };
 
-        // Decode primary byte
-        cp = uint8_t(*s);
-        if (cp <= 0x7f)
+#if defined(LSP_UTF_SSE2)
+    // SSE2 implementation
+    static size_t ascii_to_utf32_sse2(lsp_utf32_t *dst, const char *src, size_t count)
+    {
+        size_t i = 0;
+        const __m128i zero = _mm_setzero_si128();
+        for ( ; (i + 16) <= count; i += 16)
         {
-            *str    = (cp == 0) ? s : s+1;
-            --(*nsrc);
-            return cp;
-        }
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[i]));
+            if (_mm_movemask_epi8(v) != 0)
+                break;
 
-        // Multi-byte sequence
-        ++s;
-        if ((cp & 0xe0) == 0xc0) // 2 bytes: 110xxxxx 10xxxxxx
-        {
-            cp     &= 0x1f;
-            bytes   = (cp >= 0x02) ? 1 : 0;
+            const __m128i lo = _mm_unpacklo_epi8(v, zero);
+            const __m128i hi = _mm_unpackhi_epi8(v, zero);
+            __m128i *d = reinterpret_cast<__m128i *>(&dst[i]);
+            _mm_storeu_si128(&d[0], _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(&d[1], _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(&d[2], _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(&d[3], _mm_unpackhi_epi16(hi, zero));
         }
-        else if ((cp & 0xf0) == 0xe0) // 3 bytes: 1110xxxx 10xxxxxx 10xxxxxx
-        {
-            cp     &= 0x0f;
-            bytes   = (cp) ? 2 : 0;
-        }
-        else if ((cp & 0xf8) == 0xf0) // 4 bytes: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-        {
-            cp     &= 0x07;
-            bytes   = 3;
-        }
-        else
-            bytes   = 0;
 
-        // Invalid first byte sequence?
-        if (!bytes)
+        return i + ascii_to_utf32_generic(&dst[i], &src[i], count - i);
+    }
+
+    static size_t utf32_to_ascii_sse2(char *dst, const lsp_utf32_t *src, size_t count)
+    {
+        size_t i = 0;
+        const __m128i mask = _mm_set1_epi32(~0x7f);
+        const __m128i zero = _mm_setzero_si128();
+        for ( ; (i + 16) <= count; i += 16)
         {
-            *str    = s;
-            --(*nsrc);
-            return 0xfffd;
+            const __m128i *s = reinterpret_cast<const __m128i *>(&src[i]);
+            const __m128i v0 = _mm_loadu_si128(&s[0]);
+            const __m128i v1 = _mm_loadu_si128(&s[1]);
+            const __m128i v2 = _mm_loadu_si128(&s[2]);
+            const __m128i v3 = _mm_loadu_si128(&s[3]);
+            const __m128i x  = _mm_and_si128(_mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3)), mask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(x, zero)) != 0xffff)
+                break;
+
+            const __m128i lo = _mm_packs_epi32(v0, v1);
+            const __m128i hi = _mm_packs_epi32(v2, v3);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[i]), _mm_packus_epi16(lo, hi));
         }
-        else if (bytes >= *nsrc)
+
+        return i + utf32_to_ascii_generic(&dst[i], &src[i], count - i);
+    }
+
+    static size_t ascii_to_utf16_sse2(lsp_utf16_t *dst, const char *src, size_t count)
+    {
+        size_t i = 0;
+        const __m128i zero = _mm_setzero_si128();
+        for ( ; (i + 16) <= count; i += 16)
         {
-            if (force)
-            {
-                *nsrc   = 0;
-                return 0xfffd;
-            }
-            return LSP_UTF32_EOF;
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[i]));
+            if (_mm_movemask_epi8(v) != 0)
+                break;
+
+            __m128i *d = reinterpret_cast<__m128i *>(&dst[i]);
+            _mm_storeu_si128(&d[0], _mm_unpacklo_epi8(v, zero));
+            _mm_storeu_si128(&d[1], _mm_unpackhi_epi8(v, zero));
         }
 
-        // Decode extension bytes
-        for (size_t i=0; i<bytes; ++i)
+        return i + ascii_to_utf16_generic(&dst[i], &src[i], count - i);
+    }
+
+    static size_t utf16_to_ascii_sse2(char *dst, const lsp_utf16_t *src, size_t count)
+    {
+        size_t i = 0;
+        const __m128i mask = _mm_set1_epi16(~0x7f);
+        const __m128i zero = _mm_setzero_si128();
+        for ( ; (i + 16) <= count; i += 16)
         {
-            sp  = uint8_t(*s);
-            if ((sp & 0xc0) != 0x80) // Invalid sequence?
-            {
-                if (sp == 0)
-                    ++s;
-                *nsrc  -= (s - *str);
-                *str    = s;
-                return 0xfffd;
-            }
-            cp     = (cp << 6) | (sp & 0x3f);
-            ++s;
-        }
+            const __m128i *s = reinterpret_cast<const __m128i *>(&src[i]);
+            const __m128i v0 = _mm_loadu_si128(&s[0]);
+            const __m128i v1 = _mm_loadu_si128(&s[1]);
+            const __m128i x  = _mm_and_si128(_mm_or_si128(v0, v1), mask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(x, zero)) != 0xffff)
+                break;
 
-        if ((bytes == 3) && (cp < 0x10000)) // Check that 4-byte sequence is valid
-            cp      = 0xfffd;
-        else if ((cp >= 0xd800) && (cp < 0xe000)) // Check for surrogates
-            cp      = 0xfffd;
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[i]), _mm_packus_epi16(v0, v1));
+        }
 
-        *nsrc      -= (s - *str);
-        *str        = s;
-        return cp;
+        return i + utf16_to_ascii_generic(&dst[i], &src[i], count - i);
     }
 
-    inline size_t sizeof_utf8(lsp_utf32_t cp)
+    static size_t bmp_to_utf32_sse2(lsp_utf32_t *dst, const lsp_utf16_t *src, size_t count)
     {
-        if (cp >= 0x800)
-            return ((cp < 0x10000) || (cp >= 0x200000)) ? 3 : 4;
-        else
-            return (cp >= 0x80) ? 2 : 1;
+        size_t i = 0;
+        const __m128i mask = _mm_set1_epi16(short(0xf800));
+        const __m128i surr = _mm_set1_epi16(short(0xd800));
+        const __m128i zero = _mm_setzero_si128();
+        for ( ; (i + 8) <= count; i += 8)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[i]));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, mask), surr)) != 0)
+                break;
+
+            __m128i *d = reinterpret_cast<__m128i *>(&dst[i]);
+            _mm_storeu_si128(&d[0], _mm_unpacklo_epi16(v, zero));
+            _mm_storeu_si128(&d[1], _mm_unpackhi_epi16(v, zero));
+        }
+
+        return i + bmp_to_utf32_generic(&dst[i], &src[i], count - i);
     }
 
-    inline size_t count_utf8(lsp_utf32_t cp)
+    static size_t utf32_to_bmp_sse2(lsp_utf16_t *dst, const lsp_utf32_t *src, size_t count)
     {
-        if (cp >= 0x800)
-            return ((cp < 0x10000) || (cp >= 0x200000)) ? 3 : 4;
-        else
-            return (cp >= 0x80) ? 2 : 1;
+        size_t i = 0;
+        const __m128i mask = _mm_set1_epi32(int(0xffff0000));
+        const __m128i bias = _mm_set1_epi32(0x8000);
+        const __m128i bias16 = _mm_set1_epi16(short(0x8000));
+        const __m128i zero = _mm_setzero_si128();
+        for ( ; (i + 8) <= count; i += 8)
+        {
+            const __m128i *s = reinterpret_cast<const __m128i *>(&src[i]);
+            const __m128i v0 = _mm_loadu_si128(&s[0]);
+            const __m128i v1 = _mm_loadu_si128(&s[1]);
+            const __m128i x  = _mm_and_si128(_mm_or_si128(v0, v1), mask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(x, zero)) != 0xffff)
+                break;
+
+            // There is no unsigned 32-bit pack in SSE2, use signed one with bias
+            const __m128i p  = _mm_packs_epi32(_mm_sub_epi32(v0, bias), _mm_sub_epi32(v1, bias));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[i]), _mm_add_epi16(p, bias16));
+        }
+
+        return i + utf32_to_bmp_generic(&dst[i], &src[i], count - i);
     }
 
-    void write_utf8_codepoint(char **str, lsp_utf32_t cp)
+    static size_t utf8_validate_sse2(const char *src, size_t count)
     {
-        char *dst = *str;
-        if (cp >= 0x800) // 3-4 bytes
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(src);
+        size_t i = 0;
+        while ((i + 16) <= count)
         {
-            if (cp < 0x10000) // 3 bytes
-            {
-                dst[0]      = (cp >> 12) | 0xe0;
-                dst[1]      = ((cp >> 6) & 0x3f) | 0x80;
-                dst[2]      = (cp & 0x3f) | 0x80;
-                dst        += 3;
-            }
-            else if (cp < 0x200000) // 4 bytes
-            {
-                dst[0]      = (cp >> 16) | 0xf0;
-                dst[1]      = ((cp >> 12) & 0x3f) | 0x80;
-                dst[2]      = ((cp >> 6) & 0x3f) | 0x80;
-                dst[3]      = (cp & 0x3f) | 0x80;
-                dst        += 4;
-            }
-            else // Invalid character, emit 3 bytes of 0xfffd code point value
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[i]));
+            if (_mm_movemask_epi8(v) == 0)
             {
-                dst[0]      = 0xef;
-                dst[1]      = 0xbf;
-                dst[2]      = 0xbd;
-                dst        += 3;
+                i          += 16;
+                continue;
             }
-        }
-        else // 1-2 bytes
-        {
-            if (cp >= 0x80) // 2 bytes
+
+            // Validate characters that start within the block
+            for (const size_t end = i + 16; i < end; )
             {
-                dst[0]      = (cp >> 6) | 0xc0;
-                dst[1]      = (cp & 0x3f) | 0x80;
-                dst        += 2;
+                const size_t bytes = utf8_valid_sequence(&s[i], count - i);
+                if (bytes <= 0)
+                    return i;
+                i          += bytes;
             }
-            else // 1 byte
-                *(dst++)    = char(cp);
         }
-        *str    = dst;
+
+        return utf8_validate_tail(src, i, count);
     }
 
-    //-------------------------------------------------------------------------
-    // UTF-8 non-streaming routines
-    lsp_utf16_t *utf8_to_utf16le(const char *str)
+    static const utf_kernels_t utf_sse2_kernels =
     {
-        // Estimate number of bytes
-        lsp_utf32_t cp;
-        size_t bytes    = 0;
-        const char *p = str;
-        do
-        {
-            cp      = read_utf8_codepoint(&p);
-            bytes  += sizeof_utf16(cp);
-        } while (cp != 0);
+        UTF_KERNEL_SSE2,
+        ascii_to_utf32_sse2,
+        utf32_to_ascii_sse2,
+        ascii_to_utf16_sse2,
+        utf16_to_ascii_sse2,
+        bmp_to_utf32_sse2,
+        utf32_to_bmp_sse2,
+        utf8_validate_sse2
+    };
+#endif /* LSP_UTF_SSE2 */
 
-        // Allocate memory
-        lsp_utf16_t *utf16  = reinterpret_cast<lsp_utf16_t *>(::malloc(bytes));
-        if (utf16 == NULL)
-            return NULL;
+#if defined(LSP_UTF_AVX2)
+    // AVX2 implementation, the UTF-8 validation uses the lookup algorithm by J. Keiser and D. Lemire
+    LSP_UTF_TARGET_AVX2
+    static size_t ascii_to_utf32_avx2(lsp_utf32_t *dst, const char *src, size_t count)
+    {
+        size_t i = 0;
+        for ( ; (i + 32) <= count; i += 32)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&src[i]));
+            if (_mm256_movemask_epi8(v) != 0)
+                break;
 
-        // Perform encoding
-        lsp_utf16_t *dst = utf16;
-        p               = str;
-        while ((cp = read_utf8_codepoint(&p)) != 0)
-            write_utf16le_codepoint(&dst, cp);
-        *dst        = 0;
+            const __m128i lo = _mm256_castsi256_si128(v);
+            const __m128i hi = _mm256_extracti128_si256(v, 1);
+            __m256i *d = reinterpret_cast<__m256i *>(&dst[i]);
+            _mm256_storeu_si256(&d[0], _mm256_cvtepu8_epi32(lo));
+            _mm256_storeu_si256(&d[1], _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+            _mm256_storeu_si256(&d[2], _mm256_cvtepu8_epi32(hi));
+            _mm256_storeu_si256(&d[3], _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+        }
 
-        return utf16;
+        return i + ascii_to_utf32_generic(&dst[i], &src[i], count - i);
     }
 
-    lsp_utf16_t *utf8_to_utf16be(const char *str)
+    LSP_UTF_TARGET_AVX2
+    static size_t ascii_to_utf16_avx2(lsp_utf16_t *dst, const char *src, size_t count)
     {
-        // Estimate number of bytes
-        lsp_utf32_t cp;
-        size_t bytes    = 0;
-        const char *p = str;
-        do
+        size_t i = 0;
+        for ( ; (i + 32) <= count; i += 32)
         {
-            cp      = read_utf8_codepoint(&p);
-            bytes  += sizeof_utf16(cp);
-        } while (cp != 0);
-
-        // Allocate memory
-        lsp_utf16_t *utf16  = reinterpret_cast<lsp_utf16_t *>(::malloc(bytes));
-        if (utf16 == NULL)
-            return NULL;
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&src[i]));
+            if (_mm256_movemask_epi8(v) != 0)
+                break;
 
-        // Perform encoding
-        lsp_utf16_t *dst = utf16;
-        p               = str;
-        while ((cp = read_utf8_codepoint(&p)) != 0)
-            write_utf16be_codepoint(&dst, cp);
-        *dst        = 0;
+            __m256i *d = reinterpret_cast<__m256i *>(&dst[i]);
+            _mm256_storeu_si256(&d[0], _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+            _mm256_storeu_si256(&d[1], _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+        }
+
+        return i + ascii_to_utf16_generic(&dst[i], &src[i], count - i);
+    }
+
+    LSP_UTF_TARGET_AVX2
+    static inline __m256i utf8_lookup_avx2(__m256i idx, char b0, char b1, char b2, char b3, char b4, char b5, char b6, char b7,
+        char b8, char b9, char b10, char b11, char b12, char b13, char b14, char b15)
+    {
+        const __m256i table = _mm256_setr_epi8(
+            b0, b1, b2, b3, b4, b5, b6, b7, b8, b9, b10, b11, b12, b13, b14, b15,
+            b0, b1, b2, b3, b4, b5, b6, b7, b8, b9, b10, b11, b12, b13, b14, b15);
+        return _mm256_shuffle_epi8(table, idx);
+    }
+
+    LSP_UTF_TARGET_AVX2
+    static inline __m256i utf8_block_errors_avx2(__m256i input, __m256i prev_input)
+    {
+        // Error flags, see the description of the lookup algorithm
+        constexpr char TOO_SHORT    = 1 << 0;
+        constexpr char TOO_LONG     = 1 << 1;
+        constexpr char OVERLONG_3   = 1 << 2;
+        constexpr char TOO_LARGE    = 1 << 3;
+        constexpr char SURROGATE    = 1 << 4;
+        constexpr char OVERLONG_2   = 1 << 5;
+        constexpr char TOO_LARGE_1000 = 1 << 6;
+        constexpr char OVERLONG_4   = 1 << 6;
+        constexpr char TWO_CONTS    = char(1 << 7);
+        constexpr char CARRY        = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+        const __m256i nibble        = _mm256_set1_epi8(0x0f);
+        const __m256i shifted       = _mm256_permute2x128_si256(prev_input, input, 0x21);
+        const __m256i prev1         = _mm256_alignr_epi8(input, shifted, 16 - 1);
+        const __m256i prev2         = _mm256_alignr_epi8(input, shifted, 16 - 2);
+        const __m256i prev3         = _mm256_alignr_epi8(input, shifted, 16 - 3);
+
+        const __m256i byte_1_high   = utf8_lookup_avx2(
+            _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble),
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+            TOO_SHORT | OVERLONG_2,
+            TOO_SHORT,
+            TOO_SHORT | OVERLONG_3 | SURROGATE,
+            TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+        const __m256i byte_1_low    = utf8_lookup_avx2(
+            _mm256_and_si256(prev1, nibble),
+            CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+            CARRY | OVERLONG_2,
+            CARRY,
+            CARRY,
+            CARRY | TOO_LARGE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000);
+        const __m256i byte_2_high   = utf8_lookup_avx2(
+            _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble),
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+        const __m256i special       = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+        // Third and fourth bytes of multi-byte sequences should be continuations
+        const __m256i third         = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xe0 - 0x80)));
+        const __m256i fourth        = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xf0 - 0x80)));
+        const __m256i must23        = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(char(0x80)));
+
+        return _mm256_xor_si256(must23, special);
+    }
+
+    LSP_UTF_TARGET_AVX2
+    static size_t utf8_validate_avx2(const char *src, size_t count)
+    {
+        size_t i = 0;
+        __m256i prev = _mm256_setzero_si256();
+        for ( ; (i + 32) <= count; i += 32)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&src[i]));
+            if (_mm256_movemask_epi8(_mm256_or_si256(v, prev)) != 0)
+            {
+                // Errors caused by the trailing sequence of the previous block are
+                // also detected here
+                const __m256i err = utf8_block_errors_avx2(v, prev);
+                if (!_mm256_testz_si256(err, err))
+                    break;
+            }
+            prev            = v;
+        }
 
-        return utf16;
+        // Validate the rest starting with the last sequence that has not been checked
+        return utf8_validate_tail(src, utf8_sequence_start(src, i), count);
     }
 
-    size_t utf8_to_utf16le(lsp_utf16_t *dst, const char *str, size_t count)
+    static const utf_kernels_t utf_avx2_kernels =
     {
-        lsp_utf32_t cp;
-        size_t items    = 0;
-        do
+        UTF_KERNEL_AVX2,
+        ascii_to_utf32_avx2,
+        utf32_to_ascii_sse2,
+        ascii_to_utf16_avx2,
+        utf16_to_ascii_sse2,
+        bmp_to_utf32_sse2,
+        utf32_to_bmp_sse2,
+        utf8_validate_avx2
+    };
+#endif /* LSP_UTF_AVX2 */
+
+#if defined(LSP_UTF_NEON)
+    // NEON implementation, the UTF-8 validation uses the lookup algorithm by J. Keiser and D. Lemire
+    static size_t ascii_to_utf32_neon(lsp_utf32_t *dst, const char *src, size_t count)
+    {
+        size_t i = 0;
+        for ( ; (i + 16) <= count; i += 16)
         {
-            cp      = read_utf8_codepoint(&str);
-            items  += count_utf16(cp);
-            if (items > count)
-                return 0;
+            const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(&src[i]));
+            if (vmaxvq_u8(v) >= 0x80)
+                break;
 
-            write_utf16le_codepoint(&dst, cp);
-        } while (cp != 0);
+            const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+            const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+            uint32_t *d = reinterpret_cast<uint32_t *>(&dst[i]);
+            vst1q_u32(&d[0], vmovl_u16(vget_low_u16(lo)));
+            vst1q_u32(&d[4], vmovl_u16(vget_high_u16(lo)));
+            vst1q_u32(&d[8], vmovl_u16(vget_low_u16(hi)));
+            vst1q_u32(&d[12], vmovl_u16(vget_high_u16(hi)));
+        }
 
-        return items;
+        return i + ascii_to_utf32_generic(&dst[i], &src[i], count - i);
     }
 
-    size_t utf8_to_utf16be(lsp_utf16_t *dst, const char *str, size_t count)
+    static size_t utf32_to_ascii_neon(char *dst, const lsp_utf32_t *src, size_t count)
     {
-        lsp_utf32_t cp;
-        size_t items    = 0;
-        do
+        size_t i = 0;
+        for ( ; (i + 16) <= count; i += 16)
         {
-            cp      = read_utf8_codepoint(&str);
-            items  += count_utf16(cp);
-            if (items > count)
-                return 0;
+            const uint32_t *s = reinterpret_cast<const uint32_t *>(&src[i]);
+            const uint32x4_t v0 = vld1q_u32(&s[0]);
+            const uint32x4_t v1 = vld1q_u32(&s[4]);
+            const uint32x4_t v2 = vld1q_u32(&s[8]);
+            const uint32x4_t v3 = vld1q_u32(&s[12]);
+            if (vmaxvq_u32(vorrq_u32(vorrq_u32(v0, v1), vorrq_u32(v2, v3))) >= 0x80)
+                break;
 
-            write_utf16be_codepoint(&dst, cp);
-        } while (cp != 0);
+            const uint16x8_t lo = vcombine_u16(vmovn_u32(v0), vmovn_u32(v1));
+            const uint16x8_t hi = vcombine_u16(vmovn_u32(v2), vmovn_u32(v3));
+            vst1q_u8(reinterpret_cast<uint8_t *>(&dst[i]), vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+        }
 
-        return items;
+        return i + utf32_to_ascii_generic(&dst[i], &src[i], count - i);
     }
 
-    lsp_utf32_t *utf8_to_utf32le(const char *str)
+    static size_t ascii_to_utf16_neon(lsp_utf16_t *dst, const char *src, size_t count)
     {
-        // Estimate number of bytes
-        lsp_utf32_t cp;
-        size_t bytes    = 0;
-        const char *p = str;
-        do
+        size_t i = 0;
+        for ( ; (i + 16) <= count; i += 16)
         {
-            cp      = read_utf8_codepoint(&p);
-            bytes  += sizeof(lsp_utf32_t);
-        } while (cp != 0);
-
-        // Allocate memory
-        lsp_utf32_t *utf32  = reinterpret_cast<lsp_utf32_t *>(::malloc(bytes));
-        if (utf32 == NULL)
-            return NULL;
+            const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(&src[i]));
+            if (vmaxvq_u8(v) >= 0x80)
+                break;
 
-        // Perform encoding
-        lsp_utf32_t *dst = utf32;
-        p               = str;
-        while ((cp = read_utf8_codepoint(&p)) != 0)
-            *(dst++)    = CPU_TO_LE(cp);
-        *dst        = 0;
+            uint16_t *d = reinterpret_cast<uint16_t *>(&dst[i]);
+            vst1q_u16(&d[0], vmovl_u8(vget_low_u8(v)));
+            vst1q_u16(&d[8], vmovl_u8(vget_high_u8(v)));
+        }
 
-        return utf32;
+        return i + ascii_to_utf16_generic(&dst[i], &src[i], count - i);
     }
 
-    lsp_utf32_t *utf8_to_utf32be(const char *str)
+    static size_t utf16_to_ascii_neon(char *dst, const lsp_utf16_t *src, size_t count)
     {
-        // Estimate number of bytes
-        lsp_utf32_t cp;
-        size_t bytes    = 0;
-        const char *p = str;
-        do
+        size_t i = 0;
+        for ( ; (i + 16) <= count; i += 16)
         {
-            cp      = read_utf8_codepoint(&p);
-            bytes  += sizeof(lsp_utf32_t);
-        } while (cp != 0);
-
-        // Allocate memory
-        lsp_utf32_t *utf32  = reinterpret_cast<lsp_utf32_t *>(::malloc(bytes));
-        if (utf32 == NULL)
-            return NULL;
+            const uint16_t *s = reinterpret_cast<const uint16_t *>(&src[i]);
+            const uint16x8_t v0 = vld1q_u16(&s[0]);
+            const uint16x8_t v1 = vld1q_u16(&s[8]);
+            if (vmaxvq_u16(vorrq_u16(v0, v1)) >= 0x80)
+                break;
 
-        // Perform encoding
-        lsp_utf32_t *dst = utf32;
-        p               = str;
-        while ((cp = read_utf8_codepoint(&p)) != 0)
-            *(dst++)    = CPU_TO_BE(cp);
-        *dst        = 0;
+            vst1q_u8(reinterpret_cast<uint8_t *>(&dst[i]), vcombine_u8(vmovn_u16(v0), vmovn_u16(v1)));
+        }
 
-        return utf32;
+        return i + utf16_to_ascii_generic(&dst[i], &src[i], count - i);
     }
 
-    size_t utf8_to_utf32le(lsp_utf32_t *dst, const char *str, size_t count)
+    static size_t bmp_to_utf32_neon(lsp_utf32_t *dst, const lsp_utf16_t *src, size_t count)
     {
-        lsp_utf32_t cp;
-        size_t items    = 0;
-        do
+        size_t i = 0;
+        const uint16x8_t mask = vdupq_n_u16(0xf800);
+        const uint16x8_t surr = vdupq_n_u16(0xd800);
+        for ( ; (i + 8) <= count; i += 8)
         {
-            cp      = read_utf8_codepoint(&str);
-            if (++items > count)
-                return 0;
-            *(dst++)        = CPU_TO_LE(cp);
-        } while (cp != 0);
+            const uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t *>(&src[i]));
+            if (vmaxvq_u16(vceqq_u16(vandq_u16(v, mask), surr)) != 0)
+                break;
 
-        return items;
+            uint32_t *d = reinterpret_cast<uint32_t *>(&dst[i]);
+            vst1q_u32(&d[0], vmovl_u16(vget_low_u16(v)));
+            vst1q_u32(&d[4], vmovl_u16(vget_high_u16(v)));
+        }
+
+        return i + bmp_to_utf32_generic(&dst[i], &src[i], count - i);
     }
 
-    size_t utf8_to_utf32be(lsp_utf32_t *dst, const char *str, size_t count)
+    static size_t utf32_to_bmp_neon(lsp_utf16_t *dst, const lsp_utf32_t *src, size_t count)
     {
-        lsp_utf32_t cp;
-        size_t items    = 0;
-        do
+        size_t i = 0;
+        for ( ; (i + 8) <= count; i += 8)
         {
-            cp      = read_utf8_codepoint(&str);
-            if (++items > count)
-                return 0;
-            *(dst++)        = CPU_TO_BE(cp);
-        } while (cp != 0);
+            const uint32_t *s = reinterpret_cast<const uint32_t *>(&src[i]);
+            const uint32x4_t v0 = vld1q_u32(&s[0]);
+            const uint32x4_t v1 = vld1q_u32(&s[4]);
+            if (vmaxvq_u32(vorrq_u32(v0, v1)) >= 0x10000)
+                break;
 
-        return items;
+            vst1q_u16(reinterpret_cast<uint16_t *>(&dst[i]), vcombine_u16(vmovn_u32(v0), vmovn_u32(v1)));
+        }
+
+        return i + utf32_to_bmp_generic(&dst[i], &src[i], count - i);
+    }
+
+    static inline uint8x16_t utf8_lookup_neon(uint8x16_t idx, uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3,
+        uint8_t b4, uint8_t b5, uint8_t b6, uint8_t b7, uint8_t b8, uint8_t b9, uint8_t b10, uint8_t b11,
+        uint8_t b12, uint8_t b13, uint8_t b14, uint8_t b15)
+    {
+        const uint8_t table[16] = { b0, b1, b2, b3, b4, b5, b6, b7, b8, b9, b10, b11, b12, b13, b14, b15 };
+        return vqtbl1q_u8(vld1q_u8(table), idx);
+    }
+
+    static inline uint8x16_t utf8_block_errors_neon(uint8x16_t input, uint8x16_t prev_input)
+    {
+        // Error flags, see the description of the lookup algorithm
+        constexpr uint8_t TOO_SHORT     = 1 << 0;
+        constexpr uint8_t TOO_LONG      = 1 << 1;
+        constexpr uint8_t OVERLONG_3    = 1 << 2;
+        constexpr uint8_t TOO_LARGE     = 1 << 3;
+        constexpr uint8_t SURROGATE     = 1 << 4;
+        constexpr uint8_t OVERLONG_2    = 1 << 5;
+        constexpr uint8_t TOO_LARGE_1000 = 1 << 6;
+        constexpr uint8_t OVERLONG_4    = 1 << 6;
+        constexpr uint8_t TWO_CONTS     = 1 << 7;
+        constexpr uint8_t CARRY         = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+        const uint8x16_t nibble         = vdupq_n_u8(0x0f);
+        const uint8x16_t prev1          = vextq_u8(prev_input, input, 16 - 1);
+        const uint8x16_t prev2          = vextq_u8(prev_input, input, 16 - 2);
+        const uint8x16_t prev3          = vextq_u8(prev_input, input, 16 - 3);
+
+        const uint8x16_t byte_1_high    = utf8_lookup_neon(
+            vshrq_n_u8(prev1, 4),
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+            TOO_SHORT | OVERLONG_2,
+            TOO_SHORT,
+            TOO_SHORT | OVERLONG_3 | SURROGATE,
+            TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+        const uint8x16_t byte_1_low     = utf8_lookup_neon(
+            vandq_u8(prev1, nibble),
+            CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+            CARRY | OVERLONG_2,
+            CARRY,
+            CARRY,
+            CARRY | TOO_LARGE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000);
+        const uint8x16_t byte_2_high    = utf8_lookup_neon(
+            vshrq_n_u8(input, 4),
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+        const uint8x16_t special        = vandq_u8(vandq_u8(byte_1_high, byte_1_low), byte_2_high);
+
+        // Third and fourth bytes of multi-byte sequences should be continuations
+        const uint8x16_t third          = vqsubq_u8(prev2, vdupq_n_u8(0xe0 - 0x80));
+        const uint8x16_t fourth         = vqsubq_u8(prev3, vdupq_n_u8(0xf0 - 0x80));
+        const uint8x16_t must23         = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+
+        return veorq_u8(must23, special);
+    }
+
+    static size_t utf8_validate_neon(const char *src, size_t count)
+    {
+        size_t i = 0;
+        uint8x16_t prev = vdupq_n_u8(0);
+        for ( ; (i + 16) <= count; i += 16)
+        {
+            const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(&src[i]));
+            if (vmaxvq_u8(vorrq_u8(v, prev)) >= 0x80)
+            {
+                // Errors caused by the trailing sequence of the previous block are
+                // also detected here
+                if (vmaxvq_u8(utf8_block_errors_neon(v, prev)) != 0)
+                    break;
+            }
+            prev            = v;
+        }
+
+        // Validate the rest starting with the last sequence that has not been checked
+        return utf8_validate_tail(src, utf8_sequence_start(src, i), count);
     }
 
-    //-------------------------------------------------------------------------
-    // UTF-16 non-streaming routines
-    char *utf16le_to_utf8(const lsp_utf16_t *str)
+    static const utf_kernels_t utf_neon_kernels =
     {
-        // Estimate number of bytes
-        lsp_utf32_t cp;
-        size_t bytes = 0;
-        const lsp_utf16_t *p = str;
-        do
-        {
-            cp          = read_utf16le_codepoint(&p);
-            bytes      += sizeof_utf8(cp);
-        } while (cp != 0);
+        UTF_KERNEL_NEON,
+        ascii_to_utf32_neon,
+        utf32_to_ascii_neon,
+        ascii_to_utf16_neon,
+        utf16_to_ascii_neon,
+        bmp_to_utf32_neon,
+        utf32_to_bmp_neon,
+        utf8_validate_neon
+    };
+#endif /* LSP_UTF_NEON */
+
+    // Runtime dispatching
+    static const utf_kernels_t *utf_find_kernels(utf_kernel_t kernel)
+    {
+        switch (kernel)
+        {
+            case UTF_KERNEL_AUTO:
+#if defined(LSP_UTF_AVX2)
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2"))
+                    return &utf_avx2_kernels;
+#endif /* LSP_UTF_AVX2 */
+#if defined(LSP_UTF_SSE2)
+                return &utf_sse2_kernels;
+#elif defined(LSP_UTF_NEON)
+                return &utf_neon_kernels;
+#else
+                return &utf_generic_kernels;
+#endif
 
-        // Allocate memory
-        char *utf8  = reinterpret_cast<char *>(::malloc(bytes));
-        if (utf8 == NULL)
-            return NULL;
+            case UTF_KERNEL_GENERIC:
+                return &utf_generic_kernels;
 
-        // Now perform encoding
-        char *dst   = utf8;
-        p           = str;
-        while ((cp = read_utf16le_codepoint(&p)) != 0)
-            write_utf8_codepoint(&dst, cp);
-        *dst = '\0';
+#if defined(LSP_UTF_SSE2)
+            case UTF_KERNEL_SSE2:
+                return &utf_sse2_kernels;
+#endif /* LSP_UTF_SSE2 */
+
+#if defined(LSP_UTF_AVX2)
+            case UTF_KERNEL_AVX2:
+                __builtin_cpu_init();
+                return (__builtin_cpu_supports("avx2")) ? &utf_avx2_kernels : NULL;
+#endif /* LSP_UTF_AVX2 */
+
+#if defined(LSP_UTF_NEON)
+            case UTF_KERNEL_NEON:
+                return &utf_neon_kernels;
+#endif /* LSP_UTF_NEON */
 
-        return utf8;
+            default:
+                break;
+        }
+
+        return NULL;
     }
 
-    char *utf16be_to_utf8(const lsp_utf16_t *str)
+    // The pointer is initialized during the static initialization of the library,
+    // the lazy initialization covers calls from constructors of other static objects
+    static const utf_kernels_t *utf_active_kernels = utf_find_kernels(UTF_KERNEL_AUTO);
+
+    static inline const utf_kernels_t *utf_kernels()
     {
-        // Estimate number of bytes
-        lsp_utf32_t cp;
-        size_t bytes = 0;
-        const lsp_utf16_t *p = str;
-        do
-        {
-            cp          = read_utf16be_codepoint(&p);
-            bytes      += sizeof_utf8(cp);
-        } while (cp != 0);
+        if (utf_active_kernels == NULL)
+            utf_active_kernels  = utf_find_kernels(UTF_KERNEL_AUTO);
+        return utf_active_kernels;
+    }
 
-        // Allocate memory
-        char *utf8  = reinterpret_cast<char *>(::malloc(bytes));
-        if (utf8 == NULL)
-            return NULL;
+    status_t select_utf_kernel(utf_kernel_t kernel)
+    {
+        const utf_kernels_t *k = utf_find_kernels(kernel);
+        if (k == NULL)
+            return STATUS_NOT_SUPPORTED;
 
-        // Now perform encoding
-        char *dst   = utf8;
-        p           = str;
-        while ((cp = read_utf16be_codepoint(&p)) != 0)
-            write_utf8_codepoint(&dst, cp);
-        *dst = '\0';
+        utf_active_kernels  = k;
+        return STATUS_OK;
+    }
 
-        return utf8;
+    utf_kernel_t utf_kernel()
+    {
+        return utf_kernels()->id;
     }
 
-    size_t utf16le_to_utf8(char *dst, const lsp_utf16_t *str, size_t count)
+    size_t ascii_to_utf32(lsp_utf32_t *dst, const char *src, size_t count)
     {
-        lsp_utf32_t cp;
-        size_t items = 0;
-        do
+        return utf_kernels()->ascii_to_utf32(dst, src, count);
+    }
+
+    size_t utf32_to_ascii(char *dst, const lsp_utf32_t *src, size_t count)
+    {
+        return utf_kernels()->utf32_to_ascii(dst, src, count);
+    }
+
+    size_t utf8_validate(const char *src, size_t count)
+    {
+        return utf_kernels()->utf8_validate(src, count);
+    }
+
+    //-------------------------------------------------------------------------
+    // UTF-16 helper routines
+    lsp_utf32_t read_utf16le_codepoint(const lsp_utf16_t **str)
+    {
+        uint32_t cp, sc;
+        const lsp_utf16_t *s = *str;
+
+        cp = LE_TO_CPU(*(s++));
+        if (cp == 0)
+            return cp;
+
+        sc = cp & 0xfc00;
+        if (sc == 0xd800) // cp = Surrogate high
         {
-            cp          = read_utf16le_codepoint(&str);
-            items      += count_utf8(cp);
-            if (items > count)
-                return 0;
-            write_utf8_codepoint(&dst, cp);
-        } while (cp != 0);
+            sc = LE_TO_CPU(*s);
+            if ((sc & 0xfc00) == 0xdc00)
+            {
+                ++s;
+                cp  = 0x10000 + (((cp & 0x3ff) << 10) | (sc & 0x3ff));
+            }
+            else
+                cp  = 0xfffd;
+        }
+        else if (sc == 0xdc00) // Surrogate low?
+        {
+            sc = LE_TO_CPU(*s);
+            if ((sc & 0xfc00) == 0xd800)
+            {
+                ++s;
+                cp  = 0x10000 + (((sc & 0x3ff) << 10) | (cp & 0x3ff));
+            }
+            else
+                cp  = 0xfffd;
+        }
+
+        *str = s;
+        return cp;
+    }
+
+    lsp_utf32_t read_utf16be_codepoint(const lsp_utf16_t **str)
+    {
+        uint32_t cp, sc;
+        const lsp_utf16_t *s = *str;
+
+        cp = BE_TO_CPU(*(s++));
+        if (cp == 0)
+            return cp;
+
+        sc = cp & 0xfc00;
+        if (sc == 0xd800) // cp = Surrogate high
+        {
+            sc = BE_TO_CPU(*s);
+            if ((sc & 0xfc00) == 0xdc00)
+            {
+                ++s;
+                cp  = 0x10000 + (((cp & 0x3ff) << 10) | (sc & 0x3ff));
+            }
+            else
+                cp  = 0xfffd;
+        }
+        else if (sc == 0xdc00) // Surrogate low?
+        {
+            sc = BE_TO_CPU(*s);
+            if ((sc & 0xfc00) == 0xd800)
+            {
+                ++s;
+                cp  = 0x10000 + (((sc & 0x3ff) << 10) | (cp & 0x3ff));
+            }
+            else
+                cp  = 0xfffd;
+        }
+
+        *str = s;
+        return cp;
+    }
+
+    lsp_utf32_t read_utf16le_streaming(const lsp_utf16_t **str, size_t *nsrc, bool force)
+    {
+        if (*nsrc <= 0)
+            return LSP_UTF32_EOF;
+
+        uint32_t cp, sc;
+        const lsp_utf16_t *s = *str;
+
+        cp = LE_TO_CPU(*(s++));
+        sc = cp & 0xfc00;
+        if (sc == 0xd800) // cp = Surrogate high
+        {
+            if (*nsrc > 1)
+                sc      = LE_TO_CPU(*s);
+            else if (force)
+                sc      = 0;
+            else
+                return LSP_UTF32_EOF;
+
+            if ((sc & 0xfc00) == 0xdc00)
+            {
+                ++s;
+                cp  = 0x10000 + (((cp & 0x3ff) << 10) | (sc & 0x3ff));
+            }
+            else
+                cp  = 0xfffd;
+        }
+        else if (sc == 0xdc00) // Surrogate low?
+        {
+            if (*nsrc > 1)
+                sc      = LE_TO_CPU(*s);
+            else if (force)
+                sc      = 0;
+            else
+                return LSP_UTF32_EOF;
+
+            if ((sc & 0xfc00) == 0xd800)
+            {
+                ++s;
+                cp  = 0x10000 + (((sc & 0x3ff) << 10) | (cp & 0x3ff));
+            }
+            else
+                cp  = 0xfffd;
+        }
+
+        *nsrc  -= (s - *str);
+        *str    = s;
+        return cp;
+    }
+
+    lsp_utf32_t read_utf16be_streaming(const lsp_utf16_t **str, size_t *nsrc, bool force)
+    {
+        if (*nsrc <= 0)
+            return LSP_UTF32_EOF;
+
+        uint32_t cp, sc;
+        const lsp_utf16_t *s = *str;
+
+        cp = BE_TO_CPU(*(s++));
+        sc = cp & 0xfc00;
+        if (sc == 0xd800) // cp = Surrogate high
+        {
+            if (*nsrc > 1)
+                sc      = BE_TO_CPU(*s);
+            else if (force)
+                sc      = 0;
+            else
+                return LSP_UTF32_EOF;
+
+            if ((sc & 0xfc00) == 0xdc00)
+            {
+                ++s;
+                cp  = 0x10000 + (((cp & 0x3ff) << 10) | (sc & 0x3ff));
+            }
+            else
+                cp  = 0xfffd;
+        }
+        else if (sc == 0xdc00) // Surrogate low?
+        {
+            if (*nsrc > 1)
+                sc      = BE_TO_CPU(*s);
+            else if (force)
+                sc      = 0;
+            else
+                return LSP_UTF32_EOF;
+
+            if ((sc & 0xfc00) == 0xd800)
+            {
+                ++s;
+                cp  = 0x10000 + (((sc & 0x3ff) << 10) | (cp & 0x3ff));
+            }
+            else
+                cp  = 0xfffd;
+        }
+
+        *nsrc  -= (s - *str);
+        *str    = s;
+        return cp;
+    }
+
+    inline size_t sizeof_utf16(lsp_utf32_t cp)
+    {
+        return (cp < 0x10000) ? 2 : 4;
+    }
+
+    inline size_t count_utf16(lsp_utf32_t cp)
+    {
+        return (cp < 0x10000) ? 1 : 2;
+    }
+
+    void write_utf16le_codepoint(lsp_utf16_t **str, lsp_utf32_t cp)
+    {
+        lsp_utf16_t *dst = *str;
+        if (cp < 0x10000)
+            *(dst++)        = CPU_TO_LE(lsp_utf16_t(cp));
+        else
+        {
+            cp     -= 0x10000;
+            dst[0]  = CPU_TO_LE(lsp_utf16_t(0xd800 | (cp >> 10)));
+            dst[1]  = CPU_TO_LE(lsp_utf16_t(0xdc00 | (cp & 0x3ff)));
+            dst    += 2;
+        }
+        *str    = dst;
+    }
+
+    void write_utf16be_codepoint(lsp_utf16_t **str, lsp_utf32_t cp)
+    {
+        lsp_utf16_t *dst = *str;
+        if (cp < 0x10000)
+            *(dst++)        = CPU_TO_BE(lsp_utf16_t(cp));
+        else
+        {
+            cp     -= 0x10000;
+            dst[0]  = CPU_TO_BE(lsp_utf16_t(0xd800 | (cp >> 10)));
+            dst[1]  = CPU_TO_BE(lsp_utf16_t(0xdc00 | (cp & 0x3ff)));
+            dst    += 2;
+        }
+        *str    = dst;
+    }
+
+    //-------------------------------------------------------------------------
+    // UTF-8 helper routines
+    lsp_utf32_t read_utf8_codepoint(const char **str)
+    {
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(*str);
+        if (*s == 0)
+            return 0;
+
+        // The terminating zero never matches continuation byte, so the decoder
+        // can not go beyond the end of string
+        lsp_utf32_t cp;
+        const size_t bytes = utf8_decode_sequence(&cp, s, size_t(-1));
+        *str   += bytes;
+        return cp;
+    }
+
+    lsp_utf32_t read_utf8_streaming(const char **str, size_t *nsrc, bool force)
+    {
+        if (*nsrc <= 0)
+            return LSP_UTF32_EOF;
+
+        lsp_utf32_t cp;
+        const size_t bytes = utf8_decode_sequence(&cp, reinterpret_cast<const uint8_t *>(*str), *nsrc);
+
+        // Incomplete sequence?
+        if (cp == LSP_UTF32_EOF)
+        {
+            if (!force)
+                return LSP_UTF32_EOF;
+            cp      = 0xfffd;
+        }
+
+        *str       += bytes;
+        *nsrc      -= bytes;
+        return cp;
+    }
+
+    inline size_t sizeof_utf8(lsp_utf32_t cp)
+    {
+        if (cp >= 0x800)
+            return ((cp < 0x10000) || (cp >= 0x200000)) ? 3 : 4;
+        else
+            return (cp >= 0x80) ? 2 : 1;
+    }
+
+    inline size_t count_utf8(lsp_utf32_t cp)
+    {
+        if (cp >= 0x800)
+            return ((cp < 0x10000) || (cp >= 0x200000)) ? 3 : 4;
+        else
+            return (cp >= 0x80) ? 2 : 1;
+    }
+
+    void write_utf8_codepoint(char **str, lsp_utf32_t cp)
+    {
+        char *dst = *str;
+        if (cp >= 0x800) // 3-4 bytes
+        {
+            if (cp < 0x10000) // 3 bytes
+            {
+                dst[0]      = (cp >> 12) | 0xe0;
+                dst[1]      = ((cp >> 6) & 0x3f) | 0x80;
+                dst[2]      = (cp & 0x3f) | 0x80;
+                dst        += 3;
+            }
+            else if (cp < 0x200000) // 4 bytes
+            {
+                dst[0]      = (cp >> 18) | 0xf0;
+                dst[1]      = ((cp >> 12) & 0x3f) | 0x80;
+                dst[2]      = ((cp >> 6) & 0x3f) | 0x80;
+                dst[3]      = (cp & 0x3f) | 0x80;
+                dst        += 4;
+            }
+            else // Invalid character, emit 3 bytes of 0xfffd code point value
+            {
+                dst[0]      = 0xef;
+                dst[1]      = 0xbf;
+                dst[2]      = 0xbd;
+                dst        += 3;
+            }
+        }
+        else // 1-2 bytes
+        {
+            if (cp >= 0x80) // 2 bytes
+            {
+                dst[0]      = (cp >> 6) | 0xc0;
+                dst[1]      = (cp & 0x3f) | 0x80;
+                dst        += 2;
+            }
+            else // 1 byte
+                *(dst++)    = char(cp);
+        }
+        *str    = dst;
+    }
+
+    //-------------------------------------------------------------------------
+    // Streaming routines
+    //
+    // The runs of characters that do not require special handling are converted
+    // by bulk conversion kernels, other characters are converted by the routines
+    // that read and write single code points. UTF-8 input is validated block by
+    // block, valid blocks are decoded without any further checks.
+    static constexpr bool   UTF_NATIVE_LE       = __IF_LEBE(true, false);
+    static constexpr size_t UTF8_BLOCK_SIZE     = 0x1000;
+
+    template <bool le, class T>
+        static inline T utf_order(T v)
+        {
+            return (le == UTF_NATIVE_LE) ? v : byte_swap(v);
+        }
+
+    template <bool le, class T>
+        static inline void utf_reorder(T *dst, size_t count)
+        {
+            if (le != UTF_NATIVE_LE)
+            {
+                for (size_t i=0; i<count; ++i)
+                    dst[i]      = byte_swap(dst[i]);
+            }
+        }
+
+    template <bool le>
+        static inline lsp_utf32_t utf16_read_streaming(const lsp_utf16_t **str, size_t *nsrc, bool force)
+        {
+            return (le) ? read_utf16le_streaming(str, nsrc, force) : read_utf16be_streaming(str, nsrc, force);
+        }
+
+    template <bool le>
+        static inline void utf16_write_codepoint(lsp_utf16_t **str, lsp_utf32_t cp)
+        {
+            if (le)
+                write_utf16le_codepoint(str, cp);
+            else
+                write_utf16be_codepoint(str, cp);
+        }
+
+    static size_t utf8_decode_valid(lsp_utf32_t *dst, const char *src, size_t count, const utf_kernels_t *k)
+    {
+        const uint8_t *s    = reinterpret_cast<const uint8_t *>(src);
+        size_t i = 0, n = 0;
+
+        while (i < count)
+        {
+            // Convert the run of ASCII characters
+            const size_t run    = k->ascii_to_utf32(&dst[n], &src[i], count - i);
+            i                  += run;
+            n                  += run;
+
+            // Decode multi-byte characters until the next ASCII character
+            while (i < count)
+            {
+                const lsp_utf32_t c = s[i];
+                if (c < 0x80)
+                    break;
+                else if (c < 0xe0)
+                {
+                    dst[n++]    = ((c & 0x1f) << 6) | (s[i+1] & 0x3f);
+                    i          += 2;
+                }
+                else if (c < 0xf0)
+                {
+                    dst[n++]    = ((c & 0x0f) << 12) | ((s[i+1] & 0x3f) << 6) | (s[i+2] & 0x3f);
+                    i          += 3;
+                }
+                else
+                {
+                    dst[n++]    = ((c & 0x07) << 18) | ((s[i+1] & 0x3f) << 12) | ((s[i+2] & 0x3f) << 6) | (s[i+3] & 0x3f);
+                    i          += 4;
+                }
+            }
+        }
+
+        return n;
+    }
+
+    static size_t utf8_decode_valid(lsp_utf16_t *dst, size_t *chars, const char *src, size_t count, const utf_kernels_t *k)
+    {
+        const uint8_t *s    = reinterpret_cast<const uint8_t *>(src);
+        size_t i = 0, n = 0, nc = 0;
+
+        while (i < count)
+        {
+            // Convert the run of ASCII characters
+            const size_t run    = k->ascii_to_utf16(&dst[n], &src[i], count - i);
+            i                  += run;
+            n                  += run;
+            nc                 += run;
+
+            // Decode multi-byte characters until the next ASCII character
+            for ( ; i < count; ++nc)
+            {
+                lsp_utf32_t c = s[i];
+                if (c < 0x80)
+                    break;
+                else if (c < 0xe0)
+                {
+                    dst[n++]    = lsp_utf16_t(((c & 0x1f) << 6) | (s[i+1] & 0x3f));
+                    i          += 2;
+                }
+                else if (c < 0xf0)
+                {
+                    dst[n++]    = lsp_utf16_t(((c & 0x0f) << 12) | ((s[i+1] & 0x3f) << 6) | (s[i+2] & 0x3f));
+                    i          += 3;
+                }
+                else
+                {
+                    c           = (((c & 0x07) << 18) | ((s[i+1] & 0x3f) << 12) | ((s[i+2] & 0x3f) << 6) | (s[i+3] & 0x3f)) - 0x10000;
+                    dst[n++]    = lsp_utf16_t(0xd800 | (c >> 10));
+                    dst[n++]    = lsp_utf16_t(0xdc00 | (c & 0x3ff));
+                    i          += 4;
+                }
+            }
+        }
+
+        *chars              = nc;
+        return n;
+    }
+
+    template <bool le>
+        static size_t utf8_to_utf32_bulk(lsp_utf32_t *dst, size_t *ndst, const char *src, size_t *nsrc, bool force)
+        {
+            const utf_kernels_t *k  = utf_kernels();
+            const size_t dcap       = *ndst;
+            const size_t scap       = *nsrc;
+            size_t di = 0, si = 0;
+
+            while ((di < dcap) && (si < scap))
+            {
+                // Each valid character takes at least one byte, so the validated block
+                // always fits into the output buffer
+                const size_t count  = lsp_min(lsp_min(scap - si, dcap - di), UTF8_BLOCK_SIZE);
+                const size_t valid  = k->utf8_validate(&src[si], count);
+                if (valid > 0)
+                {
+                    const size_t n      = utf8_decode_valid(&dst[di], &src[si], valid, k);
+                    utf_reorder<le>(&dst[di], n);
+                    di                 += n;
+                    si                 += valid;
+                    continue;
+                }
+
+                // Decode invalid or incomplete sequence
+                const char *s       = &src[si];
+                size_t nin          = scap - si;
+                const lsp_utf32_t cp= read_utf8_streaming(&s, &nin, force);
+                if (cp == LSP_UTF32_EOF)
+                    break;
+
+                dst[di++]           = utf_order<le>(cp);
+                si                  = scap - nin;
+            }
+
+            *ndst              -= di;
+            *nsrc              -= si;
+
+            return di;
+        }
+
+    template <bool le>
+        static size_t utf8_to_utf16_bulk(lsp_utf16_t *dst, size_t *ndst, const char *src, size_t *nsrc, bool force)
+        {
+            const utf_kernels_t *k  = utf_kernels();
+            const size_t dcap       = *ndst;
+            const size_t scap       = *nsrc;
+            size_t di = 0, si = 0, processed = 0;
+
+            while ((di < dcap) && (si < scap))
+            {
+                // Each valid character produces no more UTF-16 units than it takes bytes,
+                // so the validated block always fits into the output buffer
+                const size_t count  = lsp_min(lsp_min(scap - si, dcap - di), UTF8_BLOCK_SIZE);
+                const size_t valid  = k->utf8_validate(&src[si], count);
+                if (valid > 0)
+                {
+                    size_t chars        = 0;
+                    const size_t n      = utf8_decode_valid(&dst[di], &chars, &src[si], valid, k);
+                    utf_reorder<le>(&dst[di], n);
+                    di                 += n;
+                    si                 += valid;
+                    processed          += chars;
+                    continue;
+                }
+
+                // Decode invalid or incomplete sequence
+                const char *s       = &src[si];
+                size_t nin          = scap - si;
+                const lsp_utf32_t cp= read_utf8_streaming(&s, &nin, force);
+                if (cp == LSP_UTF32_EOF)
+                    break;
+
+                const size_t nout   = count_utf16(cp);
+                if (nout > (dcap - di))
+                    break;
+
+                lsp_utf16_t *d      = &dst[di];
+                utf16_write_codepoint<le>(&d, cp);
+                di                 += nout;
+                si                  = scap - nin;
+                ++processed;
+            }
+
+            *ndst              -= di;
+            *nsrc              -= si;
+
+            return processed;
+        }
+
+    template <bool le>
+        static size_t utf16_to_utf8_bulk(char *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+        {
+            const utf_kernels_t *k  = utf_kernels();
+            const size_t dcap       = *ndst;
+            const size_t scap       = *nsrc;
+            size_t di = 0, si = 0, processed = 0;
+
+            while (si < scap)
+            {
+                const size_t start  = si;
+
+                // Convert the run of ASCII characters
+                if (le == UTF_NATIVE_LE)
+                {
+                    const size_t run    = k->utf16_to_ascii(&dst[di], &src[si], lsp_min(scap - si, dcap - di));
+                    di                 += run;
+                    si                 += run;
+                    processed          += run;
+                }
+
+                // Encode characters until the next ASCII character
+                while (si < scap)
+                {
+                    if ((le == UTF_NATIVE_LE) && (src[si] < 0x80))
+                        break;
+
+                    const lsp_utf16_t *s    = &src[si];
+                    size_t nin              = scap - si;
+                    const lsp_utf32_t cp    = utf16_read_streaming<le>(&s, &nin, force);
+                    if (cp == LSP_UTF32_EOF)
+                        break;
+
+                    const size_t nout       = count_utf8(cp);
+                    if (nout > (dcap - di))
+                        break;
+
+                    char *d                 = &dst[di];
+                    write_utf8_codepoint(&d, cp);
+                    di                     += nout;
+                    si                      = scap - nin;
+                    ++processed;
+                }
+
+                // No progress means that the output buffer is full or more data is required
+                if (si == start)
+                    break;
+            }
+
+            *ndst              -= di;
+            *nsrc              -= si;
+
+            return processed;
+        }
+
+    template <bool sle, bool dle>
+        static size_t utf16_to_utf32_bulk(lsp_utf32_t *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+        {
+            const utf_kernels_t *k  = utf_kernels();
+            const size_t dcap       = *ndst;
+            const size_t scap       = *nsrc;
+            size_t di = 0, si = 0;
+
+            while ((di < dcap) && (si < scap))
+            {
+                const size_t start  = si;
+
+                // Convert the run of characters from Basic Multilingual Plane
+                if (sle == UTF_NATIVE_LE)
+                {
+                    const size_t run    = k->bmp_to_utf32(&dst[di], &src[si], lsp_min(scap - si, dcap - di));
+                    utf_reorder<dle>(&dst[di], run);
+                    di                 += run;
+                    si                 += run;
+                }
+
+                // Decode surrogates and characters following them
+                while ((di < dcap) && (si < scap))
+                {
+                    if ((sle == UTF_NATIVE_LE) && ((src[si] & 0xf800) != 0xd800))
+                        break;
+
+                    const lsp_utf16_t *s    = &src[si];
+                    size_t nin              = scap - si;
+                    const lsp_utf32_t cp    = utf16_read_streaming<sle>(&s, &nin, force);
+                    if (cp == LSP_UTF32_EOF)
+                        break;
+
+                    dst[di++]               = utf_order<dle>(cp);
+                    si                      = scap - nin;
+                }
+
+                // No progress means that more data is required
+                if (si == start)
+                    break;
+            }
+
+            *ndst              -= di;
+            *nsrc              -= si;
+
+            return di;
+        }
+
+    template <bool le>
+        static size_t utf32_to_utf8_bulk(char *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc)
+        {
+            const utf_kernels_t *k  = utf_kernels();
+            const size_t dcap       = *ndst;
+            const size_t scap       = *nsrc;
+            size_t di = 0, si = 0;
+
+            while (si < scap)
+            {
+                const size_t start  = si;
+
+                // Convert the run of ASCII characters
+                if (le == UTF_NATIVE_LE)
+                {
+                    const size_t run    = k->utf32_to_ascii(&dst[di], &src[si], lsp_min(scap - si, dcap - di));
+                    di                 += run;
+                    si                 += run;
+                }
+
+                // Encode characters until the next ASCII character
+                for ( ; si < scap; ++si)
+                {
+                    const lsp_utf32_t cp    = utf_order<le>(src[si]);
+                    if ((le == UTF_NATIVE_LE) && (cp < 0x80))
+                        break;
+
+                    const size_t nout       = count_utf8(cp);
+                    if (nout > (dcap - di))
+                        break;
+
+                    char *d                 = &dst[di];
+                    write_utf8_codepoint(&d, cp);
+                    di                     += nout;
+                }
+
+                // No progress means that the output buffer is full
+                if (si == start)
+                    break;
+            }
+
+            *ndst              -= di;
+            *nsrc              -= si;
+
+            return si;
+        }
+
+    template <bool sle, bool dle>
+        static size_t utf32_to_utf16_bulk(lsp_utf16_t *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc)
+        {
+            const utf_kernels_t *k  = utf_kernels();
+            const size_t dcap       = *ndst;
+            const size_t scap       = *nsrc;
+            size_t di = 0, si = 0;
+
+            while (si < scap)
+            {
+                const size_t start  = si;
+
+                // Convert the run of characters from Basic Multilingual Plane
+                if (sle == UTF_NATIVE_LE)
+                {
+                    const size_t run    = k->utf32_to_bmp(&dst[di], &src[si], lsp_min(scap - si, dcap - di));
+                    utf_reorder<dle>(&dst[di], run);
+                    di                 += run;
+                    si                 += run;
+                }
 
-        return items;
+                // Encode characters outside of Basic Multilingual Plane
+                for ( ; si < scap; ++si)
+                {
+                    const lsp_utf32_t cp    = utf_order<sle>(src[si]);
+                    if ((sle == UTF_NATIVE_LE) && (cp < 0x10000))
+                        break;
+
+                    const size_t nout       = count_utf16(cp);
+                    if (nout > (dcap - di))
+                        break;
+
+                    lsp_utf16_t *d          = &dst[di];
+                    utf16_write_codepoint<dle>(&d, cp);
+                    di                     += nout;
+                }
+
+                // No progress means that the output buffer is full
+                if (si == start)
+                    break;
+            }
+
+            *ndst              -= di;
+            *nsrc              -= si;
+
+            return si;
+        }
+
+    size_t utf8_to_utf16le(lsp_utf16_t *dst, size_t *ndst, const char *src, size_t *nsrc, bool force)
+    {
+        return utf8_to_utf16_bulk<true>(dst, ndst, src, nsrc, force);
     }
 
-    size_t utf16be_to_utf8(char *dst, const lsp_utf16_t *str, size_t count)
+    size_t utf8_to_utf16be(lsp_utf16_t *dst, size_t *ndst, const char *src, size_t *nsrc, bool force)
     {
-        lsp_utf32_t cp;
-        size_t items = 0;
-        do
-        {
-            cp          = read_utf16be_codepoint(&str);
-            items      += count_utf8(cp);
-            if (items > count)
-                return 0;
-            write_utf8_codepoint(&dst, cp);
-        } while (cp != 0);
+        return utf8_to_utf16_bulk<false>(dst, ndst, src, nsrc, force);
+    }
 
-        return items;
+    size_t utf8_to_utf32le(lsp_utf32_t *dst, size_t *ndst, const char *src, size_t *nsrc, bool force)
+    {
+        return utf8_to_utf32_bulk<true>(dst, ndst, src, nsrc, force);
     }
 
-    lsp_utf32_t *utf16le_to_utf32le(const lsp_utf16_t *str)
+    size_t utf8_to_utf32be(lsp_utf32_t *dst, size_t *ndst, const char *src, size_t *nsrc, bool force)
     {
-        // Estimate number of bytes
-        lsp_utf32_t cp;
-        size_t bytes = 0;
-        const lsp_utf16_t *p = str;
-        do
-        {
-            cp          = read_utf16le_codepoint(&p);
-            bytes      += sizeof(lsp_utf32_t);
-        } while (cp != 0);
+        return utf8_to_utf32_bulk<false>(dst, ndst, src, nsrc, force);
+    }
 
-        // Allocate memory
-        lsp_utf32_t *utf32  = reinterpret_cast<lsp_utf32_t *>(::malloc(bytes));
-        if (utf32 == NULL)
-            return NULL;
+    size_t utf16le_to_utf8(char *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+    {
+        return utf16_to_utf8_bulk<true>(dst, ndst, src, nsrc, force);
+    }
 
-        // Perform encoding
-        p               = str;
-        lsp_utf32_t *dst= utf32;
-        while ((cp = read_utf16le_codepoint(&p)) != 0)
-            *(dst++)        = CPU_TO_LE(cp);
-        *dst            = 0;
+    size_t utf16be_to_utf8(char *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+    {
+        return utf16_to_utf8_bulk<false>(dst, ndst, src, nsrc, force);
+    }
 
-        return utf32;
+    size_t utf16le_to_utf32le(lsp_utf32_t *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+    {
+        return utf16_to_utf32_bulk<true, true>(dst, ndst, src, nsrc, force);
     }
 
-    lsp_utf32_t *utf16le_to_utf32be(const lsp_utf16_t *str)
+    size_t utf16be_to_utf32le(lsp_utf32_t *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
     {
-        // Estimate number of bytes
-        lsp_utf32_t cp;
-        size_t bytes = 0;
-        const lsp_utf16_t *p = str;
-        do
-        {
-            cp          = read_utf16le_codepoint(&p);
-            bytes      += sizeof(lsp_utf32_t);
-        } while (cp != 0);
+        return utf16_to_utf32_bulk<false, true>(dst, ndst, src, nsrc, force);
+    }
 
-        // Allocate memory
-        lsp_utf32_t *utf32  = reinterpret_cast<lsp_utf32_t *>(::malloc(bytes));
-        if (utf32 == NULL)
-            return NULL;
+    size_t utf16le_to_utf32be(lsp_utf32_t *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+    {
+        return utf16_to_utf32_bulk<true, false>(dst, ndst, src, nsrc, force);
+    }
 
-        // Perform encoding
-        p               = str;
-        lsp_utf32_t *dst= utf32;
-        while ((cp = read_utf16le_codepoint(&p)) != 0)
-            *(dst++)        = CPU_TO_BE(cp);
-        *dst            = 0;
+    size_t utf16be_to_utf32be(lsp_utf32_t *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+    {
+        return utf16_to_utf32_bulk<false, false>(dst, ndst, src, nsrc, force);
+    }
 
-        return utf32;
+    size_t utf32le_to_utf8(char *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
+    {
+        return utf32_to_utf8_bulk<true>(dst, ndst, src, nsrc);
     }
 
-    lsp_utf32_t *utf16be_to_utf32le(const lsp_utf16_t *str)
+    size_t utf32be_to_utf8(char *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
     {
-        // Estimate number of bytes
-        lsp_utf32_t cp;
-        size_t bytes = 0;
-        const lsp_utf16_t *p = str;
-        do
-        {
-            cp          = read_utf16be_codepoint(&p);
-            bytes      += sizeof(lsp_utf32_t);
-        } while (cp != 0);
+        return utf32_to_utf8_bulk<false>(dst, ndst, src, nsrc);
+    }
 
-        // Allocate memory
-        lsp_utf32_t *utf32  = reinterpret_cast<lsp_utf32_t *>(::malloc(bytes));
-        if (utf32 == NULL)
-            return NULL;
+    size_t utf32le_to_utf16le(lsp_utf16_t *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
+    {
+        return utf32_to_utf16_bulk<true, true>(dst, ndst, src, nsrc);
+    }
 
-        // Perform encoding
-        p               = str;
-        lsp_utf32_t *dst= utf32;
-        while ((cp = read_utf16be_codepoint(&p)) != 0)
-            *(dst++)        = CPU_TO_LE(cp);
-        *dst            = 0;
+    size_t utf32le_to_utf16be(lsp_utf16_t *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
+    {
+        return utf32_to_utf16_bulk<true, false>(dst, ndst, src, nsrc);
+    }
 
-        return utf32;
+    size_t utf32be_to_utf16le(lsp_utf16_t *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
+    {
+        return utf32_to_utf16_bulk<false, true>(dst, ndst, src, nsrc);
     }
 
-    lsp_utf32_t *utf16be_to_utf32be(const lsp_utf16_t *str)
+    size_t utf32be_to_utf16be(lsp_utf16_t *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
     {
-        // Estimate number of bytes
-        lsp_utf32_t cp;
-        size_t bytes = 0;
-        const lsp_utf16_t *p = str;
-        do
+        return utf32_to_utf16_bulk<false, false>(dst, ndst, src, nsrc);
+    }
+
+    template <class T>
+        static size_t utf_strlen(const T *str)
         {
-            cp          = read_utf16be_codepoint(&p);
-            bytes      += sizeof(lsp_utf32_t);
-        } while (cp != 0);
+            const T *p = str;
+            while (*p != 0)
+                ++p;
+            return p - str;
+        }
 
-        // Allocate memory
-        lsp_utf32_t *utf32  = reinterpret_cast<lsp_utf32_t *>(::malloc(bytes));
-        if (utf32 == NULL)
-            return NULL;
+    /**
+     * Convert NULL-terminated string in one pass using the streaming routine
+     * @param str source string
+     * @param factor maximum number of destination units produced by one source unit
+     * @param convert streaming conversion routine
+     * @return pointer to the allocated NULL-terminated string or NULL on error
+     */
+    template <class D, class S>
+        static D *utf_convert_string(const S *str, size_t factor, size_t (*convert)(D *, size_t *, const S *, size_t *, bool))
+        {
+            const size_t len    = utf_strlen(str);
+            const size_t cap    = len * factor;
+            D *res              = static_cast<D *>(::malloc((cap + 1) * sizeof(D)));
+            if (res == NULL)
+                return NULL;
 
-        // Perform encoding
-        p               = str;
-        lsp_utf32_t *dst= utf32;
-        while ((cp = read_utf16be_codepoint(&p)) != 0)
-            *(dst++)        = CPU_TO_BE(cp);
-        *dst            = 0;
+            size_t ndst         = cap;
+            size_t nsrc         = len;
+            convert(res, &ndst, str, &nsrc, true);
+            const size_t count  = cap - ndst;
+            res[count]          = 0;
 
-        return utf32;
-    }
+            // Release unused memory if it takes too much space
+            if (count < (cap >> 1))
+            {
+                D *tmp              = static_cast<D *>(::realloc(res, (count + 1) * sizeof(D)));
+                if (tmp != NULL)
+                    res                 = tmp;
+            }
 
-    size_t utf16le_to_utf32le(lsp_utf32_t *dst, const lsp_utf16_t *str, size_t count)
+            return res;
+        }
+
+    //-------------------------------------------------------------------------
+    // UTF-8 non-streaming routines
+    lsp_utf16_t *utf8_to_utf16le(const char *str)
     {
-        lsp_utf32_t cp;
-        size_t items = 0;
-        do
-        {
-            cp          = read_utf16le_codepoint(&str);
-            if (++items > count)
-                return 0;
-            *(dst++)    = CPU_TO_LE(cp);
-        } while (cp != 0);
+        return utf_convert_string<lsp_utf16_t>(str, 1, utf8_to_utf16le);
+    }
 
-        return items;
+    lsp_utf16_t *utf8_to_utf16be(const char *str)
+    {
+        return utf_convert_string<lsp_utf16_t>(str, 1, utf8_to_utf16be);
     }
 
-    size_t utf16le_to_utf32be(lsp_utf32_t *dst, const lsp_utf16_t *str, size_t count)
+    size_t utf8_to_utf16le(lsp_utf16_t *dst, const char *str, size_t count)
     {
         lsp_utf32_t cp;
-        size_t items = 0;
+        size_t items    = 0;
         do
         {
-            cp          = read_utf16le_codepoint(&str);
-            if (++items > count)
+            cp      = read_utf8_codepoint(&str);
+            items  += count_utf16(cp);
+            if (items > count)
                 return 0;
-            *(dst++)    = CPU_TO_BE(cp);
+
+            write_utf16le_codepoint(&dst, cp);
         } while (cp != 0);
 
         return items;
     }
 
-    size_t utf16be_to_utf32le(lsp_utf32_t *dst, const lsp_utf16_t *str, size_t count)
+    size_t utf8_to_utf16be(lsp_utf16_t *dst, const char *str, size_t count)
     {
         lsp_utf32_t cp;
-        size_t items = 0;
+        size_t items    = 0;
         do
         {
-            cp          = read_utf16be_codepoint(&str);
-            if (++items > count)
+            cp      = read_utf8_codepoint(&str);
+            items  += count_utf16(cp);
+            if (items > count)
                 return 0;
-            *(dst++)    = CPU_TO_LE(cp);
+
+            write_utf16be_codepoint(&dst, cp);
         } while (cp != 0);
 
         return items;
     }
 
-    size_t utf16be_to_utf32be(lsp_utf32_t *dst, const lsp_utf16_t *str, size_t count)
+    lsp_utf32_t *utf8_to_utf32le(const char *str)
     {
-        lsp_utf32_t cp;
-        size_t items = 0;
-        do
-        {
-            cp          = read_utf16be_codepoint(&str);
-            if (++items > count)
-                return 0;
-            *(dst++)    = CPU_TO_BE(cp);
-        } while (cp != 0);
+        return utf_convert_string<lsp_utf32_t>(str, 1, utf8_to_utf32le);
+    }
 
-        return items;
+    lsp_utf32_t *utf8_to_utf32be(const char *str)
+    {
+        return utf_convert_string<lsp_utf32_t>(str, 1, utf8_to_utf32be);
     }
 
-    //-------------------------------------------------------------------------
-    // UTF-32 non-streaming routines
-    char *utf32le_to_utf8(const lsp_utf32_t *str)
+    size_t utf8_to_utf32le(lsp_utf32_t *dst, const char *str, size_t count)
     {
         lsp_utf32_t cp;
-        size_t bytes = 0;
-        const lsp_utf32_t *p = str;
-
-        // Estimate length
+        size_t items    = 0;
         do
         {
-            cp          = LE_TO_CPU(*(p++));
-            bytes      += sizeof_utf8(cp);
+            cp      = read_utf8_codepoint(&str);
+            if (++items > count)
+                return 0;
+            *(dst++)        = CPU_TO_LE(cp);
         } while (cp != 0);
 
-        // Allocate memory
-        char *utf8      = reinterpret_cast<char *>(::malloc(bytes));
-        if (utf8 == NULL)
-            return NULL;
-
-        // Perform encoding
-        p               = str;
-        char *dst       = utf8;
-        while ((cp = *(p++)) != 0)
-            write_utf8_codepoint(&dst, cp);
-
-        *dst = 0;
-        return utf8;
+        return items;
     }
 
-    char *utf32be_to_utf8(const lsp_utf32_t *str)
+    size_t utf8_to_utf32be(lsp_utf32_t *dst, const char *str, size_t count)
     {
         lsp_utf32_t cp;
-        size_t bytes = 0;
-        const lsp_utf32_t *p = str;
-
-        // Estimate length
+        size_t items    = 0;
         do
         {
-            cp          = BE_TO_CPU(*(p++));
-            bytes      += sizeof_utf8(cp);
+            cp      = read_utf8_codepoint(&str);
+            if (++items > count)
+                return 0;
+            *(dst++)        = CPU_TO_BE(cp);
         } while (cp != 0);
 
-        // Allocate memory
-        char *utf8      = reinterpret_cast<char *>(::malloc(bytes));
-        if (utf8 == NULL)
-            return NULL;
-
-        // Perform encoding
-        p               = str;
-        char *dst       = utf8;
-        while ((cp = *(p++)) != 0)
-            write_utf8_codepoint(&dst, cp);
+        return items;
+    }
 
-        *dst = 0;
-        return utf8;
+    //-------------------------------------------------------------------------
+    // UTF-16 non-streaming routines
+    char *utf16le_to_utf8(const lsp_utf16_t *str)
+    {
+        return utf_convert_string<char>(str, 3, utf16le_to_utf8);
     }
 
-    size_t utf32le_to_utf8(char *dst, const lsp_utf32_t *src, size_t count)
+    char *utf16be_to_utf8(const lsp_utf16_t *str)
+    {
+        return utf_convert_string<char>(str, 3, utf16be_to_utf8);
+    }
+
+    size_t utf16le_to_utf8(char *dst, const lsp_utf16_t *str, size_t count)
     {
         lsp_utf32_t cp;
         size_t items = 0;
         do
         {
-            cp          = LE_TO_CPU(*(src++));
+            cp          = read_utf16le_codepoint(&str);
             items      += count_utf8(cp);
             if (items > count)
                 return 0;
@@ -1521,13 +2528,13 @@ namespace lsp
         return items;
     }
 
-    size_t utf32be_to_utf8(char *dst, const lsp_utf32_t *src, size_t count)
+    size_t utf16be_to_utf8(char *dst, const lsp_utf16_t *str, size_t count)
     {
         lsp_utf32_t cp;
         size_t items = 0;
         do
         {
-            cp          = BE_TO_CPU(*(src++));
+            cp          = read_utf16be_codepoint(&str);
             items      += count_utf8(cp);
             if (items > count)
                 return 0;
@@ -1537,618 +2544,400 @@ namespace lsp
         return items;
     }
 
-    lsp_utf16_t *utf32le_to_utf16le(const lsp_utf32_t *str)
+    lsp_utf32_t *utf16le_to_utf32le(const lsp_utf16_t *str)
     {
+        // Estimate number of bytes
         lsp_utf32_t cp;
         size_t bytes = 0;
-        const lsp_utf32_t *p = str;
-
-        // Estimate length
+        const lsp_utf16_t *p = str;
         do
         {
-            cp          = LE_TO_CPU(*(p++));
-            bytes      += sizeof_utf16(cp);
+            cp          = read_utf16le_codepoint(&p);
+            bytes      += sizeof(lsp_utf32_t);
         } while (cp != 0);
 
         // Allocate memory
-        lsp_utf16_t *utf16  = reinterpret_cast<lsp_utf16_t *>(::malloc(bytes));
-        if (utf16 == NULL)
+        lsp_utf32_t *utf32  = reinterpret_cast<lsp_utf32_t *>(::malloc(bytes));
+        if (utf32 == NULL)
             return NULL;
 
         // Perform encoding
         p               = str;
-        lsp_utf16_t *dst= utf16;
-        while ((cp = *(p++)) != 0)
-            write_utf16le_codepoint(&dst, cp);
+        lsp_utf32_t *dst= utf32;
+        while ((cp = read_utf16le_codepoint(&p)) != 0)
+            *(dst++)        = CPU_TO_LE(cp);
+        *dst            = 0;
 
-        *dst = 0;
-        return utf16;
+        return utf32;
     }
 
-    lsp_utf16_t *utf32le_to_utf16be(const lsp_utf32_t *str)
+    lsp_utf32_t *utf16le_to_utf32be(const lsp_utf16_t *str)
     {
+        // Estimate number of bytes
         lsp_utf32_t cp;
         size_t bytes = 0;
-        const lsp_utf32_t *p = str;
-
-        // Estimate length
+        const lsp_utf16_t *p = str;
         do
         {
-            cp          = LE_TO_CPU(*(p++));
-            bytes      += sizeof_utf16(cp);
+            cp          = read_utf16le_codepoint(&p);
+            bytes      += sizeof(lsp_utf32_t);
         } while (cp != 0);
 
         // Allocate memory
-        lsp_utf16_t *utf16  = reinterpret_cast<lsp_utf16_t *>(::malloc(bytes));
-        if (utf16 == NULL)
+        lsp_utf32_t *utf32  = reinterpret_cast<lsp_utf32_t *>(::malloc(bytes));
+        if (utf32 == NULL)
             return NULL;
 
         // Perform encoding
         p               = str;
-        lsp_utf16_t *dst= utf16;
-        while ((cp = *(p++)) != 0)
-            write_utf16be_codepoint(&dst, cp);
+        lsp_utf32_t *dst= utf32;
+        while ((cp = read_utf16le_codepoint(&p)) != 0)
+            *(dst++)        = CPU_TO_BE(cp);
+        *dst            = 0;
 
-        *dst = 0;
-        return utf16;
+        return utf32;
     }
 
-    lsp_utf16_t *utf32be_to_utf16le(const lsp_utf32_t *str)
+    lsp_utf32_t *utf16be_to_utf32le(const lsp_utf16_t *str)
     {
+        // Estimate number of bytes
         lsp_utf32_t cp;
         size_t bytes = 0;
-        const lsp_utf32_t *p = str;
-
-        // Estimate length
+        const lsp_utf16_t *p = str;
         do
         {
-            cp          = BE_TO_CPU(*(p++));
-            bytes      += sizeof_utf16(cp);
+            cp          = read_utf16be_codepoint(&p);
+            bytes      += sizeof(lsp_utf32_t);
         } while (cp != 0);
 
         // Allocate memory
-        lsp_utf16_t *utf16  = reinterpret_cast<lsp_utf16_t *>(::malloc(bytes));
-        if (utf16 == NULL)
+        lsp_utf32_t *utf32  = reinterpret_cast<lsp_utf32_t *>(::malloc(bytes));
+        if (utf32 == NULL)
             return NULL;
 
         // Perform encoding
         p               = str;
-        lsp_utf16_t *dst= utf16;
-        while ((cp = *(p++)) != 0)
-            write_utf16le_codepoint(&dst, cp);
+        lsp_utf32_t *dst= utf32;
+        while ((cp = read_utf16be_codepoint(&p)) != 0)
+            *(dst++)        = CPU_TO_LE(cp);
+        *dst            = 0;
 
-        *dst = 0;
-        return utf16;
+        return utf32;
     }
 
-    lsp_utf16_t *utf32be_to_utf16be(const lsp_utf32_t *str)
+    lsp_utf32_t *utf16be_to_utf32be(const lsp_utf16_t *str)
     {
+        // Estimate number of bytes
         lsp_utf32_t cp;
         size_t bytes = 0;
-        const lsp_utf32_t *p = str;
-
-        // Estimate length
+        const lsp_utf16_t *p = str;
         do
         {
-            cp          = BE_TO_CPU(*(p++));
-            bytes      += sizeof_utf16(cp);
+            cp          = read_utf16be_codepoint(&p);
+            bytes      += sizeof(lsp_utf32_t);
         } while (cp != 0);
 
         // Allocate memory
-        lsp_utf16_t *utf16  = reinterpret_cast<lsp_utf16_t *>(::malloc(bytes));
-        if (utf16 == NULL)
+        lsp_utf32_t *utf32  = reinterpret_cast<lsp_utf32_t *>(::malloc(bytes));
+        if (utf32 == NULL)
             return NULL;
 
         // Perform encoding
         p               = str;
-        lsp_utf16_t *dst= utf16;
-        while ((cp = *(p++)) != 0)
-            write_utf16be_codepoint(&dst, cp);
+        lsp_utf32_t *dst= utf32;
+        while ((cp = read_utf16be_codepoint(&p)) != 0)
+            *(dst++)        = CPU_TO_BE(cp);
+        *dst            = 0;
 
-        *dst = 0;
-        return utf16;
+        return utf32;
     }
 
-    size_t utf32le_to_utf16le(lsp_utf16_t *dst, const lsp_utf32_t *str, size_t count)
+    size_t utf16le_to_utf32le(lsp_utf32_t *dst, const lsp_utf16_t *str, size_t count)
     {
         lsp_utf32_t cp;
         size_t items = 0;
-
-        // Estimate length
         do
         {
-            cp          = LE_TO_CPU(*(str++));
-            items      += count_utf16(cp);
-            if (items > count)
+            cp          = read_utf16le_codepoint(&str);
+            if (++items > count)
                 return 0;
-            write_utf16le_codepoint(&dst, cp);
+            *(dst++)    = CPU_TO_LE(cp);
         } while (cp != 0);
 
         return items;
     }
 
-    size_t utf32le_to_utf16be(lsp_utf16_t *dst, const lsp_utf32_t *str, size_t count)
+    size_t utf16le_to_utf32be(lsp_utf32_t *dst, const lsp_utf16_t *str, size_t count)
     {
         lsp_utf32_t cp;
         size_t items = 0;
-
-        // Estimate length
         do
         {
-            cp          = LE_TO_CPU(*(str++));
-            items      += count_utf16(cp);
-            if (items > count)
+            cp          = read_utf16le_codepoint(&str);
+            if (++items > count)
                 return 0;
-            write_utf16be_codepoint(&dst, cp);
+            *(dst++)    = CPU_TO_BE(cp);
         } while (cp != 0);
 
         return items;
     }
 
-    size_t utf32be_to_utf16le(lsp_utf16_t *dst, const lsp_utf32_t *str, size_t count)
+    size_t utf16be_to_utf32le(lsp_utf32_t *dst, const lsp_utf16_t *str, size_t count)
     {
         lsp_utf32_t cp;
         size_t items = 0;
-
-        // Estimate length
         do
         {
-            cp          = BE_TO_CPU(*(str++));
-            items      += count_utf16(cp);
-            if (items > count)
+            cp          = read_utf16be_codepoint(&str);
+            if (++items > count)
                 return 0;
-            write_utf16le_codepoint(&dst, cp);
+            *(dst++)    = CPU_TO_LE(cp);
         } while (cp != 0);
 
         return items;
     }
 
-    size_t utf32be_to_utf16be(lsp_utf16_t *dst, const lsp_utf32_t *str, size_t count)
+    size_t utf16be_to_utf32be(lsp_utf32_t *dst, const lsp_utf16_t *str, size_t count)
     {
         lsp_utf32_t cp;
         size_t items = 0;
-
-        // Estimate length
         do
         {
-            cp          = BE_TO_CPU(*(str++));
-            items      += count_utf16(cp);
-            if (items > count)
+            cp          = read_utf16be_codepoint(&str);
+            if (++items > count)
                 return 0;
-            write_utf16be_codepoint(&dst, cp);
+            *(dst++)    = CPU_TO_BE(cp);
         } while (cp != 0);
 
         return items;
     }
 
     //-------------------------------------------------------------------------
-    // UTF-8 streaming routines
-    size_t utf8_to_utf16le(lsp_utf16_t *dst, size_t *ndst, const char *src, size_t *nsrc, bool force)
-    {
-        lsp_utf32_t cp;
-        size_t processed = 0;
-
-        while (*ndst > 0)
-        {
-            // Read code point
-            size_t nin  = *nsrc;
-            cp          = read_utf8_streaming(&src, &nin, force);
-            if (cp == LSP_UTF32_EOF) // No data ?
-                break;
-
-            // Encode code point
-            size_t nout = count_utf16(cp);
-            if (nout > *ndst)
-                break;
-            write_utf16le_codepoint(&dst, cp);
-            *nsrc       = nin;
-            *ndst      -= nout;
-
-            // Update statistics
-            ++processed;
-        }
-
-        return processed;
-    }
-
-    size_t utf8_to_utf16be(lsp_utf16_t *dst, size_t *ndst, const char *src, size_t *nsrc, bool force)
-    {
-        lsp_utf32_t cp;
-        size_t processed = 0;
-
-        while (*ndst > 0)
-        {
-            // Read code point
-            size_t nin  = *nsrc;
-            cp          = read_utf8_streaming(&src, &nin, force);
-            if (cp == LSP_UTF32_EOF) // No data ?
-                break;
-
-            // Encode code point
-            size_t nout = count_utf16(cp);
-            if (nout > *ndst)
-                break;
-            write_utf16be_codepoint(&dst, cp);
-            *nsrc       = nin;
-            *ndst      -= nout;
-
-            // Update statistics
-            ++processed;
-        }
-
-        return processed;
-    }
-
-    size_t utf8_to_utf32le(lsp_utf32_t *dst, size_t *ndst, const char *src, size_t *nsrc, bool force)
-    {
-        lsp_utf32_t cp;
-        size_t processed = 0;
-
-        while (*ndst > 0)
-        {
-            // Read code point
-            size_t nin  = *nsrc;
-            cp          = read_utf8_streaming(&src, &nin, force);
-            if (cp == LSP_UTF32_EOF) // No data ?
-                break;
-
-            // Encode code point
-            *(dst++)    = CPU_TO_LE(cp);
-            *nsrc       = nin;
-            --(*ndst);
-
-            // Update statistics
-            ++processed;
-        }
-
-        return processed;
-    }
-
-    size_t utf8_to_utf32be(lsp_utf32_t *dst, size_t *ndst, const char *src, size_t *nsrc, bool force)
-    {
-        lsp_utf32_t cp;
-        size_t processed = 0;
-
-        while (*ndst > 0)
-        {
-            // Read code point
-            size_t nin  = *nsrc;
-            cp          = read_utf8_streaming(&src, &nin, force);
-            if (cp == LSP_UTF32_EOF) // No data ?
-                break;
-
-            // Encode code point
-            *(dst++)    = CPU_TO_BE(cp);
-            *nsrc       = nin;
-            --(*ndst);
-
-            // Update statistics
-            ++processed;
-        }
-
-        return processed;
-    }
-
-    //-------------------------------------------------------------------------
-    // UTF-16 streaming routines
-    size_t utf16le_to_utf8(char *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
-    {
-        lsp_utf32_t cp;
-        size_t processed = 0;
-
-        while (*ndst > 0)
-        {
-            // Read code point
-            size_t nin  = *nsrc;
-            cp          = read_utf16le_streaming(&src, &nin, force);
-            if (cp == LSP_UTF32_EOF) // No data ?
-                break;
-
-            // Encode code point
-            size_t nout = count_utf8(cp);
-            if (nout > *ndst)
-                break;
-            write_utf8_codepoint(&dst, cp);
-            *nsrc       = nin;
-            *ndst      -= nout;
-
-            // Update statistics
-            ++processed;
-        }
-
-        return processed;
-    }
-
-    size_t utf16be_to_utf8(char *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
-    {
-        lsp_utf32_t cp;
-        size_t processed = 0;
-
-        while (*ndst > 0)
-        {
-            // Read code point
-            size_t nin  = *nsrc;
-            cp          = read_utf16be_streaming(&src, &nin, force);
-            if (cp == LSP_UTF32_EOF) // No data ?
-                break;
-
-            // Encode code point
-            size_t nout = count_utf8(cp);
-            if (nout > *ndst)
-                break;
-            write_utf8_codepoint(&dst, cp);
-            *nsrc       = nin;
-            *ndst      -= nout;
-
-            // Update statistics
-            ++processed;
-        }
+    // UTF-32 non-streaming routines
+    char *utf32le_to_utf8(const lsp_utf32_t *str)
+    {
+        return utf_convert_string<char>(str, 4, utf32le_to_utf8);
+    }
 
-        return processed;
+    char *utf32be_to_utf8(const lsp_utf32_t *str)
+    {
+        return utf_convert_string<char>(str, 4, utf32be_to_utf8);
     }
 
-    size_t utf16le_to_utf32le(lsp_utf32_t *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+    size_t utf32le_to_utf8(char *dst, const lsp_utf32_t *src, size_t count)
     {
         lsp_utf32_t cp;
-        size_t processed = 0;
-
-        while (*ndst > 0)
+        size_t items = 0;
+        do
         {
-            // Read code point
-            size_t nin  = *nsrc;
-            cp          = read_utf16le_streaming(&src, &nin, force);
-            if (cp == LSP_UTF32_EOF) // No data ?
-                break;
-
-            // Encode code point
-            *(dst++)    = CPU_TO_LE(cp);
-            *nsrc       = nin;
-            --(*ndst);
-
-            // Update statistics
-            ++processed;
-        }
+            cp          = LE_TO_CPU(*(src++));
+            items      += count_utf8(cp);
+            if (items > count)
+                return 0;
+            write_utf8_codepoint(&dst, cp);
+        } while (cp != 0);
 
-        return processed;
+        return items;
     }
 
-    size_t utf16be_to_utf32le(lsp_utf32_t *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+    size_t utf32be_to_utf8(char *dst, const lsp_utf32_t *src, size_t count)
     {
         lsp_utf32_t cp;
-        size_t processed = 0;
-
-        while (*ndst > 0)
+        size_t items = 0;
+        do
         {
-            // Read code point
-            size_t nin  = *nsrc;
-            cp          = read_utf16be_streaming(&src, &nin, force);
-            if (cp == LSP_UTF32_EOF) // No data ?
-                break;
-
-            // Encode code point
-            *(dst++)    = CPU_TO_LE(cp);
-            *nsrc       = nin;
-            --(*ndst);
-
-            // Update statistics
-            ++processed;
-        }
+            cp          = BE_TO_CPU(*(src++));
+            items      += count_utf8(cp);
+            if (items > count)
+                return 0;
+            write_utf8_codepoint(&dst, cp);
+        } while (cp != 0);
 
-        return processed;
+        return items;
     }
 
-    size_t utf16le_to_utf32be(lsp_utf32_t *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+    lsp_utf16_t *utf32le_to_utf16le(const lsp_utf32_t *str)
     {
         lsp_utf32_t cp;
-        size_t processed = 0;
+        size_t bytes = 0;
+        const lsp_utf32_t *p = str;
 
-        while (*ndst > 0)
+        // Estimate length
+        do
         {
-            // Read code point
-            size_t nin  = *nsrc;
-            cp          = read_utf16le_streaming(&src, &nin, force);
-            if (cp == LSP_UTF32_EOF) // No data ?
-                break;
+            cp          = LE_TO_CPU(*(p++));
+            bytes      += sizeof_utf16(cp);
+        } while (cp != 0);
 
-            // Encode code point
-            *(dst++)    = CPU_TO_BE(cp);
-            *nsrc       = nin;
-            --(*ndst);
+        // Allocate memory
+        lsp_utf16_t *utf16  = reinterpret_cast<lsp_utf16_t *>(::malloc(bytes));
+        if (utf16 == NULL)
+            return NULL;
 
-            // Update statistics
-            ++processed;
-        }
+        // Perform encoding
+        p               = str;
+        lsp_utf16_t *dst= utf16;
+        while ((cp = *(p++)) != 0)
+            write_utf16le_codepoint(&dst, cp);
 
-        return processed;
+        *dst = 0;
+        return utf16;
     }
 
-    size_t utf16be_to_utf32be(lsp_utf32_t *dst, size_t *ndst, const lsp_utf16_t *src, size_t *nsrc, bool force)
+    lsp_utf16_t *utf32le_to_utf16be(const lsp_utf32_t *str)
     {
         lsp_utf32_t cp;
-        size_t processed = 0;
+        size_t bytes = 0;
+        const lsp_utf32_t *p = str;
 
-        while (*ndst > 0)
+        // Estimate length
+        do
         {
-            // Read code point
-            size_t nin  = *nsrc;
-            cp          = read_utf16be_streaming(&src, &nin, force);
-            if (cp == LSP_UTF32_EOF) // No data ?
-                break;
+            cp          = LE_TO_CPU(*(p++));
+            bytes      += sizeof_utf16(cp);
+        } while (cp != 0);
 
-            // Encode code point
-            *(dst++)    = CPU_TO_BE(cp);
-            *nsrc       = nin;
-            --(*ndst);
+        // Allocate memory
+        lsp_utf16_t *utf16  = reinterpret_cast<lsp_utf16_t *>(::malloc(bytes));
+        if (utf16 == NULL)
+            return NULL;
 
-            // Update statistics
-            ++processed;
-        }
+        // Perform encoding
+        p               = str;
+        lsp_utf16_t *dst= utf16;
+        while ((cp = *(p++)) != 0)
+            write_utf16be_codepoint(&dst, cp);
 
-        return processed;
+        *dst = 0;
+        return utf16;
     }
 
-    //-------------------------------------------------------------------------
-    // UTF-32 streaming routines
-    size_t utf32le_to_utf8(char *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
+    lsp_utf16_t *utf32be_to_utf16le(const lsp_utf32_t *str)
     {
         lsp_utf32_t cp;
-        size_t processed = 0;
+        size_t bytes = 0;
+        const lsp_utf32_t *p = str;
 
-        while (*ndst > 0)
+        // Estimate length
+        do
         {
-            // Read code point
-            if (*nsrc <= 0)
-                break;
-            cp          = LE_TO_CPU(*(src++));
+            cp          = BE_TO_CPU(*(p++));
+            bytes      += sizeof_utf16(cp);
+        } while (cp != 0);
 
-            // Encode code point
-            size_t nout = count_utf8(cp);
-            if (nout > *ndst)
-                break;
-            write_utf8_codepoint(&dst, cp);
-            --(*nsrc);
-            *ndst      -= nout;
+        // Allocate memory
+        lsp_utf16_t *utf16  = reinterpret_cast<lsp_utf16_t *>(::malloc(bytes));
+        if (utf16 == NULL)
+            return NULL;
 
-            // Update statistics
-            ++processed;
-        }
+        // Perform encoding
+        p               = str;
+        lsp_utf16_t *dst= utf16;
+        while ((cp = *(p++)) != 0)
+            write_utf16le_codepoint(&dst, cp);
 
-        return processed;
+        *dst = 0;
+        return utf16;
     }
 
-    size_t utf32be_to_utf8(char *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
+    lsp_utf16_t *utf32be_to_utf16be(const lsp_utf32_t *str)
     {
         lsp_utf32_t cp;
-        size_t processed = 0;
+        size_t bytes = 0;
+        const lsp_utf32_t *p = str;
 
-        while (*ndst > 0)
+        // Estimate length
+        do
         {
-            // Read code point
-            if (*nsrc <= 0)
-                break;
-            cp          = BE_TO_CPU(*(src++));
+            cp          = BE_TO_CPU(*(p++));
+            bytes      += sizeof_utf16(cp);
+        } while (cp != 0);
 
-            // Encode code point
-            size_t nout = count_utf8(cp);
-            if (nout > *ndst)
-                break;
-            write_utf8_codepoint(&dst, cp);
-            --(*nsrc);
-            *ndst      -= nout;
+        // Allocate memory
+        lsp_utf16_t *utf16  = reinterpret_cast<lsp_utf16_t *>(::malloc(bytes));
+        if (utf16 == NULL)
+            return NULL;
 
-            // Update statistics
-            ++processed;
-        }
+        // Perform encoding
+        p               = str;
+        lsp_utf16_t *dst= utf16;
+        while ((cp = *(p++)) != 0)
+            write_utf16be_codepoint(&dst, cp);
 
-        return processed;
+        *dst = 0;
+        return utf16;
     }
 
-    size_t utf32le_to_utf16le(lsp_utf16_t *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
+    size_t utf32le_to_utf16le(lsp_utf16_t *dst, const lsp_utf32_t *str, size_t count)
     {
         lsp_utf32_t cp;
-        size_t processed = 0;
+        size_t items = 0;
 
-        while (*ndst > 0)
+        // Estimate length
+        do
         {
-            // Read code point
-            if (*nsrc <= 0)
-                break;
-            cp          = LE_TO_CPU(*(src++));
-
-            // Encode code point
-            size_t nout = count_utf16(cp);
-            if (nout > *ndst)
-                break;
+            cp          = LE_TO_CPU(*(str++));
+            items      += count_utf16(cp);
+            if (items > count)
+                return 0;
             write_utf16le_codepoint(&dst, cp);
-            --(*nsrc);
-            *ndst      -= nout;
-
-            // Update statistics
-            ++processed;
-        }
+        } while (cp != 0);
 
-        return processed;
+        return items;
     }
 
-    size_t utf32le_to_utf16be(lsp_utf16_t *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
+    size_t utf32le_to_utf16be(lsp_utf16_t *dst, const lsp_utf32_t *str, size_t count)
     {
         lsp_utf32_t cp;
-        size_t processed = 0;
+        size_t items = 0;
 
-        while (*ndst > 0)
+        // Estimate length
+        do
         {
-            // Read code point
-            if (*nsrc <= 0)
-                break;
-            cp          = LE_TO_CPU(*(src++));
-
-            // Encode code point
-            size_t nout = count_utf16(cp);
-            if (nout > *ndst)
-                break;
+            cp          = LE_TO_CPU(*(str++));
+            items      += count_utf16(cp);
+            if (items > count)
+                return 0;
             write_utf16be_codepoint(&dst, cp);
-            --(*nsrc);
-            *ndst      -= nout;
-
-            // Update statistics
-            ++processed;
-        }
+        } while (cp != 0);
 
-        return processed;
+        return items;
     }
 
-    size_t utf32be_to_utf16le(lsp_utf16_t *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
+    size_t utf32be_to_utf16le(lsp_utf16_t *dst, const lsp_utf32_t *str, size_t count)
     {
         lsp_utf32_t cp;
-        size_t processed = 0;
+        size_t items = 0;
 
-        while (*ndst > 0)
+        // Estimate length
+        do
         {
-            // Read code point
-            if (*nsrc <= 0)
-                break;
-            cp          = BE_TO_CPU(*(src++));
-
-            // Encode code point
-            size_t nout = count_utf16(cp);
-            if (nout > *ndst)
-                break;
+            cp          = BE_TO_CPU(*(str++));
+            items      += count_utf16(cp);
+            if (items > count)
+                return 0;
             write_utf16le_codepoint(&dst, cp);
-            --(*nsrc);
-            *ndst      -= nout;
-
-            // Update statistics
-            ++processed;
-        }
+        } while (cp != 0);
 
-        return processed;
+        return items;
     }
 
-    size_t utf32be_to_utf16be(lsp_utf16_t *dst, size_t *ndst, const lsp_utf32_t *src, size_t *nsrc, bool force)
+    size_t utf32be_to_utf16be(lsp_utf16_t *dst, const lsp_utf32_t *str, size_t count)
     {
         lsp_utf32_t cp;
-        size_t processed = 0;
+        size_t items = 0;
 
-        while (*ndst > 0)
+        // Estimate length
+        do
         {
-            // Read code point
-            if (*nsrc <= 0)
-                break;
-            cp          = BE_TO_CPU(*(src++));
-
-            // Encode code point
-            size_t nout = count_utf16(cp);
-            if (nout > *ndst)
-                break;
+            cp          = BE_TO_CPU(*(str++));
+            items      += count_utf16(cp);
+            if (items > count)
+                return 0;
             write_utf16be_codepoint(&dst, cp);
-            --(*nsrc);
-            *ndst      -= nout;
-
-            // Update statistics
-            ++processed;
-        }
+        } while (cp != 0);
 
-        return processed;
+        return items;
     }
 
 #if defined(PLATFORM_WINDOWS)
@@ -2720,104 +3509,11 @@ namespace lsp
     {
         while (count--)
         {
-            int32_t retval = int32_t(to_lower(*(s1++))) - int32_t(to_lower(*(s2++)));
+            int32_t retval = int32_t(to_casefold(*(s1++))) - int32_t(to_casefold(*(s2++)));
             if (retval != 0)
                 return (retval > 0) ? 1 : -1;
         }
         return 0;
     }
 
-    lsp_wchar_t to_lower(lsp_wchar_t c)
-    {
-        // Latin codepoints
-        if (c <= 0x7f)
-        {
-            if ((c >= 'A') && (c <= 'Z'))
-                return c - 'A' + 'a';
-
-            return c;
-        }
-
-        // Cyrillic + Cyrillic supplement codepoints
-        if ((c >= 0x400) && (c <= 0x52f))
-        {
-            if (c <= 0x40f)
-                return c + 0x50;
-            if (c <= 0x42f)
-                return c + 0x20;
-            if (!(c & 0x01))
-            {
-                if ((c >= 0x460) && (c <= 0x481))
-                    return c + 1;
-                if (c >= 0x48a)
-                    return c + 1;
-            }
-
-            return c;
-        }
-
-        // Cyrillic extended B
-        if ((c >= 0xa640) && (c <= 0xa69f))
-        {
-            if (!(c & 0x01))
-            {
-                if (c <= 0xa66d)
-                    return c + 1;
-                if ((c >= 0xa680) && (c <= 0xa69b))
-                    return c + 1;
-            }
-            return c;
-        }
-
-        // Other possible locales
-        return towlower(c);
-    }
-
-    lsp_wchar_t to_upper(lsp_wchar_t c)
-    {
-        // Latin codepoints
-        if (c <= 0x7f)
-        {
-            if ((c >= 'a') && (c <= 'z'))
-                return c - 'a' + 'A';
-
-            return c;
-        }
-
-        // Cyrillic + Cyrillic supplement codepoints
-        if ((c >= 0x400) && (c <= 0x52f))
-        {
-            if ((c >= 0x450) && (c <= 0x45f))
-                return c - 0x50;
-            if ((c >= 0x430) && (c <= 0x44f))
-                return c - 0x20;
-            if (c & 0x01)
-            {
-                if ((c >= 0x460) && (c <= 0x481))
-                    return c - 1;
-                if (c >= 0x48a)
-                    return c - 1;
-            }
-
-            return c;
-        }
-
-        // Cyrillic extended B
-        if ((c >= 0xa640) && (c <= 0xa69f))
-        {
-            if (c & 0x01)
-            {
-                if (c <= 0xa66d)
-                    return c - 1;
-                if ((c >= 0xa680) && (c <= 0xa69b))
-                    return c - 1;
-            }
-
-            return c;
-        }
-
-        // Other possible locales
-        return towupper(c);
-    }
-
 } /* namespace lsp */
@@ -0,0 +1,938 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#if defined(ARCH_X86) && defined(__SSE2__)
+    #define LSP_WCHAR_SSE2
+    #include <emmintrin.h>
+
+    // AVX2 routines are compiled with function-specific target options and selected at runtime
+    #if defined(__GNUC__) || defined(__clang__)
+        #define LSP_WCHAR_AVX2
+        #define LSP_WCHAR_TARGET_AVX2   __attribute__((target("avx2")))
+        #include <immintrin.h>
+    #endif
+#endif
+
+// Multiplier of the string hash function, equal to (1 << 16) + (1 << 4) + (1 << 2) + 1
+#define HASH_MUL            0x10015
+// Number of independent lanes of the string hash function
+#define HASH_LANES          8
+
+namespace lsp
+{
+    typedef struct wchar_kernels_t
+    {
+        utf_kernel_t    id;
+        size_t        (*find)(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch);
+        size_t        (*rfind)(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch);
+        size_t        (*search)(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len);
+        size_t        (*count)(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch);
+        size_t        (*replace)(lsp_wchar_t *s, size_t count, lsp_wchar_t ch, lsp_wchar_t rep);
+        size_t        (*mismatch)(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count);
+        size_t        (*casemismatch)(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count);
+        void          (*tolower)(lsp_wchar_t *s, size_t count);
+        void          (*toupper)(lsp_wchar_t *s, size_t count);
+        size_t        (*hash)(const lsp_wchar_t *s, size_t count);
+    } wchar_kernels_t;
+
+    //-------------------------------------------------------------------------
+    // Helper routines
+    static inline size_t first_bit(uint32_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(mask);
+    #else
+        size_t n = 0;
+        for ( ; !(mask & 1); mask >>= 1)
+            ++n;
+        return n;
+    #endif
+    }
+
+    static inline size_t last_bit(uint32_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return 31 - __builtin_clz(mask);
+    #else
+        size_t n = 0;
+        while (mask >>= 1)
+            ++n;
+        return n;
+    #endif
+    }
+
+    static inline size_t count_bits(uint32_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcount(mask);
+    #else
+        size_t n = 0;
+        for ( ; mask != 0; mask &= mask - 1)
+            ++n;
+        return n;
+    #endif
+    }
+
+    static inline lsp_wchar_t fold_lower(lsp_wchar_t c)
+    {
+        if (c >= 0x80)
+            return to_lower(c);
+        return ((c - 'A') < 26) ? c + 0x20 : c;
+    }
+
+    static inline lsp_wchar_t fold_upper(lsp_wchar_t c)
+    {
+        if (c >= 0x80)
+            return to_upper(c);
+        return ((c - 'a') < 26) ? c - 0x20 : c;
+    }
+
+    static inline lsp_wchar_t fold_case(lsp_wchar_t c)
+    {
+        if (c >= 0x80)
+            return to_casefold(c);
+        return ((c - 'A') < 26) ? c + 0x20 : c;
+    }
+
+    static inline size_t hash_tail(size_t hash, const lsp_wchar_t *s, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+            hash = (hash * HASH_MUL) ^ s[i];
+        return hash;
+    }
+
+    static inline size_t hash_lanes(const uint32_t *lanes)
+    {
+        size_t hash = 0;
+        for (size_t j=0; j<HASH_LANES; ++j)
+            hash = (hash * HASH_MUL) ^ lanes[j];
+        return hash;
+    }
+
+    //-------------------------------------------------------------------------
+    // Generic implementation
+    static size_t find_generic(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            if (s[i] == ch)
+                return i;
+        }
+        return count;
+    }
+
+    static size_t rfind_generic(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        for (size_t i=count; i > 0; )
+        {
+            if (s[--i] == ch)
+                return i;
+        }
+        return count;
+    }
+
+    static size_t search_generic(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len)
+    {
+        const lsp_wchar_t first = str[0];
+        const size_t tail       = (len - 1) * sizeof(lsp_wchar_t);
+
+        for (size_t i=0, last=count-len; i<=last; ++i)
+        {
+            if ((s[i] == first) && (::memcmp(&s[i+1], &str[1], tail) == 0))
+                return i;
+        }
+        return count;
+    }
+
+    static size_t count_generic(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        size_t n = 0;
+        for (size_t i=0; i<count; ++i)
+            n      += (s[i] == ch);
+        return n;
+    }
+
+    static size_t replace_generic(lsp_wchar_t *s, size_t count, lsp_wchar_t ch, lsp_wchar_t rep)
+    {
+        size_t n = 0;
+        for (size_t i=0; i<count; ++i)
+        {
+            if (s[i] == ch)
+            {
+                s[i]    = rep;
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    static size_t mismatch_generic(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            if (a[i] != b[i])
+                return i;
+        }
+        return count;
+    }
+
+    static size_t casemismatch_generic(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            if ((a[i] != b[i]) && (fold_case(a[i]) != fold_case(b[i])))
+                return i;
+        }
+        return count;
+    }
+
+    static void tolower_generic(lsp_wchar_t *s, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+            s[i]    = fold_lower(s[i]);
+    }
+
+    static void toupper_generic(lsp_wchar_t *s, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+            s[i]    = fold_upper(s[i]);
+    }
+
+    static size_t hash_generic(const lsp_wchar_t *s, size_t count)
+    {
+        // Strings shorter than the number of lanes are hashed sequentially
+        if (count < HASH_LANES)
+            return hash_tail(0, s, count);
+
+        uint32_t lanes[HASH_LANES];
+        for (size_t j=0; j<HASH_LANES; ++j)
+            lanes[j]    = 0;
+
+        size_t i = 0;
+        for ( ; (i + HASH_LANES) <= count; i += HASH_LANES)
+        {
+            for (size_t j=0; j<HASH_LANES; ++j)
+                lanes[j]    = uint32_t(lanes[j] * HASH_MUL) ^ s[i + j];
+        }
+
+        return hash_tail(hash_lanes(lanes), &s[i], count - i);
+    }
+
+    static const wchar_kernels_t wchar_generic_kernels =
+    {
+        UTF_KERNEL_GENERIC,
+        find_generic,
+        rfind_generic,
+        search_generic,
+        count_generic,
+        replace_generic,
+        mismatch_generic,
+        casemismatch_generic,
+        tolower_generic,
+        toupper_generic,
+        hash_generic
+    };
+
+#if defined(LSP_WCHAR_SSE2)
+    // SSE2 implementation
+    static inline __m128i fold_ascii_sse2(__m128i v, __m128i first, __m128i last, __m128i delta)
+    {
+        const __m128i m = _mm_and_si128(_mm_cmpgt_epi32(v, first), _mm_cmplt_epi32(v, last));
+        return _mm_add_epi32(v, _mm_and_si128(m, delta));
+    }
+
+    static inline bool is_ascii_sse2(__m128i v)
+    {
+        const __m128i x = _mm_and_si128(v, _mm_set1_epi32(~0x7f));
+        return _mm_movemask_epi8(_mm_cmpeq_epi32(x, _mm_setzero_si128())) == 0xffff;
+    }
+
+    static inline uint32_t mask_sse2(__m128i v)
+    {
+        return _mm_movemask_ps(_mm_castsi128_ps(v));
+    }
+
+    static size_t find_sse2(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        const __m128i vc = _mm_set1_epi32(ch);
+        size_t i = 0;
+        for ( ; (i + 16) <= count; i += 16)
+        {
+            const __m128i *p = reinterpret_cast<const __m128i *>(&s[i]);
+            const __m128i c0 = _mm_cmpeq_epi32(_mm_loadu_si128(&p[0]), vc);
+            const __m128i c1 = _mm_cmpeq_epi32(_mm_loadu_si128(&p[1]), vc);
+            const __m128i c2 = _mm_cmpeq_epi32(_mm_loadu_si128(&p[2]), vc);
+            const __m128i c3 = _mm_cmpeq_epi32(_mm_loadu_si128(&p[3]), vc);
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3))) == 0)
+                continue;
+
+            const uint32_t mask = mask_sse2(c0) | (mask_sse2(c1) << 4) | (mask_sse2(c2) << 8) | (mask_sse2(c3) << 12);
+            return i + first_bit(mask);
+        }
+        for ( ; (i + 4) <= count; i += 4)
+        {
+            const uint32_t mask = mask_sse2(_mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&s[i])), vc));
+            if (mask != 0)
+                return i + first_bit(mask);
+        }
+
+        return i + find_generic(&s[i], count - i, ch);
+    }
+
+    static size_t rfind_sse2(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        const __m128i vc = _mm_set1_epi32(ch);
+        size_t i = count;
+        for ( ; i >= 16; i -= 16)
+        {
+            const __m128i *p = reinterpret_cast<const __m128i *>(&s[i - 16]);
+            const __m128i c0 = _mm_cmpeq_epi32(_mm_loadu_si128(&p[0]), vc);
+            const __m128i c1 = _mm_cmpeq_epi32(_mm_loadu_si128(&p[1]), vc);
+            const __m128i c2 = _mm_cmpeq_epi32(_mm_loadu_si128(&p[2]), vc);
+            const __m128i c3 = _mm_cmpeq_epi32(_mm_loadu_si128(&p[3]), vc);
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3))) == 0)
+                continue;
+
+            const uint32_t mask = mask_sse2(c0) | (mask_sse2(c1) << 4) | (mask_sse2(c2) << 8) | (mask_sse2(c3) << 12);
+            return i - 16 + last_bit(mask);
+        }
+
+        const size_t res = rfind_generic(s, i, ch);
+        return (res < i) ? res : count;
+    }
+
+    static size_t search_sse2(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len)
+    {
+        if (len <= 1)
+            return find_sse2(s, count, str[0]);
+
+        // Filter candidates by the first and the last character of the pattern, then verify the rest
+        const __m128i vf    = _mm_set1_epi32(str[0]);
+        const __m128i vl    = _mm_set1_epi32(str[len - 1]);
+        const size_t tail   = (len - 2) * sizeof(lsp_wchar_t);
+
+        size_t i = 0;
+        for ( ; (i + len + 3) <= count; i += 4)
+        {
+            const __m128i f = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&s[i])), vf);
+            const __m128i l = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&s[i + len - 1])), vl);
+            for (uint32_t mask = mask_sse2(_mm_and_si128(f, l)); mask != 0; mask &= mask - 1)
+            {
+                const size_t k = i + first_bit(mask);
+                if (::memcmp(&s[k + 1], &str[1], tail) == 0)
+                    return k;
+            }
+        }
+
+        if ((i + len) > count)
+            return count;
+        const size_t res = search_generic(&s[i], count - i, str, len);
+        return (res < count - i) ? i + res : count;
+    }
+
+    static size_t count_sse2(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        const __m128i vc = _mm_set1_epi32(ch);
+        __m128i acc = _mm_setzero_si128();
+        size_t i = 0;
+        for ( ; (i + 4) <= count; i += 4)
+            acc     = _mm_sub_epi32(acc, _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&s[i])), vc));
+
+        uint32_t lanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), acc);
+        return size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3] + count_generic(&s[i], count - i, ch);
+    }
+
+    static size_t replace_sse2(lsp_wchar_t *s, size_t count, lsp_wchar_t ch, lsp_wchar_t rep)
+    {
+        const __m128i vc = _mm_set1_epi32(ch);
+        const __m128i vr = _mm_set1_epi32(rep);
+        size_t i = 0, n = 0;
+        for ( ; (i + 4) <= count; i += 4)
+        {
+            __m128i *p = reinterpret_cast<__m128i *>(&s[i]);
+            const __m128i v = _mm_loadu_si128(p);
+            const __m128i c = _mm_cmpeq_epi32(v, vc);
+            const uint32_t mask = mask_sse2(c);
+            if (mask == 0)
+                continue;
+
+            _mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(c, vr), _mm_andnot_si128(c, v)));
+            n      += count_bits(mask);
+        }
+
+        return n + replace_generic(&s[i], count - i, ch, rep);
+    }
+
+    static size_t mismatch_sse2(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count)
+    {
+        size_t i = 0;
+        for ( ; (i + 8) <= count; i += 8)
+        {
+            const __m128i *pa = reinterpret_cast<const __m128i *>(&a[i]);
+            const __m128i *pb = reinterpret_cast<const __m128i *>(&b[i]);
+            const __m128i c0 = _mm_cmpeq_epi32(_mm_loadu_si128(&pa[0]), _mm_loadu_si128(&pb[0]));
+            const __m128i c1 = _mm_cmpeq_epi32(_mm_loadu_si128(&pa[1]), _mm_loadu_si128(&pb[1]));
+            const uint32_t mask = mask_sse2(c0) | (mask_sse2(c1) << 4);
+            if (mask != 0xff)
+                return i + first_bit(~mask);
+        }
+
+        return i + mismatch_generic(&a[i], &b[i], count - i);
+    }
+
+    static size_t casemismatch_sse2(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count)
+    {
+        const __m128i first = _mm_set1_epi32('A' - 1);
+        const __m128i last  = _mm_set1_epi32('Z' + 1);
+        const __m128i delta = _mm_set1_epi32(0x20);
+
+        size_t i = 0;
+        for ( ; (i + 4) <= count; i += 4)
+        {
+            const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&a[i]));
+            const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&b[i]));
+            if (mask_sse2(_mm_cmpeq_epi32(va, vb)) == 0xf)
+                continue;
+
+            // Non-ASCII characters are folded by the scalar code
+            if (!is_ascii_sse2(_mm_or_si128(va, vb)))
+            {
+                const size_t res = casemismatch_generic(&a[i], &b[i], 4);
+                if (res < 4)
+                    return i + res;
+                continue;
+            }
+
+            const __m128i la = fold_ascii_sse2(va, first, last, delta);
+            const __m128i lb = fold_ascii_sse2(vb, first, last, delta);
+            const uint32_t mask = mask_sse2(_mm_cmpeq_epi32(la, lb));
+            if (mask != 0xf)
+                return i + first_bit(~mask);
+        }
+
+        return i + casemismatch_generic(&a[i], &b[i], count - i);
+    }
+
+    static inline void fold_sse2(lsp_wchar_t *s, size_t count, lsp_wchar_t from, lsp_wchar_t delta, void (*fallback)(lsp_wchar_t *s, size_t count))
+    {
+        const __m128i vf = _mm_set1_epi32(from - 1);
+        const __m128i vl = _mm_set1_epi32(from + 26);
+        const __m128i vd = _mm_set1_epi32(delta);
+
+        size_t i = 0;
+        for ( ; (i + 4) <= count; i += 4)
+        {
+            __m128i *p = reinterpret_cast<__m128i *>(&s[i]);
+            const __m128i v = _mm_loadu_si128(p);
+            if (!is_ascii_sse2(v))
+            {
+                fallback(&s[i], 4);
+                continue;
+            }
+
+            const __m128i m = _mm_and_si128(_mm_cmpgt_epi32(v, vf), _mm_cmplt_epi32(v, vl));
+            if (_mm_movemask_epi8(m) != 0)
+                _mm_storeu_si128(p, _mm_add_epi32(v, _mm_and_si128(m, vd)));
+        }
+
+        fallback(&s[i], count - i);
+    }
+
+    static void tolower_sse2(lsp_wchar_t *s, size_t count)
+    {
+        fold_sse2(s, count, 'A', 0x20, tolower_generic);
+    }
+
+    static void toupper_sse2(lsp_wchar_t *s, size_t count)
+    {
+        fold_sse2(s, count, 'a', lsp_wchar_t(-0x20), toupper_generic);
+    }
+
+    static inline __m128i hash_mul_sse2(__m128i x)
+    {
+        return _mm_add_epi32(
+            _mm_add_epi32(x, _mm_slli_epi32(x, 2)),
+            _mm_add_epi32(_mm_slli_epi32(x, 4), _mm_slli_epi32(x, 16)));
+    }
+
+    static size_t hash_sse2(const lsp_wchar_t *s, size_t count)
+    {
+        if (count < HASH_LANES)
+            return hash_tail(0, s, count);
+
+        __m128i h0 = _mm_setzero_si128();
+        __m128i h1 = _mm_setzero_si128();
+        size_t i = 0;
+        for ( ; (i + HASH_LANES) <= count; i += HASH_LANES)
+        {
+            const __m128i *p = reinterpret_cast<const __m128i *>(&s[i]);
+            h0      = _mm_xor_si128(hash_mul_sse2(h0), _mm_loadu_si128(&p[0]));
+            h1      = _mm_xor_si128(hash_mul_sse2(h1), _mm_loadu_si128(&p[1]));
+        }
+
+        uint32_t lanes[HASH_LANES];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&lanes[0]), h0);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&lanes[4]), h1);
+
+        return hash_tail(hash_lanes(lanes), &s[i], count - i);
+    }
+
+    static const wchar_kernels_t wchar_sse2_kernels =
+    {
+        UTF_KERNEL_SSE2,
+        find_sse2,
+        rfind_sse2,
+        search_sse2,
+        count_sse2,
+        replace_sse2,
+        mismatch_sse2,
+        casemismatch_sse2,
+        tolower_sse2,
+        toupper_sse2,
+        hash_sse2
+    };
+#endif /* LSP_WCHAR_SSE2 */
+
+#if defined(LSP_WCHAR_AVX2)
+    // AVX2 implementation
+    LSP_WCHAR_TARGET_AVX2
+    static inline uint32_t mask_avx2(__m256i v)
+    {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(v));
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static inline bool is_ascii_avx2(__m256i v)
+    {
+        return _mm256_testz_si256(v, _mm256_set1_epi32(~0x7f));
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static size_t find_avx2(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        const __m256i vc = _mm256_set1_epi32(ch);
+        size_t i = 0;
+        for ( ; (i + 32) <= count; i += 32)
+        {
+            const __m256i *p = reinterpret_cast<const __m256i *>(&s[i]);
+            const __m256i c0 = _mm256_cmpeq_epi32(_mm256_loadu_si256(&p[0]), vc);
+            const __m256i c1 = _mm256_cmpeq_epi32(_mm256_loadu_si256(&p[1]), vc);
+            const __m256i c2 = _mm256_cmpeq_epi32(_mm256_loadu_si256(&p[2]), vc);
+            const __m256i c3 = _mm256_cmpeq_epi32(_mm256_loadu_si256(&p[3]), vc);
+            const __m256i x  = _mm256_or_si256(_mm256_or_si256(c0, c1), _mm256_or_si256(c2, c3));
+            if (_mm256_testz_si256(x, x))
+                continue;
+
+            const uint32_t mask = mask_avx2(c0) | (mask_avx2(c1) << 8) | (mask_avx2(c2) << 16) | (mask_avx2(c3) << 24);
+            return i + first_bit(mask);
+        }
+        for ( ; (i + 8) <= count; i += 8)
+        {
+            const uint32_t mask = mask_avx2(_mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(&s[i])), vc));
+            if (mask != 0)
+                return i + first_bit(mask);
+        }
+
+        return i + find_generic(&s[i], count - i, ch);
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static size_t rfind_avx2(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        const __m256i vc = _mm256_set1_epi32(ch);
+        size_t i = count;
+        for ( ; i >= 32; i -= 32)
+        {
+            const __m256i *p = reinterpret_cast<const __m256i *>(&s[i - 32]);
+            const __m256i c0 = _mm256_cmpeq_epi32(_mm256_loadu_si256(&p[0]), vc);
+            const __m256i c1 = _mm256_cmpeq_epi32(_mm256_loadu_si256(&p[1]), vc);
+            const __m256i c2 = _mm256_cmpeq_epi32(_mm256_loadu_si256(&p[2]), vc);
+            const __m256i c3 = _mm256_cmpeq_epi32(_mm256_loadu_si256(&p[3]), vc);
+            const __m256i x  = _mm256_or_si256(_mm256_or_si256(c0, c1), _mm256_or_si256(c2, c3));
+            if (_mm256_testz_si256(x, x))
+                continue;
+
+            const uint32_t mask = mask_avx2(c0) | (mask_avx2(c1) << 8) | (mask_avx2(c2) << 16) | (mask_avx2(c3) << 24);
+            return i - 32 + last_bit(mask);
+        }
+
+        const size_t res = rfind_generic(s, i, ch);
+        return (res < i) ? res : count;
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static size_t search_avx2(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len)
+    {
+        if (len <= 1)
+            return find_avx2(s, count, str[0]);
+
+        // Filter candidates by the first and the last character of the pattern, then verify the rest
+        const __m256i vf    = _mm256_set1_epi32(str[0]);
+        const __m256i vl    = _mm256_set1_epi32(str[len - 1]);
+        const size_t tail   = (len - 2) * sizeof(lsp_wchar_t);
+
+        size_t i = 0;
+        for ( ; (i + len + 7) <= count; i += 8)
+        {
+            const __m256i f = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(&s[i])), vf);
+            const __m256i l = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(&s[i + len - 1])), vl);
+            for (uint32_t mask = mask_avx2(_mm256_and_si256(f, l)); mask != 0; mask &= mask - 1)
+            {
+                const size_t k = i + first_bit(mask);
+                if (::memcmp(&s[k + 1], &str[1], tail) == 0)
+                    return k;
+            }
+        }
+
+        if ((i + len) > count)
+            return count;
+        const size_t res = search_generic(&s[i], count - i, str, len);
+        return (res < count - i) ? i + res : count;
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static size_t count_avx2(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        const __m256i vc = _mm256_set1_epi32(ch);
+        __m256i acc = _mm256_setzero_si256();
+        size_t i = 0;
+        for ( ; (i + 8) <= count; i += 8)
+            acc     = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(&s[i])), vc));
+
+        uint32_t lanes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), acc);
+        size_t n = count_generic(&s[i], count - i, ch);
+        for (size_t j=0; j<8; ++j)
+            n      += lanes[j];
+        return n;
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static size_t replace_avx2(lsp_wchar_t *s, size_t count, lsp_wchar_t ch, lsp_wchar_t rep)
+    {
+        const __m256i vc = _mm256_set1_epi32(ch);
+        const __m256i vr = _mm256_set1_epi32(rep);
+        size_t i = 0, n = 0;
+        for ( ; (i + 8) <= count; i += 8)
+        {
+            __m256i *p = reinterpret_cast<__m256i *>(&s[i]);
+            const __m256i v = _mm256_loadu_si256(p);
+            const __m256i c = _mm256_cmpeq_epi32(v, vc);
+            const uint32_t mask = mask_avx2(c);
+            if (mask == 0)
+                continue;
+
+            _mm256_storeu_si256(p, _mm256_blendv_epi8(v, vr, c));
+            n      += count_bits(mask);
+        }
+
+        return n + replace_generic(&s[i], count - i, ch, rep);
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static size_t mismatch_avx2(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count)
+    {
+        size_t i = 0;
+        for ( ; (i + 16) <= count; i += 16)
+        {
+            const __m256i *pa = reinterpret_cast<const __m256i *>(&a[i]);
+            const __m256i *pb = reinterpret_cast<const __m256i *>(&b[i]);
+            const __m256i c0 = _mm256_cmpeq_epi32(_mm256_loadu_si256(&pa[0]), _mm256_loadu_si256(&pb[0]));
+            const __m256i c1 = _mm256_cmpeq_epi32(_mm256_loadu_si256(&pa[1]), _mm256_loadu_si256(&pb[1]));
+            const uint32_t mask = mask_avx2(c0) | (mask_avx2(c1) << 8);
+            if (mask != 0xffff)
+                return i + first_bit(~mask);
+        }
+
+        return i + mismatch_generic(&a[i], &b[i], count - i);
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static inline __m256i fold_ascii_avx2(__m256i v, __m256i first, __m256i last, __m256i delta)
+    {
+        const __m256i m = _mm256_and_si256(_mm256_cmpgt_epi32(v, first), _mm256_cmpgt_epi32(last, v));
+        return _mm256_add_epi32(v, _mm256_and_si256(m, delta));
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static size_t casemismatch_avx2(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count)
+    {
+        const __m256i first = _mm256_set1_epi32('A' - 1);
+        const __m256i last  = _mm256_set1_epi32('Z' + 1);
+        const __m256i delta = _mm256_set1_epi32(0x20);
+
+        size_t i = 0;
+        for ( ; (i + 8) <= count; i += 8)
+        {
+            const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&a[i]));
+            const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&b[i]));
+            if (mask_avx2(_mm256_cmpeq_epi32(va, vb)) == 0xff)
+                continue;
+
+            // Non-ASCII characters are folded by the scalar code
+            if (!is_ascii_avx2(_mm256_or_si256(va, vb)))
+            {
+                const size_t res = casemismatch_generic(&a[i], &b[i], 8);
+                if (res < 8)
+                    return i + res;
+                continue;
+            }
+
+            const __m256i la = fold_ascii_avx2(va, first, last, delta);
+            const __m256i lb = fold_ascii_avx2(vb, first, last, delta);
+            const uint32_t mask = mask_avx2(_mm256_cmpeq_epi32(la, lb));
+            if (mask != 0xff)
+                return i + first_bit(~mask);
+        }
+
+        return i + casemismatch_generic(&a[i], &b[i], count - i);
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static inline void fold_avx2(lsp_wchar_t *s, size_t count, lsp_wchar_t from, lsp_wchar_t delta, void (*fallback)(lsp_wchar_t *s, size_t count))
+    {
+        const __m256i vf = _mm256_set1_epi32(from - 1);
+        const __m256i vl = _mm256_set1_epi32(from + 26);
+        const __m256i vd = _mm256_set1_epi32(delta);
+
+        size_t i = 0;
+        for ( ; (i + 8) <= count; i += 8)
+        {
+            __m256i *p = reinterpret_cast<__m256i *>(&s[i]);
+            const __m256i v = _mm256_loadu_si256(p);
+            if (!is_ascii_avx2(v))
+            {
+                fallback(&s[i], 8);
+                continue;
+            }
+
+            const __m256i m = _mm256_and_si256(_mm256_cmpgt_epi32(v, vf), _mm256_cmpgt_epi32(vl, v));
+            if (!_mm256_testz_si256(m, m))
+                _mm256_storeu_si256(p, _mm256_add_epi32(v, _mm256_and_si256(m, vd)));
+        }
+
+        fallback(&s[i], count - i);
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static void tolower_avx2(lsp_wchar_t *s, size_t count)
+    {
+        fold_avx2(s, count, 'A', 0x20, tolower_generic);
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static void toupper_avx2(lsp_wchar_t *s, size_t count)
+    {
+        fold_avx2(s, count, 'a', lsp_wchar_t(-0x20), toupper_generic);
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static inline __m256i hash_mul_avx2(__m256i x)
+    {
+        return _mm256_add_epi32(
+            _mm256_add_epi32(x, _mm256_slli_epi32(x, 2)),
+            _mm256_add_epi32(_mm256_slli_epi32(x, 4), _mm256_slli_epi32(x, 16)));
+    }
+
+    LSP_WCHAR_TARGET_AVX2
+    static size_t hash_avx2(const lsp_wchar_t *s, size_t count)
+    {
+        if (count < HASH_LANES)
+            return hash_tail(0, s, count);
+
+        __m256i h = _mm256_setzero_si256();
+        size_t i = 0;
+        for ( ; (i + HASH_LANES) <= count; i += HASH_LANES)
+            h       = _mm256_xor_si256(hash_mul_avx2(h), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&s[i])));
+
+        uint32_t lanes[HASH_LANES];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), h);
+
+        return hash_tail(hash_lanes(lanes), &s[i], count - i);
+    }
+
+    static const wchar_kernels_t wchar_avx2_kernels =
+    {
+        UTF_KERNEL_AVX2,
+        find_avx2,
+        rfind_avx2,
+        search_avx2,
+        count_avx2,
+        replace_avx2,
+        mismatch_avx2,
+        casemismatch_avx2,
+        tolower_avx2,
+        toupper_avx2,
+        hash_avx2
+    };
+#endif /* LSP_WCHAR_AVX2 */
+
+    // Runtime dispatching
+    static const wchar_kernels_t *wchar_find_kernels(utf_kernel_t kernel)
+    {
+        switch (kernel)
+        {
+            case UTF_KERNEL_AUTO:
+#if defined(LSP_WCHAR_AVX2)
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2"))
+                    return &wchar_avx2_kernels;
+#endif /* LSP_WCHAR_AVX2 */
+#if defined(LSP_WCHAR_SSE2)
+                return &wchar_sse2_kernels;
+#else
+                return &wchar_generic_kernels;
+#endif
+
+            case UTF_KERNEL_GENERIC:
+                return &wchar_generic_kernels;
+
+#if defined(LSP_WCHAR_SSE2)
+            case UTF_KERNEL_SSE2:
+                return &wchar_sse2_kernels;
+#endif /* LSP_WCHAR_SSE2 */
+
+#if defined(LSP_WCHAR_AVX2)
+            case UTF_KERNEL_AVX2:
+                __builtin_cpu_init();
+                return (__builtin_cpu_supports("avx2")) ? &wchar_avx2_kernels : NULL;
+#endif /* LSP_WCHAR_AVX2 */
+
+            default:
+                break;
+        }
+
+        return NULL;
+    }
+
+    // The pointer is initialized during the static initialization of the library,
+    // the lazy initialization covers calls from constructors of other static objects
+    static const wchar_kernels_t *wchar_active_kernels = wchar_find_kernels(UTF_KERNEL_AUTO);
+
+    static inline const wchar_kernels_t *wchar_kernels()
+    {
+        if (wchar_active_kernels == NULL)
+            wchar_active_kernels    = wchar_find_kernels(UTF_KERNEL_AUTO);
+        return wchar_active_kernels;
+    }
+
+    status_t select_wchar_kernel(utf_kernel_t kernel)
+    {
+        const wchar_kernels_t *k = wchar_find_kernels(kernel);
+        if (k == NULL)
+            return STATUS_NOT_SUPPORTED;
+
+        wchar_active_kernels    = k;
+        return STATUS_OK;
+    }
+
+    utf_kernel_t wchar_kernel()
+    {
+        return wchar_kernels()->id;
+    }
+
+    ssize_t wchar_find(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        const size_t res = wchar_kernels()->find(s, count, ch);
+        return (res < count) ? res : -1;
+    }
+
+    ssize_t wchar_rfind(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        const size_t res = wchar_kernels()->rfind(s, count, ch);
+        return (res < count) ? res : -1;
+    }
+
+    ssize_t wchar_search(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len)
+    {
+        if (len <= 0)
+            return 0;
+        if (len > count)
+            return -1;
+
+        const size_t res = wchar_kernels()->search(s, count, str, len);
+        return (res < count) ? res : -1;
+    }
+
+    ssize_t wchar_rsearch(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len)
+    {
+        if (len <= 0)
+            return count;
+        if (len > count)
+            return -1;
+
+        // Look for the first character of the pattern backwards and verify the rest
+        const wchar_kernels_t *k    = wchar_kernels();
+        const size_t tail           = (len - 1) * sizeof(lsp_wchar_t);
+        for (size_t limit = count - len + 1; limit > 0; )
+        {
+            const size_t res = k->rfind(s, limit, str[0]);
+            if (res >= limit)
+                break;
+            if (::memcmp(&s[res + 1], &str[1], tail) == 0)
+                return res;
+            limit   = res;
+        }
+
+        return -1;
+    }
+
+    size_t wchar_count(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        return wchar_kernels()->count(s, count, ch);
+    }
+
+    size_t wchar_replace(lsp_wchar_t *s, size_t count, lsp_wchar_t ch, lsp_wchar_t rep)
+    {
+        return wchar_kernels()->replace(s, count, ch, rep);
+    }
+
+    size_t wchar_mismatch(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count)
+    {
+        return wchar_kernels()->mismatch(a, b, count);
+    }
+
+    size_t wchar_casemismatch(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count)
+    {
+        return wchar_kernels()->casemismatch(a, b, count);
+    }
+
+    void wchar_tolower(lsp_wchar_t *s, size_t count)
+    {
+        wchar_kernels()->tolower(s, count);
+    }
+
+    void wchar_toupper(lsp_wchar_t *s, size_t count)
+    {
+        wchar_kernels()->toupper(s, count);
+    }
+
+    size_t wchar_hash(const lsp_wchar_t *s, size_t count)
+    {
+        return wchar_kernels()->hash(s, count);
+    }
+
+} /* namespace lsp */
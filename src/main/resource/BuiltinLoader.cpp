@@ -21,6 +21,7 @@
 
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/lltl/darray.h>
+#include <lsp-plug.in/io/PathIterator.h>
 #include <lsp-plug.in/resource/BuiltinLoader.h>
 #include <lsp-plug.in/resource/Decompressor.h>
 
@@ -63,22 +64,16 @@ namespace lsp
 
         status_t BuiltinLoader::find_entry(ssize_t *out, const io::Path *path)
         {
-            status_t res;
             ssize_t index = -1;
-            LSPString item;
-            io::Path tmp;
+            io::PathIterator it(path);
 
-            // Copy path data
-            if ((res = tmp.set(path)) != STATUS_OK)
-                return res;
+            // Built-in resources are always addressed by relative path
+            if (it.is_absolute())
+                return STATUS_NOT_FOUND;
 
-            while (true)
+            while (it.next())
             {
-                // Get first item and remove it
-                if ((res = tmp.remove_first(&item)) != STATUS_OK)
-                    return res;
-
-                // Lookup for existing directory/create yet another one
+                // Lookup for the item in the current directory
                 const raw_resource_t *found = NULL;
                 for (size_t i=0; i<nCatSize; ++i)
                 {
@@ -86,7 +81,7 @@ namespace lsp
 
                     if ((ent == NULL) || (ent->parent != index) || (ent->name == NULL))
                         continue;
-                    if (item.equals_utf8(ent->name))
+                    if (it.equals_utf8(ent->name))
                     {
                         found                   = ent;
                         index                   = i;
@@ -99,7 +94,7 @@ namespace lsp
                     return STATUS_NOT_FOUND;
 
                 // Last entry?
-                if (tmp.is_empty())
+                if (it.is_last())
                 {
                     *out    = index;
                     return STATUS_OK;
@@ -107,6 +102,8 @@ namespace lsp
                 else if (found->type != RES_DIR)
                     return STATUS_NOT_FOUND;
             }
+
+            return STATUS_NOT_FOUND;
         }
 
         io::IInStream *BuiltinLoader::read_stream(const io::Path *name)
@@ -27,6 +27,7 @@
 #include <lsp-plug.in/common/bits.h>
 #include <lsp-plug.in/common/alloc.h>
 #include <lsp-plug.in/resource/Compressor.h>
+#include <lsp-plug.in/resource/codec.h>
 #include <lsp-plug.in/resource/OutProxyStream.h>
 
 namespace lsp
@@ -198,103 +199,11 @@ namespace lsp
             if (flength < 0)
                 return flength;
 
-            status_t res = STATUS_OK;
-            const uint8_t *head = sTemp.data();
-            const uint8_t *tail = &head[flength];
-            size_t offset = 0;
-
-//            IF_TRACE(
-//                wssize_t coffset    = sOS.position();
-//                size_t octets       = 0;
-//                size_t replays      = 0;
-//                size_t repeats      = 0;
-//            )
-
-            while (head < tail)
-            {
-                // Estimate the length of match
-                const size_t length = sBuffer.lookup(&offset, head, tail-head);
-
-                // Estimate size of output
-                const size_t est1   = est_uint(sBuffer.size() + *head, 5, 5) * length; // How many bits used to emit octet command
-                const size_t est2   = (length > 0) ? est_uint(offset, 5, 5) + est_uint(length - 1, 5, 5) : est1 + 1;    // How many bits used to encode buffer replay command
-
-                if (est2 < est1) // Prefer buffer replay over octet emission
-                {
-                    const size_t repeats    = calc_repeats(&head[length], tail);
-
-//                    fprintf(hFD, "BUFFER replays=%d, off=%d, length=%d, sequence=",
-//                        int(repeats), int(offset), int(length));
-//                    for (size_t i=0; i<length; ++i)
-//                        fprintf(hFD, "%02x ", head[i]);
-//                    for (size_t i=0; i<repeats; ++i)
-//                        fprintf(hFD, "%02x ", head[length - 1]);
-//                    fprintf(hFD, "\n");
-
-                    // REPLAY BUFFER
-                    // Emit Offset
-                    if ((res = emit_uint(offset, 5, 5)) != STATUS_OK)
-                        break;
-                    // Emit Length - 1
-                    if ((res = emit_uint(length - 1, 5, 5)) != STATUS_OK)
-                        break;
-                    // Emit Repeat counter
-                    if ((res = emit_uint(repeats, 0, 4)) != STATUS_OK)
-                        break;
-
-                    // Append data to buffer
-                    sBuffer.append(head, length + lsp_min(repeats, REPEAT_BUF_MAX));
-                    head           += length + repeats;
-
-//                    IF_TRACE(
-//                        ++replays;
-//                        if (rep)
-//                            ++repeats;
-//                    );
-                }
-                else
-                {
-                    const size_t repeats    = calc_repeats(&head[1], tail);
-
-//                    fprintf(hFD, "OCTET  replays=%d, sequence=%02x ",
-//                        int(repeats), int(*head));
-//                    for (size_t i=0; i<repeats; ++i)
-//                        fprintf(hFD, "%02x ", int(*head));
-//                    fprintf(hFD, "\n");
-
-                    // EMIT OCTET
-                    // Emit Value
-                    if ((res = emit_uint(sBuffer.size() + *head, 5, 5)) != STATUS_OK)
-                        break;
-                    // Emit Repeat counter
-                    if ((res = emit_uint(repeats, 0, 4)) != STATUS_OK)
-                        break;
-
-                    // Append data to buffer
-                    sBuffer.append(head, 1 + lsp_min(repeats, REPEAT_BUF_MAX));
-                    head           += 1 + repeats;
-//                    IF_TRACE(
-//                        ++octets;
-//                        if (rep)
-//                            ++repeats;
-//                    );
-                }
-            }
-
-            // Flush the bit sequence
+            // Encode the data
+            status_t res = lz_encode(&sBuffer, &sOut, sTemp.data(), flength);
             if (res != STATUS_OK)
                 return -res;
 
-            // Output stats
-//            IF_TRACE(
-//                size_t cbytes   = sOS.position() - coffset;
-//
-//                lsp_trace("  octets: %d, replays: %d, repeats: %d",
-//                        int(octets), int(replays), int(repeats));
-//                lsp_trace("  original size: %d, compressed size: %d, ratio: %.2f",
-//                        int(flength), int(cbytes), double(flength) / double(cbytes));
-//            )
-
             // Remember the actual coordinates of the entry within data array
             r->segment          = int32_t(nSegment);
             r->offset           = int32_t(nOffset);
@@ -376,57 +285,6 @@ namespace lsp
             return res;
         }
 
-        status_t Compressor::emit_uint(size_t value, size_t initial, size_t stepping)
-        {
-            status_t res;
-            size_t bits     = initial;
-
-            while (true)
-            {
-                size_t max  = (1 << bits);
-                if (value < max)
-                    break;
-                if ((res = sOut.bwrite(true)) != STATUS_OK)
-                    return res;
-
-                value      -= max;
-                bits       += stepping;
-            }
-
-            if ((res = sOut.bwrite(false)) != STATUS_OK)
-                return res;
-
-            return (bits > 0) ? sOut.writev(lsp::fixed_int(value), bits) : STATUS_OK;
-        }
-
-        size_t Compressor::est_uint(size_t value, size_t initial, size_t stepping)
-        {
-            size_t bits     = initial;
-            size_t est      = 1;
-
-            while (true)
-            {
-                size_t max  = (1 << bits);
-                if (value < max)
-                    break;
-                est        ++;
-                value      -= max;
-                bits       += stepping;
-            }
-
-            return est + bits;
-        }
-
-        size_t Compressor::calc_repeats(const uint8_t *head, const uint8_t *tail)
-        {
-            uint8_t b       = head[-1];
-            const uint8_t *s= head;
-            while ((s < tail) && (*s == b))
-                ++s;
-
-            return s - head;
-        }
-
         status_t Compressor::flush()
         {
             status_t res = sOut.flush();
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/resource/codec.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace resource
+    {
+        static status_t emit_uint(io::OutBitStream *out, size_t value, size_t initial, size_t stepping)
+        {
+            status_t res;
+            size_t bits     = initial;
+
+            while (true)
+            {
+                size_t max  = (1 << bits);
+                if (value < max)
+                    break;
+                if ((res = out->bwrite(true)) != STATUS_OK)
+                    return res;
+
+                value      -= max;
+                bits       += stepping;
+            }
+
+            if ((res = out->bwrite(false)) != STATUS_OK)
+                return res;
+
+            return (bits > 0) ? out->writev(lsp::fixed_int(value), bits) : STATUS_OK;
+        }
+
+        static size_t est_uint(size_t value, size_t initial, size_t stepping)
+        {
+            size_t bits     = initial;
+            size_t est      = 1;
+
+            while (true)
+            {
+                size_t max  = (1 << bits);
+                if (value < max)
+                    break;
+                est        ++;
+                value      -= max;
+                bits       += stepping;
+            }
+
+            return est + bits;
+        }
+
+        static size_t calc_repeats(const uint8_t *head, const uint8_t *tail)
+        {
+            uint8_t b       = head[-1];
+            const uint8_t *s= head;
+            while ((s < tail) && (*s == b))
+                ++s;
+
+            return s - head;
+        }
+
+        static inline status_t read_error(ssize_t res)
+        {
+            // Unexpected end of data means that the encoded data is invalid
+            return ((res < 0) && (res != -STATUS_EOF)) ? status_t(-res) : STATUS_CORRUPTED;
+        }
+
+        static status_t read_uint(io::InBitStream *in, size_t *out, size_t initial, size_t stepping)
+        {
+            ssize_t res;
+            ssize_t bits    = initial;
+            size_t value    = 0;
+            bool flag;
+
+            while (true)
+            {
+                if ((res = in->readb(&flag)) != 1)
+                    return read_error(res);
+                if (!flag)
+                    break;
+                if (bits >= ssize_t(sizeof(size_t) * 8 - stepping))
+                    return STATUS_CORRUPTED;
+
+                value      += size_t(1) << bits;
+                bits       += stepping;
+            }
+
+            uint64_t v      = 0;
+            if ((bits > 0) && ((res = in->readv(&v, bits)) != bits))
+                return read_error(res);
+
+            *out            = value + size_t(v);
+            return STATUS_OK;
+        }
+
+        status_t lz_encode(cbuffer_t *buf, io::OutBitStream *out, const void *src, size_t count)
+        {
+            status_t res        = STATUS_OK;
+            const uint8_t *head = static_cast<const uint8_t *>(src);
+            const uint8_t *tail = &head[count];
+            size_t offset       = 0;
+
+            while (head < tail)
+            {
+                // Estimate the length of match
+                const size_t length = buf->lookup(&offset, head, tail-head);
+
+                // Estimate size of output
+                const size_t est1   = est_uint(buf->size() + *head, 5, 5) * length; // How many bits used to emit octet command
+                const size_t est2   = (length > 0) ? est_uint(offset, 5, 5) + est_uint(length - 1, 5, 5) : est1 + 1;    // How many bits used to encode buffer replay command
+
+                if (est2 < est1) // Prefer buffer replay over octet emission
+                {
+                    const size_t repeats    = calc_repeats(&head[length], tail);
+
+                    // REPLAY BUFFER
+                    // Emit Offset
+                    if ((res = emit_uint(out, offset, 5, 5)) != STATUS_OK)
+                        break;
+                    // Emit Length - 1
+                    if ((res = emit_uint(out, length - 1, 5, 5)) != STATUS_OK)
+                        break;
+                    // Emit Repeat counter
+                    if ((res = emit_uint(out, repeats, 0, 4)) != STATUS_OK)
+                        break;
+
+                    // Append data to buffer
+                    buf->append(head, length + lsp_min(repeats, REPEAT_BUF_MAX));
+                    head           += length + repeats;
+                }
+                else
+                {
+                    const size_t repeats    = calc_repeats(&head[1], tail);
+
+                    // EMIT OCTET
+                    // Emit Value
+                    if ((res = emit_uint(out, buf->size() + *head, 5, 5)) != STATUS_OK)
+                        break;
+                    // Emit Repeat counter
+                    if ((res = emit_uint(out, repeats, 0, 4)) != STATUS_OK)
+                        break;
+
+                    // Append data to buffer
+                    buf->append(head, 1 + lsp_min(repeats, REPEAT_BUF_MAX));
+                    head           += 1 + repeats;
+                }
+            }
+
+            return res;
+        }
+
+        status_t lz_decode(dbuffer_t *buf, io::InBitStream *in, void *dst, size_t count)
+        {
+            status_t res;
+            uint8_t *d          = static_cast<uint8_t *>(dst);
+            size_t offset = 0, length = 0, rep = 0;
+
+            while (count > 0)
+            {
+                // Read offset
+                if ((res = read_uint(in, &offset, 5, 5)) != STATUS_OK)
+                    return res;
+
+                if (offset < buf->size())
+                {
+                    // REPLAY BUFFER
+                    if ((res = read_uint(in, &length, 5, 5)) != STATUS_OK)
+                        return res;
+                    if ((res = read_uint(in, &rep, 0, 4)) != STATUS_OK)
+                        return res;
+                    if ((length >= count) || (rep > count - length - 1))
+                        return STATUS_CORRUPTED;
+
+                    // Copy data from the buffer and repeat the last byte
+                    length     += 1;
+                    if (buf->extract(d, offset, length) != STATUS_OK)
+                        return STATUS_CORRUPTED;
+                    buf->append(d, length);
+                    d          += length;
+                    count      -= length;
+                }
+                else
+                {
+                    // EMIT OCTET
+                    if ((offset - buf->size()) > 0xff)
+                        return STATUS_CORRUPTED;
+                    if ((res = read_uint(in, &rep, 0, 4)) != STATUS_OK)
+                        return res;
+                    if (rep >= count)
+                        return STATUS_CORRUPTED;
+
+                    *(d++)      = uint8_t(offset - buf->size());
+                    buf->append(d[-1]);
+                    --count;
+                }
+
+                // Repeat the last byte
+                if (rep > 0)
+                {
+                    const uint8_t b = d[-1];
+                    memset(d, b, rep);
+                    for (size_t i=0, n=lsp_min(rep, REPEAT_BUF_MAX); i<n; ++i)
+                        buf->append(b);
+                    d          += rep;
+                    count      -= rep;
+                }
+            }
+
+            return STATUS_OK;
+        }
+
+    } /* namespace resource */
+} /* namespace lsp */
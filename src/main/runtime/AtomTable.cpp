@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/AtomTable.h>
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+#define INITIAL_BINS        0x10
+
+namespace lsp
+{
+    AtomTable::AtomTable()
+    {
+        vBins       = NULL;
+        nBins       = 0;
+        nSize       = 0;
+    }
+
+    AtomTable::~AtomTable()
+    {
+        // Atoms are referenced by their holders without ownership, so they are
+        // released only together with the table
+        for (size_t i=0; i<nBins; ++i)
+        {
+            for (atom_t *a = vBins[i], *next; a != NULL; a = next)
+            {
+                next        = a->next;
+                delete a;
+            }
+        }
+
+        if (vBins != NULL)
+        {
+            free(vBins);
+            vBins       = NULL;
+        }
+        nBins       = 0;
+        nSize       = 0;
+    }
+
+    AtomTable *AtomTable::global()
+    {
+        static AtomTable table;
+        return &table;
+    }
+
+    const atom_t *AtomTable::lookup(const LSPString *name, size_t hash) const
+    {
+        if (vBins == NULL)
+            return NULL;
+
+        for (const atom_t *a = vBins[hash & (nBins - 1)]; a != NULL; a = a->next)
+        {
+            if ((a->hash == hash) && (a->name.equals(name)))
+                return a;
+        }
+
+        return NULL;
+    }
+
+    bool AtomTable::grow()
+    {
+        const size_t bins   = (nBins > 0) ? nBins << 1 : INITIAL_BINS;
+        atom_t **v          = static_cast<atom_t **>(malloc(bins * sizeof(atom_t *)));
+        if (v == NULL)
+            return false;
+        for (size_t i=0; i<bins; ++i)
+            v[i]                = NULL;
+
+        // Re-distribute atoms between new bins
+        for (size_t i=0; i<nBins; ++i)
+        {
+            for (atom_t *a = vBins[i], *next; a != NULL; a = next)
+            {
+                next                = a->next;
+                atom_t **bin        = &v[a->hash & (bins - 1)];
+                a->next             = *bin;
+                *bin                = a;
+            }
+        }
+
+        if (vBins != NULL)
+            free(vBins);
+        vBins       = v;
+        nBins       = bins;
+
+        return true;
+    }
+
+    const atom_t *AtomTable::intern(const LSPString *name)
+    {
+        if (name == NULL)
+            return NULL;
+
+        const size_t hash   = name->hash();
+
+        sLock.lock();
+        lsp_finally { sLock.unlock(); };
+
+        const atom_t *res   = lookup(name, hash);
+        if (res != NULL)
+            return res;
+
+        // Create new atom
+        if ((nSize >= nBins) && (!grow()))
+            return NULL;
+
+        atom_t *a           = new atom_t;
+        if (a == NULL)
+            return NULL;
+        if (!a->name.set(name))
+        {
+            delete a;
+            return NULL;
+        }
+        a->hash             = a->name.hash();   // Also caches the hash of the name
+        a->table            = this;
+
+        atom_t **bin        = &vBins[hash & (nBins - 1)];
+        a->next             = *bin;
+        *bin                = a;
+        ++nSize;
+
+        return a;
+    }
+
+    const atom_t *AtomTable::intern(const char *name)
+    {
+        if (name == NULL)
+            return NULL;
+
+        LSPString tmp;
+        return (tmp.set_utf8(name)) ? intern(&tmp) : NULL;
+    }
+
+    const atom_t *AtomTable::find(const LSPString *name) const
+    {
+        if (name == NULL)
+            return NULL;
+
+        const size_t hash   = name->hash();
+
+        sLock.lock();
+        lsp_finally { sLock.unlock(); };
+
+        return lookup(name, hash);
+    }
+
+    const atom_t *AtomTable::find(const char *name) const
+    {
+        if (name == NULL)
+            return NULL;
+
+        LSPString tmp;
+        return (tmp.set_utf8(name)) ? find(&tmp) : NULL;
+    }
+
+    size_t AtomTable::size() const
+    {
+        sLock.lock();
+        lsp_finally { sLock.unlock(); };
+
+        return nSize;
+    }
+
+    namespace lltl
+    {
+        size_t hash_spec<atom_t>::hash_func(const void *ptr, size_t size)
+        {
+            return (static_cast<const atom_t *>(ptr))->hash;
+        }
+
+        ssize_t compare_spec<atom_t>::cmp_func(const void *a, const void *b, size_t size)
+        {
+            const uint8_t *pa = static_cast<const uint8_t *>(a);
+            const uint8_t *pb = static_cast<const uint8_t *>(b);
+            return (pa < pb) ? -1 : (pa > pb) ? 1 : 0;
+        }
+
+        void *allocator_spec<atom_t>::clone_func(const void *src, size_t size)
+        {
+            return const_cast<void *>(src);
+        }
+
+        void allocator_spec<atom_t>::free_func(void *ptr)
+        {
+        }
+    } /* namespace lltl */
+
+} /* namespace lsp */
@@ -20,13 +20,12 @@
  */
 
 #include <lsp-plug.in/runtime/Color.h>
-#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/runtime/number.h>
 #include <lsp-plug.in/stdlib/math.h>
 #include <lsp-plug.in/stdlib/stdio.h>
 #include <lsp-plug.in/stdlib/string.h>
 
 #include <ctype.h>
-#include <errno.h>
 
 namespace lsp
 {
@@ -49,6 +48,36 @@ namespace lsp
     static constexpr float ONE_DIV_95p047   = 1.0f / 95.047f;
     static constexpr float ONE_DIV_108p883  = 1.0f / 108.883f;
 
+    // Enough to store up to 5 formatted single-precision values
+    static constexpr size_t COLOR_FORMAT_BUF_SIZE   = 0x200;
+
+    static ssize_t format_values(char *dst, size_t len, const char *prefix, const float *v, size_t count) noexcept
+    {
+        char buf[COLOR_FORMAT_BUF_SIZE];
+        size_t n        = strlen(prefix);
+        memcpy(buf, prefix, n);
+        buf[n++]        = '(';
+        for (size_t i=0; i<count; ++i)
+        {
+            if (i > 0)
+            {
+                buf[n++]        = ',';
+                buf[n++]        = ' ';
+            }
+            n              += format_fixed(&buf[n], sizeof(buf) - n, v[i], 4);
+        }
+        buf[n++]        = ')';
+
+        if (len > 0)
+        {
+            const size_t copy   = lsp_min(n, len - 1);
+            memcpy(dst, buf, copy);
+            dst[copy]       = '\0';
+        }
+
+        return n;
+    }
+
     static const char *skip_whitespace(const char *src, const char *end) noexcept
     {
         for ( ; src < end; ++src)
@@ -1245,12 +1274,7 @@ namespace lsp
 
     status_t Color::parse_numeric(float *dst, size_t nmin, size_t nmax, const char *prefix, const char *src, size_t len) noexcept
     {
-        // Save and update locale
-        SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
-        status_t res = parse_cnumeric(dst, nmin, nmax, prefix, src, len);
-
-        return res;
+        return parse_cnumeric(dst, nmin, nmax, prefix, src, len);
     }
 
     status_t Color::parse_cnumeric(float *dst, size_t nmin, size_t nmax, const char *prefix, const char *src, size_t len) noexcept
@@ -1285,10 +1309,10 @@ namespace lsp
                 return STATUS_BAD_FORMAT;
 
             // Parse floating-point value
-            char *eptr = NULL;
-            errno = 0;
-            dst[count++] = strtof(src, &eptr);
-            if ((errno != 0) || (eptr != next) || (eptr == src))
+            size_t parsed = 0;
+            if (parse_float(&dst[count++], src, next - src, &parsed) != STATUS_OK)
+                return STATUS_BAD_FORMAT;
+            if (parsed != size_t(next - src))
                 return STATUS_BAD_FORMAT;
 
             // Move parse position
@@ -1384,9 +1408,6 @@ namespace lsp
         if ((res = parse3(src, len)) == STATUS_OK)
             return res;
 
-        // Save and update locale
-        SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
         // Try to parse different expressions
         if ((res = parse_cnumeric(v, 3, 3, "rgb", src, len)) == STATUS_OK)
             set_rgba(v[0], v[1], v[2], 0.0f);
@@ -1422,50 +1443,66 @@ namespace lsp
 
     ssize_t Color::format3(char *dst, size_t len) const noexcept
     {
-        // Save and update locale
-        SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
-        ssize_t res = 0;
-        if (is_rgb())
-            res = snprintf(dst, len, "rgb(%.4f, %.4f, %.4f)", rgb.R, rgb.G, rgb.B);
-        else if (is_hsl())
-            res = snprintf(dst, len, "hsl(%.4f, %.4f, %.4f)", hsl.H * 360.0f, hsl.S * 100.0f, hsl.L * 200.0f);
+        if (is_hsl())
+        {
+            const float v[] = { hsl.H * 360.0f, hsl.S * 100.0f, hsl.L * 200.0f };
+            return format_values(dst, len, "hsl", v, 3);
+        }
         else if (is_lch())
-            res = snprintf(dst, len, "hcl(%.4f, %.4f, %.4f)", lch.H, lch.C, lch.L);
+        {
+            const float v[] = { lch.H, lch.C, lch.L };
+            return format_values(dst, len, "hcl", v, 3);
+        }
         else if (is_lab())
-            res = snprintf(dst, len, "lab(%.4f, %.4f, %.4f)", lab.L, lab.A, lab.B);
+        {
+            const float v[] = { lab.L, lab.A, lab.B };
+            return format_values(dst, len, "lab", v, 3);
+        }
         else if (is_xyz())
-            res = snprintf(dst, len, "xyz(%.4f, %.4f, %.4f)", xyz.X, xyz.Y, xyz.Z);
+        {
+            const float v[] = { xyz.X, xyz.Y, xyz.Z };
+            return format_values(dst, len, "xyz", v, 3);
+        }
         else if (is_cmyk())
-            res = snprintf(dst, len, "cmyk(%.4f, %.4f, %.4f, %.4f)", cmyk.C, cmyk.M, cmyk.Y, cmyk.K);
-        else
-            res = snprintf(dst, len, "rgb(%.4f, %.4f, %.4f)", rgb.R, rgb.G, rgb.B);
+        {
+            const float v[] = { cmyk.C, cmyk.M, cmyk.Y, cmyk.K };
+            return format_values(dst, len, "cmyk", v, 4);
+        }
 
-        return res;
+        const float v[] = { rgb.R, rgb.G, rgb.B };
+        return format_values(dst, len, "rgb", v, 3);
     }
 
     ssize_t Color::format4(char *dst, size_t len) const noexcept
     {
-        // Save and update locale
-        SET_LOCALE_SCOPED(LC_NUMERIC, "C");
-
-        ssize_t res = 0;
-        if (is_rgb())
-            res = snprintf(dst, len, "rgba(%.4f, %.4f, %.4f, %.4f)", rgb.R, rgb.G, rgb.B, A);
-        else if (is_hsl())
-            res = snprintf(dst, len, "hsla(%.4f, %.4f, %.4f, %.4f)", hsl.H * 360.0f, hsl.S * 100.0f, hsl.L * 200.0f, A);
+        if (is_hsl())
+        {
+            const float v[] = { hsl.H * 360.0f, hsl.S * 100.0f, hsl.L * 200.0f, A };
+            return format_values(dst, len, "hsla", v, 4);
+        }
         else if (is_lch())
-            res = snprintf(dst, len, "hcla(%.4f, %.4f, %.4f, %.4f)", lch.H, lch.C, lch.L, A);
+        {
+            const float v[] = { lch.H, lch.C, lch.L, A };
+            return format_values(dst, len, "hcla", v, 4);
+        }
         else if (is_lab())
-            res = snprintf(dst, len, "laba(%.4f, %.4f, %.4f, %.4f)", lab.L, lab.A, lab.B, A);
+        {
+            const float v[] = { lab.L, lab.A, lab.B, A };
+            return format_values(dst, len, "laba", v, 4);
+        }
         else if (is_xyz())
-            res = snprintf(dst, len, "xyza(%.4f, %.4f, %.4f, %.4f)", xyz.X, xyz.Y, xyz.Z, A);
+        {
+            const float v[] = { xyz.X, xyz.Y, xyz.Z, A };
+            return format_values(dst, len, "xyza", v, 4);
+        }
         else if (is_cmyk())
-            res = snprintf(dst, len, "cmyka(%.4f, %.4f, %.4f, %.4f, %.4f)", cmyk.C, cmyk.M, cmyk.Y, cmyk.K, A);
-        else
-            res = snprintf(dst, len, "rgba(%.4f, %.4f, %.4f, %.4f)", rgb.R, rgb.G, rgb.B, A);
+        {
+            const float v[] = { cmyk.C, cmyk.M, cmyk.Y, cmyk.K, A };
+            return format_values(dst, len, "cmyka", v, 5);
+        }
 
-        return res;
+        const float v[] = { rgb.R, rgb.G, rgb.B, A };
+        return format_values(dst, len, "rgba", v, 4);
     }
 
     ssize_t Color::format3(LSPString *dst) const noexcept
@@ -1473,7 +1510,7 @@ namespace lsp
         if (dst == NULL)
             return -STATUS_BAD_ARGUMENTS;
 
-        char buf[64];
+        char buf[COLOR_FORMAT_BUF_SIZE];
         ssize_t res = format3(buf, sizeof(buf) / sizeof(char));
         if (res < 0)
             return res;
@@ -1486,8 +1523,8 @@ namespace lsp
         if (dst == NULL)
             return -STATUS_BAD_ARGUMENTS;
 
-        char buf[64];
-        ssize_t res = format3(buf, sizeof(buf) / sizeof(char));
+        char buf[COLOR_FORMAT_BUF_SIZE];
+        ssize_t res = format4(buf, sizeof(buf) / sizeof(char));
         if (res < 0)
             return res;
 
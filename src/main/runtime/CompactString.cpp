@@ -0,0 +1,910 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/CompactString.h>
+#include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#define GRANULARITY     0x10
+
+#define XSAFE_TRANS(index, length, result) \
+    if (index < 0) \
+    { \
+        if ((index += (length)) < 0) \
+            return result; \
+    } \
+    else if (size_t(index) > (length)) \
+        return result;
+
+namespace lsp
+{
+    namespace
+    {
+        template <class D, class S>
+        inline void copy_cells(D *dst, const S *src, size_t count)
+        {
+            for (size_t i=0; i<count; ++i)
+                dst[i]      = D(src[i]);
+        }
+
+        template <class T>
+        inline void copy_cells(T *dst, const T *src, size_t count)
+        {
+            if (count > 0)
+                ::memcpy(dst, src, count * sizeof(T));
+        }
+
+        template <class T>
+        size_t mismatch(const T *a, const T *b, size_t count)
+        {
+            // Compare by 64-bit words first
+            const size_t step = sizeof(uint64_t) / sizeof(T);
+            size_t i = 0;
+            for ( ; (i + step) <= count; i += step)
+            {
+                uint64_t x, y;
+                ::memcpy(&x, &a[i], sizeof(x));
+                ::memcpy(&y, &b[i], sizeof(y));
+                if (x != y)
+                    break;
+            }
+
+            for ( ; i < count; ++i)
+                if (a[i] != b[i])
+                    break;
+
+            return i;
+        }
+
+        template <class A, class B>
+        int compare_cells(const A *a, size_t na, const B *b, size_t nb)
+        {
+            const size_t n = lsp_min(na, nb);
+            for (size_t i=0; i<n; ++i)
+            {
+                const int retval = int(a[i]) - int(b[i]);
+                if (retval != 0)
+                    return retval;
+            }
+
+            if (na > n)
+                return int(a[n]);
+            else if (nb > n)
+                return -int(b[n]);
+            return 0;
+        }
+
+        template <class T>
+        int compare_cells(const T *a, size_t na, const T *b, size_t nb)
+        {
+            const size_t n = lsp_min(na, nb);
+            const size_t i = mismatch(a, b, n);
+            if (i < n)
+                return int(a[i]) - int(b[i]);
+
+            if (na > n)
+                return int(a[n]);
+            else if (nb > n)
+                return -int(b[n]);
+            return 0;
+        }
+
+        template <class A, class B>
+        bool equal_cells(const A *a, const B *b, size_t count)
+        {
+            for (size_t i=0; i<count; ++i)
+                if (lsp_wchar_t(a[i]) != lsp_wchar_t(b[i]))
+                    return false;
+            return true;
+        }
+
+        template <class T>
+        bool equal_cells(const T *a, const T *b, size_t count)
+        {
+            return (count <= 0) || (::memcmp(a, b, count * sizeof(T)) == 0);
+        }
+
+        // Same algorithm as wchar_hash() to keep hashes compatible with LSPString
+        template <class T>
+        size_t hash_cells(const T *s, size_t count)
+        {
+            uint32_t lanes[8];
+            size_t i = 0, hash = 0;
+
+            if (count >= 8)
+            {
+                for (size_t j=0; j<8; ++j)
+                    lanes[j]    = 0;
+                for ( ; (i + 8) <= count; i += 8)
+                {
+                    for (size_t j=0; j<8; ++j)
+                        lanes[j]    = uint32_t(lanes[j] * 0x10015) ^ s[i + j];
+                }
+                for (size_t j=0; j<8; ++j)
+                    hash = (hash * 0x10015) ^ lanes[j];
+            }
+
+            for ( ; i<count; ++i)
+                hash = (hash * 0x10015) ^ s[i];
+            return hash;
+        }
+
+        inline size_t hash_cells(const lsp_wchar_t *s, size_t count)
+        {
+            return wchar_hash(s, count);
+        }
+
+        template <class T>
+        ssize_t find_char(const T *s, size_t start, size_t count, lsp_wchar_t ch)
+        {
+            for (size_t i=start; i<count; ++i)
+                if (s[i] == ch)
+                    return i;
+            return -1;
+        }
+
+        ssize_t find_char(const uint8_t *s, size_t start, size_t count, lsp_wchar_t ch)
+        {
+            if ((ch > 0xff) || (start >= count))
+                return -1;
+            const uint8_t *p = static_cast<const uint8_t *>(::memchr(&s[start], int(ch), count - start));
+            return (p != NULL) ? p - s : -1;
+        }
+
+        template <class A, class B>
+        ssize_t find_cells(const A *s, size_t start, size_t count, const B *p, size_t len)
+        {
+            if (len <= 0)
+                return start;
+            if ((count < len) || (start > (count - len)))
+                return -1;
+
+            const size_t last = count - len;
+            const lsp_wchar_t c = p[0];
+            for (size_t i=start; i<=last; ++i)
+            {
+                if (s[i] != c)
+                    continue;
+                if (equal_cells(&s[i+1], &p[1], len - 1))
+                    return i;
+            }
+
+            return -1;
+        }
+
+        ssize_t find_cells(const uint8_t *s, size_t start, size_t count, const uint8_t *p, size_t len)
+        {
+            if (len <= 0)
+                return start;
+            if ((count < len) || (start > (count - len)))
+                return -1;
+
+            // Look up for the first character using memchr()
+            const uint8_t *end = &s[count - len + 1];
+            for (const uint8_t *x = &s[start]; x < end; ++x)
+            {
+                x = static_cast<const uint8_t *>(::memchr(x, p[0], end - x));
+                if (x == NULL)
+                    break;
+                if (::memcmp(&x[1], &p[1], len - 1) == 0)
+                    return x - s;
+            }
+
+            return -1;
+        }
+
+        inline size_t utf8_bytes(lsp_wchar_t cp)
+        {
+            // Should be consistent with write_utf8_codepoint()
+            if (cp < 0x80)
+                return 1;
+            else if (cp < 0x800)
+                return 2;
+            else if (cp < 0x10000)
+                return 3;
+            return (cp < 0x200000) ? 4 : 3;
+        }
+
+        template <class T>
+        size_t utf8_size(const T *s, size_t count)
+        {
+            size_t res = 0;
+            for (size_t i=0; i<count; ++i)
+                res    += utf8_bytes(s[i]);
+            return res;
+        }
+
+        size_t utf8_size(const uint8_t *s, size_t count)
+        {
+            // Each character with the highest bit set takes two bytes
+            size_t res = count, i = 0;
+            for ( ; (i + sizeof(uint64_t)) <= count; i += sizeof(uint64_t))
+            {
+                uint64_t x;
+                ::memcpy(&x, &s[i], sizeof(x));
+                x       = (x >> 7) & 0x0101010101010101ULL;
+                res    += (x * 0x0101010101010101ULL) >> 56;
+            }
+            for ( ; i<count; ++i)
+                res    += s[i] >> 7;
+            return res;
+        }
+
+        template <class T>
+        size_t encode_utf8(char *dst, size_t size, const T *s, size_t count)
+        {
+            char *p = dst, *end = &dst[size];
+            for (size_t i=0; i<count; ++i)
+            {
+                const lsp_wchar_t cp = s[i];
+                if (cp < 0x80)
+                {
+                    if (p >= end)
+                        break;
+                    *(p++)      = char(cp);
+                }
+                else if (cp < 0x800)
+                {
+                    if ((p + 2) > end)
+                        break;
+                    p[0]        = char((cp >> 6) | 0xc0);
+                    p[1]        = char((cp & 0x3f) | 0x80);
+                    p          += 2;
+                }
+                else
+                {
+                    if ((p + utf8_bytes(cp)) > end)
+                        break;
+                    write_utf8_codepoint(&p, cp);
+                }
+            }
+            return p - dst;
+        }
+    } /* namespace */
+
+    //-------------------------------------------------------------------------
+    CompactString::CompactString()
+    {
+        nLength     = 0;
+        nCapacity   = 0;
+        pData       = NULL;
+        nHash       = 0;
+        nShift      = 0;
+    }
+
+    CompactString::~CompactString()
+    {
+        truncate();
+    }
+
+    inline size_t CompactString::shift_of(lsp_wchar_t ch)
+    {
+        return (ch < 0x100) ? 0 : (ch < 0x10000) ? 1 : 2;
+    }
+
+    size_t CompactString::shift_of(const lsp_wchar_t *src, size_t count)
+    {
+        lsp_wchar_t max = 0;
+        for (size_t i=0; i<count; ++i)
+            max        |= src[i];
+        return shift_of(max);
+    }
+
+    bool CompactString::realloc_data(size_t capacity, size_t shift)
+    {
+        if (capacity <= 0)
+        {
+            if (pData != NULL)
+            {
+                free(pData);
+                pData       = NULL;
+            }
+            nCapacity   = 0;
+            nShift      = shift;
+            return true;
+        }
+
+        // Same width, just resize the buffer
+        if (shift == nShift)
+        {
+            uint8_t *ptr    = static_cast<uint8_t *>(realloc(pData, capacity << shift));
+            if (ptr == NULL)
+                return false;
+            pData       = ptr;
+            nCapacity   = capacity;
+            return true;
+        }
+
+        // Change the width of characters
+        uint8_t *ptr    = static_cast<uint8_t *>(malloc(capacity << shift));
+        if (ptr == NULL)
+            return false;
+
+        const size_t count = lsp_min(nLength, capacity);
+        if (count > 0)
+        {
+            if (shift == 1)
+            {
+                uint16_t *dst       = reinterpret_cast<uint16_t *>(ptr);
+                if (nShift == 0)
+                    copy_cells(dst, pData, count);
+                else
+                    copy_cells(dst, reinterpret_cast<const uint32_t *>(pData), count);
+            }
+            else if (shift == 2)
+            {
+                uint32_t *dst       = reinterpret_cast<uint32_t *>(ptr);
+                if (nShift == 0)
+                    copy_cells(dst, pData, count);
+                else
+                    copy_cells(dst, reinterpret_cast<const uint16_t *>(pData), count);
+            }
+            else if (nShift == 1)
+                copy_cells(ptr, reinterpret_cast<const uint16_t *>(pData), count);
+            else
+                copy_cells(ptr, reinterpret_cast<const uint32_t *>(pData), count);
+        }
+
+        if (pData != NULL)
+            free(pData);
+        pData       = ptr;
+        nCapacity   = capacity;
+        nShift      = shift;
+
+        return true;
+    }
+
+    bool CompactString::cap_grow(size_t delta, size_t shift)
+    {
+        if (shift < nShift)
+            shift       = nShift;
+
+        const size_t length = nLength + delta;
+        if ((length <= nCapacity) && (shift == nShift))
+            return true;
+
+        size_t cap  = nCapacity;
+        if (length > cap)
+        {
+            size_t avail = lsp_max(nCapacity >> 1, delta);
+            cap        += (avail + (GRANULARITY-1)) & (~(GRANULARITY-1));
+        }
+
+        return realloc_data(cap, shift);
+    }
+
+    void CompactString::put(size_t index, const lsp_wchar_t *src, size_t count)
+    {
+        switch (nShift)
+        {
+            case 0:  copy_cells(&pData[index], src, count); break;
+            case 1:  copy_cells(&reinterpret_cast<uint16_t *>(pData)[index], src, count); break;
+            default: copy_cells(&reinterpret_cast<uint32_t *>(pData)[index], src, count); break;
+        }
+    }
+
+    void CompactString::put(size_t index, const CompactString *src)
+    {
+        const size_t count  = src->nLength;
+        const uint8_t *s8   = src->pData;
+        const uint16_t *s16 = reinterpret_cast<const uint16_t *>(src->pData);
+        const uint32_t *s32 = reinterpret_cast<const uint32_t *>(src->pData);
+
+        switch (nShift)
+        {
+            case 0:
+                copy_cells(&pData[index], s8, count);
+                break;
+            case 1:
+            {
+                uint16_t *dst = &reinterpret_cast<uint16_t *>(pData)[index];
+                if (src->nShift == 0)
+                    copy_cells(dst, s8, count);
+                else
+                    copy_cells(dst, s16, count);
+                break;
+            }
+            default:
+            {
+                uint32_t *dst = &reinterpret_cast<uint32_t *>(pData)[index];
+                if (src->nShift == 0)
+                    copy_cells(dst, s8, count);
+                else if (src->nShift == 1)
+                    copy_cells(dst, s16, count);
+                else
+                    copy_cells(dst, s32, count);
+                break;
+            }
+        }
+    }
+
+    void CompactString::clear()
+    {
+        nLength     = 0;
+        nHash       = 0;
+    }
+
+    void CompactString::truncate()
+    {
+        clear();
+        realloc_data(0, 0);
+    }
+
+    void CompactString::reduce()
+    {
+        if (nCapacity > nLength)
+            realloc_data(nLength, nShift);
+    }
+
+    void CompactString::swap(CompactString *src)
+    {
+        lsp::swap(nLength, src->nLength);
+        lsp::swap(nCapacity, src->nCapacity);
+        lsp::swap(pData, src->pData);
+        lsp::swap(nHash, src->nHash);
+        lsp::swap(nShift, src->nShift);
+    }
+
+    lsp_wchar_t CompactString::at(ssize_t index) const
+    {
+        if (index < 0)
+        {
+            if ((index += nLength) < 0)
+                return 0;
+        }
+        else if (size_t(index) >= nLength)
+            return 0;
+
+        switch (nShift)
+        {
+            case 0:  return pData[index];
+            case 1:  return reinterpret_cast<const uint16_t *>(pData)[index];
+            default: return reinterpret_cast<const uint32_t *>(pData)[index];
+        }
+    }
+
+    lsp_wchar_t CompactString::first() const
+    {
+        return at(0);
+    }
+
+    lsp_wchar_t CompactString::last() const
+    {
+        return at(-1);
+    }
+
+    bool CompactString::set(const CompactString *src)
+    {
+        if (src == this)
+            return true;
+
+        // Choose the width of the source string
+        clear();
+        if ((nShift != src->nShift) || (nCapacity < src->nLength))
+        {
+            if (!realloc_data(src->nLength, src->nShift))
+                return false;
+        }
+
+        put(0, src);
+        nLength     = src->nLength;
+        nHash       = src->nHash;
+        return true;
+    }
+
+    bool CompactString::set(const LSPString *src)
+    {
+        return set(src->characters(), src->length());
+    }
+
+    bool CompactString::set(const lsp_wchar_t *arr, size_t n)
+    {
+        const size_t shift = shift_of(arr, n);
+
+        clear();
+        if ((nShift != shift) || (nCapacity < n))
+        {
+            if (!realloc_data(n, shift))
+                return false;
+        }
+
+        put(0, arr, n);
+        nLength     = n;
+        return true;
+    }
+
+    bool CompactString::set_ascii(const char *s, size_t n)
+    {
+        clear();
+        if ((nShift != 0) || (nCapacity < n))
+        {
+            if (!realloc_data(n, 0))
+                return false;
+        }
+
+        copy_cells(pData, reinterpret_cast<const uint8_t *>(s), n);
+        nLength     = n;
+        return true;
+    }
+
+    bool CompactString::set_utf8(const char *s, size_t n)
+    {
+        // Estimate the number and the width of characters
+        size_t count = 0;
+        lsp_wchar_t max = 0;
+        const char *p = s;
+        for (size_t left = n; left > 0; ++count)
+        {
+            if (uint8_t(*p) < 0x80)
+            {
+                ++p;
+                --left;
+                continue;
+            }
+
+            const lsp_utf32_t cp = read_utf8_streaming(&p, &left, true);
+            if (cp == LSP_UTF32_EOF)
+                break;
+            max        |= cp;
+        }
+
+        const size_t shift = shift_of(max);
+        clear();
+        if ((nShift != shift) || (nCapacity < count))
+        {
+            if (!realloc_data(count, shift))
+                return false;
+        }
+
+        // Decode the string
+        p = s;
+        size_t left = n;
+        for (size_t i=0; i<count; ++i)
+        {
+            lsp_wchar_t cp;
+            if (uint8_t(*p) < 0x80)
+            {
+                cp      = uint8_t(*(p++));
+                --left;
+            }
+            else
+                cp      = read_utf8_streaming(&p, &left, true);
+
+            switch (shift)
+            {
+                case 0:  pData[i] = uint8_t(cp); break;
+                case 1:  reinterpret_cast<uint16_t *>(pData)[i] = uint16_t(cp); break;
+                default: reinterpret_cast<uint32_t *>(pData)[i] = cp; break;
+            }
+        }
+
+        nLength     = count;
+        return true;
+    }
+
+    bool CompactString::append(lsp_wchar_t ch)
+    {
+        return append(&ch, 1);
+    }
+
+    bool CompactString::append(const lsp_wchar_t *arr, size_t n)
+    {
+        if (n <= 0)
+            return true;
+        if (!cap_grow(n, shift_of(arr, n)))
+            return false;
+
+        put(nLength, arr, n);
+        nLength    += n;
+        nHash       = 0;
+        return true;
+    }
+
+    bool CompactString::append(const LSPString *src)
+    {
+        return append(src->characters(), src->length());
+    }
+
+    bool CompactString::append(const CompactString *src)
+    {
+        if (src->nLength <= 0)
+            return true;
+        if (!cap_grow(src->nLength, src->nShift))
+            return false;
+
+        put(nLength, src);
+        nLength    += src->nLength;
+        nHash       = 0;
+        return true;
+    }
+
+    bool CompactString::get(LSPString *dst) const
+    {
+        LSPString tmp;
+        if (!tmp.reserve(nLength))
+            return false;
+
+        if (nShift >= 2)
+            tmp.append(reinterpret_cast<const lsp_wchar_t *>(pData), nLength);
+        else
+        {
+            // Expand characters by chunks
+            lsp_wchar_t buf[0x40];
+            for (size_t i=0; i<nLength; )
+            {
+                const size_t n = lsp_min(nLength - i, sizeof(buf)/sizeof(buf[0]));
+                if (nShift == 0)
+                    copy_cells(buf, &pData[i], n);
+                else
+                    copy_cells(buf, &reinterpret_cast<const uint16_t *>(pData)[i], n);
+                tmp.append(buf, n);
+                i  += n;
+            }
+        }
+
+        dst->swap(&tmp);
+        return true;
+    }
+
+    size_t CompactString::utf8_length() const
+    {
+        switch (nShift)
+        {
+            case 0:  return utf8_size(pData, nLength);
+            case 1:  return utf8_size(reinterpret_cast<const uint16_t *>(pData), nLength);
+            default: return utf8_size(reinterpret_cast<const uint32_t *>(pData), nLength);
+        }
+    }
+
+    size_t CompactString::get_utf8(char *dst, size_t size) const
+    {
+        const size_t bytes = utf8_length();
+        if ((dst == NULL) || (size <= 0))
+            return bytes;
+
+        size_t n;
+        switch (nShift)
+        {
+            case 0:
+                // Plain ASCII text is copied as is
+                if (bytes == nLength)
+                {
+                    n = lsp_min(nLength, size - 1);
+                    copy_cells(reinterpret_cast<uint8_t *>(dst), pData, n);
+                }
+                else
+                    n = encode_utf8(dst, size - 1, pData, nLength);
+                break;
+            case 1:  n = encode_utf8(dst, size - 1, reinterpret_cast<const uint16_t *>(pData), nLength); break;
+            default: n = encode_utf8(dst, size - 1, reinterpret_cast<const uint32_t *>(pData), nLength); break;
+        }
+        dst[n]  = '\0';
+
+        return bytes;
+    }
+
+    char *CompactString::clone_utf8(size_t *bytes) const
+    {
+        const size_t n  = utf8_length();
+        char *res       = static_cast<char *>(malloc(n + 1));
+        if (res == NULL)
+            return NULL;
+
+        get_utf8(res, n + 1);
+        if (bytes != NULL)
+            *bytes          = n;
+        return res;
+    }
+
+    int CompactString::compare_to(const CompactString *src) const
+    {
+        const uint8_t *s8   = src->pData;
+        const uint16_t *s16 = reinterpret_cast<const uint16_t *>(src->pData);
+        const uint32_t *s32 = reinterpret_cast<const uint32_t *>(src->pData);
+        const uint16_t *d16 = reinterpret_cast<const uint16_t *>(pData);
+        const uint32_t *d32 = reinterpret_cast<const uint32_t *>(pData);
+
+        switch ((nShift << 2) | src->nShift)
+        {
+            case 0x0: return compare_cells(pData, nLength, s8, src->nLength);
+            case 0x1: return compare_cells(pData, nLength, s16, src->nLength);
+            case 0x2: return compare_cells(pData, nLength, s32, src->nLength);
+            case 0x4: return compare_cells(d16, nLength, s8, src->nLength);
+            case 0x5: return compare_cells(d16, nLength, s16, src->nLength);
+            case 0x6: return compare_cells(d16, nLength, s32, src->nLength);
+            case 0x8: return compare_cells(d32, nLength, s8, src->nLength);
+            case 0x9: return compare_cells(d32, nLength, s16, src->nLength);
+            default:  return compare_cells(d32, nLength, s32, src->nLength);
+        }
+    }
+
+    int CompactString::compare_to(const LSPString *src) const
+    {
+        return compare_to(src->characters(), src->length());
+    }
+
+    int CompactString::compare_to(const lsp_wchar_t *src, size_t len) const
+    {
+        const uint32_t *s   = reinterpret_cast<const uint32_t *>(src);
+        switch (nShift)
+        {
+            case 0:  return compare_cells(pData, nLength, s, len);
+            case 1:  return compare_cells(reinterpret_cast<const uint16_t *>(pData), nLength, s, len);
+            default: return compare_cells(reinterpret_cast<const uint32_t *>(pData), nLength, s, len);
+        }
+    }
+
+    bool CompactString::equals(const CompactString *src) const
+    {
+        if (nLength != src->nLength)
+            return false;
+        if ((nHash != 0) && (src->nHash != 0) && (nHash != src->nHash))
+            return false;
+
+        const uint8_t *s8   = src->pData;
+        const uint16_t *s16 = reinterpret_cast<const uint16_t *>(src->pData);
+        const uint32_t *s32 = reinterpret_cast<const uint32_t *>(src->pData);
+        const uint16_t *d16 = reinterpret_cast<const uint16_t *>(pData);
+        const uint32_t *d32 = reinterpret_cast<const uint32_t *>(pData);
+
+        switch ((nShift << 2) | src->nShift)
+        {
+            case 0x0: return equal_cells(pData, s8, nLength);
+            case 0x1: return equal_cells(pData, s16, nLength);
+            case 0x2: return equal_cells(pData, s32, nLength);
+            case 0x4: return equal_cells(d16, s8, nLength);
+            case 0x5: return equal_cells(d16, s16, nLength);
+            case 0x6: return equal_cells(d16, s32, nLength);
+            case 0x8: return equal_cells(d32, s8, nLength);
+            case 0x9: return equal_cells(d32, s16, nLength);
+            default:  return equal_cells(d32, s32, nLength);
+        }
+    }
+
+    bool CompactString::equals(const LSPString *src) const
+    {
+        return equals(src->characters(), src->length());
+    }
+
+    bool CompactString::equals(const lsp_wchar_t *src, size_t len) const
+    {
+        if (nLength != len)
+            return false;
+
+        const uint32_t *s   = reinterpret_cast<const uint32_t *>(src);
+        switch (nShift)
+        {
+            case 0:  return equal_cells(pData, s, len);
+            case 1:  return equal_cells(reinterpret_cast<const uint16_t *>(pData), s, len);
+            default: return equal_cells(reinterpret_cast<const uint32_t *>(pData), s, len);
+        }
+    }
+
+    bool CompactString::equals_ascii(const char *src) const
+    {
+        const size_t len = ::strlen(src);
+        if (nLength != len)
+            return false;
+
+        const uint8_t *s    = reinterpret_cast<const uint8_t *>(src);
+        switch (nShift)
+        {
+            case 0:  return equal_cells(pData, s, len);
+            case 1:  return equal_cells(reinterpret_cast<const uint16_t *>(pData), s, len);
+            default: return equal_cells(reinterpret_cast<const uint32_t *>(pData), s, len);
+        }
+    }
+
+    ssize_t CompactString::index_of(ssize_t start, lsp_wchar_t ch) const
+    {
+        XSAFE_TRANS(start, nLength, -1);
+
+        switch (nShift)
+        {
+            case 0:  return find_char(pData, start, nLength, ch);
+            case 1:  return find_char(reinterpret_cast<const uint16_t *>(pData), start, nLength, ch);
+            default: return find_char(reinterpret_cast<const uint32_t *>(pData), start, nLength, ch);
+        }
+    }
+
+    ssize_t CompactString::index_of(lsp_wchar_t ch) const
+    {
+        return index_of(0, ch);
+    }
+
+    ssize_t CompactString::index_of(ssize_t start, const CompactString *str) const
+    {
+        XSAFE_TRANS(start, nLength, -1);
+
+        const size_t len    = str->nLength;
+        const uint8_t *s8   = str->pData;
+        const uint16_t *s16 = reinterpret_cast<const uint16_t *>(str->pData);
+        const uint32_t *s32 = reinterpret_cast<const uint32_t *>(str->pData);
+        const uint16_t *d16 = reinterpret_cast<const uint16_t *>(pData);
+        const uint32_t *d32 = reinterpret_cast<const uint32_t *>(pData);
+
+        switch ((nShift << 2) | str->nShift)
+        {
+            case 0x0: return find_cells(pData, start, nLength, s8, len);
+            case 0x1: return find_cells(pData, start, nLength, s16, len);
+            case 0x2: return find_cells(pData, start, nLength, s32, len);
+            case 0x4: return find_cells(d16, start, nLength, s8, len);
+            case 0x5: return find_cells(d16, start, nLength, s16, len);
+            case 0x6: return find_cells(d16, start, nLength, s32, len);
+            case 0x8: return find_cells(d32, start, nLength, s8, len);
+            case 0x9: return find_cells(d32, start, nLength, s16, len);
+            default:  return find_cells(d32, start, nLength, s32, len);
+        }
+    }
+
+    ssize_t CompactString::index_of(const CompactString *str) const
+    {
+        return index_of(0, str);
+    }
+
+    size_t CompactString::hash() const
+    {
+        if (nHash != 0)
+            return nHash;
+
+        switch (nShift)
+        {
+            case 0:  nHash = hash_cells(pData, nLength); break;
+            case 1:  nHash = hash_cells(reinterpret_cast<const uint16_t *>(pData), nLength); break;
+            default: nHash = hash_cells(reinterpret_cast<const uint32_t *>(pData), nLength); break;
+        }
+
+        return nHash;
+    }
+
+    namespace lltl
+    {
+        size_t hash_spec<CompactString>::hash_func(const void *ptr, size_t size)
+        {
+            return (static_cast<const CompactString *>(ptr))->hash();
+        }
+
+        ssize_t compare_spec<CompactString>::cmp_func(const void *a, const void *b, size_t size)
+        {
+            const CompactString *sa = static_cast<const CompactString *>(a);
+            const CompactString *sb = static_cast<const CompactString *>(b);
+            return sa->compare_to(sb);
+        }
+
+        void *allocator_spec<CompactString>::clone_func(const void *src, size_t size)
+        {
+            CompactString *s = new CompactString();
+            if ((s != NULL) && (!s->set(static_cast<const CompactString *>(src))))
+            {
+                delete s;
+                s   = NULL;
+            }
+            return s;
+        }
+
+        void allocator_spec<CompactString>::free_func(void *ptr)
+        {
+            delete (static_cast<CompactString *>(ptr));
+        }
+    } /* namespace lltl */
+
+} /* namespace lsp */
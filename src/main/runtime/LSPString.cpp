@@ -22,6 +22,7 @@
 #include <lsp-plug.in/common/types.h>
 #include <lsp-plug.in/common/status.h>
 #include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/finally.h>
 #include <lsp-plug.in/stdlib/stdio.h>
 #include <lsp-plug.in/stdlib/string.h>
 #include <lsp-plug.in/io/charset.h>
@@ -116,13 +117,12 @@ namespace lsp
 
     int LSPString::xcasecmp(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t n)
     {
-        while (n--)
-        {
-            int32_t retval = int32_t(lsp::to_lower(*(a++))) - int32_t(lsp::to_lower(*(b++)));
-            if (retval != 0)
-                return (retval > 0) ? 1 : -1;
-        }
-        return 0;
+        const size_t i = wchar_casemismatch(a, b, n);
+        if (i >= n)
+            return 0;
+
+        int32_t retval = int32_t(lsp::to_casefold(a[i])) - int32_t(lsp::to_casefold(b[i]));
+        return (retval > 0) ? 1 : -1;
     }
 
     void LSPString::acopy(lsp_wchar_t *dst, const char *src, size_t n)
@@ -143,6 +143,15 @@ namespace lsp
         pTemp = NULL;
     }
 
+    inline void LSPString::drop_data()
+    {
+        if (pData == NULL)
+            return;
+
+        xfree(pData);
+        pData       = NULL;
+    }
+
     void LSPString::clear()
     {
         drop_temp();
@@ -157,11 +166,7 @@ namespace lsp
         nLength     = 0;
         nHash       = 0;
         nCapacity   = 0;
-        if (pData == NULL)
-            return;
-
-        xfree(pData);
-        pData       = NULL;
+        drop_data();
     }
 
     bool LSPString::truncate(size_t size)
@@ -175,13 +180,7 @@ namespace lsp
             nLength     = size;
         }
 
-        lsp_wchar_t *v = xrealloc(pData, size);
-        if ((v == NULL) && (size > 0))
-            return false;
-
-        pData       = (size > 0) ? v : NULL;
-        nCapacity   = size;
-        return true;
+        return size_reserve(size);
     }
 
     size_t LSPString::set_length(size_t length)
@@ -203,18 +202,37 @@ namespace lsp
 
     bool LSPString::size_reserve(size_t size)
     {
-        if (size > 0)
+        if (size > INLINE_SIZE)
         {
-            lsp_wchar_t *v = xrealloc(pData, size);
-            if (v == NULL)
-                return false;
+            // Move data to the heap
+            lsp_wchar_t *v;
+            if (pData == NULL)
+            {
+                v = xmalloc(size);
+                if (v == NULL)
+                    return false;
+                xmove(v, vInline, lsp_min(nLength, size));
+            }
+            else
+            {
+                v = xrealloc(pData, size);
+                if (v == NULL)
+                    return false;
+            }
             pData   = v;
         }
-        else if (pData != NULL)
+        else if (size > 0)
         {
-            ::free(pData);
-            pData   = NULL;
+            // Short strings are stored in the inline buffer
+            if (pData != NULL)
+            {
+                xmove(vInline, pData, lsp_min(nLength, size));
+                drop_data();
+            }
+            size    = INLINE_SIZE;
         }
+        else
+            drop_data();
 
         nCapacity   = size;
         return true;
@@ -222,6 +240,8 @@ namespace lsp
 
     inline bool LSPString::cap_reserve(size_t size)
     {
+        if (size <= INLINE_SIZE)
+            return (size > nCapacity) ? size_reserve(size) : true;
         size_t ncap = (size + (GRANULARITY-1)) & (~(GRANULARITY-1));
         return (ncap > nCapacity) ? size_reserve(ncap) : true;
     }
@@ -231,6 +251,8 @@ namespace lsp
         size_t avail = nCapacity - nLength;
         if (delta <= avail)
             return true;
+        if ((nLength + delta) <= INLINE_SIZE)
+            return size_reserve(nLength + delta);
         avail = nCapacity >> 1;
         if (avail < delta)
             avail = delta;
@@ -242,20 +264,17 @@ namespace lsp
         drop_temp();
         if (nCapacity <= nLength)
             return;
-        lsp_wchar_t *v = xrealloc(pData, nLength);
-        if ((v == NULL) && (nLength > 0))
-            return;
-        pData       = (nLength > 0) ? v : NULL;
-        nCapacity   = nLength;
+        size_reserve(nLength);
     }
 
     void LSPString::trim()
     {
-        if ((pData == NULL) || (nLength <= 0))
+        if (nLength <= 0)
             return;
 
         // Cut tail first
-        lsp_wchar_t *p = &pData[nLength];
+        lsp_wchar_t *data = xdata();
+        lsp_wchar_t *p = &data[nLength];
         while (nLength > 0)
         {
             if (!is_space(*(--p)))
@@ -267,22 +286,22 @@ namespace lsp
             return;
 
         // Cut head
-        p = pData;
+        p = data;
         while (true)
         {
             if (!is_space(*p))
                 break;
             p++;
         }
-        if (p > pData)
+        if (p > data)
         {
             nHash       = 0;
-            nLength    -= (p - pData);
+            nLength    -= (p - data);
         }
         if (nLength <= 0)
             return;
 
-        xmove(pData, p, nLength);
+        xmove(data, p, nLength);
     }
 
     void LSPString::swap(LSPString *src)
@@ -290,6 +309,15 @@ namespace lsp
         if (src == this)
             return;
 
+        // Heap buffers are exchanged by pointer, the contents of inline buffers are copied
+        if ((pData == NULL) || (src->pData == NULL))
+        {
+            lsp_wchar_t buf[INLINE_SIZE];
+            xmove(buf, src->vInline, INLINE_SIZE);
+            xmove(src->vInline, vInline, INLINE_SIZE);
+            xmove(vInline, buf, INLINE_SIZE);
+        }
+
         size_t len      = src->nLength;
         size_t cap      = src->nCapacity;
         lsp_wchar_t *c  = src->pData;
@@ -315,9 +343,9 @@ namespace lsp
 
         // Swap characters
         nHash           = 0;
-        lsp_wchar_t c   = pData[idx1];
-        pData[idx1]     = pData[idx2];
-        pData[idx2]     = c;
+        lsp_wchar_t c   = xdata()[idx1];
+        xdata()[idx1]     = xdata()[idx2];
+        xdata()[idx2]     = c;
 
         return true;
     }
@@ -325,13 +353,14 @@ namespace lsp
     void LSPString::take(LSPString *src)
     {
         drop_temp();
-        if (pData != NULL)
-            xfree(pData);
+        drop_data();
 
         nLength         = src->nLength;
         nCapacity       = src->nCapacity;
         pData           = src->pData;
         nHash           = src->nHash;
+        if (pData == NULL)
+            xmove(vInline, src->vInline, INLINE_SIZE);
 
         src->nLength    = 0;
         src->nCapacity  = 0;
@@ -342,13 +371,14 @@ namespace lsp
     void LSPString::take(LSPString &src)
     {
         drop_temp();
-        if (pData != NULL)
-            xfree(pData);
+        drop_data();
 
         nLength         = src.nLength;
         nCapacity       = src.nCapacity;
         pData           = src.pData;
         nHash           = src.nHash;
+        if (pData == NULL)
+            xmove(vInline, src.vInline, INLINE_SIZE);
 
         src.nLength     = 0;
         src.nCapacity   = 0;
@@ -362,21 +392,14 @@ namespace lsp
         if (s == NULL)
             return s;
 
-        s->nLength      = nLength;
-        s->nCapacity    = nLength;
-        if (s->nLength > 0)
+        if (!s->size_reserve(nLength))
         {
-            s->pData        = xmalloc(nLength);
-            if (s->pData == NULL)
-            {
-                delete s;
-                return NULL;
-            }
-
-            xmove(s->pData, pData, nLength);
+            delete s;
+            return NULL;
         }
-        else
-            s->pData        = NULL;
+
+        xmove(s->xdata(), xdata(), nLength);
+        s->nLength      = nLength;
 
         return s;
     }
@@ -429,34 +452,26 @@ namespace lsp
         else if (size_t(index) >= nLength)
             return 0;
 
-        return pData[index];
+        return xdata()[index];
     }
 
     lsp_wchar_t LSPString::first() const
     {
-        return (nLength > 0) ? pData[0] : 0;
+        return (nLength > 0) ? xdata()[0] : 0;
     }
 
     lsp_wchar_t LSPString::last() const
     {
-        return (nLength > 0) ? pData[nLength-1] : 0;
+        return (nLength > 0) ? xdata()[nLength-1] : 0;
     }
 
     bool LSPString::set(lsp_wchar_t ch)
     {
         drop_temp();
 
-        if (nCapacity == 0)
-        {
-            lsp_wchar_t *v = xmalloc(GRANULARITY);
-            if (v == NULL)
-                return false;
-            v[0]        = ch;
-            pData       = v;
-            nCapacity   = GRANULARITY;
-        }
-        else
-            pData[0]    = ch;
+        if ((nCapacity == 0) && (!size_reserve(1)))
+            return false;
+        xdata()[0]    = ch;
 
         nHash       = 0;
         nLength     = 1;
@@ -475,7 +490,7 @@ namespace lsp
         if (!cap_reserve(n))
             return false;
 
-        xmove(pData, arr, n);
+        xmove(xdata(), arr, n);
         nHash       = 0;
         nLength     = n;
         return true;
@@ -484,7 +499,7 @@ namespace lsp
     bool LSPString::set(ssize_t first, lsp_wchar_t ch)
     {
         XSAFE_ITRANS(first, nLength, false);
-        pData[first]    = ch;
+        xdata()[first]    = ch;
         nHash           = 0;
         return true;
     }
@@ -498,7 +513,7 @@ namespace lsp
         if (!cap_reserve(src->nLength))
             return false;
         if (src->nLength > 0)
-            xmove(pData, src->pData, src->nLength);
+            xmove(xdata(), src->xdata(), src->nLength);
         nLength     = src->nLength;
         nHash       = 0;
         return true;
@@ -515,7 +530,7 @@ namespace lsp
         {
             if (!cap_reserve(length))
                 return false;
-            xmove(pData, &src->pData[first], length);
+            xmove(xdata(), &src->xdata()[first], length);
             nLength     = length;
         }
         else
@@ -537,7 +552,7 @@ namespace lsp
         {
             if (!cap_reserve(length))
                 return false;
-            xmove(pData, &src->pData[first], length);
+            xmove(xdata(), &src->xdata()[first], length);
             nLength     = length;
         }
         else
@@ -556,9 +571,9 @@ namespace lsp
 
         ssize_t length = nLength - pos;
         if (length > 0)
-            xmove(&pData[pos+1], &pData[pos], length);
+            xmove(&xdata()[pos+1], &xdata()[pos], length);
 
-        pData[pos] = ch;
+        xdata()[pos] = ch;
         nLength++;
         nHash       = 0;
         return true;
@@ -572,8 +587,8 @@ namespace lsp
 
         ssize_t count = nLength - pos;
         if (count > 0)
-            xmove(&pData[pos+n], &pData[pos], count);
-        xmove(&pData[pos], arr, n);
+            xmove(&xdata()[pos+n], &xdata()[pos], count);
+        xmove(&xdata()[pos], arr, n);
         nLength    += n;
         nHash       = 0;
         return true;
@@ -590,8 +605,8 @@ namespace lsp
 
         ssize_t count = nLength - pos;
         if (count > 0)
-            xmove(&pData[pos+src->nLength], &pData[pos], count);
-        xmove(&pData[pos], src->pData, src->nLength);
+            xmove(&xdata()[pos+src->nLength], &xdata()[pos], count);
+        xmove(&xdata()[pos], src->xdata(), src->nLength);
         nLength    += src->nLength;
         nHash       = 0;
         return true;
@@ -610,8 +625,8 @@ namespace lsp
 
         ssize_t count = nLength - pos;
         if (count > 0)
-            xmove(&pData[pos+length], &pData[pos], count);
-        xmove(&pData[pos], &src->pData[first], length);
+            xmove(&xdata()[pos+length], &xdata()[pos], count);
+        xmove(&xdata()[pos], &src->xdata()[first], length);
         nLength    += length;
         nHash       = 0;
         return true;
@@ -631,8 +646,8 @@ namespace lsp
 
         ssize_t count = nLength - pos;
         if (count > 0)
-            xmove(&pData[pos+length], &pData[pos], count);
-        xmove(&pData[pos], &src->pData[first], length);
+            xmove(&xdata()[pos+length], &xdata()[pos], count);
+        xmove(&xdata()[pos], &src->xdata()[first], length);
         nLength    += length;
         nHash       = 0;
         return true;
@@ -642,7 +657,7 @@ namespace lsp
     {
         if (!cap_grow(1))
             return false;
-        pData[nLength++] = uint8_t(ch);
+        xdata()[nLength++] = uint8_t(ch);
         nHash            = 0;
         return true;
     }
@@ -651,7 +666,7 @@ namespace lsp
     {
         if (!cap_grow(1))
             return false;
-        pData[nLength++] = ch;
+        xdata()[nLength++] = ch;
         nHash            = 0;
         return true;
     }
@@ -660,7 +675,7 @@ namespace lsp
     {
         if (!cap_grow(1))
             return false;
-        pData[nLength++] = ch;
+        xdata()[nLength++] = ch;
         nHash            = 0;
         return true;
     }
@@ -674,7 +689,7 @@ namespace lsp
     {
         if (!cap_grow(n))
             return false;
-        xmove(&pData[nLength], arr, n);
+        xmove(&xdata()[nLength], arr, n);
         nLength    += n;
         nHash       = 0;
         return true;
@@ -684,7 +699,7 @@ namespace lsp
     {
         if (!cap_grow(n))
             return false;
-        acopy(&pData[nLength], arr, n);
+        acopy(&xdata()[nLength], arr, n);
         nLength    += n;
         nHash       = 0;
         return true;
@@ -694,11 +709,20 @@ namespace lsp
     {
         if (nLength <= 0)
             return set_utf8(arr, n);
+        if (n <= 0)
+            return true;
 
-        LSPString tmp;
-        if (!tmp.set_utf8(arr, n))
+        // Each byte of UTF-8 sequence produces at most one character, decode directly to the tail
+        if (!cap_grow(n))
             return false;
-        return append(&tmp);
+
+        size_t ndst = nCapacity - nLength;
+        utf8_to_utf32(reinterpret_cast<lsp_utf32_t *>(&xdata()[nLength]), &ndst, arr, &n, true);
+        if (n > 0)
+            return false;
+        nLength     = nCapacity - ndst;
+        nHash       = 0;
+        return true;
     }
 
     bool LSPString::append_utf16(const lsp_utf16_t *arr, size_t n)
@@ -723,7 +747,7 @@ namespace lsp
             return true;
         if (!cap_grow(src->nLength))
             return false;
-        xmove(&pData[nLength], src->pData, src->nLength);
+        xmove(&xdata()[nLength], src->xdata(), src->nLength);
         nLength    += src->nLength;
         nHash       = 0;
         return true;
@@ -738,7 +762,7 @@ namespace lsp
 
         if (!cap_grow(length))
             return false;
-        xmove(&pData[nLength], &src->pData[first], length);
+        xmove(&xdata()[nLength], &src->xdata()[first], length);
         nLength    += length;
         nHash       = 0;
         return true;
@@ -754,7 +778,7 @@ namespace lsp
 
         if (!cap_grow(length))
             return false;
-        xmove(&pData[nLength], &src->pData[first], length);
+        xmove(&xdata()[nLength], &src->xdata()[first], length);
         nLength    += length;
         nHash       = 0;
         return true;
@@ -765,8 +789,8 @@ namespace lsp
         if (!cap_grow(1))
             return false;
         if (nLength > 0)
-            xmove(&pData[1], pData, nLength);
-        pData[0]    = ch;
+            xmove(&xdata()[1], xdata(), nLength);
+        xdata()[0]    = ch;
         nLength     ++;
         nHash       = 0;
         return true;
@@ -780,8 +804,8 @@ namespace lsp
             return false;
 
         if (nLength > 0)
-            xmove(&pData[n], pData, nLength);
-        xmove(pData, arr, n);
+            xmove(&xdata()[n], xdata(), nLength);
+        xmove(xdata(), arr, n);
         nLength     += n;
         nHash       = 0;
         return true;
@@ -795,8 +819,8 @@ namespace lsp
             return false;
 
         if (nLength > 0)
-            xmove(&pData[n], pData, nLength);
-        acopy(pData, arr, n);
+            xmove(&xdata()[n], xdata(), nLength);
+        acopy(xdata(), arr, n);
         nLength    += n;
         nHash       = 0;
         return true;
@@ -821,8 +845,8 @@ namespace lsp
             return false;
 
         if (nLength > 0)
-            xmove(&pData[src->nLength], pData, nLength);
-        xmove(pData, src->pData, src->nLength);
+            xmove(&xdata()[src->nLength], xdata(), nLength);
+        xmove(xdata(), src->xdata(), src->nLength);
         nLength    += src->nLength;
         nHash       = 0;
         return true;
@@ -838,8 +862,8 @@ namespace lsp
         if (!cap_grow(length))
             return false;
         if (nLength > 0)
-            xmove(&pData[length], pData, nLength);
-        xmove(pData, &src->pData[first], length);
+            xmove(&xdata()[length], xdata(), nLength);
+        xmove(xdata(), &src->xdata()[first], length);
         nLength    += length;
         nHash       = 0;
         return true;
@@ -856,8 +880,8 @@ namespace lsp
         if (!cap_grow(length))
             return false;
         if (nLength > 0)
-            xmove(&pData[length], pData, nLength);
-        xmove(pData, &src->pData[first], length);
+            xmove(&xdata()[length], xdata(), nLength);
+        xmove(xdata(), &src->xdata()[first], length);
         nLength    += length;
         nHash       = 0;
         return true;
@@ -865,14 +889,14 @@ namespace lsp
 
     bool LSPString::ends_with(lsp_wchar_t ch) const
     {
-        return (nLength > 0) ? pData[nLength-1] == ch : false;
+        return (nLength > 0) ? xdata()[nLength-1] == ch : false;
     }
 
     bool LSPString::ends_with_nocase(lsp_wchar_t ch) const
     {
         if (nLength <= 0)
             return false;
-        return lsp::to_lower(pData[nLength-1]) == lsp::to_lower(ch);
+        return lsp::to_casefold(xdata()[nLength-1]) == lsp::to_casefold(ch);
     }
 
     bool LSPString::ends_with(const LSPString *src) const
@@ -884,7 +908,7 @@ namespace lsp
         if (offset < 0)
             return false;
 
-        return xcmp(&pData[offset], src->pData, src->nLength) == 0;
+        return xcmp(&xdata()[offset], src->xdata(), src->nLength) == 0;
     }
 
     bool LSPString::ends_with_ascii(const char *src) const
@@ -908,19 +932,19 @@ namespace lsp
         if (offset < 0)
             return false;
 
-        return xcasecmp(&pData[offset], src->pData, src->nLength) == 0;
+        return xcasecmp(&xdata()[offset], src->xdata(), src->nLength) == 0;
     }
 
     bool LSPString::starts_with(lsp_wchar_t ch, size_t offset) const
     {
-        return (offset < nLength) ? pData[offset] == ch : false;
+        return (offset < nLength) ? xdata()[offset] == ch : false;
     }
 
     bool LSPString::starts_with_nocase(lsp_wchar_t ch, size_t offset) const
     {
         if (offset > nLength)
             return false;
-        return lsp::to_lower(pData[offset]) == lsp::to_lower(ch);
+        return lsp::to_casefold(xdata()[offset]) == lsp::to_casefold(ch);
     }
 
     bool LSPString::starts_with(const LSPString *src, size_t offset) const
@@ -931,7 +955,7 @@ namespace lsp
         if (nLength < (src->nLength + offset))
             return false;
 
-        return xcmp(&pData[offset], src->pData, src->nLength) == 0;
+        return xcmp(&xdata()[offset], src->xdata(), src->nLength) == 0;
     }
 
     bool LSPString::starts_with_ascii(const char *str, size_t offset) const
@@ -944,7 +968,7 @@ namespace lsp
             lsp_wchar_t c = uint8_t(*(str++));
             if (c == 0)
                 return true;
-            else if (c != pData[i])
+            else if (c != xdata()[i])
                 return false;
         }
         return (*str == '\0');
@@ -958,7 +982,7 @@ namespace lsp
         if (nLength < (offset + src->nLength))
             return false;
 
-        return xcasecmp(&pData[offset], src->pData, src->nLength) == 0;
+        return xcasecmp(&xdata()[offset], src->xdata(), src->nLength) == 0;
     }
 
     bool LSPString::starts_with_ascii_nocase(const char *str, size_t offset) const
@@ -971,7 +995,7 @@ namespace lsp
             lsp_wchar_t c = uint8_t(*(str++));
             if (c == 0)
                 return true;
-            else if (lsp::to_lower(c) != lsp::to_lower(pData[i]))
+            else if (lsp::to_casefold(c) != lsp::to_casefold(xdata()[i]))
                 return false;
         }
         return (*str == '\0');
@@ -1003,7 +1027,7 @@ namespace lsp
 
         ssize_t count = nLength - last;
         if (count > 0)
-            xmove(&pData[first], &pData[last], count);
+            xmove(&xdata()[first], &xdata()[last], count);
 
         nLength    -= length;
         nHash       = 0;
@@ -1025,7 +1049,7 @@ namespace lsp
         nHash       = 0;
 
         size_t n = (nLength >> 1);
-        lsp_wchar_t *h = pData, *t = &pData[nLength];
+        lsp_wchar_t *h = xdata(), *t = &xdata()[nLength];
         while (n--)
         {
             lsp_wchar_t c = *h;
@@ -1052,9 +1076,9 @@ namespace lsp
                 continue;
 
             // Swap characters
-            lsp_wchar_t c   = pData[idx1];
-            pData[idx1]     = pData[idx2];
-            pData[idx2]     = c;
+            lsp_wchar_t c   = xdata()[idx1];
+            xdata()[idx1]     = xdata()[idx2];
+            xdata()[idx2]     = c;
         }
     }
 
@@ -1064,7 +1088,7 @@ namespace lsp
 
         if (size_t(pos) < nLength)
         {
-            pData[pos]  = ch;
+            xdata()[pos]  = ch;
             nLength     = pos;
             nHash       = 0;
 
@@ -1082,7 +1106,7 @@ namespace lsp
         if (!cap_reserve(pos + n))
             return false;
 
-        xmove(&pData[pos], arr, n);
+        xmove(&xdata()[pos], arr, n);
         nLength     = pos + n;
         nHash       = 0;
         return true;
@@ -1095,7 +1119,7 @@ namespace lsp
         if (!cap_reserve(pos + src->nLength))
             return false;
 
-        xmove(&pData[pos], src->pData, src->nLength);
+        xmove(&xdata()[pos], src->xdata(), src->nLength);
         nLength     = pos + src->nLength;
         nHash       = 0;
         return true;
@@ -1112,7 +1136,7 @@ namespace lsp
             if (!cap_reserve(pos + length))
                 return false;
 
-            xmove(&pData[pos], &src->pData[first], length);
+            xmove(&xdata()[pos], &src->xdata()[first], length);
         }
         nLength     = pos + length;
         nHash       = 0;
@@ -1131,7 +1155,7 @@ namespace lsp
             if (!cap_reserve(pos + length))
                 return false;
 
-            xmove(&pData[pos], &src->pData[first], length);
+            xmove(&xdata()[pos], &src->xdata()[first], length);
         }
 
         nLength     = pos + length;
@@ -1152,8 +1176,8 @@ namespace lsp
 
         ssize_t tail = nLength - first - count;
         if (tail > 0)
-            xmove(&pData[first + 1], &pData[tail], nLength - tail);
-        pData[first]    = ch;
+            xmove(&xdata()[first + 1], &xdata()[tail], nLength - tail);
+        xdata()[first]    = ch;
 
         nLength     = nLength - count + 1;
         nHash       = 0;
@@ -1171,9 +1195,9 @@ namespace lsp
 
         ssize_t tail = nLength - first - count;
         if (tail > 0)
-            xmove(&pData[first + n], &pData[tail], nLength - tail);
+            xmove(&xdata()[first + n], &xdata()[tail], nLength - tail);
         if (n > 0)
-            xmove(&pData[first], arr, n);
+            xmove(&xdata()[first], arr, n);
         nLength     = nLength - count + n;
         nHash       = 0;
         return true;
@@ -1190,9 +1214,9 @@ namespace lsp
 
         ssize_t tail = nLength - first - count;
         if (tail > 0)
-            xmove(&pData[first + src->nLength], &pData[tail], nLength - tail);
+            xmove(&xdata()[first + src->nLength], &xdata()[tail], nLength - tail);
         if (src->nLength > 0)
-            xmove(&pData[first], src->pData, src->nLength);
+            xmove(&xdata()[first], src->xdata(), src->nLength);
         nLength     = nLength - count + src->nLength;
         nHash       = 0;
         return true;
@@ -1214,9 +1238,9 @@ namespace lsp
 
         ssize_t tail = nLength - first - count;
         if (tail > 0)
-            xmove(&pData[first + scount], &pData[tail], nLength - tail);
+            xmove(&xdata()[first + scount], &xdata()[tail], nLength - tail);
         if (scount > 0)
-            xmove(&pData[first], &src->pData[sfirst], scount);
+            xmove(&xdata()[first], &src->xdata()[sfirst], scount);
 
         nLength     = nLength - count + scount;
         nHash       = 0;
@@ -1238,9 +1262,9 @@ namespace lsp
 
         ssize_t tail = nLength - first - count;
         if (tail > 0)
-            xmove(&pData[first + scount], &pData[tail], nLength - tail);
+            xmove(&xdata()[first + scount], &xdata()[tail], nLength - tail);
         if (scount > 0)
-            xmove(&pData[first], &src->pData[sfirst], scount);
+            xmove(&xdata()[first], &src->xdata()[sfirst], scount);
 
         nLength     = nLength - count + scount;
         nHash       = 0;
@@ -1249,15 +1273,7 @@ namespace lsp
 
     size_t LSPString::replace_all(lsp_wchar_t ch, lsp_wchar_t rep)
     {
-        size_t n = 0;
-        for (size_t i=0; i<nLength; ++i)
-        {
-            if (pData[i] == ch)
-            {
-                pData[i] = rep;
-                ++n;
-            }
-        }
+        const size_t n = wchar_replace(xdata(), nLength, ch, rep);
         if (n > 0)
             nHash       = 0;
 
@@ -1270,14 +1286,8 @@ namespace lsp
         if (str->nLength <= 0)
             return start;
 
-        ssize_t last = nLength - str->nLength;
-        while (start <= last)
-        {
-            if (xcmp(&pData[start], str->pData, str->nLength) == 0)
-                return start;
-            start ++;
-        }
-        return -1;
+        ssize_t res = wchar_search(&xdata()[start], nLength - start, str->xdata(), str->nLength);
+        return (res >= 0) ? start + res : -1;
     }
 
     ssize_t LSPString::index_of(const LSPString *str) const
@@ -1285,54 +1295,28 @@ namespace lsp
         if (str->nLength <= 0)
             return 0;
 
-        ssize_t start = 0, last = nLength - str->nLength;
-        while (start <= last)
-        {
-            if (xcmp(&pData[start], str->pData, str->nLength) == 0)
-                return start;
-            start ++;
-        }
-        return -1;
+        return wchar_search(xdata(), nLength, str->xdata(), str->nLength);
     }
 
     ssize_t LSPString::index_of(ssize_t start, lsp_wchar_t ch) const
     {
         XSAFE_TRANS(start, nLength, -1);
 
-        ssize_t length = nLength;
-        while (start < length)
-        {
-            if (pData[start] == ch)
-                return start;
-            start ++;
-        }
-
-        return -1;
+        ssize_t res = wchar_find(&xdata()[start], nLength - start, ch);
+        return (res >= 0) ? start + res : -1;
     }
 
     ssize_t LSPString::index_of(lsp_wchar_t ch) const
     {
-        for (size_t start = 0; start < nLength; ++start)
-        {
-            if (pData[start] == ch)
-                return start;
-        }
-        return -1;
+        return wchar_find(xdata(), nLength, ch);
     }
 
     ssize_t LSPString::rindex_of(ssize_t start, const LSPString *str) const
     {
-        if (start > ssize_t(nLength))
+        if ((start < 0) || (start > ssize_t(nLength)))
             return -1;
 
-        start -= str->nLength;
-        while (start >= 0)
-        {
-            if (xcmp(&pData[start], str->pData, str->nLength) == 0)
-                return start;
-            start --;
-        }
-        return -1;
+        return wchar_rsearch(xdata(), start, str->xdata(), str->nLength);
     }
 
     ssize_t LSPString::rindex_of(const LSPString *str) const
@@ -1340,38 +1324,19 @@ namespace lsp
         if (str->nLength <= 0)
             return 0;
 
-        ssize_t start = nLength - str->nLength;
-        while (start >= 0)
-        {
-            if (xcmp(&pData[start], str->pData, str->nLength) == 0)
-                return start;
-            start --;
-        }
-        return -1;
+        return wchar_rsearch(xdata(), nLength, str->xdata(), str->nLength);
     }
 
     ssize_t LSPString::rindex_of(ssize_t start, lsp_wchar_t ch) const
     {
         XSAFE_ITRANS(start, nLength, -1);
 
-        while (start >= 0)
-        {
-            if (pData[start] == ch)
-                return start;
-            start --;
-        }
-
-        return -1;
+        return wchar_rfind(xdata(), start + 1, ch);
     }
 
     ssize_t LSPString::rindex_of(lsp_wchar_t ch) const
     {
-        for (ssize_t start=nLength-1; start >= 0; --start)
-        {
-            if (pData[start] == ch)
-                return start;
-        }
-        return -1;
+        return wchar_rfind(xdata(), nLength, ch);
     }
 
     ssize_t LSPString::index_of_nocase(ssize_t start, const LSPString *str) const
@@ -1383,7 +1348,7 @@ namespace lsp
         ssize_t last = nLength - str->nLength;
         while (start <= last)
         {
-            if (xcasecmp(&pData[start], str->pData, str->nLength) == 0)
+            if (xcasecmp(&xdata()[start], str->xdata(), str->nLength) == 0)
                 return start;
             start ++;
         }
@@ -1398,7 +1363,7 @@ namespace lsp
         ssize_t start = 0, last = nLength - str->nLength;
         while (start <= last)
         {
-            if (xcasecmp(&pData[start], str->pData, str->nLength) == 0)
+            if (xcasecmp(&xdata()[start], str->xdata(), str->nLength) == 0)
                 return start;
             start ++;
         }
@@ -1410,10 +1375,10 @@ namespace lsp
         XSAFE_TRANS(start, nLength, -1);
 
         ssize_t length = nLength;
-        ch = lsp::to_lower(ch);
+        ch = lsp::to_casefold(ch);
         while (start < length)
         {
-            if (lsp::to_lower(pData[start]) == ch)
+            if (lsp::to_casefold(xdata()[start]) == ch)
                 return start;
             start ++;
         }
@@ -1423,10 +1388,10 @@ namespace lsp
 
     ssize_t LSPString::index_of_nocase(lsp_wchar_t ch) const
     {
-        ch = lsp::to_lower(ch);
+        ch = lsp::to_casefold(ch);
         for (size_t start = 0; start < nLength; ++start)
         {
-            if (lsp::to_lower(pData[start]) == ch)
+            if (lsp::to_casefold(xdata()[start]) == ch)
                 return start;
         }
         return -1;
@@ -1440,7 +1405,7 @@ namespace lsp
         start -= str->nLength;
         while (start >= 0)
         {
-            if (xcasecmp(&pData[start], str->pData, str->nLength) == 0)
+            if (xcasecmp(&xdata()[start], str->xdata(), str->nLength) == 0)
                 return start;
             start --;
         }
@@ -1455,7 +1420,7 @@ namespace lsp
         ssize_t start = nLength - str->nLength;
         while (start >= 0)
         {
-            if (xcasecmp(&pData[start], str->pData, str->nLength) == 0)
+            if (xcasecmp(&xdata()[start], str->xdata(), str->nLength) == 0)
                 return start;
             start --;
         }
@@ -1466,10 +1431,10 @@ namespace lsp
     {
         XSAFE_ITRANS(start, nLength, -1);
 
-        ch = lsp::to_lower(ch);
+        ch = lsp::to_casefold(ch);
         while (start >= 0)
         {
-            if (lsp::to_lower(pData[start]) == ch)
+            if (lsp::to_casefold(xdata()[start]) == ch)
                 return start;
             start --;
         }
@@ -1479,10 +1444,10 @@ namespace lsp
 
     ssize_t LSPString::rindex_of_nocase(lsp_wchar_t ch) const
     {
-        ch = lsp::to_lower(ch);
+        ch = lsp::to_casefold(ch);
         for (ssize_t start=nLength-1; start >= 0; --start)
         {
-            if (lsp::to_lower(pData[start]) == ch)
+            if (lsp::to_casefold(xdata()[start]) == ch)
                 return start;
         }
         return -1;
@@ -1497,22 +1462,14 @@ namespace lsp
         if (s == NULL)
             return s;
 
-        s->nLength      = length;
-        s->nCapacity    = length;
-
-        if (length > 0)
+        if (!s->size_reserve(length))
         {
-            s->pData        = xmalloc(length);
-            if (s->pData == NULL)
-            {
-                delete s;
-                return NULL;
-            }
-
-            xmove(s->pData, &pData[first], length);
+            delete s;
+            return NULL;
         }
-        else
-            s->pData        = NULL;
+
+        xmove(s->xdata(), &xdata()[first], length);
+        s->nLength      = length;
 
         return s;
     }
@@ -1529,22 +1486,14 @@ namespace lsp
         if (s == NULL)
             return s;
 
-        s->nLength      = length;
-        s->nCapacity    = length;
-
-        if (length > 0)
+        if (!s->size_reserve(length))
         {
-            s->pData        = xmalloc(length);
-            if (s->pData == NULL)
-            {
-                delete s;
-                return NULL;
-            }
-
-            xmove(s->pData, &pData[first], length);
+            delete s;
+            return NULL;
         }
-        else
-            s->pData        = NULL;
+
+        xmove(s->xdata(), &xdata()[first], length);
+        s->nLength      = length;
 
         return s;
     }
@@ -1556,20 +1505,15 @@ namespace lsp
 
     int LSPString::compare_to(const lsp_wchar_t *src, size_t len) const
     {
-        ssize_t n = (nLength > len) ? len : nLength;
-        const lsp_wchar_t *a = pData, *b = src;
+        const size_t n = (nLength > len) ? len : nLength;
+        const size_t i = wchar_mismatch(xdata(), src, n);
 
-        while (n--)
-        {
-            int retval = int(*(a++)) - int(*(b++));
-            if (retval != 0)
-                return retval;
-        }
-
-        if (a < &pData[nLength])
-            return int(*a);
-        else if (b < &src[len])
-            return -int(*b);
+        if (i < n)
+            return int(xdata()[i]) - int(src[i]);
+        else if (n < nLength)
+            return int(xdata()[n]);
+        else if (n < len)
+            return -int(src[n]);
 
         return 0;
     }
@@ -1580,8 +1524,8 @@ namespace lsp
         for ( ; i<nLength; ++i)
         {
             if (src[i] == '\0')
-                return pData[i];
-            int retval = int(pData[i]) - uint8_t(src[i]);
+                return xdata()[i];
+            int retval = int(xdata()[i]) - uint8_t(src[i]);
             if (retval != 0)
                 return retval;
         }
@@ -1606,8 +1550,8 @@ namespace lsp
         for ( ; i<nLength; ++i)
         {
             if (src[i] == '\0')
-                return pData[i];
-            int retval = int(::lsp::to_lower(pData[i])) - ::lsp::to_lower(uint8_t(src[i]));
+                return xdata()[i];
+            int retval = int(::lsp::to_casefold(xdata()[i])) - ::lsp::to_casefold(uint8_t(src[i]));
             if (retval != 0)
                 return retval;
         }
@@ -1616,20 +1560,15 @@ namespace lsp
 
     int LSPString::compare_to_nocase(const lsp_wchar_t *src, size_t len) const
     {
-        ssize_t n = (nLength > len) ? len : nLength;
-        const lsp_wchar_t *a = pData, *b = src;
-
-        while (n--)
-        {
-            int retval = int(::lsp::to_lower(*(a++))) - int(::lsp::to_lower(*(b++)));
-            if (retval != 0)
-                return retval;
-        }
+        const size_t n = (nLength > len) ? len : nLength;
+        const size_t i = wchar_casemismatch(xdata(), src, n);
 
-        if (a < &pData[nLength])
-            return int(*a);
-        else if (b < &src[len])
-            return -int(*b);
+        if (i < n)
+            return int(::lsp::to_casefold(xdata()[i])) - int(::lsp::to_casefold(src[i]));
+        else if (n < nLength)
+            return int(xdata()[n]);
+        else if (n < len)
+            return -int(src[n]);
 
         return 0;
     }
@@ -1653,8 +1592,7 @@ namespace lsp
 
     size_t LSPString::tolower()
     {
-        for (size_t i=0; i<nLength; ++i)
-            pData[i] = lsp::to_lower(pData[i]);
+        wchar_tolower(xdata(), nLength);
         nHash       = 0;
         return nLength;
     }
@@ -1666,10 +1604,7 @@ namespace lsp
         if (n <= 0)
             return 0;
 
-        lsp_wchar_t *ptr = &pData[first];
-        for (ssize_t i=0; i<n; ++i)
-            ptr[i] = lsp::to_lower(ptr[i]);
-
+        wchar_tolower(&xdata()[first], n);
         nHash       = 0;
         return n;
     }
@@ -1686,17 +1621,14 @@ namespace lsp
         }
 
         ssize_t n = last - first;
-        lsp_wchar_t *ptr = &pData[first];
-        for (; first < last; ++first)
-            ptr[first] = lsp::to_lower(ptr[first]);
+        wchar_tolower(&xdata()[first], n);
         nHash       = 0;
         return n;
     }
 
     size_t LSPString::toupper()
     {
-        for (size_t i=0; i<nLength; ++i)
-            pData[i] = lsp::to_upper(pData[i]);
+        wchar_toupper(xdata(), nLength);
         nHash       = 0;
         return nLength;
     }
@@ -1708,9 +1640,7 @@ namespace lsp
         if (n <= 0)
             return 0;
 
-        lsp_wchar_t *ptr = &pData[first];
-        for (ssize_t i=0; i<n; ++i)
-            ptr[i] = lsp::to_upper(ptr[i]);
+        wchar_toupper(&xdata()[first], n);
         nHash       = 0;
         return n;
     }
@@ -1726,9 +1656,7 @@ namespace lsp
             first = tmp;
         }
         ssize_t n   = last - first;
-        lsp_wchar_t *ptr = &pData[first];
-        for (; first < last; ++first)
-            ptr[first] = lsp::to_upper(ptr[first]);
+        wchar_toupper(&xdata()[first], n);
         nHash       = 0;
         return n;
     }
@@ -1740,7 +1668,7 @@ namespace lsp
         if (nLength <= 0)
             return true;
 
-        return xcmp(pData, src, nLength) == 0;
+        return xcmp(xdata(), src, nLength) == 0;
     }
 
     bool LSPString::equals(const lsp_wchar_t *src) const
@@ -1753,7 +1681,7 @@ namespace lsp
         XSAFE_TRANS(first, src->nLength, false);
         XSAFE_TRANS(last, src->nLength, false);
 
-        return equals(&src->pData[first], last - first);
+        return equals(&src->xdata()[first], last - first);
     }
 
     bool LSPString::equals_nocase(const lsp_wchar_t *src, size_t len) const
@@ -1761,14 +1689,7 @@ namespace lsp
         if (nLength != len)
             return false;
 
-        const lsp_wchar_t *a = pData, *b = src;
-        for (size_t i=nLength; i>0; --i)
-        {
-            if (lsp::to_lower(*(a++)) != lsp::to_lower(*(b++)))
-                return false;
-        }
-
-        return true;
+        return wchar_casemismatch(xdata(), src, nLength) >= nLength;
     }
 
     bool LSPString::equals_nocase(const lsp_wchar_t *src) const
@@ -1778,7 +1699,7 @@ namespace lsp
 
     bool LSPString::contains_at(ssize_t index, const lsp_wchar_t *src) const
     {
-        const lsp_wchar_t *p = &pData[index];
+        const lsp_wchar_t *p = &xdata()[index];
         while (*src != '\0')
         {
             if (size_t(++index) > nLength)
@@ -1795,7 +1716,7 @@ namespace lsp
         if (nLength < (index + len))
             return false;
 
-        const lsp_wchar_t *p = &pData[index];
+        const lsp_wchar_t *p = &xdata()[index];
         for (size_t i=0; i<len; ++i)
             if (p[i] != src[i])
                 return false;
@@ -1805,7 +1726,7 @@ namespace lsp
 
     bool LSPString::contains_at_ascii(ssize_t index, const char *src) const
     {
-        const lsp_wchar_t *p = &pData[index];
+        const lsp_wchar_t *p = &xdata()[index];
         while (*src != '\0')
         {
             if (size_t(++index) > nLength)
@@ -1832,16 +1753,24 @@ namespace lsp
     bool LSPString::set_utf8(const char *s, size_t n)
     {
         LSPString   tmp;
-        lsp_wchar_t ch;
 
-        while (lsp_utf32_t(ch = read_utf8_streaming(&s, &n, true)) != LSP_UTF32_EOF)
+        // Each byte of UTF-8 sequence produces at most one character
+        if (!tmp.cap_reserve(n))
+            return false;
+
+        size_t ndst = tmp.nCapacity;
+        utf8_to_utf32(reinterpret_cast<lsp_utf32_t *>(tmp.xdata()), &ndst, s, &n, true);
+        if (n > 0)
+            return false;
+        tmp.nLength     = tmp.nCapacity - ndst;
+
+        // Release memory if the text contained too many multi-byte characters
+        if ((tmp.nCapacity > INLINE_SIZE) && (tmp.nLength < (tmp.nCapacity >> 1)))
         {
-            // Append code point
-            if (!tmp.append(ch))
+            const size_t cap = (tmp.nLength <= INLINE_SIZE) ? tmp.nLength : (tmp.nLength + (GRANULARITY-1)) & (~(GRANULARITY-1));
+            if (!tmp.size_reserve(cap))
                 return false;
         }
-        if (n > 0)
-            return false;
 
         tmp.swap(this);
         return true;
@@ -2039,7 +1968,7 @@ namespace lsp
         if (!tmp.reserve(n))
             return false;
 
-        acopy(tmp.pData, s, n);
+        acopy(tmp.xdata(), s, n);
         take(&tmp);
         nLength     = n;
         nHash       = 0;
@@ -2056,25 +1985,35 @@ namespace lsp
         if (pTemp != NULL)
             pTemp->nOffset      = 0;
 
-        char temp[BUF_SIZE + 16];
-        char *th = temp, *tt = &temp[BUF_SIZE];
+        // Encode characters directly into the temporary buffer, assume that the text
+        // is mostly ASCII and grow the buffer for the worst case only when it is full
+        const lsp_utf32_t *src  = reinterpret_cast<const lsp_utf32_t *>(&xdata()[first]);
+        size_t nsrc             = last - first;
+        size_t reserve          = nsrc + 0x10;
 
-        for (ssize_t i=first; i<last; ++i)
+        while (true)
         {
-            lsp_wchar_t ch = pData[i];
-            write_utf8_codepoint(&th, ch);
-
-            if (th >= tt)
+            const size_t offset     = (pTemp != NULL) ? pTemp->nOffset : 0;
+            const size_t avail      = (pTemp != NULL) ? pTemp->nLength - offset : 0;
+            if (avail < reserve)
             {
-                if (!append_temp(temp, th - temp))
+                if (!resize_temp(offset + reserve))
                     return NULL;
-                th  = temp;
             }
+
+            // Leave space for the terminating character
+            size_t ndst             = pTemp->nLength - pTemp->nOffset - 1;
+            const size_t n          = ndst;
+            const size_t processed  = utf32_to_utf8(&pTemp->pData[pTemp->nOffset], &ndst, src, &nsrc, true);
+            pTemp->nOffset         += n - ndst;
+            src                    += processed;
+            if (nsrc <= 0)
+                break;
+
+            reserve                 = nsrc * 3 + 0x10;
         }
 
-        *(th++) = '\0';
-        if (!append_temp(temp, th - temp))
-            return NULL;
+        pTemp->pData[pTemp->nOffset++] = '\0';
 
         return pTemp->pData;
     }
@@ -2094,7 +2033,7 @@ namespace lsp
 
         for (ssize_t i=first; i<last; ++i)
         {
-            lsp_wchar_t ch = pData[i];
+            lsp_wchar_t ch = xdata()[i];
             write_utf16_codepoint(&th, ch);
 
             if (th >= tt)
@@ -2127,7 +2066,7 @@ namespace lsp
 
         for (ssize_t i=first; i<last; ++i)
         {
-            lsp_wchar_t ch = pData[i];
+            lsp_wchar_t ch = xdata()[i];
             write_utf16le_codepoint(&th, ch);
 
             if (th >= tt)
@@ -2160,7 +2099,7 @@ namespace lsp
 
         for (ssize_t i=first; i<last; ++i)
         {
-            lsp_wchar_t ch = pData[i];
+            lsp_wchar_t ch = xdata()[i];
             write_utf16be_codepoint(&th, ch);
 
             if (th >= tt)
@@ -2188,7 +2127,7 @@ namespace lsp
         if (!resize_temp(last - first + 1))
             return NULL;
 
-        lsp_wchar_t *p  = &pData[first];
+        const lsp_wchar_t *p = &xdata()[first];
         char *dst       = pTemp->pData;
 
         for (; first < last; ++first)
@@ -2274,7 +2213,7 @@ namespace lsp
         }
 
         size_t insize   = (last - first) * sizeof(lsp_wchar_t);
-        char *inbuf     = reinterpret_cast<char *>(const_cast<lsp_wchar_t *>(&pData[first]));
+        char *inbuf     = reinterpret_cast<char *>(const_cast<lsp_wchar_t *>(&xdata()[first]));
 
         while (insize > 0)
         {
@@ -2324,6 +2263,228 @@ namespace lsp
     }
 #endif /* PLATFORM_WINDOWS */
 
+    size_t LSPString::utf8_length(ssize_t first, ssize_t last) const
+    {
+        XSAFE_TRANS(first, nLength, 0);
+        XSAFE_TRANS(last, nLength, 0);
+
+        size_t res = 0;
+        for (ssize_t i=first; i<last; ++i)
+        {
+            // Should be consistent with write_utf8_codepoint()
+            const lsp_wchar_t cp = xdata()[i];
+            if (cp < 0x80)
+                res    += 1;
+            else if (cp < 0x800)
+                res    += 2;
+            else
+                res    += ((cp < 0x10000) || (cp >= 0x200000)) ? 3 : 4;
+        }
+
+        return res;
+    }
+
+    size_t LSPString::utf16_length(ssize_t first, ssize_t last) const
+    {
+        XSAFE_TRANS(first, nLength, 0);
+        XSAFE_TRANS(last, nLength, 0);
+
+        size_t res = 0;
+        for (ssize_t i=first; i<last; ++i)
+            res    += (xdata()[i] < 0x10000) ? 1 : 2;
+
+        return res;
+    }
+
+    ssize_t LSPString::encode_utf8(char *dst, size_t size, ssize_t first, ssize_t last) const
+    {
+        XSAFE_TRANS(first, nLength, -1);
+        XSAFE_TRANS(last, nLength, -1);
+        if (first > last)
+            return -1;
+        if ((dst == NULL) || (size <= 0))
+            return utf8_length(first, last);
+
+        // Leave space for the terminating character
+        const lsp_utf32_t *src  = reinterpret_cast<const lsp_utf32_t *>(&xdata()[first]);
+        size_t nsrc             = last - first;
+        size_t ndst             = size - 1;
+        const size_t processed  = utf32_to_utf8(dst, &ndst, src, &nsrc, true);
+        const size_t written    = size - 1 - ndst;
+        dst[written]            = '\0';
+
+        // Compute the size of the remaining part if the output has been truncated
+        return (nsrc > 0) ? written + utf8_length(first + processed, last) : written;
+    }
+
+    ssize_t LSPString::encode_utf16(lsp_utf16_t *dst, size_t size, ssize_t first, ssize_t last) const
+    {
+        XSAFE_TRANS(first, nLength, -1);
+        XSAFE_TRANS(last, nLength, -1);
+        if (first > last)
+            return -1;
+        if ((dst == NULL) || (size <= 0))
+            return utf16_length(first, last);
+
+        // Leave space for the terminating character
+        const lsp_utf32_t *src  = reinterpret_cast<const lsp_utf32_t *>(&xdata()[first]);
+        size_t nsrc             = last - first;
+        size_t ndst             = size - 1;
+        const size_t processed  = utf32_to_utf16(dst, &ndst, src, &nsrc, true);
+        const size_t written    = size - 1 - ndst;
+        dst[written]            = 0;
+
+        // Compute the size of the remaining part if the output has been truncated
+        return (nsrc > 0) ? written + utf16_length(first + processed, last) : written;
+    }
+
+#if defined(PLATFORM_WINDOWS)
+    ssize_t LSPString::encode_native(char *dst, size_t size, ssize_t first, ssize_t last, const char *charset) const
+    {
+        XSAFE_TRANS(first, nLength, -1);
+        XSAFE_TRANS(last, nLength, -1);
+        if (first > last)
+            return -1;
+
+        // Get codepage
+        ssize_t cp = codepage_from_name(charset);
+        if (cp < 0)
+            return -1;
+        else if (cp == CP_UTF8)
+            return encode_utf8(dst, size, first, last);
+
+        // Encode the text as UTF-16 first, use stack buffer for short strings
+        lsp_utf16_t temp[BUF_SIZE];
+        const size_t length = utf16_length(first, last);
+        lsp_utf16_t *buf    = (length < BUF_SIZE) ? temp : static_cast<lsp_utf16_t *>(malloc((length + 1) * sizeof(lsp_utf16_t)));
+        if (buf == NULL)
+            return -1;
+        lsp_finally {
+            if (buf != temp)
+                free(buf);
+        };
+        encode_utf16(buf, length + 1, first, last);
+
+        // Estimate the size of the output
+        size_t slen         = length;
+        const ssize_t res   = (length > 0) ? widechar_to_multibyte(cp, buf, &slen, NULL, NULL) : 0;
+        if (res < 0)
+            return -1;
+        if ((dst == NULL) || (size <= 0))
+            return res;
+        if (size_t(res) >= size)
+        {
+            dst[0]              = '\0';
+            return res;
+        }
+
+        // Perform the conversion
+        size_t n            = size;
+        slen                = length;
+        const ssize_t count = (length > 0) ? widechar_to_multibyte(cp, buf, &slen, dst, &n) : 0;
+        if (count < 0)
+            return -1;
+        dst[count]          = '\0';
+
+        return count;
+    }
+#else
+    ssize_t LSPString::encode_native(char *dst, size_t size, ssize_t first, ssize_t last, const char *charset) const
+    {
+        XSAFE_TRANS(first, nLength, -1);
+        XSAFE_TRANS(last, nLength, -1);
+        if (first > last)
+            return -1;
+
+        // Do not involve iconv for the UTF-8 encoding
+        if (builtin_charset_from_name(charset) == BUILTIN_CHARSET_UTF8)
+            return encode_utf8(dst, size, first, last);
+
+        iconv_t cd = init_iconv_from_wchar_t(charset);
+        if (cd == iconv_t(-1))
+            return encode_utf8(dst, size, first, last);
+        lsp_finally { iconv_close(cd); };
+
+        size_t insize   = (last - first) * sizeof(lsp_wchar_t);
+        char *inbuf     = reinterpret_cast<char *>(const_cast<lsp_wchar_t *>(&xdata()[first]));
+
+        // Convert into the caller's buffer and only count the bytes when it becomes full
+        char temp[BUF_SIZE];
+        bool overflow   = (dst == NULL) || (size <= 0);
+        char *outbuf    = dst;
+        size_t outsize  = (overflow) ? 0 : size - 1;
+        size_t total    = 0;
+        bool flush      = false;
+
+        while (true)
+        {
+            if (overflow)
+            {
+                outbuf          = temp;
+                outsize         = sizeof(temp);
+            }
+
+            // After the whole input has been converted, emit the sequence that returns
+            // stateful encodings (ISO-2022-*, UTF-7) to the initial shift state
+            char *head      = outbuf;
+            size_t nconv    = (flush) ?
+                iconv(cd, NULL, NULL, &outbuf, &outsize) :
+                iconv(cd, &inbuf, &insize, &outbuf, &outsize);
+            total          += outbuf - head;
+            if (nconv != size_t(-1))
+            {
+                if (flush)
+                    break;
+                flush           = insize <= 0;
+                continue;
+            }
+
+            const int code  = errno;
+            if (code != E2BIG)
+                return -1;
+            if (!overflow)
+            {
+                dst[total]      = '\0';
+                overflow        = true;
+            }
+        }
+
+        if (!overflow)
+            dst[total]      = '\0';
+
+        return total;
+    }
+#endif /* PLATFORM_WINDOWS */
+
+    ssize_t LSPString::native_length(ssize_t first, ssize_t last, const char *charset) const
+    {
+        return encode_native(NULL, 0, first, last, charset);
+    }
+
+    const char *LSPString::to_utf8(char *buf, size_t size) const
+    {
+        const ssize_t res = encode_utf8(buf, size);
+        if (res < 0)
+            return NULL;
+        return (size_t(res) < size) ? buf : get_utf8();
+    }
+
+    const lsp_utf16_t *LSPString::to_utf16(lsp_utf16_t *buf, size_t size) const
+    {
+        const ssize_t res = encode_utf16(buf, size);
+        if (res < 0)
+            return NULL;
+        return (size_t(res) < size) ? buf : get_utf16();
+    }
+
+    const char *LSPString::to_native(char *buf, size_t size, const char *charset) const
+    {
+        const ssize_t res = encode_native(buf, size, charset);
+        if (res < 0)
+            return NULL;
+        return (size_t(res) < size) ? buf : get_native(charset);
+    }
+
     size_t LSPString::match(const LSPString *s, size_t index) const
     {
         if (index >= nLength)
@@ -2332,7 +2493,7 @@ namespace lsp
 
         for (; i < n; ++i)
         {
-            if (pData[i] != s->pData[i])
+            if (xdata()[i] != s->xdata()[i])
                 return i;
         }
         return i;
@@ -2346,7 +2507,7 @@ namespace lsp
 
         for (; i < n; ++i)
         {
-            if (lsp::to_lower(pData[i]) != lsp::to_lower(s->pData[i]))
+            if (lsp::to_casefold(xdata()[i]) != lsp::to_casefold(s->xdata()[i]))
                 return i;
         }
         return i;
@@ -2494,22 +2655,14 @@ namespace lsp
 
     size_t LSPString::count(lsp_wchar_t ch) const
     {
-        size_t n = 0;
-        for (size_t i=0; i<nLength; ++i)
-            if (pData[i] == ch)
-                ++n;
-        return n;
+        return wchar_count(xdata(), nLength, ch);
     }
 
     size_t LSPString::count(lsp_wchar_t ch, ssize_t first) const
     {
         XSAFE_TRANS(first, nLength, 0);
 
-        size_t n = 0;
-        for (size_t i=first; i<nLength; ++i)
-            if (pData[i] == ch)
-                ++n;
-        return n;
+        return wchar_count(&xdata()[first], nLength - first, ch);
     }
 
     size_t LSPString::count(lsp_wchar_t ch, ssize_t first, ssize_t last) const
@@ -2517,20 +2670,9 @@ namespace lsp
         XSAFE_TRANS(first, nLength, 0);
         XSAFE_TRANS(last, nLength, 0);
 
-        size_t n = 0;
-        if (first < last)
-        {
-            for (ssize_t i=first; i<last; ++i)
-                if (pData[i] == ch)
-                    ++n;
-        }
-        else
-        {
-            for (ssize_t i=last; i<first; ++i)
-                if (pData[i] == ch)
-                    ++n;
-        }
-        return n;
+        return (first < last) ?
+            wchar_count(&xdata()[first], last - first, ch) :
+            wchar_count(&xdata()[last], first - last, ch);
     }
 
     ssize_t LSPString::fmt_append_native(const char *fmt...)
@@ -2724,16 +2866,12 @@ namespace lsp
 
     size_t LSPString::hash() const
     {
-        if (pData == NULL)
+        if (nLength <= 0)
             return 0;
         else if (nHash != 0)
             return nHash;
 
-        size_t hash = 0;
-        for (size_t i=0; i<nLength; ++i)
-            hash = (hash * 0x10015) ^ pData[i];
-
-        return nHash = hash;
+        return nHash = wchar_hash(xdata(), nLength);
     }
 
     bool LSPString::to_dos()
@@ -2742,9 +2880,9 @@ namespace lsp
         size_t count = 0;
         for (size_t i=0; i<nLength; ++i)
         {
-            if (pData[i] != '\n')
+            if (xdata()[i] != '\n')
                 continue;
-            if ((i == 0) || (pData[i-1] != '\r'))
+            if ((i == 0) || (xdata()[i-1] != '\r'))
                 ++count;
         }
 
@@ -2758,15 +2896,15 @@ namespace lsp
 
         // Now we need to replace all line endings with proper ones
         size_t distance;
-        lsp_wchar_t *dst    = &pData[nLength + count];
-        const lsp_wchar_t *src = &pData[nLength];
+        lsp_wchar_t *dst    = &xdata()[nLength + count];
+        const lsp_wchar_t *src = &xdata()[nLength];
         const lsp_wchar_t *blk;
         nLength            += count;
 
         while (count-- > 0)
         {
             // Find the occurrence
-            for (blk = src-1; blk > pData; --blk)
+            for (blk = src-1; blk > xdata(); --blk)
             {
                 if (*blk != '\n')
                     continue;
@@ -2792,9 +2930,9 @@ namespace lsp
         size_t count = 0;
         for (size_t i=1; i<nLength; ++i)
         {
-            if (pData[i] != '\n')
+            if (xdata()[i] != '\n')
                 continue;
-            if (pData[i-1] == '\r')
+            if (xdata()[i-1] == '\r')
                 ++count;
         }
 
@@ -2805,9 +2943,9 @@ namespace lsp
         nHash                   = 0;
 
         size_t distance;
-        lsp_wchar_t *dst        = pData;
-        const lsp_wchar_t *src  = pData;
-        const lsp_wchar_t *end  = &pData[nLength];
+        lsp_wchar_t *dst        = xdata();
+        const lsp_wchar_t *src  = xdata();
+        const lsp_wchar_t *end  = &xdata()[nLength];
         const lsp_wchar_t *blk;
         nLength                -= count;
 
@@ -2818,7 +2956,7 @@ namespace lsp
             {
                 if (*blk != '\n')
                     continue;
-                if ((blk > pData) && (blk[-1] == '\r'))
+                if ((blk > xdata()) && (blk[-1] == '\r'))
                     break;
             }
 
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/LSPStringView.h>
+#include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+#define XSAFE_TRANS(index, length, result) \
+    if (index < 0) \
+    { \
+        if ((index += (length)) < 0) \
+            return result; \
+    } \
+    else if (size_t(index) > (length)) \
+        return result;
+
+namespace lsp
+{
+    LSPStringView::LSPStringView()
+    {
+        pBuffer     = NULL;
+        nBufCap     = 0;
+    }
+
+    LSPStringView::LSPStringView(const lsp_wchar_t *src, size_t length)
+    {
+        pBuffer     = NULL;
+        nBufCap     = 0;
+        bind(src, length);
+    }
+
+    LSPStringView::LSPStringView(const LSPString *src)
+    {
+        pBuffer     = NULL;
+        nBufCap     = 0;
+        set(src);
+    }
+
+    LSPStringView::LSPStringView(const LSPString *src, ssize_t first)
+    {
+        pBuffer     = NULL;
+        nBufCap     = 0;
+        set(src, first);
+    }
+
+    LSPStringView::LSPStringView(const LSPString *src, ssize_t first, ssize_t last)
+    {
+        pBuffer     = NULL;
+        nBufCap     = 0;
+        set(src, first, last);
+    }
+
+    LSPStringView::~LSPStringView()
+    {
+        // The referenced data is not owned by the view, detach it before LSPString destructor
+        pData       = NULL;
+        nLength     = 0;
+        nCapacity   = 0;
+
+        if (pBuffer != NULL)
+        {
+            ::free(pBuffer);
+            pBuffer     = NULL;
+        }
+        nBufCap     = 0;
+    }
+
+    inline void LSPStringView::bind(const lsp_wchar_t *data, size_t length)
+    {
+        drop_temp();
+        pData       = const_cast<lsp_wchar_t *>(data);
+        nLength     = (data != NULL) ? length : 0;
+        nHash       = 0;
+    }
+
+    lsp_wchar_t *LSPStringView::decode_buffer(size_t size)
+    {
+        if (size <= BUFFER_SIZE)
+            return vBuffer;
+        if (size <= nBufCap)
+            return pBuffer;
+
+        lsp_wchar_t *buf    = static_cast<lsp_wchar_t *>(::malloc(size * sizeof(lsp_wchar_t)));
+        if (buf == NULL)
+            return NULL;
+
+        if (pBuffer != NULL)
+            ::free(pBuffer);
+        pBuffer     = buf;
+        nBufCap     = size;
+
+        return buf;
+    }
+
+    void LSPStringView::set(const lsp_wchar_t *src, size_t length)
+    {
+        bind(src, length);
+    }
+
+    void LSPStringView::set(const LSPString *src)
+    {
+        bind(src->characters(), src->length());
+    }
+
+    bool LSPStringView::set(const LSPString *src, ssize_t first)
+    {
+        const size_t length = src->length();
+        XSAFE_TRANS(first, length, false);
+
+        bind(&src->characters()[first], length - first);
+        return true;
+    }
+
+    bool LSPStringView::set(const LSPString *src, ssize_t first, ssize_t last)
+    {
+        const size_t length = src->length();
+        XSAFE_TRANS(first, length, false);
+        XSAFE_TRANS(last, length, false);
+
+        bind(&src->characters()[first], (last > first) ? last - first : 0);
+        return true;
+    }
+
+    bool LSPStringView::set(const LSPStringView *src, ssize_t first, ssize_t last)
+    {
+        return set(src->string(), first, last);
+    }
+
+    bool LSPStringView::set_utf8(const char *src, size_t length)
+    {
+        // Each byte of UTF-8 sequence produces at most one character
+        lsp_wchar_t *buf    = decode_buffer(length);
+        if (buf == NULL)
+            return false;
+
+        size_t nsrc         = length;
+        size_t ndst         = length;
+        utf8_to_utf32(reinterpret_cast<lsp_utf32_t *>(buf), &ndst, src, &nsrc, true);
+        if (nsrc > 0)
+            return false;
+
+        bind(buf, length - ndst);
+        return true;
+    }
+
+    bool LSPStringView::set_ascii(const char *src, size_t length)
+    {
+        lsp_wchar_t *buf    = decode_buffer(length);
+        if (buf == NULL)
+            return false;
+
+        for (size_t i=0; i<length; ++i)
+            buf[i]              = uint8_t(src[i]);
+
+        bind(buf, length);
+        return true;
+    }
+
+    void LSPStringView::clear()
+    {
+        bind(NULL, 0);
+    }
+
+} /* namespace lsp */
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/SharedString.h>
+#include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#define XSAFE_TRANS(index, length, result) \
+    if (index < 0) \
+    { \
+        if ((index += (length)) < 0) \
+            return result; \
+    } \
+    else if (size_t(index) > (length)) \
+        return result;
+
+namespace lsp
+{
+    SharedString::SharedString()
+    {
+        pShared     = NULL;
+        nHash       = 0;
+    }
+
+    SharedString::~SharedString()
+    {
+        clear();
+    }
+
+    void SharedString::release(shared_t *shared)
+    {
+        if (shared == NULL)
+            return;
+
+        // The last owner releases the memory
+        if (atomic_add(&shared->nReferences, -1) != 1)
+            return;
+
+        if (shared->pData != NULL)
+            free(shared->pData);
+        free(shared);
+    }
+
+    SharedString::shared_t *SharedString::create(lsp_wchar_t *data, size_t length, size_t capacity)
+    {
+        shared_t *shared    = static_cast<shared_t *>(malloc(sizeof(shared_t)));
+        if (shared == NULL)
+            return NULL;
+
+        shared->nReferences = 1;
+        shared->nLength     = length;
+        shared->nCapacity   = capacity;
+        shared->pData       = data;
+
+        return shared;
+    }
+
+    void SharedString::replace(shared_t *shared, size_t hash)
+    {
+        shared_t *old       = pShared;
+        pShared             = shared;
+        nHash               = hash;
+        release(old);
+    }
+
+    bool SharedString::is_shared() const
+    {
+        return (pShared != NULL) && (atomic_load(&pShared->nReferences) > 1);
+    }
+
+    lsp_wchar_t SharedString::at(ssize_t index) const
+    {
+        const size_t len = length();
+        if (index < 0)
+        {
+            if ((index += len) < 0)
+                return 0;
+        }
+        else if (size_t(index) >= len)
+            return 0;
+
+        return pShared->pData[index];
+    }
+
+    size_t SharedString::hash() const
+    {
+        if (pShared == NULL)
+            return 0;
+        else if (nHash != 0)
+            return nHash;
+
+        return nHash = wchar_hash(pShared->pData, pShared->nLength);
+    }
+
+    void SharedString::clear()
+    {
+        replace(NULL, 0);
+    }
+
+    void SharedString::set(const SharedString *src)
+    {
+        if ((src == this) || (src->pShared == pShared))
+            return;
+
+        // Acquire the reference before releasing the current buffer
+        if (src->pShared != NULL)
+            atomic_add(&src->pShared->nReferences, 1);
+        replace(src->pShared, src->nHash);
+    }
+
+    bool SharedString::set(const lsp_wchar_t *arr, size_t n)
+    {
+        if (n <= 0)
+        {
+            clear();
+            return true;
+        }
+
+        lsp_wchar_t *data   = static_cast<lsp_wchar_t *>(malloc(n * sizeof(lsp_wchar_t)));
+        if (data == NULL)
+            return false;
+        memcpy(data, arr, n * sizeof(lsp_wchar_t));
+
+        shared_t *shared    = create(data, n, n);
+        if (shared == NULL)
+        {
+            free(data);
+            return false;
+        }
+
+        replace(shared, 0);
+        return true;
+    }
+
+    bool SharedString::set(const LSPString *src)
+    {
+        return set(src->characters(), src->length());
+    }
+
+    bool SharedString::set(const LSPString *src, ssize_t first)
+    {
+        return set(src, first, src->length());
+    }
+
+    bool SharedString::set(const LSPString *src, ssize_t first, ssize_t last)
+    {
+        XSAFE_TRANS(first, src->length(), false);
+        XSAFE_TRANS(last, src->length(), false);
+
+        if (first >= last)
+        {
+            clear();
+            return true;
+        }
+
+        return set(&src->characters()[first], last - first);
+    }
+
+    bool SharedString::set_utf8(const char *s, size_t n)
+    {
+        LSPString tmp;
+        return (tmp.set_utf8(s, n)) ? take(&tmp) : false;
+    }
+
+    bool SharedString::set_utf8(const char *s)
+    {
+        LSPString tmp;
+        return (tmp.set_utf8(s)) ? take(&tmp) : false;
+    }
+
+    bool SharedString::take(LSPString *src)
+    {
+        // Short strings are stored in the inline buffer and can not be taken
+        if ((src->nLength <= 0) || (src->pData == NULL))
+        {
+            if (!set(src->xdata(), src->nLength))
+                return false;
+            src->clear();
+            return true;
+        }
+
+        shared_t *shared    = create(src->pData, src->nLength, src->nCapacity);
+        if (shared == NULL)
+            return false;
+
+        const size_t hash   = src->nHash;
+        src->drop_temp();
+        src->pData          = NULL;
+        src->nLength        = 0;
+        src->nCapacity      = 0;
+        src->nHash          = 0;
+
+        replace(shared, hash);
+        return true;
+    }
+
+    bool SharedString::get(LSPString *dst) const
+    {
+        if (pShared == NULL)
+        {
+            dst->clear();
+            return true;
+        }
+
+        if (!dst->set(pShared->pData, pShared->nLength))
+            return false;
+        dst->nHash          = nHash;
+        return true;
+    }
+
+    bool SharedString::extract(LSPString *dst)
+    {
+        // Copy the data if the buffer is referenced by other strings
+        if ((pShared == NULL) || (atomic_load(&pShared->nReferences) > 1) || (pShared->nCapacity <= LSPString::INLINE_SIZE))
+        {
+            if (!get(dst))
+                return false;
+            clear();
+            return true;
+        }
+
+        // Pass the buffer to the string
+        dst->truncate();
+        dst->pData          = pShared->pData;
+        dst->nLength        = pShared->nLength;
+        dst->nCapacity      = pShared->nCapacity;
+        dst->nHash          = nHash;
+
+        free(pShared);
+        pShared             = NULL;
+        nHash               = 0;
+
+        return true;
+    }
+
+    void SharedString::view(LSPStringView *dst) const
+    {
+        dst->set(characters(), length());
+    }
+
+    void SharedString::swap(SharedString *dst)
+    {
+        lsp::swap(pShared, dst->pShared);
+        lsp::swap(nHash, dst->nHash);
+    }
+
+    bool SharedString::equals(const SharedString *src) const
+    {
+        if (pShared == src->pShared)
+            return true;
+        if (length() != src->length())
+            return false;
+        if ((nHash != 0) && (src->nHash != 0) && (nHash != src->nHash))
+            return false;
+
+        return memcmp(pShared->pData, src->pShared->pData, pShared->nLength * sizeof(lsp_wchar_t)) == 0;
+    }
+
+    bool SharedString::equals(const LSPString *src) const
+    {
+        if (length() != src->length())
+            return false;
+
+        return (pShared == NULL) || (memcmp(pShared->pData, src->characters(), pShared->nLength * sizeof(lsp_wchar_t)) == 0);
+    }
+
+    int SharedString::compare_to(const SharedString *src) const
+    {
+        if (pShared == src->pShared)
+            return 0;
+
+        LSPStringView a(characters(), length());
+        LSPStringView b(src->characters(), src->length());
+        return a.compare_to(&b);
+    }
+
+    int SharedString::compare_to(const LSPString *src) const
+    {
+        LSPStringView a(characters(), length());
+        return a.compare_to(src);
+    }
+
+} /* namespace lsp */
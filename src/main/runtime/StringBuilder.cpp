@@ -0,0 +1,539 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/StringBuilder.h>
+#include <lsp-plug.in/runtime/number.h>
+#include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#define MIN_CHUNK_SIZE      0x400
+#define MAX_CHUNK_SIZE      0x100000
+#define BUF_SIZE            0x200
+#define MAX_UTF8_CHAR       4
+
+#define XSAFE_TRANS(index, length, result) \
+    if (index < 0) \
+    { \
+        if ((index += (length)) < 0) \
+            return result; \
+    } \
+    else if (size_t(index) > (length)) \
+        return result;
+
+namespace lsp
+{
+    namespace
+    {
+        static const char hex_digits[] = "0123456789abcdef";
+
+        /**
+         * Decode UTF-8 sequence produced by the builder. The sequence is known to be valid
+         * and does not contain split characters, so no validation is performed.
+         */
+        size_t decode_utf8(lsp_wchar_t *dst, size_t ndst, const char **src, const char *end)
+        {
+            const uint8_t *s    = reinterpret_cast<const uint8_t *>(*src);
+            const uint8_t *e    = reinterpret_cast<const uint8_t *>(end);
+            size_t n            = 0;
+
+            while ((n < ndst) && (s < e))
+            {
+                // Fast path for runs of ASCII characters
+                while (((n + 8) <= ndst) && ((s + 8) <= e))
+                {
+                    uint64_t w;
+                    memcpy(&w, s, sizeof(w));
+                    if (w & 0x8080808080808080ULL)
+                        break;
+                    for (size_t i=0; i<8; ++i)
+                        dst[n + i]          = s[i];
+                    n                  += 8;
+                    s                  += 8;
+                }
+                if ((n >= ndst) || (s >= e))
+                    break;
+
+                const lsp_wchar_t c = *(s++);
+                if (c < 0x80)
+                    dst[n++]            = c;
+                else if (c < 0xe0)
+                {
+                    dst[n++]            = ((c & 0x1f) << 6) | (s[0] & 0x3f);
+                    s                  += 1;
+                }
+                else if (c < 0xf0)
+                {
+                    dst[n++]            = ((c & 0x0f) << 12) | ((s[0] & 0x3f) << 6) | (s[1] & 0x3f);
+                    s                  += 2;
+                }
+                else
+                {
+                    dst[n++]            = ((c & 0x07) << 18) | ((s[0] & 0x3f) << 12) | ((s[1] & 0x3f) << 6) | (s[2] & 0x3f);
+                    s                  += 3;
+                }
+            }
+
+            *src                = reinterpret_cast<const char *>(s);
+            return n;
+        }
+    } /* namespace */
+
+    StringBuilder::StringBuilder()
+    {
+        pHead       = NULL;
+        pTail       = NULL;
+        nBytes      = 0;
+        nChars      = 0;
+        nChunkSize  = MIN_CHUNK_SIZE;
+    }
+
+    StringBuilder::~StringBuilder()
+    {
+        truncate();
+    }
+
+    inline char *StringBuilder::chunk_data(chunk_t *chunk)
+    {
+        return reinterpret_cast<char *>(&chunk[1]);
+    }
+
+    inline const char *StringBuilder::chunk_data(const chunk_t *chunk)
+    {
+        return reinterpret_cast<const char *>(&chunk[1]);
+    }
+
+    void StringBuilder::clear()
+    {
+        if (pHead != NULL)
+        {
+            // Keep the first chunk
+            for (chunk_t *c = pHead->pNext; c != NULL; )
+            {
+                chunk_t *next   = c->pNext;
+                free(c);
+                c               = next;
+            }
+
+            pHead->pNext    = NULL;
+            pHead->nSize    = 0;
+            pTail           = pHead;
+        }
+
+        nBytes      = 0;
+        nChars      = 0;
+    }
+
+    void StringBuilder::truncate()
+    {
+        for (chunk_t *c = pHead; c != NULL; )
+        {
+            chunk_t *next   = c->pNext;
+            free(c);
+            c               = next;
+        }
+
+        pHead       = NULL;
+        pTail       = NULL;
+        nBytes      = 0;
+        nChars      = 0;
+        nChunkSize  = MIN_CHUNK_SIZE;
+    }
+
+    void StringBuilder::swap(StringBuilder *dst)
+    {
+        lsp::swap(pHead, dst->pHead);
+        lsp::swap(pTail, dst->pTail);
+        lsp::swap(nBytes, dst->nBytes);
+        lsp::swap(nChars, dst->nChars);
+        lsp::swap(nChunkSize, dst->nChunkSize);
+    }
+
+    char *StringBuilder::reserve(size_t bytes)
+    {
+        // Enough space in the last chunk?
+        if ((pTail != NULL) && ((pTail->nCapacity - pTail->nSize) >= bytes))
+            return &chunk_data(pTail)[pTail->nSize];
+
+        // Allocate new chunk, the size of chunks grows geometrically
+        const size_t capacity   = lsp_max(nChunkSize, bytes);
+        chunk_t *c              = static_cast<chunk_t *>(malloc(sizeof(chunk_t) + capacity));
+        if (c == NULL)
+            return NULL;
+
+        c->pNext                = NULL;
+        c->nSize                = 0;
+        c->nCapacity            = capacity;
+
+        if (pTail != NULL)
+            pTail->pNext            = c;
+        else
+            pHead                   = c;
+        pTail                   = c;
+
+        if (nChunkSize < MAX_CHUNK_SIZE)
+            nChunkSize            <<= 1;
+
+        return chunk_data(c);
+    }
+
+    inline void StringBuilder::commit(size_t bytes, size_t chars)
+    {
+        pTail->nSize           += bytes;
+        nBytes                 += bytes;
+        nChars                 += chars;
+    }
+
+    bool StringBuilder::append_raw(const char *s, size_t count)
+    {
+        while (count > 0)
+        {
+            // Fill the tail of the last chunk, each byte is a separate character
+            char *dst           = reserve(1);
+            if (dst == NULL)
+                return false;
+
+            const size_t n      = lsp_min(pTail->nCapacity - pTail->nSize, count);
+            memcpy(dst, s, n);
+            commit(n, n);
+
+            s                  += n;
+            count              -= n;
+        }
+
+        return true;
+    }
+
+    bool StringBuilder::append(lsp_wchar_t ch)
+    {
+        char *dst           = reserve(MAX_UTF8_CHAR);
+        if (dst == NULL)
+            return false;
+
+        char *p             = dst;
+        write_utf8_codepoint(&p, ch);
+        commit(p - dst, 1);
+
+        return true;
+    }
+
+    bool StringBuilder::append(const lsp_wchar_t *arr, size_t n)
+    {
+        while (n > 0)
+        {
+            // Ensure that at least one character fits into the last chunk
+            char *dst           = reserve(MAX_UTF8_CHAR);
+            if (dst == NULL)
+                return false;
+
+            // Encode characters until the chunk becomes full
+            char *p             = dst;
+            char *end           = &chunk_data(pTail)[pTail->nCapacity - (MAX_UTF8_CHAR - 1)];
+            size_t count        = 0;
+            for ( ; (count < n) && (p < end); ++count)
+            {
+                const lsp_wchar_t ch = arr[count];
+                if (ch < 0x80)
+                    *(p++)              = char(ch);
+                else
+                    write_utf8_codepoint(&p, ch);
+            }
+
+            commit(p - dst, count);
+            arr                += count;
+            n                  -= count;
+        }
+
+        return true;
+    }
+
+    bool StringBuilder::append(const LSPString *src, ssize_t first, ssize_t last)
+    {
+        if (src == NULL)
+            return false;
+
+        XSAFE_TRANS(first, src->length(), false);
+        XSAFE_TRANS(last, src->length(), false);
+        if (first >= last)
+            return true;
+
+        return append(&src->characters()[first], last - first);
+    }
+
+    bool StringBuilder::append_ascii(const char *str, size_t n)
+    {
+        while (n > 0)
+        {
+            // Ensure that at least one character fits into the last chunk
+            char *dst           = reserve(2);
+            if (dst == NULL)
+                return false;
+
+            // Copy characters until the chunk becomes full
+            char *p             = dst;
+            char *end           = &chunk_data(pTail)[pTail->nCapacity - 1];
+            size_t count        = 0;
+            for ( ; (count < n) && (p < end); ++count)
+            {
+                const uint8_t ch    = str[count];
+                if (ch < 0x80)
+                    *(p++)              = char(ch);
+                else
+                {
+                    *(p++)              = char(0xc0 | (ch >> 6));
+                    *(p++)              = char(0x80 | (ch & 0x3f));
+                }
+            }
+
+            commit(p - dst, count);
+            str                += count;
+            n                  -= count;
+        }
+
+        return true;
+    }
+
+    bool StringBuilder::append_ascii(const char *str)
+    {
+        return (str != NULL) ? append_ascii(str, strlen(str)) : false;
+    }
+
+    bool StringBuilder::append_utf8(const char *str, size_t n)
+    {
+        while (n > 0)
+        {
+            // Append the run of ASCII characters as is
+            size_t run = 0;
+            while ((run < n) && (uint8_t(str[run]) < 0x80))
+                ++run;
+            if (!append_raw(str, run))
+                return false;
+            str        += run;
+            n          -= run;
+
+            // Decode and validate the multi-byte sequence
+            if (n > 0)
+            {
+                const lsp_utf32_t cp = read_utf8_streaming(&str, &n, true);
+                if (cp == LSP_UTF32_EOF)
+                    break;
+                if (!append(lsp_wchar_t(cp)))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool StringBuilder::append_utf8(const char *str)
+    {
+        return (str != NULL) ? append_utf8(str, strlen(str)) : false;
+    }
+
+    bool StringBuilder::append_uint(uint64_t value)
+    {
+        char buf[24];
+        char *p = &buf[sizeof(buf)];
+
+        do
+        {
+            *(--p)      = '0' + (value % 10);
+            value      /= 10;
+        } while (value > 0);
+
+        return append_raw(p, &buf[sizeof(buf)] - p);
+    }
+
+    bool StringBuilder::append_int(int64_t value)
+    {
+        char buf[24];
+        char *p = &buf[sizeof(buf)];
+        uint64_t v  = (value < 0) ? uint64_t(0) - uint64_t(value) : uint64_t(value);
+
+        do
+        {
+            *(--p)      = '0' + (v % 10);
+            v          /= 10;
+        } while (v > 0);
+        if (value < 0)
+            *(--p)      = '-';
+
+        return append_raw(p, &buf[sizeof(buf)] - p);
+    }
+
+    bool StringBuilder::append_hex(uint64_t value, size_t digits)
+    {
+        char buf[16];
+        char *p = &buf[sizeof(buf)];
+        digits      = lsp_min(digits, sizeof(buf));
+
+        do
+        {
+            *(--p)      = hex_digits[value & 0x0f];
+            value     >>= 4;
+        } while (value > 0);
+        while (size_t(&buf[sizeof(buf)] - p) < digits)
+            *(--p)      = '0';
+
+        return append_raw(p, &buf[sizeof(buf)] - p);
+    }
+
+    bool StringBuilder::append_double(double value)
+    {
+        char buf[FLOAT_SHORTEST_BUF_SIZE];
+        const size_t len = format_shortest(buf, value);
+        return append_raw(buf, len);
+    }
+
+    bool StringBuilder::append_float(float value)
+    {
+        char buf[FLOAT_SHORTEST_BUF_SIZE];
+        const size_t len = format_shortest(buf, value);
+        return append_raw(buf, len);
+    }
+
+    bool StringBuilder::append_escaped(const LSPString *src, ssize_t first, ssize_t last)
+    {
+        if (src == NULL)
+            return false;
+
+        XSAFE_TRANS(first, src->length(), false);
+        XSAFE_TRANS(last, src->length(), false);
+        if (first >= last)
+            return true;
+
+        const lsp_wchar_t *chars = src->characters();
+        char xb[8];
+        xb[0]       = '\\';
+
+        ssize_t start = first;
+        for (ssize_t i=first; i<last; ++i)
+        {
+            const lsp_wchar_t ch = chars[i];
+            size_t bl = 2;
+
+            switch (ch)
+            {
+                case '\b': xb[1] = 'b'; break;
+                case '\f': xb[1] = 'f'; break;
+                case '\n': xb[1] = 'n'; break;
+                case '\r': xb[1] = 'r'; break;
+                case '\t': xb[1] = 't'; break;
+                case '\\': xb[1] = '\\'; break;
+                case '\"': xb[1] = '\"'; break;
+                default:
+                    if (ch >= 0x20)
+                        continue;
+                    xb[1]   = 'u';
+                    xb[2]   = '0';
+                    xb[3]   = '0';
+                    xb[4]   = hex_digits[(ch >> 4) & 0x0f];
+                    xb[5]   = hex_digits[ch & 0x0f];
+                    bl      = 6;
+                    break;
+            }
+
+            // Emit the pending characters and the escape sequence
+            if (!append(&chars[start], i - start))
+                return false;
+            if (!append_raw(xb, bl))
+                return false;
+            start       = i + 1;
+        }
+
+        return append(&chars[start], last - start);
+    }
+
+    bool StringBuilder::append_to(LSPString *dst) const
+    {
+        if (dst == NULL)
+            return false;
+        if (!dst->reserve(dst->length() + nChars))
+            return false;
+
+        // Characters are never split between chunks, so each chunk is decoded independently
+        lsp_wchar_t buf[BUF_SIZE];
+        for (const chunk_t *c = pHead; c != NULL; c = c->pNext)
+        {
+            const char *src     = chunk_data(c);
+            const char *end     = &src[c->nSize];
+
+            while (src < end)
+            {
+                const size_t count  = decode_utf8(buf, BUF_SIZE, &src, end);
+                if (!dst->append(buf, count))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool StringBuilder::to_string(LSPString *dst) const
+    {
+        if (dst == NULL)
+            return false;
+
+        LSPString tmp;
+        if (!append_to(&tmp))
+            return false;
+
+        dst->swap(&tmp);
+        return true;
+    }
+
+    status_t StringBuilder::write(io::IOutStream *os) const
+    {
+        if (os == NULL)
+            return STATUS_BAD_ARGUMENTS;
+
+        for (const chunk_t *c = pHead; c != NULL; c = c->pNext)
+        {
+            const char *src     = chunk_data(c);
+            for (size_t offset = 0; offset < c->nSize; )
+            {
+                const ssize_t n     = os->write(&src[offset], c->nSize - offset);
+                if (n <= 0)
+                    return (n < 0) ? status_t(-n) : STATUS_IO_ERROR;
+                offset             += n;
+            }
+        }
+
+        return STATUS_OK;
+    }
+
+    ssize_t StringBuilder::copy_utf8(char *dst, size_t size) const
+    {
+        if ((dst == NULL) || (size <= nBytes))
+            return -1;
+
+        char *p = dst;
+        for (const chunk_t *c = pHead; c != NULL; c = c->pNext)
+        {
+            memcpy(p, chunk_data(c), c->nSize);
+            p          += c->nSize;
+        }
+        *p          = '\0';
+
+        return nBytes;
+    }
+
+} /* namespace lsp */
@@ -35,6 +35,7 @@ namespace lsp
             head        = 0;
             length      = 0;
             cap         = 0;
+            depth       = 0;
         }
 
         cbuffer_t::~cbuffer_t()
@@ -141,10 +142,11 @@ namespace lsp
             // We can not find sequence larger than 'length' bytes
             avail               = lsp_min(avail, dmax);
 
-            // Lookup among all matches
+            // Lookup among all matches or limited number of the most recent ones
             uint32_t delta      = length - root[*v];
             const size_t mask   = cap - 1;
-            while (delta <= dmax)
+            size_t budget       = (depth > 0) ? depth : size_t(-1);
+            while ((delta <= dmax) && ((budget--) > 0))
             {
                 // Byte matched, do some heuristics
                 const size_t soff       = (head + cap - delta) & mask;
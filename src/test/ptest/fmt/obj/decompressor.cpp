@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/fmt/obj/Compressor.h>
+#include <lsp-plug.in/fmt/obj/Decompressor.h>
+#include <lsp-plug.in/fmt/obj/IObjHandler.h>
+#include <lsp-plug.in/fmt/obj/PushParser.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+PTEST_BEGIN("runtime.fmt.obj", decompressor, 5, 10)
+
+    status_t compress(io::OutMemoryStream *oms, const char *fname)
+    {
+        io::Path path;
+        if (path.fmt("%s/%s", resources(), fname) <= 0)
+            return STATUS_NO_MEM;
+
+        obj::Compressor c;
+        obj::PushParser p;
+        status_t res    = c.set_buffer_size(7);
+        if (res == STATUS_OK)
+            res             = c.wrap(oms);
+        if (res == STATUS_OK)
+            res             = p.parse_file(&c, &path);
+        return update_status(res, c.close());
+    }
+
+    void call(const char *fname)
+    {
+        io::OutMemoryStream oms;
+        status_t res = compress(&oms, fname);
+        if (res != STATUS_OK)
+            PTEST_FAIL_MSG("Failed to compress file %s, code=%d", fname, int(res));
+
+        char buf[80];
+        snprintf(buf, sizeof(buf), "decompress %s", fname);
+        printf("Testing %s (%d bytes)...\n", buf, int(oms.size()));
+
+        PTEST_LOOP(buf,
+            obj::IObjHandler handler;
+            obj::Decompressor d;
+            if ((res = d.parse_data(&handler, oms.data(), oms.size())) != STATUS_OK)
+                PTEST_FAIL_MSG("Failed to decompress data, code=%d", int(res));
+        );
+    }
+
+    PTEST_MAIN
+    {
+        call("fmt/obj/parking.obj");
+        call("fmt/obj/coliseum.obj");
+        call("fmt/obj/forest.obj");
+        call("fmt/obj/cooling-tower.obj");
+        call("fmt/obj/church.obj");
+    }
+
+PTEST_END
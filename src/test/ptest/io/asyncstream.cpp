@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/Checksum.h>
+#include <lsp-plug.in/io/InAsyncStream.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/ipc/NativeExecutor.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define DATA_SIZE       0x100000
+#define BUF_SIZE        0x10000
+#define PROCESS_PASSES  128
+
+namespace
+{
+    using namespace lsp;
+
+    /**
+     * Memory stream that emulates the latency of the storage device
+     */
+    class SlowStream: public io::InMemoryStream
+    {
+        public:
+            explicit SlowStream(const void *data, size_t size): io::InMemoryStream(data, size) {}
+
+        public:
+            virtual ssize_t read(void *dst, size_t count) override
+            {
+                ipc::Thread::sleep(1);
+                return io::InMemoryStream::read(dst, (count > BUF_SIZE) ? BUF_SIZE : count);
+            }
+    };
+}
+
+PTEST_BEGIN("runtime.io", asyncstream, 5, 100)
+
+    void init_data(uint8_t *dst, size_t count)
+    {
+        uint32_t seed = 0x12345678;
+        for (size_t i=0; i<count; ++i)
+        {
+            seed        = seed * 1664525 + 1013904223;
+            dst[i]      = uint8_t(seed >> 24);
+        }
+    }
+
+    uint64_t process(io::IInStream *is, uint8_t *buf)
+    {
+        uint64_t sum = 0;
+        while (true)
+        {
+            const ssize_t n = is->read(buf, BUF_SIZE);
+            if (n <= 0)
+                break;
+
+            // Emulate the processing of data by the consumer
+            for (size_t i=0; i<PROCESS_PASSES; ++i)
+                sum        += io::xxh64(buf, n, i);
+        }
+        return sum;
+    }
+
+    uint64_t process_sync(const uint8_t *data, uint8_t *buf)
+    {
+        SlowStream ss(data, DATA_SIZE);
+        return process(&ss, buf);
+    }
+
+    uint64_t process_async(const uint8_t *data, uint8_t *buf, ipc::IExecutor *executor, size_t depth)
+    {
+        SlowStream ss(data, DATA_SIZE);
+        io::InAsyncStream as(executor);
+        if (as.wrap(&ss, 0, depth, BUF_SIZE) != STATUS_OK)
+            return 0;
+        return process(&as, buf);
+    }
+
+    PTEST_MAIN
+    {
+        uint8_t *data   = static_cast<uint8_t *>(malloc(DATA_SIZE + BUF_SIZE));
+        if (data == NULL)
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally { free(data); };
+        uint8_t *buf    = &data[DATA_SIZE];
+        init_data(data, DATA_SIZE);
+
+        ipc::NativeExecutor executor;
+        if (executor.start() != STATUS_OK)
+            PTEST_FAIL_MSG("Could not start executor");
+        lsp_finally { executor.shutdown(); };
+
+        char key[80];
+        uint64_t sum = 0;
+
+        printf("Testing sync read...\n");
+        PTEST_LOOP("sync",
+            sum += process_sync(data, buf);
+        );
+
+        PTEST_SEPARATOR;
+
+        static const size_t depths[] = { 1, 2, 4 };
+        for (size_t i=0; i<sizeof(depths)/sizeof(depths[0]); ++i)
+        {
+            snprintf(key, sizeof(key), "async thread depth=%d", int(depths[i]));
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key,
+                sum += process_async(data, buf, NULL, depths[i]);
+            );
+
+            snprintf(key, sizeof(key), "async executor depth=%d", int(depths[i]));
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key,
+                sum += process_async(data, buf, &executor, depths[i]);
+            );
+        }
+
+        printf("Checksum: %llx\n", (unsigned long long)sum);
+    }
+
+PTEST_END
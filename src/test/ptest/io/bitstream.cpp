@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InBitStream.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/io/OutBitStream.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define NUM_VALUES      0x10000
+
+PTEST_BEGIN("runtime.io", bitstream, 5, 100)
+
+    void init_values(uint32_t *dst, size_t count)
+    {
+        uint32_t seed = 0x12345678;
+        for (size_t i=0; i<count; ++i)
+        {
+            seed        = seed * 1664525 + 1013904223;
+            dst[i]      = (seed >> 8) >> (seed & 0x0f);
+        }
+    }
+
+    void read_scalar(const io::OutMemoryStream *oms, uint32_t *dst, size_t count, size_t bits)
+    {
+        io::InMemoryStream ims(oms->data(), oms->size());
+        io::InBitStream ibs;
+        ibs.wrap(&ims, WRAP_NONE);
+        for (size_t i=0; i<count; ++i)
+            ibs.readv(&dst[i], bits);
+        ibs.close();
+    }
+
+    void read_bulk(const io::OutMemoryStream *oms, uint32_t *dst, size_t count, size_t bits)
+    {
+        io::InMemoryStream ims(oms->data(), oms->size());
+        io::InBitStream ibs;
+        ibs.wrap(&ims, WRAP_NONE);
+        ibs.readn(dst, count, bits);
+        ibs.close();
+    }
+
+    void read_varint_scalar(const io::OutMemoryStream *oms, uint32_t *dst, size_t count, size_t bits, size_t step)
+    {
+        io::InMemoryStream ims(oms->data(), oms->size());
+        io::InBitStream ibs;
+        ibs.wrap(&ims, WRAP_NONE);
+        for (size_t i=0; i<count; ++i)
+        {
+            // Decode variable-length integer by groups
+            uint32_t value = 0, b = 0;
+            size_t shift = 0, width = bits;
+            while (ibs.readv(&b, width + 1) > 0)
+            {
+                value      |= (b & ((1 << width) - 1)) << shift;
+                if (!(b >> width))
+                    break;
+                shift      += width;
+                width      += step;
+            }
+            dst[i]      = value;
+        }
+        ibs.close();
+    }
+
+    void read_varint_bulk(const io::OutMemoryStream *oms, uint32_t *dst, size_t count, size_t bits, size_t step)
+    {
+        io::InMemoryStream ims(oms->data(), oms->size());
+        io::InBitStream ibs;
+        ibs.wrap(&ims, WRAP_NONE);
+        ibs.readvar(dst, count, bits, step);
+        ibs.close();
+    }
+
+    PTEST_MAIN
+    {
+        uint32_t *src       = static_cast<uint32_t *>(malloc(NUM_VALUES * sizeof(uint32_t) * 2));
+        if (src == NULL)
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally { free(src); };
+        uint32_t *dst       = &src[NUM_VALUES];
+        init_values(src, NUM_VALUES);
+
+        char buf[80];
+
+        // Fixed-width values
+        for (size_t bits = 5; bits <= 32; bits += 9)
+        {
+            io::OutMemoryStream oms;
+            io::OutBitStream obs;
+            obs.wrap(&oms, WRAP_NONE);
+            obs.writen(src, NUM_VALUES, bits);
+            obs.close();
+
+            snprintf(buf, sizeof(buf), "readv x%d bits", int(bits));
+            printf("Testing %s...\n", buf);
+            PTEST_LOOP(buf,
+                read_scalar(&oms, dst, NUM_VALUES, bits);
+            );
+
+            snprintf(buf, sizeof(buf), "readn x%d bits", int(bits));
+            printf("Testing %s...\n", buf);
+            PTEST_LOOP(buf,
+                read_bulk(&oms, dst, NUM_VALUES, bits);
+            );
+
+            PTEST_SEPARATOR;
+        }
+
+        // Variable-length integers
+        static const size_t varint_params[] = { 6, 0, 3, 2 };
+        for (size_t i=0; i<sizeof(varint_params)/sizeof(size_t); i += 2)
+        {
+            const size_t bits   = varint_params[i];
+            const size_t step   = varint_params[i + 1];
+
+            io::OutMemoryStream oms;
+            io::OutBitStream obs;
+            obs.wrap(&oms, WRAP_NONE);
+            obs.writevar(src, NUM_VALUES, bits, step);
+            obs.close();
+
+            snprintf(buf, sizeof(buf), "varint groups bits=%d step=%d", int(bits), int(step));
+            printf("Testing %s...\n", buf);
+            PTEST_LOOP(buf,
+                read_varint_scalar(&oms, dst, NUM_VALUES, bits, step);
+            );
+
+            snprintf(buf, sizeof(buf), "readvar bits=%d step=%d", int(bits), int(step));
+            printf("Testing %s...\n", buf);
+            PTEST_LOOP(buf,
+                read_varint_bulk(&oms, dst, NUM_VALUES, bits, step);
+            );
+
+            if (memcmp(src, dst, NUM_VALUES * sizeof(uint32_t)) != 0)
+                PTEST_FAIL_MSG("Decoded values differ");
+
+            PTEST_SEPARATOR;
+        }
+    }
+
+PTEST_END
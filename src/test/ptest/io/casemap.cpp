@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define TEXT_SIZE       0x10000
+#define KEYS_COUNT      64
+
+namespace
+{
+    static const lsp::lsp_wchar_t greek[] =
+    {
+        0x0391, 0x0392, 0x0393, 0x0394, 0x0395, 0x0396, 0x0397, 0x0398,
+        0x03b1, 0x03b2, 0x03b3, 0x03b4, 0x03b5, 0x03b6, 0x03b7, 0x03c2
+    };
+
+    static const lsp::lsp_wchar_t cjk[] =
+    {
+        0x4e00, 0x4e2d, 0x6587, 0x5b57, 0x3042, 0x30a2, 0xac00, 0xd55c
+    };
+}
+
+PTEST_BEGIN("runtime.io", casemap, 5, 1000)
+
+    void init_text(lsp_wchar_t *dst, size_t count, const lsp_wchar_t *extra, size_t nextra)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            // Put a non-ASCII character approximately to each 8th position
+            if ((extra != NULL) && ((i * 0x9e3779b1) & 0x70000000) == 0)
+                dst[i]      = extra[i % nextra];
+            else
+                dst[i]      = ((i % 7) == 0) ? 'A' + (i % 26) : 'a' + (i % 26);
+        }
+    }
+
+    void call(const char *label, const lsp_wchar_t *text)
+    {
+        char name[80];
+        lsp_wchar_t sum = 0;
+
+        snprintf(name, sizeof(name), "%s to_lower", label);
+        printf("Testing %s...\n", name);
+        PTEST_LOOP(name,
+            for (size_t i=0; i<TEXT_SIZE; ++i)
+                sum    += lsp::to_lower(text[i]);
+        );
+
+        snprintf(name, sizeof(name), "%s to_upper", label);
+        printf("Testing %s...\n", name);
+        PTEST_LOOP(name,
+            for (size_t i=0; i<TEXT_SIZE; ++i)
+                sum    += lsp::to_upper(text[i]);
+        );
+
+        snprintf(name, sizeof(name), "%s to_casefold", label);
+        printf("Testing %s...\n", name);
+        PTEST_LOOP(name,
+            for (size_t i=0; i<TEXT_SIZE; ++i)
+                sum    += lsp::to_casefold(text[i]);
+        );
+
+        printf("Checksum: 0x%x\n", int(sum));
+        PTEST_SEPARATOR;
+    }
+
+    void call_lookup()
+    {
+        LSPString keys[KEYS_COUNT], queries[KEYS_COUNT];
+        for (size_t i=0; i<KEYS_COUNT; ++i)
+        {
+            if (!keys[i].fmt_utf8("parameter_%d_Σχήμα_%d", int(i * 7), int(i)))
+                PTEST_FAIL_MSG("Out of memory");
+            if (!queries[i].set(&keys[(i * 37) % KEYS_COUNT]))
+                PTEST_FAIL_MSG("Out of memory");
+            queries[i].toupper();
+        }
+
+        size_t found = 0;
+        PTEST_LOOP("nocase key lookup",
+            for (size_t i=0; i<KEYS_COUNT; ++i)
+                for (size_t j=0; j<KEYS_COUNT; ++j)
+                    if (keys[j].equals_nocase(&queries[i]))
+                    {
+                        ++found;
+                        break;
+                    }
+        );
+
+        if ((found % KEYS_COUNT) != 0)
+            PTEST_FAIL_MSG("Not all keys have been found");
+
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        lsp_wchar_t *text   = static_cast<lsp_wchar_t *>(malloc(TEXT_SIZE * sizeof(lsp_wchar_t)));
+        if (text == NULL)
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally {
+            free(text);
+        };
+
+        init_text(text, TEXT_SIZE, NULL, 0);
+        call("ascii", text);
+
+        init_text(text, TEXT_SIZE, greek, sizeof(greek)/sizeof(greek[0]));
+        call("greek", text);
+
+        init_text(text, TEXT_SIZE, cjk, sizeof(cjk)/sizeof(cjk[0]));
+        call("cjk", text);
+
+        call_lookup();
+    }
+
+PTEST_END
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/io/CharsetDecoder.h>
+#include <lsp-plug.in/io/CharsetEncoder.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define TEXT_SIZE       0x10000
+#define BUF_SIZE        0x4000
+
+namespace
+{
+    static const lsp::lsp_wchar_t cyrillic[] =
+    {
+        0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417,
+        0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437
+    };
+}
+
+PTEST_BEGIN("runtime.io", charset, 5, 1000)
+
+    void init_text(lsp_wchar_t *dst, size_t count, bool ascii)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            // Put a non-ASCII character approximately to each 8th position
+            if ((!ascii) && ((i * 0x9e3779b1) & 0x70000000) == 0)
+                dst[i]      = cyrillic[i % (sizeof(cyrillic) / sizeof(cyrillic[0]))];
+            else
+                dst[i]      = ((i % 61) == 60) ? '\n' : 'a' + (i % 26);
+        }
+    }
+
+    size_t encode(io::CharsetEncoder *enc, uint8_t *dst, const lsp_wchar_t *src, size_t count)
+    {
+        size_t processed = 0, written = 0;
+        while (true)
+        {
+            const ssize_t n = enc->fetch(&dst[written], BUF_SIZE);
+            if (n > 0)
+            {
+                written    += n;
+                continue;
+            }
+            if (processed >= count)
+                break;
+
+            const ssize_t filled = enc->fill(&src[processed], count - processed);
+            if (filled <= 0)
+                break;
+            processed  += filled;
+        }
+
+        return written;
+    }
+
+    size_t decode(io::CharsetDecoder *dec, lsp_wchar_t *dst, const uint8_t *src, size_t count)
+    {
+        size_t processed = 0, decoded = 0;
+        while (true)
+        {
+            const ssize_t n = dec->fetch(&dst[decoded], BUF_SIZE);
+            if (n > 0)
+            {
+                decoded    += n;
+                continue;
+            }
+            if (processed >= count)
+                break;
+
+            const ssize_t filled = dec->fill(&src[processed], count - processed);
+            if (filled <= 0)
+                break;
+            processed  += filled;
+        }
+
+        return decoded;
+    }
+
+    void call(const char *label, const char *charset, const lsp_wchar_t *text, lsp_wchar_t *out, uint8_t *bytes)
+    {
+        io::CharsetEncoder enc;
+        io::CharsetDecoder dec;
+        if ((enc.init(charset) != STATUS_OK) || (dec.init(charset) != STATUS_OK))
+        {
+            printf("Character set %s is not supported, skipping\n", charset);
+            return;
+        }
+
+        char buf[80];
+        size_t nbytes = 0, nchars = 0;
+
+        snprintf(buf, sizeof(buf), "%s encode %s", label, charset);
+        printf("Testing %s...\n", buf);
+        PTEST_LOOP(buf,
+            nbytes = encode(&enc, bytes, text, TEXT_SIZE);
+        );
+
+        snprintf(buf, sizeof(buf), "%s decode %s", label, charset);
+        printf("Testing %s...\n", buf);
+        PTEST_LOOP(buf,
+            nchars = decode(&dec, out, bytes, nbytes);
+        );
+
+        if ((nchars != TEXT_SIZE) || (memcmp(text, out, TEXT_SIZE * sizeof(lsp_wchar_t)) != 0))
+            PTEST_FAIL_MSG("Round-trip conversion for %s has failed", charset);
+
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        lsp_wchar_t *text   = static_cast<lsp_wchar_t *>(malloc(TEXT_SIZE * sizeof(lsp_wchar_t) * 2));
+        uint8_t *bytes      = static_cast<uint8_t *>(malloc(TEXT_SIZE * sizeof(lsp_utf32_t)));
+        if ((text == NULL) || (bytes == NULL))
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally {
+            free(text);
+            free(bytes);
+        };
+        lsp_wchar_t *out    = &text[TEXT_SIZE];
+
+        // Built-in codecs
+        init_text(text, TEXT_SIZE, true);
+        call("ascii", "US-ASCII", text, out, bytes);
+        call("ascii", "UTF-8", text, out, bytes);
+        call("ascii", "ISO-8859-1", text, out, bytes);
+
+        init_text(text, TEXT_SIZE, false);
+        call("mixed", "UTF-8", text, out, bytes);
+        call("mixed", "CP1251", text, out, bytes);
+        call("mixed", "UTF-16LE", text, out, bytes);
+    }
+
+PTEST_END
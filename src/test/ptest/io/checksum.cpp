@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/Checksum.h>
+#include <lsp-plug.in/io/File.h>
+#include <lsp-plug.in/io/InChecksumStream.h>
+#include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/io/OutFileStream.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define DATA_SIZE       0x400000
+#define BUF_SIZE        0x10000
+
+namespace
+{
+    static const lsp::io::checksum_kernel_t kernels[] =
+    {
+        lsp::io::CHECKSUM_KERNEL_GENERIC,
+        lsp::io::CHECKSUM_KERNEL_SSE42,
+        lsp::io::CHECKSUM_KERNEL_ARMV8
+    };
+
+    static const char *kernel_names[] =
+    {
+        "generic",
+        "sse4.2",
+        "armv8"
+    };
+}
+
+PTEST_BEGIN("runtime.io", checksum, 5, 100)
+
+    void init_data(uint8_t *dst, size_t count)
+    {
+        uint32_t seed = 0x12345678;
+        for (size_t i=0; i<count; ++i)
+        {
+            seed        = seed * 1664525 + 1013904223;
+            dst[i]      = uint8_t(seed >> 24);
+        }
+    }
+
+    wssize_t read_file(const LSPString *path, uint8_t *buf, io::checksum_t type, bool checksum)
+    {
+        io::InFileStream ifs;
+        if (ifs.open(path) != STATUS_OK)
+            return -1;
+
+        io::InChecksumStream cs(type);
+        io::IInStream *is = &ifs;
+        if (checksum)
+        {
+            cs.wrap(&ifs);
+            is  = &cs;
+        }
+
+        wssize_t total = 0;
+        while (true)
+        {
+            const ssize_t n = is->read(buf, BUF_SIZE);
+            if (n <= 0)
+                break;
+            total      += n;
+        }
+
+        cs.close();
+        ifs.close();
+
+        return total;
+    }
+
+    PTEST_MAIN
+    {
+        uint8_t *data   = static_cast<uint8_t *>(malloc(DATA_SIZE + BUF_SIZE));
+        if (data == NULL)
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally { free(data); };
+        uint8_t *buf    = &data[DATA_SIZE];
+        init_data(data, DATA_SIZE);
+
+        // Raw checksum computation
+        char key[80];
+        uint64_t sum = 0;
+        for (size_t k=0; k<sizeof(kernels)/sizeof(kernels[0]); ++k)
+        {
+            if (io::select_checksum_kernel(kernels[k]) != STATUS_OK)
+            {
+                printf("Checksum kernel %s is not supported, skipping\n", kernel_names[k]);
+                continue;
+            }
+
+            snprintf(key, sizeof(key), "crc32 %s", kernel_names[k]);
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key,
+                sum += io::crc32(0, data, DATA_SIZE);
+            );
+
+            snprintf(key, sizeof(key), "crc32c %s", kernel_names[k]);
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key,
+                sum += io::crc32c(0, data, DATA_SIZE);
+            );
+        }
+        io::select_checksum_kernel(io::CHECKSUM_KERNEL_AUTO);
+
+        printf("Testing xxh64...\n");
+        PTEST_LOOP("xxh64",
+            sum += io::xxh64(data, DATA_SIZE);
+        );
+
+        PTEST_SEPARATOR;
+
+        // Checksum computation layered on file stream
+        LSPString path;
+        if (!path.fmt_utf8("%s/ptest-%s.bin", tempdir(), full_name()))
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally { io::File::remove(&path); };
+
+        io::OutFileStream ofs;
+        if ((ofs.open(&path, io::File::FM_WRITE_NEW) != STATUS_OK) ||
+            (ofs.write(data, DATA_SIZE) != DATA_SIZE) ||
+            (ofs.close() != STATUS_OK))
+            PTEST_FAIL_MSG("Could not write file %s", path.get_native());
+
+        wssize_t total = 0;
+
+        printf("Testing file read...\n");
+        PTEST_LOOP("file read",
+            total += read_file(&path, buf, io::CHECKSUM_CRC32C, false);
+        );
+
+        printf("Testing file read crc32...\n");
+        PTEST_LOOP("file read crc32",
+            total += read_file(&path, buf, io::CHECKSUM_CRC32, true);
+        );
+
+        printf("Testing file read crc32c...\n");
+        PTEST_LOOP("file read crc32c",
+            total += read_file(&path, buf, io::CHECKSUM_CRC32C, true);
+        );
+
+        printf("Testing file read xxh64...\n");
+        PTEST_LOOP("file read xxh64",
+            total += read_file(&path, buf, io::CHECKSUM_XXH64, true);
+        );
+
+        printf("Checksum: %llx, bytes read: %lld\n", (unsigned long long)sum, (long long)total);
+    }
+
+PTEST_END
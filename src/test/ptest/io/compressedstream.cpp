@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InCompressedStream.h>
+#include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/io/OutCompressedStream.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define RANDOM_SIZE     0x100000
+#define BUF_SIZE        0x10000
+
+namespace
+{
+    static const char *files[] =
+    {
+        "compressor/3d/forest.obj",
+        "fmt/hydrogen/roland-mc-307-tr-909.xml",
+        "fmt/lspc/drumkit/data/Stick/Stick-0.wav",
+        NULL
+    };
+
+    static const size_t log_blocks[] = { 12, 16, 20 };
+}
+
+PTEST_BEGIN("runtime.io", compressedstream, 5, 20)
+
+    bool load_file(io::OutMemoryStream *dst, const char *name)
+    {
+        LSPString path;
+        if (!path.fmt_utf8("%s/%s", resources(), name))
+            return false;
+
+        io::InFileStream is;
+        if (is.open(&path) != STATUS_OK)
+            return false;
+        lsp_finally { is.close(); };
+
+        return is.sink(dst) >= 0;
+    }
+
+    void compress(io::OutMemoryStream *dst, const uint8_t *src, size_t count, size_t log_block)
+    {
+        io::OutCompressedStream os(log_block);
+        dst->clear();
+        os.wrap(dst);
+        os.write(src, count);
+        os.close();
+    }
+
+    size_t decompress(const io::OutMemoryStream *src, uint8_t *buf)
+    {
+        io::InMemoryStream ims(src->data(), src->size());
+        io::InCompressedStream is;
+        is.wrap(&ims);
+
+        size_t total = 0;
+        while (true)
+        {
+            const ssize_t n = is.read(buf, BUF_SIZE);
+            if (n <= 0)
+                break;
+            total      += n;
+        }
+        is.close();
+
+        return total;
+    }
+
+    void call(const char *label, const uint8_t *data, size_t size, uint8_t *buf)
+    {
+        char key[80];
+        io::OutMemoryStream oms;
+
+        for (size_t log_block: log_blocks)
+        {
+            snprintf(key, sizeof(key), "%s compress block=%d", label, int(1 << log_block));
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key,
+                compress(&oms, data, size, log_block);
+            );
+
+            printf("Compression ratio: %d -> %d bytes (%.2f%%)\n",
+                int(size), int(oms.size()), (oms.size() * 100.0) / size);
+
+            snprintf(key, sizeof(key), "%s decompress block=%d", label, int(1 << log_block));
+            printf("Testing %s...\n", key);
+            size_t total = 0;
+            PTEST_LOOP(key,
+                total = decompress(&oms, buf);
+            );
+
+            if (total != size)
+                PTEST_FAIL_MSG("Decompressed %d bytes, expected %d", int(total), int(size));
+        }
+
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        uint8_t *buf    = static_cast<uint8_t *>(malloc(BUF_SIZE + RANDOM_SIZE));
+        if (buf == NULL)
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally { free(buf); };
+
+        // Test data from resources
+        for (const char * const *name = files; *name != NULL; ++name)
+        {
+            io::OutMemoryStream data;
+            if (!load_file(&data, *name))
+                PTEST_FAIL_MSG("Could not load file %s", *name);
+
+            call(*name, data.data(), data.size(), buf);
+        }
+
+        // Incompressible data
+        uint8_t *rnd    = &buf[BUF_SIZE];
+        uint32_t seed   = 0x12345678;
+        for (size_t i=0; i<RANDOM_SIZE; ++i)
+        {
+            seed            = seed * 1664525 + 1013904223;
+            rnd[i]          = uint8_t(seed >> 24);
+        }
+        call("random", rnd, RANDOM_SIZE, buf);
+    }
+
+PTEST_END
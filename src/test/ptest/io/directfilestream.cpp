@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/AlignedBufferPool.h>
+#include <lsp-plug.in/io/File.h>
+#include <lsp-plug.in/io/InDirectFileStream.h>
+#include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/io/OutDirectFileStream.h>
+#include <lsp-plug.in/io/OutFileStream.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define DATA_SIZE       0x1000000
+#define CHUNK_SIZE      0x10000
+
+PTEST_BEGIN("runtime.io", directfilestream, 5, 20)
+
+    wssize_t write_file(io::IOutStream *os, const uint8_t *data)
+    {
+        wssize_t total = 0;
+        for (size_t off=0; off < DATA_SIZE; off += CHUNK_SIZE)
+        {
+            const ssize_t n = os->write(&data[off], CHUNK_SIZE);
+            if (n <= 0)
+                break;
+            total      += n;
+        }
+        os->close();
+        return total;
+    }
+
+    wssize_t read_file(io::IInStream *is, uint8_t *buf)
+    {
+        wssize_t total = 0;
+        while (true)
+        {
+            const ssize_t n = is->read(buf, CHUNK_SIZE);
+            if (n <= 0)
+                break;
+            total      += n;
+        }
+        is->close();
+        return total;
+    }
+
+    PTEST_MAIN
+    {
+        uint8_t *data   = static_cast<uint8_t *>(malloc(DATA_SIZE + CHUNK_SIZE));
+        if (data == NULL)
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally { free(data); };
+        uint8_t *buf    = &data[DATA_SIZE];
+
+        uint32_t seed   = 0x12345678;
+        for (size_t i=0; i<DATA_SIZE; ++i)
+        {
+            seed            = seed * 1664525 + 1013904223;
+            data[i]         = uint8_t(seed >> 24);
+        }
+
+        LSPString path;
+        if (!path.fmt_utf8("%s/ptest-%s.bin", tempdir(), full_name()))
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally { io::File::remove(&path); };
+
+        io::AlignedBufferPool pool;
+        wssize_t total = 0;
+
+        printf("Testing buffered write...\n");
+        PTEST_LOOP("buffered write",
+            io::OutFileStream os;
+            if (os.open(&path, io::File::FM_WRITE_NEW) == STATUS_OK)
+                total  += write_file(&os, data);
+        );
+
+        printf("Testing direct write...\n");
+        PTEST_LOOP("direct write",
+            io::OutDirectFileStream os(&pool);
+            if (os.open(&path) == STATUS_OK)
+                total  += write_file(&os, data);
+        );
+
+        PTEST_SEPARATOR;
+
+        printf("Testing buffered read...\n");
+        PTEST_LOOP("buffered read",
+            io::InFileStream is;
+            if (is.open(&path) == STATUS_OK)
+                total  += read_file(&is, buf);
+        );
+
+        printf("Testing direct read...\n");
+        PTEST_LOOP("direct read",
+            io::InDirectFileStream is(&pool);
+            if (is.open(&path) == STATUS_OK)
+                total  += read_file(&is, buf);
+        );
+
+        printf("Bytes transferred: %lld\n", (long long)total);
+    }
+
+PTEST_END
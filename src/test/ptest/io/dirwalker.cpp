@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/io/Dir.h>
+#include <lsp-plug.in/io/DirWalker.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define NUM_DIRS        16
+#define NUM_SUBDIRS     16
+#define NUM_FILES       32
+
+namespace
+{
+    using namespace lsp;
+
+    class CountingHandler: public io::IDirWalkHandler
+    {
+        public:
+            atomic_t    nEntries;
+
+        public:
+            CountingHandler()
+            {
+                nEntries    = 0;
+            }
+
+            virtual status_t on_entry(const io::dir_entry_t *entry) override
+            {
+                atomic_add(&nEntries, 1);
+                return STATUS_OK;
+            }
+    };
+}
+
+PTEST_BEGIN("runtime.io", dirwalker, 5, 10)
+
+    void create_tree(const io::Path *root)
+    {
+        char name[32];
+        io::Path dir, sub, file;
+        io::NativeFile fd;
+
+        if (root->mkdir(true) != STATUS_OK)
+            PTEST_FAIL_MSG("Could not create directory %s", root->as_native());
+
+        for (size_t i=0; i<NUM_DIRS; ++i)
+        {
+            snprintf(name, sizeof(name), "dir-%d", int(i));
+            if ((dir.set(root, name) != STATUS_OK) || (dir.mkdir(true) != STATUS_OK))
+                PTEST_FAIL_MSG("Could not create directory %s", dir.as_native());
+
+            for (size_t j=0; j<NUM_SUBDIRS; ++j)
+            {
+                snprintf(name, sizeof(name), "sub-%d", int(j));
+                if ((sub.set(&dir, name) != STATUS_OK) || (sub.mkdir(true) != STATUS_OK))
+                    PTEST_FAIL_MSG("Could not create directory %s", sub.as_native());
+
+                for (size_t k=0; k<NUM_FILES; ++k)
+                {
+                    snprintf(name, sizeof(name), "file-%d.dat", int(k));
+                    if ((file.set(&sub, name) != STATUS_OK) ||
+                        (fd.open(&file, io::File::FM_WRITE_NEW) != STATUS_OK))
+                        PTEST_FAIL_MSG("Could not create file %s", file.as_native());
+                    fd.close();
+                }
+            }
+        }
+    }
+
+    size_t dir_walk(const io::Path *path)
+    {
+        io::Dir dir;
+        io::Path child;
+        io::fattr_t attr;
+        LSPString name;
+        size_t count = 0;
+
+        if (dir.open(path) != STATUS_OK)
+            return 0;
+
+        while (dir.reads(&name, &attr, false) == STATUS_OK)
+        {
+            if (io::Path::is_dots(&name))
+                continue;
+
+            ++count;
+            if (attr.type != io::fattr_t::FT_DIRECTORY)
+                continue;
+            if (child.set(path, &name) == STATUS_OK)
+                count      += dir_walk(&child);
+        }
+        dir.close();
+
+        return count;
+    }
+
+    size_t walker_walk(const io::Path *path, size_t threads, size_t flags)
+    {
+        io::DirWalker w;
+        CountingHandler h;
+
+        w.set_threads(threads);
+        w.set_flags(flags);
+        if (w.walk(path, &h) != STATUS_OK)
+            return 0;
+
+        return h.nEntries;
+    }
+
+    PTEST_MAIN
+    {
+        static constexpr size_t NUM_ENTRIES = NUM_DIRS * (1 + NUM_SUBDIRS * (1 + NUM_FILES));
+
+        io::Path root;
+        if (root.fmt("%s/ptest-%s", tempdir(), full_name()) <= 0)
+            PTEST_FAIL_MSG("Could not format path");
+        create_tree(&root);
+
+        const size_t cores = ipc::Thread::system_cores();
+        size_t count = 0;
+        char buf[80];
+
+        printf("Testing io::Dir recursive loop...\n");
+        PTEST_LOOP("io::Dir",
+            count = dir_walk(&root);
+        );
+        if (count != NUM_ENTRIES)
+            PTEST_FAIL_MSG("Invalid number of entries: %d, expected %d", int(count), int(NUM_ENTRIES));
+
+        printf("Testing io::DirWalker single-threaded...\n");
+        PTEST_LOOP("DirWalker x1",
+            count = walker_walk(&root, 1, io::DirWalker::WALK_NONE);
+        );
+        if (count != NUM_ENTRIES)
+            PTEST_FAIL_MSG("Invalid number of entries: %d, expected %d", int(count), int(NUM_ENTRIES));
+
+        printf("Testing io::DirWalker single-threaded with stat...\n");
+        PTEST_LOOP("DirWalker x1 stat",
+            count = walker_walk(&root, 1, io::DirWalker::WALK_STAT);
+        );
+        if (count != NUM_ENTRIES)
+            PTEST_FAIL_MSG("Invalid number of entries: %d, expected %d", int(count), int(NUM_ENTRIES));
+
+        snprintf(buf, sizeof(buf), "DirWalker x%d", int(cores));
+        printf("Testing io::DirWalker with %d threads...\n", int(cores));
+        PTEST_LOOP(buf,
+            count = walker_walk(&root, 0, io::DirWalker::WALK_NONE);
+        );
+        if (count != NUM_ENTRIES)
+            PTEST_FAIL_MSG("Invalid number of entries: %d, expected %d", int(count), int(NUM_ENTRIES));
+    }
+
+PTEST_END
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/PathPattern.h>
+#include <lsp-plug.in/io/PathPatternSet.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define NUM_PATHS       0x1000
+
+namespace
+{
+    using namespace lsp;
+
+    static const char *patterns[] =
+    {
+        "*.c|*.h",
+        "*.cpp|*.hpp|*.cc",
+        "**/test/**/*.log",
+        "**/.git/**",
+        "**/((*.c|*.h)&(!test-*))",
+        "**/build/**",
+        "*.o|*.a|*.so",
+        "file*(!test)*.dat",
+        "!(README)&*.md",
+        "**/src/**/module-1*/**",
+        "*~",
+        "*.tmp|*.bak",
+        NULL
+    };
+
+    static const char *dirs[] =
+    {
+        "prj/src", "prj/include", "prj/test/logs", "prj/.git/objects",
+        "prj/build/release", "prj/src/module-13/impl", "prj/doc", "home/user/work"
+    };
+
+    static const char *files[] =
+    {
+        "main.c", "main.h", "test-main.c", "class.cpp", "class.hpp", "out.log",
+        "object.o", "file-001.dat", "file-test.dat", "README.md", "notes.md",
+        "data.bin", "config~", "state.tmp"
+    };
+
+    class BacktrackingPattern: public io::PathPattern
+    {
+        public:
+            bool test_backtracking(const LSPString *path) const
+            {
+                io::Path tmp;
+                if (tmp.set(path) != STATUS_OK)
+                    return false;
+                if ((!(nFlags & FULL_PATH)) && (tmp.remove_base() != STATUS_OK))
+                    return false;
+
+                return match_full(tmp.as_string());
+            }
+    };
+}
+
+PTEST_BEGIN("runtime.io", pathpattern, 5, 100)
+
+    size_t match_backtracking(lltl::parray<BacktrackingPattern> *list, lltl::parray<LSPString> *paths)
+    {
+        size_t count = 0;
+        for (size_t i=0, n=paths->size(); i<n; ++i)
+        {
+            const LSPString *path = paths->uget(i);
+            for (size_t j=0, m=list->size(); j<m; ++j)
+                if (list->uget(j)->test_backtracking(path))
+                {
+                    ++count;
+                    break;
+                }
+        }
+        return count;
+    }
+
+    size_t match_dfa(lltl::parray<BacktrackingPattern> *list, lltl::parray<LSPString> *paths)
+    {
+        size_t count = 0;
+        for (size_t i=0, n=paths->size(); i<n; ++i)
+        {
+            const LSPString *path = paths->uget(i);
+            for (size_t j=0, m=list->size(); j<m; ++j)
+                if (list->uget(j)->test(path))
+                {
+                    ++count;
+                    break;
+                }
+        }
+        return count;
+    }
+
+    size_t match_set(io::PathPatternSet *set, lltl::parray<LSPString> *paths)
+    {
+        size_t count = 0;
+        for (size_t i=0, n=paths->size(); i<n; ++i)
+            if (set->test(paths->uget(i)))
+                ++count;
+        return count;
+    }
+
+    PTEST_MAIN
+    {
+        static constexpr size_t NUM_DIRS    = sizeof(dirs) / sizeof(dirs[0]);
+        static constexpr size_t NUM_FILES   = sizeof(files) / sizeof(files[0]);
+
+        lltl::parray<BacktrackingPattern> list;
+        lltl::parray<LSPString> paths;
+        io::PathPatternSet set;
+        lsp_finally {
+            for (size_t i=0, n=list.size(); i<n; ++i)
+                delete list.uget(i);
+            for (size_t i=0, n=paths.size(); i<n; ++i)
+                delete paths.uget(i);
+        };
+
+        // Initialize patterns
+        for (const char * const *p = patterns; *p != NULL; ++p)
+        {
+            BacktrackingPattern *bp = new BacktrackingPattern();
+            if ((bp == NULL) || (!list.add(bp)))
+            {
+                delete bp;
+                PTEST_FAIL_MSG("Out of memory");
+            }
+            if ((bp->set(*p, io::PathPattern::FULL_PATH) != STATUS_OK) ||
+                (set.add(*p, io::PathPattern::FULL_PATH) != STATUS_OK))
+                PTEST_FAIL_MSG("Could not parse pattern %s", *p);
+        }
+
+        // Initialize paths
+        for (size_t i=0; i<NUM_PATHS; ++i)
+        {
+            LSPString *s = new LSPString();
+            if ((s == NULL) || (!paths.add(s)))
+            {
+                delete s;
+                PTEST_FAIL_MSG("Out of memory");
+            }
+            if (!s->fmt_utf8("%s/dir-%d/%s", dirs[i % NUM_DIRS], int(i / NUM_DIRS), files[(i * 7) % NUM_FILES]))
+                PTEST_FAIL_MSG("Out of memory");
+        }
+
+        size_t bt_count = 0, dfa_count = 0, set_count = 0;
+
+        printf("Testing backtracking matcher...\n");
+        PTEST_LOOP("backtracking",
+            bt_count = match_backtracking(&list, &paths);
+        );
+
+        printf("Testing compiled patterns...\n");
+        PTEST_LOOP("dfa",
+            dfa_count = match_dfa(&list, &paths);
+        );
+
+        printf("Testing pattern set...\n");
+        PTEST_LOOP("set",
+            set_count = match_set(&set, &paths);
+        );
+
+        if ((bt_count != dfa_count) || (bt_count != set_count))
+            PTEST_FAIL_MSG("Number of matches differs: backtracking=%d, dfa=%d, set=%d",
+                int(bt_count), int(dfa_count), int(set_count));
+    }
+
+PTEST_END
+
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define TEXT_SIZE       0x10000
+
+namespace
+{
+    static const lsp::utf_kernel_t kernels[] =
+    {
+        lsp::UTF_KERNEL_GENERIC,
+        lsp::UTF_KERNEL_SSE2,
+        lsp::UTF_KERNEL_AVX2,
+        lsp::UTF_KERNEL_NEON
+    };
+
+    static const char *kernel_names[] =
+    {
+        "generic",
+        "sse2",
+        "avx2",
+        "neon"
+    };
+
+    static const lsp::lsp_utf32_t mixed[] =
+    {
+        0x0410, 0x0411, 0x0412, 0x0413, 0x20ac, 0x4e2d, 0x6587, 0x1f600
+    };
+}
+
+PTEST_BEGIN("runtime.io", utf, 5, 1000)
+
+    void init_text(lsp_utf32_t *dst, size_t count, bool ascii)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            // Put a non-ASCII character approximately to each 8th position
+            if ((!ascii) && ((i * 0x9e3779b1) & 0x70000000) == 0)
+                dst[i]      = mixed[i % (sizeof(mixed) / sizeof(mixed[0]))];
+            else
+                dst[i]      = ((i % 61) == 60) ? '\n' : 'a' + (i % 26);
+        }
+    }
+
+    void call(const char *label, const lsp_utf32_t *text, lsp_utf32_t *out, lsp_utf16_t *u16, char *u8)
+    {
+        char buf[80];
+        size_t n8 = 0, n16 = 0;
+
+        // Prepare the source data
+        size_t nsrc = TEXT_SIZE, ndst = TEXT_SIZE * 4;
+        utf32_to_utf8(u8, &ndst, text, &nsrc, true);
+        n8          = TEXT_SIZE * 4 - ndst;
+        nsrc        = TEXT_SIZE;
+        ndst        = TEXT_SIZE * 2;
+        utf32_to_utf16(u16, &ndst, text, &nsrc, true);
+        n16         = TEXT_SIZE * 2 - ndst;
+
+        for (size_t k=0; k < sizeof(kernels)/sizeof(kernels[0]); ++k)
+        {
+            if (select_utf_kernel(kernels[k]) != STATUS_OK)
+                continue;
+
+            snprintf(buf, sizeof(buf), "%s %s utf8_validate", label, kernel_names[k]);
+            printf("Testing %s...\n", buf);
+            PTEST_LOOP(buf,
+                if (utf8_validate(u8, n8) != n8)
+                    PTEST_FAIL_MSG("Validation has failed");
+            );
+
+            snprintf(buf, sizeof(buf), "%s %s utf8_to_utf32", label, kernel_names[k]);
+            printf("Testing %s...\n", buf);
+            PTEST_LOOP(buf,
+                nsrc        = n8;
+                ndst        = TEXT_SIZE;
+                utf8_to_utf32(out, &ndst, u8, &nsrc, true);
+            );
+            if ((ndst != 0) || (memcmp(text, out, TEXT_SIZE * sizeof(lsp_utf32_t)) != 0))
+                PTEST_FAIL_MSG("UTF-8 to UTF-32 conversion has failed");
+
+            snprintf(buf, sizeof(buf), "%s %s utf32_to_utf8", label, kernel_names[k]);
+            printf("Testing %s...\n", buf);
+            PTEST_LOOP(buf,
+                nsrc        = TEXT_SIZE;
+                ndst        = TEXT_SIZE * 4;
+                utf32_to_utf8(&u8[n8], &ndst, text, &nsrc, true);
+            );
+            if ((TEXT_SIZE * 4 - ndst != n8) || (memcmp(u8, &u8[n8], n8) != 0))
+                PTEST_FAIL_MSG("UTF-32 to UTF-8 conversion has failed");
+
+            snprintf(buf, sizeof(buf), "%s %s utf16_to_utf32", label, kernel_names[k]);
+            printf("Testing %s...\n", buf);
+            PTEST_LOOP(buf,
+                nsrc        = n16;
+                ndst        = TEXT_SIZE;
+                utf16_to_utf32(out, &ndst, u16, &nsrc, true);
+            );
+            if ((ndst != 0) || (memcmp(text, out, TEXT_SIZE * sizeof(lsp_utf32_t)) != 0))
+                PTEST_FAIL_MSG("UTF-16 to UTF-32 conversion has failed");
+
+            snprintf(buf, sizeof(buf), "%s %s utf32_to_utf16", label, kernel_names[k]);
+            printf("Testing %s...\n", buf);
+            PTEST_LOOP(buf,
+                nsrc        = TEXT_SIZE;
+                ndst        = TEXT_SIZE * 2;
+                utf32_to_utf16(&u16[n16], &ndst, text, &nsrc, true);
+            );
+            if ((TEXT_SIZE * 2 - ndst != n16) || (memcmp(u16, &u16[n16], n16 * sizeof(lsp_utf16_t)) != 0))
+                PTEST_FAIL_MSG("UTF-32 to UTF-16 conversion has failed");
+
+            PTEST_SEPARATOR;
+        }
+
+        select_utf_kernel(UTF_KERNEL_AUTO);
+    }
+
+    PTEST_MAIN
+    {
+        lsp_utf32_t *text   = static_cast<lsp_utf32_t *>(malloc(TEXT_SIZE * sizeof(lsp_utf32_t) * 2));
+        lsp_utf16_t *u16    = static_cast<lsp_utf16_t *>(malloc(TEXT_SIZE * sizeof(lsp_utf16_t) * 4));
+        char *u8            = static_cast<char *>(malloc(TEXT_SIZE * 8));
+        if ((text == NULL) || (u16 == NULL) || (u8 == NULL))
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally {
+            free(text);
+            free(u16);
+            free(u8);
+        };
+        lsp_utf32_t *out    = &text[TEXT_SIZE];
+
+        init_text(text, TEXT_SIZE, true);
+        call("ascii", text, out, u16, u8);
+
+        init_text(text, TEXT_SIZE, false);
+        call("mixed", text, out, u16, u8);
+    }
+
+PTEST_END
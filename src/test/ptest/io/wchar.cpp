@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define TEXT_SIZE       0x10000
+
+namespace
+{
+    static const lsp::utf_kernel_t kernels[] =
+    {
+        lsp::UTF_KERNEL_GENERIC,
+        lsp::UTF_KERNEL_SSE2,
+        lsp::UTF_KERNEL_AVX2,
+        lsp::UTF_KERNEL_NEON
+    };
+
+    static const char *kernel_names[] =
+    {
+        "generic",
+        "sse2",
+        "avx2",
+        "neon"
+    };
+
+    static const lsp::lsp_wchar_t cyrillic[] =
+    {
+        0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417,
+        0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437
+    };
+
+    static const char *pattern = "needle in the haystack";
+}
+
+PTEST_BEGIN("runtime.io", wchar, 5, 1000)
+
+    void init_text(lsp_wchar_t *dst, size_t count, bool ascii)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            // Put a non-ASCII character approximately to each 8th position
+            if ((!ascii) && ((i * 0x9e3779b1) & 0x70000000) == 0)
+                dst[i]      = cyrillic[i % (sizeof(cyrillic) / sizeof(cyrillic[0]))];
+            else
+                dst[i]      = ((i % 61) == 60) ? '\n' : 'a' + (i % 26);
+        }
+
+        // Put the pattern to the end of the text
+        const size_t len = strlen(pattern);
+        for (size_t i=0; i<len; ++i)
+            dst[count - len + i] = pattern[i];
+    }
+
+    // Scalar loops used by LSPString before the kernels were introduced
+    static ssize_t legacy_find(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        for (size_t i=0; i<count; ++i)
+            if (s[i] == ch)
+                return i;
+        return -1;
+    }
+
+    static ssize_t legacy_search(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len)
+    {
+        for (ssize_t i=0, last=count-len; i <= last; ++i)
+            if (::memcmp(&s[i], str, len * sizeof(lsp_wchar_t)) == 0)
+                return i;
+        return -1;
+    }
+
+    static int legacy_casecmp(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            int retval = int(to_lower(a[i])) - int(to_lower(b[i]));
+            if (retval != 0)
+                return retval;
+        }
+        return 0;
+    }
+
+    static void legacy_tolower(lsp_wchar_t *s, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+            s[i]    = to_lower(s[i]);
+    }
+
+    static size_t legacy_hash(const lsp_wchar_t *s, size_t count)
+    {
+        size_t hash = 0;
+        for (size_t i=0; i<count; ++i)
+            hash = (hash * 0x10015) ^ s[i];
+        return hash;
+    }
+
+    void call_legacy(const char *label, const lsp_wchar_t *text, lsp_wchar_t *buf, const lsp_wchar_t *needle, size_t len)
+    {
+        char name[80];
+
+        snprintf(name, sizeof(name), "%s legacy find", label);
+        printf("Testing %s...\n", name);
+        PTEST_LOOP(name,
+            if (legacy_find(text, TEXT_SIZE, '@') >= 0)
+                PTEST_FAIL_MSG("Unexpected character found");
+        );
+
+        snprintf(name, sizeof(name), "%s legacy search", label);
+        printf("Testing %s...\n", name);
+        PTEST_LOOP(name,
+            if (legacy_search(text, TEXT_SIZE, needle, len) != ssize_t(TEXT_SIZE - len))
+                PTEST_FAIL_MSG("Pattern not found");
+        );
+
+        ::memcpy(buf, text, TEXT_SIZE * sizeof(lsp_wchar_t));
+        legacy_tolower(buf, TEXT_SIZE);
+        snprintf(name, sizeof(name), "%s legacy casecmp", label);
+        printf("Testing %s...\n", name);
+        PTEST_LOOP(name,
+            if (legacy_casecmp(text, buf, TEXT_SIZE) != 0)
+                PTEST_FAIL_MSG("Strings differ");
+        );
+
+        snprintf(name, sizeof(name), "%s legacy tolower", label);
+        printf("Testing %s...\n", name);
+        PTEST_LOOP(name,
+            ::memcpy(buf, text, TEXT_SIZE * sizeof(lsp_wchar_t));
+            legacy_tolower(buf, TEXT_SIZE);
+        );
+
+        size_t hash = 0;
+        snprintf(name, sizeof(name), "%s legacy hash", label);
+        printf("Testing %s...\n", name);
+        PTEST_LOOP(name,
+            hash   += legacy_hash(&text[hash & 1], TEXT_SIZE - 1);
+        );
+        printf("Hash: 0x%lx\n", (unsigned long)hash);
+
+        PTEST_SEPARATOR;
+    }
+
+    void call(const char *label, const lsp_wchar_t *text, lsp_wchar_t *buf, const lsp_wchar_t *needle, size_t len)
+    {
+        char name[80];
+
+        for (size_t k=0; k < sizeof(kernels)/sizeof(kernels[0]); ++k)
+        {
+            if (select_wchar_kernel(kernels[k]) != STATUS_OK)
+                continue;
+
+            snprintf(name, sizeof(name), "%s %s find", label, kernel_names[k]);
+            printf("Testing %s...\n", name);
+            PTEST_LOOP(name,
+                if (wchar_find(text, TEXT_SIZE, '@') >= 0)
+                    PTEST_FAIL_MSG("Unexpected character found");
+            );
+
+            snprintf(name, sizeof(name), "%s %s search", label, kernel_names[k]);
+            printf("Testing %s...\n", name);
+            PTEST_LOOP(name,
+                if (wchar_search(text, TEXT_SIZE, needle, len) != ssize_t(TEXT_SIZE - len))
+                    PTEST_FAIL_MSG("Pattern not found");
+            );
+
+            ::memcpy(buf, text, TEXT_SIZE * sizeof(lsp_wchar_t));
+            wchar_tolower(buf, TEXT_SIZE);
+            snprintf(name, sizeof(name), "%s %s casecmp", label, kernel_names[k]);
+            printf("Testing %s...\n", name);
+            PTEST_LOOP(name,
+                if (wchar_casemismatch(text, buf, TEXT_SIZE) != TEXT_SIZE)
+                    PTEST_FAIL_MSG("Strings differ");
+            );
+
+            snprintf(name, sizeof(name), "%s %s tolower", label, kernel_names[k]);
+            printf("Testing %s...\n", name);
+            PTEST_LOOP(name,
+                ::memcpy(buf, text, TEXT_SIZE * sizeof(lsp_wchar_t));
+                wchar_tolower(buf, TEXT_SIZE);
+            );
+
+            size_t hash = 0;
+            snprintf(name, sizeof(name), "%s %s hash", label, kernel_names[k]);
+            printf("Testing %s...\n", name);
+            PTEST_LOOP(name,
+                hash   += wchar_hash(&text[hash & 1], TEXT_SIZE - 1);
+            );
+            printf("Hash: 0x%lx\n", (unsigned long)hash);
+
+            PTEST_SEPARATOR;
+        }
+
+        select_wchar_kernel(UTF_KERNEL_AUTO);
+    }
+
+    PTEST_MAIN
+    {
+        lsp_wchar_t *text   = static_cast<lsp_wchar_t *>(malloc(TEXT_SIZE * sizeof(lsp_wchar_t) * 2));
+        if (text == NULL)
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally {
+            free(text);
+        };
+        lsp_wchar_t *buf    = &text[TEXT_SIZE];
+
+        lsp_wchar_t needle[32];
+        const size_t len    = strlen(pattern);
+        for (size_t i=0; i<len; ++i)
+            needle[i]           = pattern[i];
+
+        init_text(text, TEXT_SIZE, true);
+        call_legacy("ascii", text, buf, needle, len);
+        call("ascii", text, buf, needle, len);
+
+        init_text(text, TEXT_SIZE, false);
+        call_legacy("mixed", text, buf, needle, len);
+        call("mixed", text, buf, needle, len);
+    }
+
+PTEST_END
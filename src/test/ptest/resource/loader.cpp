@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/io/PathIterator.h>
+#include <lsp-plug.in/lltl/darray.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/resource/BuiltinLoader.h>
+#include <lsp-plug.in/resource/PrefixLoader.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define NUM_DIRS        8
+#define NUM_SUBDIRS     8
+#define NUM_FILES       32
+#define NAME_MAX_LEN    32
+
+namespace
+{
+    using namespace lsp;
+
+    typedef struct name_t
+    {
+        char                value[NAME_MAX_LEN];
+    } name_t;
+
+    /**
+     * Loader that provides access to the legacy lookup algorithm which copies the path
+     * and peels items one by one
+     */
+    class TestLoader: public resource::BuiltinLoader
+    {
+        public:
+            status_t find_peeling(ssize_t *out, const io::Path *path)
+            {
+                status_t res;
+                ssize_t index = -1;
+                LSPString item;
+                io::Path tmp;
+
+                if ((res = tmp.set(path)) != STATUS_OK)
+                    return res;
+
+                while (true)
+                {
+                    if ((res = tmp.remove_first(&item)) != STATUS_OK)
+                        return res;
+
+                    const resource::raw_resource_t *found = NULL;
+                    for (size_t i=0; i<nCatSize; ++i)
+                    {
+                        const resource::raw_resource_t *ent = &pCatalog[i];
+                        if ((ent->parent != index) || (ent->name == NULL))
+                            continue;
+                        if (item.equals_utf8(ent->name))
+                        {
+                            found   = ent;
+                            index   = i;
+                            break;
+                        }
+                    }
+
+                    if (found == NULL)
+                        return STATUS_NOT_FOUND;
+                    if (tmp.is_empty())
+                    {
+                        *out    = index;
+                        return STATUS_OK;
+                    }
+                    else if (found->type != resource::RES_DIR)
+                        return STATUS_NOT_FOUND;
+                }
+            }
+
+            status_t find_iterating(ssize_t *out, const io::Path *path)
+            {
+                return find_entry(out, path);
+            }
+    };
+}
+
+PTEST_BEGIN("runtime.resource", loader, 5, 100)
+
+    typedef status_t (TestLoader::*find_t)(ssize_t *out, const io::Path *path);
+
+    size_t lookup(TestLoader *ldr, find_t func, lltl::parray<io::Path> *paths)
+    {
+        size_t found = 0;
+        ssize_t index = 0;
+        for (size_t i=0, n=paths->size(); i<n; ++i)
+        {
+            if ((ldr->*func)(&index, paths->uget(i)) == STATUS_OK)
+                ++found;
+        }
+        return found;
+    }
+
+    size_t enumerate(resource::ILoader *ldr, const char *prefix)
+    {
+        char buf[64];
+        size_t found = 0;
+        resource::resource_t *list = NULL;
+
+        for (size_t i=0; i<NUM_DIRS; ++i)
+            for (size_t j=0; j<NUM_SUBDIRS; ++j)
+            {
+                snprintf(buf, sizeof(buf), "%sdir-%d/subdir-%d", prefix, int(i), int(j));
+                ssize_t count = ldr->enumerate(buf, &list);
+                if (count > 0)
+                    found  += count;
+                if (list != NULL)
+                {
+                    free(list);
+                    list = NULL;
+                }
+            }
+
+        return found;
+    }
+
+    size_t path_ops(lltl::parray<io::Path> *paths, io::Path *base)
+    {
+        io::Path tmp, out;
+        size_t length = 0;
+
+        for (size_t i=0, n=paths->size(); i<n; ++i)
+        {
+            const io::Path *p = paths->uget(i);
+            if (tmp.set(p) != STATUS_OK)
+                return 0;
+            if (tmp.append_child("../.config/file.ext") != STATUS_OK)
+                return 0;
+            if (tmp.set_parent(base) != STATUS_OK)
+                return 0;
+            if (tmp.canonicalize() != STATUS_OK)
+                return 0;
+            if (tmp.get_canonical(&out) != STATUS_OK)
+                return 0;
+            length     += out.length();
+            if (p->get_parent(&out) != STATUS_OK)
+                return 0;
+            length     += out.length();
+        }
+
+        return length;
+    }
+
+    size_t iterate(lltl::parray<io::Path> *paths)
+    {
+        size_t items = 0;
+        io::PathIterator it;
+
+        for (size_t i=0, n=paths->size(); i<n; ++i)
+        {
+            it.wrap(paths->uget(i));
+            while (it.next())
+                ++items;
+        }
+
+        return items;
+    }
+
+    size_t peel(lltl::parray<io::Path> *paths)
+    {
+        size_t items = 0;
+        io::Path tmp;
+        LSPString item;
+
+        for (size_t i=0, n=paths->size(); i<n; ++i)
+        {
+            if (tmp.set(paths->uget(i)) != STATUS_OK)
+                return 0;
+            while (tmp.remove_first(&item) == STATUS_OK)
+            {
+                ++items;
+                if (tmp.is_empty())
+                    break;
+            }
+        }
+
+        return items;
+    }
+
+    PTEST_MAIN
+    {
+        lltl::darray<resource::raw_resource_t> catalog;
+        lltl::darray<name_t> names;
+        lltl::parray<io::Path> paths;
+        lsp_finally {
+            for (size_t i=0, n=paths.size(); i<n; ++i)
+                delete paths.uget(i);
+        };
+
+        // Generate the catalog with the structure 'dir-N/subdir-M/file-K.dat'
+        static constexpr size_t NUM_ENTRIES = NUM_DIRS * (1 + NUM_SUBDIRS * (1 + NUM_FILES));
+        name_t *vnames = names.append_n(NUM_ENTRIES);
+        resource::raw_resource_t *vcat = catalog.append_n(NUM_ENTRIES);
+        if ((vnames == NULL) || (vcat == NULL))
+            PTEST_FAIL_MSG("Out of memory");
+
+        size_t count = 0;
+        for (size_t i=0; i<NUM_DIRS; ++i)
+        {
+            const ssize_t dir_index = count;
+            snprintf(vnames[count].value, NAME_MAX_LEN, "dir-%d", int(i));
+            vcat[count++] = { resource::RES_DIR, vnames[dir_index].value, -1, -1, -1, 0 };
+
+            for (size_t j=0; j<NUM_SUBDIRS; ++j)
+            {
+                const ssize_t sub_index = count;
+                snprintf(vnames[count].value, NAME_MAX_LEN, "subdir-%d", int(j));
+                vcat[count++] = { resource::RES_DIR, vnames[sub_index].value, int32_t(dir_index), -1, -1, 0 };
+
+                for (size_t k=0; k<NUM_FILES; ++k)
+                {
+                    snprintf(vnames[count].value, NAME_MAX_LEN, "file-%d.dat", int(k));
+                    vcat[count] = { resource::RES_FILE, vnames[count].value, int32_t(sub_index), -1, -1, 0 };
+                    ++count;
+
+                    io::Path *path = new io::Path();
+                    if ((path == NULL) || (!paths.add(path)))
+                    {
+                        delete path;
+                        PTEST_FAIL_MSG("Out of memory");
+                    }
+                    if (path->fmt("dir-%d/subdir-%d/file-%d.dat", int(i), int(j), int(k)) <= 0)
+                        PTEST_FAIL_MSG("Could not format path");
+                }
+            }
+        }
+
+        // Initialize loaders
+        TestLoader *builtin = new TestLoader();
+        if (builtin == NULL)
+            PTEST_FAIL_MSG("Out of memory");
+        resource::PrefixLoader prefix;
+        if (prefix.add_prefix("builtin://", builtin, true) != STATUS_OK)
+        {
+            delete builtin;
+            PTEST_FAIL_MSG("Could not add prefix");
+        }
+        builtin->init(NULL, 0, vcat, count, 0);
+
+        io::Path base;
+        if (base.set("/usr/share/lsp-plugins/resources") != STATUS_OK)
+            PTEST_FAIL_MSG("Could not set base path");
+
+        size_t peel_found = 0, iter_found = 0, peel_items = 0, iter_items = 0;
+        size_t builtin_count = 0, prefix_count = 0, length = 0;
+
+        printf("Testing lookup of entries...\n");
+        PTEST_LOOP("find peeling",
+            peel_found = lookup(builtin, &TestLoader::find_peeling, &paths);
+        );
+        PTEST_LOOP("find iterating",
+            iter_found = lookup(builtin, &TestLoader::find_iterating, &paths);
+        );
+        PTEST_SEPARATOR;
+
+        printf("Testing enumeration of directories...\n");
+        PTEST_LOOP("builtin enumerate",
+            builtin_count = enumerate(builtin, "");
+        );
+        PTEST_LOOP("prefix enumerate",
+            prefix_count = enumerate(&prefix, "builtin://");
+        );
+        PTEST_SEPARATOR;
+
+        printf("Testing walking over path items...\n");
+        PTEST_LOOP("peel items",
+            peel_items = peel(&paths);
+        );
+        PTEST_LOOP("iterate items",
+            iter_items = iterate(&paths);
+        );
+        PTEST_SEPARATOR;
+
+        printf("Testing path operations...\n");
+        PTEST_LOOP("path ops",
+            length = path_ops(&paths, &base);
+        );
+
+        if ((peel_found != paths.size()) || (iter_found != paths.size()))
+            PTEST_FAIL_MSG("Lookup failed: peeling=%d, iterating=%d, expected=%d",
+                int(peel_found), int(iter_found), int(paths.size()));
+        if ((builtin_count != paths.size()) || (prefix_count != paths.size()))
+            PTEST_FAIL_MSG("Enumeration failed: builtin=%d, prefix=%d, expected=%d",
+                int(builtin_count), int(prefix_count), int(paths.size()));
+        if ((peel_items != iter_items) || (iter_items != paths.size() * 3))
+            PTEST_FAIL_MSG("Number of items differs: peeling=%d, iterating=%d",
+                int(peel_items), int(iter_items));
+        if (length == 0)
+            PTEST_FAIL_MSG("Path operations failed");
+    }
+
+PTEST_END
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/AtomTable.h>
+#include <lsp-plug.in/expr/Variables.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define KEYS_COUNT      0x400
+
+PTEST_BEGIN("runtime.runtime", atomtable, 5, 1000)
+
+    size_t resolve_strings(expr::Variables *vars, const LSPString *keys, size_t count)
+    {
+        size_t res = 0;
+        expr::value_t v;
+        expr::init_value(&v);
+        for (size_t i=0; i<count; ++i)
+        {
+            if (vars->resolve(&v, &keys[i]) == STATUS_OK)
+                res    += v.v_int;
+        }
+        expr::destroy_value(&v);
+        return res;
+    }
+
+    size_t resolve_atoms(expr::Variables *vars, const atom_t * const *keys, size_t count)
+    {
+        size_t res = 0;
+        expr::value_t v;
+        expr::init_value(&v);
+        for (size_t i=0; i<count; ++i)
+        {
+            if (vars->resolve(&v, keys[i]) == STATUS_OK)
+                res    += v.v_int;
+        }
+        expr::destroy_value(&v);
+        return res;
+    }
+
+    size_t intern_strings(AtomTable *table, const LSPString *keys, size_t count)
+    {
+        size_t res = 0;
+        for (size_t i=0; i<count; ++i)
+        {
+            if (table->intern(&keys[i]) != NULL)
+                ++res;
+        }
+        return res;
+    }
+
+    PTEST_MAIN
+    {
+        AtomTable table;
+        expr::Variables vars;
+        LSPString *keys         = new LSPString[KEYS_COUNT];
+        const atom_t **atoms    = new const atom_t *[KEYS_COUNT];
+        lsp_finally {
+            delete [] keys;
+            delete [] atoms;
+        };
+
+        // Typical parameter names of a plugin with common prefixes
+        for (size_t i=0; i<KEYS_COUNT; ++i)
+        {
+            keys[i].fmt_ascii("param_%s_%d", ((i & 1) ? "in" : "out"), int(i));
+            atoms[i]    = table.intern(&keys[i]);
+            if ((atoms[i] == NULL) || (vars.set_int(&keys[i], i) != STATUS_OK))
+                PTEST_FAIL_MSG("Out of memory");
+        }
+
+        const size_t expected = (KEYS_COUNT * (KEYS_COUNT - 1)) / 2;
+        size_t rs = 0, ra = 0;
+
+        PTEST_LOOP("intern",
+            intern_strings(&table, keys, KEYS_COUNT);
+        );
+        PTEST_LOOP("resolve string",
+            rs = resolve_strings(&vars, keys, KEYS_COUNT);
+        );
+        PTEST_LOOP("resolve atom",
+            ra = resolve_atoms(&vars, atoms, KEYS_COUNT);
+        );
+
+        if ((rs != expected) || (ra != expected))
+            PTEST_FAIL_MSG("Resolved values do not match");
+    }
+
+PTEST_END
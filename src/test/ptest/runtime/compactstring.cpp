@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/CompactString.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define KEYS_COUNT      0x1000
+#define KEY_LENGTH      24
+#define TEXT_LENGTH     0x10000
+#define BUF_SIZE        (TEXT_LENGTH * 4)
+
+namespace
+{
+    using namespace lsp;
+
+    // Strings with access to the cached hash value
+    class TestString: public LSPString
+    {
+        public:
+            inline void reset_hash()    { nHash = 0; }
+    };
+
+    class TestCompactString: public CompactString
+    {
+        public:
+            inline void reset_hash()    { nHash = 0; }
+    };
+}
+
+PTEST_BEGIN("runtime.runtime", compactstring, 5, 1000)
+
+    void init_string(LSPString *dst, size_t index, size_t length, bool ascii)
+    {
+        dst->clear();
+        for (size_t i=0; i<length; ++i)
+        {
+            const size_t x = (index + i * 7) % 26;
+            dst->append(lsp_wchar_t((ascii) ? 'a' + x : 0x0430 + x));
+        }
+    }
+
+    template <class S>
+    size_t compare_keys(const S *keys, size_t count)
+    {
+        size_t res = 0;
+        for (size_t i=1; i<count; ++i)
+            res    += (keys[i-1].compare_to(&keys[i]) > 0) + keys[i].equals(&keys[i-1]);
+        return res;
+    }
+
+    template <class S>
+    size_t hash_keys(S *keys, size_t count)
+    {
+        size_t res = 0;
+        for (size_t i=0; i<count; ++i)
+        {
+            keys[i].reset_hash();
+            res    += keys[i].hash();
+        }
+        return res;
+    }
+
+    void measure(const char *label, bool ascii, char *buf)
+    {
+        TestString *lkeys       = new TestString[KEYS_COUNT];
+        TestCompactString *ckeys= new TestCompactString[KEYS_COUNT];
+        lsp_finally {
+            delete [] lkeys;
+            delete [] ckeys;
+        };
+
+        // Memory footprint
+        size_t lsize = 0, csize = 0;
+        for (size_t i=0; i<KEYS_COUNT; ++i)
+        {
+            init_string(&lkeys[i], i, KEY_LENGTH, ascii);
+            lkeys[i].reduce();
+            ckeys[i].set(&lkeys[i]);
+            lsize  += sizeof(LSPString) + lkeys[i].capacity() * sizeof(lsp_wchar_t);
+            csize  += sizeof(CompactString) + ckeys[i].data_size();
+        }
+        printf("Memory footprint of %d %s keys: LSPString=%d bytes, CompactString=%d bytes\n",
+            int(KEYS_COUNT), label, int(lsize), int(csize));
+
+        TestString ltext, lneedle;
+        TestCompactString ctext, cneedle;
+        init_string(&ltext, 0, TEXT_LENGTH, ascii);
+        init_string(&lneedle, 1, 8, ascii);
+        lneedle.append(lsp_wchar_t('!'));
+        ctext.set(&ltext);
+        cneedle.set(&lneedle);
+
+        char key[80];
+        size_t res = 0;
+
+        snprintf(key, sizeof(key), "%s LSPString compare_to", label);
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key, res += compare_keys(lkeys, KEYS_COUNT); );
+
+        snprintf(key, sizeof(key), "%s CompactString compare_to", label);
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key, res += compare_keys(ckeys, KEYS_COUNT); );
+
+        snprintf(key, sizeof(key), "%s LSPString hash", label);
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key, res += hash_keys(lkeys, KEYS_COUNT); );
+
+        snprintf(key, sizeof(key), "%s CompactString hash", label);
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key, res += hash_keys(ckeys, KEYS_COUNT); );
+
+        snprintf(key, sizeof(key), "%s LSPString index_of", label);
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key, res += ltext.index_of(&lneedle) + ltext.index_of(lsp_wchar_t('!')); );
+
+        snprintf(key, sizeof(key), "%s CompactString index_of", label);
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key, res += ctext.index_of(&cneedle) + ctext.index_of(lsp_wchar_t('!')); );
+
+        snprintf(key, sizeof(key), "%s LSPString get_utf8", label);
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key,
+            ltext.get_utf8();
+            res += ltext.temporal_size();
+        );
+
+        snprintf(key, sizeof(key), "%s CompactString get_utf8", label);
+        printf("Testing %s...\n", key);
+        PTEST_LOOP(key, res += ctext.get_utf8(buf, BUF_SIZE); );
+
+        printf("Result: %d\n", int(res));
+        PTEST_SEPARATOR;
+    }
+
+    PTEST_MAIN
+    {
+        char *buf = static_cast<char *>(malloc(BUF_SIZE));
+        if (buf == NULL)
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally { free(buf); };
+
+        measure("ascii", true, buf);
+        measure("cyrillic", false, buf);
+    }
+
+PTEST_END
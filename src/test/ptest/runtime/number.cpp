@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/number.h>
+#include <lsp-plug.in/stdlib/locale.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define VALUES_COUNT        0x1000
+#define TEXT_SIZE           0x40
+
+PTEST_BEGIN("runtime.runtime", number, 5, 1000)
+
+    void init_values(double *values, char *text, size_t count)
+    {
+        uint32_t seed = 0x12345678;
+        for (size_t i=0; i<count; ++i)
+        {
+            seed        = seed * 1664525 + 1013904223;
+            const double m  = double(seed) / double(0x100000000ULL);
+            seed        = seed * 1664525 + 1013904223;
+            const int e     = int(seed % 24) - 12;
+            values[i]   = (m - 0.5) * pow(10.0, e);
+            snprintf(&text[i * TEXT_SIZE], TEXT_SIZE, "%.17g", values[i]);
+        }
+    }
+
+    size_t libc_format(char *buf, const double *values, size_t count, const char *fmt)
+    {
+        SET_LOCALE_SCOPED(LC_NUMERIC, "C");
+
+        size_t res = 0;
+        for (size_t i=0; i<count; ++i)
+            res    += snprintf(buf, TEXT_SIZE, fmt, values[i]);
+        return res;
+    }
+
+    size_t lsp_format(char *buf, const double *values, size_t count, const char *fmt)
+    {
+        size_t res = 0;
+        for (size_t i=0; i<count; ++i)
+            res    += format_float(buf, TEXT_SIZE, fmt, values[i]);
+        return res;
+    }
+
+    size_t lsp_shortest(char *buf, const double *values, size_t count)
+    {
+        size_t res = 0;
+        for (size_t i=0; i<count; ++i)
+            res    += format_shortest(buf, values[i]);
+        return res;
+    }
+
+    double libc_parse(const char *text, size_t count)
+    {
+        SET_LOCALE_SCOPED(LC_NUMERIC, "C");
+
+        double res = 0.0;
+        for (size_t i=0; i<count; ++i)
+            res    += strtod(&text[i * TEXT_SIZE], NULL);
+        return res;
+    }
+
+    double lsp_parse(const char *text, size_t count)
+    {
+        double res = 0.0, v = 0.0;
+        for (size_t i=0; i<count; ++i)
+        {
+            parse_double(&v, &text[i * TEXT_SIZE], NULL);
+            res    += v;
+        }
+        return res;
+    }
+
+    PTEST_MAIN
+    {
+        double *values  = static_cast<double *>(malloc(VALUES_COUNT * sizeof(double)));
+        char *text      = static_cast<char *>(malloc(VALUES_COUNT * TEXT_SIZE + TEXT_SIZE));
+        if ((values == NULL) || (text == NULL))
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally {
+            free(values);
+            free(text);
+        };
+        char *buf       = &text[VALUES_COUNT * TEXT_SIZE];
+        init_values(values, text, VALUES_COUNT);
+
+        static const char *formats[] = { "%f", "%.3f", "%e", "%g", NULL };
+
+        char key[80];
+        size_t res = 0;
+        for (const char **fmt = formats; *fmt != NULL; ++fmt)
+        {
+            snprintf(key, sizeof(key), "libc snprintf %s", *fmt);
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key, res += libc_format(buf, values, VALUES_COUNT, *fmt); );
+
+            snprintf(key, sizeof(key), "lsp format_float %s", *fmt);
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key, res += lsp_format(buf, values, VALUES_COUNT, *fmt); );
+
+            PTEST_SEPARATOR;
+        }
+
+        printf("Testing libc snprintf %%.17g...\n");
+        PTEST_LOOP("libc snprintf %.17g", res += libc_format(buf, values, VALUES_COUNT, "%.17g"); );
+
+        printf("Testing lsp format_shortest...\n");
+        PTEST_LOOP("lsp format_shortest", res += lsp_shortest(buf, values, VALUES_COUNT); );
+
+        PTEST_SEPARATOR;
+
+        double sum = 0.0;
+        printf("Testing libc strtod...\n");
+        PTEST_LOOP("libc strtod", sum += libc_parse(text, VALUES_COUNT); );
+
+        printf("Testing lsp parse_double...\n");
+        PTEST_LOOP("lsp parse_double", sum += lsp_parse(text, VALUES_COUNT); );
+
+        printf("Result: %d %g\n", int(res), sum);
+    }
+
+PTEST_END
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define KEYS_COUNT      0x1000
+
+PTEST_BEGIN("runtime.runtime", string, 5, 1000)
+
+    void init_keys(char **keys, size_t count, size_t length)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            char *k = keys[i];
+            for (size_t j=0; j<length; ++j)
+                k[j]    = 'a' + ((i * 7 + j * 13) % 26);
+            k[length] = '\0';
+        }
+    }
+
+    size_t create_keys(char **keys, size_t count)
+    {
+        size_t res = 0;
+        for (size_t i=0; i<count; ++i)
+        {
+            LSPString s;
+            s.set_utf8(keys[i]);
+            res    += s.length();
+        }
+        return res;
+    }
+
+    size_t copy_keys(LSPString *src, size_t count)
+    {
+        size_t res = 0;
+        for (size_t i=0; i<count; ++i)
+        {
+            LSPString *s = src[i].copy();
+            if (s == NULL)
+                continue;
+            res    += s->length();
+            delete s;
+        }
+        return res;
+    }
+
+    size_t append_keys(char **keys, size_t count)
+    {
+        size_t res = 0;
+        for (size_t i=0; i<count; ++i)
+        {
+            LSPString s;
+            for (const char *p = keys[i]; *p != '\0'; ++p)
+                s.append(lsp_wchar_t(*p));
+            res    += s.length();
+        }
+        return res;
+    }
+
+    PTEST_MAIN
+    {
+        static const size_t lengths[] = { 3, 8, 16, 64 };
+
+        char *data  = static_cast<char *>(malloc(KEYS_COUNT * (sizeof(char *) + 0x80)));
+        LSPString *strings = new LSPString[KEYS_COUNT];
+        if ((data == NULL) || (strings == NULL))
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally {
+            free(data);
+            delete [] strings;
+        };
+
+        char **keys = reinterpret_cast<char **>(data);
+        for (size_t i=0; i<KEYS_COUNT; ++i)
+            keys[i]     = &data[KEYS_COUNT * sizeof(char *) + i * 0x80];
+
+        char key[80];
+        size_t total = 0;
+        for (size_t i=0; i<sizeof(lengths)/sizeof(lengths[0]); ++i)
+        {
+            init_keys(keys, KEYS_COUNT, lengths[i]);
+            for (size_t j=0; j<KEYS_COUNT; ++j)
+                strings[j].set_ascii(keys[j]);
+
+            snprintf(key, sizeof(key), "create length=%d", int(lengths[i]));
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key,
+                total  += create_keys(keys, KEYS_COUNT);
+            );
+
+            snprintf(key, sizeof(key), "copy length=%d", int(lengths[i]));
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key,
+                total  += copy_keys(strings, KEYS_COUNT);
+            );
+
+            snprintf(key, sizeof(key), "append length=%d", int(lengths[i]));
+            printf("Testing %s...\n", key);
+            PTEST_LOOP(key,
+                total  += append_keys(keys, KEYS_COUNT);
+            );
+
+            PTEST_SEPARATOR;
+        }
+
+        printf("Total characters: %d\n", int(total));
+    }
+
+PTEST_END
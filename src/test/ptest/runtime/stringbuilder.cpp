@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/StringBuilder.h>
+#include <lsp-plug.in/io/OutStringSequence.h>
+#include <lsp-plug.in/io/OutBuilderSequence.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/test-fw/ptest.h>
+
+#define RECORDS_COUNT       0x8000
+
+PTEST_BEGIN("runtime.runtime", stringbuilder, 5, 100)
+
+    void init_values(LSPString *keys, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+            keys[i].fmt_utf8("/plugin/параметр_%d", int(i));
+    }
+
+    // Emit the record with the same structure as the state dump: key, escaped value and number
+    size_t emit_string(LSPString *out, const LSPString *keys, size_t count)
+    {
+        char buf[32];
+        out->clear();
+        for (size_t i=0; i<count; ++i)
+        {
+            out->append_ascii("key = \"");
+            out->append(&keys[i]);
+            out->append_ascii("\", value = ");
+            const int n = snprintf(buf, sizeof(buf), "%d", int(i * 7));
+            out->append_ascii(buf, n);
+            out->append('\n');
+        }
+
+        return out->length();
+    }
+
+    size_t emit_builder(LSPString *out, const LSPString *keys, size_t count)
+    {
+        StringBuilder sb;
+        for (size_t i=0; i<count; ++i)
+        {
+            sb.append_ascii("key = \"");
+            sb.append(&keys[i]);
+            sb.append_ascii("\", value = ");
+            sb.append_int(i * 7);
+            sb.append('\n');
+        }
+        sb.to_string(out);
+
+        return out->length();
+    }
+
+    size_t emit_sequence(io::IOutSequence *os, const LSPString *keys, size_t count)
+    {
+        char buf[32];
+        for (size_t i=0; i<count; ++i)
+        {
+            os->write_ascii("key = \"");
+            os->write(&keys[i]);
+            os->write_ascii("\", value = ");
+            const int n = snprintf(buf, sizeof(buf), "%d", int(i * 7));
+            os->write_ascii(buf, n);
+            os->write('\n');
+        }
+
+        return count;
+    }
+
+    PTEST_MAIN
+    {
+        LSPString *keys = new LSPString[RECORDS_COUNT];
+        if (keys == NULL)
+            PTEST_FAIL_MSG("Out of memory");
+        lsp_finally { delete [] keys; };
+        init_values(keys, RECORDS_COUNT);
+
+        LSPString out, check;
+        size_t res = 0;
+
+        printf("Testing LSPString append...\n");
+        PTEST_LOOP("LSPString append", res += emit_string(&out, keys, RECORDS_COUNT); );
+
+        printf("Testing StringBuilder append...\n");
+        PTEST_LOOP("StringBuilder append", res += emit_builder(&check, keys, RECORDS_COUNT); );
+
+        if (!out.equals(&check))
+            PTEST_FAIL_MSG("StringBuilder output differs from LSPString output");
+
+        PTEST_SEPARATOR;
+
+        printf("Testing OutStringSequence...\n");
+        PTEST_LOOP("OutStringSequence",
+            out.clear();
+            io::OutStringSequence os(&out);
+            res += emit_sequence(&os, keys, RECORDS_COUNT);
+        );
+
+        printf("Testing OutBuilderSequence...\n");
+        PTEST_LOOP("OutBuilderSequence",
+            StringBuilder sb;
+            io::OutBuilderSequence os(&sb);
+            res += emit_sequence(&os, keys, RECORDS_COUNT);
+            sb.to_string(&check);
+        );
+
+        if (!out.equals(&check))
+            PTEST_FAIL_MSG("OutBuilderSequence output differs from OutStringSequence output");
+
+        printf("Result: %d characters\n", int(res));
+    }
+
+PTEST_END
@@ -252,6 +252,28 @@ UTEST_BEGIN("runtime.fmt.json", tokenizer)
         ck_invalid("/* test comment", JT_ERROR);
     }
 
+    void test_sequence_position()
+    {
+        io::InStringSequence *sq = new io::InStringSequence();
+        UTEST_ASSERT(sq != NULL);
+        UTEST_ASSERT(sq->wrap("{ 'key' :", "UTF-8") == STATUS_OK);
+        Tokenizer *t = new Tokenizer(sq);
+        UTEST_ASSERT(t != NULL);
+
+        // The position of the sequence should be updated by sync()
+        UTEST_ASSERT(t->get_token(true) == JT_LC_BRACE);
+        UTEST_ASSERT(t->sync() == STATUS_OK);
+        UTEST_ASSERT(sq->read() == ' ');
+        UTEST_ASSERT(t->get_token(true) == JT_SQ_STRING);
+        UTEST_ASSERT(t->text_value()->equals_ascii("key"));
+        UTEST_ASSERT(t->sync() == STATUS_OK);
+        UTEST_ASSERT(sq->read() == ' ');
+
+        // The tokenizer should not access the sequence when destroyed
+        delete sq;
+        delete t;
+    }
+
     UTEST_MAIN
     {
         printf("Testing basic tokens...\n");
@@ -266,6 +288,8 @@ UTEST_BEGIN("runtime.fmt.json", tokenizer)
         test_unicode_comments();
         printf("Testing invalid tokens...\n");
         test_invalid_tokens();
+        printf("Testing position of the sequence...\n");
+        test_sequence_position();
     }
 
 UTEST_END
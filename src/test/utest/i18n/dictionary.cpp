@@ -35,6 +35,22 @@ UTEST_BEGIN("runtime.i18n", dictionary)
         UTEST_ASSERT(v.equals_utf8(value));
     }
 
+    void ck_lookup_atom(i18n::IDictionary *d, AtomTable *table, const char *name, const char *value)
+    {
+        LSPString v;
+        const atom_t *key = table->intern(name);
+        UTEST_ASSERT(key != NULL);
+
+        // The second lookup should be served from the cache
+        printf("  lookup atom %s ...\n", name);
+        for (size_t i=0; i<2; ++i)
+        {
+            v.clear();
+            UTEST_ASSERT(d->lookup(key, &v) == STATUS_OK);
+            UTEST_ASSERT(v.equals_utf8(value));
+        }
+    }
+
     UTEST_MAIN
     {
         i18n::Dictionary d;
@@ -67,6 +83,21 @@ UTEST_BEGIN("runtime.i18n", dictionary)
 
         ck_lookup(&d, "i18n.valid.k2", "special_case");
         ck_lookup(&d, "i18n.valid.k8.k1", "special_case2");
+
+        printf("Testing interned key access...\n");
+        AtomTable table;
+        ck_lookup_atom(&d, &table, "i18n.valid.k1", "v1");
+        ck_lookup_atom(&d, &table, "i18n.valid.k8.k1.k2", "z2");
+        ck_lookup_atom(xd, &table, "k7.a3", "x3");
+
+        const atom_t *missing = table.intern("i18n.valid.k3");
+        UTEST_ASSERT(missing != NULL);
+        UTEST_ASSERT(d.lookup(missing, &v) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(d.lookup(missing, &v) == STATUS_NOT_FOUND);
+
+        d.clear();
+        UTEST_ASSERT(d.init(resources()) == STATUS_OK);
+        ck_lookup_atom(&d, &table, "i18n.valid.k1", "v1");
     }
 
 UTEST_END
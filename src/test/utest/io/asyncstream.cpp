@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InAsyncStream.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/ipc/NativeExecutor.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define DATA_SIZE       0x40000
+
+namespace
+{
+    using namespace lsp;
+
+    /**
+     * Stream that fails with I/O error after the specified amount of data
+     */
+    class FailingStream: public io::InMemoryStream
+    {
+        private:
+            size_t      nLimit;
+
+        public:
+            explicit FailingStream(const void *data, size_t size, size_t limit):
+                io::InMemoryStream(data, size)
+            {
+                nLimit      = limit;
+            }
+
+        public:
+            virtual ssize_t read(void *dst, size_t count) override
+            {
+                wssize_t pos = position();
+                if (pos >= wssize_t(nLimit))
+                    return -set_error(STATUS_IO_ERROR);
+                return io::InMemoryStream::read(dst, lsp_min(count, nLimit - pos));
+            }
+    };
+}
+
+UTEST_BEGIN("runtime.io", asyncstream)
+
+    void init_random(uint8_t *dst, size_t count)
+    {
+        uint32_t seed = 0x12345678;
+        for (size_t i=0; i<count; ++i)
+        {
+            seed            = seed * 1664525 + 1013904223;
+            dst[i]          = uint8_t(seed >> 24);
+        }
+    }
+
+    ssize_t read_all(io::IInStream *is, uint8_t *dst, size_t count)
+    {
+        size_t done = 0;
+        while (done < count)
+        {
+            ssize_t n = is->read(&dst[done], count - done);
+            if (n < 0)
+                return (done > 0) ? done : n;
+            done       += n;
+        }
+        return done;
+    }
+
+    void check_read(ipc::IExecutor *executor, const uint8_t *data, size_t count, size_t depth, size_t buf_size)
+    {
+        printf("  testing sequential read depth=%d, buf_size=%d, executor=%s\n",
+            int(depth), int(buf_size), (executor != NULL) ? "true" : "false");
+
+        uint8_t *buf = static_cast<uint8_t *>(malloc(count));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+
+        io::InMemoryStream ims(data, count);
+        io::InAsyncStream is(executor);
+        UTEST_ASSERT(is.read(buf, 1) == -STATUS_CLOSED);
+        UTEST_ASSERT(is.wrap(&ims, 0, 0, buf_size) == STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(is.wrap(&ims, 0, depth, 0) == STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(is.wrap(&ims, 0, depth, buf_size) == STATUS_OK);
+        UTEST_ASSERT(is.wrap(&ims, 0, depth, buf_size) == STATUS_BAD_STATE);
+        UTEST_ASSERT(is.depth() == depth);
+        UTEST_ASSERT(is.buffer_size() == buf_size);
+
+        uint32_t seed = 1;
+        for (size_t off = 0; off < count; )
+        {
+            seed                = seed * 1103515245 + 12345;
+            size_t to_read      = lsp_min(size_t((seed >> 16) % 5000) + 1, count - off);
+            ssize_t n           = is.read(&buf[off], to_read);
+            UTEST_ASSERT(n > 0);
+            UTEST_ASSERT(size_t(n) <= to_read);
+            UTEST_ASSERT(is.avail() >= 0);
+            off                += n;
+            UTEST_ASSERT(is.position() == wssize_t(off));
+        }
+
+        UTEST_ASSERT(memcmp(buf, data, count) == 0);
+        UTEST_ASSERT(is.read(buf, 1) == -STATUS_EOF);
+        UTEST_ASSERT(is.avail() == 0);
+        UTEST_ASSERT(is.skip(1) == -STATUS_EOF);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+        UTEST_ASSERT(is.read(buf, 1) == -STATUS_CLOSED);
+    }
+
+    void check_seek(ipc::IExecutor *executor, const uint8_t *data, size_t count, size_t depth, size_t buf_size)
+    {
+        printf("  testing seek and skip depth=%d, buf_size=%d, executor=%s\n",
+            int(depth), int(buf_size), (executor != NULL) ? "true" : "false");
+
+        uint8_t buf[0x100];
+        io::InAsyncStream is(executor);
+        UTEST_ASSERT(is.wrap(new io::InMemoryStream(data, count), WRAP_CLOSE | WRAP_DELETE, depth, buf_size) == STATUS_OK);
+
+        uint32_t seed = 1;
+        for (size_t i=0; i<500; ++i)
+        {
+            seed                = seed * 1103515245 + 12345;
+            const size_t action = (seed >> 8) % 3;
+            wsize_t pos         = is.position();
+            wsize_t target      = 0;
+
+            if (action == 0)
+            {
+                // Random seek
+                target              = (seed >> 12) % count;
+                UTEST_ASSERT(is.seek(target) == wssize_t(target));
+            }
+            else if (action == 1)
+            {
+                // Short seek backward within the buffer
+                target              = (pos > 10) ? pos - 10 : 0;
+                UTEST_ASSERT(is.seek(target) == wssize_t(target));
+            }
+            else
+            {
+                // Skip forward
+                wsize_t amount      = (seed >> 12) % (buf_size * 4);
+                wssize_t skipped    = is.skip(amount);
+                target              = pos;
+                if (pos >= count)
+                    UTEST_ASSERT(skipped == ((amount > 0) ? -STATUS_EOF : 0));
+                else
+                {
+                    UTEST_ASSERT(skipped == wssize_t(lsp_min(amount, count - pos)));
+                    target             += skipped;
+                }
+            }
+            UTEST_ASSERT(is.position() == wssize_t(target));
+
+            // Read and check data
+            ssize_t n           = read_all(&is, buf, sizeof(buf));
+            if (target >= count)
+            {
+                UTEST_ASSERT(n == -STATUS_EOF);
+                continue;
+            }
+            UTEST_ASSERT(n == ssize_t(lsp_min(sizeof(buf), count - target)));
+            UTEST_ASSERT(memcmp(buf, &data[target], n) == 0);
+            UTEST_ASSERT(is.position() == wssize_t(target + n));
+        }
+
+        UTEST_ASSERT(is.close() == STATUS_OK);
+    }
+
+    void check_error(ipc::IExecutor *executor, const uint8_t *data, size_t count)
+    {
+        printf("  testing error propagation executor=%s\n", (executor != NULL) ? "true" : "false");
+
+        uint8_t buf[0x1000];
+        const size_t limit = count / 2 + 17;
+        FailingStream fs(data, count, limit);
+        io::InAsyncStream is(executor);
+        UTEST_ASSERT(is.wrap(&fs, 0, 3, 1000) == STATUS_OK);
+
+        size_t total = 0;
+        ssize_t n;
+        while ((n = is.read(buf, sizeof(buf))) > 0)
+        {
+            UTEST_ASSERT(memcmp(buf, &data[total], n) == 0);
+            total          += n;
+        }
+        UTEST_ASSERT(n == -STATUS_IO_ERROR);
+        UTEST_ASSERT(total == limit);
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) == -STATUS_IO_ERROR);
+
+        // Seek should restart the read-ahead
+        UTEST_ASSERT(is.seek(10) == 10);
+        UTEST_ASSERT(read_all(&is, buf, sizeof(buf)) == sizeof(buf));
+        UTEST_ASSERT(memcmp(buf, &data[10], sizeof(buf)) == 0);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+    }
+
+    void test_stream(ipc::IExecutor *executor, const uint8_t *data)
+    {
+        static const size_t depths[]    = { 1, 2, 5 };
+        static const size_t buf_sizes[] = { 1, 997, 0x4000 };
+
+        for (size_t i=0; i<sizeof(depths)/sizeof(depths[0]); ++i)
+            for (size_t j=0; j<sizeof(buf_sizes)/sizeof(buf_sizes[0]); ++j)
+            {
+                const size_t count = (buf_sizes[j] > 1) ? DATA_SIZE : DATA_SIZE / 64;
+                check_read(executor, data, count, depths[i], buf_sizes[j]);
+                check_seek(executor, data, count, depths[i], buf_sizes[j]);
+            }
+
+        check_error(executor, data, DATA_SIZE);
+    }
+
+    UTEST_MAIN
+    {
+        uint8_t *data = static_cast<uint8_t *>(malloc(DATA_SIZE));
+        UTEST_ASSERT(data != NULL);
+        lsp_finally { free(data); };
+        init_random(data, DATA_SIZE);
+
+        printf("Testing read-ahead on dedicated thread...\n");
+        test_stream(NULL, data);
+
+        printf("Testing read-ahead on executor...\n");
+        ipc::NativeExecutor executor;
+        UTEST_ASSERT(executor.start() == STATUS_OK);
+        lsp_finally { executor.shutdown(); };
+        test_stream(&executor, data);
+    }
+
+UTEST_END
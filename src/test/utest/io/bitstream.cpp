@@ -158,6 +158,212 @@ UTEST_BEGIN("runtime.io", bitstream)
         UTEST_ASSERT(ibs.close() == STATUS_OK);
     }
 
+    void init_values(uint64_t *dst, size_t count, uint64_t seed)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            seed        = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            dst[i]      = seed ^ (seed >> 29);
+        }
+    }
+
+    void test_bulk_values()
+    {
+        static constexpr size_t COUNT = 0x1000 + 7;
+        printf("Testing bulk read and write of values\n");
+
+        uint64_t *src   = static_cast<uint64_t *>(malloc(COUNT * sizeof(uint64_t) * 2));
+        UTEST_ASSERT(src != NULL);
+        lsp_finally { free(src); };
+        uint64_t *dst   = &src[COUNT];
+        init_values(src, COUNT, 0x1234);
+
+        UTEST_FOREACH(bits, 1, 3, 7, 8, 13, 17, 31, 32, 33, 57, 63, 64) {
+            printf("  bits=%d ...\n", int(bits));
+            const uint64_t mask = (bits < 64) ? (uint64_t(1) << bits) - 1 : ~uint64_t(0);
+
+            // Write values using bulk and scalar methods
+            io::OutMemoryStream oms1, oms2;
+            io::OutBitStream obs1, obs2;
+            UTEST_ASSERT(obs1.wrap(&oms1, WRAP_NONE) == STATUS_OK);
+            UTEST_ASSERT(obs2.wrap(&oms2, WRAP_NONE) == STATUS_OK);
+
+            UTEST_ASSERT(obs1.writev(true) == STATUS_OK);
+            UTEST_ASSERT(obs2.writev(true) == STATUS_OK);
+            UTEST_ASSERT(obs1.writen(src, COUNT, bits) == STATUS_OK);
+            for (size_t i=0; i<COUNT; ++i)
+                UTEST_ASSERT(obs2.writev(src[i], bits) == STATUS_OK);
+            UTEST_ASSERT(obs1.close() == STATUS_OK);
+            UTEST_ASSERT(obs2.close() == STATUS_OK);
+
+            UTEST_ASSERT(oms1.size() == (COUNT * bits + 8) / 8);
+            UTEST_ASSERT(oms1.size() == oms2.size());
+            UTEST_ASSERT(memcmp(oms1.data(), oms2.data(), oms1.size()) == 0);
+
+            // Read values using bulk method
+            io::InMemoryStream ims(oms1.data(), oms1.size());
+            io::InBitStream ibs;
+            bool b = false;
+            UTEST_ASSERT(ibs.wrap(&ims, WRAP_NONE) == STATUS_OK);
+            UTEST_ASSERT(ibs.readb(&b) == 1);
+            UTEST_ASSERT(b);
+            UTEST_ASSERT(ibs.readn(dst, 5, bits) == 5);
+            UTEST_ASSERT(ibs.readn(&dst[5], COUNT - 5, bits) == ssize_t(COUNT - 5));
+            for (size_t i=0; i<COUNT; ++i)
+                UTEST_ASSERT_MSG(dst[i] == (src[i] & mask),
+                    "Value #%d mismatch: 0x%llx vs 0x%llx", int(i),
+                    (unsigned long long)dst[i], (unsigned long long)(src[i] & mask));
+
+            // Incomplete value should not be consumed
+            UTEST_ASSERT(ibs.readn(dst, 1, 64) == -STATUS_EOF);
+            UTEST_ASSERT(ibs.close() == STATUS_OK);
+
+            // Read values using narrow types
+            io::InMemoryStream ims2(oms1.data(), oms1.size());
+            UTEST_ASSERT(ibs.wrap(&ims2, WRAP_NONE) == STATUS_OK);
+            UTEST_ASSERT(ibs.readb(&b) == 1);
+            if (bits <= 16)
+            {
+                uint16_t *v16   = reinterpret_cast<uint16_t *>(dst);
+                UTEST_ASSERT(ibs.readn(v16, COUNT, bits) == ssize_t(COUNT));
+                for (size_t i=0; i<COUNT; ++i)
+                    UTEST_ASSERT(v16[i] == uint16_t(src[i] & mask));
+            }
+            else if (bits <= 32)
+            {
+                uint32_t *v32   = reinterpret_cast<uint32_t *>(dst);
+                UTEST_ASSERT(ibs.readn(v32, COUNT, bits) == ssize_t(COUNT));
+                for (size_t i=0; i<COUNT; ++i)
+                    UTEST_ASSERT(v32[i] == uint32_t(src[i] & mask));
+            }
+            UTEST_ASSERT(ibs.close() == STATUS_OK);
+        }
+    }
+
+    status_t write_varint_ref(io::OutBitStream *obs, uint64_t value, size_t bits, size_t step)
+    {
+        do
+        {
+            const uint64_t max  = uint64_t(1) << bits;
+            const uint64_t b    = (value >= max) ? max | (value & (max - 1)) : value;
+            status_t res        = obs->writev(b, bits + 1);
+            if (res != STATUS_OK)
+                return res;
+
+            value             >>= bits;
+            bits               += step;
+        } while (value > 0);
+
+        return STATUS_OK;
+    }
+
+    void test_varint(size_t bits, size_t step)
+    {
+        static constexpr size_t COUNT = 0x800;
+        printf("Testing variable-length integers bits=%d, step=%d\n", int(bits), int(step));
+
+        uint64_t *src   = static_cast<uint64_t *>(malloc(COUNT * sizeof(uint64_t) * 2));
+        UTEST_ASSERT(src != NULL);
+        lsp_finally { free(src); };
+        uint64_t *dst   = &src[COUNT];
+        uint32_t v32[COUNT];
+
+        // Generate values of different magnitude
+        init_values(src, COUNT, 0x5678);
+        for (size_t i=0; i<COUNT; ++i)
+            src[i]     &= uint64_t(0xffffffff) >> (i % 33);
+        src[0]      = 0;
+        src[1]      = (uint64_t(1) << bits) - 1;
+        src[2]      = uint64_t(1) << bits;
+        src[3]      = 0xffffffff;
+
+        // Write values
+        io::OutMemoryStream oms1, oms2;
+        io::OutBitStream obs1, obs2;
+        UTEST_ASSERT(obs1.wrap(&oms1, WRAP_NONE) == STATUS_OK);
+        UTEST_ASSERT(obs2.wrap(&oms2, WRAP_NONE) == STATUS_OK);
+        UTEST_ASSERT(obs1.writevar(src, COUNT / 2, bits, step) == STATUS_OK);
+        for (size_t i=COUNT/2; i<COUNT; ++i)
+            UTEST_ASSERT(obs1.writevar(src[i], bits, step) == STATUS_OK);
+        for (size_t i=0; i<COUNT; ++i)
+            UTEST_ASSERT(write_varint_ref(&obs2, src[i], bits, step) == STATUS_OK);
+        UTEST_ASSERT(obs1.close() == STATUS_OK);
+        UTEST_ASSERT(obs2.close() == STATUS_OK);
+
+        UTEST_ASSERT(oms1.size() == oms2.size());
+        UTEST_ASSERT(memcmp(oms1.data(), oms2.data(), oms1.size()) == 0);
+
+        // Read values
+        io::InMemoryStream ims(oms1.data(), oms1.size());
+        io::InBitStream ibs;
+        UTEST_ASSERT(ibs.wrap(&ims, WRAP_NONE) == STATUS_OK);
+        UTEST_ASSERT(ibs.readvar(dst, 1, bits, step) == 1);
+        UTEST_ASSERT(ibs.readvar(&dst[1], COUNT/2 - 1, bits, step) == ssize_t(COUNT/2 - 1));
+        UTEST_ASSERT(ibs.readvar(v32, COUNT/2, bits, step) == ssize_t(COUNT/2));
+        for (size_t i=0; i<COUNT/2; ++i)
+            dst[COUNT/2 + i]    = v32[i];
+        UTEST_ASSERT(ibs.close() == STATUS_OK);
+
+        for (size_t i=0; i<COUNT; ++i)
+            UTEST_ASSERT_MSG(dst[i] == src[i],
+                "Value #%d mismatch: 0x%llx vs 0x%llx", int(i),
+                (unsigned long long)dst[i], (unsigned long long)src[i]);
+
+        // Truncated data
+        io::InMemoryStream ims2(oms1.data(), 1);
+        UTEST_ASSERT(ibs.wrap(&ims2, WRAP_NONE) == STATUS_OK);
+        UTEST_ASSERT(ibs.readvar(dst, COUNT, bits, step) < ssize_t(COUNT));
+        UTEST_ASSERT(ibs.close() == STATUS_OK);
+    }
+
+    void test_large_blocks()
+    {
+        static constexpr size_t COUNT = 0x3000 + 5;
+        printf("Testing large block transfers\n");
+
+        uint8_t *src    = static_cast<uint8_t *>(malloc(COUNT * 2));
+        UTEST_ASSERT(src != NULL);
+        lsp_finally { free(src); };
+        uint8_t *dst    = &src[COUNT];
+        for (size_t i=0; i<COUNT; ++i)
+            src[i]          = uint8_t(i * 13 + (i >> 7));
+
+        // Write aligned and unaligned blocks
+        io::OutMemoryStream oms;
+        io::OutBitStream obs;
+        UTEST_ASSERT(obs.wrap(&oms, WRAP_NONE) == STATUS_OK);
+        UTEST_ASSERT(obs.write(src, COUNT) == ssize_t(COUNT));
+        UTEST_ASSERT(obs.writev(uint8_t(0x5), 3) == STATUS_OK);
+        UTEST_ASSERT(obs.write(src, COUNT) == ssize_t(COUNT));
+        UTEST_ASSERT(obs.bwrite(src, COUNT * 8 - 3) == ssize_t(COUNT * 8 - 3));
+        UTEST_ASSERT(obs.close() == STATUS_OK);
+        UTEST_ASSERT(oms.size() == COUNT * 3);
+
+        // Read the data
+        io::InMemoryStream ims(oms.data(), oms.size());
+        io::InBitStream ibs;
+        uint8_t v = 0;
+        UTEST_ASSERT(ibs.wrap(&ims, WRAP_NONE) == STATUS_OK);
+        UTEST_ASSERT(ibs.read(dst, 7) == 7);
+        UTEST_ASSERT(ibs.read(&dst[7], COUNT - 7) == ssize_t(COUNT - 7));
+        UTEST_ASSERT(memcmp(dst, src, COUNT) == 0);
+        UTEST_ASSERT(ibs.readv(&v, 3) == 3);
+        UTEST_ASSERT(v == 0x5);
+        UTEST_ASSERT(ibs.read(dst, COUNT) == ssize_t(COUNT));
+        UTEST_ASSERT(memcmp(dst, src, COUNT) == 0);
+
+        // Skip bits and read the tail
+        UTEST_ASSERT(ibs.bskip(0x1000 * 8 + 3) == 0x1000 * 8 + 3);
+        UTEST_ASSERT(ibs.readv(&v, 5) == 5);
+        UTEST_ASSERT(v == (src[0x1000] & 0x1f));
+        UTEST_ASSERT(ibs.read(dst, COUNT) == ssize_t(COUNT - 0x1001 - 1));
+        UTEST_ASSERT(memcmp(dst, &src[0x1001], COUNT - 0x1001 - 1) == 0);
+        UTEST_ASSERT(ibs.readv(&v, 8) == 5);
+        UTEST_ASSERT(v == (src[COUNT - 1] & 0x1f));
+        UTEST_ASSERT(ibs.read(dst, 1) == -STATUS_EOF);
+        UTEST_ASSERT(ibs.close() == STATUS_OK);
+    }
+
     UTEST_MAIN
     {
         io::OutMemoryStream oms;
@@ -208,6 +414,12 @@ UTEST_BEGIN("runtime.io", bitstream)
 
         // Drop the array
         oms.drop();
+
+        test_bulk_values();
+        test_varint(6, 0);
+        test_varint(3, 2);
+        test_varint(1, 1);
+        test_large_blocks();
     }
 
 UTEST_END
@@ -163,10 +163,10 @@ namespace lsp
         { "\xe0\x80\x80Test", 7, 7, 3 },           // Invalid sequence + text
         { "\xe0\x80\x80\x80", 4, 4, 4 },           // Two invalid sequences
         { "\xe0\x80\x80\x80Test", 8, 8, 4 },       // Two invalid sequences + text
-        { "\xed\xa0\x80", 1, 1, 1 },               // Invalid codepoint (surrogate)
-        { "\xed\xa0\x80Test", 5, 5, 1 },           // Invalid codepoint (surrogate) + text
-        { "\xed\xa0\x80\xed\xa0\x8f", 2, 2, 2 },   // Two invalid codepoints (surrogate)
-        { "\xed\xa0\x80\xed\xa0\x8fTest", 6, 6, 2 },   // Two invalid codepoints (surrogate) + text
+        { "\xed\xa0\x80", 3, 3, 3 },               // Invalid codepoint (surrogate)
+        { "\xed\xa0\x80Test", 7, 7, 3 },           // Invalid codepoint (surrogate) + text
+        { "\xed\xa0\x80\xed\xa0\x8f", 6, 6, 6 },   // Two invalid codepoints (surrogate)
+        { "\xed\xa0\x80\xed\xa0\x8fTest", 10, 10, 6 },  // Two invalid codepoints (surrogate) + text
         { "\xc0\xbf\xcb\xbf", 3, 3, 2 },           // One valid codepoint, one invalid (2 errors)
         { "\xc0\xbf\xcb\xbfTest", 7, 7, 2 },       // One valid codepoint, one invalid (2 errors) + text
         { "\xf0\x90\x80\x8f", 2, 1, 0 },           // Surrogate pair at output
@@ -713,8 +713,8 @@ UTEST_BEGIN("runtime.io", charset)
             0x4a9, 0x4ab, 0x4ad, 0x4af,
             0x4b1, 0x4b3, 0x4b5, 0x4b7,
             0x4b9, 0x4bb, 0x4bd, 0x4bf,
-            0x4c1, 0x4c3, 0x4c5, 0x4c7,
-            0x4c9, 0x4cb, 0x4cd, 0x4cf,
+            0x4cf, 0x4c2, 0x4c4, 0x4c6,
+            0x4c8, 0x4ca, 0x4cc, 0x4ce,
             0x4d1, 0x4d3, 0x4d5, 0x4d7,
             0x4d9, 0x4db, 0x4dd, 0x4df,
             0x4e1, 0x4e3, 0x4e5, 0x4e7,
@@ -773,8 +773,8 @@ UTEST_BEGIN("runtime.io", charset)
             0x4a8, 0x4aa, 0x4ac, 0x4ae,
             0x4b0, 0x4b2, 0x4b4, 0x4b6,
             0x4b8, 0x4ba, 0x4bc, 0x4be,
-            0x4c0, 0x4c2, 0x4c4, 0x4c6,
-            0x4c8, 0x4ca, 0x4cc, 0x4ce,
+            0x4c0, 0x4c1, 0x4c3, 0x4c5,
+            0x4c7, 0x4c9, 0x4cb, 0x4cd,
             0x4d0, 0x4d2, 0x4d4, 0x4d6,
             0x4d8, 0x4da, 0x4dc, 0x4de,
             0x4e0, 0x4e2, 0x4e4, 0x4e6,
@@ -820,6 +820,95 @@ UTEST_BEGIN("runtime.io", charset)
         }
     }
 
+    void check_unicode_case_mapping()
+    {
+        struct case_t
+        {
+            lsp_wchar_t code;
+            lsp_wchar_t lower;
+            lsp_wchar_t upper;
+            lsp_wchar_t fold;
+        };
+
+        static const case_t cases[] =
+        {
+            // ASCII and Latin-1
+            { '@',      '@',        '@',        '@'     },
+            { 'Q',      'q',        'Q',        'q'     },
+            { 0x00b5,   0x00b5,     0x039c,     0x03bc  },  // MICRO SIGN
+            { 0x00df,   0x00df,     0x00df,     0x00df  },  // SHARP S has no simple upper case
+            { 0x00ff,   0x00ff,     0x0178,     0x00ff  },
+            // Latin Extended and specials
+            { 0x0130,   'i',        0x0130,     0x0130  },  // CAPITAL I WITH DOT ABOVE
+            { 0x0131,   0x0131,     'I',        0x0131  },  // DOTLESS I
+            { 0x017f,   0x017f,     'S',        's'     },  // LONG S
+            { 0x1e9e,   0x00df,     0x1e9e,     0x00df  },  // CAPITAL SHARP S
+            { 0x212a,   'k',        0x212a,     'k'     },  // KELVIN SIGN
+            { 0x212b,   0x00e5,     0x212b,     0x00e5  },  // ANGSTROM SIGN
+            // Greek
+            { 0x03a3,   0x03c3,     0x03a3,     0x03c3  },  // CAPITAL SIGMA
+            { 0x03c2,   0x03c2,     0x03a3,     0x03c3  },  // FINAL SIGMA
+            { 0x03c3,   0x03c3,     0x03a3,     0x03c3  },  // SMALL SIGMA
+            { 0x1f88,   0x1f80,     0x1f88,     0x1f80  },  // Titlecase with PROSGEGRAMMENI
+            // Titlecase digraphs
+            { 0x01c5,   0x01c6,     0x01c4,     0x01c6  },
+            // Cyrillic and Armenian
+            { 0x0401,   0x0451,     0x0401,     0x0451  },
+            { 0x0561,   0x0561,     0x0531,     0x0561  },
+            // Georgian Mtavruli
+            { 0x1c90,   0x10d0,     0x1c90,     0x10d0  },
+            // Cherokee folds to upper case
+            { 0x13a0,   0xab70,     0x13a0,     0x13a0  },
+            { 0xab70,   0xab70,     0x13a0,     0x13a0  },
+            { 0x13f8,   0x13f8,     0x13f0,     0x13f0  },
+            // Fullwidth forms
+            { 0xff21,   0xff41,     0xff21,     0xff41  },
+            // Supplementary planes
+            { 0x10400,  0x10428,    0x10400,    0x10428 },  // Deseret
+            { 0x1e921,  0x1e943,    0x1e921,    0x1e943 },  // Adlam
+            // Characters without case
+            { 0x4e2d,   0x4e2d,     0x4e2d,     0x4e2d  },  // CJK
+            { 0x1e944,  0x1e944,    0x1e944,    0x1e944 },  // First character above tables
+            { 0x10ffff, 0x10ffff,   0x10ffff,   0x10ffff},
+            { 0x110000, 0x110000,   0x110000,   0x110000}   // Out of range
+        };
+
+        printf("Testing lsp::to_lower(), lsp::to_upper() and lsp::to_casefold() for unicode character set\n");
+
+        for (size_t i=0; i<sizeof(cases)/sizeof(cases[0]); ++i)
+        {
+            const case_t *c = &cases[i];
+            const lsp_wchar_t lc = lsp::to_lower(c->code);
+            const lsp_wchar_t uc = lsp::to_upper(c->code);
+            const lsp_wchar_t fc = lsp::to_casefold(c->code);
+
+            UTEST_ASSERT_MSG(lc == c->lower,
+                "Failed lower case mapping of 0x%x: expected 0x%x, got 0x%x", int(c->code), int(c->lower), int(lc));
+            UTEST_ASSERT_MSG(uc == c->upper,
+                "Failed upper case mapping of 0x%x: expected 0x%x, got 0x%x", int(c->code), int(c->upper), int(uc));
+            UTEST_ASSERT_MSG(fc == c->fold,
+                "Failed case folding of 0x%x: expected 0x%x, got 0x%x", int(c->code), int(c->fold), int(fc));
+        }
+
+        // ASCII fast path should match the plain definition for all ASCII characters
+        for (lsp_wchar_t c=0; c<0x80; ++c)
+        {
+            const lsp_wchar_t lc = ((c >= 'A') && (c <= 'Z')) ? c + 0x20 : c;
+            const lsp_wchar_t uc = ((c >= 'a') && (c <= 'z')) ? c - 0x20 : c;
+            UTEST_ASSERT(lsp::to_lower(c) == lc);
+            UTEST_ASSERT(lsp::to_upper(c) == uc);
+            UTEST_ASSERT(lsp::to_casefold(c) == lc);
+        }
+
+        // Case folding should be idempotent over the whole code space
+        for (lsp_wchar_t c=0; c<0x110000; ++c)
+        {
+            const lsp_wchar_t fc = lsp::to_casefold(c);
+            UTEST_ASSERT_MSG(lsp::to_casefold(fc) == fc,
+                "Case folding is not idempotent for 0x%x", int(c));
+        }
+    }
+
     UTEST_MAIN
     {
         check_utf8_to_utf16();
@@ -836,6 +925,7 @@ UTEST_BEGIN("runtime.io", charset)
 
         check_latin_lower_upper();
         check_cyrillic_lower_upper();
+        check_unicode_case_mapping();
     }
 UTEST_END;
 
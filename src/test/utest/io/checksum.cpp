@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/Checksum.h>
+#include <lsp-plug.in/io/InChecksumStream.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/io/OutChecksumStream.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define PATTERN_SIZE        1024
+
+namespace
+{
+    typedef struct vector_t
+    {
+        const char     *text;
+        size_t          length;
+        uint32_t        crc32;
+        uint32_t        crc32c;
+        uint64_t        xxh64;
+        uint64_t        xxh64_seed;
+    } vector_t;
+
+    static const uint64_t XXH64_SEED    = 0x12345678;
+
+    static const vector_t vectors[] =
+    {
+        { "", 0, 0x00000000, 0x00000000, 0xef46db3751d8e999ULL, 0x30b93d611716104aULL },
+        { "a", 1, 0xe8b7be43, 0xc1d04330, 0xd24ec4f1a98c6e5bULL, 0x8e1699d2043ffd2cULL },
+        { "abc", 3, 0x352441c2, 0x364b3fb7, 0x44bc2cf5ad770999ULL, 0x0f7fd1655f1af42bULL },
+        { "123456789", 9, 0xcbf43926, 0xe3069283, 0, 0 },
+        { "Nobody inspects the spammish repetition", 39, 0, 0, 0xfbcea83c8a378bf1ULL, 0x20c5796b7cbca621ULL },
+        { NULL, PATTERN_SIZE, 0xb70b4c26, 0x2cdf6e8f, 0x6f3914f18fe4df57ULL, 0x7e34240c3c31e086ULL }
+    };
+
+    static const lsp::io::checksum_kernel_t kernels[] =
+    {
+        lsp::io::CHECKSUM_KERNEL_GENERIC,
+        lsp::io::CHECKSUM_KERNEL_SSE42,
+        lsp::io::CHECKSUM_KERNEL_ARMV8
+    };
+
+    static const char *kernel_names[] =
+    {
+        "generic",
+        "sse4.2",
+        "armv8"
+    };
+}
+
+UTEST_BEGIN("runtime.io", checksum)
+
+    void init_pattern(uint8_t *buf)
+    {
+        for (size_t i=0; i<PATTERN_SIZE; ++i)
+            buf[i]      = uint8_t(i);
+    }
+
+    const void *vector_data(const vector_t *v, const uint8_t *pattern)
+    {
+        return (v->text != NULL) ? static_cast<const void *>(v->text) : pattern;
+    }
+
+    void test_vectors(const uint8_t *pattern)
+    {
+        for (size_t k=0; k<sizeof(kernels)/sizeof(kernels[0]); ++k)
+        {
+            if (io::select_checksum_kernel(kernels[k]) != STATUS_OK)
+            {
+                printf("Checksum kernel %s is not supported, skipping\n", kernel_names[k]);
+                continue;
+            }
+            printf("Testing CRC vectors for kernel %s\n", kernel_names[k]);
+            UTEST_ASSERT(io::checksum_kernel() == kernels[k]);
+
+            for (size_t i=0; i<sizeof(vectors)/sizeof(vectors[0]); ++i)
+            {
+                const vector_t *v   = &vectors[i];
+                const void *data    = vector_data(v, pattern);
+
+                if ((v->crc32 != 0) || (v->length == 0))
+                {
+                    const uint32_t crc = io::crc32(0, data, v->length);
+                    UTEST_ASSERT_MSG(crc == v->crc32, "CRC-32 of vector %d: 0x%08x, expected 0x%08x",
+                        int(i), int(crc), int(v->crc32));
+                }
+                if ((v->crc32c != 0) || (v->length == 0))
+                {
+                    const uint32_t crc = io::crc32c(0, data, v->length);
+                    UTEST_ASSERT_MSG(crc == v->crc32c, "CRC-32C of vector %d: 0x%08x, expected 0x%08x",
+                        int(i), int(crc), int(v->crc32c));
+                }
+            }
+        }
+
+        UTEST_ASSERT(io::select_checksum_kernel(io::CHECKSUM_KERNEL_AUTO) == STATUS_OK);
+
+        printf("Testing xxHash64 vectors\n");
+        for (size_t i=0; i<sizeof(vectors)/sizeof(vectors[0]); ++i)
+        {
+            const vector_t *v   = &vectors[i];
+            if (v->xxh64 == 0)
+                continue;
+            const void *data    = vector_data(v, pattern);
+
+            const uint64_t h1   = io::xxh64(data, v->length);
+            const uint64_t h2   = io::xxh64(data, v->length, XXH64_SEED);
+            UTEST_ASSERT_MSG(h1 == v->xxh64, "xxHash64 of vector %d: 0x%llx, expected 0x%llx",
+                int(i), (unsigned long long)h1, (unsigned long long)v->xxh64);
+            UTEST_ASSERT_MSG(h2 == v->xxh64_seed, "Seeded xxHash64 of vector %d: 0x%llx, expected 0x%llx",
+                int(i), (unsigned long long)h2, (unsigned long long)v->xxh64_seed);
+        }
+    }
+
+    void test_kernels_match()
+    {
+        printf("Testing kernels on unaligned data of different sizes\n");
+
+        uint8_t buf[8000];
+        for (size_t i=0; i<sizeof(buf); ++i)
+            buf[i]      = uint8_t(i * 0x9d + (i >> 3));
+
+        for (size_t off=0; off<8; ++off)
+            for (size_t len=0; len<sizeof(buf) - off; len += (len < 300) ? 7 : 491)
+            {
+                UTEST_ASSERT(io::select_checksum_kernel(io::CHECKSUM_KERNEL_GENERIC) == STATUS_OK);
+                const uint32_t ref32    = io::crc32(0, &buf[off], len);
+                const uint32_t ref32c   = io::crc32c(0, &buf[off], len);
+
+                for (size_t k=0; k<sizeof(kernels)/sizeof(kernels[0]); ++k)
+                {
+                    if (io::select_checksum_kernel(kernels[k]) != STATUS_OK)
+                        continue;
+                    UTEST_ASSERT(io::crc32(0, &buf[off], len) == ref32);
+                    UTEST_ASSERT(io::crc32c(0, &buf[off], len) == ref32c);
+                }
+            }
+
+        UTEST_ASSERT(io::select_checksum_kernel(io::CHECKSUM_KERNEL_AUTO) == STATUS_OK);
+    }
+
+    void test_incremental(const uint8_t *pattern)
+    {
+        static const io::checksum_t types[] = { io::CHECKSUM_CRC32, io::CHECKSUM_CRC32C, io::CHECKSUM_XXH64 };
+
+        printf("Testing incremental computation\n");
+        const vector_t *v = &vectors[sizeof(vectors)/sizeof(vectors[0]) - 1];
+        const uint64_t expected[] = { v->crc32, v->crc32c, v->xxh64 };
+
+        UTEST_FOREACH(step, 1, 3, 8, 13, 31, 32, 33, 100, 1000) {
+            for (size_t i=0; i<3; ++i)
+            {
+                io::Checksum cs(types[i]);
+                UTEST_ASSERT(cs.type() == types[i]);
+                UTEST_ASSERT(cs.size() == ((types[i] == io::CHECKSUM_XXH64) ? 8 : 4));
+
+                for (size_t off=0; off<PATTERN_SIZE; off += step)
+                    cs.update(&pattern[off], lsp_min(size_t(step), PATTERN_SIZE - off));
+                UTEST_ASSERT(cs.processed() == PATTERN_SIZE);
+                UTEST_ASSERT_MSG(cs.value() == expected[i], "Checksum %d with step %d: 0x%llx, expected 0x%llx",
+                    int(i), int(step), (unsigned long long)cs.value(), (unsigned long long)expected[i]);
+
+                cs.reset();
+                UTEST_ASSERT(cs.processed() == 0);
+                cs.update(pattern, PATTERN_SIZE);
+                UTEST_ASSERT(cs.value() == expected[i]);
+            }
+        }
+
+        io::Checksum cs;
+        UTEST_ASSERT(cs.init(io::CHECKSUM_XXH64, XXH64_SEED) == STATUS_OK);
+        cs.update(pattern, 100);
+        cs.update(&pattern[100], PATTERN_SIZE - 100);
+        UTEST_ASSERT(cs.value() == v->xxh64_seed);
+        UTEST_ASSERT(cs.init(io::checksum_t(-1)) == STATUS_BAD_ARGUMENTS);
+    }
+
+    void test_streams(const uint8_t *pattern)
+    {
+        printf("Testing checksum streams\n");
+        const vector_t *v = &vectors[sizeof(vectors)/sizeof(vectors[0]) - 1];
+
+        // Output stream
+        io::OutMemoryStream oms;
+        io::OutChecksumStream os;
+        UTEST_ASSERT(os.write(pattern, 1) < 0);
+        UTEST_ASSERT(os.wrap(&oms) == STATUS_OK);
+        UTEST_ASSERT(os.set_checksum(io::CHECKSUM_XXH64) == STATUS_BAD_STATE);
+        UTEST_ASSERT(os.write(pattern, 10) == 10);
+        UTEST_ASSERT(os.write_byte(pattern[10]) == STATUS_OK);
+        UTEST_ASSERT(os.write(&pattern[11], PATTERN_SIZE - 11) == PATTERN_SIZE - 11);
+        UTEST_ASSERT(os.position() == PATTERN_SIZE);
+        UTEST_ASSERT(os.flush() == STATUS_OK);
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(os.value() == v->crc32c);
+        UTEST_ASSERT(oms.size() == PATTERN_SIZE);
+        UTEST_ASSERT(memcmp(oms.data(), pattern, PATTERN_SIZE) == 0);
+
+        // Input stream
+        uint8_t buf[PATTERN_SIZE];
+        io::InMemoryStream ims(pattern, PATTERN_SIZE);
+        io::InChecksumStream is;
+        UTEST_ASSERT(is.set_checksum(io::CHECKSUM_XXH64, XXH64_SEED) == STATUS_OK);
+        UTEST_ASSERT(is.wrap(&ims) == STATUS_OK);
+        UTEST_ASSERT(is.avail() == PATTERN_SIZE);
+        UTEST_ASSERT(is.read(buf, 5) == 5);
+        UTEST_ASSERT(is.read_byte() == pattern[5]);
+        UTEST_ASSERT(is.skip(100) == 100);
+        UTEST_ASSERT(is.position() == 106);
+        UTEST_ASSERT(is.seek(0) < 0);
+        UTEST_ASSERT(is.read_fully(&buf[106], PATTERN_SIZE - 106) == PATTERN_SIZE - 106);
+        UTEST_ASSERT(is.read(buf, 1) == -STATUS_EOF);
+        UTEST_ASSERT(is.checksum()->processed() == PATTERN_SIZE);
+        UTEST_ASSERT(is.value() == v->xxh64_seed);
+        UTEST_ASSERT(memcmp(&buf[106], &pattern[106], PATTERN_SIZE - 106) == 0);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+        UTEST_ASSERT(is.read(buf, 1) < 0);
+    }
+
+    UTEST_MAIN
+    {
+        uint8_t pattern[PATTERN_SIZE];
+        init_pattern(pattern);
+
+        test_vectors(pattern);
+        test_kernels_match();
+        test_incremental(pattern);
+        test_streams(pattern);
+    }
+
+UTEST_END
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InCompressedStream.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/io/OutCompressedStream.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define LOG_BLOCK_SIZE      10
+
+UTEST_BEGIN("runtime.io", compressedstream)
+
+    void init_text(uint8_t *dst, size_t count)
+    {
+        static const char *words[] = { "lorem ", "ipsum ", "dolor ", "sit ", "amet, ", "\n", "consectetur ", "adipiscing ", "elit. " };
+        size_t seed = 1;
+        for (size_t i=0; i<count; )
+        {
+            seed            = seed * 1103515245 + 12345;
+            const char *w   = words[(seed >> 16) % (sizeof(words) / sizeof(words[0]))];
+            for ( ; (*w != '\0') && (i < count); ++w, ++i)
+                dst[i]          = *w;
+        }
+    }
+
+    void init_random(uint8_t *dst, size_t count)
+    {
+        uint32_t seed = 0x12345678;
+        for (size_t i=0; i<count; ++i)
+        {
+            seed            = seed * 1664525 + 1013904223;
+            dst[i]          = uint8_t(seed >> 24);
+        }
+    }
+
+    void compress(io::OutMemoryStream *dst, const uint8_t *src, size_t count, size_t chunk)
+    {
+        io::OutCompressedStream os(LOG_BLOCK_SIZE);
+        UTEST_ASSERT(os.write(src, 1) == -STATUS_CLOSED);
+        UTEST_ASSERT(os.wrap(dst) == STATUS_OK);
+        UTEST_ASSERT(os.wrap(dst) == STATUS_BAD_STATE);
+        UTEST_ASSERT(os.block_size() == (1 << LOG_BLOCK_SIZE));
+
+        for (size_t off = 0; off < count; )
+        {
+            const size_t to_write = lsp_min(chunk, count - off);
+            UTEST_ASSERT(os.write(&src[off], to_write) == ssize_t(to_write));
+            off            += to_write;
+            UTEST_ASSERT(os.position() == wssize_t(off));
+        }
+
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(os.compressed_size() == dst->size());
+    }
+
+    void check_decompress(const io::OutMemoryStream *src, const uint8_t *data, size_t count, size_t chunk)
+    {
+        io::InMemoryStream ims(src->data(), src->size());
+        io::InCompressedStream is;
+        UTEST_ASSERT(is.wrap(&ims) == STATUS_OK);
+        UTEST_ASSERT(is.block_size() == (1 << LOG_BLOCK_SIZE));
+
+        uint8_t *buf = static_cast<uint8_t *>(malloc(count + 1));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+
+        size_t off = 0;
+        while (true)
+        {
+            const ssize_t n = is.read(&buf[off], lsp_min(chunk, count + 1 - off));
+            if (n < 0)
+            {
+                UTEST_ASSERT_MSG(n == -STATUS_EOF, "Unexpected error code %d", int(-n));
+                break;
+            }
+            UTEST_ASSERT(n > 0);
+            off            += n;
+            UTEST_ASSERT(is.position() == wssize_t(off));
+        }
+
+        UTEST_ASSERT_MSG(off == count, "Decompressed %d bytes, expected %d", int(off), int(count));
+        UTEST_ASSERT(memcmp(buf, data, count) == 0);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+    }
+
+    void test_round_trip()
+    {
+        static const size_t sizes[]     = { 0, 1, 17, 1023, 1024, 1025, 5000, 0x10000 };
+        static const size_t chunks[]    = { 1, 7, 1000, 1024, 0x10000 };
+
+        uint8_t *data = static_cast<uint8_t *>(malloc(0x10000 * 2));
+        UTEST_ASSERT(data != NULL);
+        lsp_finally { free(data); };
+        uint8_t *rnd = &data[0x10000];
+        init_text(data, 0x10000);
+        init_random(rnd, 0x10000);
+
+        for (size_t size: sizes)
+            for (size_t chunk: chunks)
+            {
+                printf("Testing round trip size=%d, chunk=%d\n", int(size), int(chunk));
+
+                io::OutMemoryStream text, random;
+                compress(&text, data, size, chunk);
+                compress(&random, rnd, size, chunk);
+
+                // Random data should be stored
+                if (size >= 0x1000)
+                {
+                    UTEST_ASSERT(text.size() < size / 2);
+                    UTEST_ASSERT(random.size() > size);
+                    UTEST_ASSERT(random.size() < size + size / 16);
+                }
+
+                check_decompress(&text, data, size, chunk);
+                check_decompress(&random, rnd, size, chunk);
+            }
+    }
+
+    void test_flush()
+    {
+        printf("Testing flush\n");
+
+        uint8_t data[3000];
+        init_text(data, sizeof(data));
+
+        io::OutMemoryStream oms;
+        io::OutCompressedStream os(LOG_BLOCK_SIZE);
+        UTEST_ASSERT(os.wrap(&oms) == STATUS_OK);
+        UTEST_ASSERT(os.write(data, 100) == 100);
+        UTEST_ASSERT(os.flush() == STATUS_OK);
+        UTEST_ASSERT(oms.size() > 0);
+        UTEST_ASSERT(os.flush() == STATUS_OK);
+        UTEST_ASSERT(os.write(&data[100], sizeof(data) - 100) == ssize_t(sizeof(data) - 100));
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(os.flush() == STATUS_CLOSED);
+
+        check_decompress(&oms, data, sizeof(data), 333);
+    }
+
+    void test_seek()
+    {
+        printf("Testing seek and skip\n");
+
+        const size_t size = 10000;
+        uint8_t *data = static_cast<uint8_t *>(malloc(size));
+        UTEST_ASSERT(data != NULL);
+        lsp_finally { free(data); };
+        init_text(data, size);
+
+        io::OutMemoryStream oms;
+        compress(&oms, data, size, size);
+
+        static const wsize_t positions[] = { 5000, 10, 9999, 1024, 1023, 0, 8000, 20000, 3000, 10000, 2047 };
+        uint8_t buf[16];
+
+        // Seek to different positions
+        io::InMemoryStream ims(oms.data(), oms.size());
+        io::InCompressedStream is;
+        UTEST_ASSERT(is.seek(0) == -STATUS_CLOSED);
+        UTEST_ASSERT(is.wrap(&ims) == STATUS_OK);
+
+        for (wsize_t pos: positions)
+        {
+            const wsize_t expected = lsp_min(pos, wsize_t(size));
+            UTEST_ASSERT_MSG(is.seek(pos) == wssize_t(expected), "Failed seek to %d", int(pos));
+            UTEST_ASSERT(is.position() == wssize_t(expected));
+
+            const ssize_t n = is.read(buf, sizeof(buf));
+            if (expected >= size)
+            {
+                UTEST_ASSERT(n == -STATUS_EOF);
+                continue;
+            }
+
+            const size_t avail = lsp_min(sizeof(buf), size_t(size - expected));
+            UTEST_ASSERT(n == ssize_t(avail));
+            UTEST_ASSERT(memcmp(buf, &data[expected], avail) == 0);
+        }
+
+        // Skip data
+        UTEST_ASSERT(is.seek(100) == 100);
+        UTEST_ASSERT(is.skip(2000) == 2000);
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) == sizeof(buf));
+        UTEST_ASSERT(memcmp(buf, &data[2100], sizeof(buf)) == 0);
+        UTEST_ASSERT(is.skip(100000) == wssize_t(size - 2100 - sizeof(buf)));
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) == -STATUS_EOF);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+
+        // Skip data of fresh stream
+        ims.seek(0);
+        UTEST_ASSERT(is.wrap(&ims) == STATUS_OK);
+        UTEST_ASSERT(is.skip(7000) == 7000);
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) == sizeof(buf));
+        UTEST_ASSERT(memcmp(buf, &data[7000], sizeof(buf)) == 0);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+    }
+
+    void test_corrupted()
+    {
+        printf("Testing corrupted data\n");
+
+        const size_t size = 5000;
+        uint8_t data[size], buf[size];
+        init_text(data, size);
+
+        io::OutMemoryStream oms;
+        compress(&oms, data, size, size);
+
+        uint8_t *copy = static_cast<uint8_t *>(malloc(oms.size()));
+        UTEST_ASSERT(copy != NULL);
+        lsp_finally { free(copy); };
+
+        // Invalid stream header
+        memcpy(copy, oms.data(), oms.size());
+        copy[0] = 'X';
+        {
+            io::InMemoryStream ims(copy, oms.size());
+            io::InCompressedStream is;
+            UTEST_ASSERT(is.wrap(&ims) == STATUS_BAD_FORMAT);
+            UTEST_ASSERT(is.read(buf, 1) == -STATUS_CLOSED);
+        }
+
+        // Modified payload
+        memcpy(copy, oms.data(), oms.size());
+        copy[oms.size() / 2] ^= 0x10;
+        {
+            io::InMemoryStream ims(copy, oms.size());
+            io::InCompressedStream is;
+            UTEST_ASSERT(is.wrap(&ims) == STATUS_OK);
+            ssize_t n = 0;
+            while ((n = is.read(buf, sizeof(buf))) > 0) {}
+            UTEST_ASSERT_MSG(n == -STATUS_CORRUPTED, "Unexpected result %d", int(n));
+        }
+
+        // Truncated stream
+        {
+            io::InMemoryStream ims(oms.data(), oms.size() - 4);
+            io::InCompressedStream is;
+            UTEST_ASSERT(is.wrap(&ims) == STATUS_OK);
+            ssize_t n = is.read_fully(buf, size);
+            UTEST_ASSERT(n == ssize_t(size));
+            UTEST_ASSERT(memcmp(buf, data, size) == 0);
+            UTEST_ASSERT(is.read(buf, 1) == -STATUS_CORRUPTED);
+        }
+    }
+
+    UTEST_MAIN
+    {
+        test_round_trip();
+        test_flush();
+        test_seek();
+        test_corrupted();
+    }
+
+UTEST_END
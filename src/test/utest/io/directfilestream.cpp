@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/AlignedBufferPool.h>
+#include <lsp-plug.in/io/File.h>
+#include <lsp-plug.in/io/InDirectFileStream.h>
+#include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/io/OutDirectFileStream.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define BUF_SIZE        0x4000
+#define DATA_SIZE       (BUF_SIZE * 4 + 0x1234)
+
+UTEST_BEGIN("runtime.io", directfilestream)
+
+    void init_data(uint8_t *dst, size_t count, uint32_t seed)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            seed            = seed * 1664525 + 1013904223;
+            dst[i]          = uint8_t(seed >> 24);
+        }
+    }
+
+    void check_file(const LSPString *path, const uint8_t *data, size_t size)
+    {
+        uint8_t *buf = static_cast<uint8_t *>(malloc(size + 1));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+
+        io::InFileStream is;
+        UTEST_ASSERT(is.open(path) == STATUS_OK);
+        const ssize_t n = (size > 0) ? is.read_fully(buf, size) : 0;
+        UTEST_ASSERT_MSG(n == ssize_t(size), "Read %d bytes, expected %d", int(n), int(size));
+        UTEST_ASSERT(memcmp(buf, data, size) == 0);
+        UTEST_ASSERT(is.read(buf, 1) == -STATUS_EOF);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+    }
+
+    void test_pool()
+    {
+        printf("Testing aligned buffer pool\n");
+
+        io::AlignedBufferPool pool(1000, 100);
+        UTEST_ASSERT(pool.alignment() == IO_DIRECT_DEFAULT_ALIGN);
+        UTEST_ASSERT(pool.buffer_size() == IO_DIRECT_DEFAULT_ALIGN);
+
+        io::AlignedBufferPool big(0x10001, 0x2000);
+        UTEST_ASSERT(big.alignment() == 0x2000);
+        UTEST_ASSERT(big.buffer_size() == 0x12000);
+
+        uint8_t *a = pool.acquire();
+        uint8_t *b = pool.acquire();
+        UTEST_ASSERT((a != NULL) && (b != NULL) && (a != b));
+        UTEST_ASSERT((ptrdiff_t(a) % pool.alignment()) == 0);
+        UTEST_ASSERT((ptrdiff_t(b) % pool.alignment()) == 0);
+        UTEST_ASSERT(pool.allocated() == 2);
+        UTEST_ASSERT(pool.used() == 2);
+
+        uint8_t x;
+        UTEST_ASSERT(pool.release(&x) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(pool.release(a) == STATUS_OK);
+        UTEST_ASSERT(pool.release(a) == STATUS_BAD_STATE);
+        UTEST_ASSERT(pool.used() == 1);
+        UTEST_ASSERT(pool.acquire() == a);
+
+        UTEST_ASSERT(pool.release(b) == STATUS_OK);
+        pool.trim();
+        UTEST_ASSERT(pool.allocated() == 1);
+        UTEST_ASSERT(pool.release(a) == STATUS_OK);
+        pool.trim();
+        UTEST_ASSERT(pool.allocated() == 0);
+    }
+
+    void test_write(io::AlignedBufferPool *pool, const uint8_t *data)
+    {
+        static const size_t sizes[]     = { 0, 1, 0xfff, 0x1000, 0x1001, BUF_SIZE, BUF_SIZE * 2 + 123, DATA_SIZE };
+        static const size_t chunks[]    = { 1000, 0x1000, DATA_SIZE };
+
+        LSPString path;
+        UTEST_ASSERT(path.fmt_utf8("%s/utest-%s-write.bin", tempdir(), full_name()));
+        lsp_finally { io::File::remove(&path); };
+
+        for (size_t size: sizes)
+            for (size_t chunk: chunks)
+            {
+                io::OutDirectFileStream os(pool);
+                UTEST_ASSERT(os.write(data, 1) == -STATUS_CLOSED);
+                UTEST_ASSERT(os.open(&path) == STATUS_OK);
+                UTEST_ASSERT(os.open(&path) == STATUS_BAD_STATE);
+                printf("Testing write size=%d, chunk=%d, direct=%s\n", int(size), int(chunk), (os.direct()) ? "true" : "false");
+
+                for (size_t off=0; off < size; )
+                {
+                    const size_t to_write = lsp_min(chunk, size - off);
+                    UTEST_ASSERT(os.write(&data[off], to_write) == ssize_t(to_write));
+                    off            += to_write;
+                    UTEST_ASSERT(os.position() == wssize_t(off));
+
+                    // Flush in the middle of the data
+                    if ((off >= size / 2) && (off - to_write < size / 2))
+                        UTEST_ASSERT(os.flush() == STATUS_OK);
+                }
+
+                UTEST_ASSERT(os.close() == STATUS_OK);
+                UTEST_ASSERT(os.close() == STATUS_CLOSED);
+                UTEST_ASSERT(pool->used() == 0);
+
+                check_file(&path, data, size);
+            }
+    }
+
+    void test_overwrite(io::AlignedBufferPool *pool, const uint8_t *data)
+    {
+        printf("Testing overwrite of existing file\n");
+
+        LSPString path;
+        UTEST_ASSERT(path.fmt_utf8("%s/utest-%s-overwrite.bin", tempdir(), full_name()));
+        lsp_finally { io::File::remove(&path); };
+
+        uint8_t *expected = static_cast<uint8_t *>(malloc(DATA_SIZE));
+        UTEST_ASSERT(expected != NULL);
+        lsp_finally { free(expected); };
+        init_data(expected, DATA_SIZE, 0xdeadbeef);
+
+        // Write original file
+        io::OutDirectFileStream os(pool);
+        UTEST_ASSERT(os.open(&path) == STATUS_OK);
+        UTEST_ASSERT(os.write(expected, DATA_SIZE) == DATA_SIZE);
+        UTEST_ASSERT(os.close() == STATUS_OK);
+
+        // Overwrite the beginning of the file without truncation
+        const size_t size = BUF_SIZE + 100;
+        UTEST_ASSERT(os.open(&path, io::File::FM_WRITE) == STATUS_OK);
+        UTEST_ASSERT(os.write(data, size) == ssize_t(size));
+        UTEST_ASSERT(os.close() == STATUS_OK);
+
+        memcpy(expected, data, size);
+        check_file(&path, expected, DATA_SIZE);
+    }
+
+    void test_read(io::AlignedBufferPool *pool, const uint8_t *data)
+    {
+        static const size_t sizes[]     = { 0, 1, 0xfff, 0x1000, 0x1001, BUF_SIZE, BUF_SIZE * 2 + 123, DATA_SIZE };
+        static const size_t chunks[]    = { 1000, 0x1000, DATA_SIZE };
+
+        LSPString path;
+        UTEST_ASSERT(path.fmt_utf8("%s/utest-%s-read.bin", tempdir(), full_name()));
+        lsp_finally { io::File::remove(&path); };
+
+        uint8_t *buf = static_cast<uint8_t *>(malloc(DATA_SIZE + 1));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+
+        for (size_t size: sizes)
+        {
+            io::OutDirectFileStream os(pool);
+            UTEST_ASSERT(os.open(&path) == STATUS_OK);
+            UTEST_ASSERT(os.write(data, size) == ssize_t(size));
+            UTEST_ASSERT(os.close() == STATUS_OK);
+
+            for (size_t chunk: chunks)
+            {
+                io::InDirectFileStream is(pool);
+                UTEST_ASSERT(is.read(buf, 1) == -STATUS_CLOSED);
+                UTEST_ASSERT(is.open(&path) == STATUS_OK);
+                printf("Testing read size=%d, chunk=%d, direct=%s\n", int(size), int(chunk), (is.direct()) ? "true" : "false");
+                UTEST_ASSERT(is.avail() == wssize_t(size));
+
+                size_t off = 0;
+                while (true)
+                {
+                    const ssize_t n = is.read(&buf[off], lsp_min(chunk, DATA_SIZE + 1 - off));
+                    if (n < 0)
+                    {
+                        UTEST_ASSERT(n == -STATUS_EOF);
+                        break;
+                    }
+                    off            += n;
+                    UTEST_ASSERT(is.position() == wssize_t(off));
+                }
+
+                UTEST_ASSERT(off == size);
+                UTEST_ASSERT(memcmp(buf, data, size) == 0);
+                UTEST_ASSERT(is.close() == STATUS_OK);
+                UTEST_ASSERT(pool->used() == 0);
+            }
+        }
+    }
+
+    void test_seek(io::AlignedBufferPool *pool, const uint8_t *data)
+    {
+        printf("Testing seek and skip\n");
+
+        LSPString path;
+        UTEST_ASSERT(path.fmt_utf8("%s/utest-%s-seek.bin", tempdir(), full_name()));
+        lsp_finally { io::File::remove(&path); };
+
+        io::OutDirectFileStream os(pool);
+        UTEST_ASSERT(os.open(&path) == STATUS_OK);
+        UTEST_ASSERT(os.write(data, DATA_SIZE) == DATA_SIZE);
+        UTEST_ASSERT(os.close() == STATUS_OK);
+
+        static const wsize_t positions[] = { 100, BUF_SIZE + 5, BUF_SIZE * 2 - 1, 0, DATA_SIZE - 3, 0x1001, BUF_SIZE * 3, DATA_SIZE, DATA_SIZE + 100, 7 };
+        uint8_t buf[16];
+
+        io::InDirectFileStream is(pool);
+        UTEST_ASSERT(is.open(&path) == STATUS_OK);
+
+        for (wsize_t pos: positions)
+        {
+            const wsize_t expected = lsp_min(pos, wsize_t(DATA_SIZE));
+            UTEST_ASSERT_MSG(is.seek(pos) == wssize_t(expected), "Failed seek to %d", int(pos));
+            UTEST_ASSERT(is.position() == wssize_t(expected));
+            UTEST_ASSERT(is.avail() == wssize_t(DATA_SIZE - expected));
+
+            const ssize_t n = is.read(buf, sizeof(buf));
+            if (expected >= DATA_SIZE)
+            {
+                UTEST_ASSERT(n == -STATUS_EOF);
+                continue;
+            }
+
+            const size_t avail = lsp_min(sizeof(buf), size_t(DATA_SIZE - expected));
+            UTEST_ASSERT(n == ssize_t(avail));
+            UTEST_ASSERT(memcmp(buf, &data[expected], avail) == 0);
+        }
+
+        UTEST_ASSERT(is.seek(10) == 10);
+        UTEST_ASSERT(is.skip(BUF_SIZE) == BUF_SIZE);
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) == sizeof(buf));
+        UTEST_ASSERT(memcmp(buf, &data[BUF_SIZE + 10], sizeof(buf)) == 0);
+        UTEST_ASSERT(is.skip(DATA_SIZE) == wssize_t(DATA_SIZE - BUF_SIZE - 10 - sizeof(buf)));
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) == -STATUS_EOF);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+    }
+
+    UTEST_MAIN
+    {
+        uint8_t *data = static_cast<uint8_t *>(malloc(DATA_SIZE));
+        UTEST_ASSERT(data != NULL);
+        lsp_finally { free(data); };
+        init_data(data, DATA_SIZE, 0x12345678);
+
+        io::AlignedBufferPool pool(BUF_SIZE);
+
+        test_pool();
+        test_write(&pool, data);
+        test_overwrite(&pool, data);
+        test_read(&pool, data);
+        test_seek(&pool, data);
+    }
+
+UTEST_END
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/io/DirWalker.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/io/PathPattern.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define NUM_DIRS        4
+#define NUM_SUBDIRS     3
+#define NUM_FILES       5
+
+namespace
+{
+    using namespace lsp;
+
+    class CountingHandler: public io::IDirWalkHandler
+    {
+        public:
+            atomic_t    nDirs;
+            atomic_t    nFiles;
+            atomic_t    nErrors;
+            atomic_t    nBadAttr;
+            atomic_t    nMaxDepth;
+            status_t    nFileResult;
+            const char *sSkipDir;
+
+        public:
+            CountingHandler()
+            {
+                reset();
+                nFileResult = STATUS_OK;
+                sSkipDir    = NULL;
+            }
+
+            void reset()
+            {
+                nDirs       = 0;
+                nFiles      = 0;
+                nErrors     = 0;
+                nBadAttr    = 0;
+                nMaxDepth   = 0;
+            }
+
+            virtual status_t on_entry(const io::dir_entry_t *entry) override
+            {
+                // Check consistency of the entry
+                const size_t len = strlen(entry->path);
+                if ((strlen(entry->name) > len) || (strcmp(&entry->path[len - strlen(entry->name)], entry->name) != 0))
+                    atomic_add(&nBadAttr, 1);
+                if ((entry->attr != NULL) && (entry->attr->type != entry->type))
+                    atomic_add(&nBadAttr, 1);
+                if ((entry->attr != NULL) && (entry->type == io::fattr_t::FT_REGULAR) && (entry->attr->size != strlen(entry->name)))
+                    atomic_add(&nBadAttr, 1);
+
+                int depth = atomic_load(&nMaxDepth);
+                while ((int(entry->depth) > depth) && (!atomic_cas(&nMaxDepth, depth, int(entry->depth))))
+                    depth   = atomic_load(&nMaxDepth);
+
+                if (entry->type == io::fattr_t::FT_DIRECTORY)
+                {
+                    atomic_add(&nDirs, 1);
+                    if ((sSkipDir != NULL) && (strcmp(entry->name, sSkipDir) == 0))
+                        return STATUS_SKIP;
+                    return STATUS_OK;
+                }
+
+                atomic_add(&nFiles, 1);
+                return nFileResult;
+            }
+
+            virtual status_t on_error(const char *path, status_t code) override
+            {
+                atomic_add(&nErrors, 1);
+                return code;
+            }
+    };
+}
+
+UTEST_BEGIN("runtime.io", dirwalker)
+
+    void create_file(const io::Path *dir, const char *name)
+    {
+        io::Path path;
+        io::NativeFile fd;
+
+        UTEST_ASSERT(path.set(dir, name) == STATUS_OK);
+        UTEST_ASSERT(fd.open(&path, io::File::FM_WRITE_NEW) == STATUS_OK);
+        UTEST_ASSERT(fd.write(name, strlen(name)) == ssize_t(strlen(name)));
+        UTEST_ASSERT(fd.close() == STATUS_OK);
+    }
+
+    void create_tree(const io::Path *root)
+    {
+        char name[32];
+        io::Path dir, sub;
+
+        printf("Creating directory tree at %s\n", root->as_native());
+        UTEST_ASSERT(root->mkdir(true) == STATUS_OK);
+        create_file(root, "readme.txt");
+
+        for (size_t i=0; i<NUM_DIRS; ++i)
+        {
+            snprintf(name, sizeof(name), "d%d", int(i));
+            UTEST_ASSERT(dir.set(root, name) == STATUS_OK);
+            UTEST_ASSERT(dir.mkdir() == STATUS_OK);
+
+            for (size_t j=0; j<NUM_SUBDIRS; ++j)
+            {
+                snprintf(name, sizeof(name), "s%d", int(j));
+                UTEST_ASSERT(sub.set(&dir, name) == STATUS_OK);
+                UTEST_ASSERT(sub.mkdir() == STATUS_OK);
+
+                for (size_t k=0; k<NUM_FILES; ++k)
+                {
+                    snprintf(name, sizeof(name), "file-%d.txt", int(k));
+                    create_file(&sub, name);
+                }
+                create_file(&sub, "data.bin");
+            }
+        }
+    }
+
+    void test_walk(const io::Path *root, size_t threads, size_t flags)
+    {
+        printf("Testing walk with threads=%d, flags=0x%x\n", int(threads), int(flags));
+
+        io::DirWalker w;
+        CountingHandler h;
+        w.set_threads(threads);
+        w.set_flags(flags);
+
+        // Full walk
+        UTEST_ASSERT(w.walk(root, &h) == STATUS_OK);
+        UTEST_ASSERT(h.nDirs == NUM_DIRS + NUM_DIRS * NUM_SUBDIRS);
+        UTEST_ASSERT(h.nFiles == 1 + NUM_DIRS * NUM_SUBDIRS * (NUM_FILES + 1));
+        UTEST_ASSERT(h.nErrors == 0);
+        UTEST_ASSERT(h.nBadAttr == 0);
+        UTEST_ASSERT(h.nMaxDepth == 2);
+
+        // Limited depth
+        h.reset();
+        w.set_max_depth(0);
+        UTEST_ASSERT(w.walk(root, &h) == STATUS_OK);
+        UTEST_ASSERT(h.nDirs == NUM_DIRS);
+        UTEST_ASSERT(h.nFiles == 1);
+        UTEST_ASSERT(h.nMaxDepth == 0);
+        w.set_max_depth(size_t(-1));
+
+        // Filter entries
+        io::PathPattern filter, exclude;
+        UTEST_ASSERT(filter.set("*.txt") == STATUS_OK);
+        h.reset();
+        w.set_filter(&filter);
+        UTEST_ASSERT(w.walk(root, &h) == STATUS_OK);
+        UTEST_ASSERT(h.nDirs == 0);
+        UTEST_ASSERT(h.nFiles == 1 + NUM_DIRS * NUM_SUBDIRS * NUM_FILES);
+        w.set_filter(NULL);
+
+        // Exclude subtree
+        UTEST_ASSERT(exclude.set("d1") == STATUS_OK);
+        h.reset();
+        w.set_exclude(&exclude);
+        UTEST_ASSERT(w.walk(root, &h) == STATUS_OK);
+        UTEST_ASSERT(h.nDirs == (NUM_DIRS - 1) * (NUM_SUBDIRS + 1));
+        UTEST_ASSERT(h.nFiles == 1 + (NUM_DIRS - 1) * NUM_SUBDIRS * (NUM_FILES + 1));
+        w.set_exclude(NULL);
+
+        // Skip directories by handler
+        h.reset();
+        h.sSkipDir      = "s1";
+        UTEST_ASSERT(w.walk(root, &h) == STATUS_OK);
+        UTEST_ASSERT(h.nDirs == NUM_DIRS + NUM_DIRS * NUM_SUBDIRS);
+        UTEST_ASSERT(h.nFiles == 1 + NUM_DIRS * (NUM_SUBDIRS - 1) * (NUM_FILES + 1));
+        h.sSkipDir      = NULL;
+
+        // Abort the walk
+        h.reset();
+        h.nFileResult   = STATUS_CANCELLED;
+        UTEST_ASSERT(w.walk(root, &h) == STATUS_CANCELLED);
+        UTEST_ASSERT(h.nFiles >= 1);
+        h.nFileResult   = STATUS_OK;
+
+        // Non-existing directory
+        io::Path missing;
+        h.reset();
+        UTEST_ASSERT(missing.set(root, "missing") == STATUS_OK);
+        UTEST_ASSERT(w.walk(&missing, &h) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(h.nErrors == 1);
+    }
+
+    UTEST_MAIN
+    {
+        io::Path root;
+        UTEST_ASSERT(root.fmt("%s/utest-%s", tempdir(), full_name()) > 0);
+        create_tree(&root);
+
+        UTEST_FOREACH(threads, 1, 2, 4, 0)
+        {
+            test_walk(&root, threads, io::DirWalker::WALK_NONE);
+            test_walk(&root, threads, io::DirWalker::WALK_STAT);
+        }
+    }
+
+UTEST_END
@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/Dir.h>
+#include <lsp-plug.in/io/DirWatcher.h>
+#include <lsp-plug.in/io/NativeFile.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define LOG_SIZE        0x1000
+
+namespace
+{
+    using namespace lsp;
+
+    class LoggingHandler: public io::IDirWatchHandler
+    {
+        public:
+            char        sLog[LOG_SIZE];
+            size_t      nLength;
+            size_t      nEvents;
+
+        public:
+            LoggingHandler()
+            {
+                reset();
+            }
+
+            void reset()
+            {
+                sLog[0]     = '\0';
+                nLength     = 0;
+                nEvents     = 0;
+            }
+
+            bool contains(const char *text) const
+            {
+                return strstr(sLog, text) != NULL;
+            }
+
+            virtual status_t on_event(const io::dir_event_t *event) override
+            {
+                char *dst           = &sLog[nLength];
+                const size_t avail  = LOG_SIZE - nLength;
+                int n               = 0;
+
+                switch (event->type)
+                {
+                    case io::dir_event_t::EV_CREATE: n = snprintf(dst, avail, "C %s;", event->path); break;
+                    case io::dir_event_t::EV_DELETE: n = snprintf(dst, avail, "D %s;", event->path); break;
+                    case io::dir_event_t::EV_MODIFY: n = snprintf(dst, avail, "M %s;", event->path); break;
+                    case io::dir_event_t::EV_RENAME: n = snprintf(dst, avail, "R %s>%s;", event->old_path, event->path); break;
+                    case io::dir_event_t::EV_RESCAN: n = snprintf(dst, avail, "X;"); break;
+                    default: break;
+                }
+
+                if ((n > 0) && (size_t(n) < avail))
+                    nLength            += n;
+                ++nEvents;
+
+                return STATUS_OK;
+            }
+    };
+}
+
+UTEST_BEGIN("runtime.io", dirwatcher)
+
+    void remove_tree(const io::Path *path)
+    {
+        io::Dir dir;
+        io::Path child;
+        io::fattr_t attr;
+        LSPString name;
+
+        if (dir.open(path) == STATUS_OK)
+        {
+            while (dir.reads(&name, &attr, false) == STATUS_OK)
+            {
+                if (io::Path::is_dots(&name))
+                    continue;
+                UTEST_ASSERT(child.set(path, &name) == STATUS_OK);
+                if (attr.type == io::fattr_t::FT_DIRECTORY)
+                    remove_tree(&child);
+                else
+                    UTEST_ASSERT(child.remove() == STATUS_OK);
+            }
+            dir.close();
+        }
+        path->remove();
+    }
+
+    void write_file(const io::Path *root, const char *name, const char *text, bool append)
+    {
+        io::Path path;
+        io::NativeFile fd;
+
+        UTEST_ASSERT(path.set(root, name) == STATUS_OK);
+        UTEST_ASSERT(fd.open(&path, (append) ? io::File::FM_WRITE | io::File::FM_CREATE : io::File::FM_WRITE_NEW) == STATUS_OK);
+        if (append)
+            UTEST_ASSERT(fd.seek(0, io::File::FSK_END) == STATUS_OK);
+        UTEST_ASSERT(fd.write(text, strlen(text)) == ssize_t(strlen(text)));
+        UTEST_ASSERT(fd.close() == STATUS_OK);
+    }
+
+    void make_dir(const io::Path *root, const char *name)
+    {
+        io::Path path;
+        UTEST_ASSERT(path.set(root, name) == STATUS_OK);
+        UTEST_ASSERT(path.mkdir() == STATUS_OK);
+    }
+
+    void remove_entry(const io::Path *root, const char *name)
+    {
+        io::Path path;
+        UTEST_ASSERT(path.set(root, name) == STATUS_OK);
+        UTEST_ASSERT(path.remove() == STATUS_OK);
+    }
+
+    void rename_entry(const io::Path *root, const char *from, const char *to)
+    {
+        io::Path src, dst;
+        UTEST_ASSERT(src.set(root, from) == STATUS_OK);
+        UTEST_ASSERT(dst.set(root, to) == STATUS_OK);
+        UTEST_ASSERT(src.rename(&dst) == STATUS_OK);
+    }
+
+    void poll_events(io::DirWatcher *w, LoggingHandler *h)
+    {
+        h->reset();
+        UTEST_ASSERT(w->poll(h, 2000) == STATUS_OK);
+        printf("  events: %s\n", h->sLog);
+    }
+
+    void test_watch(const char *label, size_t flags)
+    {
+        printf("Testing %s mode\n", label);
+
+        io::Path root;
+        UTEST_ASSERT(root.fmt("%s/utest-%s-%s", tempdir(), full_name(), label) > 0);
+        remove_tree(&root);
+        UTEST_ASSERT(root.mkdir(true) == STATUS_OK);
+        make_dir(&root, "a");
+        write_file(&root, "a/old.txt", "old", false);
+
+        io::DirWatcher w;
+        LoggingHandler h;
+        w.set_poll_interval(20);
+        w.set_coalesce_delay(20);
+        UTEST_ASSERT(!w.is_opened());
+        UTEST_ASSERT(w.poll(&h, 0) == STATUS_CLOSED);
+        UTEST_ASSERT(w.open(&root, flags) == STATUS_OK);
+        UTEST_ASSERT(w.is_opened());
+        UTEST_ASSERT(w.open(&root, flags) == STATUS_OPENED);
+        const bool notify = w.mode() == io::DirWatcher::MODE_NOTIFY;
+        printf("  watcher mode: %s\n", (notify) ? "notify" : "poll");
+        if (flags & io::DirWatcher::WATCH_POLL)
+            UTEST_ASSERT(!notify);
+
+        // No changes
+        UTEST_ASSERT(w.poll(&h, 50) == STATUS_TIMED_OUT);
+        UTEST_ASSERT(h.nEvents == 0);
+
+        // Creation of the file and following writes are coalesced
+        write_file(&root, "f1", "first", false);
+        write_file(&root, "f1", "second", true);
+        poll_events(&w, &h);
+        UTEST_ASSERT(h.contains("C f1;"));
+        UTEST_ASSERT(!h.contains("M f1;"));
+
+        // Modification of the file
+        write_file(&root, "f1", "third", true);
+        poll_events(&w, &h);
+        UTEST_ASSERT(strcmp(h.sLog, "M f1;") == 0);
+
+        // Modification of the file in the subdirectory
+        write_file(&root, "a/old.txt", "new", true);
+        poll_events(&w, &h);
+        UTEST_ASSERT(strcmp(h.sLog, "M a" FILE_SEPARATOR_S "old.txt;") == 0);
+
+        // Creation of the subdirectory with contents
+        make_dir(&root, "d");
+        write_file(&root, "d/x", "x", false);
+        poll_events(&w, &h);
+        UTEST_ASSERT(h.contains("C d;"));
+        UTEST_ASSERT(h.contains("C d" FILE_SEPARATOR_S "x;"));
+        UTEST_ASSERT(strstr(h.sLog, "C d;") < strstr(h.sLog, "C d" FILE_SEPARATOR_S "x;"));
+
+        // Temporary files do not produce events
+        write_file(&root, "tmp", "tmp", false);
+        remove_entry(&root, "tmp");
+        write_file(&root, "f1", "fourth", true);
+        poll_events(&w, &h);
+        UTEST_ASSERT(strcmp(h.sLog, "M f1;") == 0);
+
+        // Rename of the file
+        rename_entry(&root, "f1", "f2");
+        poll_events(&w, &h);
+        if (notify)
+            UTEST_ASSERT(strcmp(h.sLog, "R f1>f2;") == 0);
+        else
+        {
+            UTEST_ASSERT(h.contains("C f2;"));
+            UTEST_ASSERT(h.contains("D f1;"));
+        }
+
+        // Rename of the directory, new entries should be reported with new path
+        rename_entry(&root, "d", "e");
+        poll_events(&w, &h);
+        if (notify)
+            UTEST_ASSERT(strcmp(h.sLog, "R d>e;") == 0);
+        else
+        {
+            UTEST_ASSERT(h.contains("C e;"));
+            UTEST_ASSERT(h.contains("C e" FILE_SEPARATOR_S "x;"));
+            UTEST_ASSERT(h.contains("D d;"));
+            UTEST_ASSERT(h.contains("D d" FILE_SEPARATOR_S "x;"));
+        }
+
+        write_file(&root, "e/y", "y", false);
+        poll_events(&w, &h);
+        UTEST_ASSERT(strcmp(h.sLog, "C e" FILE_SEPARATOR_S "y;") == 0);
+
+        // Deletion of the directory
+        remove_entry(&root, "e/x");
+        remove_entry(&root, "e/y");
+        remove_entry(&root, "e");
+        poll_events(&w, &h);
+        UTEST_ASSERT(h.contains("D e" FILE_SEPARATOR_S "x;"));
+        UTEST_ASSERT(h.contains("D e" FILE_SEPARATOR_S "y;"));
+        UTEST_ASSERT(h.contains("D e;"));
+
+        // No more changes
+        UTEST_ASSERT(w.poll(&h, 50) == STATUS_TIMED_OUT);
+
+        UTEST_ASSERT(w.close() == STATUS_OK);
+        UTEST_ASSERT(!w.is_opened());
+        remove_tree(&root);
+    }
+
+    void test_non_recursive()
+    {
+        printf("Testing non-recursive mode\n");
+
+        io::Path root;
+        UTEST_ASSERT(root.fmt("%s/utest-%s-flat", tempdir(), full_name()) > 0);
+        remove_tree(&root);
+        UTEST_ASSERT(root.mkdir(true) == STATUS_OK);
+        make_dir(&root, "a");
+
+        io::DirWatcher w;
+        LoggingHandler h;
+        w.set_poll_interval(20);
+        w.set_coalesce_delay(20);
+        UTEST_ASSERT(w.open(&root, io::DirWatcher::WATCH_NONE) == STATUS_OK);
+
+        write_file(&root, "a/x", "x", false);
+        write_file(&root, "f", "f", false);
+        poll_events(&w, &h);
+        UTEST_ASSERT(strcmp(h.sLog, "C f;") == 0);
+
+        UTEST_ASSERT(w.close() == STATUS_OK);
+        remove_tree(&root);
+    }
+
+    void test_errors()
+    {
+        printf("Testing error handling\n");
+
+        io::Path path;
+        io::DirWatcher w;
+        UTEST_ASSERT(path.fmt("%s/utest-%s-missing", tempdir(), full_name()) > 0);
+        UTEST_ASSERT(w.open(&path) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(!w.is_opened());
+
+        UTEST_ASSERT(path.fmt("%s/utest-%s-file", tempdir(), full_name()) > 0);
+        io::NativeFile fd;
+        UTEST_ASSERT(fd.open(&path, io::File::FM_WRITE_NEW) == STATUS_OK);
+        UTEST_ASSERT(fd.close() == STATUS_OK);
+        UTEST_ASSERT(w.open(&path) == STATUS_NOT_DIRECTORY);
+        UTEST_ASSERT(!w.is_opened());
+        UTEST_ASSERT(path.remove() == STATUS_OK);
+    }
+
+    UTEST_MAIN
+    {
+        test_watch("default", io::DirWatcher::WATCH_RECURSIVE);
+        test_watch("poll", io::DirWatcher::WATCH_RECURSIVE | io::DirWatcher::WATCH_POLL);
+        test_non_recursive();
+        test_errors();
+    }
+
+UTEST_END
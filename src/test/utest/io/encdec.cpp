@@ -198,6 +198,43 @@ UTEST_BEGIN("runtime.io", encdec)
         compareFiles(&fsrc, &fdec);
     }
 
+    void testBuiltinCodecs()
+    {
+        lsp_wchar_t obuf[16];
+        uint8_t bbuf[16];
+
+        printf("Testing built-in codecs...\n");
+
+        // Valid prefix should be decoded, invalid sequence should report error
+        static const char *invalid[] =
+        {
+            "ab\xc0\x80",             // Overlong encoding
+            "ab\xed\xa0\x80",         // Surrogate
+            "ab\xe2\x82z",            // Broken sequence
+            "ab\xf4\x90\x80\x80",     // Out of range
+            NULL
+        };
+
+        for (const char **s = invalid; *s != NULL; ++s)
+        {
+            CharsetDecoder decoder;
+            UTEST_ASSERT(decoder.init("utf8") == STATUS_OK);
+            UTEST_ASSERT(decoder.fill(*s, strlen(*s)) == ssize_t(strlen(*s)));
+            UTEST_ASSERT(decoder.fetch(obuf, 16) == 2);
+            UTEST_ASSERT((obuf[0] == 'a') && (obuf[1] == 'b'));
+            UTEST_ASSERT(decoder.fetch(obuf, 16) == -STATUS_BAD_FORMAT);
+        }
+
+        // ASCII encoder should not accept non-ASCII characters
+        static const lsp_wchar_t text[] = { 'x', 'y', 0x0416 };
+        CharsetEncoder encoder;
+        UTEST_ASSERT(encoder.init("US-ASCII") == STATUS_OK);
+        UTEST_ASSERT(encoder.fill(text, 3) == 3);
+        UTEST_ASSERT(encoder.fetch(bbuf, 16) == 2);
+        UTEST_ASSERT((bbuf[0] == 'x') && (bbuf[1] == 'y'));
+        UTEST_ASSERT(encoder.fetch(bbuf, 16) == -STATUS_BAD_FORMAT);
+    }
+
     UTEST_MAIN
     {
         const char *base = "io" FILE_SEPARATOR_S "iconv";
@@ -209,6 +246,8 @@ UTEST_BEGIN("runtime.io", encdec)
         testFileCoding(base, "03-ru-cp1251.txt", "CP1251");
         testFileCoding(base, "03-ru-utf16le.txt", "UTF-16LE");
         testFileCoding(base, "03-ru-utf8.txt", "UTF-8");
+
+        testBuiltinCodecs();
     }
 
 UTEST_END
@@ -22,6 +22,7 @@
 #include <lsp-plug.in/test-fw/utest.h>
 #include <lsp-plug.in/test-fw/ByteBuffer.h>
 #include <lsp-plug.in/io/InSharedMemoryStream.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
 
 UTEST_BEGIN("runtime.io", insharedmemorystream)
 
@@ -97,9 +98,52 @@ UTEST_BEGIN("runtime.io", insharedmemorystream)
         UTEST_ASSERT(src.equals(dst2));
     }
 
+    void test_take_chunks()
+    {
+        ByteBuffer src(0x1234);
+        ByteBuffer dst(0x1234);
+        src.randomize();
+        dst.randomize();
+
+        io::OutMemoryStream os;
+        UTEST_ASSERT(os.set_chunk_size(0x100) == STATUS_OK);
+        UTEST_ASSERT(os.write(src.data<uint8_t>(), src.size()) == ssize_t(src.size()));
+        UTEST_ASSERT(os.chunks() == 0x13);
+
+        // Take the data without copying
+        io::InSharedMemoryStream a;
+        UTEST_ASSERT(a.take(os) == STATUS_OK);
+        UTEST_ASSERT(os.size() == 0);
+        UTEST_ASSERT(os.chunks() == 0);
+        UTEST_ASSERT(a.data() == NULL);
+        UTEST_ASSERT(a.size() == src.size());
+
+        io::InSharedMemoryStream b(a);
+        UTEST_ASSERT(b.references() == 2);
+
+        // Read the data with blocks that cross chunk boundaries
+        for (size_t offset = 0; offset < src.size(); )
+        {
+            const ssize_t n = a.read(dst.data<void>(offset), 0x53);
+            UTEST_ASSERT(n > 0);
+            offset     += n;
+        }
+        UTEST_ASSERT(a.read(dst.data<uint8_t>(), 1) == -STATUS_EOF);
+        UTEST_ASSERT(src.equals(dst));
+
+        // Read byte by byte
+        for (size_t i=0; i<src.size(); ++i)
+            UTEST_ASSERT(b.read_byte() == src.data<uint8_t>()[i]);
+        UTEST_ASSERT(b.read_byte() == -STATUS_EOF);
+
+        UTEST_ASSERT(!src.corrupted());
+        UTEST_ASSERT(!dst.corrupted());
+    }
+
     UTEST_MAIN
     {
         test_simple_share();
+        test_take_chunks();
     }
 UTEST_END
 
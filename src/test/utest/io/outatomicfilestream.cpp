@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/Dir.h>
+#include <lsp-plug.in/io/File.h>
+#include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/io/OutAtomicFileStream.h>
+#include <lsp-plug.in/io/OutFileStream.h>
+#include <lsp-plug.in/io/SyncBatch.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#ifdef PLATFORM_UNIX_COMPATIBLE
+    #include <unistd.h>
+#endif /* PLATFORM_UNIX_COMPATIBLE */
+
+UTEST_BEGIN("runtime.io", outatomicfilestream)
+
+    void write_file(const LSPString *path, const char *text)
+    {
+        io::OutFileStream os;
+        UTEST_ASSERT(os.open(path, io::File::FM_WRITE_NEW) == STATUS_OK);
+        UTEST_ASSERT(os.write(text, strlen(text)) == ssize_t(strlen(text)));
+        UTEST_ASSERT(os.close() == STATUS_OK);
+    }
+
+    void check_file(const LSPString *path, const char *text)
+    {
+        char buf[0x100];
+        const size_t len = strlen(text);
+
+        io::InFileStream is;
+        UTEST_ASSERT(is.open(path) == STATUS_OK);
+        const ssize_t n = is.read_fully(buf, len);
+        UTEST_ASSERT_MSG(n == ssize_t(len), "Invalid file size %d, expected %d", int(n), int(len));
+        UTEST_ASSERT(memcmp(buf, text, len) == 0);
+        UTEST_ASSERT(is.read(buf, sizeof(buf)) == -STATUS_EOF);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+    }
+
+    bool exists(const LSPString *path)
+    {
+        io::fattr_t attr;
+        return io::File::stat(path, &attr) == STATUS_OK;
+    }
+
+    void make_path(LSPString *path, const char *name)
+    {
+        UTEST_ASSERT(path->fmt_utf8("%s/utest-%s-%s.txt", tempdir(), full_name(), name));
+        io::File::remove(path);
+    }
+
+    void test_replace()
+    {
+        printf("Testing file replacement\n");
+
+        LSPString path;
+        make_path(&path, "replace");
+        write_file(&path, "old contents");
+
+        io::OutAtomicFileStream os;
+        UTEST_ASSERT(os.temp_path() == NULL);
+        UTEST_ASSERT(os.write("x", 1) < 0);
+        UTEST_ASSERT(os.open(&path) == STATUS_OK);
+        UTEST_ASSERT(os.open(&path) == STATUS_BAD_STATE);
+
+        LSPString temp;
+        UTEST_ASSERT(os.temp_path() != NULL);
+        UTEST_ASSERT(temp.set(os.temp_path()));
+        UTEST_ASSERT(temp.starts_with(&path));
+        UTEST_ASSERT(exists(&temp));
+
+        // The original file should remain untouched until commit
+        UTEST_ASSERT(os.write("new ", 4) == 4);
+        UTEST_ASSERT(os.write("contents", 8) == 8);
+        UTEST_ASSERT(os.position() == 12);
+        check_file(&path, "old contents");
+
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(os.temp_path() == NULL);
+        UTEST_ASSERT(!exists(&temp));
+        check_file(&path, "new contents");
+
+        // Create new file
+        UTEST_ASSERT(io::File::remove(&path) == STATUS_OK);
+        UTEST_ASSERT(os.open(&path) == STATUS_OK);
+        UTEST_ASSERT(os.write("created", 7) == 7);
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        check_file(&path, "created");
+    }
+
+    void test_abort()
+    {
+        printf("Testing abort of replacement\n");
+
+        LSPString path, temp;
+        make_path(&path, "abort");
+        write_file(&path, "original");
+
+        // Explicit abort
+        {
+            io::OutAtomicFileStream os;
+            UTEST_ASSERT(os.abort() == STATUS_CLOSED);
+            UTEST_ASSERT(os.open(&path) == STATUS_OK);
+            UTEST_ASSERT(temp.set(os.temp_path()));
+            UTEST_ASSERT(os.write("garbage", 7) == 7);
+            UTEST_ASSERT(os.abort() == STATUS_OK);
+            UTEST_ASSERT(os.close() == STATUS_OK);
+        }
+        UTEST_ASSERT(!exists(&temp));
+        check_file(&path, "original");
+
+        // Destruction without commit
+        {
+            io::OutAtomicFileStream os;
+            UTEST_ASSERT(os.open(&path) == STATUS_OK);
+            UTEST_ASSERT(temp.set(os.temp_path()));
+            UTEST_ASSERT(os.write("garbage", 7) == 7);
+        }
+        UTEST_ASSERT(!exists(&temp));
+        check_file(&path, "original");
+    }
+
+    void test_failure()
+    {
+        printf("Testing failed replacement\n");
+
+        LSPString path, temp;
+        make_path(&path, "failure");
+        write_file(&path, "original");
+
+        io::OutAtomicFileStream os;
+        UTEST_ASSERT(os.open(&path) == STATUS_OK);
+        UTEST_ASSERT(temp.set(os.temp_path()));
+        UTEST_ASSERT(os.write("garbage", 7) == 7);
+
+        // Seek to the invalid position, successful operations after that should not hide the error
+        const wssize_t pos = os.seek(wsize_t(-1));
+        UTEST_ASSERT(pos < 0);
+        const status_t code = status_t(-pos);
+        UTEST_ASSERT(os.seek(0) == 0);
+        UTEST_ASSERT(os.write("data", 4) == 4);
+        UTEST_ASSERT(os.flush() == STATUS_OK);
+
+        // The first error should be returned on commit
+        UTEST_ASSERT(os.close() == code);
+        UTEST_ASSERT(os.last_error() == code);
+        UTEST_ASSERT(os.temp_path() == NULL);
+        UTEST_ASSERT(!exists(&temp));
+        check_file(&path, "original");
+    }
+
+    void test_batch()
+    {
+        printf("Testing batched commits\n");
+
+        static const char *names[] = { "batch-a", "batch-b", "batch-c" };
+        LSPString path[3];
+        io::SyncBatch batch;
+
+        for (size_t i=0; i<3; ++i)
+        {
+            make_path(&path[i], names[i]);
+
+            io::OutAtomicFileStream os;
+            UTEST_ASSERT(os.open(&path[i], &batch) == STATUS_OK);
+            UTEST_ASSERT(os.write(names[i], strlen(names[i])) == ssize_t(strlen(names[i])));
+            UTEST_ASSERT(os.close() == STATUS_OK);
+        }
+
+        // All files reside in the same directory, only one sync is pending
+        UTEST_ASSERT(batch.pending() == 1);
+        for (size_t i=0; i<3; ++i)
+            check_file(&path[i], names[i]);
+
+        UTEST_ASSERT(batch.add(tempdir()) == STATUS_OK);
+        UTEST_ASSERT(batch.pending() == 1);
+        UTEST_ASSERT(batch.add(".") == STATUS_OK);
+        UTEST_ASSERT(batch.pending() == 2);
+        UTEST_ASSERT(batch.commit() == STATUS_OK);
+        UTEST_ASSERT(batch.pending() == 0);
+
+        // Failed synchronization should be reported but not stop the batch
+        UTEST_ASSERT(batch.add("/this/directory/does/not/exist") == STATUS_OK);
+        UTEST_ASSERT(batch.add(tempdir()) == STATUS_OK);
+        UTEST_ASSERT(batch.commit() != STATUS_OK);
+        UTEST_ASSERT(batch.pending() == 0);
+
+        UTEST_ASSERT(io::Dir::sync(tempdir()) == STATUS_OK);
+    }
+
+#ifdef PLATFORM_UNIX_COMPATIBLE
+    void test_symlink()
+    {
+        printf("Testing replacement through symbolic links\n");
+
+        LSPString path, link, chain, name;
+        make_path(&path, "symlink-target");
+        make_path(&link, "symlink");
+        make_path(&chain, "symlink-chain");
+        write_file(&path, "original");
+
+        // Relative link to the target and absolute link to the relative link
+        const ssize_t idx = path.rindex_of('/');
+        UTEST_ASSERT(name.set(&path, idx + 1));
+        UTEST_ASSERT(::symlink(name.get_native(), link.get_native()) == 0);
+        UTEST_ASSERT(::symlink(link.get_native(), chain.get_native()) == 0);
+
+        io::OutAtomicFileStream os;
+        UTEST_ASSERT(os.open(&chain) == STATUS_OK);
+        UTEST_ASSERT(os.temp_path()->starts_with(&path));
+        UTEST_ASSERT(os.write("replaced", 8) == 8);
+        UTEST_ASSERT(os.close() == STATUS_OK);
+
+        // Links should stay links, the target file should be updated
+        io::fattr_t attr;
+        UTEST_ASSERT(io::File::stat(&link, &attr) == STATUS_OK);
+        UTEST_ASSERT(attr.type == io::fattr_t::FT_SYMLINK);
+        UTEST_ASSERT(io::File::stat(&chain, &attr) == STATUS_OK);
+        UTEST_ASSERT(attr.type == io::fattr_t::FT_SYMLINK);
+        check_file(&path, "replaced");
+        check_file(&chain, "replaced");
+
+        // Dangling link should create the file it points to
+        UTEST_ASSERT(io::File::remove(&path) == STATUS_OK);
+        UTEST_ASSERT(os.open(&link) == STATUS_OK);
+        UTEST_ASSERT(os.write("created", 7) == 7);
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(io::File::stat(&link, &attr) == STATUS_OK);
+        UTEST_ASSERT(attr.type == io::fattr_t::FT_SYMLINK);
+        check_file(&path, "created");
+
+        // Loop of links should be detected
+        UTEST_ASSERT(io::File::remove(&path) == STATUS_OK);
+        UTEST_ASSERT(::symlink(chain.get_native(), path.get_native()) == 0);
+        UTEST_ASSERT(os.open(&link) == STATUS_OVERFLOW);
+
+        io::File::remove(&path);
+        io::File::remove(&link);
+        io::File::remove(&chain);
+    }
+#endif /* PLATFORM_UNIX_COMPATIBLE */
+
+    UTEST_MAIN
+    {
+        test_replace();
+        test_abort();
+        test_failure();
+        test_batch();
+    #ifdef PLATFORM_UNIX_COMPATIBLE
+        test_symlink();
+    #endif /* PLATFORM_UNIX_COMPATIBLE */
+    }
+
+UTEST_END
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InFileStream.h>
+#include <lsp-plug.in/io/OutBufStream.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+UTEST_BEGIN("runtime.io", outbufstream)
+
+    void init_data(uint8_t *buf, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+            buf[i]      = uint8_t(i * 7 + (i >> 8));
+    }
+
+    void test_block_writes(const uint8_t *src, size_t count)
+    {
+        printf("Testing block writes\n");
+
+        UTEST_FOREACH(size, 1, 2, 3, 5, 7, 8, 11, 13, 16, 23) {
+            printf("  block_size=%d ...\n", int(size));
+
+            io::OutMemoryStream oms;
+            io::OutBufStream os(8);
+            UTEST_ASSERT(os.wrap(&oms) == STATUS_OK);
+
+            size_t offset = 0;
+            while (offset < count)
+            {
+                const size_t to_write = lsp_min(size, count - offset);
+                UTEST_ASSERT(os.write(&src[offset], to_write) == ssize_t(to_write));
+                offset     += to_write;
+
+                UTEST_ASSERT_MSG(
+                    os.position() == wssize_t(offset),
+                    "Invalid position returned %d, expected %d",
+                    int(os.position()), int(offset));
+                UTEST_ASSERT(oms.size() + os.buffer_size() == offset);
+                UTEST_ASSERT(os.buffer_size() <= os.buffer_capacity());
+            }
+
+            UTEST_ASSERT(os.flush() == STATUS_OK);
+            UTEST_ASSERT(os.buffer_size() == 0);
+            UTEST_ASSERT(oms.size() == count);
+            UTEST_ASSERT(memcmp(oms.data(), src, count) == 0);
+            UTEST_ASSERT(os.close() == STATUS_OK);
+        }
+    }
+
+    void test_byte_writes(const uint8_t *src, size_t count)
+    {
+        printf("Testing byte writes\n");
+
+        io::OutMemoryStream oms;
+        io::OutBufStream os(8);
+        UTEST_ASSERT(os.wrap(&oms) == STATUS_OK);
+
+        for (size_t i=0; i<count; ++i)
+        {
+            UTEST_ASSERT(os.write_byte(src[i]) == STATUS_OK);
+            UTEST_ASSERT(os.position() == wssize_t(i + 1));
+        }
+
+        // Data should be written to the underlying stream on close
+        UTEST_ASSERT(oms.size() < count);
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(oms.size() == count);
+        UTEST_ASSERT(memcmp(oms.data(), src, count) == 0);
+    }
+
+    void test_passthrough(const uint8_t *src, size_t count)
+    {
+        printf("Testing passthrough of large writes\n");
+
+        io::OutMemoryStream oms;
+        io::OutBufStream os(16);
+        UTEST_ASSERT(os.wrap(&oms) == STATUS_OK);
+
+        // Small write remains in buffer
+        UTEST_ASSERT(os.write(src, 5) == 5);
+        UTEST_ASSERT(oms.size() == 0);
+        UTEST_ASSERT(os.buffer_size() == 5);
+
+        // Large write flushes the buffer and goes directly to the stream
+        UTEST_ASSERT(os.write(&src[5], 40) == 40);
+        UTEST_ASSERT(oms.size() == 45);
+        UTEST_ASSERT(os.buffer_size() == 0);
+        UTEST_ASSERT(os.buffer_position() == 45);
+        UTEST_ASSERT(os.position() == 45);
+
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(memcmp(oms.data(), src, 45) == 0);
+    }
+
+    void test_flush_policy(const uint8_t *src, size_t count)
+    {
+        printf("Testing flush policy\n");
+
+        io::OutMemoryStream oms;
+        io::OutBufStream os(16);
+        UTEST_ASSERT(os.wrap(&oms) == STATUS_OK);
+
+        // Line policy
+        os.set_flush_policy(io::OutBufStream::FLUSH_LINE);
+        UTEST_ASSERT(os.flush_policy() == io::OutBufStream::FLUSH_LINE);
+        UTEST_ASSERT(os.write("abc", 3) == 3);
+        UTEST_ASSERT(oms.size() == 0);
+        UTEST_ASSERT(os.write("de\nf", 4) == 4);
+        UTEST_ASSERT(oms.size() == 7);
+        UTEST_ASSERT(os.write_byte('g') == STATUS_OK);
+        UTEST_ASSERT(oms.size() == 7);
+        UTEST_ASSERT(os.write_byte('\n') == STATUS_OK);
+        UTEST_ASSERT(oms.size() == 9);
+
+        // Always flush policy
+        os.set_flush_policy(io::OutBufStream::FLUSH_ALWAYS);
+        UTEST_ASSERT(os.write("xyz", 3) == 3);
+        UTEST_ASSERT(oms.size() == 12);
+        UTEST_ASSERT(os.write_byte('w') == STATUS_OK);
+        UTEST_ASSERT(oms.size() == 13);
+
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(memcmp(oms.data(), "abcde\nfg\nxyzw", 13) == 0);
+    }
+
+    void test_seek(const uint8_t *src, size_t count)
+    {
+        printf("Testing seek\n");
+
+        io::OutMemoryStream oms;
+        io::OutBufStream os(16);
+        UTEST_ASSERT(os.wrap(&oms) == STATUS_OK);
+
+        UTEST_ASSERT(os.write(src, 10) == 10);
+        UTEST_ASSERT(os.seek(10) == 10);
+        UTEST_ASSERT(os.buffer_size() == 10);
+
+        // Seek should write pending data and change position
+        UTEST_ASSERT(os.seek(4) == 4);
+        UTEST_ASSERT(oms.size() == 10);
+        UTEST_ASSERT(os.position() == 4);
+        UTEST_ASSERT(os.write("\xff\xfe", 2) == 2);
+        UTEST_ASSERT(os.position() == 6);
+        UTEST_ASSERT(os.seek(10) == 10);
+        UTEST_ASSERT(os.write(&src[10], 2) == 2);
+
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(oms.size() == 12);
+        UTEST_ASSERT(memcmp(oms.data(), src, 4) == 0);
+        UTEST_ASSERT(memcmp(&oms.data()[4], "\xff\xfe", 2) == 0);
+        UTEST_ASSERT(memcmp(&oms.data()[6], &src[6], 6) == 0);
+    }
+
+    void test_file_writes(const uint8_t *src, size_t count)
+    {
+        printf("Testing file writes\n");
+
+        LSPString path;
+        UTEST_ASSERT(path.fmt_utf8("%s/utest-%s.bin", tempdir(), full_name()));
+
+        io::OutBufStream os;
+        UTEST_ASSERT(os.position() < 0);
+        UTEST_ASSERT(os.open(&path, io::File::FM_WRITE_NEW) == STATUS_OK);
+        for (size_t offset = 0; offset < count; offset += 3)
+        {
+            const size_t to_write = lsp_min(size_t(3), count - offset);
+            UTEST_ASSERT(os.write(&src[offset], to_write) == ssize_t(to_write));
+        }
+        UTEST_ASSERT(os.position() == wssize_t(count));
+        UTEST_ASSERT(os.close() == STATUS_OK);
+
+        uint8_t *buf = static_cast<uint8_t *>(malloc(count));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+
+        io::InFileStream is;
+        UTEST_ASSERT(is.open(&path) == STATUS_OK);
+        UTEST_ASSERT(is.read_fully(buf, count) == ssize_t(count));
+        UTEST_ASSERT(is.close() == STATUS_OK);
+        UTEST_ASSERT(memcmp(buf, src, count) == 0);
+    }
+
+    UTEST_MAIN
+    {
+        static constexpr size_t DATA_SIZE = 0x1234;
+        uint8_t *src = static_cast<uint8_t *>(malloc(DATA_SIZE));
+        UTEST_ASSERT(src != NULL);
+        lsp_finally { free(src); };
+        init_data(src, DATA_SIZE);
+
+        test_block_writes(src, DATA_SIZE);
+        test_byte_writes(src, DATA_SIZE);
+        test_passthrough(src, DATA_SIZE);
+        test_flush_policy(src, DATA_SIZE);
+        test_seek(src, DATA_SIZE);
+        test_file_writes(src, DATA_SIZE);
+    }
+
+UTEST_END
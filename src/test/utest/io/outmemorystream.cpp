@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/test-fw/ByteBuffer.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+
+UTEST_BEGIN("runtime.io", outmemorystream)
+
+    void test_growth()
+    {
+        printf("Testing geometric growth\n");
+
+        ByteBuffer src(0x10000);
+        src.randomize();
+
+        io::OutMemoryStream os(0x100, 2.0f);
+        UTEST_ASSERT(os.growth() == 2.0f);
+
+        size_t reallocs = 0, capacity = 0;
+        for (size_t offset = 0; offset < src.size(); offset += 0x10)
+        {
+            UTEST_ASSERT(os.write(src.data<uint8_t>(offset), 0x10) == 0x10);
+            if (os.capacity() != capacity)
+            {
+                capacity    = os.capacity();
+                ++reallocs;
+            }
+            UTEST_ASSERT((os.capacity() % os.quantity()) == 0);
+        }
+
+        printf("  number of reallocations: %d\n", int(reallocs));
+        UTEST_ASSERT(reallocs <= 9);
+        UTEST_ASSERT(os.size() == src.size());
+        UTEST_ASSERT(memcmp(os.data(), src.data<uint8_t>(), src.size()) == 0);
+
+        // Linear growth
+        io::OutMemoryStream ls(0x100);
+        ls.set_growth(1.0f);
+        UTEST_ASSERT(ls.write(src.data<uint8_t>(), 0x180) == 0x180);
+        UTEST_ASSERT(ls.capacity() == 0x200);
+        UTEST_ASSERT(ls.write(src.data<uint8_t>(0x180), 0x100) == 0x100);
+        UTEST_ASSERT(ls.capacity() == 0x300);
+        UTEST_ASSERT(memcmp(ls.data(), src.data<uint8_t>(), 0x280) == 0);
+
+        UTEST_ASSERT(!src.corrupted());
+    }
+
+    void test_chunked()
+    {
+        printf("Testing chunked mode\n");
+
+        ByteBuffer src(0x1234);
+        src.randomize();
+
+        io::OutMemoryStream os;
+        UTEST_ASSERT(!os.chunked());
+        UTEST_ASSERT(os.set_chunk_size(0x100) == STATUS_OK);
+        UTEST_ASSERT(os.chunked());
+        UTEST_ASSERT(os.chunk_size() == 0x100);
+
+        // Write data
+        for (size_t offset = 0; offset < src.size(); offset += 0x33)
+        {
+            const size_t count = lsp_min(size_t(0x33), src.size() - offset);
+            UTEST_ASSERT(os.write(src.data<uint8_t>(offset), count) == ssize_t(count));
+        }
+        UTEST_ASSERT(os.data() == NULL);
+        UTEST_ASSERT(os.size() == src.size());
+        UTEST_ASSERT(os.chunks() == 0x13);
+        UTEST_ASSERT(os.set_chunk_size(0x200) == STATUS_BAD_STATE);
+
+        // Check chunks
+        for (size_t i=0, offset=0; i<os.chunks(); ++i)
+        {
+            size_t size = 0;
+            const uint8_t *chunk = os.chunk(i, &size);
+            UTEST_ASSERT(chunk != NULL);
+            UTEST_ASSERT(size == lsp_min(src.size() - offset, size_t(0x100)));
+            UTEST_ASSERT(memcmp(chunk, src.data<uint8_t>(offset), size) == 0);
+            offset     += size;
+        }
+        UTEST_ASSERT(os.chunk(os.chunks()) == NULL);
+
+        // Overwrite data across chunk boundary
+        UTEST_ASSERT(os.seek(0xf0) == 0xf0);
+        UTEST_ASSERT(os.write(src.data<uint8_t>(0x1000), 0x20) == 0x20);
+        UTEST_ASSERT(os.write_byte(0x55) == STATUS_OK);
+        UTEST_ASSERT(os.size() == src.size());
+        UTEST_ASSERT(os.seek(os.size()) == wssize_t(src.size()));
+
+        // Sink data to another stream
+        io::OutMemoryStream dst;
+        UTEST_ASSERT(os.sink(&dst) == wssize_t(src.size()));
+        UTEST_ASSERT(dst.size() == src.size());
+        UTEST_ASSERT(memcmp(dst.data(), src.data<uint8_t>(), 0xf0) == 0);
+        UTEST_ASSERT(memcmp(dst.data() + 0xf0, src.data<uint8_t>(0x1000), 0x20) == 0);
+        UTEST_ASSERT(dst.data()[0x110] == 0x55);
+        UTEST_ASSERT(memcmp(dst.data() + 0x111, src.data<uint8_t>(0x111), src.size() - 0x111) == 0);
+
+        // Release data as contiguous buffer
+        uint8_t *data = os.release();
+        UTEST_ASSERT(data != NULL);
+        lsp_finally { free(data); };
+        UTEST_ASSERT(memcmp(data, dst.data(), dst.size()) == 0);
+        UTEST_ASSERT(os.size() == 0);
+        UTEST_ASSERT(os.chunks() == 0);
+
+        // Release reserved but empty chunks
+        UTEST_ASSERT(os.reserve(0x300) == STATUS_OK);
+        UTEST_ASSERT(os.capacity() == 0x300);
+        UTEST_ASSERT(os.release() == NULL);
+        UTEST_ASSERT(os.capacity() == 0);
+        UTEST_ASSERT(os.write(src.data<uint8_t>(), 0x10) == 0x10);
+        UTEST_ASSERT(os.capacity() == 0x100);
+        UTEST_ASSERT(memcmp(os.chunk(0), src.data<uint8_t>(), 0x10) == 0);
+
+        UTEST_ASSERT(!src.corrupted());
+    }
+
+    UTEST_MAIN
+    {
+        test_growth();
+        test_chunked();
+    }
+
+UTEST_END
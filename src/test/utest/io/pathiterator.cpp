@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/io/PathIterator.h>
+
+using namespace lsp;
+
+UTEST_BEGIN("runtime.io", pathiterator)
+
+    void check_items(const char *path, bool absolute, const char * const *items)
+    {
+        LSPString tmp, item;
+        UTEST_ASSERT(tmp.set_utf8(path));
+        printf("  checking path '%s'\n", path);
+
+        io::PathIterator it(&tmp);
+        UTEST_ASSERT(it.is_absolute() == absolute);
+        UTEST_ASSERT(!it.valid());
+
+        for (size_t pass=0; pass<2; ++pass)
+        {
+            size_t n = 0;
+            while (it.next())
+            {
+                UTEST_ASSERT(items[n] != NULL);
+                UTEST_ASSERT(it.valid());
+                UTEST_ASSERT(it.equals_utf8(items[n]));
+                UTEST_ASSERT(it.get(&item) == STATUS_OK);
+                UTEST_ASSERT(item.equals_utf8(items[n]));
+                UTEST_ASSERT(it.equals(&item));
+                UTEST_ASSERT(tmp.get_utf8(it.first(), it.last()) != NULL);
+                UTEST_ASSERT(strcmp(tmp.get_utf8(it.first(), it.last()), items[n]) == 0);
+                UTEST_ASSERT(it.is_last() == (items[n+1] == NULL));
+                ++n;
+            }
+            UTEST_ASSERT(items[n] == NULL);
+            UTEST_ASSERT(!it.valid());
+            UTEST_ASSERT(!it.is_last());
+            UTEST_ASSERT(it.get(&item) == STATUS_NOT_FOUND);
+            UTEST_ASSERT(!it.next());
+
+            it.rewind();
+        }
+    }
+
+    void test_iterate()
+    {
+        static const char * const empty[]   = { NULL };
+        static const char * const single[]  = { "file.txt", NULL };
+        static const char * const multi[]   = { "usr", "share", "lsp-plugins", NULL };
+        static const char * const dots[]    = { "a", ".", "..", "b", NULL };
+        static const char * const utf8[]    = { "путь", "файл.txt", NULL };
+
+        printf("Testing iteration over path items...\n");
+
+        check_items("", false, empty);
+        check_items("/", true, empty);
+        check_items("///", true, empty);
+        check_items("file.txt", false, single);
+        check_items("file.txt/", false, single);
+        check_items("/file.txt", true, single);
+        check_items("/usr/share/lsp-plugins", true, multi);
+        check_items("usr/share/lsp-plugins/", false, multi);
+        check_items("usr//share\\lsp-plugins", false, multi);
+        check_items("\\usr\\share\\lsp-plugins\\\\", true, multi);
+        check_items("a/./../b", false, dots);
+        check_items("/путь/файл.txt", true, utf8);
+
+        // NULL path is treated as empty path
+        io::PathIterator it;
+        UTEST_ASSERT(!it.next());
+        UTEST_ASSERT(!it.is_absolute());
+        it.wrap(static_cast<const io::Path *>(NULL));
+        UTEST_ASSERT(!it.next());
+    }
+
+    void test_compare()
+    {
+        io::Path path;
+        LSPString tail;
+
+        printf("Testing comparison of path items...\n");
+
+        UTEST_ASSERT(path.set("ab/abc/./../абв/x") == STATUS_OK);
+        io::PathIterator it(&path);
+
+        UTEST_ASSERT(it.next());
+        UTEST_ASSERT(it.equals_ascii("ab"));
+        UTEST_ASSERT(it.equals_utf8("ab"));
+        UTEST_ASSERT(!it.equals_ascii("a"));
+        UTEST_ASSERT(!it.equals_utf8("abc"));
+        UTEST_ASSERT(!it.equals_utf8(""));
+        UTEST_ASSERT(!it.equals_utf8(NULL));
+        UTEST_ASSERT(!it.is_dots());
+        UTEST_ASSERT(it.get_tail(&tail) == STATUS_OK);
+        UTEST_ASSERT(tail.equals_utf8("abc/./../абв/x"));
+
+        UTEST_ASSERT(it.next());
+        UTEST_ASSERT(it.equals_utf8("abc"));
+        UTEST_ASSERT(!it.equals_utf8("ab"));
+        UTEST_ASSERT(!it.equals_utf8("abcd"));
+
+        UTEST_ASSERT(it.next());
+        UTEST_ASSERT(it.is_dot());
+        UTEST_ASSERT(!it.is_dotdot());
+        UTEST_ASSERT(it.is_dots());
+
+        UTEST_ASSERT(it.next());
+        UTEST_ASSERT(!it.is_dot());
+        UTEST_ASSERT(it.is_dotdot());
+        UTEST_ASSERT(it.is_dots());
+
+        UTEST_ASSERT(it.next());
+        UTEST_ASSERT(it.equals_utf8("абв"));
+        UTEST_ASSERT(!it.equals_utf8("абг"));
+        UTEST_ASSERT(!it.equals_utf8("аб"));
+        UTEST_ASSERT(!it.equals_ascii("abv"));
+        UTEST_ASSERT(!it.equals_utf8("\xd0"));
+
+        UTEST_ASSERT(it.next());
+        UTEST_ASSERT(it.is_last());
+        UTEST_ASSERT(it.get_tail(&tail) == STATUS_OK);
+        UTEST_ASSERT(tail.is_empty());
+        UTEST_ASSERT(!it.next());
+    }
+
+    void test_path_ops()
+    {
+        io::Path path, parent;
+        LSPString str;
+
+        printf("Testing in-place path operations...\n");
+
+        // Append child with self-reference
+        UTEST_ASSERT(path.set("a/b") == STATUS_OK);
+        UTEST_ASSERT(path.append_child(path.as_string()) == STATUS_OK);
+        UTEST_ASSERT(path.equals("a/b/a/b"));
+        UTEST_ASSERT(path.append_child("\\c\\d") == STATUS_INVALID_VALUE);
+        UTEST_ASSERT(path.equals("a/b/a/b"));
+        UTEST_ASSERT(path.append_child("c\\d/") == STATUS_OK);
+        UTEST_ASSERT(path.equals("a/b/a/b/c/d/"));
+        UTEST_ASSERT(path.append_child("файл") == STATUS_OK);
+        UTEST_ASSERT(path.equals("a/b/a/b/c/d/файл"));
+
+        // Set parent with self-reference
+        UTEST_ASSERT(path.set("x/y") == STATUS_OK);
+        UTEST_ASSERT(path.set_parent(&path) == STATUS_OK);
+        UTEST_ASSERT(path.equals("x/y/x/y"));
+        UTEST_ASSERT(parent.set("/root///") == STATUS_OK);
+        UTEST_ASSERT(path.set_parent(&parent) == STATUS_OK);
+        UTEST_ASSERT(path.equals("/root/x/y/x/y"));
+
+        // Canonicalize into the destination
+        UTEST_ASSERT(path.set("/a/./b/../c//d/") == STATUS_OK);
+        UTEST_ASSERT(path.get_canonical(&str) == STATUS_OK);
+        UTEST_ASSERT(str.equals_ascii("/a/c/d"));
+        UTEST_ASSERT(path.get_canonical(&parent) == STATUS_OK);
+        UTEST_ASSERT(parent.equals("/a/c/d"));
+        UTEST_ASSERT(path.get_canonical(&path) == STATUS_OK);
+        UTEST_ASSERT(path.equals("/a/c/d"));
+
+        // Append UTF-8 data to the string
+        UTEST_ASSERT(str.set_ascii("abc"));
+        UTEST_ASSERT(str.append_utf8("", 0));
+        UTEST_ASSERT(str.append_utf8("где"));
+        UTEST_ASSERT(str.equals_utf8("abcгде"));
+    }
+
+    UTEST_MAIN
+    {
+        test_iterate();
+        test_compare();
+        test_path_ops();
+    }
+
+UTEST_END
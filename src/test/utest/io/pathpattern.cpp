@@ -111,6 +111,22 @@ UTEST_BEGIN("runtime.io", pathpattern)
             {
                 return (pRoot != NULL) ? do_dump(0, pRoot) : STATUS_OK;
             }
+
+            bool compiled() const
+            {
+                return pDfa != NULL;
+            }
+
+            bool test_backtracking(const char *path) const
+            {
+                io::Path tmp;
+                if (tmp.set(path) != STATUS_OK)
+                    return false;
+                if ((!(nFlags & FULL_PATH)) && (tmp.remove_base() != STATUS_OK))
+                    return false;
+
+                return match_full(tmp.as_string());
+            }
     };
 
     void test_parse()
@@ -193,7 +209,8 @@ UTEST_BEGIN("runtime.io", pathpattern)
 
             // Test direct
             UTEST_ASSERT(p.set(m->pattern, flags) == STATUS_OK);
-            if (p.test(m->value) != m->match)
+            UTEST_ASSERT(p.compiled());
+            if ((p.test(m->value) != m->match) || (p.test_backtracking(m->value) != m->match))
             {
                 p.dump();
                 UTEST_FAIL_MSG("Falied direct match for pattern \"%s\", value=\"%s\", match=%s",
@@ -203,7 +220,7 @@ UTEST_BEGIN("runtime.io", pathpattern)
 
             // Test inverse
             UTEST_ASSERT(p.set(m->pattern, flags | io::PathPattern::INVERSE) == STATUS_OK);
-            if (p.test(m->value) == m->match)
+            if ((p.test(m->value) == m->match) || (p.test_backtracking(m->value) == m->match))
             {
                 p.dump();
                 UTEST_FAIL_MSG("Falied inverse match for pattern \"%s\", value=\"%s\", match=%s",
@@ -471,6 +488,12 @@ UTEST_BEGIN("runtime.io", pathpattern)
             { "*(a*|b*)*(c*|d*)",    false,  "12b34d56",            true            },
             { "*(a*|b*)*(c*|d*)",    false,  "12d34b56",            false           },
 
+            // Inverse of the sequence with multiple variable regions
+            { "!*(**/)",             true,   "ab",                  false           },
+            { "!*(**/)",             true,   "a/b",                 false           },
+            { "!(*(*b*))c",          false,  "abc",                 false           },
+            { "!(*(*b*))c",          false,  "aac",                 true            },
+
             // Multiple matches with path
             { "*(a*|b*)*(c*|d*)",    true,  "a/b",                  false           },
             { "*(a*|b*)*(c*|d*)",    true,  "a/c",                  false           },
@@ -581,6 +604,114 @@ UTEST_BEGIN("runtime.io", pathpattern)
         test_match_patterns(matches);
     }
 
+    static uint32_t next_random(uint32_t *seed)
+    {
+        *seed   = *seed * 1103515245 + 12345;
+        return *seed >> 8;
+    }
+
+    static void random_text(LSPString *dst, uint32_t *seed, const char *alphabet, size_t max_len)
+    {
+        const size_t n = strlen(alphabet);
+        for (size_t i=0, len = next_random(seed) % (max_len + 1); i<len; ++i)
+            dst->append(alphabet[next_random(seed) % n]);
+    }
+
+    static void random_expression(LSPString *dst, uint32_t *seed, size_t depth)
+    {
+        random_sequence(dst, seed, depth);
+        for (size_t i=0, n = next_random(seed) % 3; i<n; ++i)
+        {
+            dst->append((next_random(seed) & 1) ? '|' : '&');
+            random_sequence(dst, seed, depth);
+        }
+    }
+
+    static void random_sequence(LSPString *dst, uint32_t *seed, size_t depth)
+    {
+        if ((next_random(seed) % 5) == 0)
+            dst->append('!');
+
+        for (size_t i=0, n = 1 + next_random(seed) % 4; i<n; ++i)
+        {
+            switch (next_random(seed) % ((depth > 0) ? 8 : 6))
+            {
+                case 0: dst->append('*'); break;
+                case 1: dst->append('?'); break;
+                case 2: dst->append_ascii("**/"); break;
+                case 3: dst->append('/'); break;
+                case 4:
+                case 5:
+                    random_text(dst, seed, "abA.", 2);
+                    break;
+                case 6:
+                    dst->append_ascii((next_random(seed) & 1) ? "!(" : "(");
+                    random_expression(dst, seed, depth - 1);
+                    dst->append(')');
+                    break;
+                default:
+                    dst->append('(');
+                    random_expression(dst, seed, depth - 1);
+                    dst->append(')');
+                    break;
+            }
+        }
+    }
+
+    void test_match_random()
+    {
+        static constexpr size_t PATTERNS = 3000;
+        static constexpr size_t PATHS = 64;
+
+        TestPathPattern p(this);
+        LSPString pattern, path;
+        io::Path xpath;
+        uint32_t seed = 0x1e3779b9;
+        size_t compiled = 0, checked = 0;
+
+        printf("Testing random patterns against the backtracking matcher\n");
+
+        for (size_t i=0; i<PATTERNS; ++i)
+        {
+            pattern.clear();
+            random_expression(&pattern, &seed, 2);
+
+            size_t flags = 0;
+            if (next_random(&seed) & 1)
+                flags          |= io::PathPattern::FULL_PATH;
+            if (next_random(&seed) & 1)
+                flags          |= io::PathPattern::MATCH_CASE;
+            if ((next_random(&seed) % 4) == 0)
+                flags          |= io::PathPattern::INVERSE;
+
+            if (p.set(&pattern, flags) != STATUS_OK)
+                continue;
+            if (!p.compiled())
+                continue;
+            ++compiled;
+
+            for (size_t j=0; j<PATHS; ++j)
+            {
+                path.clear();
+                random_text(&path, &seed, "aAb./", 8);
+                const char *s   = path.get_utf8();
+
+                const bool expected = p.test_backtracking(s);
+                UTEST_ASSERT(xpath.set(&path) == STATUS_OK);
+                if ((p.test(s) != expected) || (p.test(&path) != expected) || (p.test(&xpath) != expected))
+                {
+                    p.dump();
+                    UTEST_FAIL_MSG("Mismatch of compiled and backtracking matcher for pattern \"%s\", flags=0x%x, value=\"%s\", expected=%s",
+                        pattern.get_utf8(), int(flags), s, (expected) ? "true" : "false");
+                }
+                ++checked;
+            }
+        }
+
+        printf("Checked %d values for %d compiled patterns\n", int(checked), int(compiled));
+        UTEST_ASSERT(compiled > PATTERNS / 2);
+    }
+
     UTEST_MAIN
     {
         test_parse();
@@ -588,6 +719,7 @@ UTEST_BEGIN("runtime.io", pathpattern)
         test_match_sequence_only();
         test_match_brute();
         test_match_examples();
+        test_match_random();
     }
 
 UTEST_END
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/io/PathPatternSet.h>
+
+UTEST_BEGIN("runtime.io", pathpatternset)
+
+    typedef struct pattern_t
+    {
+        const char *pattern;
+        size_t flags;
+    } pattern_t;
+
+    static constexpr size_t CASE    = io::PathPattern::MATCH_CASE;
+    static constexpr size_t FULL    = io::PathPattern::FULL_PATH;
+    static constexpr size_t INV     = io::PathPattern::INVERSE;
+
+    ssize_t find_slow(const lltl::parray<io::PathPattern> *list, const char *path, size_t first)
+    {
+        for (size_t i=first, n=list->size(); i<n; ++i)
+            if (list->uget(i)->test(path))
+                return i;
+        return -STATUS_NOT_FOUND;
+    }
+
+    void test_match()
+    {
+        static const pattern_t patterns[] =
+        {
+            { "*.c|*.h",                            0                   },
+            { "**/test/**/*.log",                   FULL                },
+            { "README",                             CASE                },
+            { "*.txt",                              INV                 },
+            { "!(test)",                            0                   },
+            { "**/((*.c|*.h)&(!test-*))",           FULL | CASE         },
+            { "*.C",                                CASE                },
+            { "Makefile",                           0                   },
+            { "**/.git/**",                         FULL                },
+            { "file*(!test)*.log",                  INV | FULL          },
+            { NULL, 0 }
+        };
+
+        static const char *paths[] =
+        {
+            "",
+            "main.c",
+            "MAIN.C",
+            "src/main.c",
+            "src/test-main.h",
+            "prj/test/logs/out.log",
+            "test/out.log",
+            "readme",
+            "README",
+            "doc/README",
+            "notes.txt",
+            "makefile",
+            "prj/.git/config",
+            ".git/HEAD",
+            "file-test.log",
+            "file.log",
+            "some-test.bin",
+            "/",
+            NULL
+        };
+
+        io::PathPatternSet set;
+        lltl::parray<io::PathPattern> list;
+        lsp_finally {
+            for (size_t i=0, n=list.size(); i<n; ++i)
+                delete list.uget(i);
+            list.flush();
+        };
+
+        for (const pattern_t *p = patterns; p->pattern != NULL; ++p)
+        {
+            io::PathPattern *xp = new io::PathPattern();
+            UTEST_ASSERT(xp != NULL);
+            UTEST_ASSERT(list.add(xp));
+            UTEST_ASSERT(xp->set(p->pattern, p->flags) == STATUS_OK);
+            UTEST_ASSERT(set.add(p->pattern, p->flags) == STATUS_OK);
+            UTEST_ASSERT(set.size() == list.size());
+            UTEST_ASSERT(set.get(set.size() - 1)->flags() == p->flags);
+
+            // Check all paths against the current set of patterns
+            for (const char * const *path = paths; *path != NULL; ++path)
+            {
+                for (size_t first=0; first <= list.size(); ++first)
+                {
+                    const ssize_t expected  = find_slow(&list, *path, first);
+                    const ssize_t found     = set.find(*path, first);
+                    UTEST_ASSERT_MSG(found == expected,
+                        "Path \"%s\", first=%d: found pattern %d, expected %d",
+                        *path, int(first), int(found), int(expected));
+                }
+
+                LSPString tmp;
+                io::Path xpath;
+                UTEST_ASSERT(tmp.set_utf8(*path));
+                UTEST_ASSERT(xpath.set(*path) == STATUS_OK);
+
+                const bool match = find_slow(&list, *path, 0) >= 0;
+                UTEST_ASSERT(set.test(*path) == match);
+                UTEST_ASSERT(set.test(&tmp) == match);
+                UTEST_ASSERT(set.find(&tmp) == find_slow(&list, *path, 0));
+                if (xpath.as_string()->equals(&tmp))
+                {
+                    UTEST_ASSERT(set.test(&xpath) == match);
+                    UTEST_ASSERT(set.find(&xpath) == find_slow(&list, *path, 0));
+                }
+            }
+        }
+
+        // Check some matches explicitly
+        UTEST_ASSERT(set.find("main.c") == 0);
+        UTEST_ASSERT(set.find("main.c", 1) == 3);
+        UTEST_ASSERT(set.find("prj/test/logs/out.log") == 1);
+        UTEST_ASSERT(set.find("README") == 2);
+        UTEST_ASSERT(set.find("notes.txt") == 4);
+        UTEST_ASSERT(set.find("test") == 3);
+        UTEST_ASSERT(set.find("test.txt") == 9);
+        UTEST_ASSERT(set.find("test.txt", 10) < 0);
+        UTEST_ASSERT(set.find("file-1.log") == 3);
+        UTEST_ASSERT(set.find("file-1.log", 4) == 4);
+        UTEST_ASSERT(set.find("file-1.log", 5) < 0);
+    }
+
+    void test_many()
+    {
+        printf("Testing many patterns\n");
+
+        io::PathPatternSet set;
+        LSPString tmp;
+
+        for (size_t i=0; i<100; ++i)
+        {
+            UTEST_ASSERT(tmp.fmt_ascii("file-%d.*", int(i)));
+            UTEST_ASSERT(set.add(&tmp) == STATUS_OK);
+        }
+        UTEST_ASSERT(set.size() == 100);
+
+        for (size_t i=0; i<100; ++i)
+        {
+            UTEST_ASSERT(tmp.fmt_ascii("dir/file-%d.txt", int(i)));
+            UTEST_ASSERT(set.find(&tmp) == ssize_t(i));
+            UTEST_ASSERT(set.find(&tmp, i + 1) < 0);
+        }
+        UTEST_ASSERT(!set.test("file-100.txt"));
+        UTEST_ASSERT(!set.test("file-1"));
+    }
+
+    void test_manage()
+    {
+        printf("Testing management of the set\n");
+
+        io::PathPatternSet set, set2;
+        io::PathPattern p;
+
+        UTEST_ASSERT(set.is_empty());
+        UTEST_ASSERT(!set.test("main.c"));
+        UTEST_ASSERT(set.find("main.c") == -STATUS_NOT_FOUND);
+        UTEST_ASSERT(set.get(0) == NULL);
+
+        UTEST_ASSERT(set.add("*.c") == STATUS_OK);
+        UTEST_ASSERT(set.add("(*.h") != STATUS_OK);
+        UTEST_ASSERT(set.size() == 1);
+        UTEST_ASSERT(p.set("*.h", CASE) == STATUS_OK);
+        UTEST_ASSERT(set.add(&p) == STATUS_OK);
+        UTEST_ASSERT(set.size() == 2);
+        UTEST_ASSERT(set.get(1)->flags() == CASE);
+        UTEST_ASSERT(set.get(1)->get()->equals_ascii("*.h"));
+
+        UTEST_ASSERT(set.find("main.h") == 1);
+        UTEST_ASSERT(set.find("main.H") < 0);
+
+        set.swap(&set2);
+        UTEST_ASSERT(set.is_empty());
+        UTEST_ASSERT(set2.size() == 2);
+        UTEST_ASSERT(!set.test("main.c"));
+        UTEST_ASSERT(set2.test("main.c"));
+
+        set2.clear();
+        UTEST_ASSERT(set2.is_empty());
+        UTEST_ASSERT(!set2.test("main.c"));
+    }
+
+    UTEST_MAIN
+    {
+        test_match();
+        test_many();
+        test_manage();
+    }
+
+UTEST_END
+
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InMarkSequence.h>
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/io/InSequence.h>
+#include <lsp-plug.in/io/InStringSequence.h>
+#include <lsp-plug.in/io/SpanReader.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+namespace
+{
+    using namespace lsp;
+
+    // Sequence that does not support span access
+    class CharSequence: public io::IInSequence
+    {
+        private:
+            const LSPString    *pString;
+            size_t              nOffset;
+
+        public:
+            explicit CharSequence(const LSPString *s)
+            {
+                pString     = s;
+                nOffset     = 0;
+            }
+
+        public:
+            virtual lsp_swchar_t read() override
+            {
+                if (nOffset >= pString->length())
+                    return -set_error(STATUS_EOF);
+                set_error(STATUS_OK);
+                return pString->char_at(nOffset++);
+            }
+
+            virtual ssize_t read(lsp_wchar_t *dst, size_t count) override
+            {
+                size_t n = 0;
+                for ( ; n < count; ++n)
+                {
+                    lsp_swchar_t ch = read();
+                    if (ch < 0)
+                        return (n > 0) ? n : ch;
+                    dst[n]      = ch;
+                }
+                return n;
+            }
+    };
+} /* namespace */
+
+UTEST_BEGIN("runtime.io", spanreader)
+
+    void init_string(LSPString *s, size_t count)
+    {
+        s->clear();
+        for (size_t i=0; i<count; ++i)
+            UTEST_ASSERT(s->append(lsp_wchar_t('a' + (i % 26))));
+    }
+
+    void test_read_all(io::IInSequence *seq, const LSPString *src, bool native)
+    {
+        const lsp_wchar_t *ptr = NULL;
+        size_t len = 0;
+        const status_t res = seq->peek_span(&ptr, &len);
+        UTEST_ASSERT((res == STATUS_OK) == native);
+
+        io::SpanReader r(seq);
+        for (size_t i=0, n=src->length(); i<n; ++i)
+        {
+            lsp_swchar_t ch = r.read();
+            UTEST_ASSERT_MSG(ch == lsp_swchar_t(src->char_at(i)),
+                "Invalid character at position %d: 0x%x", int(i), int(ch));
+        }
+        UTEST_ASSERT(r.read() == -STATUS_EOF);
+        UTEST_ASSERT(r.sync() == STATUS_OK);
+    }
+
+    void test_string_sequence(const LSPString *src)
+    {
+        printf("Testing span access for string sequence\n");
+
+        io::InStringSequence seq(src);
+        const lsp_wchar_t *ptr = NULL;
+        size_t len = 0;
+
+        UTEST_ASSERT(seq.peek_span(&ptr, &len) == STATUS_OK);
+        UTEST_ASSERT(len == src->length());
+        UTEST_ASSERT(ptr == src->characters());
+
+        // Peek does not change the position
+        UTEST_ASSERT(seq.read() == lsp_swchar_t(src->char_at(0)));
+        UTEST_ASSERT(seq.consume(10) == 10);
+        UTEST_ASSERT(seq.peek_span(&ptr, &len) == STATUS_OK);
+        UTEST_ASSERT(len == src->length() - 11);
+        UTEST_ASSERT(ptr[0] == src->char_at(11));
+        UTEST_ASSERT(seq.consume(len) == ssize_t(len));
+        UTEST_ASSERT(seq.peek_span(&ptr, &len) == STATUS_EOF);
+        UTEST_ASSERT(seq.read() == -STATUS_EOF);
+        UTEST_ASSERT(seq.close() == STATUS_OK);
+
+        io::InStringSequence all(src);
+        test_read_all(&all, src, true);
+    }
+
+    void test_sequence(const LSPString *src)
+    {
+        printf("Testing span access for decoding sequence\n");
+
+        const char *utf8 = src->get_utf8();
+        UTEST_ASSERT(utf8 != NULL);
+
+        io::InMemoryStream is(utf8, strlen(utf8));
+        io::InSequence seq;
+        UTEST_ASSERT(seq.wrap(&is, 0, "UTF-8") == STATUS_OK);
+
+        // Read part of the data by the reader and then continue with the sequence
+        {
+            io::SpanReader r(&seq);
+            for (size_t i=0; i<100; ++i)
+                UTEST_ASSERT(r.read() == lsp_swchar_t(src->char_at(i)));
+        }
+
+        LSPString tmp;
+        UTEST_ASSERT(seq.read_line(&tmp, true) == STATUS_OK);
+        UTEST_ASSERT(tmp.equals(&src->characters()[100], src->length() - 100));
+        UTEST_ASSERT(seq.close() == STATUS_OK);
+
+        io::InMemoryStream is2(utf8, strlen(utf8));
+        UTEST_ASSERT(seq.wrap(&is2, 0, "UTF-8") == STATUS_OK);
+        test_read_all(&seq, src, true);
+        UTEST_ASSERT(seq.close() == STATUS_OK);
+    }
+
+    void test_mark_sequence(const LSPString *src)
+    {
+        printf("Testing span access for mark sequence\n");
+
+        io::InStringSequence in(src);
+        io::InMarkSequence seq;
+        UTEST_ASSERT(seq.wrap(&in) == STATUS_OK);
+
+        const lsp_wchar_t *ptr = NULL;
+        size_t len = 0;
+
+        // Consume data after mark and then reset
+        UTEST_ASSERT(seq.consume(5) == 5);
+        UTEST_ASSERT(seq.mark(100) == STATUS_OK);
+        UTEST_ASSERT(seq.peek_span(&ptr, &len) == STATUS_OK);
+        UTEST_ASSERT(len > 0);
+        UTEST_ASSERT(ptr[0] == src->char_at(5));
+        UTEST_ASSERT(seq.consume(3) == 3);
+        UTEST_ASSERT(seq.read() == lsp_swchar_t(src->char_at(8)));
+        UTEST_ASSERT(seq.reset() == STATUS_OK);
+
+        UTEST_ASSERT(seq.peek_span(&ptr, &len) == STATUS_OK);
+        UTEST_ASSERT(ptr[0] == src->char_at(5));
+
+        // Read the rest of data using the reader
+        io::SpanReader r(&seq);
+        for (size_t i=5, n=src->length(); i<n; ++i)
+            UTEST_ASSERT(r.read() == lsp_swchar_t(src->char_at(i)));
+        UTEST_ASSERT(r.read() == -STATUS_EOF);
+    }
+
+    void test_fallback(const LSPString *src)
+    {
+        printf("Testing fallback for sequences without span access\n");
+
+        CharSequence seq(src);
+        test_read_all(&seq, src, false);
+
+        // The position of the sequence should stay exact
+        CharSequence seq2(src);
+        {
+            io::SpanReader r(&seq2);
+            UTEST_ASSERT(r.read() == lsp_swchar_t(src->char_at(0)));
+            UTEST_ASSERT(r.read() == lsp_swchar_t(src->char_at(1)));
+        }
+        UTEST_ASSERT(seq2.read() == lsp_swchar_t(src->char_at(2)));
+    }
+
+    UTEST_MAIN
+    {
+        LSPString src;
+        init_string(&src, 10000);
+        UTEST_ASSERT(src.append_utf8("\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82"));
+
+        test_string_sequence(&src);
+        test_sequence(&src);
+        test_mark_sequence(&src);
+        test_fallback(&src);
+    }
+
+UTEST_END
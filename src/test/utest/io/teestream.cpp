@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/io/InMemoryStream.h>
+#include <lsp-plug.in/io/InTeeStream.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define DATA_SIZE       0x10000
+
+UTEST_BEGIN("runtime.io", teestream)
+
+    void init_random(uint8_t *dst, size_t count)
+    {
+        uint32_t seed = 0x12345678;
+        for (size_t i=0; i<count; ++i)
+        {
+            seed            = seed * 1664525 + 1013904223;
+            dst[i]          = uint8_t(seed >> 24);
+        }
+    }
+
+    UTEST_MAIN
+    {
+        uint8_t data[DATA_SIZE], buf[DATA_SIZE];
+        init_random(data, DATA_SIZE);
+
+        io::InMemoryStream ims(data, DATA_SIZE);
+        io::OutMemoryStream *oms = new io::OutMemoryStream();
+        io::InTeeStream is;
+
+        UTEST_ASSERT(is.read(buf, 1) == -STATUS_CLOSED);
+        UTEST_ASSERT(is.wrap(&ims, 0, NULL, 0) == STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(is.wrap(&ims, 0, oms, WRAP_DELETE) == STATUS_OK);
+        UTEST_ASSERT(is.wrap(&ims, 0, oms, WRAP_DELETE) == STATUS_BAD_STATE);
+
+        // Read data with different chunk sizes and skip some data
+        size_t off = 0;
+        for (size_t chunk = 1; off < DATA_SIZE; chunk = chunk * 3 + 1)
+        {
+            ssize_t n = is.read(&buf[off], lsp_min(chunk, DATA_SIZE - off));
+            UTEST_ASSERT(n > 0);
+            off        += n;
+            UTEST_ASSERT(is.position() == wssize_t(off));
+
+            n           = is.skip(lsp_min(size_t(100), DATA_SIZE - off));
+            UTEST_ASSERT(n >= 0);
+            if (n > 0)
+                memcpy(&buf[off], &data[off], n);
+            off        += n;
+        }
+
+        UTEST_ASSERT(is.read(buf, 1) == -STATUS_EOF);
+        UTEST_ASSERT(memcmp(buf, data, DATA_SIZE) == 0);
+        UTEST_ASSERT(is.copied() == DATA_SIZE);
+        UTEST_ASSERT(oms->size() == DATA_SIZE);
+        UTEST_ASSERT(memcmp(oms->data(), data, DATA_SIZE) == 0);
+        UTEST_ASSERT(is.close() == STATUS_OK);
+        UTEST_ASSERT(is.read(buf, 1) == -STATUS_CLOSED);
+    }
+
+UTEST_END
@@ -0,0 +1,531 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+namespace
+{
+    using namespace lsp;
+
+    static const lsp::utf_kernel_t kernels[] =
+    {
+        lsp::UTF_KERNEL_GENERIC,
+        lsp::UTF_KERNEL_SSE2,
+        lsp::UTF_KERNEL_AVX2,
+        lsp::UTF_KERNEL_NEON
+    };
+
+    static const char *kernel_names[] =
+    {
+        "generic",
+        "sse2",
+        "avx2",
+        "neon"
+    };
+
+    /**
+     * Reference decoder of one UTF-8 character which replaces each maximal
+     * subpart of ill-formed sequence with single replacement character
+     */
+    static size_t ref_decode_utf8(lsp_utf32_t *cp, bool *valid, const uint8_t *s, size_t n)
+    {
+        const uint8_t c = s[0];
+        size_t need;
+        uint8_t lo = 0x80, hi = 0xbf;
+        lsp_utf32_t v;
+
+        if (c < 0x80)
+        {
+            *cp     = c;
+            *valid  = true;
+            return 1;
+        }
+        else if ((c >= 0xc2) && (c <= 0xdf))
+        {
+            need    = 1;
+            v       = c & 0x1f;
+        }
+        else if ((c >= 0xe0) && (c <= 0xef))
+        {
+            need    = 2;
+            v       = c & 0x0f;
+            if (c == 0xe0)
+                lo      = 0xa0;
+            else if (c == 0xed)
+                hi      = 0x9f;
+        }
+        else if ((c >= 0xf0) && (c <= 0xf4))
+        {
+            need    = 3;
+            v       = c & 0x07;
+            if (c == 0xf0)
+                lo      = 0x90;
+            else if (c == 0xf4)
+                hi      = 0x8f;
+        }
+        else
+        {
+            *cp     = 0xfffd;
+            *valid  = false;
+            return 1;
+        }
+
+        size_t i = 1;
+        for ( ; (i <= need) && (i < n); ++i)
+        {
+            if ((s[i] < lo) || (s[i] > hi))
+                break;
+            v       = (v << 6) | (s[i] & 0x3f);
+            lo      = 0x80;
+            hi      = 0xbf;
+        }
+
+        *valid  = (i > need);
+        *cp     = (*valid) ? v : 0xfffd;
+        return i;
+    }
+
+    static size_t ref_validate_utf8(const uint8_t *s, size_t n)
+    {
+        lsp_utf32_t cp;
+        bool valid;
+        size_t i = 0;
+
+        while (i < n)
+        {
+            const size_t len = ref_decode_utf8(&cp, &valid, &s[i], n - i);
+            if (!valid)
+                break;
+            i      += len;
+        }
+
+        return i;
+    }
+
+    static size_t ref_decode_utf8_all(lsp_utf32_t *dst, const uint8_t *s, size_t n)
+    {
+        lsp_utf32_t cp;
+        bool valid;
+        size_t i = 0, count = 0;
+
+        while (i < n)
+        {
+            i          += ref_decode_utf8(&cp, &valid, &s[i], n - i);
+            dst[count++]= cp;
+        }
+
+        return count;
+    }
+
+    static uint32_t next_random(uint32_t *seed)
+    {
+        *seed   = *seed * 1103515245 + 12345;
+        return *seed >> 8;
+    }
+
+    static lsp_utf32_t random_codepoint(uint32_t *seed)
+    {
+        lsp_utf32_t cp;
+        const uint32_t kind = next_random(seed) % 10;
+
+        if (kind < 5)
+            return next_random(seed) % 0x80;
+        else if (kind < 7)
+            return 0x80 + next_random(seed) % 0x780;
+        else if (kind < 9)
+        {
+            do {
+                cp  = 0x800 + next_random(seed) % 0xf800;
+            } while ((cp >= 0xd800) && (cp < 0xe000));
+            return cp;
+        }
+
+        return 0x10000 + next_random(seed) % 0x100000;
+    }
+
+    static size_t encode_utf8(uint8_t *dst, lsp_utf32_t cp)
+    {
+        char *p = reinterpret_cast<char *>(dst);
+        lsp::write_utf8_codepoint(&p, cp);
+        return p - reinterpret_cast<char *>(dst);
+    }
+
+    /**
+     * Generate ill-formed UTF-8 sequence: random byte, truncated multi-byte
+     * sequence or lead byte with restricted range of second byte followed
+     * by random continuation bytes
+     */
+    static size_t random_damage(uint8_t *dst, uint32_t *seed)
+    {
+        static const uint8_t leads[] = { 0xe0, 0xed, 0xf0, 0xf4 };
+
+        switch (next_random(seed) % 3)
+        {
+            case 0:
+            {
+                const size_t len    = encode_utf8(dst, 0x80 + next_random(seed) % 0x10ff80);
+                return (len > 1) ? 1 + next_random(seed) % (len - 1) : len;
+            }
+            case 1:
+            {
+                const size_t len    = 2 + next_random(seed) % 3;
+                dst[0]              = leads[next_random(seed) % (sizeof(leads)/sizeof(leads[0]))];
+                for (size_t i=1; i<len; ++i)
+                    dst[i]              = 0x80 + next_random(seed) % 0x40;
+                return len;
+            }
+            default:
+                dst[0]              = uint8_t(next_random(seed));
+                return 1;
+        }
+    }
+
+    /**
+     * Generate random UTF-8 text, optionally damaged with ill-formed sequences
+     */
+    static size_t random_utf8(uint8_t *dst, size_t count, uint32_t *seed, bool damage)
+    {
+        size_t n = 0;
+        while (n + 4 <= count)
+        {
+            if ((damage) && ((next_random(seed) % 16) == 0))
+                n          += random_damage(&dst[n], seed);
+            else
+                n          += encode_utf8(&dst[n], random_codepoint(seed));
+        }
+        return n;
+    }
+
+    typedef struct utf8_sequence_t
+    {
+        const char     *seq;
+        lsp_utf32_t     cp[5];
+    } utf8_sequence_t;
+
+    // Each maximal subpart of ill-formed sequence is replaced by single replacement character
+    static const utf8_sequence_t utf8_sequences[] =
+    {
+        // Well-formed boundary characters
+        { "\xed\x9f\xbf",             { 0xd7ff, 0 }                           },
+        { "\xee\x80\x80",             { 0xe000, 0 }                           },
+        { "\xf0\x90\x80\x80",         { 0x10000, 0 }                          },
+        { "\xf4\x8f\xbf\xbf",         { 0x10ffff, 0 }                         },
+        // Surrogates
+        { "\xed\xa0\x61",             { 0xfffd, 0xfffd, 'a', 0 }              },
+        { "\xed\xa0\x80",             { 0xfffd, 0xfffd, 0xfffd, 0 }           },
+        { "\xed\xbf\xbf",             { 0xfffd, 0xfffd, 0xfffd, 0 }           },
+        // Overlong sequences
+        { "\xc0\xaf",                 { 0xfffd, 0xfffd, 0 }                   },
+        { "\xc1\xbf",                 { 0xfffd, 0xfffd, 0 }                   },
+        { "\xe0\x80\x80",             { 0xfffd, 0xfffd, 0xfffd, 0 }           },
+        { "\xe0\x9f\x61",             { 0xfffd, 0xfffd, 'a', 0 }              },
+        { "\xf0\x80\x61",             { 0xfffd, 0xfffd, 'a', 0 }              },
+        { "\xf0\x8f\xbf\xbf",         { 0xfffd, 0xfffd, 0xfffd, 0xfffd, 0 }   },
+        // Code points above 0x10ffff
+        { "\xf4\x90\x61",             { 0xfffd, 0xfffd, 'a', 0 }              },
+        { "\xf4\x90\x80\x80",         { 0xfffd, 0xfffd, 0xfffd, 0xfffd, 0 }   },
+        { "\xf5\x80\x80\x80",         { 0xfffd, 0xfffd, 0xfffd, 0xfffd, 0 }   },
+        // Truncated sequences
+        { "\xc3\x61",                 { 0xfffd, 'a', 0 }                      },
+        { "\xe2\x82\x61",             { 0xfffd, 'a', 0 }                      },
+        { "\xf0\x9f\x61",             { 0xfffd, 'a', 0 }                      },
+        { "\xf0\x9f\x98\x61",         { 0xfffd, 'a', 0 }                      },
+        { "\xf0\x9f\x98\xed\x9f\xbf", { 0xfffd, 0xd7ff, 0 }                   },
+        // Stray bytes
+        { "\x80\xbf",                 { 0xfffd, 0xfffd, 0 }                   },
+        { "\xfe\xff\x61",             { 0xfffd, 0xfffd, 'a', 0 }              },
+        { NULL,                         { 0 }                                   }
+    };
+}
+
+UTEST_BEGIN("runtime.io", utf)
+
+    void test_validate_sequences(const char *kernel)
+    {
+        uint8_t buf[0x40];
+        printf("Testing validation of short sequences for kernel %s\n", kernel);
+
+        // Exhaustive check of all 1-, 2- and 3-byte sequences at different offsets within ASCII text
+        for (uint32_t v=0; v < 0x1000000; ++v)
+        {
+            const uint8_t seq[3] = { uint8_t(v >> 16), uint8_t(v >> 8), uint8_t(v) };
+            const size_t len    = ((v >> 16) != 0) ? 3 : ((v >> 8) != 0) ? 2 : 1;
+            const size_t off    = (v * 7) % (sizeof(buf) - 4);
+            const uint8_t *s    = &seq[3 - len];
+
+            memset(buf, 'a', sizeof(buf));
+            memcpy(&buf[off], s, len);
+
+            const size_t expected   = ref_validate_utf8(buf, sizeof(buf));
+            const size_t result     = utf8_validate(reinterpret_cast<const char *>(buf), sizeof(buf));
+            UTEST_ASSERT_MSG(result == expected,
+                "Validation of sequence %06x at offset %d failed: result=%d, expected=%d",
+                int(v), int(off), int(result), int(expected));
+        }
+
+        // Sampled check of 4-byte sequences
+        uint32_t seed = 0x5a5a5a5a;
+        for (size_t i=0; i < 0x100000; ++i)
+        {
+            const uint32_t v    = (next_random(&seed) & 0xffffff) | 0xf0000000 | ((i & 0xf) << 24);
+            const uint8_t seq[4]= { uint8_t(v >> 24), uint8_t(v >> 16), uint8_t(v >> 8), uint8_t(v) };
+            const size_t off    = i % (sizeof(buf) - 4);
+
+            memset(buf, 'a', sizeof(buf));
+            memcpy(&buf[off], seq, sizeof(seq));
+
+            const size_t expected   = ref_validate_utf8(buf, sizeof(buf));
+            const size_t result     = utf8_validate(reinterpret_cast<const char *>(buf), sizeof(buf));
+            UTEST_ASSERT_MSG(result == expected,
+                "Validation of sequence %08x at offset %d failed: result=%d, expected=%d",
+                int(v), int(off), int(result), int(expected));
+        }
+    }
+
+    void test_decode_random(const uint8_t *src, size_t count, lsp_utf32_t *ref, lsp_utf32_t *dst, lsp_utf16_t *u16, char *u8)
+    {
+        const size_t nref = ref_decode_utf8_all(ref, src, count);
+        const char *s8 = reinterpret_cast<const char *>(src);
+
+        UTEST_FOREACH(limit, 1, 3, 17, 64, 1000, 0x10000)
+        {
+            // UTF-8 -> UTF-32 with limited buffers, incomplete sequences are left for the next call
+            size_t ndst = 0, done = 0, chunk = limit;
+            while (done < count)
+            {
+                size_t nsrc         = lsp_min(chunk, count - done);
+                size_t nout         = limit;
+                const size_t avail  = nsrc;
+                utf8_to_utf32le(&dst[ndst], &nout, &s8[done], &nsrc, (done + avail) >= count);
+
+                const size_t consumed = avail - nsrc;
+                ndst               += limit - nout;
+                done               += consumed;
+                chunk               = (consumed > 0) ? limit : chunk + 1;
+                UTEST_ASSERT(chunk <= limit + 4);
+            }
+            for (size_t i=0; i<ndst; ++i)
+                dst[i]          = LE_TO_CPU(dst[i]);
+
+            UTEST_ASSERT_MSG(ndst == nref, "limit=%d: decoded %d characters, expected %d", int(limit), int(ndst), int(nref));
+            for (size_t i=0; i<nref; ++i)
+                UTEST_ASSERT_MSG(dst[i] == ref[i], "limit=%d: invalid character at %d: 0x%x vs 0x%x",
+                    int(limit), int(i), int(dst[i]), int(ref[i]));
+        }
+
+        // UTF-8 -> UTF-16 -> UTF-32
+        size_t nsrc = count, ndst = count;
+        utf8_to_utf16be(u16, &ndst, s8, &nsrc, true);
+        UTEST_ASSERT(nsrc == 0);
+        const size_t n16 = count - ndst;
+
+        nsrc = n16;
+        ndst = count;
+        UTEST_ASSERT(utf16be_to_utf32le(dst, &ndst, u16, &nsrc, true) == nref);
+        UTEST_ASSERT(nsrc == 0);
+        for (size_t i=0; i<nref; ++i)
+            UTEST_ASSERT(LE_TO_CPU(dst[i]) == ref[i]);
+
+        // UTF-32 -> UTF-8 in both byte orders
+        for (size_t i=0; i<nref; ++i)
+            dst[i]      = CPU_TO_BE(ref[i]);
+        nsrc = nref;
+        ndst = count * 3;
+        UTEST_ASSERT(utf32be_to_utf8(u8, &ndst, dst, &nsrc, true) == nref);
+        UTEST_ASSERT(nsrc == 0);
+        const size_t n8 = count * 3 - ndst;
+
+        for (size_t i=0; i<nref; ++i)
+            dst[i]      = CPU_TO_LE(ref[i]);
+        nsrc = nref;
+        ndst = count * 3;
+        UTEST_ASSERT(utf32le_to_utf8(&u8[n8], &ndst, dst, &nsrc, true) == nref);
+        UTEST_ASSERT(count * 3 - ndst == n8);
+        UTEST_ASSERT(memcmp(u8, &u8[n8], n8) == 0);
+
+        // UTF-16 -> UTF-8 must produce the same result
+        nsrc = n16;
+        ndst = count * 3;
+        utf16be_to_utf8(&u8[n8], &ndst, u16, &nsrc, true);
+        UTEST_ASSERT(nsrc == 0);
+        UTEST_ASSERT(count * 3 - ndst == n8);
+        UTEST_ASSERT(memcmp(u8, &u8[n8], n8) == 0);
+
+        // UTF-32 -> UTF-16 must produce the same result
+        for (size_t i=0; i<nref; ++i)
+            dst[i]      = CPU_TO_LE(ref[i]);
+        nsrc = nref;
+        ndst = count;
+        UTEST_ASSERT(utf32le_to_utf16be(&u16[n16], &ndst, dst, &nsrc, true) == nref);
+        UTEST_ASSERT(count - ndst == n16);
+        UTEST_ASSERT(memcmp(u16, &u16[n16], n16 * sizeof(lsp_utf16_t)) == 0);
+    }
+
+    void test_decode_sequences(const char *kernel, uint8_t *src, lsp_utf32_t *ref, lsp_utf32_t *dst, lsp_utf16_t *u16, char *u8)
+    {
+        static constexpr size_t PAD_SIZE = 0x60;
+        lsp_utf32_t expected[PAD_SIZE * 2 + 8];
+
+        printf("Testing decoding of ill-formed sequences for kernel %s\n", kernel);
+
+        for (const utf8_sequence_t *seq = utf8_sequences; seq->seq != NULL; ++seq)
+        {
+            // Put the sequence at different offsets to pass it through vector and scalar paths
+            UTEST_FOREACH(off, 0, 1, 15, 16, 31, 32, 33, 63)
+            {
+                const size_t len    = strlen(seq->seq);
+                size_t count = 0, nexp = 0;
+                for (size_t i=0; i<size_t(off); ++i, ++nexp)
+                {
+                    src[count++]        = 'a';
+                    expected[nexp]      = 'a';
+                }
+                memcpy(&src[count], seq->seq, len);
+                count              += len;
+                for (const lsp_utf32_t *cp = seq->cp; *cp != 0; ++cp)
+                    expected[nexp++]    = *cp;
+                for (size_t i=0; i<PAD_SIZE - size_t(off); ++i, ++nexp)
+                {
+                    src[count++]        = 'z';
+                    expected[nexp]      = 'z';
+                }
+
+                // Reference decoder should follow the table
+                const size_t nref   = ref_decode_utf8_all(ref, src, count);
+                UTEST_ASSERT_MSG(nref == nexp, "Reference decoded %d characters for sequence #%d, expected %d",
+                    int(nref), int(seq - utf8_sequences), int(nexp));
+                for (size_t i=0; i<nexp; ++i)
+                    UTEST_ASSERT_MSG(ref[i] == expected[i], "Reference mismatch at %d for sequence #%d: 0x%x vs 0x%x",
+                        int(i), int(seq - utf8_sequences), int(ref[i]), int(expected[i]));
+
+                // Library decoder should produce the same result
+                size_t nsrc = count, ndst = count;
+                UTEST_ASSERT(utf8_to_utf32le(dst, &ndst, reinterpret_cast<const char *>(src), &nsrc, true) == nexp);
+                UTEST_ASSERT((nsrc == 0) && (ndst == count - nexp));
+                for (size_t i=0; i<nexp; ++i)
+                    UTEST_ASSERT_MSG(LE_TO_CPU(dst[i]) == expected[i], "Mismatch at %d for sequence #%d at offset %d: 0x%x vs 0x%x",
+                        int(i), int(seq - utf8_sequences), int(off), int(LE_TO_CPU(dst[i])), int(expected[i]));
+
+                // Decoding of NULL-terminated string
+                src[count]          = '\0';
+                const char *s       = reinterpret_cast<const char *>(src);
+                for (size_t i=0; i<nexp; ++i)
+                    UTEST_ASSERT(read_utf8_codepoint(&s) == expected[i]);
+                UTEST_ASSERT(read_utf8_codepoint(&s) == 0);
+
+                // Streaming conversions with limited buffers
+                test_decode_random(src, count, ref, dst, u16, u8);
+            }
+        }
+    }
+
+    void test_small_buffers()
+    {
+        printf("Testing conversion with small output buffers\n");
+
+        // Output buffer too small to fit the character
+        lsp_utf16_t u16[4];
+        const char *src = "\xf0\x9f\x98\x80";
+        size_t nsrc = 4, ndst = 1;
+        UTEST_ASSERT(utf8_to_utf16le(u16, &ndst, src, &nsrc, true) == 0);
+        UTEST_ASSERT((nsrc == 4) && (ndst == 1));
+
+        char u8[4];
+        const lsp_utf32_t u32[] = { CPU_TO_LE(lsp_utf32_t('a')), CPU_TO_LE(lsp_utf32_t(0x20ac)) };
+        nsrc = 2;
+        ndst = 3;
+        UTEST_ASSERT(utf32le_to_utf8(u8, &ndst, u32, &nsrc, true) == 1);
+        UTEST_ASSERT((nsrc == 1) && (ndst == 2));
+
+        // Incomplete sequence should not be consumed without force
+        lsp_utf32_t dst[4];
+        nsrc = 3;
+        ndst = 4;
+        UTEST_ASSERT(utf8_to_utf32le(dst, &ndst, "a\xe2\x82", &nsrc, false) == 1);
+        UTEST_ASSERT((nsrc == 2) && (ndst == 3));
+        nsrc = 3;
+        ndst = 4;
+        UTEST_ASSERT(utf8_to_utf32le(dst, &ndst, "a\xe2\x82", &nsrc, true) == 2);
+        UTEST_ASSERT((nsrc == 0) && (ndst == 2));
+        UTEST_ASSERT(LE_TO_CPU(dst[1]) == 0xfffd);
+
+        // Non-streaming routines
+        const lsp_utf32_t be[] = { CPU_TO_BE(lsp_utf32_t(0x20ac)), CPU_TO_BE(lsp_utf32_t('b')), 0 };
+        char *s = utf32be_to_utf8(be);
+        UTEST_ASSERT(s != NULL);
+        UTEST_ASSERT(strcmp(s, "\xe2\x82\xac" "b") == 0);
+        free(s);
+
+        lsp_utf16_t *w = utf8_to_utf16be("\xf0\x9f\x98\x80z");
+        UTEST_ASSERT(w != NULL);
+        UTEST_ASSERT((BE_TO_CPU(w[0]) == 0xd83d) && (BE_TO_CPU(w[1]) == 0xde00) && (BE_TO_CPU(w[2]) == 'z') && (w[3] == 0));
+        free(w);
+    }
+
+    UTEST_MAIN
+    {
+        static constexpr size_t TEXT_SIZE = 0x8000;
+
+        uint8_t *src        = static_cast<uint8_t *>(malloc(TEXT_SIZE));
+        lsp_utf32_t *ref    = static_cast<lsp_utf32_t *>(malloc(TEXT_SIZE * sizeof(lsp_utf32_t)));
+        lsp_utf32_t *dst    = static_cast<lsp_utf32_t *>(malloc(TEXT_SIZE * 4 * sizeof(lsp_utf32_t)));
+        lsp_utf16_t *u16    = static_cast<lsp_utf16_t *>(malloc(TEXT_SIZE * 2 * sizeof(lsp_utf16_t)));
+        char *u8            = static_cast<char *>(malloc(TEXT_SIZE * 6));
+        lsp_finally {
+            free(src);
+            free(ref);
+            free(dst);
+            free(u16);
+            free(u8);
+            select_utf_kernel(UTF_KERNEL_AUTO);
+        };
+        UTEST_ASSERT((src != NULL) && (ref != NULL) && (dst != NULL) && (u16 != NULL) && (u8 != NULL));
+
+        for (size_t k=0; k < sizeof(kernels)/sizeof(kernels[0]); ++k)
+        {
+            if (select_utf_kernel(kernels[k]) != STATUS_OK)
+            {
+                printf("Kernel %s is not supported, skipping\n", kernel_names[k]);
+                continue;
+            }
+            UTEST_ASSERT(utf_kernel() == kernels[k]);
+
+            test_validate_sequences(kernel_names[k]);
+            test_decode_sequences(kernel_names[k], src, ref, dst, u16, u8);
+
+            printf("Testing conversion of random text for kernel %s\n", kernel_names[k]);
+            uint32_t seed = 0x1234 + k;
+            for (size_t i=0; i<8; ++i)
+            {
+                const size_t count = random_utf8(src, TEXT_SIZE, &seed, (i & 1) != 0);
+                test_decode_random(src, count, ref, dst, u16, u8);
+            }
+        }
+
+        select_utf_kernel(UTF_KERNEL_AUTO);
+        test_small_buffers();
+    }
+
+UTEST_END
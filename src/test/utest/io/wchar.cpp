@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/io/charset.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define MAX_LENGTH      200
+
+namespace
+{
+    static const lsp::utf_kernel_t kernels[] =
+    {
+        lsp::UTF_KERNEL_GENERIC,
+        lsp::UTF_KERNEL_SSE2,
+        lsp::UTF_KERNEL_AVX2,
+        lsp::UTF_KERNEL_NEON
+    };
+
+    static const char *kernel_names[] =
+    {
+        "generic",
+        "sse2",
+        "avx2",
+        "neon"
+    };
+
+    // Small alphabet to produce many matches, mixed case and non-ASCII characters
+    static const lsp::lsp_wchar_t alphabet[] =
+    {
+        'a', 'b', 'A', 'B', 'z', 'Z', '@', '[', '`', '{',
+        0x0410, 0x0430, 0x0401, 0x0451, 0x20ac
+    };
+}
+
+UTEST_BEGIN("runtime.io", wchar)
+
+    void random_text(lsp_wchar_t *dst, size_t count, size_t letters, uint32_t *seed)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            *seed       = (*seed * 1103515245) + 12345;
+            dst[i]      = alphabet[(*seed >> 16) % letters];
+        }
+    }
+
+    ssize_t ref_find(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        for (size_t i=0; i<count; ++i)
+            if (s[i] == ch)
+                return i;
+        return -1;
+    }
+
+    ssize_t ref_rfind(const lsp_wchar_t *s, size_t count, lsp_wchar_t ch)
+    {
+        for (ssize_t i=count-1; i>=0; --i)
+            if (s[i] == ch)
+                return i;
+        return -1;
+    }
+
+    bool ref_match(const lsp_wchar_t *s, const lsp_wchar_t *str, size_t len)
+    {
+        for (size_t i=0; i<len; ++i)
+            if (s[i] != str[i])
+                return false;
+        return true;
+    }
+
+    ssize_t ref_search(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len)
+    {
+        for (ssize_t i=0; i <= ssize_t(count) - ssize_t(len); ++i)
+            if (ref_match(&s[i], str, len))
+                return i;
+        return -1;
+    }
+
+    ssize_t ref_rsearch(const lsp_wchar_t *s, size_t count, const lsp_wchar_t *str, size_t len)
+    {
+        for (ssize_t i=ssize_t(count) - ssize_t(len); i >= 0; --i)
+            if (ref_match(&s[i], str, len))
+                return i;
+        return -1;
+    }
+
+    size_t ref_casemismatch(const lsp_wchar_t *a, const lsp_wchar_t *b, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+            if (to_casefold(a[i]) != to_casefold(b[i]))
+                return i;
+        return count;
+    }
+
+    size_t ref_hash(const lsp_wchar_t *s, size_t count)
+    {
+        uint32_t lanes[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        size_t i = 0, hash = 0;
+        if (count >= 8)
+        {
+            for ( ; (i + 8) <= count; i += 8)
+                for (size_t j=0; j<8; ++j)
+                    lanes[j]    = uint32_t(lanes[j] * 0x10015) ^ s[i + j];
+            for (size_t j=0; j<8; ++j)
+                hash        = (hash * 0x10015) ^ lanes[j];
+        }
+        for ( ; i<count; ++i)
+            hash        = (hash * 0x10015) ^ s[i];
+        return hash;
+    }
+
+    void test_search(const char *kernel, lsp_wchar_t *a, uint32_t *seed)
+    {
+        printf("Testing search routines for kernel %s\n", kernel);
+
+        for (size_t len=0; len<=MAX_LENGTH; ++len)
+        {
+            for (size_t letters=2; letters <= 15; letters += 13)
+            {
+                random_text(a, len, letters, seed);
+
+                for (size_t k=0; k<letters; ++k)
+                {
+                    const lsp_wchar_t ch = alphabet[k];
+                    UTEST_ASSERT(wchar_find(a, len, ch) == ref_find(a, len, ch));
+                    UTEST_ASSERT(wchar_rfind(a, len, ch) == ref_rfind(a, len, ch));
+
+                    size_t n = 0;
+                    for (size_t i=0; i<len; ++i)
+                        n      += (a[i] == ch);
+                    UTEST_ASSERT(wchar_count(a, len, ch) == n);
+                }
+
+                // Search for substrings of the text and random patterns
+                for (size_t plen=1; (plen <= 24) && (plen <= len); ++plen)
+                {
+                    const size_t off = (len - plen) / 2 + (*seed % (len - plen + 1)) / 2;
+                    const lsp_wchar_t *p = &a[off];
+                    UTEST_ASSERT(wchar_search(a, len, p, plen) == ref_search(a, len, p, plen));
+                    UTEST_ASSERT(wchar_rsearch(a, len, p, plen) == ref_rsearch(a, len, p, plen));
+
+                    lsp_wchar_t pattern[24];
+                    random_text(pattern, plen, letters, seed);
+                    UTEST_ASSERT(wchar_search(a, len, pattern, plen) == ref_search(a, len, pattern, plen));
+                    UTEST_ASSERT(wchar_rsearch(a, len, pattern, plen) == ref_rsearch(a, len, pattern, plen));
+                }
+
+                // Pattern longer than the text
+                UTEST_ASSERT(wchar_search(a, len, a, len + 1) < 0);
+                UTEST_ASSERT(wchar_rsearch(a, len, a, len + 1) < 0);
+            }
+        }
+    }
+
+    void test_modify(const char *kernel, lsp_wchar_t *a, lsp_wchar_t *b, uint32_t *seed)
+    {
+        printf("Testing modification routines for kernel %s\n", kernel);
+
+        for (size_t len=0; len<=MAX_LENGTH; ++len)
+        {
+            for (size_t letters=2; letters <= 15; letters += 13)
+            {
+                random_text(a, len, letters, seed);
+
+                // Replace
+                ::memcpy(b, a, len * sizeof(lsp_wchar_t));
+                size_t n = 0;
+                for (size_t i=0; i<len; ++i)
+                {
+                    if (a[i] == 'b')
+                    {
+                        a[i]    = 'x';
+                        ++n;
+                    }
+                }
+                UTEST_ASSERT(wchar_replace(b, len, 'b', 'x') == n);
+                UTEST_ASSERT(::memcmp(a, b, len * sizeof(lsp_wchar_t)) == 0);
+
+                // Case conversion
+                ::memcpy(b, a, len * sizeof(lsp_wchar_t));
+                wchar_tolower(b, len);
+                for (size_t i=0; i<len; ++i)
+                    UTEST_ASSERT(b[i] == to_lower(a[i]));
+
+                ::memcpy(b, a, len * sizeof(lsp_wchar_t));
+                wchar_toupper(b, len);
+                for (size_t i=0; i<len; ++i)
+                    UTEST_ASSERT(b[i] == to_upper(a[i]));
+            }
+        }
+    }
+
+    void test_compare(const char *kernel, lsp_wchar_t *a, lsp_wchar_t *b, uint32_t *seed)
+    {
+        printf("Testing comparison routines for kernel %s\n", kernel);
+
+        for (size_t len=0; len<=MAX_LENGTH; ++len)
+        {
+            for (size_t letters=2; letters <= 15; letters += 13)
+            {
+                random_text(a, len, letters, seed);
+                UTEST_ASSERT(wchar_hash(a, len) == ref_hash(a, len));
+
+                // Equal strings, then strings with different case, then strings with one different character
+                ::memcpy(b, a, len * sizeof(lsp_wchar_t));
+                UTEST_ASSERT(wchar_mismatch(a, b, len) == len);
+                UTEST_ASSERT(wchar_casemismatch(a, b, len) == len);
+
+                wchar_toupper(b, len);
+                UTEST_ASSERT(wchar_casemismatch(a, b, len) == ref_casemismatch(a, b, len));
+
+                for (size_t i=0; i<len; i += 1 + (*seed % 7))
+                {
+                    ::memcpy(b, a, len * sizeof(lsp_wchar_t));
+                    b[i]    = (b[i] == 'x') ? 'y' : 'x';
+                    UTEST_ASSERT(wchar_mismatch(a, b, len) == i);
+                    UTEST_ASSERT(wchar_casemismatch(a, b, len) == i);
+                    if (len > 0)
+                        *seed   = (*seed * 1103515245) + 12345;
+                }
+            }
+        }
+
+        // Short strings keep the sequential hash function
+        lsp_wchar_t s[] = { 'k', 'e', 'y' };
+        size_t h = 0;
+        for (size_t i=0; i<3; ++i)
+            h       = (h * 0x10015) ^ s[i];
+        UTEST_ASSERT(wchar_hash(s, 3) == h);
+    }
+
+    UTEST_MAIN
+    {
+        lsp_wchar_t *a      = static_cast<lsp_wchar_t *>(malloc((MAX_LENGTH + 1) * sizeof(lsp_wchar_t)));
+        lsp_wchar_t *b      = static_cast<lsp_wchar_t *>(malloc((MAX_LENGTH + 1) * sizeof(lsp_wchar_t)));
+        lsp_finally {
+            free(a);
+            free(b);
+            select_wchar_kernel(UTF_KERNEL_AUTO);
+        };
+        UTEST_ASSERT((a != NULL) && (b != NULL));
+
+        for (size_t k=0; k < sizeof(kernels)/sizeof(kernels[0]); ++k)
+        {
+            if (select_wchar_kernel(kernels[k]) != STATUS_OK)
+            {
+                printf("Kernel %s is not supported, skipping\n", kernel_names[k]);
+                continue;
+            }
+            UTEST_ASSERT(wchar_kernel() == kernels[k]);
+
+            uint32_t seed = 0x1234 + k;
+            test_search(kernel_names[k], a, &seed);
+            test_modify(kernel_names[k], a, b, &seed);
+            test_compare(kernel_names[k], a, b, &seed);
+        }
+    }
+
+UTEST_END
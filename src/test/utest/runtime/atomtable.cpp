@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/runtime/AtomTable.h>
+#include <lsp-plug.in/expr/Variables.h>
+#include <lsp-plug.in/fmt/config/types.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+
+#define THREADS         4
+#define NAMES           1000
+
+namespace
+{
+    typedef struct context_t
+    {
+        lsp::AtomTable     *table;
+        const lsp::atom_t  *atoms[NAMES];
+        size_t              first;
+    } context_t;
+
+    lsp::status_t intern_proc(void *arg)
+    {
+        context_t *ctx = static_cast<context_t *>(arg);
+        char buf[32];
+
+        // Each thread walks over names starting at different position
+        for (size_t i=0; i<NAMES; ++i)
+        {
+            size_t index    = (ctx->first + i) % NAMES;
+            snprintf(buf, sizeof(buf), "param_%d", int(index));
+            if ((ctx->atoms[index] = ctx->table->intern(buf)) == NULL)
+                return lsp::STATUS_NO_MEM;
+        }
+
+        return lsp::STATUS_OK;
+    }
+}
+
+UTEST_BEGIN("runtime.runtime", atomtable)
+
+    void test_intern()
+    {
+        printf("Testing basic interning...\n");
+
+        AtomTable table;
+        LSPString s;
+
+        UTEST_ASSERT(table.size() == 0);
+        UTEST_ASSERT(table.find("key") == NULL);
+
+        const atom_t *a = table.intern("key");
+        UTEST_ASSERT(a != NULL);
+        UTEST_ASSERT(a->name.equals_ascii("key"));
+        UTEST_ASSERT(s.set_ascii("key"));
+        UTEST_ASSERT(a->hash == s.hash());
+        UTEST_ASSERT(table.intern(&s) == a);
+        UTEST_ASSERT(table.find(&s) == a);
+        UTEST_ASSERT(table.find("key") == a);
+        UTEST_ASSERT(table.size() == 1);
+
+        const atom_t *b = table.intern("other key");
+        UTEST_ASSERT(b != NULL);
+        UTEST_ASSERT(b != a);
+        UTEST_ASSERT(table.intern("other key") == b);
+        UTEST_ASSERT(table.size() == 2);
+
+        const atom_t *e = table.intern("");
+        UTEST_ASSERT(e != NULL);
+        UTEST_ASSERT(e->name.is_empty());
+        UTEST_ASSERT(table.intern("") == e);
+        UTEST_ASSERT(table.intern(static_cast<const char *>(NULL)) == NULL);
+
+        // Force the table to grow, atoms should remain stable
+        char buf[32];
+        for (size_t i=0; i<NAMES; ++i)
+        {
+            snprintf(buf, sizeof(buf), "key_%d", int(i));
+            UTEST_ASSERT(table.intern(buf) != NULL);
+        }
+        UTEST_ASSERT(table.size() == NAMES + 3);
+        UTEST_ASSERT(table.intern("key") == a);
+        UTEST_ASSERT(table.intern("other key") == b);
+        UTEST_ASSERT(table.intern("") == e);
+        for (size_t i=0; i<NAMES; ++i)
+        {
+            snprintf(buf, sizeof(buf), "key_%d", int(i));
+            const atom_t *x = table.find(buf);
+            UTEST_ASSERT(x != NULL);
+            UTEST_ASSERT(x->name.equals_ascii(buf));
+        }
+
+        // Global table
+        UTEST_ASSERT(intern("global key") == AtomTable::global()->find("global key"));
+        UTEST_ASSERT(intern("global key") != NULL);
+    }
+
+    void test_concurrent()
+    {
+        printf("Testing concurrent interning...\n");
+
+        AtomTable table;
+        context_t ctx[THREADS];
+        ipc::Thread *threads[THREADS];
+
+        for (size_t i=0; i<THREADS; ++i)
+        {
+            ctx[i].table    = &table;
+            ctx[i].first    = (i * NAMES) / THREADS;
+            threads[i]      = new ipc::Thread(intern_proc, &ctx[i]);
+            UTEST_ASSERT(threads[i] != NULL);
+        }
+        lsp_finally {
+            for (size_t i=0; i<THREADS; ++i)
+                delete threads[i];
+        };
+
+        for (size_t i=0; i<THREADS; ++i)
+            UTEST_ASSERT(threads[i]->start() == STATUS_OK);
+        for (size_t i=0; i<THREADS; ++i)
+        {
+            UTEST_ASSERT(threads[i]->join() == STATUS_OK);
+            UTEST_ASSERT(threads[i]->get_result() == STATUS_OK);
+        }
+
+        // All threads should obtain the same atoms
+        UTEST_ASSERT(table.size() == NAMES);
+        for (size_t i=0; i<NAMES; ++i)
+        {
+            for (size_t j=1; j<THREADS; ++j)
+                UTEST_ASSERT(ctx[j].atoms[i] == ctx[0].atoms[i]);
+        }
+    }
+
+    void test_variables()
+    {
+        printf("Testing interned variable lookup...\n");
+
+        AtomTable table;
+        expr::Variables vars;
+        expr::value_t v;
+        expr::init_value(&v);
+        lsp_finally { expr::destroy_value(&v); };
+
+        const atom_t *a = table.intern("a");
+        const atom_t *b = table.intern("b");
+        const atom_t *c = table.intern("c");
+        UTEST_ASSERT((a != NULL) && (b != NULL) && (c != NULL));
+
+        // Set by string, resolve by atom
+        UTEST_ASSERT(vars.set_int("a", 1) == STATUS_OK);
+        UTEST_ASSERT(vars.resolve(&v, a) == STATUS_OK);
+        UTEST_ASSERT((v.type == expr::VT_INT) && (v.v_int == 1));
+        UTEST_ASSERT(vars.resolve(&v, a) == STATUS_OK);
+        UTEST_ASSERT((v.type == expr::VT_INT) && (v.v_int == 1));
+
+        // Set by atom, resolve by string
+        expr::value_t x;
+        x.type      = expr::VT_FLOAT;
+        x.v_float   = 2.0;
+        UTEST_ASSERT(vars.set(b, &x) == STATUS_OK);
+        UTEST_ASSERT(vars.resolve(&v, "b") == STATUS_OK);
+        UTEST_ASSERT((v.type == expr::VT_FLOAT) && (v.v_float == 2.0));
+
+        // Update by string should be visible by atom
+        UTEST_ASSERT(vars.set_int("b", 3) == STATUS_OK);
+        UTEST_ASSERT(vars.resolve(&v, b) == STATUS_OK);
+        UTEST_ASSERT((v.type == expr::VT_INT) && (v.v_int == 3));
+
+        // Missing variable
+        UTEST_ASSERT(vars.resolve(&v, c) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(vars.unset(c) == STATUS_NOT_FOUND);
+
+        // Remove variables by string and by atom
+        UTEST_ASSERT(vars.unset("a") == STATUS_OK);
+        UTEST_ASSERT(vars.resolve(&v, a) == STATUS_NOT_FOUND);
+        UTEST_ASSERT(vars.unset(b, &v) == STATUS_OK);
+        UTEST_ASSERT((v.type == expr::VT_INT) && (v.v_int == 3));
+        UTEST_ASSERT(vars.resolve(&v, "b") == STATUS_NOT_FOUND);
+        UTEST_ASSERT(vars.resolve(&v, b) == STATUS_NOT_FOUND);
+
+        // Re-create variables after removal
+        UTEST_ASSERT(vars.set_int("a", 4) == STATUS_OK);
+        UTEST_ASSERT(vars.resolve(&v, a) == STATUS_OK);
+        UTEST_ASSERT((v.type == expr::VT_INT) && (v.v_int == 4));
+
+        vars.clear();
+        UTEST_ASSERT(vars.resolve(&v, a) == STATUS_NOT_FOUND);
+    }
+
+    void test_params()
+    {
+        printf("Testing interned parameter names...\n");
+
+        AtomTable table;
+        config::param_t p;
+        const atom_t *a = table.intern("bypass");
+        const atom_t *b = table.intern("gain");
+        UTEST_ASSERT((a != NULL) && (b != NULL));
+
+        // Not interned name
+        UTEST_ASSERT(p.set_name("bypass"));
+        UTEST_ASSERT(p.atom == NULL);
+        UTEST_ASSERT(p.is(a));
+        UTEST_ASSERT(!p.is(b));
+
+        // Interned name
+        UTEST_ASSERT(p.intern_name(&table));
+        UTEST_ASSERT(p.atom == a);
+        UTEST_ASSERT(p.is(a));
+        UTEST_ASSERT(!p.is(b));
+
+        UTEST_ASSERT(p.set_name(b));
+        UTEST_ASSERT(p.atom == b);
+        UTEST_ASSERT(p.name.equals_ascii("gain"));
+        UTEST_ASSERT(p.is(b));
+
+        // Copy and clear
+        config::param_t q;
+        UTEST_ASSERT(q.copy(&p));
+        UTEST_ASSERT(q.atom == b);
+        q.clear();
+        UTEST_ASSERT(q.atom == NULL);
+        UTEST_ASSERT(!q.is(b));
+
+        // Setting plain name drops the atom
+        UTEST_ASSERT(p.set_name("bypass"));
+        UTEST_ASSERT(p.atom == NULL);
+        UTEST_ASSERT(p.is(a));
+
+        // Atoms of different tables are compared by name
+        AtomTable local;
+        const atom_t *la = local.intern("bypass");
+        const atom_t *lb = local.intern("gain");
+        UTEST_ASSERT((la != NULL) && (lb != NULL) && (la != a));
+        UTEST_ASSERT(la->table == &local);
+        UTEST_ASSERT(p.intern_name(&table));
+        UTEST_ASSERT(p.is(la));
+        UTEST_ASSERT(!p.is(lb));
+
+        // Direct modification of the name requires reset of the atom
+        UTEST_ASSERT(p.name.set_ascii("gain"));
+        p.atom  = NULL;
+        UTEST_ASSERT(!p.is(a));
+        UTEST_ASSERT(p.is(b));
+        UTEST_ASSERT(p.is(lb));
+    }
+
+    UTEST_MAIN
+    {
+        test_intern();
+        test_concurrent();
+        test_variables();
+        test_params();
+    }
+
+UTEST_END
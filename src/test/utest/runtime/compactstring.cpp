@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/runtime/CompactString.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace
+{
+    // Characters of different width: Latin-1, BMP and supplementary planes
+    static const lsp::lsp_wchar_t chars[] =
+    {
+        'a', 'b', 'c', ' ', 0xe9, 0xff,
+        0x0416, 0x0436, 0x30cf, 0xfffd,
+        0x1f600, 0x10348
+    };
+}
+
+UTEST_BEGIN("runtime.runtime", compactstring)
+
+    void random_string(LSPString *dst, size_t length, size_t alphabet)
+    {
+        dst->clear();
+        for (size_t i=0; i<length; ++i)
+            dst->append(chars[rand() % alphabet]);
+    }
+
+    void test_width()
+    {
+        printf("Testing storage width...\n");
+
+        CompactString s;
+        UTEST_ASSERT(s.is_empty());
+        UTEST_ASSERT(s.set_ascii("parameter"));
+        UTEST_ASSERT(s.width() == 1);
+        UTEST_ASSERT(s.length() == 9);
+        UTEST_ASSERT(s.equals_ascii("parameter"));
+
+        UTEST_ASSERT(s.append(lsp_wchar_t(0xe9)));
+        UTEST_ASSERT(s.width() == 1);
+        UTEST_ASSERT(s.append(lsp_wchar_t(0x0416)));
+        UTEST_ASSERT(s.width() == 2);
+        UTEST_ASSERT(s.length() == 11);
+        UTEST_ASSERT(s.at(0) == 'p');
+        UTEST_ASSERT(s.at(9) == 0xe9);
+        UTEST_ASSERT(s.last() == 0x0416);
+
+        UTEST_ASSERT(s.append(lsp_wchar_t(0x1f600)));
+        UTEST_ASSERT(s.width() == 4);
+        UTEST_ASSERT(s.at(-1) == 0x1f600);
+        UTEST_ASSERT(s.at(-2) == 0x0416);
+        UTEST_ASSERT(s.first() == 'p');
+        UTEST_ASSERT(s.at(12) == 0);
+
+        // Setting the string chooses the width again
+        UTEST_ASSERT(s.set_utf8("\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82"));
+        UTEST_ASSERT(s.width() == 2);
+        UTEST_ASSERT(s.length() == 6);
+        UTEST_ASSERT(s.set_utf8("caf\xc3\xa9"));
+        UTEST_ASSERT(s.width() == 1);
+        UTEST_ASSERT(s.length() == 4);
+        UTEST_ASSERT(s.at(3) == 0xe9);
+
+        s.truncate();
+        UTEST_ASSERT(s.is_empty());
+        UTEST_ASSERT(s.data_size() == 0);
+    }
+
+    void test_conversion()
+    {
+        printf("Testing conversion...\n");
+
+        LSPString src, dst;
+        CompactString cs;
+        char buf[0x200];
+
+        for (size_t alphabet = 4; alphabet <= sizeof(chars)/sizeof(chars[0]); ++alphabet)
+        {
+            for (size_t i=0; i<100; ++i)
+            {
+                random_string(&src, rand() % 64, alphabet);
+
+                UTEST_ASSERT(cs.set(&src));
+                UTEST_ASSERT(cs.length() == src.length());
+                UTEST_ASSERT(cs.equals(&src));
+                UTEST_ASSERT(cs.get(&dst));
+                UTEST_ASSERT(dst.equals(&src));
+
+                // UTF-8 encoding
+                const char *utf8 = src.get_utf8();
+                UTEST_ASSERT(utf8 != NULL);
+                const size_t len = strlen(utf8);
+                UTEST_ASSERT(cs.utf8_length() == len);
+                UTEST_ASSERT(cs.get_utf8(buf, sizeof(buf)) == len);
+                UTEST_ASSERT(strcmp(buf, utf8) == 0);
+
+                size_t bytes = 0;
+                char *clone = cs.clone_utf8(&bytes);
+                UTEST_ASSERT(clone != NULL);
+                UTEST_ASSERT(bytes == len);
+                UTEST_ASSERT(strcmp(clone, utf8) == 0);
+                free(clone);
+
+                // Truncated output should contain only complete characters
+                if (len > 4)
+                {
+                    const size_t n = cs.get_utf8(buf, len - 2);
+                    UTEST_ASSERT(n == len);
+                    UTEST_ASSERT(strlen(buf) < len - 2);
+                    UTEST_ASSERT(strncmp(buf, utf8, strlen(buf)) == 0);
+                }
+
+                // UTF-8 decoding
+                UTEST_ASSERT(cs.set_utf8(utf8));
+                UTEST_ASSERT(cs.equals(&src));
+                UTEST_ASSERT(cs.hash() == src.hash());
+            }
+        }
+    }
+
+    void test_append()
+    {
+        printf("Testing append...\n");
+
+        LSPString a, b, ab;
+        CompactString ca, cb;
+
+        for (size_t i=0; i<1000; ++i)
+        {
+            const size_t alphabet = 4 + rand() % (sizeof(chars)/sizeof(chars[0]) - 3);
+            random_string(&a, rand() % 32, alphabet);
+            random_string(&b, rand() % 32, 4 + rand() % (sizeof(chars)/sizeof(chars[0]) - 3));
+            UTEST_ASSERT(ab.set(&a));
+            UTEST_ASSERT(ab.append(&b));
+
+            UTEST_ASSERT(ca.set(&a));
+            UTEST_ASSERT(cb.set(&b));
+            UTEST_ASSERT(ca.append(&cb));
+            UTEST_ASSERT(ca.equals(&ab));
+            UTEST_ASSERT(ca.hash() == ab.hash());
+
+            UTEST_ASSERT(ca.set(&a));
+            UTEST_ASSERT(ca.append(&b));
+            UTEST_ASSERT(ca.equals(&ab));
+
+            ca.reduce();
+            UTEST_ASSERT(ca.equals(&ab));
+        }
+    }
+
+    void test_compare()
+    {
+        printf("Testing comparison and search...\n");
+
+        LSPString a, b;
+        CompactString ca, cb;
+
+        for (size_t i=0; i<10000; ++i)
+        {
+            random_string(&a, rand() % 16, 4 + rand() % (sizeof(chars)/sizeof(chars[0]) - 3));
+            if (rand() % 4)
+                random_string(&b, rand() % 16, 4 + rand() % (sizeof(chars)/sizeof(chars[0]) - 3));
+            else
+                b.set(&a, rand() % (a.length() + 1));
+
+            UTEST_ASSERT(ca.set(&a));
+            UTEST_ASSERT(cb.set(&b));
+
+            const int r1 = a.compare_to(&b);
+            const int r2 = ca.compare_to(&cb);
+            const int r3 = ca.compare_to(&b);
+            UTEST_ASSERT(r1 == r2);
+            UTEST_ASSERT(r1 == r3);
+            UTEST_ASSERT(ca.equals(&cb) == a.equals(&b));
+            UTEST_ASSERT(ca.equals(&b) == a.equals(&b));
+            UTEST_ASSERT(ca.hash() == a.hash());
+            UTEST_ASSERT(cb.hash() == b.hash());
+
+            // Search
+            const lsp_wchar_t ch = chars[rand() % (sizeof(chars)/sizeof(chars[0]))];
+            const ssize_t start = (a.length() > 0) ? rand() % a.length() : 0;
+            UTEST_ASSERT(ca.index_of(ch) == a.index_of(ch));
+            UTEST_ASSERT(ca.index_of(start, ch) == a.index_of(start, ch));
+            UTEST_ASSERT(ca.index_of(&cb) == a.index_of(&b));
+            UTEST_ASSERT(ca.index_of(start, &cb) == a.index_of(start, &b));
+        }
+    }
+
+    void test_lltl()
+    {
+        printf("Testing lltl specializations...\n");
+
+        CompactString a, b;
+        UTEST_ASSERT(a.set_ascii("key"));
+        UTEST_ASSERT(b.set_utf8("key"));
+
+        lltl::hash_spec<CompactString> hs;
+        lltl::compare_spec<CompactString> cs;
+        lltl::allocator_spec<CompactString> as;
+        UTEST_ASSERT(hs.hash(&a, sizeof(a)) == hs.hash(&b, sizeof(b)));
+        UTEST_ASSERT(cs.compare(&a, &b, sizeof(a)) == 0);
+
+        CompactString *c = static_cast<CompactString *>(as.clone(&a, sizeof(a)));
+        UTEST_ASSERT(c != NULL);
+        UTEST_ASSERT(c->equals(&a));
+        as.free(c);
+    }
+
+    UTEST_MAIN
+    {
+        test_width();
+        test_conversion();
+        test_append();
+        test_compare();
+        test_lltl();
+    }
+
+UTEST_END
@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/runtime/number.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#define RANDOM_CHECKS       0x10000
+
+UTEST_BEGIN("runtime.runtime", number)
+
+    uint64_t            nSeed;
+
+    uint64_t random64()
+    {
+        // xorshift64*
+        nSeed              ^= nSeed >> 12;
+        nSeed              ^= nSeed << 25;
+        nSeed              ^= nSeed >> 27;
+        return nSeed * 0x2545f4914f6cdd1dULL;
+    }
+
+    double random_double()
+    {
+        double v;
+        do
+        {
+            const uint64_t bits = random64();
+            memcpy(&v, &bits, sizeof(v));
+        } while (isnan(v) || isinf(v));
+        return v;
+    }
+
+    float random_float()
+    {
+        float v;
+        do
+        {
+            const uint32_t bits = uint32_t(random64() >> 32);
+            memcpy(&v, &bits, sizeof(v));
+        } while (isnan(v) || isinf(v));
+        return v;
+    }
+
+    void check_shortest(double value, const char *expected)
+    {
+        char buf[FLOAT_SHORTEST_BUF_SIZE];
+        const size_t n = format_shortest(buf, value);
+        printf("  shortest(%.17g) = %s\n", value, buf);
+        UTEST_ASSERT_MSG(strcmp(buf, expected) == 0, "Expected '%s' but got '%s'", expected, buf);
+        UTEST_ASSERT(n == strlen(expected));
+    }
+
+    void check_shortest(float value, const char *expected)
+    {
+        char buf[FLOAT_SHORTEST_BUF_SIZE];
+        const size_t n = format_shortest(buf, value);
+        printf("  shortest(%.9g f) = %s\n", double(value), buf);
+        UTEST_ASSERT_MSG(strcmp(buf, expected) == 0, "Expected '%s' but got '%s'", expected, buf);
+        UTEST_ASSERT(n == strlen(expected));
+    }
+
+    void check_parse(const char *text, status_t code, double expected, size_t length)
+    {
+        double value = -1.0;
+        const char *end = NULL;
+        const status_t res = parse_double(&value, text, &end);
+        printf("  parse_double('%s') = %.17g, code=%d, parsed=%d\n", text, value, int(res), int(end - text));
+
+        UTEST_ASSERT_MSG(res == code, "Expected code %d but got %d", int(code), int(res));
+        UTEST_ASSERT_MSG(size_t(end - text) == length, "Expected %d parsed characters but got %d", int(length), int(end - text));
+        if (code == STATUS_BAD_FORMAT)
+            return;
+        if (isnan(expected))
+            UTEST_ASSERT(isnan(value));
+        else
+            UTEST_ASSERT_MSG(memcmp(&value, &expected, sizeof(value)) == 0, "Expected %.17g but got %.17g", expected, value);
+
+        size_t parsed = 0;
+        value = -1.0;
+        UTEST_ASSERT(parse_double(&value, text, strlen(text), &parsed) == code);
+        UTEST_ASSERT(parsed == length);
+    }
+
+    void check_format(const char *fmt, double value)
+    {
+        char a[0x200], b[0x200];
+        const int n1 = snprintf(a, sizeof(a), fmt, value);
+        const ssize_t n2 = format_float(b, sizeof(b), fmt, value);
+        UTEST_ASSERT_MSG((n1 == n2) && (strcmp(a, b) == 0),
+            "format '%s' for %.17g: expected '%s' (%d) but got '%s' (%d)", fmt, value, a, int(n1), b, int(n2));
+    }
+
+    void test_shortest()
+    {
+        printf("Testing shortest formatting...\n");
+        check_shortest(0.0, "0");
+        check_shortest(-0.0, "-0");
+        check_shortest(1.0, "1");
+        check_shortest(0.1, "0.1");
+        check_shortest(0.3, "0.3");
+        check_shortest(-2.5, "-2.5");
+        check_shortest(1234.5678, "1234.5678");
+        check_shortest(0.00001, "0.00001");
+        check_shortest(0.000001, "1e-06");
+        check_shortest(1e16, "10000000000000000");
+        check_shortest(1e17, "1e+17");
+        check_shortest(1e21, "1e+21");
+        check_shortest(5e-324, "5e-324");
+        check_shortest(1.7976931348623157e+308, "1.7976931348623157e+308");
+        check_shortest(double(NAN), "nan");
+        check_shortest(double(INFINITY), "inf");
+        check_shortest(-double(INFINITY), "-inf");
+
+        check_shortest(0.1f, "0.1");
+        check_shortest(1.0f / 3.0f, "0.33333334");
+        check_shortest(16777216.0f, "16777216");
+        check_shortest(1e-45f, "1e-45");
+        check_shortest(3.4028235e+38f, "3.4028235e+38");
+
+        printf("Testing shortest formatting round-trip...\n");
+        char buf[FLOAT_SHORTEST_BUF_SIZE];
+        for (size_t i=0; i<RANDOM_CHECKS; ++i)
+        {
+            const double dv = random_double();
+            format_shortest(buf, dv);
+            double dr = 0.0;
+            UTEST_ASSERT(parse_double(&dr, buf, NULL) == STATUS_OK);
+            UTEST_ASSERT_MSG(memcmp(&dr, &dv, sizeof(dv)) == 0, "Round-trip failed for %.17g: '%s'", dv, buf);
+
+            const float fv = random_float();
+            format_shortest(buf, fv);
+            float fr = 0.0f;
+            UTEST_ASSERT(parse_float(&fr, buf, NULL) == STATUS_OK);
+            UTEST_ASSERT_MSG(memcmp(&fr, &fv, sizeof(fv)) == 0, "Round-trip failed for %.9g: '%s'", double(fv), buf);
+        }
+    }
+
+    void test_parse()
+    {
+        printf("Testing parsing...\n");
+        check_parse("0", STATUS_OK, 0.0, 1);
+        check_parse("-0", STATUS_OK, -0.0, 2);
+        check_parse("  1.5xyz", STATUS_OK, 1.5, 5);
+        check_parse("+.5", STATUS_OK, 0.5, 3);
+        check_parse("12..3", STATUS_OK, 12.0, 3);
+        check_parse("1e", STATUS_OK, 1.0, 1);
+        check_parse("1e+", STATUS_OK, 1.0, 1);
+        check_parse("1.5e3z", STATUS_OK, 1500.0, 5);
+        check_parse("1.0 db", STATUS_OK, 1.0, 3);
+        check_parse("00000.000001e-2", STATUS_OK, 1e-8, 15);
+        check_parse("0.1", STATUS_OK, 0.1, 3);
+        check_parse("9007199254740993", STATUS_OK, 9007199254740992.0, 16);
+        check_parse("2.2250738585072011e-308", STATUS_OK, 2.2250738585072011e-308, 23);
+        check_parse("1.7976931348623157e308", STATUS_OK, 1.7976931348623157e308, 22);
+        check_parse("4.9406564584124654e-324", STATUS_OK, 4.9406564584124654e-324, 23);
+        check_parse("2.4703282292062328e-324", STATUS_OK, 4.9406564584124654e-324, 23);
+        check_parse("inf", STATUS_OK, INFINITY, 3);
+        check_parse("infin", STATUS_OK, INFINITY, 3);
+        check_parse("-Infinity", STATUS_OK, -INFINITY, 9);
+        check_parse("nan", STATUS_OK, NAN, 3);
+        check_parse("NaN(abc)", STATUS_OK, NAN, 8);
+        check_parse("1e400", STATUS_OVERFLOW, INFINITY, 5);
+        check_parse("-1e400", STATUS_OVERFLOW, -INFINITY, 6);
+        check_parse("1e-400", STATUS_UNDERFLOW, 0.0, 6);
+        check_parse("2.4703282292062327e-324", STATUS_UNDERFLOW, 0.0, 23);
+        check_parse("", STATUS_BAD_FORMAT, 0.0, 0);
+        check_parse("  ", STATUS_BAD_FORMAT, 0.0, 0);
+        check_parse(".", STATUS_BAD_FORMAT, 0.0, 0);
+        check_parse("-", STATUS_BAD_FORMAT, 0.0, 0);
+        check_parse("abc", STATUS_BAD_FORMAT, 0.0, 0);
+
+        // Long mantissa which does not fit into 64 bits, requires the slow path
+        check_parse(
+            "2.47032822920623272088284396434110686182529901307162382212792841250337753635104375932649"
+            "91865e-324",
+            STATUS_OK, 4.9406564584124654e-324, 98);
+
+        // Length limit should be respected
+        double value = 0.0;
+        size_t parsed = 0;
+        UTEST_ASSERT(parse_double(&value, "12345", 3, &parsed) == STATUS_OK);
+        UTEST_ASSERT((value == 123.0) && (parsed == 3));
+
+        float fvalue = 0.0f;
+        UTEST_ASSERT(parse_float(&fvalue, "16777217", NULL) == STATUS_OK);
+        UTEST_ASSERT(fvalue == 16777216.0f);
+        UTEST_ASSERT(parse_float(&fvalue, "1e39", NULL) == STATUS_OVERFLOW);
+        UTEST_ASSERT(isinf(fvalue));
+
+        printf("Testing parsing against strtod()...\n");
+        char buf[0x40];
+        for (size_t i=0; i<RANDOM_CHECKS; ++i)
+        {
+            const double dv = random_double();
+            snprintf(buf, sizeof(buf), "%.*e", int(random64() % 20), dv);
+            const double expected = strtod(buf, NULL);
+            double dr = 0.0;
+            parse_double(&dr, buf, NULL);
+            UTEST_ASSERT_MSG(memcmp(&dr, &expected, sizeof(dr)) == 0,
+                "Parsing '%s': expected %.17g but got %.17g", buf, expected, dr);
+        }
+    }
+
+    void test_format()
+    {
+        char buf[0x40];
+
+        printf("Testing fixed and exponential formatting...\n");
+        UTEST_ASSERT(format_fixed(buf, sizeof(buf), 1.5, 3) == 5);
+        UTEST_ASSERT(strcmp(buf, "1.500") == 0);
+        UTEST_ASSERT(format_fixed(buf, sizeof(buf), 2.5, 0) == 1);
+        UTEST_ASSERT(strcmp(buf, "2") == 0);
+        UTEST_ASSERT(format_fixed(buf, sizeof(buf), -0.0, 1) == 4);
+        UTEST_ASSERT(strcmp(buf, "-0.0") == 0);
+        UTEST_ASSERT(format_exp(buf, sizeof(buf), 12345.678, 2) == 8);
+        UTEST_ASSERT(strcmp(buf, "1.23e+04") == 0);
+        UTEST_ASSERT(format_exp(buf, sizeof(buf), INFINITY, 2, true) == 3);
+        UTEST_ASSERT(strcmp(buf, "INF") == 0);
+
+        // Truncation
+        UTEST_ASSERT(format_fixed(buf, 5, 123.456, 2) == 6);
+        UTEST_ASSERT(strcmp(buf, "123.") == 0);
+        UTEST_ASSERT(format_fixed(NULL, 0, 123.456, 2) == 6);
+
+        // Invalid format strings
+        UTEST_ASSERT(format_float(buf, sizeof(buf), "%d", 1.0) < 0);
+        UTEST_ASSERT(format_float(buf, sizeof(buf), "%f %f", 1.0) < 0);
+        UTEST_ASSERT(format_float(buf, sizeof(buf), "%", 1.0) < 0);
+
+        printf("Testing formatting against snprintf()...\n");
+        static const char *formats[] =
+        {
+            "%f", "%.3f", "%.0f", "%#.0f", "%e", "%.10E", "%g", "%G", "%.3g", "%.12g",
+            "%10.3f", "%-10.3f|", "%+010.2e", "% f", "value=%lf%%", "%.20f", "%.17g",
+            NULL
+        };
+
+        static const double values[] =
+        {
+            0.0, -0.0, 1.0, 0.5, 1.5, 2.5, 0.1, 123.456, 999.9995, 1e-5, 1e-300, 1e300,
+            5e-324, 1.7976931348623157e308, 0.000123456, 123456789012345678.0
+        };
+
+        for (const char **fmt = formats; *fmt != NULL; ++fmt)
+        {
+            for (size_t i=0; i<sizeof(values)/sizeof(values[0]); ++i)
+            {
+                check_format(*fmt, values[i]);
+                check_format(*fmt, -values[i]);
+            }
+            check_format(*fmt, INFINITY);
+            check_format(*fmt, -INFINITY);
+
+            for (size_t i=0; i<RANDOM_CHECKS / 16; ++i)
+                check_format(*fmt, random_double());
+        }
+    }
+
+    UTEST_MAIN
+    {
+        nSeed       = 0x123456789abcdefULL;
+
+        test_shortest();
+        test_parse();
+        test_format();
+    }
+
+UTEST_END
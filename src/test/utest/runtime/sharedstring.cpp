@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/runtime/SharedString.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/LSPStringView.h>
+#include <lsp-plug.in/ipc/Thread.h>
+
+#define THREADS_COUNT       4
+#define ITERATIONS          10000
+
+namespace
+{
+    typedef struct context_t
+    {
+        lsp::SharedString  *pSource;
+        size_t              nErrors;
+    } context_t;
+
+    static lsp::status_t thread_proc(void *arg)
+    {
+        context_t *ctx = static_cast<context_t *>(arg);
+
+        // Make copies of the shared string and release them in different order
+        lsp::SharedString copies[8];
+        for (size_t i=0; i<ITERATIONS; ++i)
+        {
+            lsp::SharedString *c = &copies[i % 8];
+            c->set(ctx->pSource);
+            if ((c->length() != ctx->pSource->length()) || (!c->equals(ctx->pSource)))
+                ++ctx->nErrors;
+            if ((i % 3) == 0)
+                copies[(i * 5) % 8].clear();
+        }
+
+        return lsp::STATUS_OK;
+    }
+}
+
+UTEST_BEGIN("runtime.runtime", sharedstring)
+
+    void test_basic()
+    {
+        printf("Testing basic operations...\n");
+
+        SharedString a, b;
+        LSPString s, tmp;
+
+        UTEST_ASSERT(a.is_empty());
+        UTEST_ASSERT(a.length() == 0);
+        UTEST_ASSERT(a.characters() == NULL);
+        UTEST_ASSERT(a.at(0) == 0);
+        UTEST_ASSERT(a.hash() == 0);
+        UTEST_ASSERT(a.equals(&b));
+        UTEST_ASSERT(a.equals(&s));
+
+        // Copy from LSPString
+        UTEST_ASSERT(s.set_ascii("some long text value"));
+        UTEST_ASSERT(a.set(&s));
+        UTEST_ASSERT(a.length() == s.length());
+        UTEST_ASSERT(a.characters() != s.characters());
+        UTEST_ASSERT(a.equals(&s));
+        UTEST_ASSERT(a.compare_to(&s) == 0);
+        UTEST_ASSERT(a.hash() == s.hash());
+        UTEST_ASSERT(a.at(0) == 's');
+        UTEST_ASSERT(a.at(-1) == 'e');
+        UTEST_ASSERT(a.at(100) == 0);
+        UTEST_ASSERT(!a.is_shared());
+
+        // Shared copy
+        b.set(&a);
+        UTEST_ASSERT(b.characters() == a.characters());
+        UTEST_ASSERT(a.is_shared());
+        UTEST_ASSERT(b.is_shared());
+        UTEST_ASSERT(a.equals(&b));
+        UTEST_ASSERT(a.compare_to(&b) == 0);
+
+        // Modification of the copy
+        UTEST_ASSERT(b.set_utf8("другое значение"));
+        UTEST_ASSERT(!a.is_shared());
+        UTEST_ASSERT(!b.is_shared());
+        UTEST_ASSERT(a.equals(&s));
+        UTEST_ASSERT(!a.equals(&b));
+        UTEST_ASSERT(a.compare_to(&b) < 0);
+        UTEST_ASSERT(b.compare_to(&a) > 0);
+        UTEST_ASSERT(b.get(&tmp));
+        UTEST_ASSERT(tmp.equals_utf8("другое значение"));
+
+        // Ranges
+        UTEST_ASSERT(b.set(&s, 5, 9));
+        UTEST_ASSERT(b.length() == 4);
+        UTEST_ASSERT(b.get(&tmp));
+        UTEST_ASSERT(tmp.equals_ascii("long"));
+        UTEST_ASSERT(b.set(&s, -5));
+        UTEST_ASSERT(b.get(&tmp));
+        UTEST_ASSERT(tmp.equals_ascii("value"));
+        UTEST_ASSERT(!b.set(&s, 100));
+        UTEST_ASSERT(b.set(&s, 9, 5));
+        UTEST_ASSERT(b.is_empty());
+
+        // Swap and clear
+        b.swap(&a);
+        UTEST_ASSERT(a.is_empty());
+        UTEST_ASSERT(b.equals(&s));
+        b.clear();
+        UTEST_ASSERT(b.is_empty());
+    }
+
+    void test_conversion()
+    {
+        printf("Testing conversion with LSPString...\n");
+
+        SharedString a, b;
+        LSPString s, tmp;
+
+        // Take the heap buffer of the string
+        UTEST_ASSERT(s.set_ascii("the buffer of this string is taken without copying"));
+        const size_t hash = s.hash();
+        const lsp_wchar_t *chars = s.characters();
+        UTEST_ASSERT(a.take(&s));
+        UTEST_ASSERT(s.is_empty());
+        UTEST_ASSERT(a.characters() == chars);
+        UTEST_ASSERT(a.hash() == hash);
+        UTEST_ASSERT(s.set_ascii("reuse"));
+
+        // Take short string stored in the inline buffer
+        UTEST_ASSERT(tmp.set_ascii("short"));
+        UTEST_ASSERT(b.take(&tmp));
+        UTEST_ASSERT(tmp.is_empty());
+        UTEST_ASSERT(b.length() == 5);
+        UTEST_ASSERT(b.at(0) == 's');
+
+        // View
+        LSPStringView v;
+        a.view(&v);
+        UTEST_ASSERT(v.length() == a.length());
+        UTEST_ASSERT(v.string()->characters() == chars);
+        UTEST_ASSERT(v.hash() == hash);
+
+        // Extract shared buffer: the data should be copied
+        b.set(&a);
+        UTEST_ASSERT(a.extract(&tmp));
+        UTEST_ASSERT(a.is_empty());
+        UTEST_ASSERT(tmp.characters() != chars);
+        UTEST_ASSERT(tmp.equals_ascii("the buffer of this string is taken without copying"));
+        UTEST_ASSERT(!b.is_shared());
+
+        // Extract unique buffer: the buffer should be passed as is
+        UTEST_ASSERT(b.extract(&s));
+        UTEST_ASSERT(b.is_empty());
+        UTEST_ASSERT(s.characters() == chars);
+        UTEST_ASSERT(s.hash() == hash);
+        UTEST_ASSERT(s.append_ascii(", and modified"));
+        UTEST_ASSERT(s.equals_ascii("the buffer of this string is taken without copying, and modified"));
+
+        // Extract empty string
+        UTEST_ASSERT(b.extract(&s));
+        UTEST_ASSERT(s.is_empty());
+    }
+
+    void test_threads()
+    {
+        printf("Testing concurrent copies...\n");
+
+        SharedString src;
+        UTEST_ASSERT(src.set_utf8("value shared between multiple threads"));
+
+        context_t ctx[THREADS_COUNT];
+        ipc::Thread *threads[THREADS_COUNT];
+        for (size_t i=0; i<THREADS_COUNT; ++i)
+        {
+            ctx[i].pSource  = &src;
+            ctx[i].nErrors  = 0;
+            threads[i]      = new ipc::Thread(thread_proc, &ctx[i]);
+            UTEST_ASSERT(threads[i] != NULL);
+        }
+        for (size_t i=0; i<THREADS_COUNT; ++i)
+            UTEST_ASSERT(threads[i]->start() == STATUS_OK);
+        for (size_t i=0; i<THREADS_COUNT; ++i)
+        {
+            UTEST_ASSERT(threads[i]->join() == STATUS_OK);
+            UTEST_ASSERT(ctx[i].nErrors == 0);
+            delete threads[i];
+        }
+
+        // All copies have been released
+        UTEST_ASSERT(!src.is_shared());
+    }
+
+    UTEST_MAIN
+    {
+        test_basic();
+        test_conversion();
+        test_threads();
+    }
+
+UTEST_END;
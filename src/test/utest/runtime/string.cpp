@@ -434,6 +434,188 @@ UTEST_BEGIN("runtime.runtime", string)
         }
     }
 
+    void test_case_search()
+    {
+        printf("Testing case conversion and search...\n");
+
+        LSPString a, b;
+        UTEST_ASSERT(a.set_ascii("some text with some words and some more text"));
+
+        // Conversion of ranges
+        UTEST_ASSERT(b.set(&a));
+        UTEST_ASSERT(b.toupper(5, 9) == 4);
+        UTEST_ASSERT(b.equals_ascii("some TEXT with some words and some more text"));
+        UTEST_ASSERT(b.toupper(-4) == 4);
+        UTEST_ASSERT(b.equals_ascii("some TEXT with some words and some more TEXT"));
+        UTEST_ASSERT(b.tolower(9, 5) == 4);
+        UTEST_ASSERT(b.equals_ascii("some text with some words and some more TEXT"));
+
+        // Case-insensitive comparison
+        b.toupper();
+        UTEST_ASSERT(b.equals_ascii("SOME TEXT WITH SOME WORDS AND SOME MORE TEXT"));
+        UTEST_ASSERT(a.equals_nocase(&b));
+        UTEST_ASSERT(a.compare_to_nocase(&b) == 0);
+        UTEST_ASSERT(a.compare_to(&b) > 0);
+        UTEST_ASSERT(b.set_ascii("SOME TEXT WITH SOME WORDS AND SOME MORE TEXTS"));
+        UTEST_ASSERT(a.compare_to_nocase(&b) < 0);
+        UTEST_ASSERT(b.set_ascii("SOME TEXT WITH SOME WORDS AND SOME MORE TEX"));
+        UTEST_ASSERT(a.compare_to_nocase(&b) > 0);
+        UTEST_ASSERT(b.set_ascii("SOME TEXT WITH SOME WORDS AND SOME MORE TEZT"));
+        UTEST_ASSERT(a.compare_to_nocase(&b) < 0);
+
+        // Search
+        UTEST_ASSERT(b.set_ascii("some"));
+        UTEST_ASSERT(a.index_of(&b) == 0);
+        UTEST_ASSERT(a.index_of(1, &b) == 15);
+        UTEST_ASSERT(a.rindex_of(&b) == 30);
+        UTEST_ASSERT(a.rindex_of(30, &b) == 15);
+        UTEST_ASSERT(a.index_of('x') == 7);
+        UTEST_ASSERT(a.index_of(8, 'x') == 42);
+        UTEST_ASSERT(a.rindex_of('x') == 42);
+        UTEST_ASSERT(a.rindex_of(41, 'x') == 7);
+        UTEST_ASSERT(a.index_of('Q') < 0);
+        UTEST_ASSERT(a.count('s') == 4);
+        UTEST_ASSERT(a.count('s', 10) == 3);
+        UTEST_ASSERT(a.count('s', 10, 1) == 0);
+        UTEST_ASSERT(a.replace_all('s', 'S') == 4);
+        UTEST_ASSERT(a.equals_ascii("Some text with Some wordS and Some more text"));
+
+        // Unicode case folding
+        UTEST_ASSERT(a.set_utf8("ΣΟΦΟΣ KELVIN Straße"));
+        UTEST_ASSERT(b.set_utf8("σοφος \u212aelvin STRAẞE"));
+        UTEST_ASSERT(a.equals_nocase(&b));
+        UTEST_ASSERT(a.compare_to_nocase(&b) == 0);
+        UTEST_ASSERT(b.set_utf8("σοφος"));
+        UTEST_ASSERT(a.starts_with_nocase(&b));
+        UTEST_ASSERT(b.set_utf8("strasse"));
+        UTEST_ASSERT(!a.ends_with_nocase(&b));
+        UTEST_ASSERT(b.set_utf8("ꭰᏸ"));
+        UTEST_ASSERT(a.set_utf8("ᎠᏰ"));
+        UTEST_ASSERT(a.equals_nocase(&b));
+    }
+
+    void test_buffer_encode()
+    {
+        printf("Testing encoding into caller-provided buffers...\n");
+
+        LSPString s;
+        char buf[0x20];
+        lsp_utf16_t wbuf[0x20];
+
+        // "Всем привет!" + U+1F600
+        UTEST_ASSERT(s.set_utf16(utf16_ru));
+        UTEST_ASSERT(s.append(lsp_wchar_t(0x1F600)));
+        UTEST_ASSERT(s.length() == 13);
+        UTEST_ASSERT(s.utf8_length() == 26);
+        UTEST_ASSERT(s.utf8_length(4) == 18);
+        UTEST_ASSERT(s.utf8_length(4, 6) == 3);
+        UTEST_ASSERT(s.utf16_length() == 14);
+        UTEST_ASSERT(s.utf16_length(-1) == 2);
+
+        // UTF-8 encoding
+        UTEST_ASSERT(s.encode_utf8(NULL, 0) == 26);
+        UTEST_ASSERT(s.encode_utf8(buf, sizeof(buf)) == 26);
+        UTEST_ASSERT(strcmp(buf, s.get_utf8()) == 0);
+        UTEST_ASSERT(s.encode_utf8(buf, sizeof(buf), 4, 6) == 3);
+        UTEST_ASSERT(strcmp(buf, " \xd0\xbf") == 0);
+
+        // Truncation at character boundary
+        UTEST_ASSERT(s.encode_utf8(buf, 4) == 26);
+        UTEST_ASSERT(strcmp(buf, "\xd0\x92") == 0);
+        UTEST_ASSERT(s.encode_utf8(buf, 26) == 26);
+        UTEST_ASSERT(strlen(buf) == 22);
+        UTEST_ASSERT(s.encode_utf8(buf, 1) == 26);
+        UTEST_ASSERT(buf[0] == '\0');
+
+        // UTF-16 encoding
+        UTEST_ASSERT(s.encode_utf16(wbuf, 0x20) == 14);
+        UTEST_ASSERT(memcmp(wbuf, utf16_ru, 12 * sizeof(lsp_utf16_t)) == 0);
+        UTEST_ASSERT((wbuf[12] == 0xD83D) && (wbuf[13] == 0xDE00) && (wbuf[14] == 0));
+        UTEST_ASSERT(s.encode_utf16(wbuf, 14) == 14);
+        UTEST_ASSERT((wbuf[11] == 0x0021) && (wbuf[12] == 0));
+
+        // Invalid ranges
+        UTEST_ASSERT(s.encode_utf8(buf, sizeof(buf), 14) < 0);
+        UTEST_ASSERT(s.encode_utf8(buf, sizeof(buf), 6, 4) < 0);
+        UTEST_ASSERT(s.encode_utf16(wbuf, 0x20, 0, 14) < 0);
+        UTEST_ASSERT(s.encode_native(buf, sizeof(buf), 6, 4, "UTF-8") < 0);
+
+        // Native encoding
+        UTEST_ASSERT(s.encode_native(buf, sizeof(buf), "UTF-8") == 26);
+        UTEST_ASSERT(strcmp(buf, s.get_utf8()) == 0);
+        UTEST_ASSERT(s.native_length("UTF-8") == 26);
+        UTEST_ASSERT(s.set_ascii("native text"));
+        UTEST_ASSERT(s.encode_native(buf, sizeof(buf)) == ssize_t(strlen(s.get_native())));
+        UTEST_ASSERT(strcmp(buf, s.get_native()) == 0);
+        UTEST_ASSERT(s.encode_native(buf, 7) == 11);
+        UTEST_ASSERT(strlen(buf) < 7);
+
+    #ifndef PLATFORM_WINDOWS
+        // Stateful encodings should return to the initial shift state at the end of output
+        UTEST_ASSERT(s.set_utf8("\xe6\x97\xa5\xe6\x9c\xac"));
+        UTEST_ASSERT(s.encode_native(buf, sizeof(buf), "ISO-2022-JP") == 10);
+        UTEST_ASSERT(memcmp(buf, "\x1b$BF|K\\\x1b(B", 11) == 0);
+        UTEST_ASSERT(s.native_length("ISO-2022-JP") == 10);
+        UTEST_ASSERT(s.encode_native(buf, 8, "ISO-2022-JP") == 10);
+        UTEST_ASSERT(strlen(buf) < 8);
+        UTEST_ASSERT(s.set_utf8("a\xe6\x97\xa5"));
+        UTEST_ASSERT(s.encode_native(buf, sizeof(buf), "UTF-7") == 6);
+        UTEST_ASSERT(strcmp(buf, "a+ZeU-") == 0);
+        UTEST_ASSERT(s.set_ascii("native text"));
+    #endif /* PLATFORM_WINDOWS */
+
+        // Fallback to the temporary buffer when the caller's buffer is too small
+        const char *p = s.to_utf8(buf, sizeof(buf));
+        UTEST_ASSERT(p == buf);
+        UTEST_ASSERT(strcmp(p, "native text") == 0);
+        p = s.to_utf8(buf, 4);
+        UTEST_ASSERT((p != NULL) && (p != buf));
+        UTEST_ASSERT(strcmp(p, "native text") == 0);
+        p = s.to_native(buf, sizeof(buf));
+        UTEST_ASSERT(p == buf);
+        UTEST_ASSERT(strcmp(p, "native text") == 0);
+        const lsp_utf16_t *wp = s.to_utf16(wbuf, 0x20);
+        UTEST_ASSERT((wp == wbuf) && (wp[0] == 'n') && (wp[11] == 0));
+        wp = s.to_utf16(wbuf, 2);
+        UTEST_ASSERT((wp != NULL) && (wp != wbuf) && (wp[10] == 't'));
+
+        // Empty string
+        s.clear();
+        UTEST_ASSERT(s.encode_utf8(buf, sizeof(buf)) == 0);
+        UTEST_ASSERT(buf[0] == '\0');
+        UTEST_ASSERT(s.to_utf8(buf, sizeof(buf)) == buf);
+    }
+
+    void test_relocation()
+    {
+        printf("Testing relocation of string objects...\n");
+
+        // Containers like lltl::darray move objects with raw memory copy
+        static const char *values[] = { "", "key", "12345678", "long string stored on the heap" };
+
+        for (size_t i=0; i<sizeof(values)/sizeof(values[0]); ++i)
+        {
+            alignas(LSPString) uint8_t storage[sizeof(LSPString)];
+
+            LSPString *s = new (storage) LSPString();
+            UTEST_ASSERT(s->set_ascii(values[i]));
+            UTEST_ASSERT(s->append('!'));
+
+            alignas(LSPString) uint8_t moved[sizeof(LSPString)];
+            ::memcpy(moved, storage, sizeof(storage));
+            ::memset(storage, 0x55, sizeof(storage));
+            s = reinterpret_cast<LSPString *>(moved);
+
+            UTEST_ASSERT(s->length() == strlen(values[i]) + 1);
+            UTEST_ASSERT(s->starts_with_ascii(values[i]));
+            UTEST_ASSERT(s->last() == '!');
+            UTEST_ASSERT(s->append_ascii(" more text to grow the string"));
+            UTEST_ASSERT(s->ends_with_ascii("grow the string"));
+            UTEST_ASSERT(s->starts_with_ascii(values[i]));
+            s->~LSPString();
+        }
+    }
+
     UTEST_MAIN
     {
         test_basic();
@@ -441,6 +623,9 @@ UTEST_BEGIN("runtime.runtime", string)
         test_base_hashing();
         test_hash_key();
         test_line_convert();
+        test_case_search();
+        test_buffer_encode();
+        test_relocation();
     }
 UTEST_END;
 
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/runtime/StringBuilder.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/io/OutBuilderSequence.h>
+#include <lsp-plug.in/io/OutMemoryStream.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace
+{
+    // Characters of different UTF-8 length: 1, 2, 3 and 4 bytes
+    static const lsp::lsp_wchar_t mixed_chars[] =
+    {
+        'a', 0x0436, 0x6DBC, 0x1F600, 'z', 0x00e9, 0x30CF, 0x10348
+    };
+}
+
+UTEST_BEGIN("runtime.runtime", stringbuilder)
+
+    void check_contents(const StringBuilder *sb, const LSPString *expected)
+    {
+        LSPString tmp;
+        UTEST_ASSERT(sb->length() == expected->length());
+        UTEST_ASSERT(sb->to_string(&tmp));
+        UTEST_ASSERT(tmp.equals(expected));
+
+        // Check UTF-8 copy
+        const char *utf8 = expected->get_utf8();
+        const size_t bytes = strlen(utf8);
+        UTEST_ASSERT(sb->size() == bytes);
+
+        char *buf = static_cast<char *>(malloc(bytes + 1));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+        UTEST_ASSERT(sb->copy_utf8(buf, bytes) < 0);
+        UTEST_ASSERT(sb->copy_utf8(buf, bytes + 1) == ssize_t(bytes));
+        UTEST_ASSERT(memcmp(buf, utf8, bytes + 1) == 0);
+
+        // Check output to the stream
+        io::OutMemoryStream os;
+        UTEST_ASSERT(sb->write(&os) == STATUS_OK);
+        UTEST_ASSERT(os.size() == bytes);
+        UTEST_ASSERT(memcmp(os.data(), utf8, bytes) == 0);
+    }
+
+    void test_basic()
+    {
+        printf("Testing basic operations...\n");
+
+        StringBuilder sb;
+        LSPString tmp, src;
+
+        UTEST_ASSERT(sb.is_empty());
+        UTEST_ASSERT(sb.length() == 0);
+        UTEST_ASSERT(sb.to_string(&tmp));
+        UTEST_ASSERT(tmp.is_empty());
+
+        UTEST_ASSERT(sb.append_ascii("Hello"));
+        UTEST_ASSERT(sb.append(lsp_wchar_t(',')));
+        UTEST_ASSERT(sb.append(lsp_wchar_t(' ')));
+        UTEST_ASSERT(src.set_utf8("Всем привет"));
+        UTEST_ASSERT(sb.append(&src, 5));
+        UTEST_ASSERT(sb.append_utf8("! \xf0\x9f\x98\x80"));
+        UTEST_ASSERT(sb.append_ascii("\xe9", 1));
+
+        UTEST_ASSERT(tmp.set_utf8("Hello, привет! \xf0\x9f\x98\x80\xc3\xa9"));
+        check_contents(&sb, &tmp);
+
+        // Invalid UTF-8 sequence is replaced
+        sb.clear();
+        UTEST_ASSERT(sb.is_empty());
+        UTEST_ASSERT(sb.append_utf8("a\xffz", 3));
+        UTEST_ASSERT(sb.to_string(&tmp));
+        UTEST_ASSERT(tmp.length() == 3);
+        UTEST_ASSERT(tmp.at(1) == 0xfffd);
+
+        // Invalid range
+        UTEST_ASSERT(!sb.append(&src, 20));
+        UTEST_ASSERT(!sb.append(&src, 4, 30));
+
+        // Append to the existing string
+        UTEST_ASSERT(tmp.set_ascii("prefix:"));
+        UTEST_ASSERT(sb.append_to(&tmp));
+        UTEST_ASSERT(tmp.length() == 10);
+
+        // Swap
+        StringBuilder sb2;
+        sb.swap(&sb2);
+        UTEST_ASSERT(sb.is_empty());
+        UTEST_ASSERT(sb2.length() == 3);
+
+        sb2.truncate();
+        UTEST_ASSERT(sb2.is_empty());
+    }
+
+    void test_numbers()
+    {
+        printf("Testing number formatting...\n");
+
+        StringBuilder sb;
+        LSPString tmp;
+
+        UTEST_ASSERT(sb.append_int(0));
+        UTEST_ASSERT(sb.append(lsp_wchar_t(' ')));
+        UTEST_ASSERT(sb.append_int(-1234567));
+        UTEST_ASSERT(sb.append(lsp_wchar_t(' ')));
+        UTEST_ASSERT(sb.append_int(INT64_MIN));
+        UTEST_ASSERT(sb.append(lsp_wchar_t(' ')));
+        UTEST_ASSERT(sb.append_uint(UINT64_MAX));
+        UTEST_ASSERT(sb.append(lsp_wchar_t(' ')));
+        UTEST_ASSERT(sb.append_hex(0xdeadbeef));
+        UTEST_ASSERT(sb.append(lsp_wchar_t(' ')));
+        UTEST_ASSERT(sb.append_hex(0x1f, 4));
+        UTEST_ASSERT(sb.append(lsp_wchar_t(' ')));
+        UTEST_ASSERT(sb.append_double(0.1));
+        UTEST_ASSERT(sb.append(lsp_wchar_t(' ')));
+        UTEST_ASSERT(sb.append_float(0.3f));
+        UTEST_ASSERT(sb.append(lsp_wchar_t(' ')));
+        UTEST_ASSERT(sb.append_double(-2.5e-10));
+
+        UTEST_ASSERT(sb.to_string(&tmp));
+        printf("  result: %s\n", tmp.get_utf8());
+        UTEST_ASSERT(tmp.equals_ascii("0 -1234567 -9223372036854775808 18446744073709551615 deadbeef 001f 0.1 0.3 -2.5e-10"));
+    }
+
+    void test_escaped()
+    {
+        printf("Testing escaped strings...\n");
+
+        StringBuilder sb;
+        LSPString src, tmp;
+
+        UTEST_ASSERT(src.set_utf8("a\"b\\c\nd\te\x01" "f\x1fпривет"));
+        UTEST_ASSERT(sb.append(lsp_wchar_t('\"')));
+        UTEST_ASSERT(sb.append_escaped(&src));
+        UTEST_ASSERT(sb.append(lsp_wchar_t('\"')));
+        UTEST_ASSERT(sb.to_string(&tmp));
+        UTEST_ASSERT(tmp.equals_utf8("\"a\\\"b\\\\c\\nd\\te\\u0001f\\u001fпривет\""));
+
+        sb.clear();
+        UTEST_ASSERT(sb.append_escaped(&src, -6));
+        UTEST_ASSERT(sb.to_string(&tmp));
+        UTEST_ASSERT(tmp.equals_utf8("привет"));
+    }
+
+    void test_large()
+    {
+        printf("Testing large incremental output...\n");
+
+        StringBuilder sb;
+        LSPString expected, tmp;
+        const size_t nmixed = sizeof(mixed_chars) / sizeof(mixed_chars[0]);
+
+        // Mix appends of different kinds to cross chunk boundaries at different positions
+        for (size_t i=0; i<20000; ++i)
+        {
+            const lsp_wchar_t *chars = &mixed_chars[i % nmixed];
+            const size_t count = lsp_min(nmixed - (i % nmixed), (i % 5) + 1);
+
+            UTEST_ASSERT(sb.append(chars, count));
+            UTEST_ASSERT(expected.append(chars, count));
+
+            UTEST_ASSERT(sb.append_uint(i));
+            UTEST_ASSERT(tmp.fmt_ascii("%d", int(i)));
+            UTEST_ASSERT(expected.append(&tmp));
+
+            UTEST_ASSERT(tmp.set(chars, count));
+            const char *utf8 = tmp.get_utf8();
+            UTEST_ASSERT(sb.append_utf8(utf8));
+            UTEST_ASSERT(expected.append(&tmp));
+        }
+
+        printf("  generated %d characters, %d bytes\n", int(sb.length()), int(sb.size()));
+        check_contents(&sb, &expected);
+    }
+
+    void test_sequence()
+    {
+        printf("Testing output sequence...\n");
+
+        StringBuilder sb;
+        LSPString tmp, src;
+
+        io::OutBuilderSequence os(&sb);
+        UTEST_ASSERT(src.set_utf8("строка"));
+        UTEST_ASSERT(os.write_ascii("key") == STATUS_OK);
+        UTEST_ASSERT(os.write('=') == STATUS_OK);
+        UTEST_ASSERT(os.write(&src, 1, 4) == STATUS_OK);
+        UTEST_ASSERT(os.writeln_ascii(";") == STATUS_OK);
+        UTEST_ASSERT(os.close() == STATUS_OK);
+        UTEST_ASSERT(os.write('x') == STATUS_CLOSED);
+
+        UTEST_ASSERT(sb.to_string(&tmp));
+        UTEST_ASSERT(tmp.equals_utf8("key=тро;\n"));
+    }
+
+    UTEST_MAIN
+    {
+        test_basic();
+        test_numbers();
+        test_escaped();
+        test_large();
+        test_sequence();
+    }
+
+UTEST_END;
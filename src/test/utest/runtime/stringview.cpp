@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-runtime-lib
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-runtime-lib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-runtime-lib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-runtime-lib. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/LSPStringView.h>
+#include <lsp-plug.in/lltl/pphash.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+UTEST_BEGIN("runtime.runtime", stringview)
+
+    void test_set()
+    {
+        printf("Testing references to strings...\n");
+
+        LSPString s;
+        UTEST_ASSERT(s.set_utf8("section.key.value"));
+
+        LSPStringView v;
+        UTEST_ASSERT(v.is_empty());
+        UTEST_ASSERT(v.length() == 0);
+        UTEST_ASSERT(v.hash() == 0);
+
+        v.set(&s);
+        UTEST_ASSERT(v.length() == s.length());
+        UTEST_ASSERT(v.characters() == s.characters());
+        UTEST_ASSERT(v.equals(&s));
+
+        UTEST_ASSERT(v.set(&s, 8));
+        UTEST_ASSERT(v.characters() == &s.characters()[8]);
+        UTEST_ASSERT(v.equals_ascii("key.value"));
+
+        UTEST_ASSERT(v.set(&s, 8, 11));
+        UTEST_ASSERT(v.equals_ascii("key"));
+        UTEST_ASSERT(v.first() == 'k');
+        UTEST_ASSERT(v.last() == 'y');
+        UTEST_ASSERT(strcmp(v.get_utf8(), "key") == 0);
+
+        UTEST_ASSERT(v.set(&s, -5, -1));
+        UTEST_ASSERT(v.equals_ascii("valu"));
+        UTEST_ASSERT(v.set(&s, 11, 8));
+        UTEST_ASSERT(v.is_empty());
+
+        // Out of bounds
+        UTEST_ASSERT(!v.set(&s, 18));
+        UTEST_ASSERT(!v.set(&s, 0, 100));
+        UTEST_ASSERT(!v.set(&s, -100, 1));
+
+        // Sub-view of the view
+        LSPStringView w(&s, 8);
+        UTEST_ASSERT(v.set(&w, 4, w.length()));
+        UTEST_ASSERT(v.equals_ascii("value"));
+
+        // Raw characters
+        const lsp_wchar_t chars[] = { 'a', 'b', 0x0416, 'c' };
+        v.set(chars, 4);
+        UTEST_ASSERT(v.length() == 4);
+        UTEST_ASSERT(v.at(2) == 0x0416);
+        UTEST_ASSERT(v.index_of(lsp_wchar_t('c')) == 3);
+
+        v.clear();
+        UTEST_ASSERT(v.is_empty());
+        UTEST_ASSERT(v.characters() == NULL);
+
+        // The referenced string should stay intact
+        UTEST_ASSERT(s.equals_ascii("section.key.value"));
+    }
+
+    void test_decode()
+    {
+        printf("Testing decoding of UTF-8 and ASCII sequences...\n");
+
+        LSPString s;
+        LSPStringView v;
+
+        // Short sequence is decoded into the internal buffer
+        UTEST_ASSERT(v.set_utf8("Привет, мир!"));
+        UTEST_ASSERT(s.set_utf8("Привет, мир!"));
+        UTEST_ASSERT(v.length() == 12);
+        UTEST_ASSERT(v.equals(&s));
+        UTEST_ASSERT(v.hash() == s.hash());
+
+        // Long sequence requires the heap buffer
+        s.clear();
+        for (size_t i=0; i<200; ++i)
+            UTEST_ASSERT(s.append(lsp_wchar_t((i & 1) ? 'a' + (i % 26) : 0x0430 + (i % 32))));
+        const char *utf8 = s.get_utf8();
+        UTEST_ASSERT(utf8 != NULL);
+        UTEST_ASSERT(v.set_utf8(utf8));
+        UTEST_ASSERT(v.equals(&s));
+        UTEST_ASSERT(v.hash() == s.hash());
+        UTEST_ASSERT(v.compare_to_utf8(utf8) == 0);
+
+        // Re-use of the buffer
+        UTEST_ASSERT(v.set_utf8("key", 2));
+        UTEST_ASSERT(v.equals_ascii("ke"));
+
+        UTEST_ASSERT(v.set_ascii("plain ascii"));
+        UTEST_ASSERT(v.equals_ascii("plain ascii"));
+
+        UTEST_ASSERT(v.set_utf8(""));
+        UTEST_ASSERT(v.is_empty());
+    }
+
+    void test_compare()
+    {
+        printf("Testing comparison and hashing...\n");
+
+        LSPString s, a;
+        UTEST_ASSERT(s.set_ascii("alpha.Beta.gamma"));
+        UTEST_ASSERT(a.set_ascii("beta"));
+
+        LSPStringView v(&s, 6, 10), w(&s, 0, 5);
+        UTEST_ASSERT(!v.equals(&a));
+        UTEST_ASSERT(v.equals_nocase(&a));
+        UTEST_ASSERT(v.compare_to(&a) < 0);
+        UTEST_ASSERT(a.compare_to(v.string()) > 0);
+        UTEST_ASSERT(w.compare_to(&v) > 0);
+        UTEST_ASSERT(v.compare_to(&w) < 0);
+        UTEST_ASSERT(v.compare_to_nocase(&w) > 0);
+
+        UTEST_ASSERT(a.set_ascii("Beta"));
+        UTEST_ASSERT(v.equals(&a));
+        UTEST_ASSERT(v.hash() == a.hash());
+
+        // Hash should be re-computed after the view has been changed
+        v.set(&s, 11);
+        UTEST_ASSERT(a.set_ascii("gamma"));
+        UTEST_ASSERT(v.hash() == a.hash());
+    }
+
+    void test_lltl()
+    {
+        printf("Testing lookups in lltl containers...\n");
+
+        static const char *keys[] = { "alpha", "beta", "gamma", "delta", NULL };
+
+        lltl::pphash<LSPString, LSPString> map;
+        lsp_finally {
+            lltl::parray<LSPString> values;
+            map.values(&values);
+            for (size_t i=0, n=values.size(); i<n; ++i)
+                delete values.uget(i);
+            map.flush();
+        };
+
+        LSPStringView key;
+        for (const char **k = keys; *k != NULL; ++k)
+        {
+            LSPString *value = new LSPString();
+            UTEST_ASSERT(value != NULL);
+            UTEST_ASSERT(value->set_utf8(*k));
+            UTEST_ASSERT(key.set_utf8(*k));
+            UTEST_ASSERT(map.put(key.string(), value, NULL));
+        }
+
+        LSPString path;
+        UTEST_ASSERT(path.set_ascii("/gamma/beta/epsilon/alpha"));
+        for (ssize_t first = 1; first < ssize_t(path.length()); )
+        {
+            ssize_t last = path.index_of(first, '/');
+            if (last < 0)
+                last = path.length();
+
+            UTEST_ASSERT(key.set(&path, first, last));
+            LSPString *value = map.get(key.string());
+            printf("  lookup '%s' -> %s\n", key.get_utf8(), (value != NULL) ? value->get_utf8() : "NULL");
+
+            if (key.equals_ascii("epsilon"))
+                UTEST_ASSERT(value == NULL);
+            else
+            {
+                UTEST_ASSERT(value != NULL);
+                UTEST_ASSERT(value->equals(key.string()));
+            }
+
+            first = last + 1;
+        }
+    }
+
+    UTEST_MAIN
+    {
+        test_set();
+        test_decode();
+        test_compare();
+        test_lltl();
+    }
+
+UTEST_END